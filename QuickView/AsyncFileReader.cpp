@@ -0,0 +1,305 @@
+#include "pch.h"
+#include "AsyncFileReader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace QuickView {
+
+size_t ReadFileAt(NativeFileHandle file, uint64_t offset, uint8_t* dst, size_t length) {
+    size_t done = 0;
+    while (done < length) {
+        const size_t want = (std::min)(length - done, (size_t)1 << 30);
+#ifdef _WIN32
+        OVERLAPPED ov = {};
+        const uint64_t at = offset + done;
+        ov.Offset = (DWORD)(at & 0xFFFFFFFFu);
+        ov.OffsetHigh = (DWORD)(at >> 32);
+        DWORD got = 0;
+        if (!ReadFile(file, dst + done, (DWORD)want, &got, &ov) || got == 0) break;
+#else
+        const ssize_t got = pread(file, dst + done, want, (off_t)(offset + done));
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) break;
+#endif
+        done += (size_t)got;
+    }
+    return done;
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// ThreadPool backend
+// ----------------------------------------------------------------------------
+class ThreadPoolReader final : public AsyncFileReader {
+public:
+    explicit ThreadPoolReader(int threads) {
+        for (int i = 0; i < (std::max)(1, threads); ++i) {
+            m_threads.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+    ~ThreadPoolReader() override {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+        m_cv.notify_all();
+        for (auto& t : m_threads) t.join(); // Workers drain the queue first
+    }
+
+    Backend GetBackend() const override { return Backend::ThreadPool; }
+
+    void Submit(const AsyncReadRequest* requests, size_t count) override {
+        if (!count) return;
+        {
+            std::lock_guard lock(m_mutex);
+            m_queue.insert(m_queue.end(), requests, requests + count);
+        }
+        if (count == 1) m_cv.notify_one();
+        else m_cv.notify_all();
+    }
+
+private:
+    void WorkerLoop() {
+        for (;;) {
+            AsyncReadRequest req;
+            {
+                std::unique_lock lock(m_mutex);
+                m_cv.wait(lock, [&] { return m_stopping || !m_queue.empty(); });
+                if (m_queue.empty()) return;
+                req = m_queue.front();
+                m_queue.pop_front();
+            }
+            const size_t got = ReadFileAt(req.file, req.offset, req.dst, req.length);
+            if (req.onComplete) req.onComplete(req.ctx, req, got);
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<AsyncReadRequest> m_queue;
+    std::vector<std::thread> m_threads;
+    bool m_stopping = false;
+};
+
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+// ----------------------------------------------------------------------------
+// io_uring backend (raw syscalls, no liburing dependency)
+// ----------------------------------------------------------------------------
+class IoUringReader final : public AsyncFileReader {
+public:
+    static std::unique_ptr<IoUringReader> Create(unsigned depth) {
+        std::unique_ptr<IoUringReader> r(new IoUringReader());
+        if (!r->Init(depth)) return nullptr;
+        return r;
+    }
+
+    ~IoUringReader() override {
+        if (m_reaper.joinable()) {
+            {
+                std::lock_guard lock(m_mutex);
+                m_stopping = true;
+                PushSqeLocked(IORING_OP_NOP, nullptr, 0); // Wake the reaper
+                EnterLocked();
+            }
+            m_reaper.join();
+        }
+        if (m_sqes) munmap(m_sqes, m_sqesBytes);
+        if (m_cqRing && m_cqRing != m_sqRing) munmap(m_cqRing, m_cqRingBytes);
+        if (m_sqRing) munmap(m_sqRing, m_sqRingBytes);
+        if (m_ringFd >= 0) close(m_ringFd);
+    }
+
+    Backend GetBackend() const override { return Backend::IoUring; }
+
+    void Submit(const AsyncReadRequest* requests, size_t count) override {
+        if (!count) return;
+        std::lock_guard lock(m_mutex);
+        m_pending.insert(m_pending.end(), requests, requests + count);
+        FlushLocked();
+    }
+
+private:
+    IoUringReader() = default;
+
+    bool Init(unsigned depth) {
+        io_uring_params p;
+        std::memset(&p, 0, sizeof(p));
+        m_ringFd = (int)syscall(__NR_io_uring_setup, depth, &p);
+        if (m_ringFd < 0) return false;
+
+        m_sqRingBytes = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        m_cqRingBytes = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        const bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single) m_sqRingBytes = m_cqRingBytes = (std::max)(m_sqRingBytes, m_cqRingBytes);
+
+        m_sqRing = MapRing(m_sqRingBytes, IORING_OFF_SQ_RING);
+        if (!m_sqRing) return false;
+        m_cqRing = single ? m_sqRing : MapRing(m_cqRingBytes, IORING_OFF_CQ_RING);
+        if (!m_cqRing) return false;
+        m_sqesBytes = p.sq_entries * sizeof(io_uring_sqe);
+        m_sqes = static_cast<io_uring_sqe*>(MapRing(m_sqesBytes, IORING_OFF_SQES));
+        if (!m_sqes) return false;
+
+        auto* sq = static_cast<uint8_t*>(m_sqRing);
+        auto* cq = static_cast<uint8_t*>(m_cqRing);
+        m_sqTail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        m_sqMask = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        m_sqArray = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        m_cqHead = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        m_cqTail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        m_cqMask = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+
+        // One SQ slot stays free for the shutdown NOP
+        m_maxInFlight = p.sq_entries - 1;
+        m_slots.resize(m_maxInFlight);
+        for (unsigned i = 0; i < m_maxInFlight; ++i) m_freeSlots.push_back(i);
+
+        m_reaper = std::thread([this] { ReaperLoop(); });
+        return true;
+    }
+
+    void* MapRing(size_t bytes, off_t offset) {
+        void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, offset);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    // Caller holds m_mutex. user_data 0 is the wake-up NOP.
+    void PushSqeLocked(uint8_t opcode, const AsyncReadRequest* req, uint64_t userData) {
+        const unsigned tail = std::atomic_ref<unsigned>(*m_sqTail).load(std::memory_order_relaxed);
+        const unsigned index = tail & m_sqMask;
+        io_uring_sqe& sqe = m_sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = opcode;
+        if (req) {
+            sqe.fd = req->file;
+            sqe.off = req->offset;
+            sqe.addr = reinterpret_cast<uint64_t>(req->dst);
+            sqe.len = (uint32_t)req->length;
+        }
+        sqe.user_data = userData;
+        m_sqArray[index] = index;
+        std::atomic_ref<unsigned>(*m_sqTail).store(tail + 1, std::memory_order_release);
+        m_unsubmitted++;
+    }
+
+    void EnterLocked() {
+        if (!m_unsubmitted) return;
+        const long ret = syscall(__NR_io_uring_enter, m_ringFd, m_unsubmitted, 0, 0, nullptr, 0);
+        if (ret > 0) m_unsubmitted -= (unsigned)ret; // Leftovers go with the next enter
+    }
+
+    void FlushLocked() {
+        while (!m_pending.empty() && !m_freeSlots.empty()) {
+            const unsigned slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+            m_slots[slot] = m_pending.front();
+            m_pending.pop_front();
+            PushSqeLocked(IORING_OP_READ, &m_slots[slot], (uint64_t)slot + 1);
+        }
+        EnterLocked();
+    }
+
+    void ReaperLoop() {
+        std::vector<std::pair<AsyncReadRequest, int>> done;
+        for (bool exit = false; !exit;) {
+            syscall(__NR_io_uring_enter, m_ringFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+
+            done.clear();
+            {
+                std::lock_guard lock(m_mutex);
+                unsigned head = std::atomic_ref<unsigned>(*m_cqHead).load(std::memory_order_relaxed);
+                const unsigned tail = std::atomic_ref<unsigned>(*m_cqTail).load(std::memory_order_acquire);
+                for (; head != tail; ++head) {
+                    const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+                    if (cqe.user_data == 0) continue;
+                    const unsigned slot = (unsigned)(cqe.user_data - 1);
+                    done.emplace_back(m_slots[slot], cqe.res);
+                    m_freeSlots.push_back(slot);
+                }
+                std::atomic_ref<unsigned>(*m_cqHead).store(head, std::memory_order_release);
+                FlushLocked();
+                exit = m_stopping && m_pending.empty() && m_freeSlots.size() == m_maxInFlight;
+            }
+
+            for (auto& [req, res] : done) {
+                size_t got = res > 0 ? (size_t)res : 0;
+                // Errors (-EINVAL on kernels without IORING_OP_READ, -EAGAIN) and short
+                // reads finish synchronously here
+                if (got < req.length) got += ReadFileAt(req.file, req.offset + got, req.dst + got, req.length - got);
+                if (req.onComplete) req.onComplete(req.ctx, req, got);
+            }
+        }
+    }
+
+    int m_ringFd = -1;
+    void* m_sqRing = nullptr;
+    void* m_cqRing = nullptr;
+    size_t m_sqRingBytes = 0;
+    size_t m_cqRingBytes = 0;
+    io_uring_sqe* m_sqes = nullptr;
+    size_t m_sqesBytes = 0;
+    unsigned* m_sqTail = nullptr;
+    unsigned* m_sqArray = nullptr;
+    unsigned m_sqMask = 0;
+    unsigned* m_cqHead = nullptr;
+    unsigned* m_cqTail = nullptr;
+    unsigned m_cqMask = 0;
+    io_uring_cqe* m_cqes = nullptr;
+
+    std::mutex m_mutex; // SQ producer side, slots, pending queue
+    std::vector<AsyncReadRequest> m_slots;
+    std::vector<unsigned> m_freeSlots;
+    std::deque<AsyncReadRequest> m_pending;
+    unsigned m_maxInFlight = 0;
+    unsigned m_unsubmitted = 0;
+    bool m_stopping = false;
+    std::thread m_reaper;
+};
+#endif
+
+} // namespace
+
+std::unique_ptr<AsyncFileReader> AsyncFileReader::CreateThreadPool(int threads) {
+    return std::make_unique<ThreadPoolReader>(threads);
+}
+
+std::unique_ptr<AsyncFileReader> AsyncFileReader::CreateIoUring(unsigned queueDepth) {
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+    return IoUringReader::Create(queueDepth);
+#else
+    (void)queueDepth;
+    return nullptr;
+#endif
+}
+
+AsyncFileReader& AsyncFileReader::Shared() {
+    static const std::unique_ptr<AsyncFileReader> s_reader = [] {
+        std::unique_ptr<AsyncFileReader> reader = CreateIoUring(64);
+        if (!reader) reader = CreateThreadPool(2);
+        return reader;
+    }();
+    return *s_reader;
+}
+
+} // namespace QuickView
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace QuickView {
+
+#ifdef _WIN32
+    using NativeFileHandle = HANDLE;
+    inline const NativeFileHandle kInvalidFileHandle = INVALID_HANDLE_VALUE;
+#else
+    using NativeFileHandle = int;
+    inline constexpr NativeFileHandle kInvalidFileHandle = -1;
+#endif
+
+    // Blocking positional read; loops over short reads. Returns bytes read (< length at EOF or on error).
+    size_t ReadFileAt(NativeFileHandle file, uint64_t offset, uint8_t* dst, size_t length);
+
+    // ============================================================================
+    // [Readahead] Asynchronous positional reads
+    // ============================================================================
+    // MappedFile's async mode and the engine's readahead window submit chunked reads
+    // here and return at once; completions arrive on backend threads.
+    //   ThreadPool: a few threads doing blocking ReadFile/pread (portable)
+    //   IoUring:    Linux io_uring, one io_uring_enter per batch, one reaper thread
+    // Short reads are finished synchronously, so a completion always reports either
+    // the full length or the point where the file ended / failed.
+    // ============================================================================
+
+    struct AsyncReadRequest {
+        NativeFileHandle file = kInvalidFileHandle;
+        uint64_t offset = 0;
+        uint8_t* dst = nullptr;
+        size_t length = 0;
+
+        // Runs on a backend thread. Must not block on other reads.
+        void (*onComplete)(void* ctx, const AsyncReadRequest& req, size_t bytesRead) = nullptr;
+        void* ctx = nullptr;
+    };
+
+    class AsyncFileReader {
+    public:
+        enum class Backend { ThreadPool, IoUring };
+
+        virtual ~AsyncFileReader() = default;
+        virtual Backend GetBackend() const = 0;
+
+        // Thread-safe; never blocks on I/O. Requests beyond the backend's queue depth wait
+        // in order inside the backend.
+        virtual void Submit(const AsyncReadRequest* requests, size_t count) = 0;
+
+        static std::unique_ptr<AsyncFileReader> CreateThreadPool(int threads);
+        // nullptr when io_uring is unavailable (not Linux, old kernel, or blocked by seccomp)
+        static std::unique_ptr<AsyncFileReader> CreateIoUring(unsigned queueDepth);
+
+        // Process-wide reader: io_uring where available, else a 2-thread pool
+        static AsyncFileReader& Shared();
+    };
+
+} // namespace QuickView
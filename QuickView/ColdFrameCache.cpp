@@ -0,0 +1,516 @@
+#include "pch.h"
+#include "ColdFrameCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace QuickView {
+
+// ============================================================================
+// FrameCodec: vertical delta + per-group bit packing
+// ============================================================================
+// Each byte is predicted from the byte one row up (the first row of a stripe
+// from the pixel to its left), so stripes decode independently. Residuals are
+// zigzag-mapped and packed in 16-byte groups at 0, 2, 4 or 8 bits; each row
+// starts with the 2-bit width codes of its groups. Packing is planar within a
+// group (byte j holds residuals j, j+8 or j, j+4, j+8, j+12), so unpacking is a
+// few 64-bit mask/shift ops per 8 bytes instead of QOI's op-by-op parse.
+
+namespace FrameCodec {
+
+namespace {
+
+constexpr int kGroup = 16;
+constexpr uint8_t kInitialPixel[4] = { 0, 0, 0, 255 }; // Opaque black (BGRA)
+constexpr size_t kPayloadBytes[4] = { 0, kGroup / 4, kGroup / 2, kGroup };
+constexpr uint64_t kLow1 = 0x0101010101010101ull;
+constexpr uint64_t kLow7 = 0x7F7F7F7F7F7F7F7Full;
+
+inline size_t GroupsPerRow(int width) { return ((size_t)width * 4 + kGroup - 1) / kGroup; }
+inline size_t CodeBytes(size_t groups) { return (groups + 3) / 4; }
+inline int CodeAt(const uint8_t* codes, size_t g) { return (codes[g / 4] >> (g % 4 * 2)) & 3; }
+
+inline uint8_t ZigZag(uint8_t r) { return (uint8_t)((r << 1) ^ (uint8_t)((int8_t)r >> 7)); }
+inline uint8_t UnZigZag(uint8_t z) { return (uint8_t)((z >> 1) ^ (uint8_t)-(z & 1)); }
+
+inline uint64_t Load64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+inline void Store64(uint8_t* p, uint64_t v) { std::memcpy(p, &v, 8); }
+
+// Eight lanes at once: unzigzag, then a carry-free bytewise add
+inline uint64_t UnZigZag8(uint64_t z) { return ((z >> 1) & kLow7) ^ ((z & kLow1) * 0xFF); }
+inline uint64_t AddBytes8(uint64_t a, uint64_t b) { return ((a & kLow7) + (b & kLow7)) ^ ((a ^ b) & ~kLow7); }
+
+// Residuals of a group, 8 lanes per word
+inline void Unpack(const uint8_t* p, int code, uint64_t& lo, uint64_t& hi) {
+    switch (code) {
+        case 0:
+            lo = hi = 0;
+            break;
+        case 1: {
+            uint32_t w;
+            std::memcpy(&w, p, 4);
+            const uint64_t v = (uint64_t)w | (uint64_t)(w >> 2) << 32;
+            lo = v & 0x0303030303030303ull;
+            hi = (v >> 4) & 0x0303030303030303ull;
+            break;
+        }
+        case 2: {
+            const uint64_t v = Load64(p);
+            lo = v & 0x0F0F0F0F0F0F0F0Full;
+            hi = (v >> 4) & 0x0F0F0F0F0F0F0F0Full;
+            break;
+        }
+        default:
+            lo = Load64(p);
+            hi = Load64(p + 8);
+            break;
+    }
+}
+
+void Pack(const uint8_t* z, int code, uint8_t* o) {
+    switch (code) {
+        case 1:
+            for (int j = 0; j < kGroup / 4; ++j) {
+                o[j] = (uint8_t)(z[j] | z[j + 4] << 2 | z[j + 8] << 4 | z[j + 12] << 6);
+            }
+            break;
+        case 2:
+            for (int j = 0; j < kGroup / 2; ++j) o[j] = (uint8_t)(z[j] | z[j + 8] << 4);
+            break;
+        case 3:
+            std::memcpy(o, z, kGroup);
+            break;
+        default:
+            break;
+    }
+}
+
+} // namespace
+
+size_t MaxEncodedSize(int width, int rows) {
+    const size_t groups = GroupsPerRow(width);
+    return (CodeBytes(groups) + groups * kGroup) * (size_t)rows;
+}
+
+size_t EncodeStripe(const uint8_t* src, int width, int rows, size_t stride, uint8_t* out) {
+    const size_t rowBytes = (size_t)width * 4;
+    const size_t groups = GroupsPerRow(width);
+    std::vector<uint8_t> z(groups * kGroup, 0); // Tail of the last group stays zero
+    uint8_t* o = out;
+
+    for (int y = 0; y < rows; ++y) {
+        const uint8_t* row = src + (size_t)y * stride;
+        if (y) {
+            const uint8_t* above = row - stride;
+            for (size_t i = 0; i < rowBytes; ++i) z[i] = ZigZag((uint8_t)(row[i] - above[i]));
+        } else {
+            for (size_t i = 0; i < rowBytes; ++i) z[i] = ZigZag((uint8_t)(row[i] - (i < 4 ? kInitialPixel[i] : row[i - 4])));
+        }
+
+        uint8_t* codes = o;
+        std::memset(codes, 0, CodeBytes(groups));
+        o += CodeBytes(groups);
+        for (size_t g = 0; g < groups; ++g) {
+            const uint8_t* zg = z.data() + g * kGroup;
+            uint8_t bits = 0;
+            for (int i = 0; i < kGroup; ++i) bits |= zg[i];
+            const int code = bits == 0 ? 0 : bits < 4 ? 1 : bits < 16 ? 2 : 3;
+            codes[g / 4] |= (uint8_t)(code << (g % 4 * 2));
+            Pack(zg, code, o);
+            o += kPayloadBytes[code];
+        }
+    }
+    return (size_t)(o - out);
+}
+
+bool DecodeStripe(const uint8_t* in, size_t size, int width, int rows, size_t stride, uint8_t* dst) {
+    const size_t rowBytes = (size_t)width * 4;
+    const size_t groups = GroupsPerRow(width);
+    const size_t fullGroups = rowBytes / kGroup;
+    const uint8_t* p = in;
+    const uint8_t* end = in + size;
+
+    for (int y = 0; y < rows; ++y) {
+        if ((size_t)(end - p) < CodeBytes(groups)) return false;
+        const uint8_t* codes = p;
+        p += CodeBytes(groups);
+        if ((size_t)(end - p) < groups * kGroup) { // Near the end: check the exact payload size
+            size_t payload = 0;
+            for (size_t g = 0; g < groups; ++g) payload += kPayloadBytes[CodeAt(codes, g)];
+            if ((size_t)(end - p) < payload) return false;
+        }
+
+        uint8_t* row = dst + (size_t)y * stride;
+        if (y) {
+            const uint8_t* above = row - stride;
+            size_t g = 0;
+            for (; g < fullGroups; ++g) {
+                const int code = CodeAt(codes, g);
+                uint64_t lo, hi;
+                Unpack(p, code, lo, hi);
+                p += kPayloadBytes[code];
+                uint8_t* d = row + g * kGroup;
+                const uint8_t* a = above + g * kGroup;
+                Store64(d, AddBytes8(Load64(a), UnZigZag8(lo)));
+                Store64(d + 8, AddBytes8(Load64(a + 8), UnZigZag8(hi)));
+            }
+            if (g < groups) { // Row tail: 4, 8 or 12 bytes
+                const int code = CodeAt(codes, g);
+                uint8_t z[kGroup];
+                uint64_t lo, hi;
+                Unpack(p, code, lo, hi);
+                p += kPayloadBytes[code];
+                Store64(z, lo);
+                Store64(z + 8, hi);
+                for (size_t i = g * kGroup; i < rowBytes; ++i) row[i] = (uint8_t)(above[i] + UnZigZag(z[i - g * kGroup]));
+            }
+        } else {
+            // First row: left predictor, serial along the row
+            for (size_t g = 0; g < groups; ++g) {
+                const int code = CodeAt(codes, g);
+                uint8_t z[kGroup];
+                uint64_t lo, hi;
+                Unpack(p, code, lo, hi);
+                p += kPayloadBytes[code];
+                Store64(z, lo);
+                Store64(z + 8, hi);
+                const size_t n = (std::min)((size_t)kGroup, rowBytes - g * kGroup);
+                for (size_t i = 0; i < n; ++i) {
+                    const size_t x = g * kGroup + i;
+                    row[x] = (uint8_t)((x < 4 ? kInitialPixel[x] : row[x - 4]) + UnZigZag(z[i]));
+                }
+            }
+        }
+    }
+    return p == end;
+}
+
+} // namespace FrameCodec
+
+// ============================================================================
+// ColdFrameCache
+// ============================================================================
+
+namespace {
+
+// Everything but the pixels (and the per-instance hand-offs: aux layers and
+// animators never enter the cold tier)
+std::shared_ptr<RawImageFrame> MakeShell(const RawImageFrame& f) {
+    auto shell = std::make_shared<RawImageFrame>();
+    shell->width = f.width;
+    shell->height = f.height;
+    shell->stride = f.stride;
+    shell->format = f.format;
+    shell->quality = f.quality;
+    shell->formatDetails = f.formatDetails;
+    shell->exifOrientation = f.exifOrientation;
+    shell->iccProfile = f.iccProfile;
+    shell->colorInfo = f.colorInfo;
+    shell->hdrMetadata = f.hdrMetadata;
+    shell->srcWidth = f.srcWidth;
+    shell->srcHeight = f.srcHeight;
+    shell->dpiX = f.dpiX;
+    shell->dpiY = f.dpiY;
+    shell->blendOp = f.blendOp;
+    shell->shaderPayload = f.shaderPayload;
+    shell->frameMeta = f.frameMeta;
+    return shell;
+}
+
+int StripeRowsFor(const RawImageFrame& f) {
+    const size_t rowBytes = (size_t)f.width * 4;
+    return (int)std::clamp<size_t>(ColdFrameCache::kStripeBytes / rowBytes, 1, (size_t)f.height);
+}
+
+} // namespace
+
+ColdFrameCache::ColdFrameCache(size_t budgetBytes)
+    : m_pool((std::max)(budgetBytes / (1024 * 1024), (size_t)1)), m_budget(budgetBytes) {
+    m_worker = std::thread([this] { WorkerLoop(); });
+}
+
+ColdFrameCache::~ColdFrameCache() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    m_worker.join();
+    Clear(); // Blocks go back to m_pool before it is destroyed
+}
+
+bool ColdFrameCache::Accepts(const RawImageFrame& f) {
+    return (f.format == PixelFormat::BGRA8888 || f.format == PixelFormat::RGBA8888) &&
+           f.pixels && f.width > 0 && f.height > 0 && f.stride >= f.width * 4 &&
+           !f.svg && !f.auxLayer && !f.animator;
+}
+
+void ColdFrameCache::Put(ImageID id, std::shared_ptr<RawImageFrame> frame, int sourceIndex) {
+    if (!frame || !Accepts(*frame)) return;
+    // Larger than the whole tier even at a good ratio: not worth queueing
+    if ((size_t)frame->width * frame->height * 4 / 2 > m_budget) return;
+
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_entries.find(id);
+        if (it != m_entries.end()) EraseLocked(it);
+
+        Entry entry;
+        entry.shell = MakeShell(*frame);
+        entry.queued = std::move(frame);
+        entry.sourceIndex = sourceIndex;
+        entry.rawBytes = (size_t)entry.shell->width * entry.shell->height * 4;
+        entry.serial = ++m_putSerial;
+        m_lru.push_front(id);
+        entry.lru = m_lru.begin();
+        m_entries.emplace(id, std::move(entry));
+        m_pending.push_back(id);
+
+        // Browsing faster than the worker compresses: raw frames must not pile up
+        while (m_pending.size() > kMaxQueued) {
+            auto oldest = m_entries.find(m_pending.front());
+            if (oldest == m_entries.end()) {
+                m_pending.pop_front();
+                continue;
+            }
+            EraseLocked(oldest);
+            m_evictions++;
+        }
+    }
+    m_cv.notify_all();
+}
+
+std::shared_ptr<RawImageFrame> ColdFrameCache::Take(ImageID id, int* outSourceIndex) {
+    const auto t0 = std::chrono::steady_clock::now();
+    Entry entry;
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_entries.find(id);
+        if (it == m_entries.end()) {
+            m_misses++;
+            return nullptr;
+        }
+        m_hits++;
+        entry = std::move(it->second);
+        m_lru.erase(entry.lru);
+        m_pending.remove(id);
+        m_entries.erase(it);
+        if (!entry.blocks.empty()) {
+            m_compressedBytes -= entry.blocks.size() * kBlockSize;
+            m_rawBytes -= entry.rawBytes;
+        }
+    }
+    if (outSourceIndex) *outSourceIndex = entry.sourceIndex;
+    if (entry.queued) return std::move(entry.queued);
+
+    auto frame = Decompress(entry);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    std::lock_guard lock(m_mutex);
+    m_lastPromoteMs = ms;
+    return frame;
+}
+
+bool ColdFrameCache::Contains(ImageID id) const {
+    std::lock_guard lock(m_mutex);
+    return m_entries.count(id) != 0;
+}
+
+void ColdFrameCache::Erase(ImageID id) {
+    std::lock_guard lock(m_mutex);
+    auto it = m_entries.find(id);
+    if (it != m_entries.end()) EraseLocked(it);
+}
+
+void ColdFrameCache::Clear() {
+    std::lock_guard lock(m_mutex);
+    while (!m_entries.empty()) EraseLocked(m_entries.begin());
+}
+
+void ColdFrameCache::Flush() {
+    std::unique_lock lock(m_mutex);
+    m_cv.wait(lock, [&] { return (m_pending.empty() && !m_busy) || m_stop; });
+}
+
+ColdFrameCache::Stats ColdFrameCache::GetStats() const {
+    std::lock_guard lock(m_mutex);
+    Stats s;
+    s.entries = m_entries.size();
+    s.queued = m_pending.size();
+    s.compressedBytes = m_compressedBytes;
+    s.rawBytes = m_rawBytes;
+    s.budgetBytes = m_budget;
+    s.hits = m_hits;
+    s.misses = m_misses;
+    s.evictions = m_evictions;
+    s.lastPromoteMs = m_lastPromoteMs;
+    return s;
+}
+
+void ColdFrameCache::EraseLocked(std::unordered_map<ImageID, Entry>::iterator it) {
+    Entry& e = it->second;
+    if (!e.blocks.empty()) {
+        m_compressedBytes -= e.blocks.size() * kBlockSize;
+        m_rawBytes -= e.rawBytes;
+    }
+    if (e.queued) m_pending.remove(it->first);
+    m_lru.erase(e.lru);
+    m_entries.erase(it);
+}
+
+// Drops the least recently evicted compressed entry other than `keep`
+bool ColdFrameCache::EvictOneLocked(ImageID keep) {
+    for (auto lit = m_lru.rbegin(); lit != m_lru.rend(); ++lit) {
+        if (*lit == keep) continue;
+        auto it = m_entries.find(*lit);
+        if (it == m_entries.end() || it->second.blocks.empty()) continue;
+        EraseLocked(it);
+        m_evictions++;
+        return true;
+    }
+    return false;
+}
+
+void ColdFrameCache::WorkerLoop() {
+    std::vector<uint8_t> stream;
+    std::unique_lock lock(m_mutex);
+    for (;;) {
+        m_cv.wait(lock, [&] { return m_stop || !m_pending.empty(); });
+        if (m_stop) return;
+
+        const ImageID id = m_pending.front();
+        m_pending.pop_front();
+        auto it = m_entries.find(id);
+        if (it == m_entries.end() || !it->second.queued) continue;
+        std::shared_ptr<RawImageFrame> frame = it->second.queued;
+        const uint64_t serial = it->second.serial;
+        m_busy = true;
+        lock.unlock();
+
+        // Encode every stripe back to back into one reusable stream
+        const RawImageFrame& f = *frame;
+        const int stripeRows = StripeRowsFor(f);
+        std::vector<size_t> offsets;
+        offsets.push_back(0);
+        for (int y = 0; y < f.height; y += stripeRows) {
+            const int rows = (std::min)(stripeRows, f.height - y);
+            const size_t at = offsets.back();
+            if (stream.size() < at + FrameCodec::MaxEncodedSize(f.width, rows)) {
+                stream.resize(at + FrameCodec::MaxEncodedSize(f.width, rows));
+            }
+            const size_t n = FrameCodec::EncodeStripe(f.pixels + (size_t)y * f.stride, f.width, rows, f.stride, stream.data() + at);
+            offsets.push_back(at + n);
+        }
+        const size_t total = offsets.back();
+        const size_t blockCount = (total + kBlockSize - 1) / kBlockSize;
+
+        // Make room and take the blocks under the lock; fill them outside it
+        std::vector<TileMemoryManager::SlabPtr> blocks;
+        lock.lock();
+        const bool stillWanted = [&] {
+            auto cur = m_entries.find(id);
+            return cur != m_entries.end() && cur->second.serial == serial;
+        }();
+        if (stillWanted && total < (size_t)f.width * f.height * 4) {
+            while (m_compressedBytes + blockCount * kBlockSize > m_budget && EvictOneLocked(id)) {}
+            if (m_compressedBytes + blockCount * kBlockSize <= m_budget) {
+                for (size_t b = 0; b < blockCount; ++b) {
+                    auto slab = m_pool.AllocateSmart(kBlockSize);
+                    if (!slab) break;
+                    blocks.push_back(std::move(slab));
+                }
+            }
+        }
+        lock.unlock();
+
+        const bool haveBlocks = blockCount > 0 && blocks.size() == blockCount;
+        if (haveBlocks) {
+            for (size_t b = 0; b < blockCount; ++b) {
+                const size_t at = b * kBlockSize;
+                std::memcpy(blocks[b].get(), stream.data() + at, (std::min)(kBlockSize, total - at));
+            }
+        }
+        frame.reset(); // Last reference may be ours: free the raw pixels before relocking
+
+        lock.lock();
+        m_busy = false;
+        auto cur = m_entries.find(id);
+        if (cur != m_entries.end() && cur->second.serial == serial) {
+            if (haveBlocks) {
+                Entry& e = cur->second;
+                e.blocks = std::move(blocks);
+                e.stripeOffsets = std::move(offsets);
+                e.stripeRows = stripeRows;
+                e.queued.reset();
+                m_compressedBytes += e.blocks.size() * kBlockSize;
+                m_rawBytes += e.rawBytes;
+            } else {
+                EraseLocked(cur); // Incompressible or no room: the tier cannot hold it
+            }
+        }
+        m_cv.notify_all(); // Flush()
+    }
+}
+
+std::shared_ptr<RawImageFrame> ColdFrameCache::Decompress(const Entry& e) {
+    const RawImageFrame& shell = *e.shell;
+    const size_t bufferSize = (size_t)shell.stride * shell.height;
+    uint8_t* pixels = new (std::nothrow) uint8_t[bufferSize];
+    if (!pixels) return nullptr;
+
+    const size_t stripeCount = e.stripeOffsets.size() - 1;
+    std::atomic<size_t> next{ 0 };
+    std::atomic<bool> ok{ true };
+
+    auto work = [&] {
+        std::vector<uint8_t> gather; // For stripes that straddle a block boundary
+        for (size_t s; (s = next.fetch_add(1, std::memory_order_relaxed)) < stripeCount;) {
+            const size_t begin = e.stripeOffsets[s];
+            const size_t len = e.stripeOffsets[s + 1] - begin;
+            const size_t block = begin / kBlockSize;
+            const size_t inBlock = begin % kBlockSize;
+            const uint8_t* src;
+            if (inBlock + len <= kBlockSize) {
+                src = e.blocks[block].get() + inBlock;
+            } else {
+                gather.resize(len);
+                for (size_t copied = 0; copied < len;) {
+                    const size_t at = begin + copied;
+                    const size_t n = (std::min)(len - copied, kBlockSize - at % kBlockSize);
+                    std::memcpy(gather.data() + copied, e.blocks[at / kBlockSize].get() + at % kBlockSize, n);
+                    copied += n;
+                }
+                src = gather.data();
+            }
+            const int y = (int)s * e.stripeRows;
+            const int rows = (std::min)(e.stripeRows, shell.height - y);
+            if (!FrameCodec::DecodeStripe(src, len, shell.width, rows, shell.stride, pixels + (size_t)y * shell.stride)) {
+                ok.store(false, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    // Promotion is on the navigation path: spread the stripes over the cores
+    const size_t threads = (std::min)(stripeCount, (size_t)std::clamp((int)std::thread::hardware_concurrency(), 1, 8));
+    std::vector<std::thread> helpers;
+    for (size_t i = 1; i < threads; ++i) helpers.emplace_back(work);
+    work();
+    for (auto& t : helpers) t.join();
+
+    if (!ok.load()) {
+        delete[] pixels;
+        return nullptr;
+    }
+
+    auto frame = MakeShell(shell);
+    frame->pixels = pixels;
+    frame->memoryDeleter = MemoryDeleter::FromDeleteArray();
+    return frame;
+}
+
+} // namespace QuickView
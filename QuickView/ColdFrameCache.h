@@ -0,0 +1,127 @@
+#pragma once
+#include "pch.h"
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "ImageTypes.h"
+#include "PathTable.h"
+#include "TileMemoryManager.h"
+
+namespace QuickView {
+
+    // ============================================================================
+    // [Cold Tier] Compressed second level behind ImageEngine's decoded-frame cache
+    // ============================================================================
+    // Frames evicted from the hot LRU are compressed losslessly and kept in pooled
+    // 256 KB blocks, so flipping back to them costs a decompress instead of a full
+    // decode. The codec is a vertical byte delta with 16-byte groups bit-packed at
+    // 0/2/4/8 bits: decode is branch-light byte arithmetic. Frames are split into
+    // independent row stripes, so promotion decodes the stripes in parallel.
+    //
+    // Compression runs on the cache's own background thread. A frame that is still
+    // queued is handed back as-is. Only 8-bit raster frames without aux layers or
+    // animators are kept; anything else is dropped on eviction as before.
+    // ============================================================================
+
+    namespace FrameCodec {
+        // Worst case per stripe: every group at 8 bits plus the per-row width codes
+        size_t MaxEncodedSize(int width, int rows);
+
+        // Pixels are 4 bytes each; rows are `stride` apart. Returns bytes written.
+        size_t EncodeStripe(const uint8_t* src, int width, int rows, size_t stride, uint8_t* out);
+
+        // False on truncated / malformed input (dst contents are then unspecified)
+        bool DecodeStripe(const uint8_t* in, size_t size, int width, int rows, size_t stride, uint8_t* dst);
+    }
+
+    class ColdFrameCache {
+    public:
+        static constexpr size_t kBlockSize = 256 * 1024;   // TileSizeClass::Quarter
+        static constexpr size_t kStripeBytes = 1024 * 1024; // Raw bytes per independent stripe
+        static constexpr size_t kMaxQueued = 8;             // Uncompressed frames waiting; oldest dropped beyond
+
+        explicit ColdFrameCache(size_t budgetBytes);
+        ~ColdFrameCache();
+
+        ColdFrameCache(const ColdFrameCache&) = delete;
+        ColdFrameCache& operator=(const ColdFrameCache&) = delete;
+
+        static bool Accepts(const RawImageFrame& frame);
+
+        // Queue an evicted hot-cache frame for compression. The frame must no longer
+        // be written to (hot-cache frames are immutable once published).
+        void Put(ImageID id, std::shared_ptr<RawImageFrame> frame, int sourceIndex);
+
+        // Remove and return a decompressed copy (or the queued frame itself).
+        // nullptr on miss.
+        std::shared_ptr<RawImageFrame> Take(ImageID id, int* outSourceIndex = nullptr);
+
+        bool Contains(ImageID id) const;
+        void Erase(ImageID id);
+        void Clear();
+
+        // Blocks until every queued frame is compressed (tests / benchmarks)
+        void Flush();
+
+        struct Stats {
+            size_t entries = 0;
+            size_t queued = 0;          // Waiting for compression
+            size_t compressedBytes = 0; // Block bytes held
+            size_t rawBytes = 0;        // Decoded size of the held frames
+            size_t budgetBytes = 0;
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t evictions = 0;     // Dropped to stay in budget
+            double lastPromoteMs = 0.0;
+
+            double Ratio() const { return rawBytes ? (double)compressedBytes / rawBytes : 0.0; }
+        };
+        Stats GetStats() const;
+
+    private:
+        struct Entry {
+            std::shared_ptr<RawImageFrame> shell;  // Metadata only (pixels == nullptr)
+            std::shared_ptr<RawImageFrame> queued; // Uncompressed, waiting for the worker
+            std::vector<TileMemoryManager::SlabPtr> blocks;
+            std::vector<size_t> stripeOffsets;     // Into the concatenated block stream; back() == total
+            int stripeRows = 0;
+            int sourceIndex = -1;
+            size_t rawBytes = 0;
+            uint64_t serial = 0;                   // Distinguishes re-Put frames for the same path
+            std::list<ImageID>::iterator lru;
+        };
+
+        void WorkerLoop();
+        std::shared_ptr<RawImageFrame> Decompress(const Entry& entry);
+        void EraseLocked(std::unordered_map<ImageID, Entry>::iterator it);
+        bool EvictOneLocked(ImageID keep);
+
+        TileMemoryManager m_pool;
+        size_t m_budget;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::unordered_map<ImageID, Entry> m_entries;
+        std::list<ImageID> m_lru;          // Most recently evicted from hot at front
+        std::list<ImageID> m_pending;      // Compression order
+        bool m_busy = false;               // Worker is compressing outside the lock
+        bool m_stop = false;
+        uint64_t m_putSerial = 0;
+
+        size_t m_compressedBytes = 0;
+        size_t m_rawBytes = 0;
+        uint64_t m_hits = 0;
+        uint64_t m_misses = 0;
+        uint64_t m_evictions = 0;
+        double m_lastPromoteMs = 0.0;
+
+        std::thread m_worker;
+    };
+
+} // namespace QuickView
@@ -10,40 +10,6 @@ using Microsoft::WRL::ComPtr;
 
 namespace QuickView {
 
-struct alignas(16) ToneMapSettings {
-    float contentPeakScRgb;
-    float displayPeakScRgb;
-    float paperWhiteScRgb;
-    float exposure;
-
-    float exposureGain;
-    uint32_t mode;
-    float splineSrcPivot;
-    float splineDstPivot;
-
-    float splinePa;
-    float splinePb;
-    float splineQa;
-    float splineQb;
-
-    float splineQc;
-    uint32_t isHdrOutput;           // 1: HDR/Sim, 0: SDR
-    float realHardwarePeakScRgb;    // Actual display peak in ScRGB
-    uint32_t transferFunction;      // Enum QuickView::TransferFunction
-
-    float desatThreshold;           // [v6.1.4.24] New desaturation threshold
-    float desatStrength;            // [v6.1.4.24] New desaturation strength
-    float sceneAvgPq;               // Scene average luminance in PQ space
-    float mappedAvgPq;              // Mapped scene average luminance in PQ space
-
-    float contrastRecovery;         // Contrast recovery strength (defaults to 0.30)
-    float _pad[3];                  // Keep colorMatrix 16-byte aligned
-
-    float colorMatrix[16];          // float4x4 layout: 3x3 matrix stored as 4 rows of float4 for HLSL alignment
-};
-static_assert(sizeof(ToneMapSettings) == 160, "CB must be exactly 160 bytes to match HLSL float4x4 layout");
-
-
 struct GamutMaskReadback {
     int width = 0;
     int height = 0;
@@ -90,6 +90,7 @@ struct HdrStaticMetadata {
     float gainMapAppliedHeadroom = 0.0f;
 };
 
+#ifdef _WIN32
 struct DisplayColorState {
     HMONITOR monitor = nullptr;
     std::wstring gdiDeviceName;
@@ -149,6 +150,7 @@ private:
 
     DisplayColorState m_state;
 };
+#endif // _WIN32
 
 const wchar_t* ToString(TransferFunction value);
 const wchar_t* ToString(ColorPrimaries value);
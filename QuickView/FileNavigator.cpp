@@ -460,7 +460,7 @@ std::wstring FileNavigator::GetResolvedPath(const std::wstring& requestedPath) c
     return requestedPath;
 }
 
-int FileNavigator::FindIndex(const std::wstring& path) const {
+int FileNavigator::FindIndex(std::wstring_view path) const {
     // Handle virtual path matching where we might be passed just the archive path from OS
     if (m_archive && m_archive->IsValid()) {
         if (path == m_archivePath) {
@@ -16,22 +16,13 @@
 #include "exif.h"      // for easyexif
 #include "SupportedExtensions.h" // Unified supported extensions
 #include "ArchiveVFS.h"
+#include "PathTable.h"     // [ImageID] ImageID type and ComputePathHash
 
 #pragma comment(lib, "Shlwapi.lib")
 
 // [Directory Watcher] Custom window message posted when background scan completes
 constexpr UINT WM_NAVIGATOR_DIR_CHANGED = WM_APP + 50;
 
-// [ImageID Architecture] Stable content-based unique identifier
-using ImageID = size_t;  // 64-bit path hash
-
-// Helper: Compute normalized path hash (case-insensitive for Windows)
-inline ImageID ComputePathHash(const std::wstring& path) {
-    std::wstring normalized = path;
-    std::transform(normalized.begin(), normalized.end(), normalized.begin(), ::towlower);
-    return std::hash<std::wstring>{}(normalized);
-}
-
 class FileNavigator {
 public:
     // [RAW+JPEG Pairing] A RAW hidden behind its same-name rendered sibling
@@ -76,7 +67,7 @@ public:
     // Random Access (For Gallery Virtualization)
     const std::wstring& GetFile(int index) const;
     std::wstring GetResolvedPath(const std::wstring& requestedPath) const;
-    int FindIndex(const std::wstring& path) const;
+    int FindIndex(std::wstring_view path) const;
 
     // Virtual file system accessors
     inline bool IsVirtualPath(const std::wstring& path) const {
@@ -106,7 +97,7 @@ public:
     }
     
     // [ImageID] Compute hash from path (for external use)
-    static ImageID PathToImageID(const std::wstring& path) {
+    static ImageID PathToImageID(std::wstring_view path) {
         return ComputePathHash(path);
     }
 
@@ -3,14 +3,17 @@
 static constexpr const char* CURRENT_MODULE = "HeavyLanePool";
 #include "ImageEngine.h"
 #include "ImageLoaderSimd.h"
+#include "MipChain.h"
 #include "TileManager.h"
 #include "ToolProcessProtocol.h"
 #include <condition_variable>
 #include <semaphore>
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <new>
 #include "AnimationDecoder.h"
+#include "ProgressiveStream.h"
 #include <turbojpeg.h>
 #include <chrono>
 #include <winioctl.h>
@@ -19,7 +22,7 @@ static constexpr const char* CURRENT_MODULE = "HeavyLanePool";
 namespace {
     struct AuxLayerReadyCtx {
         HeavyLanePool* pool;
-        std::wstring path;
+        std::wstring_view path; // Interned (PathTable)
         ImageID id;
         PaneSlot targetSlot;
         uint64_t generationId;
@@ -33,6 +36,24 @@ namespace {
     struct SharedPtrCtx {
         std::shared_ptr<uint8_t[]> ptr;
     };
+
+    // [Streaming] A released partial frame parks its buffer here, so the next partial
+    // only copies the rows that were not yet final when that buffer was filled
+    struct PartialBufferPool {
+        std::mutex mutex;
+        std::unique_ptr<uint8_t[]> spare;
+        size_t spareBytes = 0;
+        int spareFinal = 0; // Rows [0, spareFinal) already match every later partial
+        int spareReady = 0; // Rows [spareReady, height) are still zero
+    };
+
+    // Consumed by the frame's deleter (RawImageFrame::Release never runs ctxDeleter)
+    struct PartialBufferCtx {
+        std::shared_ptr<PartialBufferPool> pool;
+        size_t bytes;
+        int rowsFinal;
+        int rowsReady;
+    };
 }
 
 
@@ -43,7 +64,8 @@ bool IsCopyOnlyLoaderName(const std::wstring& loaderName) {
     return loaderName.contains(L"LODCache Slice") ||
            loaderName.contains(L"Zero-Copy") ||
            loaderName.contains(L"RAM Copy") ||
-           loaderName.contains(L"MMF Copy");
+           loaderName.contains(L"MMF Copy") ||
+           loaderName.contains(L"MipChain Reduce");
 }
 }
 
@@ -64,9 +86,11 @@ HeavyLanePool::HeavyLanePool(ImageEngine* parent, CImageLoader* loader,
     // Pre-allocate worker slots
     m_workers.resize(m_cap);
     const size_t queueReserve = static_cast<size_t>(std::max(512, m_cap * 128));
-    m_pendingJobs.reserve(queueReserve);
+    m_jobQueue.Reset(std::max(1, m_cap));
     m_deferredTileJobs.reserve(queueReserve / 2);
     m_inFlightTiles.reserve(queueReserve);
+    // Pre-faulting is memory-bandwidth bound; a few threads saturate it
+    m_prefaultThreads = std::clamp((int)std::thread::hardware_concurrency() / 4, 1, 4);
     
     // [Phase 4] Create Job Object for zombie prevention.
     // JOB_OBJECT_LIMIT_KILL_ON_JOB_CLOSE: when this handle is closed
@@ -168,6 +192,7 @@ void HeavyLanePool::SetTitanMode(bool enabled, int srcW, int srcH, const std::ws
 
 void HeavyLanePool::SetConcurrencyLimit(int limit) {
     m_concurrencyLimit = limit;
+    m_jobQueue.SetActiveLanes(limit > 0 ? limit : m_cap); // Deal new batches to admitted workers only
     // We don't need to force shrink here; WorkerLoop checks limit before starting work.
     // however, if we GROW the limit, we must wake up sleeping workers so they can check the new limit rule.
     // AND we must potentially spawn new workers if we were enforcing a strict count.
@@ -459,31 +484,28 @@ void HeavyLanePool::UpdateConcurrency(int decodeMs, std::chrono::steady_clock::t
 }
 
 void HeavyLanePool::Flush() {
-    std::lock_guard lock(m_poolMutex);
-    
+    // Increment generation first: anything stamped before it is dead, even a job a
+    // worker popped while we clear the queue
+    m_generationID.fetch_add(1); 
+
     // [Fix] Fix Leaked Active Count
     // We must count how many tile jobs are being discarded
     int discardedTiles = 0;
-    for (const auto& job : m_pendingJobs) {
+    m_jobQueue.Clear([&](const JobInfo& job) {
         if (job.type == JobType::Tile) discardedTiles++;
-    }
+    });
     if (discardedTiles > 0) {
         m_activeTileJobs.fetch_sub(discardedTiles);
     }
     
-    m_pendingJobs.clear(); // O(1) with vector
+    std::lock_guard lock(m_inFlightMutex);
     m_inFlightTiles.clear(); // [Dedup] Reset in-flight tracking
-    // Increment generation to invalidate any in-flight jobs that haven't started processing
-    m_generationID.fetch_add(1); 
     // We don't need to notify workers; existing workers will wake up, check GenID, and skip.
 }
 
 HeavyLanePool::~HeavyLanePool() {
     // Signal all workers to stop
-    {
-        std::lock_guard lock(m_poolMutex);
-        m_pendingJobs.clear();
-    }
+    m_jobQueue.Clear();
     
     // Stop shrinker first
     m_shrinker.request_stop();
@@ -539,13 +561,75 @@ void HeavyLanePool::ShrinkMemory() {
     m_tileMemory.Shrink();
 }
 
+void HeavyLanePool::HintFrameSize(ImageID imageId, int width, int height, const std::wstring& format) {
+    if (width <= 0 || height <= 0) return;
+
+    FrameHint hint;
+    hint.imageId = imageId;
+    hint.width = width;
+    hint.height = height;
+    // Float decoders (EXR / Radiance) hand back RGBA32F
+    hint.bytesPerPixel = (format == L"EXR" || format == L"HDR" || format == L"PIC") ? 16 : 4;
+    hint.isJpeg = (format == L"JPEG" || format == L"JPG");
+
+    size_t retain = 0;
+    {
+        std::lock_guard lock(m_frameHintMutex);
+        m_frameHint = hint;
+        m_arenaWorkingSet.Record(ArenaWorkingSet::PredictFrameBytes(width, height, hint.bytesPerPixel));
+        retain = m_arenaWorkingSet.RetainBytes();
+    }
+    // Both Heavy Arenas take turns as the decode target (SwapHeavy)
+    m_pool->GetActiveHeavyArena().SetRetainBytes(retain);
+    m_pool->GetBackHeavyArena().SetRetainBytes(retain);
+}
+
+void HeavyLanePool::PrecommitForDecode(QuantumArena& arena, ImageID imageId, bool isFullDecode, int targetW, int targetH) {
+    FrameHint hint;
+    {
+        std::lock_guard lock(m_frameHintMutex);
+        if (m_frameHint.imageId != imageId) return;
+        hint = m_frameHint;
+    }
+
+    int outW = hint.width, outH = hint.height;
+    if (!isFullDecode && hint.isJpeg && targetW > 0 && targetH > 0) {
+        // Mirrors LoadToFrameFromMemory: nearest n/8 IDCT factor to the fit scale
+        double scale = (std::min)((double)targetW / hint.width, (double)targetH / hint.height);
+        int n = std::clamp((int)std::lround(scale * 8.0), 1, 8);
+        outW = (hint.width * n + 7) / 8;
+        outH = (hint.height * n + 7) / 8;
+    }
+    // Other scaled decoders produce the full frame first and resize after
+    arena.Precommit(ArenaWorkingSet::PredictFrameBytes(outW, outH, hint.bytesPerPixel), m_prefaultThreads);
+}
+
 // ============================================================================
 // Task Submission
 // ============================================================================
 
-void HeavyLanePool::Submit(const std::wstring& path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, PaneSlot targetSlot, uint64_t generationId) {
+std::shared_ptr<const HeavyLanePool::ImageContext> HeavyLanePool::InternImage(std::wstring_view path, ImageID imageId, const std::shared_ptr<QuickView::MappedFile>& mmf) {
+    std::lock_guard lock(m_imageContextMutex);
+    for (size_t i = 0; i < m_imageContexts.size(); ++i) {
+        auto ctx = m_imageContexts[i].lock();
+        if (ctx && ctx->imageId == imageId && ctx->mmf == mmf && ctx->path == path) {
+            std::rotate(m_imageContexts.begin(), m_imageContexts.begin() + i, m_imageContexts.begin() + i + 1);
+            return ctx;
+        }
+    }
+
+    // Weak slots: a context (and its mapping) lives only as long as its jobs do
+    auto ctx = std::make_shared<const ImageContext>(ImageContext{ QuickView::PathTable::Instance().Intern(path).path, imageId, mmf });
+    m_imageContexts.insert(m_imageContexts.begin(), ctx);
+    if (m_imageContexts.size() > kImageContextSlots) m_imageContexts.pop_back();
+    return ctx;
+}
+
+void HeavyLanePool::Submit(std::wstring_view path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, PaneSlot targetSlot, uint64_t generationId) {
+    const QuickView::PathRef interned = QuickView::PathTable::Instance().Intern(path);
+
     // [Hardware] Update IO throttling based on target drive
-    bool isSSD = SystemInfo::IsSolidStateDrive(path);
+    bool isSSD = SystemInfo::IsSolidStateDrive(interned.c_str());
     UpdateIOLimit(isSSD ? m_cap : 2);
     
     // [Baseline Benchmark] Record IO type for concurrency adjustment
@@ -555,184 +639,243 @@ void HeavyLanePool::Submit(const std::wstring& path, ImageID imageId, std::share
     // [Revision 2] Trigger ONLY for the active image. Prefetch jobs (ID mismatch) 
     // are prohibited from destroying current Titan resources.
     if (m_isTitanMode.load(std::memory_order_relaxed) && imageId == m_activeTitanImageId.load(std::memory_order_relaxed)) {
-        EnsureMasterWarmup(path, imageId, mmf, targetSlot, generationId);
+        EnsureMasterWarmup(interned.path, imageId, mmf, targetSlot, generationId);
     }
 
-    std::lock_guard lock(m_poolMutex);
-    
     // Non-Titan: full decode only (JPEG upgrade path removed). Titan: scaled base layer.
     bool isFull = !m_isTitanMode;
 
-    // [Dedup] Prevent redundant decoding jobs in the pending queue
-    if (!m_isTitanMode) {
-        for (const auto& existing : m_pendingJobs) {
-        if (existing.type == JobType::Standard && existing.imageId == imageId && existing.targetSlot == targetSlot) {
-                // If the generation is old, we could update it. But simple dedup is fine.
-                // Just return if we already have it pending.
-                return;
-            }
-        }
-    }
-
     JobInfo job;
     job.type = JobType::Standard;
-    job.path = path;
+    job.image = InternImage(path, imageId, mmf);
     job.imageId = imageId;
     job.targetSlot = targetSlot;
     job.generationId = generationId;
     job.submitTime = std::chrono::steady_clock::now();
-    job.mmf = mmf;
     job.targetHdrHeadroomStops = m_targetHdrHeadroomStops.load(std::memory_order_relaxed);
     job.isFullDecode = isFull;
     job.priority = 200; 
+    job.critical = true;
     job.genID = m_generationID.load(); // [Smart Pull] Stamp Generation
-    
-    m_pendingJobs.push_back(job);
-    std::push_heap(m_pendingJobs.begin(), m_pendingJobs.end()); // O(log N)
+    job.cancelEpoch = m_cancelEpoch.load();
+
+    // [Dedup] Prevent redundant decoding jobs in the pending queue. Check and push
+    // are atomic, so concurrent submits of the same image cannot both enqueue.
+    // A queued prefetch of this image (possibly screen-sized) does not count as a
+    // duplicate: the full decode replaces it.
+    if (!m_isTitanMode) {
+        int superseded = 0;
+        const bool pushed = m_jobQueue.PushReplacing(
+            [&](const JobInfo& existing) {
+                return existing.type == JobType::Standard && existing.imageId == imageId &&
+                       existing.targetSlot == targetSlot && !existing.prefetch;
+            },
+            [&](const JobInfo& existing) {
+                return existing.type == JobType::Standard && existing.imageId == imageId && existing.prefetch;
+            },
+            [&](const JobInfo&) { superseded++; },
+            std::move(job));
+        m_cancelCount += superseded;
+        if (!pushed) return;
+    } else {
+        m_jobQueue.Push(std::move(job));
+    }
 
-    TryExpand();
+    // Publishing under m_poolMutex pairs with the wait predicate in WorkerLoop
+    {
+        std::lock_guard lock(m_poolMutex);
+        TryExpand();
+    }
     m_poolCv.notify_all(); // [Fix] notify_all required
 }
 
-void HeavyLanePool::SubmitFullDecode(const std::wstring& path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, PaneSlot targetSlot, uint64_t generationId) {
-    std::lock_guard lock(m_poolMutex);
-    
+void HeavyLanePool::SubmitFullDecode(std::wstring_view path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, PaneSlot targetSlot, uint64_t generationId) {
     JobInfo job;
     job.type = JobType::Standard;
-    job.path = path;
+    job.image = InternImage(path, imageId, mmf);
     job.imageId = imageId;
     job.targetSlot = targetSlot;
     job.generationId = generationId;
     job.submitTime = std::chrono::steady_clock::now();
-    job.mmf = mmf; 
     job.targetHdrHeadroomStops = m_targetHdrHeadroomStops.load(std::memory_order_relaxed);
     job.isFullDecode = true; 
     job.priority = 150; 
+    job.critical = true;
     job.genID = m_generationID.load();
+    job.cancelEpoch = m_cancelEpoch.load();
     
-    m_pendingJobs.push_back(job);
-    std::push_heap(m_pendingJobs.begin(), m_pendingJobs.end());
+    m_jobQueue.Push(std::move(job));
+
+    {
+        std::lock_guard lock(m_poolMutex);
+        TryExpand();
+    }
+    m_poolCv.notify_all();
+}
+
+void HeavyLanePool::SubmitPrefetch(std::wstring_view path, ImageID imageId, int targetW, int targetH,
+                                  std::shared_ptr<QuickView::MappedFile> mmf) {
+    JobInfo job;
+    job.type = JobType::Standard;
+    job.image = InternImage(path, imageId, mmf);
+    job.imageId = imageId;
+    job.submitTime = std::chrono::steady_clock::now();
+    job.targetHdrHeadroomStops = m_targetHdrHeadroomStops.load(std::memory_order_relaxed);
+    job.isFullDecode = targetW <= 0 || targetH <= 0;
+    job.prefetch = true;
+    job.targetW = job.isFullDecode ? 0 : targetW;
+    job.targetH = job.isFullDecode ? 0 : targetH;
+    job.priority = 100; // Below the current image's Submit / SubmitFullDecode
+    job.genID = m_generationID.load();
+    job.cancelEpoch = m_cancelEpoch.load();
 
-    TryExpand();
+    const bool pushed = m_jobQueue.PushUnique([&](const JobInfo& existing) {
+        return existing.type == JobType::Standard && existing.imageId == imageId;
+    }, std::move(job));
+    if (!pushed) return;
+
+    {
+        std::lock_guard lock(m_poolMutex);
+        TryExpand();
+    }
     m_poolCv.notify_all();
 }
 
-void HeavyLanePool::SubmitTile(const std::wstring& path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, TileCoord coord, RegionRequest region, int priority) {
-    std::lock_guard lock(m_poolMutex);
-    
+void HeavyLanePool::SubmitTile(std::wstring_view path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, TileCoord coord, RegionRequest region, int priority) {
     // [Dedup] Check if tile is already in-flight
     uint64_t tileHash = MakeTileHash(coord.col, coord.row, coord.lod);
-    const auto [_, inserted] = m_inFlightTiles.insert(tileHash);
-    if (!inserted) {
-        return; // Already queued or running
+    {
+        std::lock_guard lock(m_inFlightMutex);
+        const auto [_, inserted] = m_inFlightTiles.insert(tileHash);
+        if (!inserted) {
+            return; // Already queued or running
+        }
     }
 
     JobInfo job;
     job.type = JobType::Tile;
-    job.path = path;
+    job.image = InternImage(path, imageId, mmf);
     job.imageId = imageId;
     job.submitTime = std::chrono::steady_clock::now();
-    job.mmf = mmf; 
     job.targetHdrHeadroomStops = m_targetHdrHeadroomStops.load(std::memory_order_relaxed);
     job.tileCoord = coord;
     job.region = region;
     job.priority = priority; 
+    job.critical = true; // Single on-demand tile: someone is looking at it
     job.genID = m_generationID.load(); // [Smart Pull]
+    job.cancelEpoch = m_cancelEpoch.load();
     
-    m_pendingJobs.push_back(job);
-    std::push_heap(m_pendingJobs.begin(), m_pendingJobs.end());
-    
-    TryExpand();
+    // Count before publishing: a worker may finish it before Push returns
     m_activeTileJobs.fetch_add(1);
+    m_jobQueue.Push(std::move(job));
+    
+    {
+        std::lock_guard lock(m_poolMutex);
+        TryExpand();
+    }
     m_poolCv.notify_all(); // [Fix] notify_all required for filtered pool
 }
 
-void HeavyLanePool::SubmitPriorityTileBatch(const std::wstring& path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, const std::vector<TilePriorityRequest>& batch) {
+void HeavyLanePool::SubmitPriorityTileBatch(std::wstring_view path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, const std::vector<TilePriorityRequest>& batch) {
     if (batch.empty()) return;
     
     // [Optimization] IO Limit is already set in Submit() - skip per-batch probing.
     
-    std::lock_guard lock(m_poolMutex);
-    uint32_t currentGen = m_generationID.load();
+    const uint32_t currentGen = m_generationID.load();
+    const uint64_t cancelEpoch = m_cancelEpoch.load();
+    const auto image = InternImage(path, imageId, mmf);
+    const auto now = std::chrono::steady_clock::now();
+    const float headroom = m_targetHdrHeadroomStops.load(std::memory_order_relaxed);
     
-    int addedCount = 0;
-    m_pendingJobs.reserve(m_pendingJobs.size() + batch.size());
-    m_inFlightTiles.reserve(m_inFlightTiles.size() + batch.size());
-    for (const auto& item : batch) {
-        // [Dedup] Skip if this tile is already queued or being decoded
-        uint64_t tileHash = MakeTileHash(item.coord.col, item.coord.row, item.coord.lod);
-        if (!m_inFlightTiles.insert(tileHash).second) {
-            continue; // Already in-flight, skip duplicate
+    std::vector<JobInfo> jobs;
+    jobs.reserve(batch.size());
+    {
+        std::lock_guard lock(m_inFlightMutex);
+        m_inFlightTiles.reserve(m_inFlightTiles.size() + batch.size());
+        for (const auto& item : batch) {
+            // [Dedup] Skip if this tile is already queued or being decoded
+            uint64_t tileHash = MakeTileHash(item.coord.col, item.coord.row, item.coord.lod);
+            if (!m_inFlightTiles.insert(tileHash).second) {
+                continue; // Already in-flight, skip duplicate
+            }
+            
+            JobInfo& job = jobs.emplace_back();
+            job.type = JobType::Tile;
+            job.image = image;
+            job.imageId = imageId;
+            job.targetHdrHeadroomStops = headroom;
+            job.submitTime = now;
+            job.tileCoord = item.coord;
+            job.region = item.region;
+            job.priority = item.priority;
+            job.critical = item.critical;
+            job.genID = currentGen;
+            job.cancelEpoch = cancelEpoch;
         }
-        
-        JobInfo job;
-        job.type = JobType::Tile;
-        job.path = path;
-        job.imageId = imageId;
-        job.mmf = mmf;
-        job.targetHdrHeadroomStops = m_targetHdrHeadroomStops.load(std::memory_order_relaxed);
-        job.submitTime = std::chrono::steady_clock::now();
-        job.tileCoord = item.coord;
-        job.region = item.region;
-        job.priority = item.priority;
-        job.genID = currentGen;
-        m_pendingJobs.push_back(job);
-        addedCount++;
-    }
-    
-    if (addedCount == 0) return;
-    
-    // Bulk re-heapify (faster than individual push_heap)
-    std::make_heap(m_pendingJobs.begin(), m_pendingJobs.end());
-    
-    TryExpand();
-    m_activeTileJobs.fetch_add(addedCount);
+    }
+    
+    if (jobs.empty()) return;
+    
+    // Sorted once and dealt across worker lanes; visible tiles go through the injector
+    m_activeTileJobs.fetch_add((int)jobs.size());
+    m_jobQueue.PushBatch(jobs);
+    
+    {
+        std::lock_guard lock(m_poolMutex);
+        TryExpand();
+    }
     m_poolCv.notify_all();
 }
 
 // [Titan Engine] Batch Submission for MacroTiles
-void HeavyLanePool::SubmitTileBatch(const std::wstring& path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, const std::vector<std::pair<QuickView::TileCoord, QuickView::RegionRequest>>& batch, int priority) {
+void HeavyLanePool::SubmitTileBatch(std::wstring_view path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, const std::vector<std::pair<QuickView::TileCoord, QuickView::RegionRequest>>& batch, int priority) {
     if (batch.empty()) return;
 
     // [Optimization] IO Limit is already set in Submit() - skip per-batch probing.
 
-    std::lock_guard lock(m_poolMutex);
-    uint32_t currentGen = m_generationID.load();
-    int addedCount = 0;
+    const uint32_t currentGen = m_generationID.load();
+    const uint64_t cancelEpoch = m_cancelEpoch.load();
+    const auto image = InternImage(path, imageId, mmf);
+    const auto now = std::chrono::steady_clock::now();
+    const float headroom = m_targetHdrHeadroomStops.load(std::memory_order_relaxed);
 
-    m_pendingJobs.reserve(m_pendingJobs.size() + batch.size());
-    m_inFlightTiles.reserve(m_inFlightTiles.size() + batch.size());
+    std::vector<JobInfo> jobs;
+    jobs.reserve(batch.size());
+    {
+        std::lock_guard lock(m_inFlightMutex);
+        m_inFlightTiles.reserve(m_inFlightTiles.size() + batch.size());
 
-    for (const auto& item : batch) {
-        uint64_t tileHash = MakeTileHash(item.first.col, item.first.row, item.first.lod);
-        if (!m_inFlightTiles.insert(tileHash).second) {
-            continue;
-        }
+        for (const auto& item : batch) {
+            uint64_t tileHash = MakeTileHash(item.first.col, item.first.row, item.first.lod);
+            if (!m_inFlightTiles.insert(tileHash).second) {
+                continue;
+            }
 
-        JobInfo job;
-        job.type = JobType::Tile;
-        job.path = path;
-        job.imageId = imageId;
-        job.submitTime = std::chrono::steady_clock::now();
-        job.mmf = mmf;
-        job.targetHdrHeadroomStops = m_targetHdrHeadroomStops.load(std::memory_order_relaxed);
-        
-        job.tileCoord = item.first;
-        job.region = item.second;
-        job.priority = priority; // All share same priority
-        
-        job.genID = currentGen;
-        m_pendingJobs.push_back(job);
-        addedCount++;
+            JobInfo& job = jobs.emplace_back();
+            job.type = JobType::Tile;
+            job.image = image;
+            job.imageId = imageId;
+            job.submitTime = now;
+            job.targetHdrHeadroomStops = headroom;
+            
+            job.tileCoord = item.first;
+            job.region = item.second;
+            job.priority = priority; // All share same priority
+            
+            job.genID = currentGen;
+            job.cancelEpoch = cancelEpoch;
+        }
     }
 
-    if (addedCount == 0) return;
+    if (jobs.empty()) return;
 
-    // Bulk re-heapify
-    std::make_heap(m_pendingJobs.begin(), m_pendingJobs.end());
+    m_activeTileJobs.fetch_add((int)jobs.size());
+    m_jobQueue.PushBatch(jobs);
 
-    TryExpand();
-    m_activeTileJobs.fetch_add(addedCount);
+    {
+        std::lock_guard lock(m_poolMutex);
+        TryExpand();
+    }
     m_poolCv.notify_all();
 }
 // ============================================================================
@@ -740,29 +883,34 @@ void HeavyLanePool::SubmitTileBatch(const std::wstring& path, ImageID imageId, s
 // ============================================================================
 
 void HeavyLanePool::CancelOthers(ImageID currentId, PaneSlot targetSlot) {
-    std::lock_guard lock(m_poolMutex);
-    
-// 1. Clear Job Queue of non-matching IDs
-    auto it = m_pendingJobs.begin();
+    // 1. Clear Job Queue of non-matching IDs
     int removedTiles = 0;
-    while (it != m_pendingJobs.end()) {
-        if (it->targetSlot == targetSlot && it->imageId != currentId) {
-            if (it->type == JobType::Tile) {
+    std::vector<uint64_t> releasedTiles;
+    const size_t removed = m_jobQueue.RemoveIf(
+        [&](const JobInfo& job) { return job.targetSlot == targetSlot && job.imageId != currentId && !job.prefetch; },
+        [&](const JobInfo& job) {
+            if (job.type == JobType::Tile) {
                 removedTiles++;
-                // [Dedup] Remove from in-flight set
-                m_inFlightTiles.erase(MakeTileHash(it->tileCoord.col, it->tileCoord.row, it->tileCoord.lod));
+                releasedTiles.push_back(MakeTileHash(job.tileCoord.col, job.tileCoord.row, job.tileCoord.lod));
             }
-            it = m_pendingJobs.erase(it);
-            m_cancelCount++;
-        } else {
-            ++it;
-        }
+        });
+    if (!releasedTiles.empty()) {
+        // [Dedup] Remove from in-flight set
+        std::lock_guard lock(m_inFlightMutex);
+        for (uint64_t hash : releasedTiles) m_inFlightTiles.erase(hash);
     }
+    m_cancelCount += (int)removed;
     if (removedTiles > 0) m_activeTileJobs.fetch_sub(removedTiles);
     
+    std::lock_guard lock(m_poolMutex);
+    CancelMark& mark = m_cancelMarks[(int)targetSlot];
+    mark.epoch = ++m_cancelEpoch;
+    mark.keepId = currentId;
+    mark.keepNone = false;
+
     // 2. Stop BUSY workers working on old IDs
     for (auto& w : m_workers) {
-        if (w.state == WorkerState::BUSY && w.currentId != currentId) {
+        if (w.state == WorkerState::BUSY && w.currentId != currentId && !w.currentPrefetch) {
             w.stopSource.request_stop();
             // [Phase 4.1] Kill any active subprocess for this worker immediately
             if (w.activeWorkerProcess) {
@@ -774,16 +922,23 @@ void HeavyLanePool::CancelOthers(ImageID currentId, PaneSlot targetSlot) {
 }
 
 void HeavyLanePool::CancelAll() {
-    std::lock_guard lock(m_poolMutex);
-    
     int discardedTiles = 0;
-    for (const auto& job : m_pendingJobs) {
+    m_jobQueue.Clear([&](const JobInfo& job) {
         if (job.type == JobType::Tile) discardedTiles++;
-    }
+    });
     if (discardedTiles > 0) m_activeTileJobs.fetch_sub(discardedTiles);
     
-    m_pendingJobs.clear();
-    m_inFlightTiles.clear(); // [Dedup] Reset in-flight tracking
+    {
+        std::lock_guard lock(m_inFlightMutex);
+        m_inFlightTiles.clear(); // [Dedup] Reset in-flight tracking
+    }
+
+    std::lock_guard lock(m_poolMutex);
+    const uint64_t epoch = ++m_cancelEpoch;
+    for (CancelMark& mark : m_cancelMarks) {
+        mark.epoch = epoch;
+        mark.keepNone = true;
+    }
     for (auto& w : m_workers) {
         w.stopSource.request_stop();
         if (w.activeWorkerProcess) {
@@ -792,6 +947,33 @@ void HeavyLanePool::CancelAll() {
     }
 }
 
+void HeavyLanePool::RetainPrefetch(const std::vector<ImageID>& keep) {
+    auto kept = [&](ImageID id) { return std::find(keep.begin(), keep.end(), id) != keep.end(); };
+    const size_t removed = m_jobQueue.RemoveIf(
+        [&](const JobInfo& job) { return job.prefetch && !kept(job.imageId); },
+        [](const JobInfo&) {});
+    m_cancelCount += (int)removed;
+
+    std::lock_guard lock(m_poolMutex);
+    for (auto& w : m_workers) {
+        if (w.state == WorkerState::BUSY && w.currentPrefetch && !kept(w.currentId)) {
+            w.stopSource.request_stop();
+        }
+    }
+}
+
+bool HeavyLanePool::IsCancelledLocked(const JobInfo& job) const {
+    const CancelMark& mark = m_cancelMarks[(int)job.targetSlot];
+    return job.cancelEpoch < mark.epoch && (mark.keepNone || (job.imageId != mark.keepId && !job.prefetch));
+}
+
+void HeavyLanePool::ReleaseTileJob(const JobInfo& job) {
+    if (job.type != JobType::Tile) return;
+    m_activeTileJobs.fetch_sub(1);
+    std::lock_guard lock(m_inFlightMutex);
+    m_inFlightTiles.erase(MakeTileHash(job.tileCoord.col, job.tileCoord.row, job.tileCoord.lod));
+}
+
 // ============================================================================
 // Worker Loop
 // ============================================================================
@@ -811,17 +993,20 @@ void HeavyLanePool::ResumeDeferredJobs(ImageID imageId, int lod) {
         }
     }
     if (!toResume.empty()) {
-        std::lock_guard lock(m_poolMutex);
+        const size_t count = toResume.size();
         for (auto& job : toResume) {
-            m_pendingJobs.push_back(std::move(job));
+            job.critical = true; // Already waited for the LOD cache once
+        }
+        m_activeTileJobs.fetch_add((int)count);
+        m_jobQueue.PushBatch(toResume);
+        {
+            std::lock_guard lock(m_poolMutex);
+            TryExpand();
         }
-        std::make_heap(m_pendingJobs.begin(), m_pendingJobs.end());
-        TryExpand();
-        m_activeTileJobs.fetch_add((int)toResume.size());
         m_poolCv.notify_all();
         
         QV_LOG("Pool_ResumeDeferred",
-            TraceLoggingUInt64((uint64_t)toResume.size(), "Count"),
+            TraceLoggingUInt64((uint64_t)count, "Count"),
             TraceLoggingInt32(lod, "LOD"));
     }
 }
@@ -837,43 +1022,45 @@ void HeavyLanePool::WorkerLoop(int workerId, std::stop_token st) {
         JobInfo job;
         [[maybe_unused]] bool taken = false;
 
-        // Wait for job
-        {
+        // [Fix] Enforce Concurrency Limit at Wakeup
+        // High-index workers (e.g. 7) should NOT take jobs if limit is low (e.g. 4).
+        auto isAllowed = [&] {
+            int limit = m_concurrencyLimit.load();
+            return limit == 0 || workerId < limit;
+        };
+
+        // [Titan Perf] Take a job without the pool lock: injector / own lane / steal
+        if (!isAllowed() || !m_jobQueue.TryPop(workerId, &job)) {
+            // Wait for job. Submitters publish under m_poolMutex before notifying,
+            // so checking the queue under it cannot miss a wakeup.
+            // In Titan Mode, we persist even if empty (until stop_requested)
             std::unique_lock lock(m_poolMutex);
             m_poolCv.wait(lock, [&] {
-                // In Titan Mode, we persist even if empty (until stop_requested)
-                // But generally we wait until there IS a job or stop is requested.
-                // [Fix] Enforce Concurrency Limit at Wakeup
-                // High-index workers (e.g. 7) should NOT take jobs if limit is low (e.g. 4).
-                int limit = m_concurrencyLimit.load();
-                bool allowed = (limit == 0 || workerId < limit);
-                
-                return st.stop_requested() || (!m_pendingJobs.empty() && allowed);
+                return st.stop_requested() || (!m_jobQueue.Empty() && isAllowed());
             });
-            
-            if (st.stop_requested()) break;
-            if (m_pendingJobs.empty()) continue; // Spurious wake
-            
-            // Take job (Heap Pop)
-            std::pop_heap(m_pendingJobs.begin(), m_pendingJobs.end());
-            job = m_pendingJobs.back();
-            m_pendingJobs.pop_back();
-            
-            taken = true;
-            
-            // [Smart Pull] Check 1: Generation ID
-            // If job is from an old generation (before Flush), assert it's dead.
-            if (job.genID != m_generationID.load()) {
-                if (job.type == JobType::Tile) {
-                    m_activeTileJobs.fetch_sub(1);
-                    // [Dedup] Already under m_poolMutex
-                    m_inFlightTiles.erase(MakeTileHash(job.tileCoord.col, job.tileCoord.row, job.tileCoord.lod));
-                }
+            continue;
+        }
+        taken = true;
+
+        // [Smart Pull] Check 1: Generation ID
+        // If job is from an old generation (before Flush), assert it's dead.
+        if (job.genID != m_generationID.load()) {
+            ReleaseTileJob(job);
+            continue;
+        }
+
+        {
+            std::lock_guard lock(m_poolMutex);
+
+            // Popped just before CancelOthers/CancelAll swept the queue
+            if (IsCancelledLocked(job)) {
+                m_cancelCount++;
+                ReleaseTileJob(job);
                 continue;
             }
 
-            self.currentPath = job.path;
             self.currentId = job.imageId;  // [ImageID]
+            self.currentPrefetch = job.prefetch;
             self.stopSource = std::stop_source();  // Fresh stop source for this job
             self.state = WorkerState::BUSY;
             m_busyCount.fetch_add(1);
@@ -896,7 +1083,7 @@ void HeavyLanePool::WorkerLoop(int workerId, std::stop_token st) {
                      if (layer->GetState(job.tileCoord.col, job.tileCoord.row) == QuickView::TileStateCode::Empty) {
                          m_busyCount.fetch_sub(1);
                          m_activeTileJobs.fetch_sub(1);
-                         { std::lock_guard dlock(m_poolMutex); m_inFlightTiles.erase(MakeTileHash(job.tileCoord.col, job.tileCoord.row, job.tileCoord.lod)); }
+                         { std::lock_guard dlock(m_inFlightMutex); m_inFlightTiles.erase(MakeTileHash(job.tileCoord.col, job.tileCoord.row, job.tileCoord.lod)); }
                          self.state = WorkerState::STANDBY;
                          continue;
                      }
@@ -910,7 +1097,7 @@ void HeavyLanePool::WorkerLoop(int workerId, std::stop_token st) {
                      
                      m_busyCount.fetch_sub(1);
                      m_activeTileJobs.fetch_sub(1); 
-                     { std::lock_guard dlock(m_poolMutex); m_inFlightTiles.erase(MakeTileHash(job.tileCoord.col, job.tileCoord.row, job.tileCoord.lod)); }
+                     { std::lock_guard dlock(m_inFlightMutex); m_inFlightTiles.erase(MakeTileHash(job.tileCoord.col, job.tileCoord.row, job.tileCoord.lod)); }
                      self.state = WorkerState::STANDBY;
                      continue;
                  }
@@ -949,7 +1136,7 @@ void HeavyLanePool::WorkerLoop(int workerId, std::stop_token st) {
         if (!stillValid) {
             m_busyCount.fetch_sub(1);
             m_activeTileJobs.fetch_sub(1); 
-            { std::lock_guard dlock(m_poolMutex); m_inFlightTiles.erase(MakeTileHash(job.tileCoord.col, job.tileCoord.row, job.tileCoord.lod)); }
+            { std::lock_guard dlock(m_inFlightMutex); m_inFlightTiles.erase(MakeTileHash(job.tileCoord.col, job.tileCoord.row, job.tileCoord.lod)); }
             self.state = WorkerState::STANDBY;
             continue;
         }
@@ -985,7 +1172,7 @@ void HeavyLanePool::WorkerLoop(int workerId, std::stop_token st) {
         // [Fix Bug #85] Break the Race Condition. 
         // If this worker is exiting due to cancellation, but new jobs arrived 
         // while it was BUSY, we must wake a replacement worker to carry on.
-        if (!m_pendingJobs.empty()) {
+        if (!m_jobQueue.Empty()) {
             TryExpand();
         }
     }
@@ -1056,7 +1243,7 @@ void HeavyLanePool::TryExpand() {
     // Maintain (Active Workers == Pending Jobs + 1 Hot Spare)
     // Limits: Cannot exceed m_cap.
     
-    int pending = (int)m_pendingJobs.size();
+    int pending = (int)m_jobQueue.Size();
     int idle = 0;
     
     // Count current state
@@ -1182,14 +1369,14 @@ void HeavyLanePool::PerformDecode(int workerId, const JobInfo& job, std::stop_to
             if (isTile) {
                 pool->m_activeTileJobs.fetch_sub(1);
                 if (!deferred) {
-                    std::lock_guard dlock(pool->m_poolMutex);
+                    std::lock_guard dlock(pool->m_inFlightMutex);
                     pool->m_inFlightTiles.erase(MakeTileHash(coord.col, coord.row, coord.lod));
                 }
             }
         }
     } guard{ this, job.tileCoord, job.type == JobType::Tile };
 
-    if (job.path.empty()) return;
+    if (job.Path().empty()) return;
     
     auto start = std::chrono::high_resolution_clock::now();
 
@@ -1247,14 +1434,20 @@ void HeavyLanePool::PerformDecode(int workerId, const JobInfo& job, std::stop_to
     // Only reset the arena if we are the first and only job running on it right now.
     // (e.g. all background tile decoding for previous image finished).
     // Since we already incremented it, it will be exactly 1.
+    bool arenaFresh = false;
     if (arena.m_activeJobs.load(std::memory_order_acquire) == 1) {
         arena.Reset();
+        arenaFresh = true;
     }
 
          if (job.type == JobType::Standard) {
               // --- Standard Decode (Full/Scaled) ---
               int targetW = 0, targetH = 0;
-              if (!job.isFullDecode) {
+              if (!job.isFullDecode && job.targetW > 0 && job.targetH > 0) {
+                   // [Prefetch Planner] Placeholder tier: box chosen by ImageEngine
+                   targetW = job.targetW;
+                   targetH = job.targetH;
+              } else if (!job.isFullDecode) {
                    int screenW = GetSystemMetrics(SM_CXSCREEN);
                    int screenH = GetSystemMetrics(SM_CYSCREEN);
                    
@@ -1273,9 +1466,15 @@ void HeavyLanePool::PerformDecode(int workerId, const JobInfo& job, std::stop_to
                    targetW = (targetW + 7) & ~7;
                    targetH = (targetH + 7) & ~7;
                }
+
+              // [Arena Precommit] Commit + fault the predicted output before the decoder grows into it.
+              // Titan base layers go to the decode subprocess and leave the arena alone.
+              if (arenaFresh && !(m_isTitanMode && !job.isFullDecode && !job.prefetch && targetW > 0 && targetH > 0)) {
+                  PrecommitForDecode(arena, job.imageId, job.isFullDecode, targetW, targetH);
+              }
               
               // [Phase 3] Titan Mode: Route Base Layer to killable subprocess
-              if (m_isTitanMode && !job.isFullDecode && targetW > 0 && targetH > 0) {
+              if (m_isTitanMode && !job.isFullDecode && !job.prefetch && targetW > 0 && targetH > 0) {
                    bool expectsMasterCache = ShouldWarmupMasterBacking();
                    bool warmupResolved = false;
 
@@ -1302,8 +1501,8 @@ void HeavyLanePool::PerformDecode(int workerId, const JobInfo& job, std::stop_to
                             uint8_t* dstBuf = (uint8_t*)_aligned_malloc(dstSize, 32);
                             
                             if (dstBuf) {
-                                ImageLoaderSimd::ResizeBilinear(masterView, mW, mH, mS,
-                                                          dstBuf, targetW, targetH, (int)dstStride);
+                                ImageLoaderSimd::Resize(masterView, mW, mH, mS,
+                                                  dstBuf, targetW, targetH, (int)dstStride, ImageLoaderSimd::ResampleFilter::Box);
                                 
                                 rawFrame.pixels = dstBuf;
                                 rawFrame.width = targetW;
@@ -1339,6 +1538,15 @@ void HeavyLanePool::PerformDecode(int workerId, const JobInfo& job, std::stop_to
                    }
               }
 
+              // [Streaming] Slow source still arriving: show rows/scans as they decode
+              if (FAILED(hr) && !m_isTitanMode && !job.prefetch && job.Mmf() && !job.Mmf()->IsComplete()) {
+                  EmitStreamingPartials(job, cancelPred);
+                  if (cancelPred()) {
+                      m_cancelCount++;
+                      return;
+                  }
+              }
+
               // Inline decode (non-Titan, or subprocess fallback)
               if (FAILED(hr)) {
               // [Optimization] Use MMF if available (Zero-Copy)
@@ -1346,7 +1554,7 @@ void HeavyLanePool::PerformDecode(int workerId, const JobInfo& job, std::stop_to
               // For WIC formats (TIFF, AVIF, etc), loading from MMF via SHCreateMemStream COPIES the file,
               // leading to massive memory bloat/OOM for 1GB+ large files. Pass directly to file loader instead.
               {
-                  auto* ctx = new(std::nothrow) AuxLayerReadyCtx{ this, job.path, job.imageId, job.targetSlot, job.generationId };
+                  auto* ctx = new(std::nothrow) AuxLayerReadyCtx{ this, job.Path(), job.imageId, job.targetSlot, job.generationId };
                   if (ctx) {
                       rawFrame.onAuxLayerReady.ctx = ctx;
                       rawFrame.onAuxLayerReady.pfn = [](void* c, std::unique_ptr<QuickView::AuxLayer> aux, QuickView::GpuBlendOp op, QuickView::GpuShaderPayload payload) {
@@ -1368,8 +1576,11 @@ void HeavyLanePool::PerformDecode(int workerId, const JobInfo& job, std::stop_to
 
               const auto fmt = m_titanFormat.load();
               bool supportsMmfDecode = QuickView::SupportsTitanMemoryDecode(fmt);
+              // [Readahead] A buffered file is already in memory whatever its format: decoding
+              // from it costs no copy beyond the buffer, and skips a second read of the file.
+              if (!m_isTitanMode && job.Mmf() && job.Mmf()->IsBuffered()) supportsMmfDecode = true;
                                         
-              if (job.mmf && job.mmf->IsValid() && supportsMmfDecode) {
+              if (job.Mmf() && job.Mmf()->IsValid() && supportsMmfDecode) {
                    // [Fix] Animation probe for MMF path: animated files need an Animator
                    // lifecycle that LoadToFrameFromMemory cannot provide.
                    // This mirrors the ShouldProbeAnimatedBufferCodec pattern in LoadImageUnified.
@@ -1377,8 +1588,8 @@ void HeavyLanePool::PerformDecode(int workerId, const JobInfo& job, std::stop_to
                    // so we detect format directly from MMF magic bytes.
                    bool animResolved = false;
                    {
-                       const uint8_t* d = job.mmf->data();
-                       size_t sz = job.mmf->size();
+                       const uint8_t* d = job.Mmf()->data();
+                       size_t sz = job.Mmf()->size();
                        std::unique_ptr<IAnimationDecoder> animDecoder;
 
                        // Magic-byte format detection (mirrors DetectFormatFromContent)
@@ -1396,7 +1607,7 @@ void HeavyLanePool::PerformDecode(int workerId, const JobInfo& job, std::stop_to
                        else if (sz >= 12 && memcmp(d + 4, "ftypavif", 8) == 0)
                            animDecoder = CreateAvifAnimator(); // AVIF container
 
-                       if (animDecoder && animDecoder->Initialize(job.mmf, PixelFormat::BGRA8888)) {
+                       if (animDecoder && animDecoder->Initialize(job.Mmf(), PixelFormat::BGRA8888)) {
                            if (animDecoder->IsAnimated()) {
                                auto firstFrame = animDecoder->GetNextFrame();
                                if (firstFrame && firstFrame->pixels) {
@@ -1427,17 +1638,17 @@ void HeavyLanePool::PerformDecode(int workerId, const JobInfo& job, std::stop_to
                    }
 
                    if (!animResolved) {
-                       hr = m_loader->LoadToFrameFromMemory(job.mmf->data(), job.mmf->size(), &rawFrame, &arena, targetW, targetH, &loaderName, &meta);
+                       hr = m_loader->LoadToFrameFromMemory(job.Mmf()->data(), job.Mmf()->size(), &rawFrame, &arena, targetW, targetH, &loaderName, &meta);
                        if (FAILED(hr)) {
                            // Fallback to file if MMF decode fails
-                           hr = m_loader->LoadToFrame(job.path.c_str(), &rawFrame, &arena, targetW, targetH, &loaderName, cancelPred, &meta, !job.isFullDecode, m_isTitanMode, job.targetHdrHeadroomStops);
+                           hr = m_loader->LoadToFrame(job.Path().data(), &rawFrame, &arena, targetW, targetH, &loaderName, cancelPred, &meta, !job.isFullDecode, m_isTitanMode, job.targetHdrHeadroomStops);
                        } else {
                            // MMF Decode Success -> Trigger Touch-Up Prefetch!
-                           TriggerPrefetch(job.mmf);
+                           TriggerPrefetch(job.Mmf());
                        }
                    }
               } else {
-                   hr = m_loader->LoadToFrame(job.path.c_str(), &rawFrame, &arena, targetW, targetH, &loaderName, cancelPred, &meta, !job.isFullDecode, m_isTitanMode, job.targetHdrHeadroomStops);
+                   hr = m_loader->LoadToFrame(job.Path().data(), &rawFrame, &arena, targetW, targetH, &loaderName, cancelPred, &meta, !job.isFullDecode, m_isTitanMode, job.targetHdrHeadroomStops);
               }
               } // end FAILED(hr) inline fallback
               // [Baseline Benchmark] Measure performance from Standard (base layer) decode
@@ -1453,10 +1664,10 @@ void HeavyLanePool::PerformDecode(int workerId, const JobInfo& job, std::stop_to
                        
                        // [Perf] Detect Progressive JPEG for memory-aware concurrency
                        bool isProgressiveJPEG = false;
-                       if (job.mmf && job.mmf->IsValid()) {
+                       if (job.Mmf() && job.Mmf()->IsValid()) {
                            tjhandle probe = tj3Init(TJINIT_DECOMPRESS);
                            if (probe) {
-                               if (tj3DecompressHeader(probe, job.mmf->data(), job.mmf->size()) == 0) {
+                               if (tj3DecompressHeader(probe, job.Mmf()->data(), job.Mmf()->size()) == 0) {
                                    isProgressiveJPEG = (tj3Get(probe, TJPARAM_PROGRESSIVE) == 1);
                                }
                                tj3Destroy(probe);
@@ -1523,6 +1734,24 @@ void HeavyLanePool::PerformDecode(int workerId, const JobInfo& job, std::stop_to
                            if (SUCCEEDED(hr)) goto tile_decode_done;
                        }
                    }
+
+                   // [Mip Chain] Zooming out: reduce the finer tiles still in memory
+                   // instead of decoding this region again
+                   if (job.tileCoord.lod > 0 &&
+                       job.imageId == m_parent->m_currentImageId.load(std::memory_order_relaxed)) {
+                       if (auto tm = m_parent->GetTileManager()) {
+                           int imgW = 0, imgH = 0;
+                           tm->GetImageSize(&imgW, &imgH);
+                           const auto key = QuickView::TileKey::From(job.tileCoord.col, job.tileCoord.row, job.tileCoord.lod);
+                           if (QuickView::MipChain::BuildFromDescendants(key, imgW, imgH,
+                                   [&tm](QuickView::TileKey k) { return tm->GetReadyFrame(k); },
+                                   m_tileMemory, rawFrame)) {
+                               hr = S_OK;
+                               loaderName = L"MipChain Reduce";
+                               goto tile_decode_done;
+                           }
+                       }
+                   }
                    
                     // Format-aware strategy matrix:
                     // - JPEG baseline: native ROI is best.
@@ -1684,26 +1913,30 @@ void HeavyLanePool::PerformDecode(int workerId, const JobInfo& job, std::stop_to
                   int targetTileSize = 512; // [Fix] HARDCODED TILE_SIZE (matches TileManager.h)
                   
                   // [Native Region Processing Framework]
-                  if (job.mmf && job.mmf->IsValid()) {
+                  if (job.Mmf() && job.Mmf()->IsValid()) {
                       // Zero-Copy Direct Memory Parsing
                       if (titanFmt == QuickView::TitanFormat::JPEG) {
+                          // First tile of an image builds the index (one entropy pass or an RST scan);
+                          // tiles decoded meanwhile take the plain crop path
+                          auto entryIndex = m_jpegEntryIndex.Acquire(job.imageId, job.Mmf()->data(), job.Mmf()->size());
                           hr = CImageLoader::LoadTileFromMemory(
-                              job.mmf->data(), job.mmf->size(), 
-                              rect, scale, &rawFrame, &m_tileMemory, targetTileSize, targetTileSize
+                              job.Mmf()->data(), job.Mmf()->size(), 
+                              rect, scale, &rawFrame, &m_tileMemory, targetTileSize, targetTileSize,
+                              entryIndex.get()
                           );
                           loaderName = SUCCEEDED(hr) ? L"TurboJPEG (MMF)" : L"MMF Failed -> Fallback";
                       } else if (titanFmt == QuickView::TitanFormat::WEBP) {
                           // [Native ROI] WebP Memory Decode
                           hr = m_loader->LoadWebPRegionToFrame(
-                              job.path.c_str(), rect, scale, &rawFrame, &m_tileMemory, nullptr, cancelPred, targetTileSize, targetTileSize,
-                              job.mmf->data(), job.mmf->size()
+                              job.Path().data(), rect, scale, &rawFrame, &m_tileMemory, nullptr, cancelPred, targetTileSize, targetTileSize,
+                              job.Mmf()->data(), job.Mmf()->size()
                           );
                           loaderName = SUCCEEDED(hr) ? L"WebP ROI (MMF)" : L"WebP Failed -> Fallback";
                       } else if (titanFmt == QuickView::TitanFormat::JXL) {
                           // [Native ROI] JXL Memory Decode (using underlying file mapped within loader for now)
                           hr = m_loader->LoadJxlRegionToFrame(
-                              job.path.c_str(), rect, scale, &rawFrame, &m_tileMemory, nullptr, cancelPred, targetTileSize, targetTileSize,
-                              job.mmf->data(), job.mmf->size()
+                              job.Path().data(), rect, scale, &rawFrame, &m_tileMemory, nullptr, cancelPred, targetTileSize, targetTileSize,
+                              job.Mmf()->data(), job.Mmf()->size()
                           );
                           loaderName = SUCCEEDED(hr) ? L"JXL ROI" : L"JXL Failed -> Fallback";
                       } else {
@@ -1712,12 +1945,12 @@ void HeavyLanePool::PerformDecode(int workerId, const JobInfo& job, std::stop_to
                       
                       // Fallback logic
                       if (FAILED(hr)) {
-                          hr = m_loader->LoadRegionToFrame(job.path.c_str(), rect, scale, &rawFrame, &m_tileMemory, nullptr /*arena*/, &loaderName, cancelPred, targetTileSize, targetTileSize);
+                          hr = m_loader->LoadRegionToFrame(job.Path().data(), rect, scale, &rawFrame, &m_tileMemory, nullptr /*arena*/, &loaderName, cancelPred, targetTileSize, targetTileSize);
                       }
                   } else {
                       // Fallback: File IO Path (Slow)
                       // [Titan] Use Shareable Slab Allocator
-                      hr = m_loader->LoadRegionToFrame(job.path.c_str(), rect, scale, &rawFrame, &m_tileMemory, nullptr /*arena*/, &loaderName,
+                      hr = m_loader->LoadRegionToFrame(job.Path().data(), rect, scale, &rawFrame, &m_tileMemory, nullptr /*arena*/, &loaderName,
                          cancelPred, targetTileSize, targetTileSize);
                   }
              }
@@ -1785,7 +2018,7 @@ tile_decode_done: ; // [P14] Jump target for fast path (skip legacy TJ decode)
             
             // Generate Event
             EngineEvent evt;
-            evt.filePath = job.path;
+            evt.filePath = job.Path();
             evt.imageId = job.imageId;
             evt.targetSlot = job.targetSlot;
             evt.generationId = job.generationId;
@@ -1903,7 +2136,7 @@ tile_decode_done: ; // [P14] Jump target for fast path (skip legacy TJ decode)
                 // This allows ImageEngine to capture hr=0xC00D5212 and show the prompt.
                 EngineEvent evt;
                 evt.type = EventType::LoadError;
-                evt.filePath = job.path;
+                evt.filePath = job.Path();
                 evt.imageId = job.imageId;
                 evt.targetSlot = job.targetSlot;
                 evt.generationId = job.generationId;
@@ -1935,29 +2168,151 @@ tile_decode_done: ; // [P14] Jump target for fast path (skip legacy TJ decode)
 // Result Queue
 // ============================================================================
 
+void HeavyLanePool::EmitStreamingPartials(const JobInfo& job, CImageLoader::CancelPredicate checkCancel) {
+    const auto& mmf = job.Mmf();
+
+    QuickView::StreamingSource src;
+    src.data = mmf->PartialData();
+    src.size = mmf->size();
+    src.ctx = mmf.get();
+    src.waitForBytes = [](void* c, size_t bytes) { return static_cast<QuickView::MappedFile*>(c)->WaitForBytes(bytes); };
+
+    struct EmitCtx {
+        HeavyLanePool* pool;
+        const JobInfo* job;
+        int count;
+        std::shared_ptr<PartialBufferPool> buffers;
+    } ctx{ this, &job, 0, std::make_shared<PartialBufferPool>() };
+
+    QuickView::PartialFrameCallback onPartial;
+    onPartial.ctx = &ctx;
+    onPartial.pfn = [](void* c, const QuickView::PartialFrame& f) {
+        auto* e = static_cast<EmitCtx*>(c);
+        const size_t bufferSize = (size_t)f.stride * f.height;
+
+        // Own copy: the streamer keeps writing into its buffer. A recycled buffer only
+        // needs the rows that were not final when it was filled (progressive scans
+        // report none final, so they recopy the frame)
+        const int rowsReady = (std::clamp)(f.rowsReady, 0, f.height);
+        const int rowsFinal = (std::clamp)(f.rowsFinal, 0, rowsReady);
+        std::unique_ptr<uint8_t[]> heapPixels;
+        int firstRow = 0;
+        {
+            std::lock_guard lock(e->buffers->mutex);
+            if (e->buffers->spare && e->buffers->spareBytes == bufferSize && e->buffers->spareReady <= rowsReady) {
+                heapPixels = std::move(e->buffers->spare);
+                firstRow = e->buffers->spareFinal;
+            }
+            e->buffers->spare.reset(); // Unusable (other size or further along): drop it
+        }
+        if (!heapPixels) {
+            heapPixels.reset(new (std::nothrow) uint8_t[bufferSize]());
+            if (!heapPixels) return;
+        }
+        if (rowsReady > firstRow) {
+            memcpy(heapPixels.get() + (size_t)firstRow * f.stride, f.pixels + (size_t)firstRow * f.stride,
+                   (size_t)(rowsReady - firstRow) * f.stride);
+        }
+
+        auto* bufferCtx = new (std::nothrow) PartialBufferCtx{ e->buffers, bufferSize, rowsFinal, rowsReady };
+        if (!bufferCtx) return;
+
+        auto safeFrame = std::make_shared<QuickView::RawImageFrame>();
+        safeFrame->pixels = heapPixels.release();
+        safeFrame->width = f.width;
+        safeFrame->height = f.height;
+        safeFrame->stride = f.stride;
+        safeFrame->format = PixelFormat::BGRA8888;
+        safeFrame->quality = QuickView::DecodeQuality::Preview;
+        safeFrame->srcWidth = f.srcWidth;
+        safeFrame->srcHeight = f.srcHeight;
+        safeFrame->memoryDeleter.ctx = bufferCtx;
+        safeFrame->memoryDeleter.pfn = [](uint8_t* p, void* c) {
+            std::unique_ptr<PartialBufferCtx> bc(static_cast<PartialBufferCtx*>(c));
+            std::unique_ptr<uint8_t[]> pixels(p);
+            std::lock_guard lock(bc->pool->mutex);
+            if (!bc->pool->spare) {
+                bc->pool->spare = std::move(pixels);
+                bc->pool->spareBytes = bc->bytes;
+                bc->pool->spareFinal = bc->rowsFinal;
+                bc->pool->spareReady = bc->rowsReady;
+            }
+        };
+
+        EngineEvent evt;
+        evt.type = EventType::PreviewReady;
+        evt.filePath = e->job->Path();
+        evt.imageId = e->job->imageId;
+        evt.targetSlot = e->job->targetSlot;
+        evt.generationId = e->job->generationId;
+        evt.loaderName = L"Streaming";
+        evt.rawFrame = std::move(safeFrame);
+        evt.metadata.Width = f.srcWidth;
+        evt.metadata.Height = f.srcHeight;
+        evt.metadata.LoaderName = L"Streaming";
+        e->pool->QueueResult(std::move(evt));
+        e->count++;
+    };
+
+    const auto outcome = QuickView::StreamPartialFrames(src, QuickView::StreamingOptions{}, onPartial, checkCancel);
+
+    QV_LOG("Worker_Streaming",
+        TraceLoggingInt32((int)outcome, "Outcome"),
+        TraceLoggingInt32(ctx.count, "Partials"),
+        TraceLoggingUInt64((uint64_t)mmf->BytesAvailable(), "BytesAvailable"));
+}
+
 void HeavyLanePool::QueueResult(EngineEvent&& evt) {
-    bool shouldNotify = false;
-    {
+    const ResultTag tag{ evt.imageId, evt.type == EventType::TileReady };
+
+    // Tile finished after navigation: drop it before it costs the UI thread anything
+    if (tag.isTile && m_parent && tag.imageId != m_parent->m_currentImageId.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // Once anything overflowed, later results follow it until the UI thread drains
+    // the deque, so completion order is kept
+    const bool inRing = m_resultOverflowCount.load(std::memory_order_acquire) == 0 &&
+                        m_resultRing.TryPush(evt, tag);
+    if (!inRing) {
         std::lock_guard lock(m_resultMutex);
-        // [Fix11] Coalesce: Only notify main thread when queue transitions empty→non-empty.
-        // PollState's while-loop drains all results, so one PostMessage suffices.
-        shouldNotify = m_results.empty();
         m_results.push_back(std::move(evt));
+        m_resultOverflowCount.fetch_add(1, std::memory_order_release);
     }
     
-    // Notify main thread (only on first queued item)
-    if (shouldNotify && m_parent) {
+    // [Fix11] Coalesce: Only notify main thread when no wakeup is outstanding.
+    // DrainResults re-arms the flag before it drains, so one PostMessage suffices.
+    if (!m_resultSignalPending.exchange(true, std::memory_order_acq_rel) && m_parent) {
         m_parent->QueueEvent(EngineEvent{});  // Trigger WM_ENGINE_EVENT
     }
 }
 
-std::optional<EngineEvent> HeavyLanePool::TryPopResult() {
-    std::lock_guard lock(m_resultMutex);
-    if (m_results.empty()) return std::nullopt;
-    
-    auto evt = std::move(m_results.front());
-    m_results.pop_front();
-    return evt;
+size_t HeavyLanePool::DrainResults(ImageID currentImageId, std::vector<EngineEvent>& out) {
+    // RMW on the flag: a producer either sees it cleared (and posts again) or its
+    // publication is visible to the drain below
+    m_resultSignalPending.exchange(false, std::memory_order_acq_rel);
+
+    auto isStale = [currentImageId](const ResultTag& tag) {
+        return tag.isTile && tag.imageId != currentImageId;
+    };
+    size_t dropped = m_resultRing.Drain(isStale, [&](EngineEvent&& evt, const ResultTag&) {
+        out.push_back(std::move(evt));
+    });
+
+    // Overflow holds newer results than the ring; wait for in-flight ring slots first
+    if (m_resultOverflowCount.load(std::memory_order_acquire) > 0 && m_resultRing.EmptyApprox()) {
+        std::lock_guard lock(m_resultMutex);
+        for (auto& evt : m_results) {
+            if (isStale(ResultTag{ evt.imageId, evt.type == EventType::TileReady })) {
+                dropped++;
+                continue;
+            }
+            out.push_back(std::move(evt));
+        }
+        m_resultOverflowCount.fetch_sub((int)m_results.size(), std::memory_order_release);
+        m_results.clear();
+    }
+    return dropped;
 }
 
 // ============================================================================
@@ -1985,8 +2340,7 @@ HeavyLanePool::PoolStats HeavyLanePool::GetStats() const {
         }
     }
     
-    std::lock_guard lock(m_poolMutex);
-    stats.pendingJobs = static_cast<int>(m_pendingJobs.size());
+    stats.pendingJobs = static_cast<int>(m_jobQueue.Size());
     
     return stats;
 }
@@ -2035,7 +2389,7 @@ bool HeavyLanePool::IsIdle() const {
     std::lock_guard lock(m_poolMutex);
     // [Fix] Background warmup is only "busy" if it's joinable AND not yet ready.
     bool warmingUp = m_masterWarmupThread.joinable() && !m_masterWarmupReady.load();
-    return m_busyCount.load() == 0 && m_pendingJobs.empty() && !warmingUp;
+    return m_busyCount.load() == 0 && m_jobQueue.Empty() && !warmingUp;
 }
 
 // ============================================================================
@@ -2127,7 +2481,7 @@ void HeavyLanePool::StopMasterWarmup() {
     m_lodCacheCond.notify_all(); // Wake any waiters so they can re-check
 }
 
-void HeavyLanePool::EnsureMasterWarmup(const std::wstring& path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, PaneSlot targetSlot, uint64_t generationId) {
+void HeavyLanePool::EnsureMasterWarmup(std::wstring_view path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, PaneSlot targetSlot, uint64_t generationId) {
     if (!ShouldWarmupMasterBacking()) return;
     if (!mmf || !mmf->IsValid()) return;
 
@@ -2288,7 +2642,7 @@ void HeavyLanePool::EnsureMasterWarmup(const std::wstring& path, ImageID imageId
                     auto* wc = static_cast<WarmupCancelCtx*>(c);
                     return wc->st->stop_requested() || wc->genId->load(std::memory_order_acquire) != wc->gen;
                 };
-                hr = m_loader->LoadToFrame(path.c_str(), &fullFrame, nullptr, 0, 0, nullptr, warmupCancel, nullptr, true, false, m_targetHdrHeadroomStops.load(std::memory_order_relaxed));
+                hr = m_loader->LoadToFrame(path.data(), &fullFrame, nullptr, 0, 0, nullptr, warmupCancel, nullptr, true, false, m_targetHdrHeadroomStops.load(std::memory_order_relaxed));
             }
 
             if (st.stop_requested()) return;
@@ -2881,7 +3235,7 @@ HRESULT HeavyLanePool::LaunchDecodeWorker(
     using QuickView::ToolProcess::DecodeResultHeader;
     constexpr uint64_t kHeaderBytes = sizeof(DecodeResultHeader);
 
-    if (job.path.empty()) return E_INVALIDARG;
+    if (job.Path().empty()) return E_INVALIDARG;
     if (targetW <= 0 || targetH <= 0) return E_INVALIDARG;
     if (checkCancel && checkCancel()) return E_ABORT;
 
@@ -2930,7 +3284,7 @@ HRESULT HeavyLanePool::LaunchDecodeWorker(
     std::wstring cmdLine = L"\"";
     cmdLine += exePath;
     cmdLine += L"\" --decode-worker --input \"";
-    cmdLine += job.path;
+    cmdLine += job.Path();
     cmdLine += L"\" --out-map \"";
     cmdLine += mapName;
     cmdLine += L"\" --target-w ";
@@ -3104,7 +3458,7 @@ HRESULT HeavyLanePool::LaunchDecodeWorker(
 }
 
 HRESULT HeavyLanePool::FullDecodeAndCacheLOD(Worker& worker, const JobInfo& job, RawImageFrame& outTile, std::wstring& loader, CImageLoader::CancelPredicate checkCancel) {
-    if (!job.mmf || !job.mmf->IsValid()) return E_FAIL;
+    if (!job.Mmf() || !job.Mmf()->IsValid()) return E_FAIL;
     if (m_titanSrcW <= 0 || m_titanSrcH <= 0) return E_FAIL;
     if (checkCancel && checkCancel()) return E_ABORT;
     
@@ -3176,7 +3530,7 @@ HRESULT HeavyLanePool::FullDecodeAndCacheLOD(Worker& worker, const JobInfo& job,
     if (m_titanFormat.load() == QuickView::TitanFormat::JPEG) {
         // JPEG: use TurboJPEG with IDCT scaling (scale parameter is used)
         hr = CImageLoader::LoadTileFromMemory(
-            job.mmf->data(), job.mmf->size(),
+            job.Mmf()->data(), job.Mmf()->size(),
             fullRegion, scale,
             &fullFrame, nullptr, 0, 0);
     } else {
@@ -3220,9 +3574,16 @@ HRESULT HeavyLanePool::FullDecodeAndCacheLOD(Worker& worker, const JobInfo& job,
                     // when available — pixel count is 1/4 of master, massive speedup.
                     if (cascadeSource.pixels && cascadeSource.lod == lod - 1
                         && cascadeSource.width > 0 && cascadeSource.height > 0) {
-                        ImageLoaderSimd::ResizeBilinear(
-                            cascadeSource.pixels.get(), cascadeSource.width, cascadeSource.height,
-                            cascadeSource.stride, dstBuf, targetW, targetH, (int)dstStride);
+                        // ceil(ceil(W / 2^(l-1)) / 2) == ceil(W / 2^l): always one exact mip step
+                        if ((cascadeSource.width + 1) / 2 == targetW && (cascadeSource.height + 1) / 2 == targetH) {
+                            ImageLoaderSimd::Downsample2x(
+                                cascadeSource.pixels.get(), cascadeSource.width, cascadeSource.height,
+                                cascadeSource.stride, dstBuf, (int)dstStride);
+                        } else {
+                            ImageLoaderSimd::Resize(
+                                cascadeSource.pixels.get(), cascadeSource.width, cascadeSource.height,
+                                cascadeSource.stride, dstBuf, targetW, targetH, (int)dstStride, ImageLoaderSimd::ResampleFilter::Box);
+                        }
                         QV_LOG("P15_MasterRoute",
                             TraceLoggingString("CascadedDownscale", "Action"),
                             TraceLoggingInt32(cascadeSource.width, "SrcW"),
@@ -3231,8 +3592,8 @@ HRESULT HeavyLanePool::FullDecodeAndCacheLOD(Worker& worker, const JobInfo& job,
                             TraceLoggingInt32(targetH, "DstH"),
                             TraceLoggingInt32(lod, "LOD"));
                     } else {
-                        ImageLoaderSimd::ResizeBilinear(masterPixelsView, masterW, masterH,
-                                                  masterStride, dstBuf, targetW, targetH, (int)dstStride);
+                        ImageLoaderSimd::Resize(masterPixelsView, masterW, masterH,
+                                          masterStride, dstBuf, targetW, targetH, (int)dstStride, ImageLoaderSimd::ResampleFilter::Box);
                         QV_LOG("P15_MasterRoute",
                             TraceLoggingString("InstantDownscale", "Action"),
                             TraceLoggingInt32(targetW, "Width"),
@@ -3331,8 +3692,8 @@ HRESULT HeavyLanePool::FullDecodeAndCacheLOD(Worker& worker, const JobInfo& job,
                     
                     if (dstBuf) {
                         if (lod > 0) {
-                            ImageLoaderSimd::ResizeBilinear(masterView, mW, mH, mS,
-                                                      dstBuf, targetW, targetH, (int)dstStride);
+                            ImageLoaderSimd::Resize(masterView, mW, mH, mS,
+                                              dstBuf, targetW, targetH, (int)dstStride, ImageLoaderSimd::ResampleFilter::Box);
                         } else {
                             for (int y = 0; y < targetH; ++y) {
                                 memcpy(dstBuf + (size_t)y * dstStride,
@@ -3388,7 +3749,7 @@ HRESULT HeavyLanePool::FullDecodeAndCacheLOD(Worker& worker, const JobInfo& job,
                 const int targetW = (m_titanSrcW + (1 << lod) - 1) / (1 << lod);
                 const int targetH = (m_titanSrcH + (1 << lod) - 1) / (1 << lod);
                 {
-                    auto* ctx = new(std::nothrow) AuxLayerReadyCtx{ this, job.path, job.imageId, job.targetSlot, job.generationId };
+                    auto* ctx = new(std::nothrow) AuxLayerReadyCtx{ this, job.Path(), job.imageId, job.targetSlot, job.generationId };
                     if (ctx) {
                         fullFrame.onAuxLayerReady.ctx = ctx;
                         fullFrame.onAuxLayerReady.pfn = [](void* c, std::unique_ptr<QuickView::AuxLayer> aux, QuickView::GpuBlendOp op, QuickView::GpuShaderPayload payload) {
@@ -3407,7 +3768,7 @@ HRESULT HeavyLanePool::FullDecodeAndCacheLOD(Worker& worker, const JobInfo& job,
                         fullFrame.onAuxLayerReady.ctxDeleter = [](void* c) { delete static_cast<AuxLayerReadyCtx*>(c); };
                     }
                 }
-                hr = m_loader->LoadToFrame(job.path.c_str(), &fullFrame, nullptr, targetW, targetH, &loader, checkCancel, nullptr, true, false, job.targetHdrHeadroomStops);
+                hr = m_loader->LoadToFrame(job.Path().data(), &fullFrame, nullptr, targetW, targetH, &loader, checkCancel, nullptr, true, false, job.targetHdrHeadroomStops);
                 if (SUCCEEDED(hr)) {
                     loader = L"WIC(LOD-Fallback)";
                     QV_LOG("Worker_Route", TraceLoggingString("Phase4 InlineWIC FallbackSuccess", "Action"));
@@ -3468,8 +3829,8 @@ HRESULT HeavyLanePool::FullDecodeAndCacheLOD(Worker& worker, const JobInfo& job,
                         if (!dstBuf) {
                             hr = E_OUTOFMEMORY;
                         } else {
-                            ImageLoaderSimd::ResizeBilinear(frameSharedPtr.get(), fullFrame.width, fullFrame.height,
-                                                      fullFrame.stride, dstBuf, targetW, targetH, (int)dstStride);
+                            ImageLoaderSimd::Resize(frameSharedPtr.get(), fullFrame.width, fullFrame.height,
+                                              fullFrame.stride, dstBuf, targetW, targetH, (int)dstStride, ImageLoaderSimd::ResampleFilter::Box);
                             
                             fullFrame.pixels = dstBuf;
                             fullFrame.width = targetW;
@@ -5,6 +5,9 @@
 #include "MemoryArena.h"
 #include "SystemInfo.h"
 #include "TileMemoryManager.h" // [Titan]
+#include "JpegEntryIndex.h"
+#include "StealingJobQueue.h"
+#include "MpscEventRing.h"
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
@@ -68,33 +71,46 @@ public:
     // === Task Submission ===
     // Thread-safe. Will auto-expand if needed.
     // [ImageID] Uses stable path hash instead of incrementing token
-    void Submit(const std::wstring& path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf = nullptr, PaneSlot targetSlot = PaneSlot::Primary, uint64_t generationId = 0);
+    void Submit(std::wstring_view path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf = nullptr, PaneSlot targetSlot = PaneSlot::Primary, uint64_t generationId = 0);
     
     // Full resolution decode (no scaling)
-    void SubmitFullDecode(const std::wstring& path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf = nullptr, PaneSlot targetSlot = PaneSlot::Primary, uint64_t generationId = 0);
+    void SubmitFullDecode(std::wstring_view path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf = nullptr, PaneSlot targetSlot = PaneSlot::Primary, uint64_t generationId = 0);
+    
+    // [Prefetch Planner] Background decode of a neighbour. Survives CancelOthers (navigation);
+    // RetainPrefetch drops the ones the new plan no longer lists. targetW/targetH > 0 asks
+    // the decoder for a downscale into that box (placeholder tier), else full resolution.
+    // mmf is the window's readahead buffer for the file, if one was issued.
+    void SubmitPrefetch(std::wstring_view path, ImageID imageId, int targetW = 0, int targetH = 0,
+                        std::shared_ptr<QuickView::MappedFile> mmf = nullptr);
     
     // [Titan Engine] Submit a tile decode task
-    void SubmitTile(const std::wstring& path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, QuickView::TileCoord coord, QuickView::RegionRequest region, int priority = 0);
+    void SubmitTile(std::wstring_view path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, QuickView::TileCoord coord, QuickView::RegionRequest region, int priority = 0);
     
     struct TilePriorityRequest {
         QuickView::TileCoord coord;
         QuickView::RegionRequest region;
         int priority;
+        bool critical = false; // Intersects the viewport: dispatched ahead of worker lanes
     };
 
     // [Optimization] Submit multiple tiles with INDIVIDUAL priorities in one lock
-    void SubmitPriorityTileBatch(const std::wstring& path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, const std::vector<TilePriorityRequest>& batch);
+    void SubmitPriorityTileBatch(std::wstring_view path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, const std::vector<TilePriorityRequest>& batch);
 
     // [Titan Engine] Batch Submission for MacroTiles (reduces locking overhead)
-    void SubmitTileBatch(const std::wstring& path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, const std::vector<std::pair<QuickView::TileCoord, QuickView::RegionRequest>>& batch, int priority = 0);
+    void SubmitTileBatch(std::wstring_view path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, const std::vector<std::pair<QuickView::TileCoord, QuickView::RegionRequest>>& batch, int priority = 0);
     
     // === Cancellation ===
     // [ImageID] Cancel tasks that don't match the current imageId
     void CancelOthers(ImageID currentId, PaneSlot targetSlot = PaneSlot::Primary);
     void CancelAll();
+    // [Prefetch Planner] Cancel queued / running prefetch jobs whose image is not in `keep`
+    void RetainPrefetch(const std::vector<ImageID>& keep);
     
     // === Result Retrieval ===
-    std::optional<EngineEvent> TryPopResult();
+    // UI thread only. Appends finished results to `out` in completion order. Tile
+    // results for any image but `currentImageId` are dropped on the way; returns
+    // how many.
+    size_t DrainResults(ImageID currentImageId, std::vector<EngineEvent>& out);
     
     // === Status Query (for Debug HUD) ===
     struct PoolStats {
@@ -130,13 +146,19 @@ public:
     // [Memory]
     void ShrinkMemory();
 
+    // [Arena Precommit] Header dimensions of the image about to be submitted (from PeekHeader).
+    // The worker pre-commits and pre-faults the Heavy Arena to the predicted output before
+    // decoding it, and both Heavy Arenas keep a working set sized to recent images.
+    void HintFrameSize(ImageID imageId, int width, int height, const std::wstring& format);
+    QuickView::TileMemoryManager::Stats GetTileMemoryStats() const { return m_tileMemory.GetStats(); }
+
 private:
     // === Worker Structure ===
     struct Worker {
         std::thread thread; // [Fast Exit] Use std::thread for detach capability
         WorkerState state = WorkerState::SLEEPING;  // Protected by m_poolMutex
-        std::wstring currentPath;
         ImageID currentId = 0;  // [ImageID] Path hash of current task
+        bool currentPrefetch = false; // [Prefetch Planner] Current task is a SubmitPrefetch job
         std::stop_source stopSource; // Job cancellation
         std::stop_source threadStopSource; // [Fast Exit] Thread lifecycle control
         std::chrono::steady_clock::time_point lastActiveTime;
@@ -173,6 +195,20 @@ private:
     std::atomic<ImageID> m_activeTitanImageId{ 0 }; // [Revision 2] Only this ID can trigger Titan warmup
     std::atomic<float> m_targetHdrHeadroomStops{ -1.0f };
     int m_titanSrcW = 0, m_titanSrcH = 0; // Source image dimensions (set in SetTitanMode)
+
+    // [Arena Precommit] Latest HintFrameSize + working set across navigations
+    struct FrameHint {
+        ImageID imageId = 0;
+        int width = 0;
+        int height = 0;
+        int bytesPerPixel = 4;
+        bool isJpeg = false; // Scaled decodes use IDCT scaling: output size is predictable
+    };
+    std::mutex m_frameHintMutex;
+    FrameHint m_frameHint;
+    ArenaWorkingSet m_arenaWorkingSet;
+    int m_prefaultThreads = 1;
+    void PrecommitForDecode(QuantumArena& arena, ImageID imageId, bool isFullDecode, int targetW, int targetH);
     std::atomic<QuickView::TitanFormat> m_titanFormat{QuickView::TitanFormat::Unknown}; // [P15] Thread-safe format enum
     std::counting_semaphore<std::numeric_limits<std::ptrdiff_t>::max()> m_ioSemaphore{ 0 }; // Initialized in constructor
     std::atomic<int> m_ioLimit{ 0 }; // [Optimization] Atomic for lock-free fast check
@@ -255,7 +291,7 @@ private:
     std::atomic<double> m_lastDecodeTimeMs = 0.0;
     std::atomic<ImageID> m_lastDecodeId = 0; // [HUD Fix] Track which image was decoded
     
-    // Job queue
+    // Worker states + wakeups. Jobs themselves live in m_jobQueue (own locks).
     mutable std::mutex m_poolMutex;
     std::condition_variable m_poolCv;
     
@@ -267,6 +303,14 @@ private:
     
 #include "MappedFile.h"
 
+    // [Titan Perf] Interned per-image source: every job of an image shares one
+    // instance instead of copying the path and bumping the mapping's refcount
+    struct ImageContext {
+        std::wstring_view path; // PathTable entry: null-terminated, never freed
+        ImageID imageId = 0;
+        std::shared_ptr<QuickView::MappedFile> mmf;
+    };
+
     struct JobInfo {
         JobType type = JobType::Standard;
         int priority = 0; // Higher = Earlier
@@ -275,39 +319,76 @@ private:
         uint32_t genID = 0; // Capture of m_generationID at submission
 
         // Common
-        std::wstring path;
+        std::shared_ptr<const ImageContext> image; // Path + zero-copy MMF source
         ImageID imageId;
         PaneSlot targetSlot = PaneSlot::Primary;
         uint64_t generationId = 0;
         std::chrono::steady_clock::time_point submitTime; // [Metrics] Track queue time
-        std::shared_ptr<QuickView::MappedFile> mmf; // [Optimization] Zero-Copy MMF Source
         float targetHdrHeadroomStops = -1.0f;
+        bool critical = false;     // Injector (base layer / visible tile) vs worker lane
+        uint64_t cancelEpoch = 0;  // m_cancelEpoch at submission
         
         // Standard
         bool isFullDecode = false;  // true = full resolution, false = scaled
+        bool prefetch = false;      // [Prefetch Planner] Spared by CancelOthers
+        int targetW = 0, targetH = 0; // Scaled prefetch box (0 = Titan base-layer sizing)
         
         // Tile
         QuickView::RegionRequest region; // [Titan] Rect + Scale
         QuickView::TileCoord tileCoord;  // [Titan] For result indentification
         
-        // Heap Comparator (Max-Heap: Highest Priority First)
-        bool operator<(const JobInfo& other) const {
-            return priority < other.priority;
+        // Interned: .data() is a valid C string for the loader APIs
+        std::wstring_view Path() const {
+            return image ? image->path : std::wstring_view{ L"" };
         }
+        const std::shared_ptr<QuickView::MappedFile>& Mmf() const {
+            static const std::shared_ptr<QuickView::MappedFile> none;
+            return image ? image->mmf : none;
+        }
+    };
+    // [Titan Perf] Injector + per-worker lanes with stealing (see StealingJobQueue.h)
+    QuickView::StealingJobQueue<JobInfo> m_jobQueue;
+
+    std::mutex m_imageContextMutex;
+    std::vector<std::weak_ptr<const ImageContext>> m_imageContexts; // Recent images, MRU first
+    static constexpr size_t kImageContextSlots = 4;
+    std::shared_ptr<const ImageContext> InternImage(std::wstring_view path, ImageID imageId,
+                                                    const std::shared_ptr<QuickView::MappedFile>& mmf);
+
+    // A job popped before CancelOthers/CancelAll ran but not yet BUSY is dropped when
+    // it reaches the pool lock: it would have been removed from the queue.
+    struct CancelMark {
+        uint64_t epoch = 0;  // Jobs stamped below this were queued before the cancel
+        ImageID keepId = 0;
+        bool keepNone = false;
     };
-    // [Titan] Using Vector + Heap for O(1) Clear and Priority
-    std::vector<JobInfo> m_pendingJobs;
+    std::atomic<uint64_t> m_cancelEpoch{ 0 };
+    CancelMark m_cancelMarks[2]; // Per PaneSlot, guarded by m_poolMutex
+    bool IsCancelledLocked(const JobInfo& job) const;
+    void ReleaseTileJob(const JobInfo& job); // Undo tile bookkeeping for a job that will not run
 
     // [Dedup] Track tiles currently in-flight (queued + decoding)
     // Key = (col << 20 | row << 8 | lod) — uniquely identifies a tile request
+    std::mutex m_inFlightMutex;
     std::unordered_set<uint64_t> m_inFlightTiles;
     static uint64_t MakeTileHash(int col, int row, int lod) {
         return ((uint64_t)col << 20) | ((uint64_t)row << 8) | (uint64_t)(lod & 0xFF);
     }
     
     // Results queue
+    // [Titan Perf] Workers publish into a lock-free ring of preallocated events; the
+    // mutex deque only takes overflow while the ring is full. Tags let stale tiles
+    // be dropped without moving the event out.
+    struct ResultTag {
+        ImageID imageId = 0;
+        bool isTile = false; // Only tile results are ever dropped as stale
+    };
+    static constexpr size_t kResultRingSlots = 512;
+    QuickView::MpscEventRing<EngineEvent, ResultTag> m_resultRing{ kResultRingSlots };
+    std::atomic<int> m_resultOverflowCount{ 0 };   // Events in m_results
+    std::atomic<bool> m_resultSignalPending{ false }; // A WM_ENGINE_EVENT is already posted
     mutable std::mutex m_resultMutex;
-    std::deque<EngineEvent> m_results;
+    std::deque<EngineEvent> m_results; // Overflow only
     
     // Shrinker thread
     std::jthread m_shrinker;
@@ -338,6 +419,10 @@ private:
     // We keep it here to be shared by all workers
     QuickView::TileMemoryManager m_tileMemory;
 
+    // [Titan Perf] Per-image JPEG entry points: tile decode cost scales with the
+    // tile, not with how far down the image it sits
+    QuickView::JpegEntryIndexCache m_jpegEntryIndex;
+
     // [Safety] Atomic Tracking for Lifecycle Management
     std::atomic<int> m_activeTileJobs = 0;
 
@@ -382,6 +467,10 @@ private:
     bool ShouldUseSingleDecode(int lod) const;
     bool ShouldUseSingleDecodeForWebP(int lod) const;
 
+    // [Streaming] While a Standard job's source is still being read, queue partial
+    // frames as PreviewReady. Returns once the source is complete (or on cancel).
+    void EmitStreamingPartials(const JobInfo& job, CImageLoader::CancelPredicate checkCancel);
+
     // ============================================================================
     // [Phase-1] Persistent Backing Store for Heavy Non-ROI Formats
     // ============================================================================
@@ -485,7 +574,7 @@ private:
     std::atomic<ImageID> m_masterWarmupImageId{ 0 };
     std::atomic<bool> m_masterWarmupReady{ false };  // [Direct-to-MMF] Set true when warmup decode is complete
     bool ShouldWarmupMasterBacking() const;
-    void EnsureMasterWarmup(const std::wstring& path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, PaneSlot targetSlot, uint64_t generationId);
+    void EnsureMasterWarmup(std::wstring_view path, ImageID imageId, std::shared_ptr<QuickView::MappedFile> mmf, PaneSlot targetSlot, uint64_t generationId); // path: interned, outlives the thread
     void StopMasterWarmup();
     
     // ============================================================================
@@ -17,11 +17,44 @@ static constexpr const char* CURRENT_MODULE = "ImageEngine";
 namespace {
     struct AuxLayerReadyCtx {
         ImageEngine* engine;
-        std::wstring path;
+        std::wstring_view path; // Interned (PathTable)
         ImageID id;
         PaneSlot targetSlot;
         uint64_t generationId;
     };
+
+    // Same triggers as DispatchImageLoad: these images are decoded via tiles, never prefetched
+    bool IsTitanCandidate(const std::wstring& fmtUpper, int width, int height, uintmax_t fileSize) {
+        const bool isTitanFormat =
+            (fmtUpper == L"JPEG" || fmtUpper == L"JPG" ||
+             fmtUpper == L"WEBP" || fmtUpper == L"PNG" ||
+             fmtUpper == L"JXL" || fmtUpper == L"TIF" ||
+             fmtUpper == L"TIFF" || fmtUpper == L"AVIF");
+        return isTitanFormat &&
+            ((width > 8192 || height > 8192) ||
+             ((uint64_t)width * (uint64_t)height > 50000000ULL) ||
+             ((width <= 0 || height <= 0) && fileSize >= (32ull * 1024ull * 1024ull)));
+    }
+
+    double SteadyNowMs() {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // [Prefetch Planner] Box a screen-sized placeholder decode into (aspect kept, 8-px aligned)
+    void FitToScreen(int srcW, int srcH, int* outW, int* outH) {
+        const int screenW = GetSystemMetrics(SM_CXSCREEN);
+        const int screenH = GetSystemMetrics(SM_CYSCREEN);
+        const float srcRatio = (float)srcW / (float)srcH;
+        if (srcRatio > (float)screenW / (float)screenH) {
+            *outW = screenW;
+            *outH = (int)(screenW / srcRatio);
+        } else {
+            *outH = screenH;
+            *outW = (int)(screenH * srcRatio);
+        }
+        *outW = (*outW + 7) & ~7;
+        *outH = (*outH + 7) & ~7;
+    }
 }
 
 extern HWND g_mainHwnd;
@@ -51,6 +84,11 @@ ImageEngine::ImageEngine(CImageLoader* loader)
     // [Infinity Engine]
     m_tileManager = std::make_shared<QuickView::TileManager>();
 
+    // [Cold Tier]
+    if (m_prefetchPolicy.maxColdCacheMemory > 0) {
+        m_coldCache = std::make_shared<QuickView::ColdFrameCache>(m_prefetchPolicy.maxColdCacheMemory);
+    }
+
     // Debug output
     QV_LOG("Engine_Init",
         TraceLoggingInt32(m_engineConfig.maxHeavyWorkers, "MaxWorkers"));
@@ -152,7 +190,7 @@ void ImageEngine::SetTargetHdrHeadroomStops(float stops) {
 }
 
 // Request full resolution decode for current image (used by JXL serial pipeline)
-void ImageEngine::RequestFullDecode(const std::wstring& path, ImageID imageId, PaneSlot targetSlot, uint64_t generationId) {
+void ImageEngine::RequestFullDecode(std::wstring_view path, ImageID imageId, PaneSlot targetSlot, uint64_t generationId) {
     // Node B: Decoding Complete / Request Full Decode
     QV_LOG("ImageEngine_FullDecode",
         TraceLoggingInt32(g_debugMetrics.lastUploadChannel.load(), "LastUploadChannel"),
@@ -188,15 +226,15 @@ void ImageEngine::RequestFullDecode(const std::wstring& path, ImageID imageId, P
 }
 
 // [Phase 2] Dispatcher Implementation
-void ImageEngine::DispatchImageLoad(const std::wstring& path, ImageID imageId, uintmax_t fileSize, PaneSlot targetSlot, uint64_t generationId) {
+void ImageEngine::DispatchImageLoad(std::wstring_view path, ImageID imageId, uintmax_t fileSize, PaneSlot targetSlot, uint64_t generationId) {
     // 1. Peek Header
-    CImageLoader::ImageHeaderInfo info = m_loader->PeekHeader(path.c_str());
+    CImageLoader::ImageHeaderInfo info = m_loader->PeekHeader(path.data());
 
     // [Header Guard] Some containers (large AVIF/HEIC/TIFF variants) may return 0x0 in PeekHeader.
     // Run a second fast probe, then a last-resort WIC size query to stabilize Titan dispatch.
     if (info.width <= 0 || info.height <= 0 || info.format == L"Unknown") {
         CImageLoader::ImageInfo fastInfo{};
-        if (SUCCEEDED(m_loader->GetImageInfoFast(path.c_str(), &fastInfo))) {
+        if (SUCCEEDED(m_loader->GetImageInfoFast(path.data(), &fastInfo))) {
             if (info.width <= 0 && fastInfo.width > 0) info.width = (int)fastInfo.width;
             if (info.height <= 0 && fastInfo.height > 0) info.height = (int)fastInfo.height;
             if (info.format == L"Unknown" && !fastInfo.format.empty()) info.format = fastInfo.format;
@@ -204,13 +242,16 @@ void ImageEngine::DispatchImageLoad(const std::wstring& path, ImageID imageId, u
         }
         if (info.width <= 0 || info.height <= 0) {
             UINT w = 0, h = 0;
-            if (SUCCEEDED(m_loader->GetImageSize(path.c_str(), &w, &h))) {
+            if (SUCCEEDED(m_loader->GetImageSize(path.data(), &w, &h))) {
                 info.width = (int)w;
                 info.height = (int)h;
             }
         }
     }
 
+    // [Arena Precommit] Size the Heavy Arena for this image before any Submit below
+    m_heavyPool->HintFrameSize(imageId, info.width, info.height, info.format);
+
     // [v9.0] Explicit Force Refresh (Toolbar Toggle)
     if (m_forceRefresh.exchange(false)) {
         InvalidateCache(path);
@@ -227,8 +268,10 @@ void ImageEngine::DispatchImageLoad(const std::wstring& path, ImageID imageId, u
     
     // [Map First] Create MMF immediately for this image
     // This allows Zero-Copy decoding for Base Layer AND Zero-Copy for Tiles
-    std::shared_ptr<QuickView::MappedFile> primaryMMF = std::make_shared<QuickView::MappedFile>(path);
-    if (!primaryMMF->IsValid()) primaryMMF.reset(); // Fallback if map fails
+    // [Streaming] On HDD/network sources the read is async and may still be filling;
+    // the Standard job streams partial frames from it while it does.
+    std::shared_ptr<QuickView::MappedFile> primaryMMF = AcquireMapping(path, imageId);
+    if (!primaryMMF->IsOpen()) primaryMMF.reset(); // Fallback if map fails
 
     // [Titan] Trigger Conditions
     // 1. Format support: JPEG, WebP, PNG, JXL, TIFF, AVIF
@@ -255,6 +298,8 @@ void ImageEngine::DispatchImageLoad(const std::wstring& path, ImageID imageId, u
              bag.mmf = std::move(m_mmf);
              m_heavyPool->EnqueueTrash(std::move(bag));
          }
+         // Tiles read the whole source: wait for it here rather than in every tile job
+         if (primaryMMF && !primaryMMF->IsValid()) primaryMMF.reset();
          m_mmf = primaryMMF;
          
          m_tileManager->InvalidateAll(); // Reset generation
@@ -262,7 +307,7 @@ void ImageEngine::DispatchImageLoad(const std::wstring& path, ImageID imageId, u
              TraceLoggingString("Enabled", "Action"),
              TraceLoggingInt32(info.width, "Width"),
              TraceLoggingInt32(info.height, "Height"),
-             TraceLoggingBool(m_mmf && m_mmf->IsValid(), "MMF_OK"));
+             TraceLoggingBool(m_mmf != nullptr, "MMF_OK"));
          
          // [Scientific 2.0] Enable Titan Mode - pool handles dynamic concurrency via Scout phase.
          // SetTitanMode(true) resets scout state, sets initial concurrency to 2, 
@@ -287,7 +332,8 @@ void ImageEngine::DispatchImageLoad(const std::wstring& path, ImageID imageId, u
     // [Prefetch System] Cache Check ...
     // If the image is already in memory (from prefetch), use it immediately!
     {
-        auto cachedFrame = GetCachedImage(path);
+        bool cachedScaled = false;
+        auto cachedFrame = GetCachedImage(imageId, &cachedScaled);
 
         // Guard: do not reuse JXL placeholder/scaled cache as a final hit.
         // Large JXL revisit must re-enter decode pipeline to ensure proper tile activation.
@@ -348,6 +394,7 @@ void ImageEngine::DispatchImageLoad(const std::wstring& path, ImageID imageId, u
                 e.targetSlot = targetSlot;
                 e.generationId = generationId;
                 e.rawFrame = cachedFrame; // Zero-copy shared_ptr
+                e.isScaled = cachedScaled;
                 
                 // [Fix - Bug 7] Re-populate metadata from cache
                 // Never trust info.width directly, this causes dimension downgrade 
@@ -376,12 +423,19 @@ void ImageEngine::DispatchImageLoad(const std::wstring& path, ImageID imageId, u
                 }
                 
                 QueueEvent(std::move(e)); 
+
+                // [Prefetch Planner] A placeholder is shown at once; the full decode follows
+                if (cachedScaled && !enableTitan) {
+                    RequestPlaceholderUpgrade(path, imageId, targetSlot, generationId);
+                }
                 
                 return; 
             }
         }
     }
     
+    if (!enableTitan) NoteDecodeStart(imageId, info, QuickView::PrefetchTier::Full, false);
+
     // [DEBUG] Log
     {
         QV_LOG("Dispatch_Route",
@@ -425,7 +479,7 @@ void ImageEngine::DispatchImageLoad(const std::wstring& path, ImageID imageId, u
         else if (info.hasEmbeddedThumb) {
             int embW = 0, embH = 0;
             // Call the new method [v6.5 Recursor]
-            if (SUCCEEDED(m_loader->GetEmbeddedPreviewInfo(path.c_str(), &embW, &embH))) {
+            if (SUCCEEDED(m_loader->GetEmbeddedPreviewInfo(path.data(), &embW, &embH))) {
                 uint64_t embPixels = (uint64_t)embW * embH;
                 // Threshold: 2.5 MP (Conservative)
                 // If embedded preview is huge, it will block FastLane. Force Heavy Lane.
@@ -485,7 +539,7 @@ void ImageEngine::DispatchImageLoad(const std::wstring& path, ImageID imageId, u
     
     // 5. JXL Special Logic (User "Ultimate Strategy")
     if (info.format == L"JXL") {
-        m_pendingJxlHeavyPath.clear();
+        m_pendingJxlHeavyPath = {};
         m_pendingJxlHeavyId = 0;
         m_pendingJxlHeavySlot = targetSlot;
         m_pendingJxlHeavyGenerationId = generationId;
@@ -598,13 +652,15 @@ void ImageEngine::NavigateTo(const std::wstring& path, uintmax_t fileSize, uint6
     m_currentNavToken.store(navToken);
     
     // [ImageID Architecture] Compute stable hash
-    ImageID imageId = ComputePathHash(path);
+    // [Path Table] Everything downstream carries the interned view, not a copy
+    const QuickView::PathRef interned = QuickView::PathTable::Instance().Intern(path);
+    ImageID imageId = interned.id;
     m_currentImageId.store(imageId);
     m_currentImageIdBySlot[static_cast<int>(targetSlot)].store(imageId);
     // Cancel stale heavy/tile work immediately for the target pane.
     m_heavyPool->CancelOthers(imageId, targetSlot);
     
-    m_currentNavPath = path;
+    m_currentNavPath = interned.path;
     m_lastInputTime = std::chrono::steady_clock::now();
 
     // [JXL Serial] Reset State
@@ -613,7 +669,7 @@ void ImageEngine::NavigateTo(const std::wstring& path, uintmax_t fileSize, uint6
     m_baseLayerReady.store(false);
 
     // Use Central Dispatcher
-    DispatchImageLoad(path, imageId, fileSize, targetSlot, generationId);
+    DispatchImageLoad(interned.path, imageId, fileSize, targetSlot, generationId);
 }
 
 ImageID ImageEngine::GetCurrentImageId(PaneSlot slot) const {
@@ -664,7 +720,11 @@ std::vector<EngineEvent> ImageEngine::PollState() {
     }
 
     // 2. Harvest Heavy Events
-    while (auto e = m_heavyPool->TryPopResult()) {
+    // [Titan Perf] Stale tiles from a previous image are dropped inside the drain
+    const size_t heavyBegin = batch.size();
+    m_heavyPool->DrainResults(m_currentImageId.load(), batch);
+    for (size_t i = heavyBegin; i < batch.size(); ++i) {
+         EngineEvent* e = &batch[i];
          if (e->type == EventType::TileReady && e->tileCoord.has_value() && e->rawFrame) {
              // [Fix] Only route tiles belonging to the CURRENT image to TileManager.
              // Stale tiles from a previous image (decoded after navigation) must be
@@ -680,7 +740,6 @@ std::vector<EngineEvent> ImageEngine::PollState() {
          } else if (e->type == EventType::FullReady && e->imageId == m_currentImageId.load()) {
              m_pool.SwapHeavy();
          }
-         batch.push_back(std::move(*e));
     }
 
     // 3. [JXL Serial] Track state and trigger full decode
@@ -736,8 +795,12 @@ std::vector<EngineEvent> ImageEngine::PollState() {
                       TraceLoggingUInt32((uint32_t)e.hr, "HR"));
                   PostMessage(m_hwnd, WM_APP + 99, 0, 0);
              }
+             {
+                 std::lock_guard lock(m_plannerMutex);
+                 m_decodeStarts.erase(e.imageId);
+             }
              std::lock_guard lock(m_pendingMutex);
-             m_pendingPaths.erase(e.filePath);
+             m_pendingIds.erase(e.imageId);
         }
 
         // [v8.11 Fix] Cache ALL FullReady events (both current and prefetch)
@@ -765,17 +828,36 @@ std::vector<EngineEvent> ImageEngine::PollState() {
 
             if (skipJxlCache) {
                 std::lock_guard lock(m_pendingMutex);
-                m_pendingPaths.erase(e.filePath);
+                m_pendingIds.erase(e.imageId);
             } else {
+                // [Prefetch Planner] Learn the decode cost; placeholder tiers are cached as such
+                bool placeholder = false;
+                {
+                    std::lock_guard lock(m_plannerMutex);
+                    auto sit = m_decodeStarts.find(e.imageId);
+                    if (sit != m_decodeStarts.end()) {
+                        const DecodeStart& start = sit->second;
+                        const bool placeholderTier = start.tier != QuickView::PrefetchTier::Full;
+                        // A full decode can overtake (or replace) a pending placeholder
+                        // decode of the same image: only scaled frames are placeholders
+                        placeholder = placeholderTier && e.isScaled;
+                        if (placeholderTier == e.isScaled) {
+                            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start.start).count();
+                            m_planner.RecordDecode(start.format, start.tier, start.megapixels, ms);
+                        }
+                        m_decodeStarts.erase(sit);
+                    }
+                }
+
                 if (m_navigator) {
                     int idx = m_navigator->FindIndex(e.filePath);
                     if (idx != -1) {
-                         AddToCache(idx, e.filePath, e.rawFrame);
+                         AddToCache(idx, e.imageId, e.rawFrame, placeholder);
                          
                          // [v8.15] Remove from pending set
                          {
                              std::lock_guard lock(m_pendingMutex);
-                             m_pendingPaths.erase(e.filePath);
+                             m_pendingIds.erase(e.imageId);
                          }
                     }
                 }
@@ -794,6 +876,20 @@ std::vector<EngineEvent> ImageEngine::PollState() {
              m_pendingJxlHeavyId = 0; // Consumed
         }
     }
+    // [Prefetch Planner] Placeholder shown while flying past: upgrade once the user settles
+    std::optional<PlaceholderUpgrade> upgrade;
+    {
+        std::lock_guard lock(m_plannerMutex);
+        if (m_placeholderUpgrade && std::chrono::steady_clock::now() >= m_placeholderUpgrade->due) {
+            upgrade = std::move(m_placeholderUpgrade);
+            m_placeholderUpgrade.reset();
+        }
+    }
+    if (upgrade) {
+        NoteDecodeStart(upgrade->imageId, m_loader->PeekHeader(upgrade->path.data()), QuickView::PrefetchTier::Full, false);
+        RequestFullDecode(upgrade->path, upgrade->imageId, upgrade->targetSlot, upgrade->generationId);
+    }
+
     // [v9.0] Startup Idle Detection: Enable prefetch after 500ms of continuous system idle
     if (!m_startupPrefetchAllowed) {
         if (IsIdle()) {
@@ -895,8 +991,7 @@ ImageEngine::DebugStats ImageEngine::GetDebugStats() const {
             }
             
             // For neighbors, check prefetch cache
-            const std::wstring& path = m_navigator->GetFile(targetIndex);
-            auto it = m_cache.find(path);
+            auto it = m_cache.find(m_navigator->GetImageID(targetIndex));
             
             if (it != m_cache.end()) {
                 s.topology.slots[slotIndex] = CacheStatus::HEAVY;
@@ -1017,10 +1112,12 @@ ImageEngine::TelemetrySnapshot ImageEngine::GetTelemetry() const {
                  continue;
              }
              
-             std::wstring path = m_navigator->GetFile(targetIndex);
-             if (m_cache.count(path)) {
+             const ImageID id = m_navigator->GetImageID(targetIndex);
+             if (m_cache.count(id)) {
                  s.cacheSlots[i] = CacheStatus::HEAVY; // Green (Cached)
-             } else if (m_pendingPaths.count(path)) {
+             } else if (m_coldCache && m_coldCache->Contains(id)) {
+                 s.cacheSlots[i] = CacheStatus::COLD; // Green outline (Compressed)
+             } else if (m_pendingIds.count(id)) {
                  s.cacheSlots[i] = CacheStatus::PENDING; // Blue (Processing)
              } else {
                  s.cacheSlots[i] = CacheStatus::EMPTY; // Gray (Not loaded)
@@ -1031,6 +1128,12 @@ ImageEngine::TelemetrySnapshot ImageEngine::GetTelemetry() const {
     // 4. Memory (Zone D)
     s.pmrUsed = m_pool.GetUsedMemory();
     s.pmrCapacity = m_pool.GetTotalMemory();
+
+    const auto cold = GetColdCacheStats();
+    s.coldBytes = cold.compressedBytes;
+    s.coldRawBytes = cold.rawBytes;
+    s.coldItems = (int)cold.entries;
+    s.coldPromoteMs = cold.lastPromoteMs;
     
     // System Memory
     PROCESS_MEMORY_COUNTERS pmc;
@@ -1072,11 +1175,12 @@ void ImageEngine::FastLane::Clear() {
     // m_skipCount is not reset here, it accumulates for debug stats.
 }
 
-void ImageEngine::FastLane::Push(const std::wstring& path, ImageID id, float targetHdrHeadroomStops, PaneSlot targetSlot, uint64_t generationId) {
+void ImageEngine::FastLane::Push(std::wstring_view path, ImageID id, float targetHdrHeadroomStops, PaneSlot targetSlot, uint64_t generationId) {
     if (m_stopSignal) return;
+    const std::wstring_view interned = QuickView::PathTable::Instance().Intern(path).path; // Outlives the queue
     {
         std::lock_guard lock(m_queueMutex);
-        m_queue.push_back({path, id, targetHdrHeadroomStops, targetSlot, generationId});
+        m_queue.push_back({interned, id, targetHdrHeadroomStops, targetSlot, generationId});
         // [v3.1] Simplified Push: No complex anti-explosion here.
         // UpdateView()'s "Ruthless Purge" handles queue depth.
     }
@@ -1094,6 +1198,66 @@ void ImageEngine::FastLane::Push(const std::wstring& path, ImageID id, float tar
     m_cv.notify_one();
 }
 
+void ImageEngine::FastLane::PushPreview(std::wstring_view path, ImageID id, int longEdge) {
+    if (m_stopSignal) return;
+    {
+        std::lock_guard lock(m_queueMutex);
+        FastLaneCommand cmd{ QuickView::PathTable::Instance().Intern(path).path, id };
+        cmd.previewLongEdge = longEdge;
+        m_queue.push_back(std::move(cmd));
+    }
+    m_cv.notify_one();
+}
+
+// [Prefetch Planner] Placeholder tier for RAW neighbours: the embedded JPEG preview via
+// the thumbnail path (shell cache, then container previews). Never cancels the Heavy Lane.
+void ImageEngine::FastLane::LoadEmbeddedPreview(const FastLaneCommand& cmd) {
+    CImageLoader::ThumbData thumb{};
+    const HRESULT hr = m_loader->LoadThumbnail(cmd.path.data(), cmd.previewLongEdge, &thumb, false);
+
+    // A shell-cache icon is no placeholder for a screen-sized view
+    const bool usable = SUCCEEDED(hr) && thumb.isValid && !thumb.pixels.empty() &&
+                        (std::max)(thumb.width, thumb.height) * 2 >= cmd.previewLongEdge;
+    if (!usable) {
+        QV_LOG("FastLane_Preview", TraceLoggingString("Unusable", "Action"), TraceLoggingInt32(thumb.width, "W"));
+        std::lock_guard lock(m_parent->m_pendingMutex);
+        m_parent->m_pendingIds.erase(cmd.id);
+        return;
+    }
+
+    auto frame = std::make_shared<QuickView::RawImageFrame>();
+    frame->pixels = new uint8_t[thumb.pixels.size()];
+    memcpy(frame->pixels, thumb.pixels.data(), thumb.pixels.size());
+    frame->width = thumb.width;
+    frame->height = thumb.height;
+    frame->stride = thumb.stride;
+    frame->format = QuickView::PixelFormat::BGRA8888;
+    frame->quality = QuickView::DecodeQuality::Preview;
+    frame->srcWidth = thumb.origWidth;
+    frame->srcHeight = thumb.origHeight;
+    frame->memoryDeleter = QuickView::MemoryDeleter::FromDeleteArray();
+
+    EngineEvent e;
+    e.type = EventType::FullReady;
+    e.filePath = cmd.path;
+    e.imageId = cmd.id;
+    e.targetSlot = cmd.targetSlot;
+    e.generationId = cmd.generationId;
+    e.isScaled = true;
+    e.rawFrame = frame;
+    e.metadata.Width = thumb.origWidth > 0 ? thumb.origWidth : thumb.width;
+    e.metadata.Height = thumb.origHeight > 0 ? thumb.origHeight : thumb.height;
+    e.metadata.Format = m_loader->PeekHeader(cmd.path.data()).format;
+    e.metadata.FileSize = thumb.fileSize;
+    e.metadata.LoaderName = L"Embedded Preview";
+    {
+        std::lock_guard lock(m_queueMutex);
+        m_results.push_back(std::move(e));
+    }
+    m_parent->QueueEvent(EngineEvent{}); // Signal
+    QV_LOG("FastLane_Output", TraceLoggingString("EmbeddedPreview", "Action"), TraceLoggingInt32(thumb.width, "RawW"));
+}
+
 std::optional<EngineEvent> ImageEngine::FastLane::TryPopResult() {
     // Ideally we'd use a mutex here too, but for single-consumer (MainThread)
     // we can check empty first or lock.
@@ -1145,6 +1309,12 @@ void ImageEngine::FastLane::QueueWorker() {
             if (cmd.path.empty()) continue;
             
             m_isWorking = true; // [HUD V4] Active
+
+            if (cmd.previewLongEdge > 0) {
+                LoadEmbeddedPreview(cmd);
+                m_isWorking = false;
+                continue;
+            }
             
             QV_LOG("FastLane_Process", TraceLoggingString("Start", "Action"));
 
@@ -1159,7 +1329,7 @@ void ImageEngine::FastLane::QueueWorker() {
             QuickView::RawImageFrame rawFrame;
             std::wstring loaderName;
             
-            auto info = m_loader->PeekHeader(cmd.path.c_str());
+            auto info = m_loader->PeekHeader(cmd.path.data());
             
             // [Fix] Intelligent Target Sizing - Ultimate Fix!
             // FastLane only receives TypeA_Sprint or Dedicated Small (<30ms) formats.
@@ -1191,7 +1361,7 @@ void ImageEngine::FastLane::QueueWorker() {
                     rawFrame.onAuxLayerReady.ctxDeleter = [](void* c) { delete static_cast<AuxLayerReadyCtx*>(c); };
                 }
             }
-            HRESULT hr = m_loader->LoadToFrame(cmd.path.c_str(), &rawFrame, &arena, targetW, targetH, &loaderName, {}, nullptr, true, false, cmd.targetHdrHeadroomStops);
+            HRESULT hr = m_loader->LoadToFrame(cmd.path.data(), &rawFrame, &arena, targetW, targetH, &loaderName, {}, nullptr, true, false, cmd.targetHdrHeadroomStops);
             
             int decodeMs = (int)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
 
@@ -1353,14 +1523,26 @@ void ImageEngine::FastLane::QueueWorker() {
 }
 
 void ImageEngine::SetPrefetchPolicy(const PrefetchPolicy& policy) {
-    m_prefetchPolicy = policy;
+    std::shared_ptr<QuickView::ColdFrameCache> retired;
+    {
+        std::lock_guard lock(m_cacheMutex);
+        // [Cold Tier] Budget is fixed per instance; a new gear starts an empty tier
+        if (policy.maxColdCacheMemory != m_prefetchPolicy.maxColdCacheMemory) {
+            retired = std::move(m_coldCache);
+            if (policy.maxColdCacheMemory > 0) {
+                m_coldCache = std::make_shared<QuickView::ColdFrameCache>(policy.maxColdCacheMemory);
+            }
+        }
+        m_prefetchPolicy = policy;
+    }
+    // retired joins its worker here (or in the last in-flight promote), outside the cache lock
 }
 
 void ImageEngine::TriggerPendingJxlHeavy() {
     if (!m_pendingJxlHeavyPath.empty() && m_pendingJxlHeavyId != 0) {
         QV_LOG("PollState_Route", TraceLoggingString("JXL Sequential TriggerHeavy", "Action"));
         m_heavyPool->Submit(m_pendingJxlHeavyPath, m_pendingJxlHeavyId, nullptr, m_pendingJxlHeavySlot, m_pendingJxlHeavyGenerationId);
-        m_pendingJxlHeavyPath.clear();
+        m_pendingJxlHeavyPath = {};
         m_pendingJxlHeavyId = 0;
     }
 }
@@ -1375,13 +1557,71 @@ int ImageEngine::GetCacheItemCount() const {
     return (int)m_cache.size();
 }
 
-std::shared_ptr<QuickView::RawImageFrame> ImageEngine::GetCachedImage(const std::wstring& path) {
-    std::lock_guard lock(m_cacheMutex); // Thread-safe copy
-    auto it = m_cache.find(path);
+QuickView::ColdFrameCache::Stats ImageEngine::GetColdCacheStats() const {
+    std::lock_guard lock(m_cacheMutex);
+    return m_coldCache ? m_coldCache->GetStats() : QuickView::ColdFrameCache::Stats{};
+}
+
+std::shared_ptr<QuickView::RawImageFrame> ImageEngine::GetCachedImage(std::wstring_view path, bool* outScaled) {
+    return GetCachedImage(ComputePathHash(path), outScaled);
+}
+
+std::shared_ptr<QuickView::RawImageFrame> ImageEngine::GetCachedImage(ImageID id, bool* outScaled) {
+    std::shared_ptr<QuickView::ColdFrameCache> cold;
+    uint64_t invalidateEpoch = 0;
+    {
+        std::lock_guard lock(m_cacheMutex); // Thread-safe copy
+        if (outScaled) *outScaled = false;
+        auto it = m_cache.find(id);
+        if (it != m_cache.end()) {
+            if (outScaled) *outScaled = it->second.scaled;
+            return it->second.frame; 
+        }
+        if (!m_coldCache) return nullptr;
+        cold = m_coldCache;
+        invalidateEpoch = m_invalidateEpoch;
+    }
+
+    // [Cold Tier] Promote: a parallel decompress (a few ms) instead of a re-decode.
+    // It runs outside m_cacheMutex so decode results and UI peeks are not held up.
+    int sourceIndex = -1;
+    auto frame = cold->Take(id, &sourceIndex);
+    if (!frame) return nullptr;
+
+    // The frame is already heap-owned, so it goes back into m_cache as-is
+    std::lock_guard lock(m_cacheMutex);
+    if (m_invalidateEpoch != invalidateEpoch) return nullptr; // Stale pixels: file was edited meanwhile
+    auto it = m_cache.find(id);
     if (it != m_cache.end()) {
-        return it->second.frame; 
+        // A decode landed while we decompressed; it is at least as good as ours
+        if (outScaled) *outScaled = it->second.scaled;
+        return it->second.frame;
     }
-    return nullptr;
+
+    const size_t size = frame->GetBufferSize();
+    MakeRoomLocked(size);
+
+    CacheEntry entry;
+    entry.frame = frame;
+    entry.sourceIndex = sourceIndex;
+    entry.sizeBytes = size;
+    m_cache[id] = std::move(entry);
+    m_lruOrder.push_front(id);
+    m_currentCacheBytes += size;
+
+    QV_LOG("Cache_ColdPromote",
+        TraceLoggingInt32(sourceIndex, "Index"),
+        TraceLoggingFloat64(cold->GetStats().lastPromoteMs, "PromoteMs"));
+    return frame;
+}
+
+std::shared_ptr<QuickView::RawImageFrame> ImageEngine::PeekCachedImage(std::wstring_view path, bool* outScaled) const {
+    std::lock_guard lock(m_cacheMutex);
+    if (outScaled) *outScaled = false;
+    auto it = m_cache.find(ComputePathHash(path));
+    if (it == m_cache.end()) return nullptr;
+    if (outScaled) *outScaled = it->second.scaled;
+    return it->second.frame;
 }
 
 void ImageEngine::UpdateView(int currentIndex, QuickView::BrowseDirection dir) {
@@ -1395,6 +1635,11 @@ void ImageEngine::UpdateView(int currentIndex, QuickView::BrowseDirection dir) {
         TraceLoggingInt32(currentIndex, "Index"),
         TraceLoggingInt32(dirInt, "Direction"));
     
+    {
+        std::lock_guard lock(m_plannerMutex);
+        m_planner.OnNavigate(currentIndex, SteadyNowMs());
+    }
+
     // 1. Prune: Cancel old tasks not in visible range
     PruneQueue(currentIndex, dir);
     
@@ -1408,50 +1653,292 @@ void ImageEngine::UpdateView(int currentIndex, QuickView::BrowseDirection dir) {
     // [v9.1] Serial Queue Population
     m_prefetchQueue.clear();
 
-    if (dir == QuickView::BrowseDirection::IDLE) {
-         // [Startup/Reset] Conservative Bidirectional Prefetch
-         int count = (int)m_navigator->Count();
-         if (count > 0) {
-             int nextIdx = (currentIndex + 1) % count;
-             int prevIdx = (currentIndex - 1 + count) % count;
-             
-             // Queue neighbors
-             m_prefetchQueue.push_back({nextIdx, QuickView::Priority::High});
-             m_prefetchQueue.push_back({prevIdx, QuickView::Priority::High});
-         }
-    } else {
-         // Directional Prefetch
-         int step = (dir == QuickView::BrowseDirection::BACKWARD) ? -1 : 1;
-         
-         // 3. Adjacent: High Priority
-         m_prefetchQueue.push_back({currentIndex + step, QuickView::Priority::High});
-         
-         // 5. Anti-regret: One in opposite direction
-         m_prefetchQueue.push_back({currentIndex - step, QuickView::Priority::Low});
-         
-         // 6. Look-ahead
-         for (int i = 2; i <= m_prefetchPolicy.lookAheadCount; ++i) {
-             m_prefetchQueue.push_back({currentIndex + step * i, QuickView::Priority::Idle});
-         }
-    }
+    // [Prefetch Planner] Depth and decode tier per neighbour from browse rate + decode costs
+    if (m_navigator) PlanPrefetch(currentIndex);
     
+    // Start the window's file reads now; decodes are serialized, I/O need not be
+    IssueReadahead();
+
     // Pump queue immediately
     PumpPrefetch();
 }
 
-void ImageEngine::ScheduleJob(int index, QuickView::Priority pri) {
+void ImageEngine::PlanPrefetch(int currentIndex) {
+    const int count = (int)m_navigator->Count();
+    if (currentIndex < 0 || currentIndex >= count) return;
+
+    // Plan on a copy: the candidate callback takes the cache / pending locks
+    QuickView::PrefetchPlanner planner;
+    {
+        std::lock_guard lock(m_plannerMutex);
+        planner = m_planner;
+    }
+    const bool titan = IsTitanModeEnabled();
+
+    const ImageID currentId = m_navigator->GetImageID(currentIndex);
+    const PrefetchHeader current = GetPrefetchHeader(currentId, m_navigator->GetFile(currentIndex), m_navigator->GetFileSize(currentIndex));
+    bool currentCached = false, currentScaled = false;
+    {
+        std::lock_guard lock(m_cacheMutex);
+        auto it = m_cache.find(currentId);
+        currentCached = it != m_cache.end();
+        currentScaled = currentCached && it->second.scaled;
+    }
+
+    QuickView::PrefetchPlanInput in;
+    in.current = currentIndex;
+    in.count = count;
+    in.maxDepth = m_prefetchPolicy.lookAheadCount;
+    in.budgetBytes = m_prefetchPolicy.maxCacheMemory;
+    in.screenMegapixels = (double)GetSystemMetrics(SM_CXSCREEN) * GetSystemMetrics(SM_CYSCREEN) / 1e6;
+    const bool rapid = planner.GetMode() == QuickView::PrefetchPlanner::Mode::Rapid;
+    if (!currentCached || (currentScaled && !rapid)) {
+        // The image on screen decodes first; prefetch starts behind it
+        in.busyMs = planner.EstimateDecodeMs(current.format, QuickView::PrefetchTier::Full,
+                                             (double)current.width * current.height / 1e6);
+    }
+
+    auto jobs = planner.Plan(in, [&](int index) {
+        const ImageID id = m_navigator->GetImageID(index);
+        const PrefetchHeader h = GetPrefetchHeader(id, m_navigator->GetFile(index), m_navigator->GetFileSize(index));
+        const uint64_t predictedSize = (uint64_t)h.width * h.height * 4;
+
+        QuickView::PrefetchCandidate c;
+        c.format = h.format;
+        c.megapixels = (double)h.width * h.height / 1e6;
+        // JPEG IDCT scaling; only worth it when the source is bigger than the screen
+        c.canScale = h.heavy && !titan && (h.format == L"JPEG" || h.format == L"JPG") && c.megapixels > in.screenMegapixels;
+        c.hasPreview = h.embeddedPreview;
+        c.skip = h.titanCandidate ||
+                 (m_prefetchPolicy.maxCacheMemory > 0 && !titan && predictedSize > m_prefetchPolicy.maxCacheMemory);
+        {
+            std::lock_guard lock(m_cacheMutex);
+            c.ready = m_cache.count(id) || (m_coldCache && m_coldCache->Contains(id));
+        }
+        {
+            std::lock_guard lock(m_pendingMutex);
+            c.inFlight = m_pendingIds.count(id) > 0;
+        }
+        return c;
+    });
+
+    std::vector<ImageID> keep{ currentId };
+    for (const auto& job : jobs) {
+        if (job.inFlight) {
+            keep.push_back(m_navigator->GetImageID(job.index));
+        } else {
+            m_prefetchQueue.push_back({ job.index, job.priority, job.tier });
+        }
+    }
+
+    // Prefetches the new plan dropped (passed, or out of the window) stop here instead of
+    // holding the lane; NavigateTo's CancelOthers no longer touches them.
+    m_heavyPool->RetainPrefetch(keep);
+    std::vector<ImageID> dropped;
+    {
+        std::lock_guard lock(m_plannerMutex);
+        for (auto it = m_decodeStarts.begin(); it != m_decodeStarts.end();) {
+            if (it->second.prefetchHeavy && std::find(keep.begin(), keep.end(), it->first) == keep.end()) {
+                dropped.push_back(it->first);
+                it = m_decodeStarts.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    if (!dropped.empty()) {
+        std::lock_guard lock(m_pendingMutex);
+        for (ImageID id : dropped) m_pendingIds.erase(id);
+    }
+
+    QV_LOG("Prefetch_Plan",
+        TraceLoggingInt32((int)planner.GetMode(), "Mode"),
+        TraceLoggingFloat64(planner.IntervalMs(), "IntervalMs"),
+        TraceLoggingInt32((int)m_prefetchQueue.size(), "Jobs"),
+        TraceLoggingInt32((int)dropped.size(), "Dropped"));
+}
+
+ImageEngine::PrefetchHeader ImageEngine::GetPrefetchHeader(ImageID id, const std::wstring& path, uintmax_t fileSize) {
+    {
+        std::lock_guard lock(m_plannerMutex);
+        auto it = m_prefetchHeaders.find(id);
+        if (it != m_prefetchHeaders.end()) return it->second;
+    }
+
+    const auto info = m_loader->PeekHeader(path.c_str());
+    PrefetchHeader h;
+    h.format = info.format;
+    std::transform(h.format.begin(), h.format.end(), h.format.begin(), ::towupper);
+    h.width = info.width;
+    h.height = info.height;
+    h.heavy = info.type == CImageLoader::ImageType::TypeB_Heavy;
+    h.embeddedPreview = info.hasEmbeddedThumb && h.format.contains(L"RAW");
+    h.titanCandidate = IsTitanCandidate(h.format, info.width, info.height, fileSize);
+
+    std::lock_guard lock(m_plannerMutex);
+    if (m_prefetchHeaders.size() >= 4096) m_prefetchHeaders.clear(); // Folder change; cheap to rebuild
+    m_prefetchHeaders[id] = h;
+    return h;
+}
+
+void ImageEngine::NoteDecodeStart(ImageID id, const CImageLoader::ImageHeaderInfo& info, QuickView::PrefetchTier tier, bool prefetchHeavy) {
+    DecodeStart start;
+    start.start = std::chrono::steady_clock::now();
+    start.format = info.format;
+    std::transform(start.format.begin(), start.format.end(), start.format.begin(), ::towupper);
+    start.megapixels = (double)info.width * info.height / 1e6;
+    start.tier = tier;
+    start.prefetchHeavy = prefetchHeavy;
+
+    std::lock_guard lock(m_plannerMutex);
+    if (m_decodeStarts.size() >= 256) m_decodeStarts.clear(); // Results that never came back
+    auto it = m_decodeStarts.find(id);
+    if (it != m_decodeStarts.end() && it->second.tier != QuickView::PrefetchTier::Full &&
+        tier == QuickView::PrefetchTier::Full) {
+        // A placeholder decode may still be running: its frame must be cached as a
+        // placeholder, so the pending tier wins (the full frame is told apart by isScaled)
+        return;
+    }
+    m_decodeStarts[id] = std::move(start);
+}
+
+void ImageEngine::RequestPlaceholderUpgrade(std::wstring_view path, ImageID imageId, PaneSlot targetSlot, uint64_t generationId) {
+    bool deferred = false, spawnWakeup = false;
+    {
+        std::lock_guard lock(m_plannerMutex);
+        deferred = m_planner.GetMode() == QuickView::PrefetchPlanner::Mode::Rapid;
+        if (deferred) {
+            // Flying past: a full decode now would only be cancelled by the next step
+            // and would hold the prefetch lane meanwhile
+            const auto settle = std::chrono::duration<double, std::milli>(2.0 * m_planner.IntervalMs());
+            m_placeholderUpgrade = PlaceholderUpgrade{ path, imageId, targetSlot, generationId,
+                std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(settle) };
+            spawnWakeup = !m_upgradeWakeupPending;
+            m_upgradeWakeupPending = true;
+        } else {
+            m_placeholderUpgrade.reset();
+        }
+    }
+
+    if (spawnWakeup) {
+        // PollState only runs on events: wake it once the upgrade is due
+        std::thread([this]() {
+            for (;;) {
+                std::chrono::steady_clock::time_point due;
+                {
+                    std::lock_guard lock(m_plannerMutex);
+                    if (!m_placeholderUpgrade || std::chrono::steady_clock::now() >= m_placeholderUpgrade->due) {
+                        m_upgradeWakeupPending = false;
+                        break;
+                    }
+                    due = m_placeholderUpgrade->due;
+                }
+                std::this_thread::sleep_until(due);
+            }
+            QueueEvent(EngineEvent{}); // Wake PollState
+        }).detach();
+    }
+    if (deferred) return;
+
+    NoteDecodeStart(imageId, m_loader->PeekHeader(path.data()), QuickView::PrefetchTier::Full, false);
+    RequestFullDecode(path, imageId, targetSlot, generationId);
+}
+
+// [Readahead] Batch-read the files of the prefetch window
+void ImageEngine::IssueReadahead() {
+    if (!m_navigator || m_navigator->GetArchive()) return; // Archive entries are not files
+
+    std::vector<std::pair<ImageID, int>> window; // ID, navigator index
+    size_t budget = kReadaheadBudget;
+    for (const auto& task : m_prefetchQueue) {
+        if (task.index < 0 || task.index >= (int)m_navigator->Count()) continue;
+        const uintmax_t size = m_navigator->GetFileSize(task.index);
+        // Unknown size, or big enough to be mapped rather than buffered
+        if (size == 0 || size >= QuickView::MappedFile::kBufferedLimit) continue;
+        if (size > budget) break;
+        budget -= (size_t)size;
+        window.emplace_back(m_navigator->GetImageID(task.index), task.index);
+    }
+
+    std::vector<ImageID> toOpenIds;
+    std::vector<std::wstring> toOpen; // MappedFile opens by path
+    std::vector<std::shared_ptr<QuickView::MappedFile>> evicted;
+    {
+        std::lock_guard lock(m_readaheadMutex);
+        for (auto it = m_readahead.begin(); it != m_readahead.end();) {
+            if (std::find_if(window.begin(), window.end(), [&](const auto& w) { return w.first == it->first; }) == window.end()) {
+                evicted.push_back(std::move(it->second));
+                it = m_readahead.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        for (const auto& [id, index] : window) {
+            if (m_readahead.count(id)) continue;
+            {
+                std::lock_guard cacheLock(m_cacheMutex);
+                if (m_cache.count(id)) continue; // Already decoded
+                if (m_coldCache && m_coldCache->Contains(id)) continue; // Promotes without I/O
+            }
+            toOpenIds.push_back(id);
+            toOpen.push_back(m_navigator->GetFile(index));
+        }
+    }
+    // Left the window: destruction waits for in-flight chunks, so it happens on the GC thread
+    for (auto& file : evicted) {
+        HeavyLanePool::TrashBag bag;
+        bag.mmf = std::move(file);
+        m_heavyPool->EnqueueTrash(std::move(bag));
+    }
+    if (toOpen.empty()) return;
+
+    // One batch for the whole window (a single io_uring_enter on Linux)
+    auto files = QuickView::MappedFile::OpenReadahead(toOpen, QuickView::AsyncFileReader::Shared());
+    std::lock_guard lock(m_readaheadMutex);
+    for (size_t i = 0; i < toOpen.size(); ++i) {
+        if (files[i]) m_readahead.emplace(toOpenIds[i], std::move(files[i]));
+    }
+}
+
+std::shared_ptr<QuickView::MappedFile> ImageEngine::PeekReadahead(ImageID id) {
+    // Shared, not taken: a navigation onto the image still finds it in AcquireMapping
+    std::lock_guard lock(m_readaheadMutex);
+    auto it = m_readahead.find(id);
+    if (it == m_readahead.end() || it->second->HasReadError()) return nullptr;
+    return it->second;
+}
+
+std::shared_ptr<QuickView::MappedFile> ImageEngine::AcquireMapping(std::wstring_view path, ImageID id) {
+    {
+        std::lock_guard lock(m_readaheadMutex);
+        auto it = m_readahead.find(id);
+        if (it != m_readahead.end()) {
+            auto file = std::move(it->second);
+            m_readahead.erase(it);
+            if (!file->HasReadError()) return file;
+        }
+    }
+    // [Streaming] Seek-bound or remote media: return while the chunks are still in flight
+    const auto mode = SystemInfo::IsSolidStateDrive(path.data()) ? QuickView::MappedFile::LoadMode::Blocking
+                                                                 : QuickView::MappedFile::LoadMode::Async;
+    return std::make_shared<QuickView::MappedFile>(std::wstring(path), mode);
+}
+
+void ImageEngine::ScheduleJob(int index, QuickView::Priority pri, QuickView::PrefetchTier tier) {
     // 1. Bounds check
     if (!m_navigator) return;
     if (index < 0 || index >= (int)m_navigator->Count()) return;
     
     // 2. Get file path
-    const std::wstring& path = m_navigator->GetFile(index);
-    if (path.empty()) return;
+    const ImageID id = m_navigator->GetImageID(index);
+    const std::wstring& file = m_navigator->GetFile(index);
+    if (file.empty()) return;
     
     // 3. Check if already in cache
     {
         std::lock_guard lock(m_cacheMutex);
-        if (m_cache.count(path)) return; // Already cached
+        if (m_cache.count(id)) return; // Already cached
+        if (m_coldCache && m_coldCache->Contains(id)) return; // [Cold Tier] Promoted on demand
     }
     
     // [v9.0] Strict Startup Delay
@@ -1463,8 +1950,11 @@ void ImageEngine::ScheduleJob(int index, QuickView::Priority pri) {
     
     // [v4.1] Smart Prefetch logic re-enabled (Unified Dispatch Integration)
 
+    // [Path Table] Lanes and events carry the interned view from here on
+    const std::wstring_view path = QuickView::PathTable::Instance().Intern(file).path;
+
     // 6. Pre-flight check for classification
-    auto info = m_loader->PeekHeader(path.c_str());
+    auto info = m_loader->PeekHeader(file.c_str());
     
     // 7. Dispatch based on classification
     uintmax_t fileSize = m_navigator->GetFileSize(index);
@@ -1476,16 +1966,7 @@ void ImageEngine::ScheduleJob(int index, QuickView::Priority pri) {
     // so they DON'T consume the same heap cache. We should allow prefetch to MMF!
     std::wstring fmtUpper = info.format;
     std::transform(fmtUpper.begin(), fmtUpper.end(), fmtUpper.begin(), ::toupper);
-    const bool isTitanFormat =
-        (fmtUpper == L"JPEG" || fmtUpper == L"JPG" ||
-         fmtUpper == L"WEBP" || fmtUpper == L"PNG" ||
-         fmtUpper == L"JXL" || fmtUpper == L"TIF" ||
-         fmtUpper == L"TIFF" || fmtUpper == L"AVIF");
-    const bool isTitanCandidate =
-        isTitanFormat &&
-        ((info.width > 8192 || info.height > 8192) ||
-         ((uint64_t)info.width * (uint64_t)info.height > 50000000ULL) ||
-         ((info.width <= 0 || info.height <= 0) && fileSize >= (32ull * 1024ull * 1024ull)));
+    const bool isTitanCandidate = IsTitanCandidate(fmtUpper, info.width, info.height, fileSize);
 
     if (pri != QuickView::Priority::Critical && isTitanCandidate) {
         QV_LOG("Engine_Trace", TraceLoggingString("NonTitan Skip", "Action"));
@@ -1504,13 +1985,26 @@ void ImageEngine::ScheduleJob(int index, QuickView::Priority pri) {
          }
     }
     
+    // [Prefetch Planner] Embedded preview: no pixel decode, runs on the FastLane
+    if (tier == QuickView::PrefetchTier::EmbeddedPreview && info.hasEmbeddedThumb) {
+        {
+            std::lock_guard lock(m_pendingMutex);
+            m_pendingIds.insert(id);
+        }
+        NoteDecodeStart(id, info, tier, false);
+        m_fastLane.PushPreview(path, id,
+                               (std::max)(GetSystemMetrics(SM_CXSCREEN), GetSystemMetrics(SM_CYSCREEN)));
+        return;
+    }
+
     if (info.type == CImageLoader::ImageType::TypeA_Sprint) {
         // Small image: push to FastLane
         {
             std::lock_guard lock(m_pendingMutex);
-            m_pendingPaths.insert(path);
+            m_pendingIds.insert(id);
         }
-        m_fastLane.Push(path, ComputePathHash(path), m_targetHdrHeadroomStops.load(std::memory_order_relaxed));
+        NoteDecodeStart(id, info, QuickView::PrefetchTier::Full, false);
+        m_fastLane.Push(path, id, m_targetHdrHeadroomStops.load(std::memory_order_relaxed));
     } else if (info.type == CImageLoader::ImageType::TypeB_Heavy) {
         // Large image: 
         // Critical: Always submit
@@ -1519,15 +2013,27 @@ void ImageEngine::ScheduleJob(int index, QuickView::Priority pri) {
         if (pri == QuickView::Priority::Critical || m_heavyPool->IsIdle()) {
             {
                 std::lock_guard lock(m_pendingMutex);
-                m_pendingPaths.insert(path);
+                m_pendingIds.insert(id);
             }
             
-            // [v9.3] Alignment: JXL uses Direct Full Decode (serial upgrade cancelled).
-            // Prefetch must also be Full to prevent stuck Scaled/Blurry image.
-            if (info.format == L"JXL") {
-                m_heavyPool->SubmitFullDecode(path, ComputePathHash(path));
+            if (pri == QuickView::Priority::Critical) {
+                // [v9.3] Alignment: JXL uses Direct Full Decode (serial upgrade cancelled).
+                if (info.format == L"JXL") {
+                    m_heavyPool->SubmitFullDecode(path, id);
+                } else {
+                    m_heavyPool->Submit(path, id); // [ImageID]
+                }
+            } else if (tier == QuickView::PrefetchTier::Scaled && !IsTitanModeEnabled() && info.width > 0 && info.height > 0) {
+                // [Prefetch Planner] Screen-sized IDCT-scaled decode; upgraded on arrival
+                int targetW = 0, targetH = 0;
+                FitToScreen(info.width, info.height, &targetW, &targetH);
+                NoteDecodeStart(id, info, tier, true);
+                m_heavyPool->SubmitPrefetch(path, id, targetW, targetH, PeekReadahead(id));
             } else {
-                m_heavyPool->Submit(path, ComputePathHash(path)); // [ImageID]
+                // Full resolution (JXL included: a scaled prefetch would stick as blurry).
+                // Prefetch jobs survive navigation until a new plan drops them.
+                NoteDecodeStart(id, info, QuickView::PrefetchTier::Full, true);
+                m_heavyPool->SubmitPrefetch(path, id, 0, 0, PeekReadahead(id));
             }
         }
         // If Heavy is busy and not critical, skip prefetch
@@ -1544,7 +2050,7 @@ void ImageEngine::PruneQueue(int currentIndex, QuickView::BrowseDirection /*dir*
     EvictCache(currentIndex);
 }
 
-void ImageEngine::AddToCache(int index, const std::wstring& path, std::shared_ptr<QuickView::RawImageFrame> frame) {
+void ImageEngine::AddToCache(int index, ImageID id, std::shared_ptr<QuickView::RawImageFrame> frame, bool scaled) {
     if (!frame || !frame->IsValid()) return;
     
     // [v10.5] Skip caching for animated images - animator is stateful and cannot be deep-copied.
@@ -1559,11 +2065,13 @@ void ImageEngine::AddToCache(int index, const std::wstring& path, std::shared_pt
     std::lock_guard lock(m_cacheMutex);
     
     // 2. Check if already cached
-    auto it = m_cache.find(path);
+    auto it = m_cache.find(id);
     if (it != m_cache.end()) {
         // [v9.0] Smart Upgrade: Allow overwriting Preview with Full
-        if (it->second.frame->quality == QuickView::DecodeQuality::Preview && 
-            frame->quality == QuickView::DecodeQuality::Full) {
+        // [Prefetch Planner] ...and a placeholder tier with any full decode
+        if ((it->second.frame->quality == QuickView::DecodeQuality::Preview && 
+             frame->quality == QuickView::DecodeQuality::Full) ||
+            (it->second.scaled && !scaled)) {
             
             // Allow overwrite!
             // Remove old size from tracker
@@ -1574,10 +2082,10 @@ void ImageEngine::AddToCache(int index, const std::wstring& path, std::shared_pt
             // But we need to be careful about LRU order?
             // Existing logic pushes to push_front, but doesn't remove old LRU entry if it exists?
             // Actually AddToCache is implemented as:
-            // m_cache[path] = entry; m_lruOrder.push_front(path);
+            // m_cache[id] = entry; m_lruOrder.push_front(id);
             // If we just proceed, we get duplicate in LRU list (safe but inefficient).
             // Let's remove the old LRU entry to be clean.
-            auto lit = std::find(m_lruOrder.begin(), m_lruOrder.end(), path);
+            auto lit = std::find(m_lruOrder.begin(), m_lruOrder.end(), id);
             if (lit != m_lruOrder.end()) m_lruOrder.erase(lit);
             
         } else {
@@ -1586,36 +2094,7 @@ void ImageEngine::AddToCache(int index, const std::wstring& path, std::shared_pt
     }
     
     // 3. Memory limit check with eviction
-    while (m_currentCacheBytes + newSize > m_prefetchPolicy.maxCacheMemory && !m_lruOrder.empty()) {
-        // Find victim from LRU tail
-        std::wstring victimPath = m_lruOrder.back();
-        auto vit = m_cache.find(victimPath);
-        
-        if (vit != m_cache.end()) {
-            int victimIndex = vit->second.sourceIndex;
-            
-            // Keep Zone: Cannot evict current ±1
-            // Use m_currentViewIndex which is updated in UpdateView
-            if (abs(victimIndex - m_currentViewIndex) <= 1) {
-                // Check if the TAIL item is protected. 
-                // If it is, we need to scan deeper or just stop eviction?
-                // If the tail is protected, it means we recently accessed it?
-                // No, LRU tail is Least Recently Used.
-                // If the neighbor is at the tail, it means we haven't touched it recently.
-                // But we must protect it.
-                // Complex handling: Move it to front (protect) and try next tail?
-                // For simplicity: If tail is protected, we try to evict the ONE BEFORE tail?
-                // Or just break loop and allow over-limit (Protection > Limit).
-                // "Safety Zone" > Memory Limit.
-                break; 
-            }
-            
-            // Evict victim
-            m_currentCacheBytes -= vit->second.sizeBytes;
-            m_cache.erase(vit);
-        }
-        m_lruOrder.pop_back();
-    }
+    MakeRoomLocked(newSize);
     
     // 4. Add to cache (ProtectionZone allows exceeding limit)
     // Only add if we have space OR if it's high priority (neighbor)
@@ -1690,14 +2169,65 @@ void ImageEngine::AddToCache(int index, const std::wstring& path, std::shared_pt
         entry.frame = cachedFrame; // Now owns independent heap memory
         entry.sourceIndex = index;
         entry.sizeBytes = newSize;
+        entry.scaled = scaled;
         
-        m_cache[path] = std::move(entry);
-        m_lruOrder.push_front(path);
+        m_cache[id] = std::move(entry);
+        m_lruOrder.push_front(id);
         m_currentCacheBytes += newSize;
     }
 }
 
+void ImageEngine::MakeRoomLocked(size_t newSize) {
+    while (m_currentCacheBytes + newSize > m_prefetchPolicy.maxCacheMemory && !m_lruOrder.empty()) {
+        // Find victim from LRU tail
+        const ImageID victimId = m_lruOrder.back();
+        auto vit = m_cache.find(victimId);
+        
+        if (vit != m_cache.end()) {
+            int victimIndex = vit->second.sourceIndex;
+            
+            // Keep Zone: Cannot evict current ±1
+            // Use m_currentViewIndex which is updated in UpdateView
+            if (abs(victimIndex - m_currentViewIndex) <= 1) {
+                // Check if the TAIL item is protected. 
+                // If it is, we need to scan deeper or just stop eviction?
+                // If the tail is protected, it means we recently accessed it?
+                // No, LRU tail is Least Recently Used.
+                // If the neighbor is at the tail, it means we haven't touched it recently.
+                // But we must protect it.
+                // Complex handling: Move it to front (protect) and try next tail?
+                // For simplicity: If tail is protected, we try to evict the ONE BEFORE tail?
+                // Or just break loop and allow over-limit (Protection > Limit).
+                // "Safety Zone" > Memory Limit.
+                break; 
+            }
+            
+            // Evict victim (compressed into the cold tier when it can hold it)
+            EvictToColdLocked(vit);
+        }
+        m_lruOrder.pop_back();
+    }
+}
+
+void ImageEngine::EvictToColdLocked(std::unordered_map<ImageID, CacheEntry>::iterator it) {
+    m_currentCacheBytes -= it->second.sizeBytes;
+    // Placeholders are cheap to redo and must not come back looking like full decodes
+    if (m_coldCache && !it->second.scaled && QuickView::ColdFrameCache::Accepts(*it->second.frame)) {
+        m_coldCache->Put(it->first, std::move(it->second.frame), it->second.sourceIndex);
+    }
+    m_cache.erase(it);
+}
+
 void ImageEngine::EvictCache(int currentIndex) {
+    // [Prefetch Planner] Rapid plans reach further ahead; keep what they prefetched
+    int radius = m_prefetchPolicy.lookAheadCount + 1;
+    {
+        std::lock_guard plannerLock(m_plannerMutex);
+        if (m_planner.GetMode() == QuickView::PrefetchPlanner::Mode::Rapid) {
+            radius = m_prefetchPolicy.lookAheadCount * QuickView::PrefetchPlanner::kRapidDepthScale + 1;
+        }
+    }
+
     std::lock_guard lock(m_cacheMutex);
     
     // Evict entries far from current view
@@ -1708,9 +2238,8 @@ void ImageEngine::EvictCache(int currentIndex) {
             int idx = cit->second.sourceIndex;
             
             // Keep if within ± lookAheadCount
-            if (abs(idx - currentIndex) > m_prefetchPolicy.lookAheadCount + 1) {
-                m_currentCacheBytes -= cit->second.sizeBytes;
-                m_cache.erase(cit);
+            if (abs(idx - currentIndex) > radius) {
+                EvictToColdLocked(cit);
                 it = m_lruOrder.erase(it);
                 continue;
             }
@@ -1722,7 +2251,7 @@ void ImageEngine::EvictCache(int currentIndex) {
 // [v5.3] Async Request for Auxiliary Metadata (EXIF/Stats)
 void ImageEngine::RequestFullMetadata() {
     // Capture current state safely
-    std::wstring path = m_currentNavPath;
+    const std::wstring_view path = m_currentNavPath; // Interned: safe to hand to the thread
     ImageID id = m_currentImageId;
     
     if (path.empty()) return;
@@ -1770,7 +2299,7 @@ void ImageEngine::RequestFullMetadata() {
                 CImageLoader::ImageMetadata meta;
                 
                 // Pass 'clear=true' to ensure fresh struct
-                tempLoader.ReadMetadata(path.c_str(), &meta, true);
+                tempLoader.ReadMetadata(path.data(), &meta, true);
                 
                 EngineEvent evt;
                 evt.type = EventType::MetadataReady;
@@ -1821,14 +2350,15 @@ void ImageEngine::PumpPrefetch() {
         if (!m_navigator || task.index < 0 || task.index >= (int)m_navigator->Count()) continue;
 
         // Check cache before scheduling to avoid "scheduling nothing" and stopping
-        std::wstring path = m_navigator->GetFile(task.index);
+        const ImageID id = m_navigator->GetImageID(task.index);
         {
             std::lock_guard lock(m_cacheMutex);
-            if (m_cache.count(path)) continue; // Already cached, try next
+            if (m_cache.count(id)) continue; // Already cached, try next
+            if (m_coldCache && m_coldCache->Contains(id)) continue;
         }
 
         // Schedule it
-        ScheduleJob(task.index, task.priority);
+        ScheduleJob(task.index, task.priority, task.tier);
         
         // We assume work started (or was queued).
         // Since we checked IsIdle above, and ScheduleJob submits,
@@ -1839,17 +2369,20 @@ void ImageEngine::PumpPrefetch() {
 }
 
 // [Fix] Invalidate specific cache entry (e.g. after Edit/Save)
-void ImageEngine::InvalidateCache(const std::wstring& path) {
+void ImageEngine::InvalidateCache(std::wstring_view path) {
+    const ImageID id = ComputePathHash(path);
     std::lock_guard lock(m_cacheMutex);
+    m_invalidateEpoch++; // A promote already decompressing must not insert either
+    if (m_coldCache) m_coldCache->Erase(id); // Stale pixels must not promote back
     
-    auto cit = m_cache.find(path);
+    auto cit = m_cache.find(id);
     if (cit != m_cache.end()) {
         m_currentCacheBytes -= cit->second.sizeBytes;
         m_cache.erase(cit);
         
         // Remove from LRU list (O(N) unfortunately, but safe)
         // Finding element in list by value needs scan
-        auto lit = std::find(m_lruOrder.begin(), m_lruOrder.end(), path);
+        auto lit = std::find(m_lruOrder.begin(), m_lruOrder.end(), id);
         if (lit != m_lruOrder.end()) {
             m_lruOrder.erase(lit);
         }
@@ -1926,7 +2459,7 @@ void ImageEngine::UpdateTileViewport(QuickView::RegionRect viewport, float scale
             priority -= 100000000;
         }
 
-        batch.push_back({ coord, req, priority });
+        batch.push_back({ coord, req, priority, isInside });
     }
     
     // Use Priority Batch Submission
@@ -17,9 +17,12 @@
 #include "ImageTypes.h"    // [Direct D2D] RawImageFrame
 #include "AnimationDecoder.h" // [v10.5] Animated Formats
 #include "MappedFile.h"    // [Optimization] MMF
+#include "ColdFrameCache.h" // [Cold Tier] Compressed evicted frames
+#include "PrefetchPlanner.h" // [Prefetch Planner] Browse-rate aware depth + decode tier
 #include "EditState.h"
 #include "SystemInfo.h"  // [N+1] Hardware detection & auto-config
 #include "FileNavigator.h"  // [ImageID] For ImageID type and ComputePathHash
+#include "PathTable.h"      // [Path Table] Interned paths for events, queues and caches
 #include "PaneTypes.h"
 
 // Forward declarations
@@ -52,7 +55,7 @@ enum class EventType {
 
 struct EngineEvent {
     EventType type = EventType::None;
-    std::wstring filePath; // Which file is this event for?
+    std::wstring_view filePath; // Which file is this event for? (PathTable view, never freed)
     uint64_t navToken = 0; // [Phase 3] Navigation session token (deprecated, use imageId)
     ImageID imageId = 0;   // [ImageID Architecture] Stable content-based hash
     PaneSlot targetSlot = PaneSlot::Primary;
@@ -107,7 +110,7 @@ public:
     void CancelHeavy();  // Implementation in ImageEngine.cpp
     
     // Request full resolution decode for current image (used by JXL serial pipeline)
-    void RequestFullDecode(const std::wstring& path, ImageID imageId, PaneSlot targetSlot = PaneSlot::Primary, uint64_t generationId = 0);
+    void RequestFullDecode(std::wstring_view path, ImageID imageId, PaneSlot targetSlot = PaneSlot::Primary, uint64_t generationId = 0);
     
     // [JXL Sequential] Trigger pending Heavy task after FastLane completes
     void TriggerPendingJxlHeavy();
@@ -116,7 +119,7 @@ public:
     void RequestFullMetadata();
 
     // [Fix] Invalidate specific cache entry (e.g. after Edit/Save)
-    void InvalidateCache(const std::wstring& path);
+    void InvalidateCache(std::wstring_view path);
 
     // [v9.0] Force Refresh Signal (Atomic One-Shot)
     void SetForceRefresh(bool force) { m_forceRefresh = force; }
@@ -155,6 +158,7 @@ public:
         bool enablePrefetch = true;
         int maxCacheItems = 50;
         size_t maxCacheMemory = 1024 * 1024 * 1024; // 1GB (default)
+        size_t maxColdCacheMemory = 256 * 1024 * 1024; // [Cold Tier] Compressed budget (0 = off)
         int lookAheadCount = 5;
     };
     
@@ -164,12 +168,17 @@ public:
     const PrefetchPolicy& GetPrefetchPolicy() const { return m_prefetchPolicy; }
     size_t GetCacheMemoryUsage() const;
     int GetCacheItemCount() const;
-    std::shared_ptr<QuickView::RawImageFrame> GetCachedImage(const std::wstring& path);
+    QuickView::ColdFrameCache::Stats GetColdCacheStats() const;
+    // outScaled: the entry is a prefetch placeholder (embedded preview / scaled decode)
+    std::shared_ptr<QuickView::RawImageFrame> GetCachedImage(std::wstring_view path, bool* outScaled = nullptr);
+    std::shared_ptr<QuickView::RawImageFrame> GetCachedImage(ImageID id, bool* outScaled = nullptr);
+    // Hot cache only: never promotes from the cold tier (UI-thread peeks, repaints)
+    std::shared_ptr<QuickView::RawImageFrame> PeekCachedImage(std::wstring_view path, bool* outScaled = nullptr) const;
 
     
     // === Debug/Instrumentation API ===
     enum class HeavyState { IDLE, DECODING, CANCELLING };
-    enum class CacheStatus { EMPTY, FAST, HEAVY, PENDING };
+    enum class CacheStatus { EMPTY, FAST, HEAVY, PENDING, COLD };
     
     static constexpr int TOPOLOGY_RANGE = 2; // [-2, -1, CUR, +1, +2]
     static constexpr int HISTORY_SIZE = 60;  // 60 frames of history
@@ -243,6 +252,10 @@ public:
         size_t pmrUsed = 0;
         size_t pmrCapacity = 0;
         size_t sysMemory = 0;    // [Phase 6] Working Set
+        size_t coldBytes = 0;    // [Cold Tier] Compressed bytes held
+        size_t coldRawBytes = 0; // [Cold Tier] Decoded size of those frames
+        int coldItems = 0;
+        double coldPromoteMs = 0.0; // Last promotion back to the hot cache
     };
     
     TelemetrySnapshot GetTelemetry() const;
@@ -294,7 +307,8 @@ private:
     bool ShouldSkipFastLaneForFastFormat(const std::wstring& path);
 
     // [Phase 2] Dispatcher
-    void DispatchImageLoad(const std::wstring& path, ImageID imageId, uintmax_t fileSize, PaneSlot targetSlot, uint64_t generationId);
+    // path: interned (PathTable)
+    void DispatchImageLoad(std::wstring_view path, ImageID imageId, uintmax_t fileSize, PaneSlot targetSlot, uint64_t generationId);
 
     // --- Lane 1: The Fast Lane ---
     class FastLane {
@@ -306,7 +320,9 @@ private:
         // [v3.1] Ruthless Purge: Clear pending queue
         // [v3.1] Ruthless Purge: Clear pending queue
         void Clear();
-        void Push(const std::wstring& path, ImageID id, float targetHdrHeadroomStops = -1.0f, PaneSlot targetSlot = PaneSlot::Primary, uint64_t generationId = 0);
+        void Push(std::wstring_view path, ImageID id, float targetHdrHeadroomStops = -1.0f, PaneSlot targetSlot = PaneSlot::Primary, uint64_t generationId = 0);
+        // [Prefetch Planner] Embedded preview only (RAW), no pixel decode. Emitted as a scaled FullReady.
+        void PushPreview(std::wstring_view path, ImageID id, int longEdge);
         std::optional<EngineEvent> TryPopResult();
         bool IsQueueEmpty() const;
         
@@ -342,12 +358,14 @@ private:
         std::set<ImageID> m_pendingMetadataRequests;
 
         struct FastLaneCommand {
-            std::wstring path;
+            std::wstring_view path; // Interned
             ImageID id;
             float targetHdrHeadroomStops = -1.0f;
             PaneSlot targetSlot = PaneSlot::Primary;
             uint64_t generationId = 0;
+            int previewLongEdge = 0; // > 0: PushPreview
         };
+        void LoadEmbeddedPreview(const FastLaneCommand& cmd);
         std::deque<FastLaneCommand> m_queue; 
         std::deque<EngineEvent> m_results; 
         std::atomic<bool> m_stopSignal = false;
@@ -361,7 +379,7 @@ private:
     EngineConfig m_engineConfig;
 
     // Tracking
-    std::wstring m_currentNavPath;
+    std::wstring_view m_currentNavPath; // Interned
     std::chrono::steady_clock::time_point m_lastInputTime;
     std::atomic<float> m_targetHdrHeadroomStops{ -1.0f };
     
@@ -377,7 +395,7 @@ private:
     std::atomic<bool> m_baseLayerReady{false};
     
     // [JXL Sequential] Pending Heavy task - waits for FastLane completion
-    std::wstring m_pendingJxlHeavyPath;
+    std::wstring_view m_pendingJxlHeavyPath; // Interned
     ImageID m_pendingJxlHeavyId = 0;
     PaneSlot m_pendingJxlHeavySlot = PaneSlot::Primary;
     uint64_t m_pendingJxlHeavyGenerationId = 0;
@@ -394,7 +412,7 @@ private:
     std::atomic<int> m_lastDirectionInt{0}; // [v8.15] Atomic: -1=Back, 0=Idle, 1=Forward
     
     // [v8.15] Track pending images for HUD PENDING (blue) display
-    std::unordered_set<std::wstring> m_pendingPaths;
+    std::unordered_set<ImageID> m_pendingIds;
     mutable std::mutex m_pendingMutex;
     
     // Global Cache Entry
@@ -404,17 +422,26 @@ private:
         int status = 0; // 0=Empty, 1=Fast, 2=Heavy, 3=Pending (Legacy enum map)
         int sourceIndex = -1;
         size_t sizeBytes = 0;
+        bool scaled = false; // [Prefetch Planner] Placeholder tier: replaced by the full decode
     };
 
     // Global Cache (LRU)
-    std::unordered_map<std::wstring, CacheEntry> m_cache;
-    std::list<std::wstring> m_lruOrder; // Most recent at front
+    // [Path Table] Keyed by ImageID: lookups and LRU moves copy no path text
+    std::unordered_map<ImageID, CacheEntry> m_cache;
+    std::list<ImageID> m_lruOrder; // Most recent at front
     mutable std::mutex m_cacheMutex;
     size_t m_currentCacheBytes = 0;
+    uint64_t m_invalidateEpoch = 0; // Bumped by InvalidateCache; in-flight promotes re-check it
     
-    void AddToCache(int index, const std::wstring& path, std::shared_ptr<QuickView::RawImageFrame> frame);
+    // [Cold Tier] Frames leaving m_cache are compressed here instead of dropped.
+    // Lock order: m_cacheMutex before the cold cache's own lock.
+    std::shared_ptr<QuickView::ColdFrameCache> m_coldCache; // Shared: promotes decompress outside m_cacheMutex
+
+    void AddToCache(int index, ImageID id, std::shared_ptr<QuickView::RawImageFrame> frame, bool scaled = false);
     void EvictCache(int currentIndex);
-    void ScheduleJob(int index, QuickView::Priority priority);
+    void EvictToColdLocked(std::unordered_map<ImageID, CacheEntry>::iterator it);
+    void MakeRoomLocked(size_t newSize);
+    void ScheduleJob(int index, QuickView::Priority priority, QuickView::PrefetchTier tier = QuickView::PrefetchTier::Full);
     void PruneQueue(int currentIndex, QuickView::BrowseDirection dir);
 
     std::atomic<bool> m_startupPrefetchAllowed{false}; // [v9.0] Strict Startup Delay
@@ -430,9 +457,46 @@ private:
     struct PrefetchTask {
         int index;
         QuickView::Priority priority;
+        QuickView::PrefetchTier tier = QuickView::PrefetchTier::Full;
     };
     std::deque<PrefetchTask> m_prefetchQueue;
     void PumpPrefetch();
+
+    // [Prefetch Planner] Browse rate and per-format decode costs pick depth and tier.
+    // m_plannerMutex guards the members below; never held while taking m_cacheMutex.
+    struct PrefetchHeader {
+        std::wstring format;   // Upper-case PeekHeader format
+        int width = 0;
+        int height = 0;
+        bool heavy = false;    // TypeB_Heavy (scaled decode possible)
+        bool embeddedPreview = false;
+        bool titanCandidate = false;
+    };
+    struct DecodeStart {
+        std::chrono::steady_clock::time_point start;
+        std::wstring format;
+        double megapixels = 0.0;
+        QuickView::PrefetchTier tier = QuickView::PrefetchTier::Full;
+        bool prefetchHeavy = false; // Cancellable by RetainPrefetch
+    };
+    struct PlaceholderUpgrade {
+        std::wstring_view path; // Interned
+        ImageID imageId = 0;
+        PaneSlot targetSlot = PaneSlot::Primary;
+        uint64_t generationId = 0;
+        std::chrono::steady_clock::time_point due;
+    };
+    QuickView::PrefetchPlanner m_planner;
+    std::unordered_map<ImageID, PrefetchHeader> m_prefetchHeaders;     // Memoized PeekHeader
+    std::unordered_map<ImageID, DecodeStart> m_decodeStarts;           // Image -> running decode
+    std::optional<PlaceholderUpgrade> m_placeholderUpgrade;             // Deferred while flying past
+    bool m_upgradeWakeupPending = false;                                // A thread will wake PollState when due
+    std::mutex m_plannerMutex;
+
+    void PlanPrefetch(int currentIndex);
+    PrefetchHeader GetPrefetchHeader(ImageID id, const std::wstring& path, uintmax_t fileSize);
+    void NoteDecodeStart(ImageID id, const CImageLoader::ImageHeaderInfo& info, QuickView::PrefetchTier tier, bool prefetchHeavy);
+    void RequestPlaceholderUpgrade(std::wstring_view path, ImageID imageId, PaneSlot targetSlot, uint64_t generationId);
     
     // [v9.0] Force Refresh Flag
     std::atomic<bool> m_forceRefresh{false};
@@ -443,6 +507,15 @@ private:
     // [Optimization] Zero-Copy Source
     std::shared_ptr<QuickView::MappedFile> m_mmf;
 
+    // [Readahead] Async-filled MappedFiles for the prefetch window, keyed by ImageID.
+    // DispatchImageLoad adopts an entry, prefetch jobs share it; neither reads the file again.
+    static constexpr size_t kReadaheadBudget = 256 * 1024 * 1024;
+    std::unordered_map<ImageID, std::shared_ptr<QuickView::MappedFile>> m_readahead;
+    std::mutex m_readaheadMutex;
+    void IssueReadahead();
+    std::shared_ptr<QuickView::MappedFile> PeekReadahead(ImageID id);
+    std::shared_ptr<QuickView::MappedFile> AcquireMapping(std::wstring_view path, ImageID id);
+
 
 
 private:
@@ -45,6 +45,8 @@ using namespace QuickView;
 #include <shobjidl.h> // [Add] for IShellItemImageFactory
 #include <thread>
 #include "MiniTiff.h"
+#include "PsdComposite.h"
+#include "JpegEntryIndex.h"
 
 extern FileNavigator& g_navigator;
 
@@ -632,11 +634,6 @@ static HRESULT Load(const uint8_t *data, size_t size, const DecodeContext &ctx,
 static HRESULT LoadHdr(const uint8_t *data, size_t size,
                        const DecodeContext &ctx, DecodeResult &result);
 } // namespace Stb
-namespace PsdComposite {
-static HRESULT Load(const uint8_t *data, size_t size, const DecodeContext &ctx,
-                    DecodeResult &result);
-} // namespace PsdComposite
-
 } // namespace Codec
 } // namespace QuickView
 
@@ -645,14 +642,6 @@ using namespace QuickView::Codec;
 // [v5.0] Forward// Forward declarations
 struct IStream;
 struct IWICBitmap;
-namespace QuickView {
-namespace Codec {
-namespace PsdComposite {
-static HRESULT Load(const uint8_t *data, size_t size, const DecodeContext &ctx,
-                    DecodeResult &result);
-} // namespace PsdComposite
-} // namespace Codec
-} // namespace QuickView
 
 // Helper to detect format from buffer
 static std::wstring DetectFormatFromContent(const uint8_t *magic, size_t size) {
@@ -682,6 +671,8 @@ static std::wstring DetectFormatFromContent(const uint8_t *magic, size_t size) {
   static const uint8_t sig_ico[] = {0x00, 0x00, 0x01, 0x00};
   static const uint8_t sig_tif1[] = {0x49, 0x49, 0x2A, 0x00};
   static const uint8_t sig_tif2[] = {0x4D, 0x4D, 0x00, 0x2A};
+  static const uint8_t sig_btf1[] = {0x49, 0x49, 0x2B, 0x00}; // BigTIFF
+  static const uint8_t sig_btf2[] = {0x4D, 0x4D, 0x00, 0x2B};
 
   static const MagicSignature signatures[] = {
       {L"JPEG", 0, sig_jpeg, sizeof(sig_jpeg)},
@@ -699,7 +690,9 @@ static std::wstring DetectFormatFromContent(const uint8_t *magic, size_t size) {
       {L"PCX", 0, sig_pcx, sizeof(sig_pcx)},
       {L"ICO", 0, sig_ico, sizeof(sig_ico)},
       {L"TIFF", 0, sig_tif1, sizeof(sig_tif1)},
-      {L"TIFF", 0, sig_tif2, sizeof(sig_tif2)}};
+      {L"TIFF", 0, sig_tif2, sizeof(sig_tif2)},
+      {L"TIFF", 0, sig_btf1, sizeof(sig_btf1)},
+      {L"TIFF", 0, sig_btf2, sizeof(sig_btf2)}};
 
   for (const auto &sig : signatures) {
     if (size >= sig.offset + sig.sig_len) {
@@ -807,6 +800,65 @@ bool PrefersSdrTarget(const QuickView::Codec::DecodeContext &ctx) {
   return ctx.targetHdrHeadroomStops <= 0.01f;
 }
 
+// CPU twin of RenderEngine's SDR-output ToneMapSettings for decodes that never
+// reach the GPU (thumbnails, export, SDR-target decodes). Float results are
+// scene-linear Rec.709, so transfer and gamut are identity.
+QuickView::ToneMapSettings
+BuildSdrTargetToneMapSettings(const QuickView::Codec::DecodeResult &result,
+                              float exposure) {
+  using namespace QuickView;
+
+  ToneMapSettings settings{};
+  settings.exposure = exposure;
+  settings.exposureGain = 1.0f;
+  settings.displayPeakScRgb = (g_config.HdrPeakNitsOverride > 0.0f)
+                                  ? (g_config.HdrPeakNitsOverride / 80.0f)
+                                  : (203.0f / 80.0f);
+  settings.paperWhiteScRgb = settings.displayPeakScRgb;
+  settings.realHardwarePeakScRgb = settings.displayPeakScRgb;
+  settings.isHdrOutput = 0;
+  settings.transferFunction = static_cast<uint32_t>(TransferFunction::Linear);
+  settings.mode = static_cast<uint32_t>(g_config.HdrToneMappingMode);
+  settings.desatThreshold = g_config.HdrDesatThreshold;
+  settings.desatStrength = g_config.HdrMaxDesat;
+  settings.colorMatrix[0] = settings.colorMatrix[5] = settings.colorMatrix[10] =
+      settings.colorMatrix[15] = 1.0f;
+
+  // Content peak: pixel scan, capped by MaxCLL / mastering peak when present
+  const bool isFp16 = (result.format == PixelFormat::R16G16B16A16_FLOAT);
+  float scanPeak = 0.0f;
+  for (int y = 0; y < result.height; ++y) {
+    const uint8_t *row =
+        result.pixels + static_cast<size_t>(y) * result.stride;
+    const float rowPeak =
+        isFp16 ? ImageLoaderSimd::FindPeakLuminanceHalf(
+                     reinterpret_cast<const uint16_t *>(row), result.width)
+               : ImageLoaderSimd::FindPeakLuminanceFloat(
+                     reinterpret_cast<const float *>(row), result.width);
+    scanPeak = (std::max)(scanPeak, rowPeak);
+  }
+  const auto &hdr = result.metadata.hdrMetadata;
+  const float metadataPeak = hdr.maxCLLNits > 0.0f ? hdr.maxCLLNits / 80.0f
+                             : hdr.masteringMaxNits > 0.0f
+                                 ? hdr.masteringMaxNits / 80.0f
+                                 : 0.0f;
+  float contentPeak = scanPeak;
+  if (contentPeak <= 1.0f && metadataPeak > 1.0f)
+    contentPeak = metadataPeak;
+  else if (metadataPeak > 1.0f)
+    contentPeak = (std::min)(contentPeak, metadataPeak);
+  settings.contentPeakScRgb =
+      (std::max)((std::max)(contentPeak, 1.0f) * exposure, 1e-4f);
+
+  if (settings.mode == 0) {
+    if (settings.contentPeakScRgb <= settings.displayPeakScRgb + 1e-4f)
+      settings.mode = 1; // Content fits: the spline would be an identity
+    else
+      ImageLoaderSimd::FitSplineToneCurve(settings, g_config.HdrSplineKnee);
+  }
+  return settings;
+}
+
 HRESULT CollapseFloatResultToSdr(const QuickView::Codec::DecodeContext &ctx,
                                  QuickView::Codec::DecodeResult &result) {
   using namespace QuickView;
@@ -853,26 +905,21 @@ HRESULT CollapseFloatResultToSdr(const QuickView::Codec::DecodeContext &ctx,
   const bool useClip = (g_config.HdrToneMappingMode == 1) ||
                        (!result.metadata.hdrMetadata.isHdr);
 
-  if (isFp16) {
-    if (useClip) { // 1 = Colorimetric (Clip) or Non-HDR SDR
+  if (useClip) { // 1 = Colorimetric (Clip) or Non-HDR SDR
+    if (isFp16) {
       ImageLoaderSimd::ToneMapClipBatchHalf(
           reinterpret_cast<const uint16_t *>(result.pixels), result.stride,
           dstPixels, dstStride, result.width, result.height, kSdrExposure);
-    } else { // 0 = ACES
-      ImageLoaderSimd::ToneMapAcesBatchHalf(
-          reinterpret_cast<const uint16_t *>(result.pixels), result.stride,
-          dstPixels, dstStride, result.width, result.height, kSdrExposure);
-    }
-  } else {         // isFp32
-    if (useClip) { // 1 = Colorimetric (Clip) or Non-HDR SDR
+    } else {
       ImageLoaderSimd::ToneMapClipBatch(
           reinterpret_cast<const float *>(result.pixels), result.stride,
           dstPixels, dstStride, result.width, result.height, kSdrExposure);
-    } else { // 0 = ACES
-      ImageLoaderSimd::ToneMapAcesBatch(
-          reinterpret_cast<const float *>(result.pixels), result.stride,
-          dstPixels, dstStride, result.width, result.height, kSdrExposure);
     }
+  } else { // 0 = Spline, 2 = BT.2390 EETF: same curve as the GPU SDR path
+    ImageLoaderSimd::ToneMapHdrToSdr(result.pixels, result.stride,
+                                     result.format, dstPixels, dstStride,
+                                     result.width, result.height,
+                                     BuildSdrTargetToneMapSettings(result, kSdrExposure));
   }
 
   if (ctx.freeFunc) {
@@ -2108,7 +2155,22 @@ static HRESULT LoadJpegRegion_V3(const uint8_t *buf, size_t bufSize,
                                  QuickView::RawImageFrame *outFrame,
                                  QuickView::TileMemoryManager *tileManager,
                                  QuantumArena *arena, int explicitTargetW = 0,
-                                 int explicitTargetH = 0) {
+                                 int explicitTargetH = 0,
+                                 const QuickView::JpegEntryIndex *entryIndex = nullptr) {
+  // [Titan Perf] Start at the nearest entry point instead of entropy-decoding
+  // every MCU row above the crop. The sub-JPEG starts at an MCU row, which is a
+  // multiple of 8 and therefore exact in every TurboJPEG scaled space.
+  thread_local std::vector<uint8_t> t_subJpeg;
+  if (entryIndex && rect.h > 0) {
+    int firstRow = 0;
+    if (entryIndex->ExtractRows(buf, bufSize, rect.y, rect.y + rect.h,
+                                &t_subJpeg, &firstRow)) {
+      buf = t_subJpeg.data();
+      bufSize = t_subJpeg.size();
+      rect.y -= firstRow;
+    }
+  }
+
   // Initialize v3 Decompressor
   tjhandle tj = tj3Init(TJINIT_DECOMPRESS);
   if (!tj)
@@ -2242,8 +2304,8 @@ static HRESULT LoadJpegRegion_V3(const uint8_t *buf, size_t bufSize,
 
     size_t finalSize = outFrame->GetBufferSize();
 
-    if (tileManager && finalSize <= TILE_SLAB_SIZE) {
-      outFrame->pixels = (uint8_t *)tileManager->Allocate();
+    if (tileManager) {
+      outFrame->pixels = (uint8_t *)tileManager->Allocate(finalSize);
       if (outFrame->pixels) {
         outFrame->memoryDeleter.ctx = tileManager;
         outFrame->memoryDeleter.pfn = [](uint8_t *p, void *ctx) {
@@ -2271,9 +2333,9 @@ static HRESULT LoadJpegRegion_V3(const uint8_t *buf, size_t bufSize,
 
     // Software Resize
     // We resize into the top-left 'contentW x contentH' of the buffer.
-    ImageLoaderSimd::ResizeBilinear(pDecodeBuf, tjScdW, tjScdH, 0 /*stride*/,
-                                    outFrame->pixels, contentW, contentH,
-                                    outFrame->stride);
+    ImageLoaderSimd::Resize(pDecodeBuf, tjScdW, tjScdH, 0 /*stride*/,
+                            outFrame->pixels, contentW, contentH,
+                            outFrame->stride, ImageLoaderSimd::ResampleFilter::Mitchell);
 
     // [CMS] Extract ICC Profile from TurboJPEG (Software Resized)
     uint8_t *iccBuf = nullptr;
@@ -2299,8 +2361,8 @@ static HRESULT LoadJpegRegion_V3(const uint8_t *buf, size_t bufSize,
 
     size_t totalSize = outFrame->GetBufferSize();
 
-    if (tileManager && totalSize <= TILE_SLAB_SIZE) {
-      outFrame->pixels = (uint8_t *)tileManager->Allocate();
+    if (tileManager) {
+      outFrame->pixels = (uint8_t *)tileManager->Allocate(totalSize);
       if (outFrame->pixels) {
         outFrame->memoryDeleter.ctx = tileManager;
         outFrame->memoryDeleter.pfn = [](uint8_t *p, void *ctx) {
@@ -2383,7 +2445,8 @@ CImageLoader::LoadTileFromMemory(const uint8_t *sourceData, size_t sourceSize,
                                  QuickView::RegionRect region, float scale,
                                  QuickView::RawImageFrame *outFrame,
                                  QuickView::TileMemoryManager *tileManager,
-                                 int targetWidth, int targetHeight) {
+                                 int targetWidth, int targetHeight,
+                                 const QuickView::JpegEntryIndex *entryIndex) {
   if (!sourceData || !outFrame)
     return E_INVALIDARG;
 
@@ -2395,7 +2458,7 @@ CImageLoader::LoadTileFromMemory(const uint8_t *sourceData, size_t sourceSize,
     // 3. Tile Slab Allocation
     return LoadJpegRegion_V3(sourceData, sourceSize, region, scale, outFrame,
                              tileManager, nullptr /*arena*/, targetWidth,
-                             targetHeight);
+                             targetHeight, entryIndex);
   } __except (GetExceptionCode() == EXCEPTION_IN_PAGE_ERROR
                   ? EXCEPTION_EXECUTE_HANDLER
                   : EXCEPTION_CONTINUE_SEARCH) {
@@ -2772,19 +2835,24 @@ HRESULT CImageLoader::LoadRegionToFrame(
 
   // --- Strategy 1c: MiniTIFF Region Decoding ---
   if (format == L"TIFF") {
-    int origWidth = 0, origHeight = 0;
-    if (SUCCEEDED(GetImageSize(filePath, (UINT*)&origWidth, (UINT*)&origHeight))) {
+    QuickView::MappedFile mapping(filePath);
+    uint32_t origWidth = 0, origHeight = 0;
+    bool haveSize = mapping.IsValid() &&
+                    QuickView::MiniTiff::GetImageSize(mapping.data(), mapping.size(), &origWidth, &origHeight);
+    if (!haveSize) {
+      haveSize = SUCCEEDED(GetImageSize(filePath, &origWidth, &origHeight));
+    }
+    if (haveSize) {
       RegionScalePlan plan{};
-      if (BuildRegionScalePlan(srcRect, origWidth, origHeight, scale, targetWidth, targetHeight, &plan)) {
-        QuickView::MappedFile mapping(filePath);
+      if (BuildRegionScalePlan(srcRect, (int)origWidth, (int)origHeight, scale, targetWidth, targetHeight, &plan)) {
         if (mapping.IsValid()) {
           outFrame->width = plan.frameW;
           outFrame->height = plan.frameH;
           outFrame->stride = CalculateAlignedStride(plan.frameW, 4);
           outFrame->format = PixelFormat::BGRA8888;
           size_t totalSize = outFrame->GetBufferSize();
-          if (tileManager && totalSize <= TILE_SLAB_SIZE) {
-            outFrame->pixels = (uint8_t *)tileManager->Allocate();
+          if (tileManager) {
+            outFrame->pixels = (uint8_t *)tileManager->Allocate(totalSize);
             if (outFrame->pixels) {
               outFrame->memoryDeleter.ctx = tileManager;
               outFrame->memoryDeleter.pfn = [](uint8_t *p, void *ctx) {
@@ -2809,17 +2877,49 @@ HRESULT CImageLoader::LoadRegionToFrame(
             return static_cast<uint8_t*>(_aligned_malloc(s, 64));
           };
           tiffCtx.checkCancel = checkCancel;
+          tiffCtx.helperThreads = 0; // Tiles already decode in parallel on the pool
 
           QuickView::Codec::DecodeResult roiResult;
+          QuickView::MiniTiff::RegionWindow roiWindow;
+          // Pyramidal TIFFs return the crop from the coarsest level covering `scale`,
+          // widened to whole level pixels; roiWindow is the exact crop inside it
           HRESULT hrRegion = QuickView::MiniTiff::LoadRegion(
               mapping.data(), mapping.size(), tiffCtx, roiResult,
-              plan.cropX, plan.cropY, plan.cropW, plan.cropH
+              plan.cropX, plan.cropY, plan.cropW, plan.cropH, scale, &roiWindow
           );
 
+          if (SUCCEEDED(hrRegion) && roiResult.format != QuickView::PixelFormat::BGRA8888) {
+            // Float TIFF crops: tiles are BGRA, so clip at the SDR baseline before resizing
+            const int bgraStride = CalculateSIMDAlignedStride(roiResult.width, 4);
+            uint8_t *bgra = static_cast<uint8_t *>(
+                _aligned_malloc(static_cast<size_t>(bgraStride) * roiResult.height, 64));
+            if (bgra) {
+              const float kSdrExposure = 0.8f;
+              if (roiResult.format == QuickView::PixelFormat::R16G16B16A16_FLOAT) {
+                ImageLoaderSimd::ToneMapClipBatchHalf(
+                    reinterpret_cast<const uint16_t *>(roiResult.pixels), roiResult.stride,
+                    bgra, bgraStride, roiResult.width, roiResult.height, kSdrExposure);
+              } else {
+                ImageLoaderSimd::ToneMapClipBatch(
+                    reinterpret_cast<const float *>(roiResult.pixels), roiResult.stride,
+                    bgra, bgraStride, roiResult.width, roiResult.height, kSdrExposure);
+              }
+            } else {
+              hrRegion = E_OUTOFMEMORY;
+            }
+            _aligned_free(roiResult.pixels);
+            roiResult.pixels = bgra;
+            roiResult.stride = bgraStride;
+            roiResult.format = QuickView::PixelFormat::BGRA8888;
+          }
+
           if (SUCCEEDED(hrRegion)) {
-            ImageLoaderSimd::ResizeBilinear(
-                roiResult.pixels, plan.cropW, plan.cropH, roiResult.stride,
-                outFrame->pixels, plan.contentW, plan.contentH, outFrame->stride
+            // Sampling the exact window keeps adjacent tiles registered (no seams)
+            ImageLoaderSimd::ResizeRegion(
+                roiResult.pixels, roiResult.width, roiResult.height, roiResult.stride,
+                roiWindow.x, roiWindow.y, roiWindow.width, roiWindow.height,
+                outFrame->pixels, plan.contentW, plan.contentH, outFrame->stride,
+                ImageLoaderSimd::ResampleFilter::Mitchell
             );
             if (roiResult.pixels) {
               _aligned_free(roiResult.pixels);
@@ -2887,8 +2987,8 @@ HRESULT CImageLoader::LoadRegionGeneric_StrategyB(
   outFrame->format = fullFrame.format;
 
   size_t totalSize = outFrame->GetBufferSize();
-  if (tileManager && totalSize <= TILE_SLAB_SIZE) {
-    outFrame->pixels = (uint8_t *)tileManager->Allocate();
+  if (tileManager) {
+    outFrame->pixels = (uint8_t *)tileManager->Allocate(totalSize);
     if (outFrame->pixels) {
       outFrame->memoryDeleter.ctx = tileManager;
       outFrame->memoryDeleter.pfn = [](uint8_t *p, void *ctx) {
@@ -2911,11 +3011,11 @@ HRESULT CImageLoader::LoadRegionGeneric_StrategyB(
   }
 
   // Resize/Crop from Full Image to Out Frame
-  ImageLoaderSimd::ResizeBilinear(
+  ImageLoaderSimd::Resize(
       fullFrame.pixels + (size_t)plan.cropY * fullFrame.stride +
           (size_t)plan.cropX * 4,
       plan.cropW, plan.cropH, (int)fullFrame.stride, outFrame->pixels,
-      plan.contentW, plan.contentH, outFrame->stride);
+      plan.contentW, plan.contentH, outFrame->stride, ImageLoaderSimd::ResampleFilter::Mitchell);
 
   return S_OK;
 }
@@ -2982,8 +3082,8 @@ HRESULT CImageLoader::LoadWebPRegionToFrame(
 
   size_t totalSize = outFrame->GetBufferSize();
 
-  if (tileManager && totalSize <= TILE_SLAB_SIZE) {
-    outFrame->pixels = (uint8_t *)tileManager->Allocate();
+  if (tileManager) {
+    outFrame->pixels = (uint8_t *)tileManager->Allocate(totalSize);
     if (outFrame->pixels) {
       outFrame->memoryDeleter.ctx = tileManager;
       outFrame->memoryDeleter.pfn = [](uint8_t *p, void *ctx) {
@@ -3225,8 +3325,8 @@ HRESULT CImageLoader::LoadJxlRegionToFrame(
 
   size_t totalSize = outFrame->GetBufferSize();
 
-  if (tileManager && totalSize <= TILE_SLAB_SIZE) {
-    outFrame->pixels = (uint8_t *)tileManager->Allocate();
+  if (tileManager) {
+    outFrame->pixels = (uint8_t *)tileManager->Allocate(totalSize);
     if (outFrame->pixels) {
       outFrame->memoryDeleter.ctx = tileManager;
       outFrame->memoryDeleter.pfn = [](uint8_t *p, void *ctx) {
@@ -3260,9 +3360,9 @@ HRESULT CImageLoader::LoadJxlRegionToFrame(
   // Remember libjxl outputs RGBA, we need BGRA
   ImageLoaderSimd::SwizzleRGBAToBGRA(tempBuf, (size_t)plan.cropW * plan.cropH);
 
-  ImageLoaderSimd::ResizeBilinear(tempBuf, plan.cropW, plan.cropH, tempStride,
-                                  outFrame->pixels, plan.contentW,
-                                  plan.contentH, outFrame->stride);
+  ImageLoaderSimd::Resize(tempBuf, plan.cropW, plan.cropH, tempStride,
+                          outFrame->pixels, plan.contentW,
+                          plan.contentH, outFrame->stride, ImageLoaderSimd::ResampleFilter::Mitchell);
 
   // Cleanup
   if (tempBuf && !arena) {
@@ -3765,9 +3865,9 @@ static HRESULT DownscaleThumbDataIfNeeded(CImageLoader::ThumbData *pData,
         pData->height, pData->stride, reinterpret_cast<float *>(resized.data()),
         finalW, finalH, finalStride);
   } else {
-    ImageLoaderSimd::ResizeBilinear(
+    ImageLoaderSimd::Resize(
         pData->pixels.data(), pData->width, pData->height, pData->stride,
-        resized.data(), finalW, finalH, finalStride);
+        resized.data(), finalW, finalH, finalStride, ImageLoaderSimd::ResampleFilter::Lanczos3);
   }
 
   pData->pixels = std::move(resized);
@@ -8149,444 +8249,6 @@ static HRESULT Load(const uint8_t *data, size_t size, const DecodeContext &ctx,
 }
 } // namespace TinyEXR
 
-namespace PsdComposite {
-struct HeaderInfo {
-  uint16_t version = 0; // 1=PSD, 2=PSB
-  uint16_t channels = 0;
-  uint32_t width = 0;
-  uint32_t height = 0;
-  uint16_t depth = 0;       // 8/16 supported
-  uint16_t colorMode = 0;   // 1=Gray, 3=RGB supported
-  uint16_t compression = 0; // 0=Raw, 1=RLE
-  size_t imageDataOffset = 0;
-};
-
-static inline uint16_t ReadBE16(const uint8_t *p) {
-  return static_cast<uint16_t>((static_cast<uint16_t>(p[0]) << 8) | p[1]);
-}
-
-static inline uint32_t ReadBE32(const uint8_t *p) {
-  return (static_cast<uint32_t>(p[0]) << 24) |
-         (static_cast<uint32_t>(p[1]) << 16) |
-         (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
-}
-
-static inline uint64_t ReadBE64(const uint8_t *p) {
-  return (static_cast<uint64_t>(p[0]) << 56) |
-         (static_cast<uint64_t>(p[1]) << 48) |
-         (static_cast<uint64_t>(p[2]) << 40) |
-         (static_cast<uint64_t>(p[3]) << 32) |
-         (static_cast<uint64_t>(p[4]) << 24) |
-         (static_cast<uint64_t>(p[5]) << 16) |
-         (static_cast<uint64_t>(p[6]) << 8) | static_cast<uint64_t>(p[7]);
-}
-
-static inline bool FitsRange(size_t offset, size_t need, size_t size) {
-  return offset <= size && need <= (size - offset);
-}
-
-static bool ParseHeader(const uint8_t *data, size_t size, HeaderInfo &out) {
-  if (!data || size < 26)
-    return false;
-  if (std::memcmp(data, "8BPS", 4) != 0)
-    return false;
-
-  out.version = ReadBE16(data + 4);
-  if (out.version != 1 && out.version != 2)
-    return false;
-
-  out.channels = ReadBE16(data + 12);
-  out.height = ReadBE32(data + 14);
-  out.width = ReadBE32(data + 18);
-  out.depth = ReadBE16(data + 22);
-  out.colorMode = ReadBE16(data + 24);
-
-  if (out.channels == 0 || out.width == 0 || out.height == 0)
-    return false;
-
-  size_t off = 26;
-
-  if (!FitsRange(off, 4, size))
-    return false;
-  const uint32_t colorModeLen = ReadBE32(data + off);
-  off += 4;
-  if (!FitsRange(off, colorModeLen, size))
-    return false;
-  off += static_cast<size_t>(colorModeLen);
-
-  if (!FitsRange(off, 4, size))
-    return false;
-  const uint32_t imageResLen = ReadBE32(data + off);
-  off += 4;
-  if (!FitsRange(off, imageResLen, size))
-    return false;
-  off += static_cast<size_t>(imageResLen);
-
-  uint64_t layerMaskLen = 0;
-  if (out.version == 1) {
-    if (!FitsRange(off, 4, size))
-      return false;
-    layerMaskLen = ReadBE32(data + off);
-    off += 4;
-  } else {
-    if (!FitsRange(off, 8, size))
-      return false;
-    layerMaskLen = ReadBE64(data + off);
-    off += 8;
-  }
-
-  if (layerMaskLen > static_cast<uint64_t>(size - off))
-    return false;
-  off += static_cast<size_t>(layerMaskLen);
-
-  if (!FitsRange(off, 2, size))
-    return false;
-  out.compression = ReadBE16(data + off);
-  out.imageDataOffset = off;
-  return true;
-}
-
-
-
-static bool DecodePackBitsRow(const uint8_t *src, size_t srcSize, uint8_t *dst,
-                              size_t dstSize) {
-  size_t si = 0;
-  size_t di = 0;
-
-  while (si < srcSize && di < dstSize) {
-    const int8_t n = static_cast<int8_t>(src[si++]);
-    if (n >= 0) {
-      const size_t count = static_cast<size_t>(n) + 1;
-      if (count > srcSize - si || count > dstSize - di)
-        return false;
-      std::memcpy(dst + di, src + si, count);
-      si += count;
-      di += count;
-    } else if (n >= -127) {
-      if (si >= srcSize)
-        return false;
-      const uint8_t value = src[si++];
-      const size_t count = static_cast<size_t>(1 - n);
-      if (count > dstSize - di)
-        return false;
-      std::memset(dst + di, value, count);
-      di += count;
-    } else {
-      // n == -128: no-op
-    }
-  }
-
-  return di == dstSize;
-}
-
-static inline uint8_t Sample16To8Bit(const uint8_t *row, uint32_t srcX) {
-  const size_t offset = static_cast<size_t>(srcX) * 2;
-  uint32_t val = (static_cast<uint32_t>(row[offset]) << 8) | row[offset + 1];
-  if (val > 32768) val = 32768;
-  // Map [0, 32768] -> [0, 255] with rounding
-  return static_cast<uint8_t>((val * 255 + 16384) / 32768);
-}
-
-static void WriteChannelToBgraRow(uint8_t *dstRow,
-                                  const std::vector<uint32_t> &srcXForOut,
-                                  const uint8_t *srcRow, uint16_t depth,
-                                  uint16_t colorMode, uint16_t channelIndex) {
-  const size_t outW = srcXForOut.size();
-  if (colorMode == 3) {
-    if (depth == 16) {
-      if (channelIndex == 0) {
-        for (size_t ox = 0; ox < outW; ++ox) dstRow[ox * 4 + 2] = Sample16To8Bit(srcRow, srcXForOut[ox]);
-      } else if (channelIndex == 1) {
-        for (size_t ox = 0; ox < outW; ++ox) dstRow[ox * 4 + 1] = Sample16To8Bit(srcRow, srcXForOut[ox]);
-      } else if (channelIndex == 2) {
-        for (size_t ox = 0; ox < outW; ++ox) dstRow[ox * 4 + 0] = Sample16To8Bit(srcRow, srcXForOut[ox]);
-      } else if (channelIndex == 3) {
-        for (size_t ox = 0; ox < outW; ++ox) dstRow[ox * 4 + 3] = Sample16To8Bit(srcRow, srcXForOut[ox]);
-      }
-    } else {
-      if (channelIndex == 0) {
-        for (size_t ox = 0; ox < outW; ++ox) dstRow[ox * 4 + 2] = srcRow[srcXForOut[ox]];
-      } else if (channelIndex == 1) {
-        for (size_t ox = 0; ox < outW; ++ox) dstRow[ox * 4 + 1] = srcRow[srcXForOut[ox]];
-      } else if (channelIndex == 2) {
-        for (size_t ox = 0; ox < outW; ++ox) dstRow[ox * 4 + 0] = srcRow[srcXForOut[ox]];
-      } else if (channelIndex == 3) {
-        for (size_t ox = 0; ox < outW; ++ox) dstRow[ox * 4 + 3] = srcRow[srcXForOut[ox]];
-      }
-    }
-  } else if (colorMode == 1) {
-    if (depth == 16) {
-      if (channelIndex == 0) {
-        for (size_t ox = 0; ox < outW; ++ox) {
-          uint8_t v = Sample16To8Bit(srcRow, srcXForOut[ox]);
-          dstRow[ox * 4 + 0] = v;
-          dstRow[ox * 4 + 1] = v;
-          dstRow[ox * 4 + 2] = v;
-        }
-      } else if (channelIndex == 1) {
-        for (size_t ox = 0; ox < outW; ++ox) dstRow[ox * 4 + 3] = Sample16To8Bit(srcRow, srcXForOut[ox]);
-      }
-    } else {
-      if (channelIndex == 0) {
-        for (size_t ox = 0; ox < outW; ++ox) {
-          uint8_t v = srcRow[srcXForOut[ox]];
-          dstRow[ox * 4 + 0] = v;
-          dstRow[ox * 4 + 1] = v;
-          dstRow[ox * 4 + 2] = v;
-        }
-      } else if (channelIndex == 1) {
-        for (size_t ox = 0; ox < outW; ++ox) dstRow[ox * 4 + 3] = srcRow[srcXForOut[ox]];
-      }
-    }
-  }
-}
-
-static HRESULT Load(const uint8_t *data, size_t size, const DecodeContext &ctx,
-                    DecodeResult &result) {
-  HeaderInfo header;
-  if (!ParseHeader(data, size, header))
-    return E_FAIL;
-
-  const bool supportedColorMode =
-      (header.colorMode == 3 || header.colorMode == 1);
-  const bool supportedDepth = (header.depth == 8 || header.depth == 16);
-  const bool supportedCompression =
-      (header.compression == 0 || header.compression == 1);
-  if (!supportedColorMode || !supportedDepth || !supportedCompression)
-    return E_NOTIMPL;
-
-  if (header.colorMode == 3 && header.channels < 3)
-    return E_FAIL;
-  if (header.colorMode == 1 && header.channels < 1)
-    return E_FAIL;
-
-  uint32_t outW = header.width;
-  uint32_t outH = header.height;
-  if (ctx.targetWidth > 0 || ctx.targetHeight > 0) {
-    const double tw = (ctx.targetWidth > 0)
-                          ? static_cast<double>(ctx.targetWidth)
-                          : static_cast<double>(header.width);
-    const double th = (ctx.targetHeight > 0)
-                          ? static_cast<double>(ctx.targetHeight)
-                          : static_cast<double>(header.height);
-    double scale = (std::min)(tw / static_cast<double>(header.width),
-                              th / static_cast<double>(header.height));
-    if (scale > 1.0)
-      scale = 1.0;
-    if (scale > 0.0 && scale < 1.0) {
-      outW = (std::max)(1u, static_cast<uint32_t>(header.width * scale + 0.5));
-      outH = (std::max)(1u, static_cast<uint32_t>(header.height * scale + 0.5));
-    }
-  }
-
-  const int stride = CalculateSIMDAlignedStride(static_cast<int>(outW), 4);
-  if (stride <= 0)
-    return E_FAIL;
-
-  const size_t totalSize =
-      static_cast<size_t>(stride) * static_cast<size_t>(outH);
-  uint8_t *pixels = ctx.allocator(totalSize);
-  if (!pixels)
-    return E_OUTOFMEMORY;
-
-  std::memset(pixels, 0, totalSize);
-  for (uint32_t y = 0; y < outH; ++y) {
-    uint8_t *row = pixels + static_cast<size_t>(y) * stride;
-    for (uint32_t x = 0; x < outW; ++x) {
-      row[static_cast<size_t>(x) * 4 + 3] = 255;
-    }
-  }
-
-  std::vector<uint32_t> srcXForOut(outW);
-  for (uint32_t ox = 0; ox < outW; ++ox) {
-    uint32_t sx = static_cast<uint32_t>(
-        (static_cast<uint64_t>(ox) * header.width) / outW);
-    if (sx >= header.width)
-      sx = header.width - 1;
-    srcXForOut[ox] = sx;
-  }
-
-  std::vector<int32_t> srcYToOut(header.height, -1);
-  for (uint32_t oy = 0; oy < outH; ++oy) {
-    uint32_t sy = static_cast<uint32_t>(
-        (static_cast<uint64_t>(oy) * header.height) / outH);
-    if (sy >= header.height)
-      sy = header.height - 1;
-    srcYToOut[sy] = static_cast<int32_t>(oy);
-  }
-
-  const size_t rowBytes =
-      static_cast<size_t>(header.width) * ((header.depth == 16) ? 2u : 1u);
-  const size_t compressionOffset = header.imageDataOffset + 2;
-
-  const auto isRelevantChannel = [&](uint16_t c) -> bool {
-    if (header.colorMode == 3)
-      return c < 4; // Always decode alpha to inspect its transparency details at runtime
-    if (header.colorMode == 1)
-      return c < 2;
-    return false;
-  };
-
-  if (header.compression == 0) {
-    if (!FitsRange(compressionOffset, 0, size))
-      return E_FAIL;
-    const uint8_t *ptr = data + compressionOffset;
-    const uint8_t *end = data + size;
-
-    for (uint16_t c = 0; c < header.channels; ++c) {
-      for (uint32_t sy = 0; sy < header.height; ++sy) {
-        if (ctx.checkCancel && (sy % 128 == 0) && ctx.checkCancel())
-          return E_ABORT;
-        if (ptr > end || rowBytes > static_cast<size_t>(end - ptr))
-          return E_FAIL;
-
-        const int32_t oy = srcYToOut[sy];
-        if (oy >= 0 && isRelevantChannel(c)) {
-          uint8_t *dstRow = pixels + static_cast<size_t>(oy) * stride;
-          WriteChannelToBgraRow(dstRow, srcXForOut, ptr, header.depth,
-                                header.colorMode, c);
-        }
-        ptr += rowBytes;
-      }
-    }
-  } else {
-    const uint64_t numRows = static_cast<uint64_t>(header.channels) *
-                             static_cast<uint64_t>(header.height);
-    const size_t rleLenField = (header.version == 2) ? 4u : 2u;
-    if (numRows > (std::numeric_limits<size_t>::max() / rleLenField))
-      return E_FAIL;
-    const size_t rleTableBytes = static_cast<size_t>(numRows) * rleLenField;
-    if (!FitsRange(compressionOffset, rleTableBytes, size))
-      return E_FAIL;
-
-    const uint8_t *rleLenTable = data + compressionOffset;
-    const uint8_t *compPtr = rleLenTable + rleTableBytes;
-    const uint8_t *end = data + size;
-    std::vector<uint8_t> decodedRow(rowBytes);
-
-    for (uint16_t c = 0; c < header.channels; ++c) {
-      for (uint32_t sy = 0; sy < header.height; ++sy) {
-        if (ctx.checkCancel && (sy % 128 == 0) && ctx.checkCancel())
-          return E_ABORT;
-
-        const uint64_t idx = static_cast<uint64_t>(c) * header.height + sy;
-        const uint8_t *lenPtr =
-            rleLenTable + static_cast<size_t>(idx) * rleLenField;
-        const uint32_t packedLen =
-            (rleLenField == 2) ? ReadBE16(lenPtr) : ReadBE32(lenPtr);
-
-        if (compPtr > end || packedLen > static_cast<uint32_t>(end - compPtr))
-          return E_FAIL;
-
-        const int32_t oy = srcYToOut[sy];
-        if (oy >= 0 && isRelevantChannel(c)) {
-          if (!DecodePackBitsRow(compPtr, packedLen, decodedRow.data(),
-                                 rowBytes))
-            return E_FAIL;
-          uint8_t *dstRow = pixels + static_cast<size_t>(oy) * stride;
-          WriteChannelToBgraRow(dstRow, srcXForOut, decodedRow.data(),
-                                header.depth, header.colorMode, c);
-        }
-
-        compPtr += packedLen;
-      }
-    }
-  }
-
-  // Evaluate true transparency using zero-alpha RGB check heuristic to avoid showing
-  // checkerboard grids in dark shadow regions where a custom alpha channel name is saved.
-  if (header.channels >= (header.colorMode == 3 ? 4u : 2u)) {
-    size_t zeroAlphaCount = 0;
-    size_t zeroAlphaButNotEmptyCount = 0;
-    const bool isRgb = (header.colorMode == 3);
-
-    for (uint32_t y = 0; y < outH; ++y) {
-      uint8_t *row = pixels + static_cast<size_t>(y) * stride;
-      for (uint32_t x = 0; x < outW; ++x) {
-        uint8_t a = row[x * 4 + 3];
-        if (a == 0) {
-          zeroAlphaCount++;
-          if (isRgb) {
-            if (row[x * 4 + 2] != 255 || row[x * 4 + 1] != 255 ||
-                row[x * 4 + 0] != 255) {
-              zeroAlphaButNotEmptyCount++;
-            }
-          } else {
-            if (row[x * 4 + 0] != 255) {
-              zeroAlphaButNotEmptyCount++;
-            }
-          }
-        }
-      }
-    }
-
-    bool hasTransparency = false;
-    if (zeroAlphaCount > 0) {
-      const size_t maxLeak =
-          (std::max)(static_cast<size_t>(50), zeroAlphaCount / 50);
-      if (zeroAlphaButNotEmptyCount <= maxLeak) {
-        hasTransparency = true;
-      }
-    }
-
-    if (!hasTransparency) {
-#pragma omp parallel for schedule(dynamic, 64)
-      for (int y = 0; y < static_cast<int>(outH); ++y) {
-        uint8_t *row = pixels + static_cast<size_t>(y) * stride;
-        for (uint32_t x = 0; x < outW; ++x) {
-          row[x * 4 + 3] = 255;
-        }
-      }
-    } else {
-      // In-place premultiply straight RGB by Alpha because Direct2D renders
-      // BGRA8888 in D2D1_ALPHA_MODE_PREMULTIPLIED mode.
-      ImageLoaderSimd::PremultiplyAlpha(pixels, outW, outH, stride);
-    }
-  }
-
-  result.pixels = pixels;
-  result.width = static_cast<int>(outW);
-  result.height = static_cast<int>(outH);
-  result.stride = stride;
-  result.format = PixelFormat::BGRA8888;
-  result.success = true;
-  result.metadata.Format = (header.version == 2) ? L"PSB" : L"PSD";
-  result.metadata.LoaderName =
-      (header.version == 2) ? L"PSB Composite" : L"PSD Composite";
-  result.metadata.Width = header.width;
-  result.metadata.Height = header.height;
-
-  std::wstring details =
-      (header.version == 2) ? L"PSB v2 Composite" : L"PSD Composite";
-  details += (header.compression == 0) ? L" Raw" : L" RLE";
-  if (header.depth == 16)
-    details += L" 16bpc";
-  else if (header.depth == 32)
-    details += L" 32bpc";
-  if (outW != header.width || outH != header.height)
-    details += L" [Scaled]";
-  result.metadata.FormatDetails = details;
-  result.metadata.colorInfo.nominalBitDepth = static_cast<uint8_t>(
-      (std::min)(header.depth, static_cast<uint16_t>(255)));
-  result.metadata.colorInfo.primaries = QuickView::ColorPrimaries::SRGB;
-  result.metadata.colorInfo.transfer = (header.depth >= 32)
-                                           ? QuickView::TransferFunction::Linear
-                                           : QuickView::TransferFunction::SRGB;
-  result.metadata.colorInfo.dataSpace =
-      (header.depth >= 32) ? QuickView::PixelDataSpace::SceneLinear
-                           : QuickView::PixelDataSpace::EncodedSdr;
-  // Populate HDR metadata for high bit-depth PSD/PSB
-  result.metadata.hdrMetadata.isValid = true;
-  result.metadata.hdrMetadata.transfer =
-      (header.depth >= 32) ? QuickView::TransferFunction::Linear
-                           : QuickView::TransferFunction::SRGB;
-  result.metadata.hdrMetadata.primaries = QuickView::ColorPrimaries::SRGB;
-  result.metadata.hdrMetadata.isHdr = (header.depth >= 32);
-  result.metadata.hdrMetadata.isSceneLinear = (header.depth >= 32);
-  return S_OK;
-}
-} // namespace PsdComposite
-
 namespace Stb {
 static HRESULT Load(const uint8_t *data, size_t size, const DecodeContext &ctx,
                     DecodeResult &result) {
@@ -9220,6 +8882,11 @@ HRESULT CImageLoader::LoadImageUnifiedInternal(LPCWSTR filePath,
       if (fmt == L"TIFF") {
         HRESULT hr = QuickView::MiniTiff::Load(mappedData, mappedSize, ctx, result);
         if (SUCCEEDED(hr)) {
+          // Float TIFFs follow the EXR path: stay float for the GPU tone-mapper,
+          // collapse to BGRA only for SDR-only consumers
+          HRESULT collapseHr = CollapseFloatResultToSdr(ctx, result);
+          if (FAILED(collapseHr))
+            return collapseHr;
           return S_OK;
         }
         if (hr == E_OUTOFMEMORY || hr == E_ABORT) {
@@ -11525,11 +11192,6 @@ void CImageLoader::ComputeHistogramFromFrame(
   if (!frame.pixels || frame.width == 0 || frame.height == 0 || !pMetadata)
     return;
 
-  pMetadata->HistR.assign(256, 0);
-  pMetadata->HistG.assign(256, 0);
-  pMetadata->HistB.assign(256, 0);
-  pMetadata->HistL.assign(256, 0);
-
   // Skip Sampling (Target ~2MP samples)
   UINT64 totalPixels = (UINT64)frame.width * frame.height;
   UINT stepY = 1;
@@ -11542,94 +11204,47 @@ void CImageLoader::ComputeHistogramFromFrame(
       stepY = 1;
   }
 
-  const uint8_t *ptr = frame.pixels;
-  int stride = frame.stride;
-  const UINT lapStep = stepY;
-  double lapSumSq = 0.0;
-  uint64_t lapCount = 0;
-
-  bool isFloat = (frame.format == PixelFormat::R32G32B32A32_FLOAT);
+  ImageLoaderSimd::FrameStatsSource src;
+  src.pixels = frame.pixels;
+  src.width = frame.width;
+  src.height = frame.height;
+  src.stride = frame.stride;
+  src.isFloat = (frame.format == PixelFormat::R32G32B32A32_FLOAT);
 
   // [Bug Fix] Capture auxLayer safely to avoid race conditions during async
   // updates
   const QuickView::AuxLayer *pAux = frame.auxLayer.get();
   bool hasGainMap =
       (frame.blendOp == GpuBlendOp::UltraHdrGainMap && pAux && pAux->pixels);
-  int auxWidth = hasGainMap ? pAux->width : 0;
-  int auxHeight = hasGainMap ? pAux->height : 0;
-  int auxStride = hasGainMap ? pAux->stride : 0;
-  const uint8_t *auxPixels = hasGainMap ? pAux->pixels : nullptr;
-
-  for (UINT y = 0; y < (UINT)frame.height; y += stepY) {
-    const uint8_t *row = ptr + (UINT64)y * stride;
-
-    if (isFloat) {
-      float mapRange = 4.0f; // Default 4.0x SDR headroom
-      if (frame.hdrMetadata.masteringMaxNits > 80.f) {
-        mapRange = frame.hdrMetadata.masteringMaxNits / 80.0f;
-      }
-      pMetadata->HistMapRange = mapRange;
-      ImageLoaderSimd::ComputeHistogramRowFloat(
-          (const float *)row, frame.width, mapRange, pMetadata->HistR.data(),
-          pMetadata->HistG.data(), pMetadata->HistB.data(),
-          pMetadata->HistL.data());
-    } else if (hasGainMap) {
-      float mapRange = std::exp2(frame.shaderPayload.targetHeadroom);
-      pMetadata->HistMapRange = mapRange;
-      UINT auxY = (y * auxHeight) / frame.height;
-      if (auxY >= (UINT)auxHeight)
-        auxY = auxHeight > 0 ? auxHeight - 1 : 0;
-      const uint8_t *auxRow = auxPixels + (UINT64)auxY * auxStride;
-      ImageLoaderSimd::ComputeHistogramRowGainMap(
-          row, auxRow, frame.width, auxWidth, mapRange, frame.shaderPayload,
-          pMetadata->HistR.data(), pMetadata->HistG.data(),
-          pMetadata->HistB.data(), pMetadata->HistL.data());
-    } else {
-      pMetadata->HistMapRange = 1.0f;
-      // [Highway] Delegate histogram + luminance computation to dynamic
-      // dispatch
-      ImageLoaderSimd::ComputeHistogramRow(
-          row, frame.width, pMetadata->HistR.data(), pMetadata->HistG.data(),
-          pMetadata->HistB.data(), pMetadata->HistL.data());
-    }
-  }
-
-  // Laplacian Sharpness (sampled)
-  if ((UINT)frame.width > lapStep * 2 && (UINT)frame.height > lapStep * 2) {
-    auto getLumaAt = [&](const uint8_t *rowPtr, UINT x) -> int {
-      if (isFloat) {
-        const float *px = (const float *)rowPtr + x * 4;
-        float r = px[0], g = px[1], b = px[2];
-        return (int)std::clamp((r * 0.299f + g * 0.587f + b * 0.114f) * 255.0f,
-                               0.0f, 255.0f);
-      } else {
-        const uint8_t b = rowPtr[x * 4 + 0];
-        const uint8_t g = rowPtr[x * 4 + 1];
-        const uint8_t r = rowPtr[x * 4 + 2];
-        return (int)((54 * r + 183 * g + 19 * b) >> 8);
-      }
-    };
-
-    for (UINT y = lapStep; y + lapStep < (UINT)frame.height; y += lapStep) {
-      const uint8_t *rowPrev = ptr + (UINT64)(y - lapStep) * stride;
-      const uint8_t *rowCurr = ptr + (UINT64)y * stride;
-      const uint8_t *rowNext = ptr + (UINT64)(y + lapStep) * stride;
-
-      for (UINT x = lapStep; x + lapStep < (UINT)frame.width; x += lapStep) {
-        const int center = getLumaAt(rowCurr, x);
-        const int left = getLumaAt(rowCurr, x - lapStep);
-        const int right = getLumaAt(rowCurr, x + lapStep);
-        const int up = getLumaAt(rowPrev, x);
-        const int down = getLumaAt(rowNext, x);
-        const int lap = (up + down + left + right) - 4 * center;
-        lapSumSq += (double)lap * (double)lap;
-        lapCount++;
-      }
-    }
-  }
 
-  if (lapCount > 0) {
-    pMetadata->Sharpness = lapSumSq / (double)lapCount;
+  if (src.isFloat) {
+    float mapRange = 4.0f; // Default 4.0x SDR headroom
+    if (frame.hdrMetadata.masteringMaxNits > 80.f) {
+      mapRange = frame.hdrMetadata.masteringMaxNits / 80.0f;
+    }
+    src.mapRange = mapRange;
+  } else if (hasGainMap) {
+    src.mapRange = std::exp2(frame.shaderPayload.targetHeadroom);
+    src.gainMap = pAux->pixels;
+    src.gainMapWidth = pAux->width;
+    src.gainMapHeight = pAux->height;
+    src.gainMapStride = pAux->stride;
+    src.payload = &frame.shaderPayload;
+  }
+  pMetadata->HistMapRange = src.mapRange;
+
+  // [Highway] Histograms + Laplacian sharpness in one pass over the sampled
+  // rows (Laplacian on the stepY x stepY grid)
+  ImageLoaderSimd::FrameStats stats;
+  ImageLoaderSimd::ComputeFrameStats(src, (int)stepY, &stats);
+
+  pMetadata->HistR.assign(stats.histR, stats.histR + 256);
+  pMetadata->HistG.assign(stats.histG, stats.histG + 256);
+  pMetadata->HistB.assign(stats.histB, stats.histB + 256);
+  pMetadata->HistL.assign(stats.histL, stats.histL + 256);
+
+  if (stats.lapCount > 0) {
+    pMetadata->Sharpness = (double)stats.lapSumSq / (double)stats.lapCount;
     pMetadata->HasSharpness = true;
   } else {
     pMetadata->Sharpness = 0.0;
@@ -11637,9 +11252,7 @@ void CImageLoader::ComputeHistogramFromFrame(
   }
 
   {
-    uint64_t total = 0;
-    for (uint32_t v : pMetadata->HistL)
-      total += v;
+    const uint64_t total = stats.pixelCount;
     if (total > 0) {
       double entropy = 0.0;
       const double invTotal = 1.0 / (double)total;
@@ -13401,9 +13014,9 @@ HRESULT CImageLoader::LoadToFrame(
 
       if (resizedPixels) {
         // Perform Resize
-        ImageLoaderSimd::ResizeBilinear(res.pixels, res.width, res.height,
-                                        res.stride, resizedPixels, finalW,
-                                        finalH, finalStride);
+        ImageLoaderSimd::Resize(res.pixels, res.width, res.height,
+                                res.stride, resizedPixels, finalW,
+                                finalH, finalStride, ImageLoaderSimd::ResampleFilter::Mitchell);
 
         // Free the original huge buffer
         if (arena && arena->Owns(res.pixels)) {
@@ -14026,8 +13639,8 @@ HRESULT CImageLoader::LoadToFrame(
         }
       }
     } else {
-      ImageLoaderSimd::ResizeBilinear(wicData, wicWidth, wicHeight, wicStride,
-                                      pixels, finalW, finalH, outStride);
+      ImageLoaderSimd::Resize(wicData, wicWidth, wicHeight, wicStride,
+                              pixels, finalW, finalH, outStride, ImageLoaderSimd::ResampleFilter::Mitchell);
     }
   } else {
     // Copy row by row (handles stride mismatch)
@@ -14510,7 +14123,7 @@ DecodeTransferToLinear(float value, QuickView::TransferFunction tf) {
 
 // ============================================================================
 
-void CImageLoader::PopulateFormatDetails(struct ImageMetadata *meta,
+void CImageLoader::PopulateFormatDetails(ImageMetadata *meta,
                                          const wchar_t *formatName,
                                          int bitDepth, bool isLossless,
                                          bool hasAlpha, bool isAnim) {
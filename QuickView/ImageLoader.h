@@ -1,4 +1,5 @@
 #pragma once
+#include "CodecTypes.h"        // Codec::DecodeContext / DecodeResult, ImageMetadata
 #include "ImageTypes.h"        // [Direct D2D] RawImageFrame
 #include "TileMemoryManager.h" // [Titan]
 #include "TileTypes.h"         // [Titan] RegionRect
@@ -13,10 +14,7 @@
 #include <type_traits>
 
 namespace QuickView {
-namespace Codec {
-struct DecodeContext;
-struct DecodeResult;
-} // namespace Codec
+class JpegEntryIndex;
 } // namespace QuickView
 
 /// <summary>
@@ -36,121 +34,14 @@ public:
   // [v4.0] Infrastructure: Atomic Cancellation Predicate
   using CancelPredicate = QuickView::SimplePredicate;
 
-  // --- Metadata Structure ---
-  struct ImageMetadata {
-    std::wstring Make;
-    std::wstring Model;
-    std::wstring Lens;
-    std::wstring ISO;             // e.g. "ISO 100"
-    std::wstring Aperture;        // e.g. "f/2.8"
-    std::wstring Shutter;         // e.g. "1/500s"
-    std::wstring Focal;           // e.g. "50mm"
-    std::wstring Focal35mm;       // e.g. "75mm" (35mm equivalent)
-    std::wstring ExposureBias;    // e.g. "+0.3 EV"
-    std::wstring Flash;           // New: Flash status
-    std::wstring WhiteBalance;    // [v5.5] Auto/Manual
-    std::wstring MeteringMode;    // [v5.5] Pattern/Spot/etc.
-    std::wstring ExposureProgram; // [v5.5] Aperture Priority/Manual/etc.
-    std::wstring Date;            // EXIF Date or File Date fallback
-    std::wstring Software;        // New: Software/Firmware
-
-    UINT Width = 0;
-    UINT Height = 0;
-    double DpiX = 96.0;         // [v10.5] Embedded Physical Resolution
-    double DpiY = 96.0;
-    bool hasAlpha = true;       // [Titan Perf] Alpha mode for Zero-Blend
-    UINT64 FileSize = 0;
-    std::wstring Format;        // e.g. "JPEG", "RAW (ARW)"
-    std::wstring FormatDetails; // e.g. "4:2:0", "10-bit", "Lossy"
-    std::wstring ColorSpace;    // e.g. "sRGB", "Display P3", "Adobe RGB"
-    std::wstring SourcePath;    // New: Original file path
-
-    // [v5.3] EXIF Orientation (1-8, 1=Normal)
-    int ExifOrientation = 1;
-
-    // Decoder Info
-    std::wstring LoaderName; // e.g. "TurboJPEG", "libavif"
-    DWORD LoadTimeMs = 0;    // Load time in milliseconds
-
-    // [Phase 18] Embedded Profile Flag
-    std::optional<bool> HasEmbeddedColorProfile;
-
-    // GPS
-    bool HasGPS = false;
-    double Latitude = 0.0;
-    double Longitude = 0.0;
-    double Altitude = 0.0; // New: Altitude
-
-    // [v5.3] Split Strategy: True if Aux data (EXIF strings) is loaded
-    bool IsFullMetadataLoaded = false;
-
-    // [v5.3] File Timestamps (for Sorting/Details)
-    FILETIME CreationTime = {};
-    FILETIME LastWriteTime = {};
-
-    // True if this image was decoded from a RAW file using the 'Full Decode'
-    // logic
-    bool IsRawFullDecode = false;
-
-    // Histogram (256 bins)
-    std::vector<uint32_t> HistR;
-    std::vector<uint32_t> HistG;
-    std::vector<uint32_t> HistB;
-    std::vector<uint32_t> HistL; // Luminance
-    float HistMapRange = 1.0f;   // Linear SDR multiplier mapped to 255 bin
-
-    // Compare Metrics
-    double Sharpness = 0.0; // Laplacian variance
-    double Entropy = 0.0;   // Shannon entropy
-    bool HasSharpness = false;
-    bool HasEntropy = false;
-
-    // [CMS] Unified pixel workspace description
-    QuickView::PixelColorInfo colorInfo;
-    std::pmr::vector<uint8_t> iccProfileData; // [CMS] Extracted raw ICC payload
-    QuickView::HdrStaticMetadata hdrMetadata;
-
-    // [v10.0] Measured Peak Statistics (Full Frame SIMD Scan)
-    float MeasuredPeakNits = -1.0f; // -1 = Not measured yet
-
-    bool IsEmpty() const {
-      return Make.empty() && Model.empty() && ISO.empty() && Date.empty();
-    }
-
-    std::wstring GetCompactString() const {
-      std::wstring s;
-      if (!Make.empty())
-        s += Make + L" ";
-      if (!Model.empty())
-        s += Model;
-      if (!Focal.empty())
-        s += (s.empty() ? L"" : L"  ") + Focal;
-      if (!ISO.empty())
-        s += (s.empty() ? L"" : L"  ") + (L"ISO " + ISO);
-      if (!Aperture.empty())
-        s += L"  " + Aperture;
-      if (!Shutter.empty())
-        s += L"  " + Shutter;
-      if (!ExposureBias.empty())
-        s += L"  " + ExposureBias;
-      return s;
-    }
-
-    // [v10.4] Universal Predicate: Returns true if the HRESULT indicates a missing UI/Codec plugin.
-    static bool IsWicCodecMissing(HRESULT hr) {
-      // 0x88982F50: WINCODEC_ERR_COMPONENTNOTFOUND (Common on Win10/11)
-      // 0x80040154: REGDB_E_CLASSNOTREG (Common when stub is present but no impl)
-      // 0x88982F03: WINCODEC_ERR_CODECNOTHANDLED (Fallback)
-      // 0xC00D5212: MF_E_TOPO_CODEC_NOT_FOUND (Crucial for Win10 HEVC missing)
-      return (hr == (HRESULT)0x88982F50) || (hr == (HRESULT)0x80040154) || (hr == (HRESULT)0x88982F03) || (hr == (HRESULT)0xC00D5212);
-    }
-  };
+  // --- Metadata Structure (shared with the codecs, see CodecTypes.h) ---
+  using ImageMetadata = QuickView::ImageMetadata;
 
   // [v6.2] Static Helpers (Defined here to see ImageMetadata)
   static std::wstring ParseICCProfileName(const uint8_t *data, size_t size);
 
   // [v6.3] Helper to populate FormatDetails string
-  static void PopulateFormatDetails(struct ImageMetadata *meta,
+  static void PopulateFormatDetails(ImageMetadata *meta,
                                     const wchar_t *formatName, int bitDepth,
                                     bool isLossless, bool hasAlpha,
                                     bool isAnim);
@@ -273,12 +164,15 @@ public:
 
   // [Infinity Engine] Zero-Copy Tile Loader
   // Decodes a region directly from a memory pointer (MMF) into a slab.
+  // entryIndex (built for this exact buffer) lets the decode start at the
+  // nearest MCU row instead of the top of the scan.
   static HRESULT LoadTileFromMemory(
       const uint8_t *sourceData, size_t sourceSize,
       QuickView::RegionRect region, float scale,
       QuickView::RawImageFrame *outFrame,
       QuickView::TileMemoryManager *tileManager, int targetWidth = 0,
-      int targetHeight = 0); // [Fix] Explicit Target Size for padding
+      int targetHeight = 0, // [Fix] Explicit Target Size for padding
+      const QuickView::JpegEntryIndex *entryIndex = nullptr);
 
   // ============================================================================
   // [P15] Format-Agnostic Full Decode from Memory
@@ -521,54 +415,3 @@ private:
   // Custom PCX Decoder
   HRESULT LoadPCX(LPCWSTR filePath, IWICBitmap **ppBitmap);
 };
-
-namespace QuickView {
-namespace Codec {
-
-struct DecodeContext {
-  QuickView::AllocatorCallback allocator;
-  QuickView::FreeCallback freeFunc;
-
-  QuickView::SimplePredicate checkCancel;
-  std::stop_token stopToken;
-
-  int targetWidth = 0;
-  int targetHeight = 0;
-  PixelFormat format = PixelFormat::BGRA8888;
-  bool forcePreview = false;
-  float targetHdrHeadroomStops = -1.0f;
-
-  std::wstring *pLoaderName = nullptr;
-  std::wstring *pFormatDetails = nullptr;
-
-  ::CImageLoader::ImageMetadata *pMetadata = nullptr;
-
-  bool forceRenderFull = false;
-  bool allowFakeBase = true;
-  bool isTitanMode = false;
-  bool preserveFloat = false;
-
-  QuickView::AuxLayerCallback onAuxLayerReady;
-};
-
-struct DecodeResult {
-  uint8_t *pixels = nullptr;
-  int width = 0;
-  int height = 0;
-  int stride = 0;
-  PixelFormat format = PixelFormat::BGRA8888;
-  bool success = false;
-
-  ::CImageLoader::ImageMetadata metadata;
-
-  GpuBlendOp blendOp = GpuBlendOp::None;
-  std::unique_ptr<AuxLayer> auxLayer;
-  GpuShaderPayload shaderPayload;
-
-  std::shared_ptr<QuickView::IAnimationDecoder> animator;
-  QuickView::AnimationFrameMeta frameMeta;
-};
-
-} // namespace Codec
-} // namespace QuickView
-
@@ -34,14 +34,18 @@ struct __clangd_preamble_stop_struct {};
 #undef HWY_TARGET_INCLUDE
 #define HWY_TARGET_INCLUDE "ImageLoaderSimd.cpp"
 #include <hwy/foreach_target.h>
-#include "ImageTypes.h" // For GpuShaderPayload
+#include "ImageTypes.h" // For GpuShaderPayload, ToneMapSettings, PixelFormat
 #include <hwy/highway.h>
 #include <hwy/cache_control.h>
 
 #include "ImageLoaderSimd.h"
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <DirectXPackedVector.h>
 
 // Locally enable peak optimization and Fast Math
@@ -69,6 +73,451 @@ static inline uint8_t LinearToSdr8Scalar(float v) {
     v = (v < 0.0f) ? 0.0f : (v > 1.0f ? 1.0f : v);
     return static_cast<uint8_t>(v * 255.0f + 0.5f);
 }
+
+// TIFF Predictor=2: running sum per channel along the row (wrapping arithmetic).
+// Also the tail loop of the vectorized kernel, continuing from byte/lane `start`.
+static inline void UndoHorizontalPredictorScalar(uint8_t* row, size_t start, size_t count,
+                                                 int samples, int bytesPerSample, bool bigEndian) {
+    const size_t s = static_cast<size_t>(samples);
+    if (bytesPerSample == 1) {
+        for (size_t i = (std::max)(start, s); i < count; ++i) {
+            row[i] = static_cast<uint8_t>(row[i] + row[i - s]);
+        }
+        return;
+    }
+    // 16-bit: `count` is in samples; byte order follows the file
+    for (size_t i = (std::max)(start, s); i < count; ++i) {
+        uint8_t* cur = row + i * 2;
+        const uint8_t* prev = row + (i - s) * 2;
+        if (bigEndian) {
+            uint16_t v = static_cast<uint16_t>(((cur[0] << 8) | cur[1]) + ((prev[0] << 8) | prev[1]));
+            cur[0] = static_cast<uint8_t>(v >> 8);
+            cur[1] = static_cast<uint8_t>(v);
+        } else {
+            uint16_t v = static_cast<uint16_t>((cur[0] | (cur[1] << 8)) + (prev[0] | (prev[1] << 8)));
+            cur[0] = static_cast<uint8_t>(v);
+            cur[1] = static_cast<uint8_t>(v >> 8);
+        }
+    }
+}
+
+// Separable resampling: per-axis tap tables shared by every target.
+// Output i reads `taps` consecutive source pixels from start[i] (always in
+// bounds; taps outside the filter window weigh 0). Weights are 2.14 fixed point
+// and sum to exactly 1 << 14, so flat areas come through unchanged.
+constexpr int kResampleBits = 14;
+
+struct ResampleAxis {
+    int taps = 0;
+    std::vector<int> start;
+    std::vector<int16_t> weights; // dstSize * taps
+};
+
+static inline double ResampleSupport(ImageLoaderSimd::ResampleFilter filter) {
+    switch (filter) {
+        case ImageLoaderSimd::ResampleFilter::Mitchell: return 2.0;
+        case ImageLoaderSimd::ResampleFilter::Lanczos3: return 3.0;
+        default: return 0.5;
+    }
+}
+
+static inline double ResampleKernel(ImageLoaderSimd::ResampleFilter filter, double x) {
+    x = std::fabs(x);
+    if (filter == ImageLoaderSimd::ResampleFilter::Mitchell) {
+        constexpr double B = 1.0 / 3.0, C = 1.0 / 3.0;
+        if (x < 1.0) return ((12 - 9 * B - 6 * C) * x * x * x + (-18 + 12 * B + 6 * C) * x * x + (6 - 2 * B)) / 6.0;
+        if (x < 2.0) return ((-B - 6 * C) * x * x * x + (6 * B + 30 * C) * x * x + (-12 * B - 48 * C) * x + (8 * B + 24 * C)) / 6.0;
+        return 0.0;
+    }
+    // Lanczos3
+    if (x < 1e-9) return 1.0;
+    if (x >= 3.0) return 0.0;
+    const double px = 3.14159265358979323846 * x;
+    return 3.0 * std::sin(px) * std::sin(px / 3.0) / (px * px);
+}
+
+// The filter is stretched by the downscale factor (never narrower than one
+// source pixel), which is what makes 10-50x reductions alias-free. Box weighs
+// each source pixel by its exact overlap with the output pixel's footprint.
+// Outputs span [srcOrigin, srcOrigin + srcExtent) of the source, which may start
+// mid-pixel; taps still reach past that window into the rest of the source.
+static void BuildResampleAxis(int srcSize, int dstSize, ImageLoaderSimd::ResampleFilter filter,
+                              ResampleAxis& out, double srcOrigin, double srcExtent) {
+    const double scale = srcExtent / dstSize;
+    const double filterScale = (std::max)(scale, 1.0);
+    const double support = ResampleSupport(filter) * filterScale;
+    const bool box = filter == ImageLoaderSimd::ResampleFilter::Box;
+
+    // Pass 1: float weights over each window, trimmed to the non-zero span
+    std::vector<int> lo(dstSize);
+    std::vector<int> span(dstSize);
+    const int window = (std::min)(srcSize, static_cast<int>(std::ceil(2.0 * support)) + 1);
+    std::vector<double> w(static_cast<size_t>(dstSize) * window, 0.0);
+    int taps = 1;
+    for (int i = 0; i < dstSize; ++i) {
+        const double center = srcOrigin + (i + 0.5) * scale;
+        const int x0 = (std::max)(0, static_cast<int>(std::floor(center - support)));
+        const int x1 = (std::min)(srcSize, (std::min)(x0 + window, static_cast<int>(std::ceil(center + support))));
+        double* wi = w.data() + static_cast<size_t>(i) * window;
+        int first = -1, last = -1;
+        double sum = 0.0;
+        for (int x = x0; x < x1; ++x) {
+            const double v = box
+                ? (std::max)(0.0, (std::min)(x + 1.0, center + support) - (std::max)(static_cast<double>(x), center - support))
+                : ResampleKernel(filter, (x + 0.5 - center) / filterScale);
+            if (v == 0.0) continue;
+            if (first < 0) first = x;
+            last = x;
+            wi[x - x0] = v;
+            sum += v;
+        }
+        if (first < 0 || sum <= 0.0) { // Degenerate window: nearest source pixel
+            first = last = std::clamp(static_cast<int>(center), 0, srcSize - 1);
+            std::fill(wi, wi + window, 0.0);
+            wi[0] = 1.0;
+            sum = 1.0;
+        } else {
+            std::copy(wi + (first - x0), wi + (last - x0) + 1, wi); // Left-align the span
+            std::fill(wi + (last - first) + 1, wi + window, 0.0);
+            for (int k = 0; k <= last - first; ++k) wi[k] /= sum;
+        }
+        lo[i] = first;
+        span[i] = last - first + 1;
+        taps = (std::max)(taps, span[i]);
+    }
+
+    // Pass 2: quantize; rounding residue goes to the largest tap
+    out.taps = taps;
+    out.start.resize(dstSize);
+    out.weights.assign(static_cast<size_t>(dstSize) * taps, 0);
+    for (int i = 0; i < dstSize; ++i) {
+        const double* wi = w.data() + static_cast<size_t>(i) * window;
+        const int start = (std::min)(lo[i], srcSize - taps);
+        int16_t* q = out.weights.data() + static_cast<size_t>(i) * taps + (lo[i] - start);
+        int total = 0, peak = 0;
+        for (int k = 0; k < span[i]; ++k) {
+            q[k] = static_cast<int16_t>(std::lround(wi[k] * (1 << kResampleBits)));
+            total += q[k];
+            if (q[k] > q[peak]) peak = k;
+        }
+        q[peak] = static_cast<int16_t>(q[peak] + ((1 << kResampleBits) - total));
+        out.start[i] = start;
+    }
+}
+
+static inline uint8_t ResampleNarrow(int32_t acc) {
+    acc >>= kResampleBits; // Rounding bias is folded into the accumulator's start value
+    return static_cast<uint8_t>(acc < 0 ? 0 : (acc > 255 ? 255 : acc));
+}
+
+// Horizontal pass over one BGRA row, output pixels [x0, dstW)
+static inline void ResampleRowHScalar(const uint8_t* src, uint8_t* dst, int x0, int dstW,
+                                      const int* starts, const int16_t* weights, int taps) {
+    for (int x = x0; x < dstW; ++x) {
+        const uint8_t* s = src + static_cast<size_t>(starts[x]) * 4;
+        const int16_t* w = weights + static_cast<size_t>(x) * taps;
+        int32_t acc[4] = { 1 << (kResampleBits - 1), 1 << (kResampleBits - 1),
+                           1 << (kResampleBits - 1), 1 << (kResampleBits - 1) };
+        for (int k = 0; k < taps; ++k) {
+            for (int c = 0; c < 4; ++c) acc[c] += s[k * 4 + c] * w[k];
+        }
+        for (int c = 0; c < 4; ++c) dst[static_cast<size_t>(x) * 4 + c] = ResampleNarrow(acc[c]);
+    }
+}
+
+// Vertical pass: bytes [i0, count) of one output row from `taps` rows `rowStride` apart
+static inline void ResampleRowVScalar(const uint8_t* rows, size_t rowStride, const int16_t* weights,
+                                      int taps, uint8_t* dst, size_t i0, size_t count) {
+    for (size_t i = i0; i < count; ++i) {
+        int32_t acc = 1 << (kResampleBits - 1);
+        for (int k = 0; k < taps; ++k) acc += rows[k * rowStride + i] * weights[k];
+        dst[i] = ResampleNarrow(acc);
+    }
+}
+
+// 2x2 box average for output pixels [x0, ceil(srcW/2)) of one row pair; a missing
+// last column repeats the one before it. Rounds half up, like the SIMD path.
+static inline void Downsample2xRowScalar(const uint8_t* row0, const uint8_t* row1, uint8_t* dst,
+                                         int x0, int srcW) {
+    const int dstW = (srcW + 1) / 2;
+    for (int x = x0; x < dstW; ++x) {
+        const size_t a = static_cast<size_t>(x) * 8;
+        const size_t b = static_cast<size_t>((std::min)(x * 2 + 1, srcW - 1)) * 4;
+        for (int c = 0; c < 4; ++c) {
+            dst[static_cast<size_t>(x) * 4 + c] =
+                static_cast<uint8_t>((row0[a + c] + row0[b + c] + row1[a + c] + row1[b + c] + 2) >> 2);
+        }
+    }
+}
+
+// Info-panel statistics (ComputeFrameStats). Histograms are kept in kStatsBanks
+// sub-histograms (B, G, R, L bins each) that pixel x feeds by x % kStatsBanks and
+// are merged at the end. Histogram luma is (R*299 + G*587 + B*114 + 500) / 1000;
+// the sharpness Laplacian runs on the cheaper (54R + 183G + 19B) >> 8.
+constexpr int kStatsBanks = 4;
+constexpr size_t kStatsBankSize = 4 * 256;
+
+static inline void FrameStatsRowBgra8Scalar(const uint8_t* row, size_t x0, size_t width,
+                                            uint32_t* banks, uint8_t* lapLuma) {
+    for (size_t x = x0; x < width; ++x) {
+        const uint32_t b = row[x * 4 + 0];
+        const uint32_t g = row[x * 4 + 1];
+        const uint32_t r = row[x * 4 + 2];
+        uint32_t* h = banks + (x % kStatsBanks) * kStatsBankSize;
+        h[b]++;
+        h[256 + g]++;
+        h[512 + r]++;
+        h[768 + (r * 299 + g * 587 + b * 114 + 500) / 1000]++;
+        if (lapLuma) lapLuma[x] = static_cast<uint8_t>((54 * r + 183 * g + 19 * b) >> 8);
+    }
+}
+
+// Sum of squared 4-neighbour Laplacians for middle-row points [max(j0, 1), count - 1)
+static inline uint64_t LaplacianRowScalar(const uint8_t* up, const uint8_t* mid, const uint8_t* down,
+                                          size_t j0, size_t count) {
+    uint64_t sum = 0;
+    for (size_t j = (std::max)(j0, static_cast<size_t>(1)); j + 1 < count; ++j) {
+        const int lap = up[j] + down[j] + mid[j - 1] + mid[j + 1] - 4 * mid[j];
+        sum += static_cast<uint64_t>(lap * lap);
+    }
+    return sum;
+}
+
+// Codec conversions to BGRA8 (MiniTiff, PSD composite). CMYK divides by 255 with
+// rounding as (u + (u >> 8)) >> 8, u = t + 128, which is exact for every product of
+// two bytes; PSD 16-bit samples are big-endian in Photoshop's 0..32768 range and
+// map to (min(v, 32768) * 255 + 16384) >> 15.
+static inline uint8_t Div255Round(uint32_t t) {
+    const uint32_t u = t + 128;
+    return static_cast<uint8_t>((u + (u >> 8)) >> 8);
+}
+
+static inline uint8_t PsdSample16To8(const uint8_t* p) {
+    const uint32_t v = (std::min)((static_cast<uint32_t>(p[0]) << 8) | p[1], 32768u);
+    return static_cast<uint8_t>((v * 255 + 16384) >> 15);
+}
+
+static inline void CmykToBgraScalar(const uint8_t* src, int samples, uint8_t* dst, size_t x0, size_t width) {
+    for (size_t x = x0; x < width; ++x) {
+        const uint8_t* p = src + x * samples;
+        const uint32_t invK = 255u - p[3];
+        dst[x * 4 + 0] = Div255Round((255u - p[2]) * invK);
+        dst[x * 4 + 1] = Div255Round((255u - p[1]) * invK);
+        dst[x * 4 + 2] = Div255Round((255u - p[0]) * invK);
+        dst[x * 4 + 3] = 255;
+    }
+}
+
+static inline void GrayToBgraScalar(const uint8_t* src, int samples, uint8_t* dst, size_t x0, size_t width,
+                                    bool invert) {
+    for (size_t x = x0; x < width; ++x) {
+        const uint8_t* p = src + x * samples;
+        const uint8_t v = invert ? static_cast<uint8_t>(255 - p[0]) : p[0];
+        dst[x * 4 + 0] = v;
+        dst[x * 4 + 1] = v;
+        dst[x * 4 + 2] = v;
+        dst[x * 4 + 3] = samples > 1 ? p[1] : 255;
+    }
+}
+
+static inline void PlanarToBgraScalar(const uint8_t* const* planes, int bytesPerSample, uint8_t* dst,
+                                      size_t x0, size_t width) {
+    for (size_t x = x0; x < width; ++x) {
+        for (int c = 0; c < 4; ++c) {
+            const uint8_t* p = planes[c];
+            uint8_t v = 255;
+            if (p) v = bytesPerSample == 2 ? PsdSample16To8(p + x * 2) : p[x];
+            dst[x * 4 + (c == 3 ? 3 : 2 - c)] = v;
+        }
+    }
+}
+
+// ComputeEngine tone-mapping pipeline (CSToneMap / CSToneMapHDR / CSComposeGainMap).
+// Everything that depends only on the constant buffer is folded once per call
+// into these uniforms; the per-pixel math follows the HLSL in ComputeEngine.cpp.
+struct ToneMapUniforms {
+    QuickView::PixelFormat srcFormat;
+    bool hdrOutput;
+    uint32_t transfer;      // TransferFunction: 1 sRGB, 3 PQ, 4 HLG, others linear
+    float scale;            // Exposure * ExposureGain
+    bool toneMap;           // ToneMapSDR / ToneMapHDR can change the pixel
+    uint32_t mode;          // 0 spline, 1 clip, 2 BT.2390 EETF
+    float srcPivot, dstPivot, pa, pb, qa, qb, qc;
+    float splineMaxX;       // PQ(ContentPeak) - SrcPivot
+    float splinePeakPq;     // PQ(DisplayPeakScRgb)
+    bool contrast;
+    float contrastRecovery;
+    float invSceneAvgPq;    // 1 / max(SceneAvgPQ, 1e-6)
+    float invMappedAvgPq;   // 1 / max(MappedAvgPQ, 1e-6)
+    float contrastPeakPq;   // PQ(max(DisplayPeakScRgb, 1))
+    bool eetf;              // Mode 2 and PQ(ContentPeak) > PQ(displayPeak)
+    float ks, dstMaxPq, eetfInvSpan, eetfC;
+    bool desat;
+    float desatThreshold, invDesatThreshold, desatStrength;
+    float matrix[9];        // ColorMatrix 3x3, SDR output's / displayPeak folded in
+    float gamutY[3];        // Rec.709 Y (SDR shader) or BT.2020 Y (HDR shader)
+    float gamutPeak;
+};
+
+static inline float LinearToPqScalar(float l) {
+    const float p = std::pow((std::max)(l, 0.0f) / 125.0f, 2610.0f / 16384.0f);
+    return std::pow((0.8359375f + 18.8515625f * p) / (1.0f + 18.6875f * p), 78.84375f);
+}
+
+static inline float PqToLinearScalar(float v) {
+    const float p = std::pow((std::max)(v, 0.0f), 1.0f / 78.84375f);
+    return std::pow((std::max)(p - 0.8359375f, 0.0f) / (18.8515625f - 18.6875f * p), 16384.0f / 2610.0f) * 125.0f;
+}
+
+static inline float SrgbToLinearScalar(float c) {
+    return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+static inline float Bt2020Luma(const float* c) {
+    return 0.2627f * c[0] + 0.6780f * c[1] + 0.0593f * c[2];
+}
+
+// Source pixel x of one row as float RGBA (R32G32B32A32_FLOAT / R16G16B16A16_FLOAT / _UNORM)
+static inline void LoadRgbaScalar(const uint8_t* row, size_t x, QuickView::PixelFormat format, float* px) {
+    if (format == QuickView::PixelFormat::R32G32B32A32_FLOAT) {
+        std::memcpy(px, row + x * 16, 16);
+        return;
+    }
+    const uint16_t* p = reinterpret_cast<const uint16_t*>(row) + x * 4;
+    for (int c = 0; c < 4; ++c) {
+        px[c] = format == QuickView::PixelFormat::R16G16B16A16_FLOAT
+                    ? DirectX::PackedVector::XMConvertHalfToFloat(p[c])
+                    : p[c] * (1.0f / 65535.0f);
+    }
+}
+
+// CSToneMap / CSToneMapHDR for one pixel, rgb in place: decode, exposure, tone curve,
+// color matrix and hue-preserving gamut map (the output encoding is left to the caller)
+static inline void ToneMapPixelScalar(float* c, const ToneMapUniforms& u) {
+    for (int i = 0; i < 3; ++i) c[i] = (std::max)(c[i], 0.0f);
+    if (u.transfer == 3) {
+        for (int i = 0; i < 3; ++i) c[i] = PqToLinearScalar(c[i]);
+    } else if (u.transfer == 4) {
+        for (int i = 0; i < 3; ++i) {
+            c[i] = c[i] >= 0.5f ? (std::exp((c[i] - 0.55991073f) / 0.17883277f) + 0.28466892f) / 12.0f
+                                : c[i] * c[i] / 3.0f;
+        }
+        const float gain = std::pow((std::max)(Bt2020Luma(c), 0.0f), 0.2f) * 12.5f;
+        for (int i = 0; i < 3; ++i) c[i] *= gain;
+    } else if (u.transfer == 1) {
+        for (int i = 0; i < 3; ++i) c[i] = SrgbToLinearScalar(c[i]);
+    }
+    for (int i = 0; i < 3; ++i) c[i] *= u.scale;
+
+    const float l = Bt2020Luma(c);
+    if (u.toneMap && l > 1e-6f) {
+        float target = l;
+        if (u.mode == 0) {
+            const float lPq = LinearToPqScalar(l);
+            const float x = lPq - u.srcPivot;
+            float targetPq;
+            if (x > 0.0f) {
+                const float xh = (std::min)(x, u.splineMaxX);
+                targetPq = ((u.qa * xh + u.qb) * xh + u.qc) * xh + u.dstPivot;
+            } else {
+                const float xl = (std::max)(x, -u.srcPivot);
+                targetPq = (u.pa * xl + u.pb) * xl + u.dstPivot;
+            }
+            target = PqToLinearScalar((std::min)((std::max)(targetPq, 0.0f), u.splinePeakPq));
+            if (u.contrast) {
+                const float mappedPq = LinearToPqScalar(target);
+                const float ratioPq = (lPq * u.invSceneAvgPq) / (std::max)(mappedPq * u.invMappedAvgPq, 1e-6f);
+                const float factor = std::pow((std::max)(ratioPq, 1e-6f), u.contrastRecovery);
+                target = PqToLinearScalar((std::min)((std::max)(mappedPq * factor, 0.0f), u.contrastPeakPq));
+            }
+        } else if (u.eetf) {
+            const float lPq = LinearToPqScalar(l);
+            if (lPq > u.ks) {
+                const float t = (std::min)((std::max)((lPq - u.ks) * u.eetfInvSpan, 0.0f), 1.0f);
+                const float h = (((u.eetfC - 2.0f) * t + (3.0f - 2.0f * u.eetfC)) * t + u.eetfC) * t;
+                target = PqToLinearScalar((std::min)((std::max)(u.ks + (u.dstMaxPq - u.ks) * h, 0.0f), u.dstMaxPq));
+            }
+        }
+        const float ratio = target / l;
+        for (int i = 0; i < 3; ++i) c[i] *= ratio;
+        if (u.desat && ratio < u.desatThreshold) {
+            const float d = std::pow((u.desatThreshold - ratio) * u.invDesatThreshold, 1.5f) * u.desatStrength;
+            const float m = Bt2020Luma(c);
+            for (int i = 0; i < 3; ++i) c[i] += (m - c[i]) * d;
+        }
+    }
+
+    const float r = c[0], g = c[1], b = c[2];
+    for (int i = 0; i < 3; ++i) c[i] = u.matrix[i * 3] * r + u.matrix[i * 3 + 1] * g + u.matrix[i * 3 + 2] * b;
+
+    const float y = u.gamutY[0] * c[0] + u.gamutY[1] * c[1] + u.gamutY[2] * c[2];
+    const float maxC = (std::max)({ c[0], c[1], c[2] });
+    const float minC = (std::min)({ c[0], c[1], c[2] });
+    if (maxC <= 0.0f) {
+        c[0] = c[1] = c[2] = 0.0f;
+        return;
+    }
+    float k = 1.0f;
+    if (maxC > u.gamutPeak && maxC > y) k = (std::min)(k, (u.gamutPeak - y) / (maxC - y));
+    if (minC < 0.0f && y > minC) k = (std::min)(k, y / (y - minC));
+    for (int i = 0; i < 3; ++i) c[i] = y + k * (c[i] - y);
+}
+
+// Pixels [x0, width) of one row: BGRA8 sRGB (straight alpha) or RGBA FP16 out
+static inline void ToneMapRowScalar(const uint8_t* src, uint8_t* dst, size_t x0, size_t width,
+                                    const ToneMapUniforms& u) {
+    for (size_t x = x0; x < width; ++x) {
+        float px[4];
+        LoadRgbaScalar(src, x, u.srcFormat, px);
+        ToneMapPixelScalar(px, u);
+        if (u.hdrOutput) {
+            uint16_t* out = reinterpret_cast<uint16_t*>(dst) + x * 4;
+            for (int c = 0; c < 4; ++c) out[c] = DirectX::PackedVector::XMConvertFloatToHalf(px[c]);
+        } else {
+            uint8_t* out = dst + x * 4;
+            out[0] = LinearToSdr8Scalar(px[2]);
+            out[1] = LinearToSdr8Scalar(px[1]);
+            out[2] = LinearToSdr8Scalar(px[0]);
+            out[3] = static_cast<uint8_t>((std::min)((std::max)(px[3], 0.0f), 1.0f) * 255.0f + 0.5f);
+        }
+    }
+}
+
+// CSComposeGainMap. Per output row the two gain-map rows are blended into gainLine
+// (0..1); x0 / x1 / fx are the per-column horizontal taps of the bilinear filter.
+struct GainMapUniforms {
+    bool floatBase;         // Linear RGBA32F base (BaseIsLinear), else sRGB BGRA8
+    const float* srgbLut;   // SrgbToLinear(i / 255), 8-bit bases
+    bool sharedGain;        // One gain curve for all channels (single-channel metadata)
+    float invGamma[3];      // 1 / max(Gamma, 0.001)
+    float gainMin[3];
+    float gainSpan[3];      // GainMapMax - GainMapMin
+    float weight;           // Headroom weight, already flipped for HDR bases
+    float offsetSdr[3];
+    float offsetHdr[3];
+};
+
+static inline void ComposeGainMapRowScalar(const uint8_t* sdr, const float* gainLine, const int32_t* x0s,
+                                           const int32_t* x1s, const float* fx, uint16_t* dst,
+                                           size_t x0, size_t width, const GainMapUniforms& u) {
+    for (size_t x = x0; x < width; ++x) {
+        float base[3];
+        if (u.floatBase) {
+            std::memcpy(base, sdr + x * 16, 12);
+        } else {
+            for (int c = 0; c < 3; ++c) base[c] = u.srgbLut[sdr[x * 4 + 2 - c]];
+        }
+        const float g0 = gainLine[x0s[x]];
+        const float gain = g0 + (gainLine[x1s[x]] - g0) * fx[x];
+        uint16_t* out = dst + x * 4;
+        for (int c = 0; c < 3; ++c) {
+            const float gainLog = u.gainMin[c] + u.gainSpan[c] * std::pow(gain, u.invGamma[c]);
+            const float hdr = (base[c] + u.offsetSdr[c]) * std::exp2(gainLog * u.weight) - u.offsetHdr[c];
+            out[c] = DirectX::PackedVector::XMConvertFloatToHalf((std::max)(hdr, 0.0f));
+        }
+        out[3] = DirectX::PackedVector::XMConvertFloatToHalf(1.0f);
+    }
+}
 #endif // IMAGE_LOADER_SIMD_SCALARS
 
 HWY_BEFORE_NAMESPACE();
@@ -1443,6 +1892,204 @@ void ResizeBilinearImpl(const uint8_t* src, int srcW, int srcH, int srcStride,
     }
 }
 
+// ============================================================================
+// Resize - separable passes over ResampleAxis tables (see BuildResampleAxis)
+// Horizontal: one BGRA pixel per 128-bit vector. Each pair of taps is widened
+// to [b0 b1 g0 g1 r0 r1 a0 a1] and folded in with one pairwise multiply-add.
+// Vertical: plain lanes along the row, one int32 multiply-add per tap.
+// ============================================================================
+void ResampleHorizontalImpl(const uint8_t* HWY_RESTRICT src, uint8_t* HWY_RESTRICT dst, int dstW,
+                            const int* starts, const int16_t* weights, int taps) {
+    int x = 0;
+#if HWY_TARGET != HWY_SCALAR
+    const hn::Full128<int16_t> d16;
+    const hn::Full128<int32_t> d32;
+    const hn::Full64<uint8_t> d8x8;
+    const hn::Full32<uint8_t> d8x4;
+    const auto bias = hn::Set(d32, 1 << (kResampleBits - 1));
+    for (; x < dstW; ++x) {
+        const uint8_t* s = src + static_cast<size_t>(starts[x]) * 4;
+        const int16_t* w = weights + static_cast<size_t>(x) * taps;
+        auto acc = bias;
+        int k = 0;
+        for (; k + 2 <= taps; k += 2) {
+            const auto px = hn::PromoteTo(d16, hn::LoadU(d8x8, s + k * 4));
+            const auto pairs = hn::InterleaveLower(d16, px, hn::ShiftRightLanes<4>(d16, px));
+            const uint32_t wPair = (static_cast<uint32_t>(static_cast<uint16_t>(w[k + 1])) << 16) |
+                                   static_cast<uint16_t>(w[k]);
+            acc = hn::Add(acc, hn::WidenMulPairwiseAdd(d32, pairs,
+                                                       hn::BitCast(d16, hn::Set(d32, static_cast<int32_t>(wPair)))));
+        }
+        if (k < taps) {
+            const auto px = hn::PromoteTo(d32, hn::LoadU(d8x4, s + k * 4));
+            acc = hn::Add(acc, hn::Mul(px, hn::Set(d32, static_cast<int32_t>(w[k]))));
+        }
+        hn::StoreU(hn::DemoteTo(d8x4, hn::ShiftRight<kResampleBits>(acc)), d8x4, dst + static_cast<size_t>(x) * 4);
+    }
+#endif
+    ResampleRowHScalar(src, dst, x, dstW, starts, weights, taps);
+}
+
+void ResampleVerticalImpl(const uint8_t* HWY_RESTRICT rows, size_t rowStride, const int16_t* weights,
+                          int taps, uint8_t* HWY_RESTRICT dst, size_t count) {
+    size_t i = 0;
+#if HWY_TARGET != HWY_SCALAR
+    const hn::ScalableTag<int32_t> d32;
+    const hn::Rebind<uint8_t, decltype(d32)> d8;
+    const size_t N = hn::Lanes(d32);
+    const auto bias = hn::Set(d32, 1 << (kResampleBits - 1));
+    for (; i + N <= count; i += N) {
+        auto acc = bias;
+        for (int k = 0; k < taps; ++k) {
+            if (weights[k] == 0) continue; // Padding taps at the window edges
+            const auto px = hn::PromoteTo(d32, hn::LoadU(d8, rows + k * rowStride + i));
+            acc = hn::Add(acc, hn::Mul(px, hn::Set(d32, static_cast<int32_t>(weights[k]))));
+        }
+        hn::StoreU(hn::DemoteTo(d8, hn::ShiftRight<kResampleBits>(acc)), d8, dst + i);
+    }
+#endif
+    ResampleRowVScalar(rows, rowStride, weights, taps, dst, i, count);
+}
+
+// ============================================================================
+// Downsample2x - one mip level, 2x2 box
+// Rows are summed vertically in u16, then each pixel's four u16 channels are
+// treated as one u64 lane so even + odd pixels pair up with ConcatEven/Odd
+// (channel sums stay below 1024, so no carry crosses a channel).
+// ============================================================================
+void Downsample2xRowImpl(const uint8_t* HWY_RESTRICT row0, const uint8_t* HWY_RESTRICT row1,
+                         uint8_t* HWY_RESTRICT dst, int srcW) {
+    int x = 0;
+#if HWY_TARGET != HWY_SCALAR
+    const hn::ScalableTag<uint8_t> d8;
+    const hn::Half<decltype(d8)> dh8;
+    const hn::Repartition<uint16_t, decltype(d8)> d16;
+    const hn::Repartition<uint64_t, decltype(d8)> d64;
+    const size_t N = hn::Lanes(d8);
+    const int step = static_cast<int>(N / 4); // Output pixels per iteration (two vectors in per row)
+    const int pairs = srcW / 2;               // Output pixels with both source columns present
+    const auto bias = hn::Set(d16, 2);
+
+    auto pairSum = [&](hn::Vec<decltype(d16)> lo, hn::Vec<decltype(d16)> hi) {
+        const auto l64 = hn::BitCast(d64, lo);
+        const auto h64 = hn::BitCast(d64, hi);
+        const auto sum = hn::Add(hn::ConcatEven(d64, h64, l64), hn::ConcatOdd(d64, h64, l64));
+        return hn::ShiftRight<2>(hn::Add(hn::BitCast(d16, sum), bias));
+    };
+
+    for (; x + step <= pairs; x += step) {
+        const uint8_t* p0 = row0 + static_cast<size_t>(x) * 8;
+        const uint8_t* p1 = row1 + static_cast<size_t>(x) * 8;
+        const auto a0 = hn::LoadU(d8, p0);
+        const auto a1 = hn::LoadU(d8, p0 + N);
+        const auto b0 = hn::LoadU(d8, p1);
+        const auto b1 = hn::LoadU(d8, p1 + N);
+        const auto s0 = hn::Add(hn::PromoteTo(d16, hn::LowerHalf(dh8, a0)), hn::PromoteTo(d16, hn::LowerHalf(dh8, b0)));
+        const auto s1 = hn::Add(hn::PromoteTo(d16, hn::UpperHalf(dh8, a0)), hn::PromoteTo(d16, hn::UpperHalf(dh8, b0)));
+        const auto s2 = hn::Add(hn::PromoteTo(d16, hn::LowerHalf(dh8, a1)), hn::PromoteTo(d16, hn::LowerHalf(dh8, b1)));
+        const auto s3 = hn::Add(hn::PromoteTo(d16, hn::UpperHalf(dh8, a1)), hn::PromoteTo(d16, hn::UpperHalf(dh8, b1)));
+        const auto out = hn::Combine(d8, hn::DemoteTo(dh8, pairSum(s2, s3)), hn::DemoteTo(dh8, pairSum(s0, s1)));
+        hn::StoreU(out, d8, dst + static_cast<size_t>(x) * 4);
+    }
+#endif
+    Downsample2xRowScalar(row0, row1, dst, x, srcW);
+}
+
+// ============================================================================
+// FrameStatsRowBgra8 - banked R/G/B/L histograms + Laplacian luma line
+// Lane k scatters into bank k % 4, so runs of equal pixels (flat areas, the
+// common case) bump four different counters instead of waiting on one
+// store-to-load chain. Luma / 1000 is ((sum >> 3) * 33555) >> 22: exact for
+// every reachable sum, and it stays within 32 bits.
+// ============================================================================
+void FrameStatsRowBgra8Impl(const uint8_t* HWY_RESTRICT row, int width, uint32_t* HWY_RESTRICT banks,
+                            uint8_t* HWY_RESTRICT lapLuma) {
+    size_t x = 0;
+#if HWY_TARGET != HWY_SCALAR
+    const hn::ScalableTag<uint32_t> d32;
+    const hn::Rebind<uint8_t, decltype(d32)> d8;
+    const size_t N = hn::Lanes(d32);
+    const auto v299 = hn::Set(d32, 299u);
+    const auto v587 = hn::Set(d32, 587u);
+    const auto v114 = hn::Set(d32, 114u);
+    const auto v500 = hn::Set(d32, 500u);
+    const auto vDiv = hn::Set(d32, 33555u);
+    const auto v54 = hn::Set(d32, 54u);
+    const auto v183 = hn::Set(d32, 183u);
+    const auto v19 = hn::Set(d32, 19u);
+
+    HWY_ALIGN uint8_t bBuf[HWY_MAX_LANES_D(hn::ScalableTag<uint32_t>)];
+    HWY_ALIGN uint8_t gBuf[HWY_MAX_LANES_D(hn::ScalableTag<uint32_t>)];
+    HWY_ALIGN uint8_t rBuf[HWY_MAX_LANES_D(hn::ScalableTag<uint32_t>)];
+    HWY_ALIGN uint8_t lBuf[HWY_MAX_LANES_D(hn::ScalableTag<uint32_t>)];
+
+    for (; x + N <= static_cast<size_t>(width); x += N) {
+        hn::Vec<decltype(d8)> b8, g8, r8, a8;
+        hn::LoadInterleaved4(d8, row + x * 4, b8, g8, r8, a8);
+        const auto b = hn::PromoteTo(d32, b8);
+        const auto g = hn::PromoteTo(d32, g8);
+        const auto r = hn::PromoteTo(d32, r8);
+
+        auto sum = hn::MulAdd(r, v299, v500);
+        sum = hn::MulAdd(g, v587, sum);
+        sum = hn::MulAdd(b, v114, sum);
+        const auto luma = hn::ShiftRight<22>(hn::Mul(hn::ShiftRight<3>(sum), vDiv));
+
+        hn::Store(b8, d8, bBuf);
+        hn::Store(g8, d8, gBuf);
+        hn::Store(r8, d8, rBuf);
+        hn::Store(hn::DemoteTo(d8, luma), d8, lBuf);
+        if (lapLuma) {
+            const auto lap = hn::MulAdd(r, v54, hn::MulAdd(g, v183, hn::Mul(b, v19)));
+            hn::StoreU(hn::DemoteTo(d8, hn::ShiftRight<8>(lap)), d8, lapLuma + x);
+        }
+
+        // x is a multiple of N (itself a multiple of 4), so lane k lands in bank k % 4
+        for (size_t k = 0; k < N; ++k) {
+            uint32_t* h = banks + (k % kStatsBanks) * kStatsBankSize;
+            h[bBuf[k]]++;
+            h[256 + gBuf[k]]++;
+            h[512 + rBuf[k]]++;
+            h[768 + lBuf[k]]++;
+        }
+    }
+#endif
+    FrameStatsRowBgra8Scalar(row, x, static_cast<size_t>(width), banks, lapLuma);
+}
+
+// ============================================================================
+// LaplacianRow - sum of squared 4-neighbour Laplacians over three luma lines
+// Laplacians fit int16 (|lap| <= 1020); squares are pair-summed into int32 and
+// flushed every 1024 points, before 1024 * 1020^2 could overflow.
+// ============================================================================
+uint64_t LaplacianRowImpl(const uint8_t* HWY_RESTRICT up, const uint8_t* HWY_RESTRICT mid,
+                          const uint8_t* HWY_RESTRICT down, int count) {
+    size_t j = 1;
+    uint64_t total = 0;
+#if HWY_TARGET != HWY_SCALAR
+    const hn::ScalableTag<int16_t> d16;
+    const hn::Rebind<uint8_t, decltype(d16)> d8;
+    const hn::Repartition<int32_t, decltype(d16)> d32;
+    const size_t N = hn::Lanes(d16);
+    const size_t n = static_cast<size_t>(count);
+
+    while (j + N < n) {
+        auto acc = hn::Zero(d32);
+        for (size_t points = 0; points < 1024 && j + N < n; points += N, j += N) {
+            const auto c = hn::PromoteTo(d16, hn::LoadU(d8, mid + j));
+            const auto l = hn::PromoteTo(d16, hn::LoadU(d8, mid + j - 1));
+            const auto r = hn::PromoteTo(d16, hn::LoadU(d8, mid + j + 1));
+            const auto u = hn::PromoteTo(d16, hn::LoadU(d8, up + j));
+            const auto d = hn::PromoteTo(d16, hn::LoadU(d8, down + j));
+            const auto lap = hn::Sub(hn::Add(hn::Add(u, d), hn::Add(l, r)), hn::ShiftLeft<2>(c));
+            acc = hn::Add(acc, hn::WidenMulPairwiseAdd(d32, lap, lap));
+        }
+        total += static_cast<uint64_t>(hn::ReduceSum(d32, acc));
+    }
+#endif
+    return total + LaplacianRowScalar(up, mid, down, j, static_cast<size_t>(count));
+}
+
 void Pack16to8Impl(const uint16_t* HWY_RESTRICT src, uint8_t* HWY_RESTRICT dst, size_t pixelCount) {
     namespace hn = hwy::HWY_NAMESPACE;
     const hn::ScalableTag<uint16_t> d16;
@@ -1461,6 +2108,620 @@ void Pack16to8Impl(const uint16_t* HWY_RESTRICT src, uint8_t* HWY_RESTRICT dst,
     }
 }
 
+// ============================================================================
+// UndoHorizontalPredictor - TIFF Predictor=2, one row in-place
+// Per 128-bit block: log-step prefix sum over lanes S apart (S = samples), then
+// add the carried last pixel of the previous block. Blocks advance by whole
+// pixels (15 bytes / 6 lanes for 3 samples); the next block is loaded before the
+// current one is stored so the overlapping lanes still read original deltas.
+// ============================================================================
+#if HWY_TARGET != HWY_SCALAR
+template <typename T, int S>
+HWY_INLINE size_t UndoPredictorBlocks(T* HWY_RESTRICT row, size_t count) {
+    const hn::Full128<T> d;
+    const hn::Full128<uint8_t> d8;
+    constexpr int kLanes = 16 / static_cast<int>(sizeof(T));
+    constexpr int kStep = (kLanes / S) * S;
+    if (count < static_cast<size_t>(kLanes)) return 0;
+
+    // Broadcast pattern of the last complete pixel in a block, lane L <- channel L % S
+    alignas(16) uint8_t carryIdx[16];
+    for (int b = 0; b < 16; ++b) {
+        const int lane = b / static_cast<int>(sizeof(T));
+        const int srcLane = kStep - S + (lane % S);
+        carryIdx[b] = static_cast<uint8_t>(srcLane * static_cast<int>(sizeof(T)) + b % static_cast<int>(sizeof(T)));
+    }
+    const auto idx = hn::Load(d8, carryIdx);
+
+    auto carry = hn::Zero(d);
+    auto cur = hn::LoadU(d, row);
+    size_t i = 0;
+    for (; i + kStep + kLanes <= count; i += kStep) {
+        const auto next = hn::LoadU(d, row + i + kStep);
+        auto v = hn::Add(cur, hn::ShiftLeftLanes<S>(d, cur));
+        if constexpr (2 * S < kLanes) v = hn::Add(v, hn::ShiftLeftLanes<2 * S>(d, v));
+        if constexpr (4 * S < kLanes) v = hn::Add(v, hn::ShiftLeftLanes<4 * S>(d, v));
+        if constexpr (8 * S < kLanes) v = hn::Add(v, hn::ShiftLeftLanes<8 * S>(d, v));
+        v = hn::Add(v, carry);
+        hn::StoreU(v, d, row + i);
+        carry = hn::BitCast(d, hn::TableLookupBytes(hn::BitCast(d8, v), idx));
+        cur = next;
+    }
+    // Restore the deltas clobbered by the last overlapping store, then hand the
+    // remainder to the scalar loop (it continues from fully-summed lanes < i)
+    hn::StoreU(cur, d, row + i);
+    return i;
+}
+#endif
+
+void UndoHorizontalPredictorImpl(uint8_t* row, int width, int samples, int bytesPerSample, bool bigEndian) {
+    if (!row || width <= 1 || samples <= 0) return;
+    const size_t count = static_cast<size_t>(width) * samples;
+    size_t done = 0;
+
+#if HWY_TARGET != HWY_SCALAR
+    if (bytesPerSample == 1) {
+        switch (samples) {
+            case 1: done = UndoPredictorBlocks<uint8_t, 1>(row, count); break;
+            case 2: done = UndoPredictorBlocks<uint8_t, 2>(row, count); break;
+            case 3: done = UndoPredictorBlocks<uint8_t, 3>(row, count); break;
+            case 4: done = UndoPredictorBlocks<uint8_t, 4>(row, count); break;
+            default: break;
+        }
+    } else if (bytesPerSample == 2 && !bigEndian && (reinterpret_cast<uintptr_t>(row) & 1) == 0) {
+        uint16_t* row16 = reinterpret_cast<uint16_t*>(row);
+        switch (samples) {
+            case 1: done = UndoPredictorBlocks<uint16_t, 1>(row16, count); break;
+            case 2: done = UndoPredictorBlocks<uint16_t, 2>(row16, count); break;
+            case 3: done = UndoPredictorBlocks<uint16_t, 3>(row16, count); break;
+            case 4: done = UndoPredictorBlocks<uint16_t, 4>(row16, count); break;
+            default: break;
+        }
+    }
+#endif
+
+    UndoHorizontalPredictorScalar(row, done, count, samples, bytesPerSample, bigEndian);
+}
+
+// ============================================================================
+// InterleavePlanes - PlanarConfiguration=2 rows to chunky order
+// One full vector per plane, written with StoreInterleaved2/3/4 on lanes of the
+// sample width (u8/u16/u32), so float samples are moved bit-exact.
+// ============================================================================
+template <class D>
+HWY_INLINE size_t InterleavePlaneLanes(D d, const uint8_t* const* planes, int planeCount,
+                                       uint8_t* HWY_RESTRICT dst, size_t count) {
+    using T = hn::TFromD<D>;
+    const size_t N = hn::Lanes(d);
+    const T* p0 = reinterpret_cast<const T*>(planes[0]);
+    const T* p1 = reinterpret_cast<const T*>(planes[1]);
+    T* out = reinterpret_cast<T*>(dst);
+
+    size_t i = 0;
+    if (planeCount == 2) {
+        for (; i + N <= count; i += N) {
+            hn::StoreInterleaved2(hn::LoadU(d, p0 + i), hn::LoadU(d, p1 + i), d, out + i * 2);
+        }
+    } else if (planeCount == 3) {
+        const T* p2 = reinterpret_cast<const T*>(planes[2]);
+        for (; i + N <= count; i += N) {
+            hn::StoreInterleaved3(hn::LoadU(d, p0 + i), hn::LoadU(d, p1 + i), hn::LoadU(d, p2 + i),
+                                  d, out + i * 3);
+        }
+    } else if (planeCount == 4) {
+        const T* p2 = reinterpret_cast<const T*>(planes[2]);
+        const T* p3 = reinterpret_cast<const T*>(planes[3]);
+        for (; i + N <= count; i += N) {
+            hn::StoreInterleaved4(hn::LoadU(d, p0 + i), hn::LoadU(d, p1 + i), hn::LoadU(d, p2 + i),
+                                  hn::LoadU(d, p3 + i), d, out + i * 4);
+        }
+    }
+    return i;
+}
+
+void InterleavePlanesImpl(const uint8_t* const* planes, int planeCount, int bytesPerSample,
+                          uint8_t* dst, size_t count) {
+    if (!planes || !dst || planeCount <= 0 || count == 0) return;
+    const size_t bps = static_cast<size_t>(bytesPerSample);
+    if (planeCount == 1) {
+        std::memcpy(dst, planes[0], count * bps);
+        return;
+    }
+
+    // Wide lanes need sample-aligned pointers; odd offsets into a mapped file go scalar
+    bool aligned = (reinterpret_cast<uintptr_t>(dst) % bps) == 0;
+    for (int p = 0; p < planeCount; ++p) {
+        aligned = aligned && (reinterpret_cast<uintptr_t>(planes[p]) % bps) == 0;
+    }
+
+    size_t done = 0;
+    if (planeCount <= 4 && aligned) {
+        switch (bytesPerSample) {
+            case 1: done = InterleavePlaneLanes(hn::ScalableTag<uint8_t>(), planes, planeCount, dst, count); break;
+            case 2: done = InterleavePlaneLanes(hn::ScalableTag<uint16_t>(), planes, planeCount, dst, count); break;
+            case 4: done = InterleavePlaneLanes(hn::ScalableTag<uint32_t>(), planes, planeCount, dst, count); break;
+            default: break;
+        }
+    }
+
+    for (size_t i = done; i < count; ++i) {
+        for (int p = 0; p < planeCount; ++p) {
+            std::memcpy(dst + (i * planeCount + p) * bps, planes[p] + i * bps, bps);
+        }
+    }
+}
+
+// ============================================================================
+// Codec conversions to BGRA8 - CMYK, gray, palette, 16-to-8 narrowing, PSD planes
+// Integer math only, so every target matches the scalar helpers bit for bit.
+// ============================================================================
+#if HWY_TARGET != HWY_SCALAR
+// Div255Round on u16 lanes holding products of two bytes (t <= 65025, no overflow)
+template <class D16>
+HWY_INLINE hn::VFromD<D16> Div255RoundU16(D16 d16, hn::VFromD<D16> t) {
+    const auto u = hn::Add(t, hn::Set(d16, 128));
+    return hn::ShiftRight<8>(hn::Add(u, hn::ShiftRight<8>(u)));
+}
+
+// Big-endian 0..32768 samples to 8-bit: (v * 510 + 32768) >> 16, with the low
+// product half supplying the rounding carry so everything stays in u16 lanes
+template <class D16>
+HWY_INLINE hn::VFromD<hn::Rebind<uint8_t, D16>> PsdSamples16To8(D16 d16, const uint8_t* HWY_RESTRICT p) {
+    const hn::Repartition<uint8_t, D16> dBytes;
+    const hn::Rebind<uint8_t, D16> d8;
+    const auto raw = hn::BitCast(d16, hn::LoadU(dBytes, p));
+    const auto v = hn::Min(hn::Or(hn::ShiftLeft<8>(raw), hn::ShiftRight<8>(raw)), hn::Set(d16, 32768));
+    const auto k = hn::Set(d16, 510);
+    return hn::DemoteTo(d8, hn::Add(hn::MulHigh(v, k), hn::ShiftRight<15>(hn::Mul(v, k))));
+}
+#endif
+
+void CmykToBgraImpl(const uint8_t* HWY_RESTRICT src, int samples, uint8_t* HWY_RESTRICT dst, int width) {
+    if (!src || !dst || width <= 0 || samples < 4) return;
+    const size_t w = static_cast<size_t>(width);
+    size_t x = 0;
+
+#if HWY_TARGET != HWY_SCALAR
+    if (samples == 4) {
+        const hn::ScalableTag<uint16_t> d16;
+        const hn::Rebind<uint8_t, decltype(d16)> d8;
+        const size_t N = hn::Lanes(d16);
+        const auto opaque = hn::Set(d8, 255);
+        for (; x + N <= w; x += N) {
+            hn::VFromD<decltype(d8)> c, m, y, k;
+            hn::LoadInterleaved4(d8, src + x * 4, c, m, y, k);
+            const auto invK = hn::PromoteTo(d16, hn::Not(k));
+            const auto b = hn::DemoteTo(d8, Div255RoundU16(d16, hn::Mul(hn::PromoteTo(d16, hn::Not(y)), invK)));
+            const auto g = hn::DemoteTo(d8, Div255RoundU16(d16, hn::Mul(hn::PromoteTo(d16, hn::Not(m)), invK)));
+            const auto r = hn::DemoteTo(d8, Div255RoundU16(d16, hn::Mul(hn::PromoteTo(d16, hn::Not(c)), invK)));
+            hn::StoreInterleaved4(b, g, r, opaque, d8, dst + x * 4);
+        }
+    }
+#endif
+    CmykToBgraScalar(src, samples, dst, x, w);
+}
+
+void GrayToBgraImpl(const uint8_t* HWY_RESTRICT src, int samples, uint8_t* HWY_RESTRICT dst, int width, bool invert) {
+    if (!src || !dst || width <= 0 || samples < 1) return;
+    const size_t w = static_cast<size_t>(width);
+    size_t x = 0;
+
+#if HWY_TARGET != HWY_SCALAR
+    const hn::ScalableTag<uint8_t> d8;
+    const size_t N = hn::Lanes(d8);
+    const auto flip = hn::Set(d8, static_cast<uint8_t>(invert ? 0xFF : 0)); // 255 - v == v ^ 0xFF
+    if (samples == 1) {
+        const auto opaque = hn::Set(d8, 255);
+        for (; x + N <= w; x += N) {
+            const auto v = hn::Xor(hn::LoadU(d8, src + x), flip);
+            hn::StoreInterleaved4(v, v, v, opaque, d8, dst + x * 4);
+        }
+    } else if (samples == 2) {
+        for (; x + N <= w; x += N) {
+            hn::VFromD<decltype(d8)> v, a;
+            hn::LoadInterleaved2(d8, src + x * 2, v, a);
+            v = hn::Xor(v, flip);
+            hn::StoreInterleaved4(v, v, v, a, d8, dst + x * 4);
+        }
+    }
+#endif
+    GrayToBgraScalar(src, samples, dst, x, w, invert);
+}
+
+void PaletteToBgraImpl(const uint8_t* HWY_RESTRICT indices, const uint32_t* HWY_RESTRICT palette,
+                       uint8_t* HWY_RESTRICT dst, int width) {
+    if (!indices || !palette || !dst || width <= 0) return;
+    const size_t w = static_cast<size_t>(width);
+    size_t x = 0;
+
+#if HWY_TARGET != HWY_SCALAR
+    const hn::ScalableTag<uint32_t> d32;
+    const hn::RebindToSigned<decltype(d32)> di32;
+    const hn::Rebind<uint8_t, decltype(d32)> d8;
+    const hn::Repartition<uint8_t, decltype(d32)> dBytes;
+    const size_t N = hn::Lanes(d32);
+    for (; x + N <= w; x += N) {
+        const auto idx = hn::BitCast(di32, hn::PromoteTo(d32, hn::LoadU(d8, indices + x)));
+        hn::StoreU(hn::BitCast(dBytes, hn::GatherIndex(d32, palette, idx)), dBytes, dst + x * 4);
+    }
+#endif
+    for (; x < w; ++x) {
+        std::memcpy(dst + x * 4, &palette[indices[x]], 4);
+    }
+}
+
+void Narrow16To8Impl(const uint8_t* HWY_RESTRICT src, uint8_t* HWY_RESTRICT dst, size_t count, bool bigEndian) {
+    if (!src || !dst) return;
+    size_t i = 0;
+
+#if HWY_TARGET != HWY_SCALAR
+    const hn::ScalableTag<uint8_t> d8;
+    const size_t N = hn::Lanes(d8);
+    for (; i + N <= count; i += N) {
+        hn::VFromD<decltype(d8)> first, second;
+        hn::LoadInterleaved2(d8, src + i * 2, first, second);
+        hn::StoreU(bigEndian ? first : second, d8, dst + i);
+    }
+#endif
+    const size_t hi = bigEndian ? 0 : 1;
+    for (; i < count; ++i) {
+        dst[i] = src[i * 2 + hi];
+    }
+}
+
+void PlanarToBgraImpl(const uint8_t* const* planes, int bytesPerSample, uint8_t* HWY_RESTRICT dst, int width) {
+    if (!planes || !planes[0] || !planes[1] || !planes[2] || !dst || width <= 0) return;
+    if (bytesPerSample != 1 && bytesPerSample != 2) return;
+    const size_t w = static_cast<size_t>(width);
+    size_t x = 0;
+
+#if HWY_TARGET != HWY_SCALAR
+    if (bytesPerSample == 1) {
+        const hn::ScalableTag<uint8_t> d8;
+        const size_t N = hn::Lanes(d8);
+        const auto opaque = hn::Set(d8, 255);
+        for (; x + N <= w; x += N) {
+            const auto r = hn::LoadU(d8, planes[0] + x);
+            const auto g = hn::LoadU(d8, planes[1] + x);
+            const auto b = hn::LoadU(d8, planes[2] + x);
+            const auto a = planes[3] ? hn::LoadU(d8, planes[3] + x) : opaque;
+            hn::StoreInterleaved4(b, g, r, a, d8, dst + x * 4);
+        }
+    } else {
+        const hn::ScalableTag<uint16_t> d16;
+        const hn::Rebind<uint8_t, decltype(d16)> d8;
+        const size_t N = hn::Lanes(d16);
+        const auto opaque = hn::Set(d8, 255);
+        for (; x + N <= w; x += N) {
+            const auto r = PsdSamples16To8(d16, planes[0] + x * 2);
+            const auto g = PsdSamples16To8(d16, planes[1] + x * 2);
+            const auto b = PsdSamples16To8(d16, planes[2] + x * 2);
+            const auto a = planes[3] ? PsdSamples16To8(d16, planes[3] + x * 2) : opaque;
+            hn::StoreInterleaved4(b, g, r, a, d8, dst + x * 4);
+        }
+    }
+#endif
+    PlanarToBgraScalar(planes, bytesPerSample, dst, x, w);
+}
+
+// ============================================================================
+// ComputeEngine tone-mapping pipeline (CPU twin of CSToneMap / CSToneMapHDR /
+// CSComposeGainMap). The PQ curve raises to powers up to 78.8, so pow goes
+// through log2 / exp2 accurate to a few ulps instead of the fastLog2 / fastExp2
+// approximations the ACES kernels get away with.
+// ============================================================================
+template <class DF>
+HWY_INLINE hn::VFromD<DF> Log2Accurate(DF df, hn::VFromD<DF> x) {
+    const hn::RebindToSigned<DF> di;
+    // x = m * 2^e with m in [sqrt(1/2), sqrt(2))
+    const auto ix = hn::BitCast(di, x);
+    const auto e = hn::ShiftRight<23>(hn::Sub(ix, hn::Set(di, 0x3F3504F3)));
+    const auto m = hn::BitCast(df, hn::Sub(ix, hn::ShiftLeft<23>(e)));
+    // ln(m) = 2 atanh(s), s = (m - 1) / (m + 1), |s| < 0.172
+    const auto one = hn::Set(df, 1.0f);
+    const auto s = hn::Div(hn::Sub(m, one), hn::Add(m, one));
+    const auto s2 = hn::Mul(s, s);
+    auto p = hn::MulAdd(s2, hn::Set(df, 1.0f / 9.0f), hn::Set(df, 1.0f / 7.0f));
+    p = hn::MulAdd(p, s2, hn::Set(df, 1.0f / 5.0f));
+    p = hn::MulAdd(p, s2, hn::Set(df, 1.0f / 3.0f));
+    p = hn::MulAdd(p, s2, one);
+    return hn::MulAdd(hn::Mul(s, hn::Set(df, 2.88539008f)), p, hn::ConvertTo(df, e));
+}
+
+template <class DF>
+HWY_INLINE hn::VFromD<DF> Exp2Accurate(DF df, hn::VFromD<DF> x) {
+    const hn::RebindToSigned<DF> di;
+    x = hn::Clamp(x, hn::Set(df, -126.0f), hn::Set(df, 127.0f));
+    const auto xi = hn::Round(x);
+    const auto f = hn::Sub(x, xi); // [-0.5, 0.5]
+    auto p = hn::MulAdd(f, hn::Set(df, 1.5252734e-5f), hn::Set(df, 1.5403530e-4f));
+    p = hn::MulAdd(p, f, hn::Set(df, 1.3333558e-3f));
+    p = hn::MulAdd(p, f, hn::Set(df, 9.6181291e-3f));
+    p = hn::MulAdd(p, f, hn::Set(df, 5.5504109e-2f));
+    p = hn::MulAdd(p, f, hn::Set(df, 0.24022651f));
+    p = hn::MulAdd(p, f, hn::Set(df, 0.69314718f));
+    p = hn::MulAdd(p, f, hn::Set(df, 1.0f));
+    const auto scale = hn::BitCast(df, hn::ShiftLeft<23>(hn::Add(hn::ConvertTo(di, xi), hn::Set(di, 127))));
+    return hn::Mul(p, scale);
+}
+
+// x^y for x > 0; 0 for x <= 0 and denormals (the HLSL pow's exp2(y * log2(x)) for y > 0)
+template <class DF>
+HWY_INLINE hn::VFromD<DF> PowAccurate(DF df, hn::VFromD<DF> x, hn::VFromD<DF> y) {
+    const auto valid = hn::Ge(x, hn::Set(df, 1.17549435e-38f));
+    const auto safe = hn::IfThenElse(valid, x, hn::Set(df, 1.0f));
+    return hn::IfThenElseZero(valid, Exp2Accurate(df, hn::Mul(y, Log2Accurate(df, safe))));
+}
+
+template <class DF>
+HWY_INLINE hn::VFromD<DF> LinearToPqV(DF df, hn::VFromD<DF> l) {
+    const auto p = PowAccurate(df, hn::Mul(hn::Max(l, hn::Zero(df)), hn::Set(df, 1.0f / 125.0f)),
+                               hn::Set(df, 2610.0f / 16384.0f));
+    const auto num = hn::MulAdd(p, hn::Set(df, 18.8515625f), hn::Set(df, 0.8359375f));
+    const auto den = hn::MulAdd(p, hn::Set(df, 18.6875f), hn::Set(df, 1.0f));
+    return PowAccurate(df, hn::Div(num, den), hn::Set(df, 78.84375f));
+}
+
+template <class DF>
+HWY_INLINE hn::VFromD<DF> PqToLinearV(DF df, hn::VFromD<DF> v) {
+    const auto p = PowAccurate(df, v, hn::Set(df, 1.0f / 78.84375f));
+    const auto num = hn::Max(hn::Sub(p, hn::Set(df, 0.8359375f)), hn::Zero(df));
+    const auto den = hn::NegMulAdd(p, hn::Set(df, 18.6875f), hn::Set(df, 18.8515625f));
+    return hn::Mul(PowAccurate(df, hn::Div(num, den), hn::Set(df, 16384.0f / 2610.0f)), hn::Set(df, 125.0f));
+}
+
+template <class DF>
+HWY_INLINE hn::VFromD<DF> Bt2020LumaV(DF df, hn::VFromD<DF> r, hn::VFromD<DF> g, hn::VFromD<DF> b) {
+    return hn::MulAdd(r, hn::Set(df, 0.2627f), hn::MulAdd(g, hn::Set(df, 0.6780f), hn::Mul(b, hn::Set(df, 0.0593f))));
+}
+
+// One row, pixels [0, width): load per source format, ToneMapPixelScalar on N lanes,
+// then BGRA8 sRGB (straight alpha) or RGBA FP16
+void ToneMapRowImpl(const uint8_t* HWY_RESTRICT src, uint8_t* HWY_RESTRICT dst, int width,
+                    const ToneMapUniforms& u) {
+    if (!src || !dst || width <= 0) return;
+    const size_t w = static_cast<size_t>(width);
+    size_t x = 0;
+
+#if HWY_TARGET != HWY_SCALAR
+    using QuickView::PixelFormat;
+    const hn::ScalableTag<float> df;
+    const hn::RebindToSigned<decltype(df)> di;
+    const hn::Rebind<uint16_t, decltype(df)> du16;
+    const hn::Rebind<hwy::float16_t, decltype(df)> dh;
+    const hn::Rebind<uint8_t, decltype(df)> d8;
+    using VF = hn::VFromD<decltype(df)>;
+    const size_t N = hn::Lanes(df);
+
+    const VF zero = hn::Zero(df);
+    const VF one = hn::Set(df, 1.0f);
+    const VF scale = hn::Set(df, u.scale);
+
+    auto decode = [&](VF& r, VF& g, VF& b) {
+        r = hn::Max(r, zero);
+        g = hn::Max(g, zero);
+        b = hn::Max(b, zero);
+        if (u.transfer == 3) {
+            r = PqToLinearV(df, r);
+            g = PqToLinearV(df, g);
+            b = PqToLinearV(df, b);
+        } else if (u.transfer == 4) {
+            auto hlg = [&](VF v) {
+                const VF lo = hn::Mul(hn::Mul(v, v), hn::Set(df, 1.0f / 3.0f));
+                const VF ex = Exp2Accurate(df, hn::Mul(hn::Sub(v, hn::Set(df, 0.55991073f)),
+                                                       hn::Set(df, 1.44269504f / 0.17883277f)));
+                const VF hi = hn::Mul(hn::Add(ex, hn::Set(df, 0.28466892f)), hn::Set(df, 1.0f / 12.0f));
+                return hn::IfThenElse(hn::Ge(v, hn::Set(df, 0.5f)), hi, lo);
+            };
+            r = hlg(r);
+            g = hlg(g);
+            b = hlg(b);
+            const VF gain = hn::Mul(PowAccurate(df, Bt2020LumaV(df, r, g, b), hn::Set(df, 0.2f)), hn::Set(df, 12.5f));
+            r = hn::Mul(r, gain);
+            g = hn::Mul(g, gain);
+            b = hn::Mul(b, gain);
+        } else if (u.transfer == 1) {
+            auto srgb = [&](VF c) {
+                const VF lo = hn::Mul(c, hn::Set(df, 1.0f / 12.92f));
+                const VF hi = PowAccurate(df, hn::Mul(hn::Add(c, hn::Set(df, 0.055f)), hn::Set(df, 1.0f / 1.055f)),
+                                          hn::Set(df, 2.4f));
+                return hn::IfThenElse(hn::Le(c, hn::Set(df, 0.04045f)), lo, hi);
+            };
+            r = srgb(r);
+            g = srgb(g);
+            b = srgb(b);
+        }
+        r = hn::Mul(r, scale);
+        g = hn::Mul(g, scale);
+        b = hn::Mul(b, scale);
+    };
+
+    auto toneCurve = [&](VF& r, VF& g, VF& b) {
+        const VF l = Bt2020LumaV(df, r, g, b);
+        const auto active = hn::Gt(l, hn::Set(df, 1e-6f));
+        if (hn::AllFalse(df, active)) return;
+        const VF safeL = hn::IfThenElse(active, l, one);
+        VF target = safeL;
+        if (u.mode == 0) {
+            const VF lPq = LinearToPqV(df, safeL);
+            const VF xv = hn::Sub(lPq, hn::Set(df, u.srcPivot));
+            const VF xh = hn::Min(xv, hn::Set(df, u.splineMaxX));
+            const VF xl = hn::Max(xv, hn::Set(df, -u.srcPivot));
+            VF hi = hn::MulAdd(hn::Set(df, u.qa), xh, hn::Set(df, u.qb));
+            hi = hn::MulAdd(hi, xh, hn::Set(df, u.qc));
+            hi = hn::MulAdd(hi, xh, hn::Set(df, u.dstPivot));
+            VF lo = hn::MulAdd(hn::Set(df, u.pa), xl, hn::Set(df, u.pb));
+            lo = hn::MulAdd(lo, xl, hn::Set(df, u.dstPivot));
+            const VF targetPq = hn::IfThenElse(hn::Gt(xv, zero), hi, lo);
+            target = PqToLinearV(df, hn::Clamp(targetPq, zero, hn::Set(df, u.splinePeakPq)));
+            if (u.contrast) {
+                const VF mappedPq = LinearToPqV(df, target);
+                const VF ratioPq = hn::Div(hn::Mul(lPq, hn::Set(df, u.invSceneAvgPq)),
+                                           hn::Max(hn::Mul(mappedPq, hn::Set(df, u.invMappedAvgPq)), hn::Set(df, 1e-6f)));
+                const VF factor = PowAccurate(df, hn::Max(ratioPq, hn::Set(df, 1e-6f)), hn::Set(df, u.contrastRecovery));
+                target = PqToLinearV(df, hn::Clamp(hn::Mul(mappedPq, factor), zero, hn::Set(df, u.contrastPeakPq)));
+            }
+        } else if (u.eetf) {
+            const VF lPq = LinearToPqV(df, safeL);
+            const VF ks = hn::Set(df, u.ks);
+            const VF c = hn::Set(df, u.eetfC);
+            const VF t = hn::Clamp(hn::Mul(hn::Sub(lPq, ks), hn::Set(df, u.eetfInvSpan)), zero, one);
+            VF h = hn::MulAdd(hn::Sub(c, hn::Set(df, 2.0f)), t, hn::NegMulAdd(hn::Set(df, 2.0f), c, hn::Set(df, 3.0f)));
+            h = hn::MulAdd(h, t, c);
+            h = hn::Mul(h, t);
+            const VF dstMax = hn::Set(df, u.dstMaxPq);
+            const VF mapped = PqToLinearV(df, hn::Clamp(hn::MulAdd(hn::Sub(dstMax, ks), h, ks), zero, dstMax));
+            target = hn::IfThenElse(hn::Gt(lPq, ks), mapped, safeL);
+        }
+        const VF ratio = hn::IfThenElse(active, hn::Div(target, safeL), one);
+        r = hn::Mul(r, ratio);
+        g = hn::Mul(g, ratio);
+        b = hn::Mul(b, ratio);
+        if (u.desat) {
+            const VF threshold = hn::Set(df, u.desatThreshold);
+            const VF t = hn::Max(hn::Mul(hn::Sub(threshold, ratio), hn::Set(df, u.invDesatThreshold)), zero);
+            // pow(t, 1.5) = t * sqrt(t)
+            const VF d = hn::IfThenElseZero(hn::Lt(ratio, threshold),
+                                            hn::Mul(hn::Mul(t, hn::Sqrt(t)), hn::Set(df, u.desatStrength)));
+            const VF m = Bt2020LumaV(df, r, g, b);
+            r = hn::MulAdd(hn::Sub(m, r), d, r);
+            g = hn::MulAdd(hn::Sub(m, g), d, g);
+            b = hn::MulAdd(hn::Sub(m, b), d, b);
+        }
+    };
+
+    auto matrixAndGamut = [&](VF& r, VF& g, VF& b) {
+        const VF r0 = r, g0 = g, b0 = b;
+        r = hn::MulAdd(hn::Set(df, u.matrix[0]), r0, hn::MulAdd(hn::Set(df, u.matrix[1]), g0, hn::Mul(hn::Set(df, u.matrix[2]), b0)));
+        g = hn::MulAdd(hn::Set(df, u.matrix[3]), r0, hn::MulAdd(hn::Set(df, u.matrix[4]), g0, hn::Mul(hn::Set(df, u.matrix[5]), b0)));
+        b = hn::MulAdd(hn::Set(df, u.matrix[6]), r0, hn::MulAdd(hn::Set(df, u.matrix[7]), g0, hn::Mul(hn::Set(df, u.matrix[8]), b0)));
+
+        const VF y = hn::MulAdd(hn::Set(df, u.gamutY[0]), r, hn::MulAdd(hn::Set(df, u.gamutY[1]), g, hn::Mul(hn::Set(df, u.gamutY[2]), b)));
+        const VF maxC = hn::Max(hn::Max(r, g), b);
+        const VF minC = hn::Min(hn::Min(r, g), b);
+        const VF peak = hn::Set(df, u.gamutPeak);
+        const auto over = hn::And(hn::Gt(maxC, peak), hn::Gt(maxC, y));
+        const auto under = hn::And(hn::Lt(minC, zero), hn::Gt(y, minC));
+        // Masked-off lanes divide by 1 so no inf / NaN reaches the selects
+        const VF kOver = hn::Div(hn::Sub(peak, y), hn::IfThenElse(over, hn::Sub(maxC, y), one));
+        const VF kUnder = hn::Div(y, hn::IfThenElse(under, hn::Sub(y, minC), one));
+        VF k = hn::IfThenElse(over, hn::Min(one, kOver), one);
+        k = hn::IfThenElse(under, hn::Min(k, kUnder), k);
+        const auto black = hn::Le(maxC, zero);
+        r = hn::IfThenZeroElse(black, hn::MulAdd(k, hn::Sub(r, y), y));
+        g = hn::IfThenZeroElse(black, hn::MulAdd(k, hn::Sub(g, y), y));
+        b = hn::IfThenZeroElse(black, hn::MulAdd(k, hn::Sub(b, y), y));
+    };
+
+    // Same sRGB encode as LinearToSdr8Scalar, through the accurate pow
+    auto toSdr8 = [&](VF v) {
+        v = hn::Max(v, zero);
+        const VF lo = hn::Mul(v, hn::Set(df, 12.92f));
+        const VF hi = hn::MulSub(hn::Set(df, 1.055f), PowAccurate(df, v, hn::Set(df, 1.0f / 2.4f)), hn::Set(df, 0.055f));
+        v = hn::Clamp(hn::IfThenElse(hn::Le(v, hn::Set(df, 0.0031308f)), lo, hi), zero, one);
+        return hn::DemoteTo(d8, hn::ConvertTo(di, hn::MulAdd(v, hn::Set(df, 255.0f), hn::Set(df, 0.5f))));
+    };
+
+    const float* src32 = reinterpret_cast<const float*>(src);
+    const uint16_t* src16 = reinterpret_cast<const uint16_t*>(src);
+    uint16_t* dst16 = reinterpret_cast<uint16_t*>(dst);
+    for (; x + N <= w; x += N) {
+        VF r, g, b, a;
+        if (u.srcFormat == PixelFormat::R32G32B32A32_FLOAT) {
+            hn::LoadInterleaved4(df, src32 + x * 4, r, g, b, a);
+        } else {
+            hn::VFromD<decltype(du16)> r16, g16, b16, a16;
+            hn::LoadInterleaved4(du16, src16 + x * 4, r16, g16, b16, a16);
+            if (u.srcFormat == PixelFormat::R16G16B16A16_FLOAT) {
+                r = hn::PromoteTo(df, hn::BitCast(dh, r16));
+                g = hn::PromoteTo(df, hn::BitCast(dh, g16));
+                b = hn::PromoteTo(df, hn::BitCast(dh, b16));
+                a = hn::PromoteTo(df, hn::BitCast(dh, a16));
+            } else {
+                const VF inv = hn::Set(df, 1.0f / 65535.0f);
+                r = hn::Mul(hn::ConvertTo(df, hn::PromoteTo(di, r16)), inv);
+                g = hn::Mul(hn::ConvertTo(df, hn::PromoteTo(di, g16)), inv);
+                b = hn::Mul(hn::ConvertTo(df, hn::PromoteTo(di, b16)), inv);
+                a = hn::Mul(hn::ConvertTo(df, hn::PromoteTo(di, a16)), inv);
+            }
+        }
+
+        decode(r, g, b);
+        if (u.toneMap) toneCurve(r, g, b);
+        matrixAndGamut(r, g, b);
+
+        if (u.hdrOutput) {
+            hn::StoreInterleaved4(hn::BitCast(du16, hn::DemoteTo(dh, r)), hn::BitCast(du16, hn::DemoteTo(dh, g)),
+                                  hn::BitCast(du16, hn::DemoteTo(dh, b)), hn::BitCast(du16, hn::DemoteTo(dh, a)),
+                                  du16, dst16 + x * 4);
+        } else {
+            const auto a8 = hn::DemoteTo(d8, hn::ConvertTo(di, hn::MulAdd(hn::Clamp(a, zero, one), hn::Set(df, 255.0f),
+                                                                          hn::Set(df, 0.5f))));
+            hn::StoreInterleaved4(toSdr8(b), toSdr8(g), toSdr8(r), a8, d8, dst + x * 4);
+        }
+    }
+#endif
+    ToneMapRowScalar(src, dst, x, w, u);
+}
+
+// One output row of CSComposeGainMap; see ComposeGainMapRowScalar for the layout
+void ComposeGainMapRowImpl(const uint8_t* HWY_RESTRICT sdr, const float* HWY_RESTRICT gainLine,
+                           const int32_t* HWY_RESTRICT x0s, const int32_t* HWY_RESTRICT x1s,
+                           const float* HWY_RESTRICT fx, uint16_t* HWY_RESTRICT dst, int width,
+                           const GainMapUniforms& u) {
+    if (!sdr || !gainLine || !dst || width <= 0) return;
+    const size_t w = static_cast<size_t>(width);
+    size_t x = 0;
+
+#if HWY_TARGET != HWY_SCALAR
+    const hn::ScalableTag<float> df;
+    const hn::RebindToSigned<decltype(df)> di;
+    const hn::Rebind<uint16_t, decltype(df)> du16;
+    const hn::Rebind<hwy::float16_t, decltype(df)> dh;
+    const hn::Rebind<uint8_t, decltype(df)> d8;
+    using VF = hn::VFromD<decltype(df)>;
+    const size_t N = hn::Lanes(df);
+
+    const VF weight = hn::Set(df, u.weight);
+    const auto opaque = hn::BitCast(du16, hn::DemoteTo(dh, hn::Set(df, 1.0f)));
+    auto gainFactor = [&](VF gain, int c) {
+        const VF encoded = PowAccurate(df, gain, hn::Set(df, u.invGamma[c]));
+        const VF gainLog = hn::MulAdd(hn::Set(df, u.gainSpan[c]), encoded, hn::Set(df, u.gainMin[c]));
+        return Exp2Accurate(df, hn::Mul(gainLog, weight));
+    };
+    auto apply = [&](VF base, VF factor, int c) {
+        const VF hdr = hn::Sub(hn::Mul(hn::Add(base, hn::Set(df, u.offsetSdr[c])), factor), hn::Set(df, u.offsetHdr[c]));
+        return hn::BitCast(du16, hn::DemoteTo(dh, hn::Max(hdr, hn::Zero(df))));
+    };
+
+    const float* sdr32 = reinterpret_cast<const float*>(sdr);
+    for (; x + N <= w; x += N) {
+        VF r, g, b;
+        if (u.floatBase) {
+            VF a;
+            hn::LoadInterleaved4(df, sdr32 + x * 4, r, g, b, a);
+        } else {
+            hn::VFromD<decltype(d8)> b8, g8, r8, a8;
+            hn::LoadInterleaved4(d8, sdr + x * 4, b8, g8, r8, a8);
+            r = hn::GatherIndex(df, u.srgbLut, hn::PromoteTo(di, r8));
+            g = hn::GatherIndex(df, u.srgbLut, hn::PromoteTo(di, g8));
+            b = hn::GatherIndex(df, u.srgbLut, hn::PromoteTo(di, b8));
+        }
+
+        const VF g0 = hn::GatherIndex(df, gainLine, hn::LoadU(di, x0s + x));
+        const VF g1 = hn::GatherIndex(df, gainLine, hn::LoadU(di, x1s + x));
+        const VF gain = hn::MulAdd(hn::Sub(g1, g0), hn::LoadU(df, fx + x), g0);
+
+        const VF factorR = gainFactor(gain, 0);
+        const VF factorG = u.sharedGain ? factorR : gainFactor(gain, 1);
+        const VF factorB = u.sharedGain ? factorR : gainFactor(gain, 2);
+        hn::StoreInterleaved4(apply(r, factorR, 0), apply(g, factorG, 1), apply(b, factorB, 2), opaque,
+                              du16, dst + x * 4);
+    }
+#endif
+    ComposeGainMapRowScalar(sdr, gainLine, x0s, x1s, fx, dst, x, w, u);
+}
+
 } // namespace HWY_NAMESPACE
 } // namespace ImageLoaderSimd
 HWY_AFTER_NAMESPACE();
@@ -1477,11 +2738,16 @@ HWY_EXPORT(PremultiplyAlphaImpl);
 HWY_EXPORT(SwizzleRGBAToBGRAImpl);
 HWY_EXPORT(ConvertRGBToBGRARowImpl);
 HWY_EXPORT(ResizeBilinearImpl);
+HWY_EXPORT(ResampleHorizontalImpl);
+HWY_EXPORT(ResampleVerticalImpl);
+HWY_EXPORT(Downsample2xRowImpl);
 HWY_EXPORT(Pack16to8Impl);
 HWY_EXPORT(FindPeakFloatImpl);
 HWY_EXPORT(ComputeHistogramRowImpl);
 HWY_EXPORT(ComputeHistogramRowFloatImpl);
 HWY_EXPORT(ComputeHistogramRowGainMapImpl);
+HWY_EXPORT(FrameStatsRowBgra8Impl);
+HWY_EXPORT(LaplacianRowImpl);
 HWY_EXPORT(SumLuminance8BitRangeImpl);
 HWY_EXPORT(SumLuminanceFloatRangeImpl);
 HWY_EXPORT(TransformColorMatrix3x3Impl);
@@ -1494,6 +2760,15 @@ HWY_EXPORT(FindPeakLuminanceHalfImpl);
 HWY_EXPORT(SumLuminanceHalfRangeImpl);
 HWY_EXPORT(ToneMapAcesBatchHalfImpl);
 HWY_EXPORT(ToneMapClipBatchHalfImpl);
+HWY_EXPORT(UndoHorizontalPredictorImpl);
+HWY_EXPORT(InterleavePlanesImpl);
+HWY_EXPORT(CmykToBgraImpl);
+HWY_EXPORT(GrayToBgraImpl);
+HWY_EXPORT(PaletteToBgraImpl);
+HWY_EXPORT(Narrow16To8Impl);
+HWY_EXPORT(PlanarToBgraImpl);
+HWY_EXPORT(ToneMapRowImpl);
+HWY_EXPORT(ComposeGainMapRowImpl);
 
 // ============================================================================
 // Public API: thin wrappers that call the best-available target
@@ -1523,6 +2798,128 @@ void ResizeBilinear(const uint8_t* src, int srcW, int srcH, int srcStride,
                                               dst, dstW, dstH, dstStride);
 }
 
+// Runs body(first, last, scratch) over rows [0, count) in bands of `bandRows`.
+// Bands go to short-lived workers off an atomic counter (the CMake build has no
+// OpenMP runtime); each worker keeps one scratch buffer across its bands.
+template <typename Body>
+static void ForEachRowBand(int count, int bandRows, bool parallel, Body&& body) {
+    const int bands = (count + bandRows - 1) / bandRows;
+    unsigned workers = 1;
+    if (parallel && bands > 1) {
+        workers = (std::min)(std::clamp(std::thread::hardware_concurrency(), 1u, 8u), static_cast<unsigned>(bands));
+    }
+
+    std::atomic<int> next{0};
+    auto run = [&]() {
+        std::vector<uint8_t> scratch;
+        for (int b = next.fetch_add(1, std::memory_order_relaxed); b < bands;
+             b = next.fetch_add(1, std::memory_order_relaxed)) {
+            body(b * bandRows, (std::min)(count, (b + 1) * bandRows), scratch);
+        }
+    };
+
+    std::vector<std::jthread> pool;
+    pool.reserve(workers - 1);
+    for (unsigned t = 1; t < workers; ++t) {
+        pool.emplace_back(run);
+    }
+    run();
+}
+
+// Output rows are cut into bands. A band runs the horizontal pass over just the
+// source rows it reads (band-local scratch), then the vertical pass. Neighbouring
+// bands share (taps - 1) source rows, so bands span at least 4x the vertical
+// window to keep the recomputation small.
+void Resize(const uint8_t* src, int srcW, int srcH, int srcStride,
+            uint8_t* dst, int dstW, int dstH, int dstStride, ResampleFilter filter) {
+    ResizeRegion(src, srcW, srcH, srcStride, 0.0, 0.0, srcW, srcH, dst, dstW, dstH, dstStride, filter);
+}
+
+void ResizeRegion(const uint8_t* src, int srcW, int srcH, int srcStride,
+                  double regionX, double regionY, double regionW, double regionH,
+                  uint8_t* dst, int dstW, int dstH, int dstStride, ResampleFilter filter) {
+    if (!src || !dst || srcW <= 0 || srcH <= 0 || dstW <= 0 || dstH <= 0) return;
+    if (!(regionW > 0.0) || !(regionH > 0.0)) return;
+    if (srcStride == 0) srcStride = srcW * 4;
+    if (dstStride == 0) dstStride = dstW * 4;
+    const size_t rowBytes = static_cast<size_t>(dstW) * 4;
+
+    // An axis is copied as-is only when the region is the whole source at 1:1
+    const bool resizeX = !(regionX == 0.0 && regionW == srcW && srcW == dstW);
+    const bool resizeY = !(regionY == 0.0 && regionH == srcH && srcH == dstH);
+    if (!resizeX && !resizeY) {
+        for (int y = 0; y < dstH; ++y) {
+            std::memcpy(dst + static_cast<size_t>(y) * dstStride, src + static_cast<size_t>(y) * srcStride, rowBytes);
+        }
+        return;
+    }
+
+    ResampleAxis xAxis, yAxis;
+    if (resizeX) BuildResampleAxis(srcW, dstW, filter, xAxis, regionX, regionW);
+    if (resizeY) BuildResampleAxis(srcH, dstH, filter, yAxis, regionY, regionH);
+
+    const auto horizontal = HWY_DYNAMIC_DISPATCH(ResampleHorizontalImpl);
+    const auto vertical = HWY_DYNAMIC_DISPATCH(ResampleVerticalImpl);
+
+    auto runBand = [&](int y0, int y1, std::vector<uint8_t>& scratch) {
+        if (!resizeY) {
+            for (int y = y0; y < y1; ++y) {
+                horizontal(src + static_cast<size_t>(y) * srcStride, dst + static_cast<size_t>(y) * dstStride,
+                           dstW, xAxis.start.data(), xAxis.weights.data(), xAxis.taps);
+            }
+            return;
+        }
+        const int s0 = yAxis.start[y0];
+        const int s1 = yAxis.start[y1 - 1] + yAxis.taps;
+        const uint8_t* rows = src + static_cast<size_t>(s0) * srcStride;
+        size_t rowStride = static_cast<size_t>(srcStride);
+        if (resizeX) {
+            scratch.resize(static_cast<size_t>(s1 - s0) * rowBytes);
+            for (int sy = s0; sy < s1; ++sy) {
+                horizontal(src + static_cast<size_t>(sy) * srcStride, scratch.data() + (sy - s0) * rowBytes,
+                           dstW, xAxis.start.data(), xAxis.weights.data(), xAxis.taps);
+            }
+            rows = scratch.data();
+            rowStride = rowBytes;
+        }
+        for (int y = y0; y < y1; ++y) {
+            vertical(rows + (yAxis.start[y] - s0) * rowStride, rowStride,
+                     yAxis.weights.data() + static_cast<size_t>(y) * yAxis.taps, yAxis.taps,
+                     dst + static_cast<size_t>(y) * dstStride, rowBytes);
+        }
+    };
+
+    int bandRows = 16;
+    if (resizeY) {
+        const double srcPerDst = regionH / dstH;
+        bandRows = (std::max)(bandRows, static_cast<int>(std::ceil(4.0 * yAxis.taps / srcPerDst)));
+    }
+    // Multiply-adds per channel; below ~4M the thread start-up costs more than it saves
+    const double work = (resizeX ? static_cast<double>(resizeY ? srcH : dstH) * dstW * xAxis.taps : 0.0) +
+                        (resizeY ? static_cast<double>(dstH) * dstW * yAxis.taps : 0.0);
+    ForEachRowBand(dstH, bandRows, work > 4.0 * 1024 * 1024, runBand);
+}
+
+void Downsample2x(const uint8_t* src, int srcW, int srcH, int srcStride,
+                  uint8_t* dst, int dstStride) {
+    if (!src || !dst || srcW <= 0 || srcH <= 0) return;
+    if (srcStride == 0) srcStride = srcW * 4;
+    const int dstW = (srcW + 1) / 2;
+    const int dstH = (srcH + 1) / 2;
+    if (dstStride == 0) dstStride = dstW * 4;
+
+    const auto row = HWY_DYNAMIC_DISPATCH(Downsample2xRowImpl);
+    // Memory-bound: only whole-image levels (cascaded LOD caches) are worth threads
+    const bool parallel = static_cast<double>(srcW) * srcH > 8.0 * 1024 * 1024;
+    ForEachRowBand(dstH, 64, parallel, [&](int y0, int y1, std::vector<uint8_t>&) {
+        for (int y = y0; y < y1; ++y) {
+            const uint8_t* r0 = src + static_cast<size_t>(y) * 2 * srcStride;
+            const uint8_t* r1 = (y * 2 + 1 < srcH) ? r0 + srcStride : r0;
+            row(r0, r1, dst + static_cast<size_t>(y) * dstStride, srcW);
+        }
+    });
+}
+
 void Pack16to8(const uint16_t* src, uint8_t* dst, size_t pixelCount) {
     HWY_DYNAMIC_DISPATCH(Pack16to8Impl)(src, dst, pixelCount);
 }
@@ -1550,6 +2947,109 @@ void ComputeHistogramRowGainMap(const uint8_t* sdrRow, const uint8_t* gainMapRow
     HWY_DYNAMIC_DISPATCH(ComputeHistogramRowGainMapImpl)(sdrRow, gainMapRow, width, auxWidth, mapRange, payload, histR, histG, histB, histL);
 }
 
+// Sampled row i is source row i * step. Each band keeps its own banks and a ring
+// of three Laplacian luma lines; it also derives the lines of the rows just
+// outside it, so every middle row gets its Laplacian without a second pass.
+void ComputeFrameStats(const FrameStatsSource& src, int step, FrameStats* out) {
+    if (!out) return;
+    *out = FrameStats{};
+    if (!src.pixels || src.width <= 0 || src.height <= 0) return;
+    step = (std::max)(step, 1);
+
+    const int rows = (src.height + step - 1) / step;
+    const int cols = (src.width + step - 1) / step; // Laplacian grid x = j * step
+    const bool gainMap = !src.isFloat && src.gainMap && src.payload && src.gainMapWidth > 0 && src.gainMapHeight > 0;
+    const bool fused = !src.isFloat && !gainMap;
+    const float mapRange = src.mapRange;
+
+    const auto statsRow = HWY_DYNAMIC_DISPATCH(FrameStatsRowBgra8Impl);
+    const auto lapRow = HWY_DYNAMIC_DISPATCH(LaplacianRowImpl);
+
+    auto rowPtr = [&](int i) { return src.pixels + static_cast<size_t>(i) * step * src.stride; };
+    auto lumaLine = [&](int i, uint8_t* line) {
+        const uint8_t* row = rowPtr(i);
+        for (int j = 0; j < cols; ++j) {
+            const size_t x = static_cast<size_t>(j) * step;
+            if (src.isFloat) {
+                const float* px = reinterpret_cast<const float*>(row) + x * 4;
+                line[j] = static_cast<uint8_t>(std::clamp((px[0] * 0.299f + px[1] * 0.587f + px[2] * 0.114f) * 255.0f, 0.0f, 255.0f));
+            } else {
+                const uint8_t* px = row + x * 4;
+                line[j] = static_cast<uint8_t>((54 * px[2] + 183 * px[1] + 19 * px[0]) >> 8);
+            }
+        }
+    };
+
+    std::mutex mergeMutex;
+    auto runBand = [&](int first, int last, std::vector<uint8_t>& scratch) {
+        const size_t bankBytes = kStatsBanks * kStatsBankSize * sizeof(uint32_t);
+        scratch.assign(bankBytes + 3 * static_cast<size_t>(cols), 0);
+        uint32_t* banks = reinterpret_cast<uint32_t*>(scratch.data());
+        uint8_t* ring[3] = { scratch.data() + bankBytes, scratch.data() + bankBytes + cols,
+                             scratch.data() + bankBytes + 2 * static_cast<size_t>(cols) };
+        uint64_t lapSum = 0;
+        int lapRows = 0;
+        auto laplacian = [&](int mid) { // Middle row `mid`, once rows mid - 1 .. mid + 1 are in the ring
+            if (mid < (std::max)(first, 1) || cols < 3) return;
+            lapSum += lapRow(ring[(mid + 2) % 3], ring[mid % 3], ring[(mid + 1) % 3], cols);
+            ++lapRows;
+        };
+
+        if (first > 0) lumaLine(first - 1, ring[(first - 1) % 3]);
+        for (int i = first; i < last; ++i) {
+            const uint8_t* row = rowPtr(i);
+            uint8_t* line = ring[i % 3];
+            if (fused) {
+                statsRow(row, src.width, banks, step == 1 ? line : nullptr);
+                if (step != 1) lumaLine(i, line);
+            } else {
+                uint32_t* hB = banks;
+                uint32_t* hG = banks + 256;
+                uint32_t* hR = banks + 512;
+                uint32_t* hL = banks + 768;
+                if (src.isFloat) {
+                    HWY_DYNAMIC_DISPATCH(ComputeHistogramRowFloatImpl)(reinterpret_cast<const float*>(row), src.width,
+                                                                       mapRange, hR, hG, hB, hL);
+                } else {
+                    int auxY = static_cast<int>(static_cast<int64_t>(i) * step * src.gainMapHeight / src.height);
+                    auxY = (std::min)(auxY, src.gainMapHeight - 1);
+                    const uint8_t* auxRow = src.gainMap + static_cast<size_t>(auxY) * src.gainMapStride;
+                    HWY_DYNAMIC_DISPATCH(ComputeHistogramRowGainMapImpl)(row, auxRow, src.width, src.gainMapWidth,
+                                                                         mapRange, *src.payload, hR, hG, hB, hL);
+                }
+                lumaLine(i, line);
+            }
+            laplacian(i - 1);
+        }
+        if (last < rows) {
+            lumaLine(last, ring[last % 3]);
+            laplacian(last - 1);
+        }
+
+        std::lock_guard lock(mergeMutex);
+        for (int b = 0; b < kStatsBanks; ++b) {
+            const uint32_t* h = banks + b * kStatsBankSize;
+            for (int v = 0; v < 256; ++v) {
+                out->histB[v] += h[v];
+                out->histG[v] += h[256 + v];
+                out->histR[v] += h[512 + v];
+                out->histL[v] += h[768 + v];
+            }
+        }
+        out->lapSumSq += lapSum;
+        out->lapCount += static_cast<uint64_t>(lapRows) * (cols >= 3 ? cols - 2 : 0);
+    };
+
+    // Sampling keeps most frames near 2 MP; threads only pay off above ~1 MP
+    const bool parallel = static_cast<double>(rows) * src.width > 1024.0 * 1024;
+    ForEachRowBand(rows, 64, parallel, runBand);
+
+    for (int v = 0; v < 256; ++v) {
+        out->pixelCount += out->histL[v];
+        out->lumaSum += static_cast<uint64_t>(v) * out->histL[v];
+    }
+}
+
 uint64_t SumLuminance8BitRange(const uint8_t* row, int x0, int x1, bool isRgbaOrder) {
     return HWY_DYNAMIC_DISPATCH(SumLuminance8BitRangeImpl)(row, x0, x1, isRgbaOrder);
 }
@@ -1611,6 +3111,338 @@ void ToneMapClipBatchHalf(const uint16_t* src, int srcStride,
                                                    width, height, exposure);
 }
 
+void UndoHorizontalPredictor(uint8_t* row, int width, int samples, int bytesPerSample, bool bigEndian) {
+    HWY_DYNAMIC_DISPATCH(UndoHorizontalPredictorImpl)(row, width, samples, bytesPerSample, bigEndian);
+}
+
+void InterleavePlanes(const uint8_t* const* planes, int planeCount, int bytesPerSample,
+                      uint8_t* dst, size_t count) {
+    HWY_DYNAMIC_DISPATCH(InterleavePlanesImpl)(planes, planeCount, bytesPerSample, dst, count);
+}
+
+void CmykToBgra(const uint8_t* src, int samples, uint8_t* dst, int width) {
+    HWY_DYNAMIC_DISPATCH(CmykToBgraImpl)(src, samples, dst, width);
+}
+
+void GrayToBgra(const uint8_t* src, int samples, uint8_t* dst, int width, bool invert) {
+    HWY_DYNAMIC_DISPATCH(GrayToBgraImpl)(src, samples, dst, width, invert);
+}
+
+void PaletteToBgra(const uint8_t* indices, const uint32_t* palette, uint8_t* dst, int width) {
+    HWY_DYNAMIC_DISPATCH(PaletteToBgraImpl)(indices, palette, dst, width);
+}
+
+void Narrow16To8(const uint8_t* src, uint8_t* dst, size_t count, bool bigEndian) {
+    HWY_DYNAMIC_DISPATCH(Narrow16To8Impl)(src, dst, count, bigEndian);
+}
+
+void PlanarToBgra(const uint8_t* const* planes, int bytesPerSample, uint8_t* dst, int width) {
+    HWY_DYNAMIC_DISPATCH(PlanarToBgraImpl)(planes, bytesPerSample, dst, width);
+}
+
+// ============================================================================
+// ComputeEngine tone-mapping pipeline on the CPU
+// ============================================================================
+
+// Folds everything in the constant buffer that does not depend on the pixel,
+// exactly as CSToneMap (hdrOutput = false) / CSToneMapHDR derive it
+static ToneMapUniforms MakeToneMapUniforms(QuickView::PixelFormat srcFormat, const QuickView::ToneMapSettings& s,
+                                           bool hdrOutput) {
+    ToneMapUniforms u{};
+    u.srcFormat = srcFormat;
+    u.hdrOutput = hdrOutput;
+    u.transfer = s.transferFunction;
+    u.scale = s.exposure * s.exposureGain;
+    u.mode = s.mode;
+    // Clip leaves ratio at exactly 1; ToneMapHDR's spline returns early for content the display holds
+    u.toneMap = s.mode != 1 && !(hdrOutput && s.mode == 0 && s.contentPeakScRgb <= s.displayPeakScRgb + 1e-5f);
+
+    const float displayPeak = (std::max)(s.displayPeakScRgb, 1.0f);
+    const float contentPq = LinearToPqScalar(s.contentPeakScRgb);
+    u.srcPivot = s.splineSrcPivot;
+    u.dstPivot = s.splineDstPivot;
+    u.pa = s.splinePa;
+    u.pb = s.splinePb;
+    u.qa = s.splineQa;
+    u.qb = s.splineQb;
+    u.qc = s.splineQc;
+    u.splineMaxX = contentPq - s.splineSrcPivot;
+    u.splinePeakPq = LinearToPqScalar(s.displayPeakScRgb);
+    u.contrast = s.contrastRecovery > 0.0f;
+    u.contrastRecovery = s.contrastRecovery;
+    u.invSceneAvgPq = 1.0f / (std::max)(s.sceneAvgPq, 1e-6f);
+    u.invMappedAvgPq = 1.0f / (std::max)(s.mappedAvgPq, 1e-6f);
+    u.contrastPeakPq = LinearToPqScalar(displayPeak);
+
+    u.dstMaxPq = LinearToPqScalar(displayPeak);
+    u.eetf = s.mode == 2 && contentPq > u.dstMaxPq;
+    u.ks = (std::max)(1.5f * u.dstMaxPq - 0.5f, 0.075f);
+    u.eetfInvSpan = 1.0f / (std::max)(contentPq - u.ks, 1e-6f);
+    u.eetfC = (contentPq - u.ks) / (std::max)(u.dstMaxPq - u.ks, 1e-6f);
+
+    // ratio >= 0, so a threshold <= 0 never desaturates
+    u.desat = s.desatThreshold > 0.0f;
+    u.desatThreshold = s.desatThreshold;
+    u.invDesatThreshold = u.desat ? 1.0f / s.desatThreshold : 0.0f;
+    u.desatStrength = s.desatStrength;
+
+    // SDR output normalizes [0, displayPeak] to [0, 1] before the matrix
+    const float norm = hdrOutput ? 1.0f : 1.0f / displayPeak;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) u.matrix[i * 3 + j] = s.colorMatrix[i * 4 + j] * norm;
+    }
+    static const float kRec709Y[3] = { 0.2126f, 0.7152f, 0.0722f };
+    static const float kBt2020Y[3] = { 0.2627f, 0.6780f, 0.0593f };
+    std::memcpy(u.gamutY, hdrOutput ? kBt2020Y : kRec709Y, sizeof(u.gamutY));
+    u.gamutPeak = hdrOutput ? (std::max)((std::min)(s.realHardwarePeakScRgb, s.displayPeakScRgb), 1.0f) : 1.0f;
+    return u;
+}
+
+static bool IsToneMapSource(QuickView::PixelFormat format) {
+    return format == QuickView::PixelFormat::R32G32B32A32_FLOAT || format == QuickView::PixelFormat::R16G16B16A16_FLOAT ||
+           format == QuickView::PixelFormat::R16G16B16A16_UNORM;
+}
+
+static void ToneMapRows(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height,
+                        const ToneMapUniforms& u) {
+    const bool parallel = static_cast<int64_t>(width) * height > 256 * 1024;
+    ForEachRowBand(height, 32, parallel, [&](int y0, int y1, std::vector<uint8_t>&) {
+        for (int y = y0; y < y1; ++y) {
+            HWY_DYNAMIC_DISPATCH(ToneMapRowImpl)(src + static_cast<size_t>(y) * srcStride,
+                                                 dst + static_cast<size_t>(y) * dstStride, width, u);
+        }
+    });
+}
+
+// libplacebo-compatible smoothstep (edge0 > edge1 maps to decreasing ramp)
+static float SplineSmoothStep(float edge0, float edge1, float x) {
+    x = std::clamp((x - edge0) / (edge1 - edge0 + 1e-9f), 0.0f, 1.0f);
+    return x * x * (3.0f - 2.0f * x);
+}
+
+void FitSplineToneCurve(QuickView::ToneMapSettings& settings, float kneeOverride) {
+    const float contentPeakLinear = settings.contentPeakScRgb;
+    const float displayPeakLinear = (std::max)(settings.displayPeakScRgb, 1e-4f);
+
+    // --- Convert all luminance bounds to PQ space [0, 1] ---
+    const float input_min  = 0.0f;
+    const float input_max  = LinearToPqScalar(contentPeakLinear);
+    const float output_min = 0.0f;
+    const float output_max = LinearToPqScalar(displayPeakLinear);
+
+    // Static image viewer: force input_avg = 0 to use default knee position.
+    // mpv uses dynamic peak detection (hdr-compute-peak=yes) for real-time scene avg,
+    // NOT static maxFALL metadata. For static images, libplacebo defaults to
+    // knee_default (0.4) when input_avg is 0, producing the standard spline curve.
+    const float input_avg = 0.0f;
+
+    // --- st2094_pick_knee (libplacebo port, PQ space) ---
+    constexpr float knee_adaptation = 0.4f;
+    constexpr float knee_minimum    = 0.1f;
+    constexpr float knee_maximum    = 0.8f;
+    constexpr float knee_default    = 0.4f;
+
+    const float src_knee_min = input_min + knee_minimum * (input_max - input_min);
+    const float src_knee_max = input_min + knee_maximum * (input_max - input_min);
+    const float dst_knee_min = output_min + knee_minimum * (output_max - output_min);
+    const float dst_knee_max = output_min + knee_maximum * (output_max - output_min);
+
+    float src_knee;
+    float dst_knee;
+
+    if (kneeOverride > 0.0f) {
+        // Manual Static Mode: Knee is a percentage of the display peak luminance.
+        // Maintain 1:1 absolute mapping up to the knee point.
+        dst_knee = output_min + kneeOverride * (output_max - output_min);
+        src_knee = dst_knee; // 1:1 mapping in PQ space means input = output
+        
+        // Ensure we don't exceed input peak, otherwise we are stretching instead of compressing
+        if (src_knee > input_max) {
+            src_knee = input_max;
+            dst_knee = src_knee;
+        }
+    } else {
+        // Automatic Dynamic Mode (libplacebo default)
+        // Source knee from scene average brightness (clamped to safe range)
+        src_knee = (input_avg > 0.0f)
+            ? input_avg
+            : (input_min + knee_default * (input_max - input_min));
+        src_knee = std::clamp(src_knee, src_knee_min, src_knee_max);
+
+        // Target adaptation: linear rescale + perceptual weighting
+        const float target = (src_knee - input_min) / (input_max - input_min + 1e-9f);
+        const float adapted = output_min + target * (output_max - output_min);
+
+        // Increase adaptation strength near extreme knee positions
+        const float tuning = 1.0f - SplineSmoothStep(knee_maximum, knee_default, target)
+                                   * SplineSmoothStep(knee_minimum, knee_default, target);
+        const float adaptation = knee_adaptation + (1.0f - knee_adaptation) * tuning;
+        dst_knee = src_knee + (adapted - src_knee) * adaptation;
+        dst_knee = std::clamp(dst_knee, dst_knee_min, dst_knee_max);
+    }
+
+    // --- Spline slope and polynomial solve (PQ space, identical to libplacebo) ---
+    constexpr float spline_contrast = 0.5f;
+    constexpr float slope_tuning    = 1.5f;
+    constexpr float slope_offset    = 0.2f;
+
+    float slope = (dst_knee - output_min) / (src_knee - input_min + 1e-9f);
+
+    // Tune slope: closer to 1.0 when peak ratio is small, closer to linear when large
+    float ratio = input_max / (output_max + 1e-9f) - 1.0f;
+    ratio = std::clamp(slope_tuning * ratio, slope_offset, 1.0f + slope_offset);
+    slope = powf(slope, (1.0f - spline_contrast) * ratio);
+
+    // Normalize around pivot for polynomial fitting
+    const float in_min  = input_min  - src_knee;
+    const float in_max  = input_max  - src_knee;
+    const float out_min = output_min - dst_knee;
+    const float out_max = output_max - dst_knee;
+
+    // P polynomial (order 2) — shadow region
+    // P(in_min) = out_min, P'(0) = slope, P(0) = 0
+    const float Pa = (std::abs(in_min) > 1e-7f)
+        ? (out_min - slope * in_min) / (in_min * in_min) : 0.0f;
+    const float Pb = slope;
+
+    // Q polynomial (order 3) — highlight region
+    // Q(in_max) = out_max, Q''(in_max) = 0, Q(0) = 0, Q'(0) = slope
+    float Qa, Qb, Qc;
+    if (std::abs(in_max) > 1e-7f) {
+      const float t = 2.0f * in_max * in_max;
+      Qa = (slope * in_max - out_max) / (in_max * t);
+      Qb = -3.0f * (slope * in_max - out_max) / t;
+      Qc = slope;
+    } else {
+      Qa = 0.0f; Qb = 0.0f; Qc = slope;
+    }
+
+    settings.splineSrcPivot = src_knee;   // PQ space
+    settings.splineDstPivot = dst_knee;   // PQ space
+    settings.splinePa = Pa;
+    settings.splinePb = Pb;
+    settings.splineQa = Qa;
+    settings.splineQb = Qb;
+    settings.splineQc = Qc;
+
+    // Calculate mapped scene average luminance in PQ space for contrast recovery
+    float input_avg_pq = input_avg;
+    if (input_avg_pq <= 0.0f) {
+      input_avg_pq = (kneeOverride > 0.0f) ? src_knee : (input_min + knee_default * (input_max - input_min));
+    }
+    float sx = input_avg_pq - src_knee;
+    float mapped_avg;
+    if (sx > 0.0f) {
+      sx = (std::min)(sx, input_max - src_knee);
+      mapped_avg = ((Qa * sx + Qb) * sx + Qc) * sx + dst_knee;
+    } else {
+      sx = (std::max)(sx, -src_knee);
+      mapped_avg = (Pa * sx + Pb) * sx + dst_knee;
+    }
+    mapped_avg = std::clamp(mapped_avg, 0.0f, output_max);
+
+    settings.sceneAvgPq = input_avg_pq;
+    settings.mappedAvgPq = mapped_avg;
+    settings.contrastRecovery = 0.0f; // Disabled: libplacebo default is 0.0 (high_quality preset uses 0.3, video-optimized)
+}
+
+void ToneMapHdrToSdr(const uint8_t* src, int srcStride, QuickView::PixelFormat srcFormat,
+                     uint8_t* dst, int dstStride, int width, int height,
+                     const QuickView::ToneMapSettings& settings) {
+    if (!src || !dst || width <= 0 || height <= 0 || !IsToneMapSource(srcFormat)) return;
+    ToneMapRows(src, srcStride, dst, dstStride, width, height, MakeToneMapUniforms(srcFormat, settings, false));
+}
+
+void ToneMapHdrToHdr(const uint8_t* src, int srcStride, QuickView::PixelFormat srcFormat,
+                     uint16_t* dst, int dstStride, int width, int height,
+                     const QuickView::ToneMapSettings& settings) {
+    if (!src || !dst || width <= 0 || height <= 0 || !IsToneMapSource(srcFormat)) return;
+    ToneMapRows(src, srcStride, reinterpret_cast<uint8_t*>(dst), dstStride, width, height,
+                MakeToneMapUniforms(srcFormat, settings, true));
+}
+
+// Bilinear taps of a clamp-addressed sampler reading `srcSize` texels at
+// uv = (i + 0.5) / dstSize
+static void GainMapTaps(int dstSize, int srcSize, int i, int32_t& i0, int32_t& i1, float& f) {
+    const float t = (static_cast<float>(i) + 0.5f) / static_cast<float>(dstSize) * static_cast<float>(srcSize) - 0.5f;
+    const float base = std::floor(t);
+    f = t - base;
+    const int b = static_cast<int>(base);
+    i0 = std::clamp(b, 0, srcSize - 1);
+    i1 = std::clamp(b + 1, 0, srcSize - 1);
+}
+
+void ComposeGainMap(const uint8_t* sdr, int sdrStride, QuickView::PixelFormat sdrFormat,
+                    int width, int height,
+                    const uint8_t* gainMap, int gainWidth, int gainHeight, int gainStride,
+                    const QuickView::GpuShaderPayload& payload,
+                    uint16_t* dst, int dstStride) {
+    ComposeGainMapRows(sdr, sdrStride, sdrFormat, width, height, gainMap, gainWidth, gainHeight, gainStride,
+                       payload, 0, height, dst, dstStride);
+}
+
+void ComposeGainMapRows(const uint8_t* sdr, int sdrStride, QuickView::PixelFormat sdrFormat,
+                        int width, int height,
+                        const uint8_t* gainMap, int gainWidth, int gainHeight, int gainStride,
+                        const QuickView::GpuShaderPayload& payload, int rowBegin, int rowEnd,
+                        uint16_t* dst, int dstStride) {
+    if (!sdr || !gainMap || !dst || width <= 0 || height <= 0 || gainWidth <= 0 || gainHeight <= 0) return;
+    rowBegin = (std::max)(rowBegin, 0);
+    rowEnd = (std::min)(rowEnd, height);
+    if (rowBegin >= rowEnd) return;
+    const bool floatBase = sdrFormat == QuickView::PixelFormat::R32G32B32A32_FLOAT;
+    if (!floatBase && sdrFormat != QuickView::PixelFormat::BGRA8888 && sdrFormat != QuickView::PixelFormat::BGRX8888) return;
+
+    static const std::vector<float> srgbLut = [] {
+        std::vector<float> lut(256);
+        for (int i = 0; i < 256; ++i) lut[i] = SrgbToLinearScalar(static_cast<float>(i) / 255.0f);
+        return lut;
+    }();
+
+    GainMapUniforms u{};
+    u.floatBase = floatBase;
+    u.srgbLut = srgbLut.data();
+    for (int c = 0; c < 3; ++c) {
+        u.invGamma[c] = 1.0f / (std::max)(payload.gamma[c], 0.001f);
+        u.gainMin[c] = payload.gainMapMin[c];
+        u.gainSpan[c] = payload.gainMapMax[c] - payload.gainMapMin[c];
+        u.offsetSdr[c] = payload.offsetSdr[c];
+        u.offsetHdr[c] = payload.offsetHdr[c];
+    }
+    u.sharedGain = u.invGamma[0] == u.invGamma[1] && u.invGamma[0] == u.invGamma[2] &&
+                   u.gainMin[0] == u.gainMin[1] && u.gainMin[0] == u.gainMin[2] &&
+                   u.gainSpan[0] == u.gainSpan[1] && u.gainSpan[0] == u.gainSpan[2];
+    const float capRange = payload.hdrCapacityMax - payload.hdrCapacityMin;
+    u.weight = capRange > 0.001f ? std::clamp((payload.targetHeadroom - payload.hdrCapacityMin) / capRange, 0.0f, 1.0f) : 0.0f;
+    if (payload.baseIsHdr > 0.5f) u.weight = 1.0f - u.weight;
+
+    std::vector<int32_t> x0s(width), x1s(width);
+    std::vector<float> fx(width);
+    for (int x = 0; x < width; ++x) GainMapTaps(width, gainWidth, x, x0s[x], x1s[x], fx[x]);
+
+    const int rows = rowEnd - rowBegin;
+    const bool parallel = static_cast<int64_t>(width) * rows > 256 * 1024;
+    ForEachRowBand(rows, 32, parallel, [&](int y0, int y1, std::vector<uint8_t>& scratch) {
+        scratch.resize(static_cast<size_t>(gainWidth) * sizeof(float));
+        float* gainLine = reinterpret_cast<float*>(scratch.data());
+        for (int y = rowBegin + y0; y < rowBegin + y1; ++y) {
+            int32_t r0, r1;
+            float fy;
+            GainMapTaps(height, gainHeight, y, r0, r1, fy);
+            const uint8_t* row0 = gainMap + static_cast<size_t>(r0) * gainStride;
+            const uint8_t* row1 = gainMap + static_cast<size_t>(r1) * gainStride;
+            for (int x = 0; x < gainWidth; ++x) {
+                const float g0 = row0[x];
+                gainLine[x] = (g0 + (static_cast<float>(row1[x]) - g0) * fy) * (1.0f / 255.0f);
+            }
+            HWY_DYNAMIC_DISPATCH(ComposeGainMapRowImpl)(sdr + static_cast<size_t>(y) * sdrStride, gainLine,
+                                                        x0s.data(), x1s.data(), fx.data(),
+                                                        reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(dst) + static_cast<size_t>(y - rowBegin) * dstStride),
+                                                        width, u);
+        }
+    });
+}
+
 const char* GetActiveTargetName() {
     const int64_t supported = hwy::SupportedTargets();
     const int64_t best = supported & (-supported);
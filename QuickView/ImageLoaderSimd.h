@@ -4,7 +4,11 @@
 #include <cstdint>
 #include <cstddef>
 
-namespace QuickView { struct GpuShaderPayload; }
+namespace QuickView {
+struct GpuShaderPayload;
+struct ToneMapSettings;
+enum class PixelFormat : uint8_t;
+}
 
 namespace ImageLoaderSimd {
 
@@ -27,6 +31,35 @@ void ConvertRGBToBGRA(const uint8_t* src, uint8_t* dst, int width, int height, i
 void ResizeBilinear(const uint8_t* src, int srcW, int srcH, int srcStride,
                     uint8_t* dst, int dstW, int dstH, int dstStride);
 
+/// Reconstruction filter for Resize. Each widens with the downscale factor, so
+/// large reductions average every source pixel instead of sampling 2 of them.
+enum class ResampleFilter : uint8_t {
+    Box,      ///< Area average: cheapest, for LOD / master-backing layers
+    Mitchell, ///< Bicubic B=C=1/3: soft, no ringing, for on-screen fit
+    Lanczos3  ///< Windowed sinc: sharpest, for thumbnails
+};
+
+/// Separable resize of BGRA image (any scale). Fixed-point coefficient tables,
+/// SIMD horizontal and vertical passes; large outputs are split into row bands
+/// across threads. Strides of 0 mean width * 4.
+void Resize(const uint8_t* src, int srcW, int srcH, int srcStride,
+            uint8_t* dst, int dstW, int dstH, int dstStride,
+            ResampleFilter filter);
+
+/// Resize of the source rectangle (regionX, regionY, regionW, regionH) into the
+/// whole of dst. The rectangle is in source pixels and may be fractional, so a
+/// crop widened to whole pixels (e.g. a pyramid level) still lands exactly on the
+/// requested box; filter taps read the surrounding source pixels.
+void ResizeRegion(const uint8_t* src, int srcW, int srcH, int srcStride,
+                  double regionX, double regionY, double regionW, double regionH,
+                  uint8_t* dst, int dstW, int dstH, int dstStride,
+                  ResampleFilter filter);
+
+/// 2x2 box reduction of BGRA image (one mip level). dst is ceil(srcW/2) x ceil(srcH/2);
+/// an odd last column / row is averaged with itself. Strides of 0 mean width * 4.
+void Downsample2x(const uint8_t* src, int srcW, int srcH, int srcStride,
+                  uint8_t* dst, int dstStride);
+
 /// Pack 16-bit packed pixels to 8-bit pixels (taking upper 8 bits).
 void Pack16to8(const uint16_t* src, uint8_t* dst, size_t pixelCount);
 
@@ -64,6 +97,39 @@ void ComputeHistogramRowGainMap(const uint8_t* sdrRow, const uint8_t* gainMapRow
                                 uint32_t* histR, uint32_t* histG,
                                 uint32_t* histB, uint32_t* histL);
 
+/// Pixels for ComputeFrameStats: BGRA8 (optionally with an UltraHDR gain map) or
+/// R32G32B32A32_FLOAT. Float and gain-map histograms map `mapRange` to bin 255.
+struct FrameStatsSource {
+    const uint8_t* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    int stride = 0;
+    bool isFloat = false;
+    float mapRange = 1.0f;
+    const uint8_t* gainMap = nullptr; ///< 8-bit, stretched over the frame
+    int gainMapWidth = 0;
+    int gainMapHeight = 0;
+    int gainMapStride = 0;
+    const ::QuickView::GpuShaderPayload* payload = nullptr; ///< Required with gainMap
+};
+
+/// Info-panel statistics of one frame.
+struct FrameStats {
+    uint32_t histR[256] = {};
+    uint32_t histG[256] = {};
+    uint32_t histB[256] = {};
+    uint32_t histL[256] = {};
+    uint64_t pixelCount = 0; ///< Pixels in each histogram
+    uint64_t lumaSum = 0;    ///< Sum of histL luma values: mean = lumaSum / pixelCount
+    uint64_t lapSumSq = 0;   ///< Sum of squared 4-neighbour Laplacians of luma
+    uint64_t lapCount = 0;   ///< Laplacian points: variance (sharpness) = lapSumSq / lapCount
+};
+
+/// Histograms of every `step`-th row plus the Laplacian on the `step` x `step`
+/// grid, in one pass over those rows. 8-bit rows run a fused kernel with banked
+/// sub-histograms; row bands run on worker threads and are merged at the end.
+void ComputeFrameStats(const FrameStatsSource& src, int step, FrameStats* out);
+
 /// Sum luminance for a contiguous 8-bit 4-channel pixel span.
 /// Returns the sum of per-pixel luminance in 0..255 space.
 /// `isRgbaOrder=false` means BGRA/BGRX input; `true` means RGBA input.
@@ -112,6 +178,91 @@ void ToneMapClipBatchHalf(const uint16_t* src, int srcStride,
                           uint8_t* dst, int dstStride,
                           int width, int height, float exposure);
 
+// ============================================================================
+// Category C: Codec row kernels (MiniTiff, PSD composite)
+// ============================================================================
+
+/// Undo TIFF horizontal differencing (Predictor=2) on one row, in-place.
+/// `row` holds `width` pixels of `samples` interleaved samples, each `bytesPerSample`
+/// (1 or 2) bytes in file byte order. 8/16-bit with 1-4 samples run vectorized;
+/// other layouts and big-endian 16-bit data take the scalar path.
+void UndoHorizontalPredictor(uint8_t* row, int width, int samples, int bytesPerSample, bool bigEndian);
+
+/// Merge separate-plane rows (TIFF PlanarConfiguration=2) into interleaved samples.
+/// `planes[p]` holds `count` samples of `bytesPerSample` (1, 2 or 4) bytes; `dst`
+/// receives count * planeCount samples. Bytes are copied unchanged, so any sample
+/// type (integer, half, float) works. 2-4 planes run vectorized.
+void InterleavePlanes(const uint8_t* const* planes, int planeCount, int bytesPerSample,
+                      uint8_t* dst, size_t count);
+
+/// CMYK (inks, 0 = none) to opaque BGRA8: channel = (255 - ink) * (255 - K) / 255,
+/// rounded exactly. `src` holds `width` pixels of `samples` (>= 4) 8-bit samples;
+/// extra samples are ignored. 4 samples run vectorized.
+void CmykToBgra(const uint8_t* src, int samples, uint8_t* dst, int width);
+
+/// 8-bit gray to BGRA8, replicating gray into B, G and R. With `samples` >= 2 the
+/// second sample is alpha (kept straight), otherwise alpha is 255. `invert` maps
+/// v to 255 - v for TIFF WhiteIsZero; alpha is never inverted.
+void GrayToBgra(const uint8_t* src, int samples, uint8_t* dst, int width, bool invert);
+
+/// 8-bit indices to BGRA8 through a 256-entry table of packed BGRA pixels (the
+/// bytes of each entry are copied as stored). Uses gathers where available.
+void PaletteToBgra(const uint8_t* indices, const uint32_t* palette, uint8_t* dst, int width);
+
+/// Keep the 8 MSBs of `count` 16-bit samples in file byte order.
+void Narrow16To8(const uint8_t* src, uint8_t* dst, size_t count, bool bigEndian);
+
+/// Separate channel rows (PSD composite) to interleaved BGRA8. `planes` is R, G, B, A;
+/// gray passes its plane as R, G and B, and a null A plane writes 255. 8-bit samples
+/// are copied; 16-bit samples are big-endian in Photoshop's 0..32768 range and map
+/// to (min(v, 32768) * 255 + 16384) / 32768.
+void PlanarToBgra(const uint8_t* const* planes, int bytesPerSample, uint8_t* dst, int width);
+
+// ============================================================================
+// Category D: ComputeEngine tone-mapping pipeline on the CPU
+// Twins of the D3D11 shaders CSToneMap, CSToneMapHDR and CSComposeGainMap for
+// hosts without a compute device (RenderEngine fallback, SDR-target decodes,
+// headless tests). Same constant buffers, same per-pixel math; results match
+// the GPU to within its pow / exp2 precision (+-1 LSB in 8-bit output).
+// ============================================================================
+
+/// CSToneMap: RGBA source (R32G32B32A32_FLOAT, R16G16B16A16_FLOAT or _UNORM) through
+/// the full ToneMapSettings (transfer decode, exposure, spline or BT.2390 curve,
+/// contrast recovery, desaturation, colorMatrix, hue-preserving gamut map) to sRGB
+/// BGRA8 with straight alpha. Large frames are split into row bands across threads.
+void ToneMapHdrToSdr(const uint8_t* src, int srcStride, ::QuickView::PixelFormat srcFormat,
+                     uint8_t* dst, int dstStride, int width, int height,
+                     const ::QuickView::ToneMapSettings& settings);
+
+/// libplacebo pl_tone_map_spline fit for mode 0: derives the PQ-space pivots, P/Q
+/// coefficients and scene / mapped averages from contentPeakScRgb and
+/// displayPeakScRgb. kneeOverride > 0 pins the knee to that fraction of the
+/// display peak (1:1 below it); 0 picks it automatically.
+void FitSplineToneCurve(::QuickView::ToneMapSettings& settings, float kneeOverride);
+
+/// CSToneMapHDR: same sources and settings to scRGB R16G16B16A16_FLOAT (RGBA order).
+void ToneMapHdrToHdr(const uint8_t* src, int srcStride, ::QuickView::PixelFormat srcFormat,
+                     uint16_t* dst, int dstStride, int width, int height,
+                     const ::QuickView::ToneMapSettings& settings);
+
+/// CSComposeGainMap (ISO 21496-1): sRGB BGRA8 or linear R32G32B32A32_FLOAT base plus
+/// an 8-bit gain map of any size, sampled bilinearly with edge clamping, to
+/// R16G16B16A16_FLOAT (RGBA, alpha 1). The weight comes from payload.targetHeadroom;
+/// the base size is `width` x `height` (payload.sdrWidth / sdrHeight are not read).
+void ComposeGainMap(const uint8_t* sdr, int sdrStride, ::QuickView::PixelFormat sdrFormat,
+                    int width, int height,
+                    const uint8_t* gainMap, int gainWidth, int gainHeight, int gainStride,
+                    const ::QuickView::GpuShaderPayload& payload,
+                    uint16_t* dst, int dstStride);
+
+/// Rows [rowBegin, rowEnd) of ComposeGainMap, written from dst's first row on, so a
+/// large frame can be baked through a band-sized buffer. `sdr` is still the whole base.
+void ComposeGainMapRows(const uint8_t* sdr, int sdrStride, ::QuickView::PixelFormat sdrFormat,
+                        int width, int height,
+                        const uint8_t* gainMap, int gainWidth, int gainHeight, int gainStride,
+                        const ::QuickView::GpuShaderPayload& payload, int rowBegin, int rowEnd,
+                        uint16_t* dst, int dstStride);
+
 // ============================================================================
 // Runtime introspection
 // ============================================================================
@@ -9,6 +9,7 @@
 
 #include "DisplayColorInfo.h"
 #include <cstdint>
+#include <cstring>
 #include <malloc.h>
 #include <memory>
 #include <string>
@@ -235,6 +236,41 @@ struct AuxLayer {
     }
 };
 
+// Tone-mapping constant buffer (cbuffer ToneMapParams) shared by the ComputeEngine
+// shaders and their CPU twins in ImageLoaderSimd. Layout MUST match HLSL exactly.
+struct alignas(16) ToneMapSettings {
+    float contentPeakScRgb;
+    float displayPeakScRgb;
+    float paperWhiteScRgb;
+    float exposure;
+
+    float exposureGain;
+    uint32_t mode;
+    float splineSrcPivot;
+    float splineDstPivot;
+
+    float splinePa;
+    float splinePb;
+    float splineQa;
+    float splineQb;
+
+    float splineQc;
+    uint32_t isHdrOutput;           // 1: HDR/Sim, 0: SDR
+    float realHardwarePeakScRgb;    // Actual display peak in ScRGB
+    uint32_t transferFunction;      // Enum QuickView::TransferFunction
+
+    float desatThreshold;           // [v6.1.4.24] New desaturation threshold
+    float desatStrength;            // [v6.1.4.24] New desaturation strength
+    float sceneAvgPq;               // Scene average luminance in PQ space
+    float mappedAvgPq;              // Mapped scene average luminance in PQ space
+
+    float contrastRecovery;         // Contrast recovery strength (defaults to 0.30)
+    float _pad[3];                  // Keep colorMatrix 16-byte aligned
+
+    float colorMatrix[16];          // float4x4 layout: 3x3 matrix stored as 4 rows of float4 for HLSL alignment
+};
+static_assert(sizeof(ToneMapSettings) == 160, "CB must be exactly 160 bytes to match HLSL float4x4 layout");
+
 // GPU shader constant buffer payload (strict 16-byte / float4 alignment)
 // Layout MUST match HLSL cbuffer exactly. Each float3 is padded to float4.
 //
@@ -0,0 +1,648 @@
+#include "pch.h"
+#include "JpegEntryIndex.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace QuickView {
+
+namespace {
+
+using HuffTable = JpegEntryIndex::HuffTable;
+
+inline uint16_t ReadBE16(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+inline uint64_t LoadBE64(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(_MSC_VER)
+    return _byteswap_uint64(v);
+#else
+    return __builtin_bswap64(v);
+#endif
+}
+
+// Canonical Huffman codes from a DHT definition (ITU T.81 Annex C)
+bool BuildHuffTable(HuffTable& t) {
+    memset(t.lookup, 0, sizeof(t.lookup));
+    memset(t.length, 0, sizeof(t.length));
+    int k = 0;
+    uint32_t code = 0;
+    for (int len = 1; len <= 16; ++len) {
+        t.valPtr[len] = k;
+        t.minCode[len] = (int32_t)code;
+        for (int i = 0; i < t.counts[len]; ++i, ++k, ++code) {
+            const uint8_t sym = t.symbols[k];
+            t.code[sym] = (uint16_t)code;
+            t.length[sym] = (uint8_t)len;
+            if (len <= 9) {
+                const int shift = 9 - len;
+                for (uint32_t fill = 0; fill < (1u << shift); ++fill) {
+                    t.lookup[(code << shift) | fill] = (uint16_t)((len << 8) | sym);
+                }
+            }
+        }
+        if (code > (1u << len)) return false; // Over-subscribed
+        t.maxCode[len] = t.counts[len] ? (int32_t)code - 1 : -1;
+        code <<= 1;
+    }
+    t.maxCode[17] = INT32_MAX;
+    t.present = true;
+    return true;
+}
+
+// Reads the entropy-coded segment bit by bit, dropping the stuffed 0x00 after 0xFF.
+// Past `end` it feeds zeros and reports Overrun() once those are consumed.
+class StuffedBitReader {
+public:
+    StuffedBitReader(const uint8_t* data, uint64_t pos, uint64_t end)
+        : m_data(data), m_pos(pos), m_end(end) {}
+
+    void Refill() {
+        // Fast path: no 0xFF among the next 8 bytes, so they load without unstuffing
+        if (m_bits <= 56 && m_pos + 8 <= m_end) {
+            const uint64_t raw = LoadBE64(m_data + m_pos);
+            const uint64_t inv = ~raw;
+            if (((inv - 0x0101010101010101ull) & ~inv & 0x8080808080808080ull) == 0) {
+                const int n = (64 - m_bits) >> 3;
+                m_acc |= (raw & (~0ull << (64 - 8 * n))) >> m_bits;
+                m_bits += 8 * n;
+                m_pos += n;
+                m_loaded += n;
+                return;
+            }
+        }
+        while (m_bits <= 56) {
+            uint64_t b = 0;
+            if (m_pos < m_end) {
+                b = m_data[m_pos];
+                m_pos += (b == 0xFF) ? 2 : 1; // Only stuffed FF00 occurs before m_end
+                m_loaded++;
+            } else {
+                m_padding++;
+            }
+            m_acc |= b << (56 - m_bits);
+            m_bits += 8;
+        }
+    }
+
+    void EnsureBits(int n) {
+        if (m_bits < n) Refill();
+    }
+
+    uint32_t Peek(int n) const { return (uint32_t)(m_acc >> (64 - n)); }
+    void Skip(int n) { m_acc <<= n; m_bits -= n; }
+    uint32_t Read(int n) {
+        if (n == 0) return 0;
+        const uint32_t v = Peek(n);
+        Skip(n);
+        return v;
+    }
+
+    // Bits consumed since the start byte
+    uint64_t Consumed() const { return (m_loaded + m_padding) * 8 - (uint64_t)m_bits; }
+    bool Overrun() const { return Consumed() > m_loaded * 8; }
+
+private:
+    const uint8_t* m_data;
+    uint64_t m_pos;
+    uint64_t m_end;
+    uint64_t m_acc = 0;
+    int m_bits = 0;
+    uint64_t m_loaded = 0;
+    uint64_t m_padding = 0;
+};
+
+class StuffedBitWriter {
+public:
+    explicit StuffedBitWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+    // n <= 32, v has no bits above n
+    void Put(uint32_t v, int n) {
+        m_acc = (m_acc << n) | v;
+        m_bits += n;
+        while (m_bits >= 8) {
+            m_bits -= 8;
+            const uint8_t b = (uint8_t)(m_acc >> m_bits);
+            m_out.push_back(b);
+            if (b == 0xFF) m_out.push_back(0x00);
+        }
+    }
+
+    // Pads the last byte with 1-bits (T.81 F.1.2.3)
+    void Flush() {
+        if (m_bits) Put((1u << (8 - m_bits)) - 1, 8 - m_bits);
+    }
+
+private:
+    std::vector<uint8_t>& m_out;
+    uint64_t m_acc = 0;
+    int m_bits = 0;
+};
+
+// Leaves at least 16 bits buffered for the symbol's extra bits
+inline int DecodeSymbol(StuffedBitReader& br, const HuffTable& t) {
+    br.EnsureBits(32);
+    const uint16_t e = t.lookup[br.Peek(9)];
+    if (e) {
+        br.Skip(e >> 8);
+        return e & 0xFF;
+    }
+    const uint32_t bits16 = br.Peek(16);
+    for (int len = 10; len <= 16; ++len) {
+        const int32_t c = (int32_t)(bits16 >> (16 - len));
+        if (c <= t.maxCode[len]) {
+            br.Skip(len);
+            return t.symbols[t.valPtr[len] + c - t.minCode[len]];
+        }
+    }
+    return -1;
+}
+
+inline int Extend(uint32_t v, int s) {
+    return v < (1u << (s - 1)) ? (int)v - (1 << s) + 1 : (int)v;
+}
+
+inline int Category(int v) {
+    uint32_t a = (uint32_t)(v < 0 ? -v : v);
+    int c = 0;
+    while (a) { c++; a >>= 1; }
+    return c;
+}
+
+inline bool DcEncodable(const HuffTable& dc, int v) {
+    const int cat = Category(v);
+    return cat <= 11 && dc.length[cat] != 0;
+}
+
+// Entropy-only pass over one 8x8 block: returns the DC difference
+bool SkipBlock(StuffedBitReader& br, const HuffTable& dc, const HuffTable& ac, int* dcDiff) {
+    const int s = DecodeSymbol(br, dc);
+    if (s < 0 || s > 11) return false;
+    *dcDiff = s ? Extend(br.Read(s), s) : 0;
+
+    for (int k = 1; k < 64;) {
+        const int rs = DecodeSymbol(br, ac);
+        if (rs < 0) return false;
+        const int r = rs >> 4;
+        const int size = rs & 15;
+        if (size) {
+            br.Skip(size);
+            k += r + 1;
+        } else {
+            if (r != 15) break; // EOB
+            k += 16;
+        }
+        if (k > 64) return false;
+    }
+    return true;
+}
+
+// Re-emits one block, adding `dcAdjust` to its DC difference
+bool TranscodeBlock(StuffedBitReader& br, const HuffTable& dc, const HuffTable& ac, int dcAdjust,
+                    StuffedBitWriter& w) {
+    const int s = DecodeSymbol(br, dc);
+    if (s < 0 || s > 11) return false;
+    const int v = (s ? Extend(br.Read(s), s) : 0) + dcAdjust;
+    const int cat = Category(v);
+    if (cat > 11 || !dc.length[cat]) return false;
+    w.Put(dc.code[cat], dc.length[cat]);
+    if (cat) w.Put((uint32_t)(v < 0 ? v + (1 << cat) - 1 : v), cat);
+
+    for (int k = 1; k < 64;) {
+        const int rs = DecodeSymbol(br, ac);
+        if (rs < 0) return false;
+        w.Put(ac.code[rs], ac.length[rs]);
+        const int r = rs >> 4;
+        const int size = rs & 15;
+        if (size) {
+            w.Put(br.Read(size), size);
+            k += r + 1;
+        } else {
+            if (r != 15) break;
+            k += 16;
+        }
+        if (k > 64) return false;
+    }
+    return true;
+}
+
+// First marker at or after `pos` in entropy data (stuffed FF00 skipped); `size` if none
+uint64_t NextMarker(const uint8_t* data, uint64_t pos, uint64_t size) {
+    while (pos + 1 < size) {
+        const void* hit = memchr(data + pos, 0xFF, (size_t)(size - pos - 1));
+        if (!hit) return size;
+        pos = (uint64_t)((const uint8_t*)hit - data);
+        if (data[pos + 1] != 0x00) return pos;
+        pos += 2;
+    }
+    return size;
+}
+
+// Marker code at `pos` (skipping 0xFF fill bytes); *after = first byte past the marker
+uint8_t MarkerCode(const uint8_t* data, uint64_t pos, uint64_t size, uint64_t* after) {
+    uint64_t q = pos + 1;
+    while (q < size && data[q] == 0xFF) q++;
+    if (q >= size) { *after = size; return 0; }
+    *after = q + 1;
+    return data[q];
+}
+
+} // namespace
+
+// ============================================================================
+// Header parsing
+// ============================================================================
+
+std::shared_ptr<const JpegEntryIndex> JpegEntryIndex::Build(const uint8_t* data, size_t size) {
+    if (!data || size < 4) return nullptr;
+    std::shared_ptr<JpegEntryIndex> index(new JpegEntryIndex());
+    if (!ParseGuarded(index.get(), data, size)) return nullptr;
+    return index;
+}
+
+bool JpegEntryIndex::ParseGuarded(JpegEntryIndex* index, const uint8_t* data, size_t size) {
+    // Mapped files can fault (network share dropped): give up on the index, not the app
+    __try {
+        return index->Parse(data, size);
+    } __except (GetExceptionCode() == EXCEPTION_IN_PAGE_ERROR ? EXCEPTION_EXECUTE_HANDLER
+                                                               : EXCEPTION_CONTINUE_SEARCH) {
+        return false;
+    }
+}
+
+bool JpegEntryIndex::Parse(const uint8_t* data, size_t size) {
+    m_sourceSize = size;
+    if (data[0] != 0xFF || data[1] != 0xD8) return false;
+
+    struct SofComponent { uint8_t id, h, v; };
+    SofComponent sof[4] = {};
+    bool haveSof = false;
+    size_t pos = 2;
+
+    for (;;) {
+        if (pos + 4 > size || data[pos] != 0xFF) return false;
+        while (pos < size && data[pos] == 0xFF) pos++;
+        if (pos >= size) return false;
+        const uint8_t marker = data[pos++];
+
+        if (marker == 0xD8 || marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7)) continue; // Standalone
+        if (marker == 0xD9) return false; // EOI before any scan
+        if (pos + 2 > size) return false;
+        const size_t len = ReadBE16(data + pos);
+        if (len < 2 || pos + len > size) return false;
+        const uint8_t* seg = data + pos + 2;
+        const size_t segLen = len - 2;
+
+        switch (marker) {
+        case 0xC0: // Baseline
+        case 0xC1: // Extended sequential, Huffman
+        {
+            if (haveSof || segLen < 6 || seg[0] != 8) return false;
+            m_height = ReadBE16(seg + 1);
+            m_width = ReadBE16(seg + 3);
+            m_componentCount = seg[5];
+            if (m_width == 0 || m_height == 0) return false; // DNL-defined height
+            if (m_componentCount < 1 || m_componentCount > 4 || segLen < 6 + 3 * (size_t)m_componentCount) return false;
+            for (int i = 0; i < m_componentCount; ++i) {
+                sof[i].id = seg[6 + 3 * i];
+                sof[i].h = seg[7 + 3 * i] >> 4;
+                sof[i].v = seg[7 + 3 * i] & 15;
+                if (sof[i].h < 1 || sof[i].h > 4 || sof[i].v < 1 || sof[i].v > 4) return false;
+            }
+            m_sofHeightOffset = pos + 2 + 1;
+            haveSof = true;
+            break;
+        }
+        case 0xC4: // DHT
+        {
+            size_t p = 0;
+            while (p + 17 <= segLen) {
+                const int tc = seg[p] >> 4;
+                const int th = seg[p] & 15;
+                if (tc > 1 || th > 3) return false;
+                HuffTable& t = tc ? m_ac[th] : m_dc[th];
+                int total = 0;
+                for (int l = 1; l <= 16; ++l) {
+                    t.counts[l] = seg[p + l];
+                    total += t.counts[l];
+                }
+                if (total > 256 || p + 17 + total > segLen) return false;
+                memcpy(t.symbols, seg + p + 17, total);
+                if (!BuildHuffTable(t)) return false;
+                p += 17 + total;
+            }
+            break;
+        }
+        case 0xDD: // DRI
+            if (segLen < 2) return false;
+            m_restartInterval = ReadBE16(seg);
+            break;
+        case 0xDA: // SOS
+        {
+            if (!haveSof || segLen < 1) return false;
+            const int ns = seg[0];
+            if (ns != m_componentCount || segLen < 1 + 2 * (size_t)ns + 3) return false;
+            for (int i = 0; i < ns; ++i) {
+                // Scan order must follow frame order (it does for every encoder we know)
+                if (seg[1 + 2 * i] != sof[i].id) return false;
+                Component& c = m_components[i];
+                c.id = sof[i].id;
+                c.h = sof[i].h;
+                c.v = sof[i].v;
+                c.dcTable = seg[2 + 2 * i] >> 4;
+                c.acTable = seg[2 + 2 * i] & 15;
+                if (c.dcTable > 3 || c.acTable > 3 || !m_dc[c.dcTable].present || !m_ac[c.acTable].present) return false;
+            }
+            const uint8_t* spectral = seg + 1 + 2 * ns;
+            if (spectral[0] != 0 || spectral[1] != 63 || spectral[2] != 0) return false;
+            m_scanStart = pos + len;
+            goto scan;
+        }
+        default:
+            // Progressive, lossless, hierarchical and arithmetic frames are not indexed
+            if (marker >= 0xC2 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8) return false;
+            break; // APPn, DQT, COM, ...
+        }
+        pos += len;
+    }
+
+scan:
+    if (m_componentCount == 1) {
+        // Non-interleaved: one block per MCU whatever the sampling factors say
+        m_components[0].blocksPerMcu = 1;
+        m_mcuW = m_mcuH = 8;
+    } else {
+        int hMax = 1, vMax = 1, blocks = 0;
+        for (int i = 0; i < m_componentCount; ++i) {
+            Component& c = m_components[i];
+            c.blocksPerMcu = c.h * c.v;
+            blocks += c.blocksPerMcu;
+            hMax = (std::max)(hMax, (int)c.h);
+            vMax = (std::max)(vMax, (int)c.v);
+        }
+        if (blocks > 10) return false;
+        m_mcuW = 8 * hMax;
+        m_mcuH = 8 * vMax;
+    }
+    m_mcusPerRow = (m_width + m_mcuW - 1) / m_mcuW;
+    m_mcuRows = (m_height + m_mcuH - 1) / m_mcuH;
+
+    return m_restartInterval ? IndexRestartMarkers(data) : IndexHuffman(data);
+}
+
+// ============================================================================
+// Index construction
+// ============================================================================
+
+bool JpegEntryIndex::IndexRestartMarkers(const uint8_t* data) {
+    const uint64_t totalMcus = (uint64_t)m_mcusPerRow * (uint64_t)m_mcuRows;
+    const uint64_t intervals = (totalMcus + m_restartInterval - 1) / m_restartInterval;
+
+    uint64_t pos = m_scanStart;
+    for (uint32_t k = 0;; ++k) {
+        // Interval k starts at `pos`; it is an entry point when it starts an MCU row
+        const uint64_t firstMcu = (uint64_t)k * m_restartInterval;
+        if (firstMcu % (uint64_t)m_mcusPerRow == 0) {
+            EntryPoint e;
+            e.mcuRow = (uint32_t)(firstMcu / (uint64_t)m_mcusPerRow);
+            e.restartIndex = k;
+            e.byteOffset = pos;
+            m_entries.push_back(e);
+        }
+
+        const uint64_t marker = NextMarker(data, pos, m_sourceSize);
+        if (marker >= m_sourceSize) return false; // Truncated
+        uint64_t after = 0;
+        const uint8_t code = MarkerCode(data, marker, m_sourceSize, &after);
+        if (code >= 0xD0 && code <= 0xD7) {
+            if ((uint32_t)(code - 0xD0) != (k & 7) || k + 1 >= intervals) return false;
+            pos = after;
+            continue;
+        }
+        m_scanEnd = marker;
+        return code == 0xD9 && k + 1 == intervals; // Single scan, every interval present
+    }
+}
+
+bool JpegEntryIndex::IndexHuffman(const uint8_t* data) {
+    m_scanEnd = NextMarker(data, m_scanStart, m_sourceSize);
+    if (m_scanEnd >= m_sourceSize) return false;
+    uint64_t after = 0;
+    if (MarkerCode(data, m_scanEnd, m_sourceSize, &after) != 0xD9) return false; // More scans follow
+
+    StuffedBitReader br(data, m_scanStart, m_scanEnd);
+    uint64_t mapPos = m_scanStart; // Stuffed offset of unstuffed byte `mapBytes`
+    uint64_t mapBytes = 0;
+    int pred[4] = {};
+    m_entries.reserve(m_mcuRows);
+
+    for (int row = 0; row < m_mcuRows; ++row) {
+        const uint64_t consumed = br.Consumed();
+        while (mapBytes < consumed / 8) {
+            mapPos += (data[mapPos] == 0xFF) ? 2 : 1;
+            mapBytes++;
+        }
+
+        EntryPoint e;
+        e.mcuRow = (uint32_t)row;
+        e.byteOffset = mapPos;
+        e.bitOffset = (uint8_t)(consumed & 7);
+        e.dataBit = consumed;
+        for (int c = 0; c < m_componentCount; ++c) {
+            if (pred[c] < SHRT_MIN || pred[c] > SHRT_MAX) return false;
+            e.dcPred[c] = (int16_t)pred[c];
+        }
+
+        int firstDiff[4] = {};
+        for (int x = 0; x < m_mcusPerRow; ++x) {
+            for (int c = 0; c < m_componentCount; ++c) {
+                const Component& comp = m_components[c];
+                for (int b = 0; b < comp.blocksPerMcu; ++b) {
+                    int diff = 0;
+                    if (!SkipBlock(br, m_dc[comp.dcTable], m_ac[comp.acTable], &diff)) return false;
+                    if (x == 0 && b == 0) firstDiff[c] = diff;
+                    pred[c] += diff;
+                }
+            }
+        }
+        if (br.Overrun()) return false;
+
+        // The sub-JPEG restarts predictors at zero, so the row's first DC values are
+        // re-coded as absolute differences: skip rows whose category the table lacks
+        bool encodable = true;
+        for (int c = 0; c < m_componentCount; ++c) {
+            encodable = encodable && DcEncodable(m_dc[m_components[c].dcTable], e.dcPred[c] + firstDiff[c]);
+        }
+        if (encodable) m_entries.push_back(e);
+    }
+
+    while (mapPos < m_scanEnd) {
+        mapPos += (data[mapPos] == 0xFF) ? 2 : 1;
+        mapBytes++;
+    }
+    m_scanDataBits = mapBytes * 8;
+    return !m_entries.empty();
+}
+
+// ============================================================================
+// Sub-JPEG synthesis
+// ============================================================================
+
+bool JpegEntryIndex::ExtractRows(const uint8_t* data, size_t size, int y0, int y1,
+                                 std::vector<uint8_t>* out, int* firstRow) const {
+    if (!data || size != m_sourceSize || !out || !firstRow || m_entries.empty()) return false;
+    y0 = (std::max)(0, y0);
+    y1 = (std::min)(m_height, y1);
+    if (y1 <= y0) return false;
+
+    // One MCU row of context on each side keeps chroma upsampling identical to a full decode
+    const int rowFirst = (std::max)(0, y0 / m_mcuH - 1);
+    const int rowEnd = (std::min)(m_mcuRows, (y1 + m_mcuH - 1) / m_mcuH + 1);
+
+    auto byRow = [](const EntryPoint& e, uint32_t row) { return e.mcuRow < row; };
+    auto endIt = std::lower_bound(m_entries.begin(), m_entries.end(), (uint32_t)rowEnd, byRow);
+    auto fromIt = std::lower_bound(m_entries.begin(), m_entries.end(), (uint32_t)rowFirst + 1, byRow);
+    if (fromIt == m_entries.begin()) return false;
+    const EntryPoint& from = *(fromIt - 1);
+    if (from.mcuRow == 0 && endIt == m_entries.end()) return false; // Whole scan: nothing to skip
+
+    // The copy runs up to the next entry point, which can lie past rowEnd when a
+    // restart interval spans several MCU rows (or rows were not encodable): the SOF
+    // height must cover every copied row or the decoder warns about trailing data
+    const int copiedEnd = endIt != m_entries.end() ? (int)endIt->mcuRow : m_mcuRows;
+    const int firstY = (int)from.mcuRow * m_mcuH;
+    const int subHeight = (std::min)(m_height, copiedEnd * m_mcuH) - firstY;
+
+    uint64_t endOffset = m_scanEnd;
+    if (UsesRestartMarkers() && endIt != m_entries.end()) {
+        // Stop before the RST marker (and any fill bytes) that opens the end interval
+        endOffset = endIt->byteOffset - 2;
+        while (endOffset > from.byteOffset && data[endOffset - 1] == 0xFF) endOffset--;
+    }
+
+    out->clear();
+    out->reserve((size_t)(m_scanStart + (endOffset - from.byteOffset) * 9 / 8 + 64));
+    out->insert(out->end(), data, data + m_scanStart);
+    (*out)[m_sofHeightOffset] = (uint8_t)(subHeight >> 8);
+    (*out)[m_sofHeightOffset + 1] = (uint8_t)(subHeight & 0xFF);
+
+    const bool ok = UsesRestartMarkers()
+        ? CopyRestartSegments(data, from, endOffset, out)
+        : TranscodeHuffman(data, from, endIt != m_entries.end() ? endIt->dataBit : m_scanDataBits, out);
+    if (!ok) return false;
+
+    out->push_back(0xFF);
+    out->push_back(0xD9);
+    *firstRow = firstY;
+    return true;
+}
+
+bool JpegEntryIndex::CopyRestartSegments(const uint8_t* data, const EntryPoint& from, uint64_t endOffset,
+                                         std::vector<uint8_t>* out) const {
+    const size_t start = out->size();
+    out->insert(out->end(), data + from.byteOffset, data + endOffset);
+
+    // The decoder expects RST0 after the first interval: shift every marker number
+    const int shift = (int)(from.restartIndex & 7);
+    if (shift == 0) return true;
+    uint8_t* p = out->data() + start;
+    uint8_t* const end = out->data() + out->size();
+    while (p + 1 < end) {
+        p = static_cast<uint8_t*>(memchr(p, 0xFF, (size_t)(end - p - 1)));
+        if (!p) break;
+        if (p[1] >= 0xD0 && p[1] <= 0xD7) {
+            p[1] = (uint8_t)(0xD0 + ((p[1] - 0xD0 - shift) & 7));
+        }
+        p++;
+    }
+    return true;
+}
+
+bool JpegEntryIndex::TranscodeHuffman(const uint8_t* data, const EntryPoint& from, uint64_t endDataBit,
+                                      std::vector<uint8_t>* out) const {
+    StuffedBitReader br(data, from.byteOffset, m_scanEnd);
+    br.Refill();
+    br.Skip(from.bitOffset);
+    StuffedBitWriter w(*out);
+
+    // First MCU: the first block of each component carries the DC predictor
+    for (int c = 0; c < m_componentCount; ++c) {
+        const Component& comp = m_components[c];
+        for (int b = 0; b < comp.blocksPerMcu; ++b) {
+            if (!TranscodeBlock(br, m_dc[comp.dcTable], m_ac[comp.acTable], b == 0 ? from.dcPred[c] : 0, w)) {
+                return false;
+            }
+        }
+    }
+
+    // Everything after it is copied verbatim, realigned to the new byte boundary
+    const uint64_t pos = from.dataBit + (br.Consumed() - from.bitOffset);
+    if (pos > endDataBit) return false;
+    uint64_t remaining = endDataBit - pos;
+    while (remaining >= 32) {
+        br.Refill();
+        w.Put(br.Read(32), 32);
+        remaining -= 32;
+    }
+    br.Refill();
+    w.Put(br.Read((int)remaining), (int)remaining);
+    w.Flush();
+    return !br.Overrun();
+}
+
+// ============================================================================
+// Per-image cache
+// ============================================================================
+
+std::shared_ptr<const JpegEntryIndex> JpegEntryIndexCache::Acquire(size_t imageId, const uint8_t* data, size_t size) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tick++;
+        for (auto it = m_slots.begin(); it != m_slots.end();) {
+            if (it->imageId != imageId) { ++it; continue; }
+            if (it->sourceSize == size) {
+                it->lastUse = m_tick;
+                return it->building ? nullptr : it->index;
+            }
+            // Same ID, different file contents (edited on disk): stale
+            it = it->building ? it + 1 : m_slots.erase(it);
+        }
+
+        if (m_slots.size() >= CAPACITY) {
+            auto victim = m_slots.end();
+            for (auto it = m_slots.begin(); it != m_slots.end(); ++it) {
+                if (!it->building && (victim == m_slots.end() || it->lastUse < victim->lastUse)) victim = it;
+            }
+            if (victim == m_slots.end()) return nullptr; // Everything is being built
+            m_slots.erase(victim);
+        }
+        Slot slot;
+        slot.imageId = imageId;
+        slot.sourceSize = size;
+        slot.building = true;
+        slot.lastUse = m_tick;
+        m_slots.push_back(std::move(slot));
+    }
+
+    std::shared_ptr<const JpegEntryIndex> index = JpegEntryIndex::Build(data, size);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (Slot& slot : m_slots) {
+        if (slot.imageId == imageId && slot.sourceSize == size && slot.building) {
+            slot.building = false;
+            slot.index = index;
+            break;
+        }
+    }
+    return index;
+}
+
+void JpegEntryIndexCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_slots.clear();
+}
+
+} // namespace QuickView
@@ -0,0 +1,137 @@
+#pragma once
+#include "pch.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace QuickView {
+
+    // ============================================================================
+    // [Titan Perf] JPEG entry-point index (random access into a baseline scan)
+    // ============================================================================
+    // tj3SetCroppingRegion still entropy-decodes every MCU row above the crop, so a
+    // tile near the bottom of a 200 MP JPEG costs a full-image Huffman pass. The index
+    // is built once per image and records where each MCU row starts:
+    //   - Restart markers (DRI): a byte scan over the entropy data; rows that begin a
+    //     restart interval become entry points. No Huffman decoding at all.
+    //   - No restart markers: one entropy-only pass (no IDCT) records the bit offset
+    //     and the DC predictors entering every MCU row.
+    // ExtractRows() then writes a small standalone JPEG covering just the rows a tile
+    // needs (plus one MCU row of upsampling context each side): the original headers
+    // with a patched SOF height, followed by the entropy data from the entry point.
+    // Restart markers are renumbered; for Huffman entry points the first MCU is
+    // transcoded so its DC differences absorb the predictors, and the remaining bits
+    // are copied realigned to a byte boundary.
+    // Only single-scan baseline / extended Huffman 8-bit streams are indexed;
+    // progressive and arithmetic JPEGs keep the plain region decode.
+    class JpegEntryIndex {
+    public:
+        struct EntryPoint {
+            uint32_t mcuRow = 0;
+            uint32_t restartIndex = 0;  // Restart interval starting here (DRI streams)
+            uint64_t byteOffset = 0;    // Entropy byte holding the row's first bit
+            uint64_t dataBit = 0;       // Same position in unstuffed bits from the scan start
+            uint8_t bitOffset = 0;      // Bits of byteOffset already used by the previous row
+            int16_t dcPred[4] = {};     // DC predictors entering the row (Huffman streams)
+        };
+
+        // Returns nullptr when the stream cannot be indexed (see above) or is corrupt.
+        // Safe on memory-mapped input: in-page errors abort the build.
+        static std::shared_ptr<const JpegEntryIndex> Build(const uint8_t* data, size_t size);
+
+        // Writes a standalone JPEG holding image rows [y0, y1) into `out` (reusing its
+        // capacity). *firstRow receives the image row the sub-JPEG starts at; crop
+        // coordinates must be shifted up by it. Returns false when the index does not
+        // help (caller decodes the original stream).
+        bool ExtractRows(const uint8_t* data, size_t size, int y0, int y1,
+                         std::vector<uint8_t>* out, int* firstRow) const;
+
+        int Width() const { return m_width; }
+        int Height() const { return m_height; }
+        int McuHeight() const { return m_mcuH; }
+        size_t SourceSize() const { return m_sourceSize; }
+        bool UsesRestartMarkers() const { return m_restartInterval != 0; }
+        const std::vector<EntryPoint>& Entries() const { return m_entries; }
+
+        struct HuffTable {
+            bool present = false;
+            uint8_t counts[17] = {};    // counts[len], len 1..16
+            uint8_t symbols[256] = {};
+            // Decode: 9-bit lookahead ((len << 8) | symbol, 0 = longer code)
+            uint16_t lookup[512] = {};
+            int32_t maxCode[18] = {};
+            int32_t valPtr[17] = {};
+            int32_t minCode[17] = {};
+            // Encode: code / length per symbol (length 0 = not in table)
+            uint16_t code[256] = {};
+            uint8_t length[256] = {};
+        };
+
+        struct Component {
+            uint8_t id = 0;
+            uint8_t h = 1;
+            uint8_t v = 1;
+            uint8_t dcTable = 0;
+            uint8_t acTable = 0;
+            int blocksPerMcu = 1;
+        };
+
+    private:
+        JpegEntryIndex() = default;
+
+        bool Parse(const uint8_t* data, size_t size);
+        static bool ParseGuarded(JpegEntryIndex* index, const uint8_t* data, size_t size);
+        bool IndexRestartMarkers(const uint8_t* data);
+        bool IndexHuffman(const uint8_t* data);
+
+        bool CopyRestartSegments(const uint8_t* data, const EntryPoint& from, uint64_t endOffset,
+                                 std::vector<uint8_t>* out) const;
+        bool TranscodeHuffman(const uint8_t* data, const EntryPoint& from, uint64_t endDataBit,
+                              std::vector<uint8_t>* out) const;
+
+        int m_width = 0;
+        int m_height = 0;
+        int m_mcuW = 8;
+        int m_mcuH = 8;
+        int m_mcusPerRow = 0;
+        int m_mcuRows = 0;
+        int m_componentCount = 0;
+        Component m_components[4];
+        HuffTable m_dc[4];
+        HuffTable m_ac[4];
+        uint32_t m_restartInterval = 0;
+
+        size_t m_sourceSize = 0;
+        uint64_t m_sofHeightOffset = 0; // Big-endian 16-bit height field in the SOF segment
+        uint64_t m_scanStart = 0;       // First entropy byte (headers are [0, m_scanStart))
+        uint64_t m_scanEnd = 0;         // Marker ending the entropy data
+        uint64_t m_scanDataBits = 0;    // Unstuffed bits in the scan (Huffman streams)
+
+        std::vector<EntryPoint> m_entries; // Ascending mcuRow
+    };
+
+    // Per-image cache used by the Titan tile workers. The first worker to ask builds
+    // the index; workers asking meanwhile get nullptr and use the plain region decode.
+    class JpegEntryIndexCache {
+    public:
+        std::shared_ptr<const JpegEntryIndex> Acquire(size_t imageId, const uint8_t* data, size_t size);
+        void Clear();
+
+        static constexpr size_t CAPACITY = 4;
+
+    private:
+        struct Slot {
+            size_t imageId = 0;
+            size_t sourceSize = 0;
+            bool building = false;
+            std::shared_ptr<const JpegEntryIndex> index; // nullptr after a build: not indexable
+            uint64_t lastUse = 0;
+        };
+
+        std::mutex m_mutex;
+        std::vector<Slot> m_slots;
+        uint64_t m_tick = 0;
+    };
+
+} // namespace QuickView
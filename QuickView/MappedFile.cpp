@@ -0,0 +1,217 @@
+#include "pch.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <new>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <filesystem>
+#endif
+
+namespace QuickView {
+
+MappedFile::MappedFile(const std::wstring& path, LoadMode mode, AsyncFileReader* reader) : m_path(path) {
+    if (mode == LoadMode::Blocking) {
+        Open(mode, nullptr);
+        return;
+    }
+    std::vector<AsyncReadRequest> batch;
+    Open(mode, &batch);
+    if (!batch.empty()) (reader ? *reader : AsyncFileReader::Shared()).Submit(batch.data(), batch.size());
+}
+
+MappedFile::MappedFile(const std::wstring& path, std::vector<AsyncReadRequest>& batch) : m_path(path) {
+    Open(LoadMode::Async, &batch);
+}
+
+void MappedFile::Open(LoadMode mode, std::vector<AsyncReadRequest>* batch) {
+#ifdef _WIN32
+    // [BugFix] Support FILE_SHARE_DELETE so that background/temporary files deleted by
+    // the sending processes don't trigger access denied during open.
+    m_hFile = CreateFileW(m_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_hFile == INVALID_HANDLE_VALUE) return; // Invalid
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_hFile, &size)) return;
+    m_size = (size_t)size.QuadPart;
+#else
+    m_hFile = open(std::filesystem::path(m_path).c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_hFile < 0) return; // Invalid
+
+    struct stat st;
+    if (fstat(m_hFile, &st) != 0) return;
+    m_size = (size_t)st.st_size;
+#endif
+    if (m_size == 0) return;
+
+    // [Stability Optimization] For files under 128MB (99.9% of normal PNGs/JPEGs),
+    // we load them entirely into memory to prevent STATUS_IN_PAGE_ERROR (0xc0000006)
+    // caused by asynchronous file locking/deletion by antivirus, DLP or compressor software.
+    if (m_size < kBufferedLimit) {
+        m_buffer.reset(new (std::nothrow) uint8_t[m_size]);
+        if (!m_buffer) {
+            m_size = 0;
+            return;
+        }
+
+        if (mode == LoadMode::Async && batch) {
+            m_ptr = m_buffer.get();
+            QueueChunks(*batch);
+            return;
+        }
+
+        if (ReadFileAt(m_hFile, 0, m_buffer.get(), m_size) == m_size) {
+            m_ptr = m_buffer.get();
+            m_available.store(m_size, std::memory_order_release);
+        } else {
+            m_buffer.reset();
+            m_size = 0;
+        }
+        return;
+    }
+
+    // For massive files (>128MB), map them to preserve address space & RAM
+#ifdef _WIN32
+    m_hMap = CreateFileMappingW(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_hMap) {
+        m_ptr = static_cast<const uint8_t*>(MapViewOfFile(m_hMap, FILE_MAP_READ, 0, 0, 0));
+    }
+#else
+    void* view = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_hFile, 0);
+    if (view != MAP_FAILED) m_ptr = static_cast<const uint8_t*>(view);
+#endif
+    m_mapped = m_ptr != nullptr;
+    if (m_mapped) m_available.store(m_size, std::memory_order_release);
+}
+
+MappedFile::~MappedFile() {
+    {
+        std::unique_lock lock(m_asyncMutex);
+        m_asyncCv.wait(lock, [&] { return m_inFlight == 0; });
+    }
+#ifdef _WIN32
+    if (m_mapped) UnmapViewOfFile(m_ptr);
+    if (m_hMap) CloseHandle(m_hMap);
+    if (m_hFile != INVALID_HANDLE_VALUE) CloseHandle(m_hFile);
+#else
+    if (m_mapped) munmap(const_cast<uint8_t*>(m_ptr), m_size);
+    if (m_hFile >= 0) close(m_hFile);
+#endif
+}
+
+// ============================================================================
+// Async fill
+// ============================================================================
+// Chunk 0 is kHeadChunk so format sniffing and header parsing can start after one
+// small read; the rest are kChunkSize. Chunks complete in any order; the watermark
+// only advances over a contiguous done prefix.
+
+size_t MappedFile::ChunkIndex(uint64_t offset) const {
+    return offset == 0 ? 0 : 1 + (size_t)((offset - kHeadChunk) / kChunkSize);
+}
+
+void MappedFile::QueueChunks(std::vector<AsyncReadRequest>& out) {
+    const size_t count = m_size <= kHeadChunk ? 1 : 1 + (m_size - kHeadChunk + kChunkSize - 1) / kChunkSize;
+    m_chunkDone.assign(count, 0);
+    m_inFlight = count;
+
+    for (size_t i = 0; i < count; ++i) {
+        AsyncReadRequest req;
+        req.file = m_hFile;
+        req.offset = i == 0 ? 0 : kHeadChunk + (i - 1) * kChunkSize;
+        req.length = (std::min)(m_size - (size_t)req.offset, i == 0 ? kHeadChunk : kChunkSize);
+        req.dst = m_buffer.get() + req.offset;
+        req.onComplete = &MappedFile::OnChunkRead;
+        req.ctx = this;
+        out.push_back(req);
+    }
+}
+
+void MappedFile::OnChunkRead(void* ctx, const AsyncReadRequest& req, size_t bytesRead) {
+    auto* self = static_cast<MappedFile*>(ctx);
+    std::lock_guard lock(self->m_asyncMutex);
+    if (bytesRead < req.length) {
+        // File truncated or unreadable underneath us: same outcome as a failed blocking read
+        self->m_readError.store(true, std::memory_order_release);
+    } else {
+        self->m_chunkDone[self->ChunkIndex(req.offset)] = 1;
+        size_t available = self->m_available.load(std::memory_order_relaxed);
+        while (self->m_nextChunk < self->m_chunkDone.size() && self->m_chunkDone[self->m_nextChunk]) {
+            const size_t next = ++self->m_nextChunk;
+            available = next == self->m_chunkDone.size() ? self->m_size : kHeadChunk + (next - 1) * kChunkSize;
+        }
+        self->m_available.store(available, std::memory_order_release);
+    }
+    --self->m_inFlight;
+    self->m_asyncCv.notify_all(); // Under the lock: the destructor may run as soon as we release it
+}
+
+size_t MappedFile::WaitForBytes(size_t bytes) const {
+    const size_t target = (std::min)(bytes, m_size);
+    size_t available = BytesAvailable();
+    if (available >= target || !m_ptr) return available;
+
+    std::unique_lock lock(m_asyncMutex);
+    m_asyncCv.wait(lock, [&] { return BytesAvailable() >= target || HasReadError() || m_inFlight == 0; });
+    return BytesAvailable();
+}
+
+const uint8_t* MappedFile::data() const {
+    if (!m_ptr) return nullptr;
+    if (BytesAvailable() == m_size) return m_ptr;
+    return WaitForBytes(m_size) == m_size ? m_ptr : nullptr;
+}
+
+std::vector<std::shared_ptr<MappedFile>> MappedFile::OpenReadahead(const std::vector<std::wstring>& paths, AsyncFileReader& reader) {
+    std::vector<std::shared_ptr<MappedFile>> files;
+    std::vector<AsyncReadRequest> batch;
+    files.reserve(paths.size());
+    for (const auto& path : paths) {
+        std::shared_ptr<MappedFile> file(new MappedFile(path, batch));
+        if (!file->IsOpen()) file.reset();
+        files.push_back(std::move(file));
+    }
+    reader.Submit(batch.data(), batch.size());
+    return files;
+}
+
+void MappedFile::Prefetch(size_t offset, size_t length) {
+    // Buffered files are already in memory (or on their way there): no-op
+    if (!m_mapped) return;
+
+    if (!m_ptr || m_size == 0) return;
+    if (offset >= m_size) return;
+
+    size_t validLen = length;
+    if (offset + validLen > m_size) validLen = m_size - offset;
+
+#ifdef _WIN32
+    // Define function pointer type for PrefetchVirtualMemory
+    typedef BOOL (WINAPI *PfnPrefetchVirtualMemory)(HANDLE, ULONG_PTR, PWIN32_MEMORY_RANGE_ENTRY, ULONG);
+
+    static PfnPrefetchVirtualMemory pPrefetch = []() -> PfnPrefetchVirtualMemory {
+        HMODULE hKernel = GetModuleHandleW(L"kernel32.dll");
+        if (hKernel) {
+            return (PfnPrefetchVirtualMemory)GetProcAddress(hKernel, "PrefetchVirtualMemory");
+        }
+        return nullptr;
+    }();
+
+    if (pPrefetch) {
+        WIN32_MEMORY_RANGE_ENTRY entry;
+        entry.VirtualAddress = (void*)(m_ptr + offset);
+        entry.NumberOfBytes = validLen;
+        pPrefetch(GetCurrentProcess(), 1, &entry, 0);
+    }
+#else
+    const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t begin = offset & ~(page - 1);
+    madvise(const_cast<uint8_t*>(m_ptr) + begin, offset + validLen - begin, MADV_WILLNEED);
+#endif
+}
+
+} // namespace QuickView
@@ -1,9 +1,12 @@
 #pragma once
-#include "pch.h"
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <cstdint>
 #include <vector>
+#include "AsyncFileReader.h"
 
 namespace QuickView {
 
@@ -12,94 +15,77 @@ namespace QuickView {
     // ============================================================================
     // Encapsulates Windows Memory Mapped Files for safe, zero-copy read access.
     // Throws std::runtime_error on failure (construction).
+    //
+    // [Readahead] LoadMode::Async returns as soon as the file is open: the buffer is
+    // filled in chunks by an AsyncFileReader and BytesAvailable() is a contiguous
+    // watermark from offset 0. Streaming decoders read PartialData() up to the
+    // watermark; data() / IsValid() wait for the whole file, so existing callers keep
+    // working unchanged. Mapped files (>= 128MB) are the same in both modes.
     class MappedFile {
     public:
-        MappedFile(const std::wstring& path) : m_path(path) {
-            // [BugFix] Support FILE_SHARE_DELETE so that background/temporary files deleted by 
-            // the sending processes don't trigger access denied during open.
-            m_hFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
-            if (m_hFile == INVALID_HANDLE_VALUE) return; // Invalid
+        enum class LoadMode { Blocking, Async };
 
-            LARGE_INTEGER size;
-            if (!GetFileSizeEx(m_hFile, &size)) return;
-            m_size = (size_t)size.QuadPart;
+        static constexpr size_t kBufferedLimit = 128 * 1024 * 1024;
+        static constexpr size_t kHeadChunk = 64 * 1024;   // Header parsers get this first
+        static constexpr size_t kChunkSize = 1024 * 1024; // Then 1MB per request
 
-            if (m_size > 0) {
-                // [Stability Optimization] For files under 128MB (99.9% of normal PNGs/JPEGs),
-                // we load them entirely into memory vector to prevent STATUS_IN_PAGE_ERROR (0xc0000006) 
-                // caused by asynchronous file locking/deletion by antivirus, DLP or compressor software.
-                if (m_size < 128 * 1024 * 1024) {
-                    m_buffer.resize(m_size);
-                    DWORD bytesRead = 0;
-                    if (ReadFile(m_hFile, m_buffer.data(), (DWORD)m_size, &bytesRead, nullptr) && bytesRead == m_size) {
-                        m_ptr = m_buffer.data();
-                    } else {
-                        m_buffer.clear();
-                        m_size = 0;
-                        m_ptr = nullptr;
-                    }
-                } else {
-                    // For massive files (>128MB), map them to preserve address space & RAM
-                    m_hMap = CreateFileMappingW(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
-                    if (m_hMap) {
-                        m_ptr = static_cast<const uint8_t*>(MapViewOfFile(m_hMap, FILE_MAP_READ, 0, 0, 0));
-                    }
-                }
-            }
-        }
-
-        ~MappedFile() {
-            if (m_ptr && m_buffer.empty()) UnmapViewOfFile(m_ptr);
-            if (m_hMap) CloseHandle(m_hMap);
-            if (m_hFile != INVALID_HANDLE_VALUE) CloseHandle(m_hFile);
-        }
+        // reader == nullptr in Async mode uses AsyncFileReader::Shared()
+        explicit MappedFile(const std::wstring& path, LoadMode mode = LoadMode::Blocking, AsyncFileReader* reader = nullptr);
+        ~MappedFile(); // Waits for in-flight chunk reads
 
         // Disable Copy
         MappedFile(const MappedFile&) = delete;
         MappedFile& operator=(const MappedFile&) = delete;
 
-        bool IsValid() const { return m_ptr != nullptr; }
-        const uint8_t* data() const { return m_ptr; }
+        // Opens every file and submits all their chunks as one batch (one
+        // io_uring_enter). Files that fail to open come back as nullptr.
+        static std::vector<std::shared_ptr<MappedFile>> OpenReadahead(const std::vector<std::wstring>& paths, AsyncFileReader& reader);
+
+        bool IsValid() const { return data() != nullptr; }
+        const uint8_t* data() const;
         size_t size() const { return m_size; }
         const std::wstring& GetPath() const { return m_path; }
 
-    public:
-        void Prefetch(size_t offset, size_t length) {
-            // If already fully in memory, prefetch is a no-op
-            if (!m_buffer.empty()) return;
-            
-            if (!m_ptr || m_size == 0) return;
-            if (offset >= m_size) return;
-            
-            size_t validLen = length;
-            if (offset + validLen > m_size) validLen = m_size - offset;
+        // --- Streaming access (never blocks except WaitForBytes) ---
+        bool IsOpen() const { return m_ptr != nullptr; }
+        // Read into a private buffer (< kBufferedLimit) rather than mapped
+        bool IsBuffered() const { return IsOpen() && !m_mapped; }
+        bool IsComplete() const { return BytesAvailable() == m_size || HasReadError(); }
+        bool HasReadError() const { return m_readError.load(std::memory_order_acquire); }
+        size_t BytesAvailable() const { return m_available.load(std::memory_order_acquire); }
+        // Blocks until min(bytes, size()) are available or a read fails; returns the watermark
+        size_t WaitForBytes(size_t bytes) const;
+        // Valid up to BytesAvailable(); the rest is still being written
+        const uint8_t* PartialData() const { return m_ptr; }
 
-            // Define function pointer type for PrefetchVirtualMemory
-            typedef BOOL (WINAPI *PfnPrefetchVirtualMemory)(HANDLE, ULONG_PTR, PWIN32_MEMORY_RANGE_ENTRY, ULONG);
-            
-            static PfnPrefetchVirtualMemory pPrefetch = []() -> PfnPrefetchVirtualMemory {
-                HMODULE hKernel = GetModuleHandleW(L"kernel32.dll");
-                if (hKernel) {
-                    return (PfnPrefetchVirtualMemory)GetProcAddress(hKernel, "PrefetchVirtualMemory");
-                }
-                return nullptr;
-            }();
+    public:
+        void Prefetch(size_t offset, size_t length);
 
-            if (pPrefetch) {
-                WIN32_MEMORY_RANGE_ENTRY entry;
-                entry.VirtualAddress = (void*)(m_ptr + offset);
-                entry.NumberOfBytes = validLen;
-                pPrefetch(GetCurrentProcess(), 1, &entry, 0);
-            }
-        }
-        
     private:
-        HANDLE m_hFile = INVALID_HANDLE_VALUE;
+        MappedFile(const std::wstring& path, std::vector<AsyncReadRequest>& batch);
+        void Open(LoadMode mode, std::vector<AsyncReadRequest>* batch);
+        void QueueChunks(std::vector<AsyncReadRequest>& out);
+        size_t ChunkIndex(uint64_t offset) const;
+        static void OnChunkRead(void* ctx, const AsyncReadRequest& req, size_t bytesRead);
+
+        NativeFileHandle m_hFile = kInvalidFileHandle;
+#ifdef _WIN32
         HANDLE m_hMap = nullptr;
+#endif
+        bool m_mapped = false;
         const uint8_t* m_ptr = nullptr;
         size_t m_size = 0;
         std::wstring m_path;
-        std::vector<uint8_t> m_buffer; // Buffered content for small files
+        std::unique_ptr<uint8_t[]> m_buffer; // Buffered content for small files
+
+        // Async fill state. m_chunkDone / m_inFlight are guarded by m_asyncMutex.
+        std::atomic<size_t> m_available{0};
+        std::atomic<bool> m_readError{false};
+        mutable std::mutex m_asyncMutex;
+        mutable std::condition_variable m_asyncCv;
+        std::vector<uint8_t> m_chunkDone;
+        size_t m_nextChunk = 0; // First chunk not yet below the watermark
+        size_t m_inFlight = 0;
     };
 
 } // namespace QuickView
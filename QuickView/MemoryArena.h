@@ -1,13 +1,15 @@
 #pragma once
-#include "pch.h"
 #include <atomic>
 #include <mutex>
 #include <cstdint>
 #include <memory>
+#include <algorithm>
+#include <thread>
+#include <vector>
 
 #include <cstdlib>
 #include <stdexcept>
-#include <windows.h>
+#include "VirtualMemory.h"
 
 // ============================================================================
 // QuantumArena - Quantum Stream architecture core memory pool
@@ -19,6 +21,7 @@
 //   4. Lock-free design - single-thread exclusive use (dedicated for HeavyLane)
 //   5. Overflow protection - ultra-large images automatically overflow to system heap
 //   6. Dynamic on-demand commit - reserve huge address space, commit as much as needed, release physical memory when idle
+//   7. Portable - page operations go through QuickView::VM (VirtualAlloc on Windows, mmap/mprotect/madvise on POSIX)
 // ============================================================================
 
 class QuantumArena;
@@ -30,18 +33,23 @@ public:
     static constexpr size_t DEFAULT_SIZE = 512 * 1024 * 1024;
     static constexpr size_t ALIGNMENT = 64; // Cache Line
 
-    QuantumArena(size_t capacity = DEFAULT_SIZE) 
+    // 1MB commit granularity, balancing performance and memory footprint
+    // (raised to the huge page size when the arena is huge-page backed)
+    static constexpr size_t COMMIT_CHUNK = 1024 * 1024;
+
+    using HugePages = QuickView::VM::HugePages;
+
+    QuantumArena(size_t capacity = DEFAULT_SIZE, HugePages hugePages = HugePages::Off) 
         : m_capacity(capacity) 
+        , m_hugePagesRequested(hugePages)
     {
         // Lazy initialization - constructor does not allocate memory
     }
 
     ~QuantumArena() {
         FreeOverflows();
-        if (m_buffer) {
-            VirtualFree(m_buffer, 0, MEM_RELEASE);
-            m_buffer = nullptr;
-        }
+        QuickView::VM::Release(m_reservation);
+        m_buffer = nullptr;
     }
 
     // Copy constructor and assignment disabled
@@ -51,13 +59,16 @@ public:
     // Move constructor and assignment enabled
     QuantumArena(QuantumArena&& other) noexcept 
         : m_buffer(other.m_buffer)
+        , m_reservation(other.m_reservation)
         , m_capacity(other.m_capacity)
+        , m_hugePagesRequested(other.m_hugePagesRequested)
         , m_committed(other.m_committed.load())
         , m_offset(other.m_offset.load())
         , m_peakUsage(other.m_peakUsage.load())
         , m_overflowHead(other.m_overflowHead)
     {
         other.m_buffer = nullptr;
+        other.m_reservation = QuickView::VM::Reservation{};
         other.m_capacity = 0;
         other.m_committed = 0;
         other.m_offset = 0;
@@ -77,28 +88,89 @@ public:
     /// </summary>
     void Reset() noexcept {
         FreeOverflows();
+        if (m_buffer) {
+            // Everything below the old offset was written, so it is resident now
+            std::lock_guard<std::mutex> lock(m_commitMutex);
+            size_t used = (std::min)(m_offset.load(std::memory_order_relaxed), m_committed.load(std::memory_order_relaxed));
+            m_faultedBytes = (std::max)(m_faultedBytes, used);
+        }
         m_offset = 0;
         if (ShouldShrinkMemory()) {
-            Shrink(); // Return free physical memory
+            ShrinkToRetained(); // Return free physical memory beyond the working set
         }
+        CloseTelemetryCycle();
     }
 
     /// <summary>
     /// Shrink memory - decommit unused reserved memory, returning it to the OS
+    /// (ignores the retained working set; used by explicit reclaim)
     /// </summary>
     void Shrink() noexcept {
-        if (!m_buffer) return;
-        size_t used = m_offset.load(std::memory_order_relaxed);
-        // Align to 4KB page size
-        size_t keepSize = (used + 4095) & ~4095;
-        if (keepSize < m_committed) {
-            std::lock_guard<std::mutex> lock(m_commitMutex);
-            if (keepSize < m_committed) {
-                size_t decommitSize = m_committed - keepSize;
-                VirtualFree(m_buffer + keepSize, decommitSize, MEM_DECOMMIT);
-                m_committed = keepSize;
+        ShrinkTo(0);
+    }
+
+    /// <summary>
+    /// Working set kept committed through Reset() even when ShouldShrinkMemory() (see ArenaWorkingSet)
+    /// </summary>
+    void SetRetainBytes(size_t bytes) noexcept { m_retainBytes.store(bytes, std::memory_order_relaxed); }
+    size_t GetRetainBytes() const noexcept { return m_retainBytes.load(std::memory_order_relaxed); }
+
+    /// <summary>
+    /// Shrink down to the retained working set. Hysteresis: nothing is decommitted until the
+    /// commit exceeds the working set by 25%, so a slightly larger image does not cause a
+    /// decommit/recommit pair on every navigation.
+    /// </summary>
+    void ShrinkToRetained() noexcept {
+        const size_t retain = m_retainBytes.load(std::memory_order_relaxed);
+        if (retain && m_committed.load(std::memory_order_relaxed) <= retain + retain / 4) return;
+        ShrinkTo(retain);
+    }
+
+    /// <summary>
+    /// Pre-commit the arena up to `bytes` before a decode whose output size is known from the
+    /// header, so the decoder never stops at the commit mutex. With faultThreads > 0 the pages
+    /// are also touched up front, split across that many threads (1 = calling thread), moving
+    /// the soft faults off the decode path. Pages known to be resident are skipped.
+    /// Returns the bytes committed ahead of use.
+    /// </summary>
+    size_t Precommit(size_t bytes, int faultThreads = 0) noexcept {
+        EnsureInitialized();
+        if (!m_buffer || bytes == 0) return 0;
+        if (bytes > m_capacity) bytes = m_capacity;
+        if (bytes > m_committed && !CommitUpTo(bytes)) return 0;
+        if (faultThreads <= 0) return bytes;
+
+        // Held while touching: Shrink() must not decommit pages under the fault threads
+        std::lock_guard<std::mutex> lock(m_commitMutex);
+        const size_t page = QuickView::VM::PageSize();
+        const size_t begin = (m_faultedBytes + page - 1) & ~(page - 1);
+        const size_t end = (std::min)(bytes, m_committed.load(std::memory_order_relaxed));
+        if (begin >= end) return bytes;
+
+        // At least 16MB per thread; below that, thread start-up costs more than it saves
+        constexpr size_t kMinSlice = 16 * 1024 * 1024;
+        const size_t span = end - begin;
+        size_t threads = (std::min)((size_t)faultThreads, (span + kMinSlice - 1) / kMinSlice);
+        const size_t slice = ((span / threads) + page - 1) & ~(page - 1);
+
+        std::vector<std::thread> helpers;
+        size_t inlineBegin = begin;
+        for (size_t t = 1; t < threads; ++t) {
+            const size_t sBegin = begin + (t - 1) * slice;
+            const size_t sEnd = (std::min)(sBegin + slice, end);
+            try {
+                helpers.emplace_back([p = m_buffer + sBegin, n = sEnd - sBegin] { QuickView::VM::Prefault(p, n); });
+            } catch (...) {
+                break; // Finish the rest on this thread
             }
+            inlineBegin = sEnd;
         }
+        QuickView::VM::Prefault(m_buffer + inlineBegin, end - inlineBegin);
+        for (auto& h : helpers) h.join();
+
+        m_faultedBytes = end;
+        m_prefaultBytes.fetch_add(span, std::memory_order_relaxed);
+        return bytes;
     }
 
     /// <summary>
@@ -120,21 +192,9 @@ public:
             return AllocateOverflow(size, alignment);
         }
 
-        // Dynamically commit physical memory on demand (MEM_COMMIT)
-        if (newOffset > m_committed) {
-            std::lock_guard<std::mutex> lock(m_commitMutex);
-            if (newOffset > m_committed) {
-                size_t chunk = 1024 * 1024; // 1MB commit granularity, balancing performance and memory footprint
-                size_t targetCommit = (newOffset + chunk - 1) & ~(chunk - 1);
-                if (targetCommit > m_capacity) targetCommit = m_capacity;
-
-                size_t commitSize = targetCommit - m_committed;
-                void* res = VirtualAlloc(m_buffer + m_committed, commitSize, MEM_COMMIT, PAGE_READWRITE);
-                if (!res) {
-                    return AllocateOverflow(size, alignment);
-                }
-                m_committed = targetCommit;
-            }
+        // Dynamically commit physical memory on demand
+        if (newOffset > m_committed && !CommitUpTo(newOffset)) {
+            return AllocateOverflow(size, alignment);
         }
 
         // CAS update (although designed for single-thread, keep atomic just in case)
@@ -148,25 +208,15 @@ public:
                 return AllocateOverflow(size, alignment);
             }
             
-            if (newOffset > m_committed) {
-                std::lock_guard<std::mutex> lock(m_commitMutex);
-                if (newOffset > m_committed) {
-                    size_t chunk = 1024 * 1024;
-                    size_t targetCommit = (newOffset + chunk - 1) & ~(chunk - 1);
-                    if (targetCommit > m_capacity) targetCommit = m_capacity;
-                    size_t commitSize = targetCommit - m_committed;
-                    void* res = VirtualAlloc(m_buffer + m_committed, commitSize, MEM_COMMIT, PAGE_READWRITE);
-                    if (!res) {
-                        return AllocateOverflow(size, alignment);
-                    }
-                    m_committed = targetCommit;
-                }
+            if (newOffset > m_committed && !CommitUpTo(newOffset)) {
+                return AllocateOverflow(size, alignment);
             }
         }
 
         // Update peak stats
         size_t peak = m_peakUsage.load(std::memory_order_relaxed);
         while (newOffset > peak && !m_peakUsage.compare_exchange_weak(peak, newOffset));
+        m_allocCount.fetch_add(1, std::memory_order_relaxed);
 
         return m_buffer + aligned;
     }
@@ -200,16 +250,121 @@ public:
         return used < m_capacity ? m_capacity - used : 0; 
     }
     bool IsInitialized() const noexcept { return m_buffer != nullptr; }
+    size_t GetCommittedBytes() const noexcept { return m_committed.load(std::memory_order_relaxed); }
+    // Mode actually obtained from the OS (Off until the first allocation reserves)
+    HugePages GetHugePages() const noexcept { return m_reservation.hugePages; }
+    size_t GetAllocationCount() const noexcept { return m_allocCount.load(std::memory_order_relaxed); }
+    size_t GetOverflowCount() const noexcept { return m_overflowCount.load(std::memory_order_relaxed); }
+
+    /// <summary>
+    /// Commit/decommit activity. A cycle runs from one Reset() to the next, i.e. one decode.
+    /// Page faults are process-wide deltas over the cycle, so they are exact only while this
+    /// arena's owner is the only thread touching fresh memory (benchmarks, idle UI).
+    /// </summary>
+    struct Telemetry {
+        uint64_t resetCycles = 0;
+        uint64_t commitCalls = 0;       // Lifetime totals
+        uint64_t decommitCalls = 0;
+        uint64_t prefaultBytes = 0;     // Touched ahead of use by Precommit()
+        uint64_t committedBytes = 0;    // Current
+        // Last completed cycle
+        uint64_t cycleCommitCalls = 0;
+        uint64_t cycleDecommitCalls = 0;
+        uint64_t cycleCommitBytes = 0;
+        uint64_t cycleDecommitBytes = 0;
+        uint64_t cyclePageFaults = 0;
+    };
+
+    Telemetry GetTelemetry() const noexcept {
+        Telemetry t;
+        t.resetCycles = m_resetCycles.load(std::memory_order_relaxed);
+        t.commitCalls = m_commitCalls.load(std::memory_order_relaxed);
+        t.decommitCalls = m_decommitCalls.load(std::memory_order_relaxed);
+        t.prefaultBytes = m_prefaultBytes.load(std::memory_order_relaxed);
+        t.committedBytes = m_committed.load(std::memory_order_relaxed);
+        t.cycleCommitCalls = m_lastCycle.commitCalls.load(std::memory_order_relaxed);
+        t.cycleDecommitCalls = m_lastCycle.decommitCalls.load(std::memory_order_relaxed);
+        t.cycleCommitBytes = m_lastCycle.commitBytes.load(std::memory_order_relaxed);
+        t.cycleDecommitBytes = m_lastCycle.decommitBytes.load(std::memory_order_relaxed);
+        t.cyclePageFaults = m_lastCycle.pageFaults.load(std::memory_order_relaxed);
+        return t;
+    }
+
+    /// <summary>
+    /// Reset peak/allocation counters (used by benchmarks to measure a single decode)
+    /// </summary>
+    void ResetStatistics() noexcept {
+        m_peakUsage.store(m_offset.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        m_allocCount.store(0, std::memory_order_relaxed);
+        m_overflowCount.store(0, std::memory_order_relaxed);
+    }
 
 private:
+    void ShrinkTo(size_t keepBytes) noexcept {
+        if (!m_buffer) return;
+        size_t used = (std::max)(m_offset.load(std::memory_order_relaxed), keepBytes);
+        // Align to commit granularity (4KB page, or 2MB when huge-page backed)
+        const size_t granularity = m_reservation.commitGranularity;
+        size_t keepSize = (used + granularity - 1) & ~(granularity - 1);
+        if (keepSize < m_committed) {
+            std::lock_guard<std::mutex> lock(m_commitMutex);
+            if (keepSize < m_committed) {
+                size_t decommitSize = m_committed - keepSize;
+                QuickView::VM::Decommit(m_buffer + keepSize, decommitSize);
+                m_committed = keepSize;
+                m_faultedBytes = (std::min)(m_faultedBytes, keepSize);
+                m_decommitCalls.fetch_add(1, std::memory_order_relaxed);
+                m_decommitBytes.fetch_add(decommitSize, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Caller saw newOffset > m_committed. Returns false if the OS refused the commit.
+    bool CommitUpTo(size_t newOffset) noexcept {
+        std::lock_guard<std::mutex> lock(m_commitMutex);
+        if (newOffset <= m_committed) return true;
+
+        size_t chunk = (std::max)(COMMIT_CHUNK, m_reservation.commitGranularity);
+        size_t targetCommit = (newOffset + chunk - 1) & ~(chunk - 1);
+        if (targetCommit > m_reservation.size) targetCommit = m_reservation.size;
+
+        size_t commitSize = targetCommit - m_committed;
+        if (!QuickView::VM::Commit(m_buffer + m_committed, commitSize)) {
+            return false;
+        }
+        m_committed = targetCommit;
+        m_commitCalls.fetch_add(1, std::memory_order_relaxed);
+        m_commitBytes.fetch_add(commitSize, std::memory_order_relaxed);
+        return true;
+    }
+
+    void CloseTelemetryCycle() noexcept {
+        const uint64_t faults = QuickView::VM::ProcessPageFaults();
+        const uint64_t commits = m_commitCalls.load(std::memory_order_relaxed);
+        const uint64_t decommits = m_decommitCalls.load(std::memory_order_relaxed);
+        const uint64_t commitBytes = m_commitBytes.load(std::memory_order_relaxed);
+        const uint64_t decommitBytes = m_decommitBytes.load(std::memory_order_relaxed);
+
+        m_lastCycle.commitCalls.store(commits - m_cycleStart.commitCalls, std::memory_order_relaxed);
+        m_lastCycle.decommitCalls.store(decommits - m_cycleStart.decommitCalls, std::memory_order_relaxed);
+        m_lastCycle.commitBytes.store(commitBytes - m_cycleStart.commitBytes, std::memory_order_relaxed);
+        m_lastCycle.decommitBytes.store(decommitBytes - m_cycleStart.decommitBytes, std::memory_order_relaxed);
+        m_lastCycle.pageFaults.store(m_cycleStart.pageFaults ? faults - m_cycleStart.pageFaults : 0,
+                                     std::memory_order_relaxed);
+        m_resetCycles.fetch_add(1, std::memory_order_relaxed);
+
+        m_cycleStart = CycleStart{ commits, decommits, commitBytes, decommitBytes, faults };
+    }
+
     void* AllocateOverflow(size_t size, size_t alignment) noexcept {
         // Allocate size + alignment, place linked list node in front to ensure returned pointer still satisfies alignment
-        void* raw_ptr = _aligned_malloc(size + alignment, alignment);
+        void* raw_ptr = QuickView::VM::AlignedAlloc(size + alignment, alignment);
         if (raw_ptr) {
             std::lock_guard<std::mutex> lock(m_overflowMutex);
             void** header = static_cast<void**>(raw_ptr);
             *header = m_overflowHead;
             m_overflowHead = raw_ptr;
+            m_overflowCount.fetch_add(1, std::memory_order_relaxed);
             return static_cast<char*>(raw_ptr) + alignment;
         }
         return nullptr;
@@ -224,7 +379,7 @@ private:
         }
         while (curr) {
             void* next = *static_cast<void**>(curr);
-            _aligned_free(curr);
+            QuickView::VM::AlignedFree(curr);
             curr = next;
         }
     }
@@ -232,21 +387,50 @@ private:
     void EnsureInitialized() {
         if (m_buffer) return;
 
-        // Only reserve virtual address space (MEM_RESERVE), consumes no physical memory!
-        m_buffer = static_cast<char*>(VirtualAlloc(nullptr, m_capacity, MEM_RESERVE, PAGE_READWRITE));
-        if (!m_buffer) {
+        // Only reserve virtual address space, consumes no physical memory!
+        m_reservation = QuickView::VM::Reserve(m_capacity, m_hugePagesRequested);
+        if (!m_reservation) {
             return;
         }
 
+        m_buffer = static_cast<char*>(m_reservation.base);
         m_committed = 0;
     }
 
     char* m_buffer = nullptr;
+    QuickView::VM::Reservation m_reservation;
     size_t m_capacity;
+    HugePages m_hugePagesRequested = HugePages::Off;
     std::atomic<size_t> m_committed{0};
     std::mutex m_commitMutex;
+    size_t m_faultedBytes = 0; // Prefix known to be resident (guarded by m_commitMutex)
+    std::atomic<size_t> m_retainBytes{0};
     std::atomic<size_t> m_offset{0};
     std::atomic<size_t> m_peakUsage{0};
+    std::atomic<size_t> m_allocCount{0};
+    std::atomic<size_t> m_overflowCount{0};
+
+    // Telemetry
+    std::atomic<uint64_t> m_commitCalls{0};
+    std::atomic<uint64_t> m_decommitCalls{0};
+    std::atomic<uint64_t> m_commitBytes{0};
+    std::atomic<uint64_t> m_decommitBytes{0};
+    std::atomic<uint64_t> m_prefaultBytes{0};
+    std::atomic<uint64_t> m_resetCycles{0};
+    struct CycleStart {
+        uint64_t commitCalls = 0;
+        uint64_t decommitCalls = 0;
+        uint64_t commitBytes = 0;
+        uint64_t decommitBytes = 0;
+        uint64_t pageFaults = 0;
+    } m_cycleStart; // Owner thread only (written in Reset)
+    struct {
+        std::atomic<uint64_t> commitCalls{0};
+        std::atomic<uint64_t> decommitCalls{0};
+        std::atomic<uint64_t> commitBytes{0};
+        std::atomic<uint64_t> decommitBytes{0};
+        std::atomic<uint64_t> pageFaults{0};
+    } m_lastCycle;
 
     std::mutex m_overflowMutex;
     void* m_overflowHead = nullptr;
@@ -322,16 +506,13 @@ private:
 struct ArenaConfig {
     size_t scoutArenaSize;    // Scout Arena size
     size_t heavyArenaSize;    // Heavy Arena size (each)
+    QuantumArena::HugePages heavyHugePages = QuantumArena::HugePages::Off; // Huge-page backing for Heavy Arenas
     
     /// <summary>
     /// Automatically calculate best configuration based on system physical memory
     /// </summary>
     static ArenaConfig Detect() {
-        MEMORYSTATUSEX statex;
-        statex.dwLength = sizeof(statex);
-        GlobalMemoryStatusEx(&statex);
-        
-        uint64_t totalPhys = statex.ullTotalPhys;
+        uint64_t totalPhys = QuickView::VM::TotalPhysicalMemory();
         ArenaConfig config;
         
         if (totalPhys <= 4ULL * 1024 * 1024 * 1024) {
@@ -346,6 +527,9 @@ struct ArenaConfig {
             // > 8GB: Extreme mode (reserve address space only, commit on demand)
             config.scoutArenaSize = 256 * 1024 * 1024;  // 256MB
             config.heavyArenaSize = 1024 * 1024 * 1024; // 1GB × 2
+            // Full-frame decodes stream through hundreds of MB: 2MB pages cut TLB misses
+            // and first-touch faults. Costs at most one extra 2MB block of commit.
+            config.heavyHugePages = QuantumArena::HugePages::Transparent;
         }
         
         return config;
@@ -361,6 +545,47 @@ struct ArenaConfig {
     }
 };
 
+// ============================================================================
+// ArenaWorkingSet - How much a Heavy Arena keeps committed across navigations
+// ============================================================================
+// Records the frame size predicted from each image header. The arena retains the
+// largest of the last kWindow predictions through Reset(), so browsing a folder of
+// same-sized photos stops re-faulting the same pages, while a single small image
+// does not give the memory back. A run of kWindow smaller images does.
+// ============================================================================
+
+class ArenaWorkingSet {
+public:
+    static constexpr size_t kWindow = 8;
+
+    // Output frame bytes for a decode at the given size (rows padded to 64 bytes, the widest loader stride)
+    static size_t PredictFrameBytes(int width, int height, int bytesPerPixel = 4) noexcept {
+        if (width <= 0 || height <= 0 || bytesPerPixel <= 0) return 0;
+        size_t stride = ((size_t)width * bytesPerPixel + QuantumArena::ALIGNMENT - 1) & ~(QuantumArena::ALIGNMENT - 1);
+        return stride * (size_t)height;
+    }
+
+    void Record(size_t bytes) noexcept {
+        m_history[m_next % kWindow] = bytes;
+        m_next++;
+    }
+
+    size_t RetainBytes() const noexcept {
+        size_t retain = 0;
+        for (size_t b : m_history) retain = (std::max)(retain, b);
+        return retain;
+    }
+
+    void Clear() noexcept {
+        for (size_t& b : m_history) b = 0;
+        m_next = 0;
+    }
+
+private:
+    size_t m_history[kWindow] = {};
+    size_t m_next = 0;
+};
+
 // ============================================================================
 // TripleArenaPool - Triple Arena manager
 // ============================================================================
@@ -388,8 +613,8 @@ public:
     void Initialize(const ArenaConfig& config) {
         m_config = config;
         m_scoutArena = std::make_unique<QuantumArena>(config.scoutArenaSize);
-        m_heavyArenas[0] = std::make_unique<QuantumArena>(config.heavyArenaSize);
-        m_heavyArenas[1] = std::make_unique<QuantumArena>(config.heavyArenaSize);
+        m_heavyArenas[0] = std::make_unique<QuantumArena>(config.heavyArenaSize, config.heavyHugePages);
+        m_heavyArenas[1] = std::make_unique<QuantumArena>(config.heavyArenaSize, config.heavyHugePages);
         m_initialized = true;
     }
     
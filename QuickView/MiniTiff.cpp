@@ -22,9 +22,11 @@
 #include <cstring>
 #include <vector>
 #include <span>
-#include <omp.h>
 #include <zlib.h>
 #include <algorithm>
+#include <cmath>
+#include <atomic>
+#include <thread>
 
 namespace QuickView::MiniTiff {
 
@@ -35,22 +37,30 @@ struct TiffImageDesc {
     uint16_t photometric = 2;
     uint16_t samples = 1;
     uint16_t bitsPerSample = 8;
+    uint16_t sampleFormat = 1;  // 1 = unsigned integer, 3 = IEEE float
     uint16_t planarConfig = 1;
     uint16_t predictor = 1;
     uint16_t orientation = 1;
     uint16_t extraSamples = 0;
     uint32_t rowsPerStrip = 0;
+    uint32_t subfileType = 0;   // NewSubfileType (bit 0 = reduced resolution, bit 2 = mask)
     bool isTiled = false;
     uint32_t tileWidth = 0;
     uint32_t tileHeight = 0;
     bool isLE = true;
+    bool isBigTiff = false;
 
     std::vector<uint64_t> offsets;
     std::vector<uint64_t> byteCounts;
     std::span<const uint8_t> iccProfile;
+    std::span<const uint8_t> jpegTables; // Shared DQT/DHT stream for Compression=7 units
     std::vector<uint16_t> colorMap;
+    std::vector<uint32_t> paletteBgra;   // First 256 ColorMap entries as packed BGRA8
 };
 
+// Separate-plane (PlanarConfiguration=2) images are interleaved from at most this many planes
+static constexpr int kMaxPlanes = 4;
+
 // PackBits decoder implementation
 static bool DecompressPackBits(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen) {
     size_t srcIdx = 0;
@@ -115,30 +125,28 @@ static bool DecompressDeflate(const uint8_t* src, size_t srcLen, uint8_t* dst, s
     return false;
 }
 
-static Status ParseTiffIFD(const uint8_t* data, size_t size, TiffImageDesc& desc) {
-    if (size < 8) return Status::NotTiff;
+// Byte-order and classic/BigTIFF aware view over the mapped file
+struct TiffStream {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    bool isLE = true;
+    bool isBig = false;
 
-    bool isLE = false;
-    if (data[0] == 0x49 && data[1] == 0x49 && data[2] == 0x2A && data[3] == 0x00) {
-        isLE = true;
-    } else if (data[0] == 0x4D && data[1] == 0x4D && data[2] == 0x00 && data[3] == 0x2A) {
-        isLE = false;
-    } else {
-        return Status::NotTiff;
+    bool InRange(uint64_t off, uint64_t len) const {
+        return off <= size && len <= size - off;
     }
-    desc.isLE = isLE;
 
-    auto read16 = [&](size_t off) -> uint16_t {
-        if (off + 2 > size) return 0;
+    uint16_t Read16(uint64_t off) const {
+        if (!InRange(off, 2)) return 0;
         if (isLE) {
             return data[off] | (static_cast<uint16_t>(data[off + 1]) << 8);
         } else {
             return (static_cast<uint16_t>(data[off]) << 8) | data[off + 1];
         }
-    };
+    }
 
-    auto read32 = [&](size_t off) -> uint32_t {
-        if (off + 4 > size) return 0;
+    uint32_t Read32(uint64_t off) const {
+        if (!InRange(off, 4)) return 0;
         if (isLE) {
             return data[off] | (static_cast<uint32_t>(data[off + 1]) << 8) |
                    (static_cast<uint32_t>(data[off + 2]) << 16) | (static_cast<uint32_t>(data[off + 3]) << 24);
@@ -146,246 +154,299 @@ static Status ParseTiffIFD(const uint8_t* data, size_t size, TiffImageDesc& desc
             return (static_cast<uint32_t>(data[off]) << 24) | (static_cast<uint32_t>(data[off + 1]) << 16) |
                    (static_cast<uint32_t>(data[off + 2]) << 8) | data[off + 3];
         }
-    };
+    }
 
-    auto getTagValue = [&](size_t entryOff, uint16_t type, uint32_t count) -> uint32_t {
-        if (count != 1) return 0;
-        if (type == 3) {
-            return read16(entryOff + 8);
-        } else if (type == 4) {
-            return read32(entryOff + 8);
-        } else if (type == 1) {
-            return data[entryOff + 8];
-        }
-        return 0;
-    };
+    uint64_t Read64(uint64_t off) const {
+        if (!InRange(off, 8)) return 0;
+        uint64_t lo = Read32(off);
+        uint64_t hi = Read32(off + 4);
+        return isLE ? (lo | (hi << 32)) : ((lo << 32) | hi);
+    }
 
-    uint32_t ifdOffset = read32(4);
-    if (ifdOffset == 0 || ifdOffset + 2 > size) {
-        return Status::Corrupt;
+    // IFD offsets and out-of-line value pointers are 32-bit in classic TIFF, 64-bit in BigTIFF
+    uint64_t ReadOffset(uint64_t off) const { return isBig ? Read64(off) : Read32(off); }
+    uint32_t EntrySize() const { return isBig ? 20 : 12; }
+    uint32_t InlineBytes() const { return isBig ? 8 : 4; }
+};
+
+struct TiffTag {
+    uint16_t tag = 0;
+    uint16_t type = 0;
+    uint64_t count = 0;
+    uint64_t valuePos = 0; // Absolute file position of the first element (inline or out-of-line)
+};
+
+static uint32_t TiffTypeSize(uint16_t type) {
+    switch (type) {
+        case 1: case 2: case 6: case 7: return 1;    // BYTE, ASCII, SBYTE, UNDEFINED
+        case 3: case 8: return 2;                    // SHORT, SSHORT
+        case 4: case 9: case 11: case 13: return 4;  // LONG, SLONG, FLOAT, IFD
+        case 5: case 10: case 12: return 8;          // RATIONAL, SRATIONAL, DOUBLE
+        case 16: case 17: case 18: return 8;         // LONG8, SLONG8, IFD8 (BigTIFF)
+        default: return 0;
     }
+}
 
-    uint16_t numEntries = read16(ifdOffset);
-    size_t current = ifdOffset + 2;
-    if (current + numEntries * 12 > size) {
+// Reads element `index` of an integer-typed tag. Returns false on type/range mismatch.
+static bool ReadTagElement(const TiffStream& s, const TiffTag& t, uint64_t index, uint64_t& out) {
+    uint32_t typeSize = TiffTypeSize(t.type);
+    if (typeSize == 0 || index >= t.count) return false;
+    uint64_t pos = t.valuePos + index * typeSize;
+    if (!s.InRange(pos, typeSize)) return false;
+    switch (t.type) {
+        case 1: case 6: case 7: out = s.data[pos]; return true;
+        case 3: case 8: out = s.Read16(pos); return true;
+        case 4: case 9: case 13: out = s.Read32(pos); return true;
+        case 16: case 17: case 18: out = s.Read64(pos); return true;
+        default: return false;
+    }
+}
+
+static uint64_t ReadTagScalar(const TiffStream& s, const TiffTag& t) {
+    uint64_t v = 0;
+    ReadTagElement(s, t, 0, v);
+    return v;
+}
+
+static Status ReadTagArray(const TiffStream& s, const TiffTag& t, std::vector<uint64_t>& out) {
+    uint32_t typeSize = TiffTypeSize(t.type);
+    if (t.type != 3 && t.type != 4 && t.type != 13 && t.type != 16 && t.type != 18) {
+        return Status::Unsupported;
+    }
+    if (t.count == 0 || t.count > s.size / typeSize || !s.InRange(t.valuePos, t.count * typeSize)) {
         return Status::Corrupt;
     }
+    out.resize(static_cast<size_t>(t.count));
+    for (uint64_t j = 0; j < t.count; ++j) {
+        ReadTagElement(s, t, j, out[j]);
+    }
+    return Status::Ok;
+}
 
-    uint32_t stripOffsetsOffset = 0;
-    uint32_t stripOffsetsCount = 0;
-    uint16_t stripOffsetsType = 0;
+static Status ParseTiffHeader(const uint8_t* data, size_t size, TiffStream& s, uint64_t& firstIfd) {
+    if (size < 8) return Status::NotTiff;
 
-    uint32_t stripByteCountsOffset = 0;
-    uint32_t stripByteCountsCount = 0;
-    uint16_t stripByteCountsType = 0;
+    s.data = data;
+    s.size = size;
+    if (data[0] == 0x49 && data[1] == 0x49) {
+        s.isLE = true;
+    } else if (data[0] == 0x4D && data[1] == 0x4D) {
+        s.isLE = false;
+    } else {
+        return Status::NotTiff;
+    }
 
-    uint32_t tileOffsetsOffset = 0;
-    uint32_t tileOffsetsCount = 0;
-    uint16_t tileOffsetsType = 0;
+    uint16_t magic = s.Read16(2);
+    if (magic == 0x2A) {
+        s.isBig = false;
+        firstIfd = s.Read32(4);
+    } else if (magic == 0x2B) {
+        // BigTIFF: [bytesize=8][reserved=0][uint64 first IFD]
+        if (size < 16 || s.Read16(4) != 8 || s.Read16(6) != 0) return Status::Corrupt;
+        s.isBig = true;
+        firstIfd = s.Read64(8);
+    } else {
+        return Status::NotTiff;
+    }
+    return Status::Ok;
+}
+
+// Parses one IFD. nextIfd / subIfds are optional outputs used for pyramid discovery.
+static Status ParseTiffIFD(const TiffStream& s, uint64_t ifdOffset, TiffImageDesc& desc,
+                           uint64_t* nextIfd, std::vector<uint64_t>* subIfds) {
+    desc.isLE = s.isLE;
+    desc.isBigTiff = s.isBig;
 
-    uint32_t tileByteCountsOffset = 0;
-    uint32_t tileByteCountsCount = 0;
-    uint16_t tileByteCountsType = 0;
+    const uint64_t countBytes = s.isBig ? 8 : 2;
+    if (ifdOffset == 0 || !s.InRange(ifdOffset, countBytes)) {
+        return Status::Corrupt;
+    }
+
+    uint64_t numEntries = s.isBig ? s.Read64(ifdOffset) : s.Read16(ifdOffset);
+    uint64_t current = ifdOffset + countBytes;
+    if (numEntries > s.size / s.EntrySize() || !s.InRange(current, numEntries * s.EntrySize())) {
+        return Status::Corrupt;
+    }
 
-    for (uint16_t i = 0; i < numEntries; ++i) {
-        size_t entryOff = current + i * 12;
-        uint16_t tag = read16(entryOff);
-        uint16_t type = read16(entryOff + 2);
-        uint32_t count = read32(entryOff + 4);
+    TiffTag stripOffsets, stripByteCounts, tileOffsets, tileByteCounts;
 
-        switch (tag) {
+    for (uint64_t i = 0; i < numEntries; ++i) {
+        uint64_t entryOff = current + i * s.EntrySize();
+        TiffTag t;
+        t.tag = s.Read16(entryOff);
+        t.type = s.Read16(entryOff + 2);
+        t.count = s.isBig ? s.Read64(entryOff + 4) : s.Read32(entryOff + 4);
+
+        uint64_t valueField = entryOff + (s.isBig ? 12 : 8);
+        uint32_t typeSize = TiffTypeSize(t.type);
+        bool fitsInline = typeSize != 0 && t.count <= s.InlineBytes() / typeSize;
+        t.valuePos = fitsInline ? valueField : s.ReadOffset(valueField);
+
+        switch (t.tag) {
+            case 254: // NewSubfileType
+                desc.subfileType = static_cast<uint32_t>(ReadTagScalar(s, t));
+                break;
             case 256: // ImageWidth
-                desc.width = getTagValue(entryOff, type, count);
+                desc.width = static_cast<uint32_t>(ReadTagScalar(s, t));
                 break;
             case 257: // ImageHeight
-                desc.height = getTagValue(entryOff, type, count);
+                desc.height = static_cast<uint32_t>(ReadTagScalar(s, t));
                 break;
             case 258: // BitsPerSample
-                if (count == 1) {
-                    desc.bitsPerSample = static_cast<uint16_t>(getTagValue(entryOff, type, count));
-                } else if (count > 1) {
-                    uint32_t valOrOff = read32(entryOff + 8);
-                    if (type == 3) {
-                        if (valOrOff + count * 2 > size) return Status::Corrupt;
-                        desc.bitsPerSample = read16(valOrOff);
-                        for (uint32_t j = 1; j < count; ++j) {
-                            if (read16(valOrOff + j * 2) != desc.bitsPerSample) {
-                                return Status::Unsupported; // Inconsistent bit depths
-                            }
-                        }
-                    } else {
-                        return Status::Unsupported;
+                if (t.type != 3) return Status::Unsupported;
+                desc.bitsPerSample = static_cast<uint16_t>(ReadTagScalar(s, t));
+                for (uint64_t j = 1; j < t.count; ++j) {
+                    uint64_t bits = 0;
+                    if (!ReadTagElement(s, t, j, bits)) return Status::Corrupt;
+                    if (bits != desc.bitsPerSample) {
+                        return Status::Unsupported; // Inconsistent bit depths
                     }
                 }
                 break;
             case 259: // Compression
-                desc.compression = static_cast<uint16_t>(getTagValue(entryOff, type, count));
+                desc.compression = static_cast<uint16_t>(ReadTagScalar(s, t));
                 break;
             case 262: // PhotometricInterpretation
-                desc.photometric = static_cast<uint16_t>(getTagValue(entryOff, type, count));
+                desc.photometric = static_cast<uint16_t>(ReadTagScalar(s, t));
                 break;
             case 273: // StripOffsets
-                stripOffsetsOffset = read32(entryOff + 8);
-                stripOffsetsCount = count;
-                stripOffsetsType = type;
+                stripOffsets = t;
                 break;
             case 274: // Orientation
-                desc.orientation = static_cast<uint16_t>(getTagValue(entryOff, type, count));
+                desc.orientation = static_cast<uint16_t>(ReadTagScalar(s, t));
                 break;
             case 277: // SamplesPerPixel
-                desc.samples = static_cast<uint16_t>(getTagValue(entryOff, type, count));
+                desc.samples = static_cast<uint16_t>(ReadTagScalar(s, t));
                 break;
             case 278: // RowsPerStrip
-                desc.rowsPerStrip = getTagValue(entryOff, type, count);
+                desc.rowsPerStrip = static_cast<uint32_t>(ReadTagScalar(s, t));
                 break;
             case 279: // StripByteCounts
-                stripByteCountsOffset = read32(entryOff + 8);
-                stripByteCountsCount = count;
-                stripByteCountsType = type;
+                stripByteCounts = t;
                 break;
             case 284: // PlanarConfiguration
-                desc.planarConfig = static_cast<uint16_t>(getTagValue(entryOff, type, count));
+                desc.planarConfig = static_cast<uint16_t>(ReadTagScalar(s, t));
                 break;
             case 317: // Predictor
-                desc.predictor = static_cast<uint16_t>(getTagValue(entryOff, type, count));
+                desc.predictor = static_cast<uint16_t>(ReadTagScalar(s, t));
                 break;
             case 320: // ColorMap
-                if (type == 3) {
-                    uint32_t valOrOff = read32(entryOff + 8);
-                    if (valOrOff + count * 2 > size) return Status::Corrupt;
-                    desc.colorMap.resize(count);
-                    for (uint32_t j = 0; j < count; ++j) {
-                        desc.colorMap[j] = read16(valOrOff + j * 2);
+                if (t.type == 3) {
+                    if (t.count > s.size / 2 || !s.InRange(t.valuePos, t.count * 2)) return Status::Corrupt;
+                    desc.colorMap.resize(static_cast<size_t>(t.count));
+                    for (uint64_t j = 0; j < t.count; ++j) {
+                        desc.colorMap[j] = s.Read16(t.valuePos + j * 2);
+                    }
+                    if (desc.colorMap.size() >= 768) {
+                        desc.paletteBgra.resize(256);
+                        for (int j = 0; j < 256; ++j) {
+                            const uint8_t bgra[4] = { static_cast<uint8_t>(desc.colorMap[j + 512] / 256),
+                                                      static_cast<uint8_t>(desc.colorMap[j + 256] / 256),
+                                                      static_cast<uint8_t>(desc.colorMap[j] / 256), 255 };
+                            std::memcpy(&desc.paletteBgra[j], bgra, 4);
+                        }
                     }
                 }
                 break;
             case 322: // TileWidth
                 desc.isTiled = true;
-                desc.tileWidth = getTagValue(entryOff, type, count);
+                desc.tileWidth = static_cast<uint32_t>(ReadTagScalar(s, t));
                 break;
             case 323: // TileLength
-                desc.tileHeight = getTagValue(entryOff, type, count);
+                desc.tileHeight = static_cast<uint32_t>(ReadTagScalar(s, t));
                 break;
             case 324: // TileOffsets
-                tileOffsetsOffset = read32(entryOff + 8);
-                tileOffsetsCount = count;
-                tileOffsetsType = type;
+                tileOffsets = t;
                 break;
             case 325: // TileByteCounts
-                tileByteCountsOffset = read32(entryOff + 8);
-                tileByteCountsCount = count;
-                tileByteCountsType = type;
+                tileByteCounts = t;
+                break;
+            case 330: // SubIFDs (reduced-resolution levels in DNG/OME/GDAL exports)
+                if (subIfds) {
+                    std::vector<uint64_t> subs;
+                    if (ReadTagArray(s, t, subs) == Status::Ok) {
+                        subIfds->insert(subIfds->end(), subs.begin(), subs.end());
+                    }
+                }
                 break;
             case 338: // ExtraSamples
-                desc.extraSamples = static_cast<uint16_t>(getTagValue(entryOff, type, count));
+                desc.extraSamples = static_cast<uint16_t>(ReadTagScalar(s, t));
                 break;
-            case 34675: // ICCProfile
-                if (type == 7 || type == 1) {
-                    uint32_t valOrOff = read32(entryOff + 8);
-                    if (valOrOff + count <= size) {
-                        desc.iccProfile = std::span<const uint8_t>(data + valOrOff, count);
+            case 339: // SampleFormat
+                desc.sampleFormat = static_cast<uint16_t>(ReadTagScalar(s, t));
+                for (uint64_t j = 1; j < t.count; ++j) {
+                    uint64_t format = 0;
+                    if (!ReadTagElement(s, t, j, format)) return Status::Corrupt;
+                    if (format != desc.sampleFormat) {
+                        return Status::Unsupported; // Mixed integer/float channels
                     }
                 }
                 break;
-        }
-    }
-
-    // Populate offsets and byteCounts
-    if (desc.isTiled) {
-        if (tileOffsetsCount == 0 || tileOffsetsCount != tileByteCountsCount) {
-            return Status::Corrupt;
-        }
-        desc.offsets.resize(tileOffsetsCount);
-        desc.byteCounts.resize(tileByteCountsCount);
-
-        if (tileOffsetsCount == 1) {
-            desc.offsets[0] = tileOffsetsOffset;
-            desc.byteCounts[0] = tileByteCountsOffset;
-        } else {
-            if (tileOffsetsType == 3) {
-                if (tileOffsetsOffset + tileOffsetsCount * 2 > size) return Status::Corrupt;
-                for (uint32_t j = 0; j < tileOffsetsCount; ++j) {
-                    desc.offsets[j] = read16(tileOffsetsOffset + j * 2);
-                }
-            } else if (tileOffsetsType == 4) {
-                if (tileOffsetsOffset + tileOffsetsCount * 4 > size) return Status::Corrupt;
-                for (uint32_t j = 0; j < tileOffsetsCount; ++j) {
-                    desc.offsets[j] = read32(tileOffsetsOffset + j * 4);
-                }
-            } else {
-                return Status::Unsupported;
-            }
-
-            if (tileByteCountsType == 3) {
-                if (tileByteCountsOffset + tileByteCountsCount * 2 > size) return Status::Corrupt;
-                for (uint32_t j = 0; j < tileByteCountsCount; ++j) {
-                    desc.byteCounts[j] = read16(tileByteCountsOffset + j * 2);
+            case 347: // JPEGTables
+                if ((t.type == 7 || t.type == 1) && s.InRange(t.valuePos, t.count)) {
+                    desc.jpegTables = std::span<const uint8_t>(s.data + t.valuePos, static_cast<size_t>(t.count));
                 }
-            } else if (tileByteCountsType == 4) {
-                if (tileByteCountsOffset + tileByteCountsCount * 4 > size) return Status::Corrupt;
-                for (uint32_t j = 0; j < tileByteCountsCount; ++j) {
-                    desc.byteCounts[j] = read32(tileByteCountsOffset + j * 4);
+                break;
+            case 34675: // ICCProfile
+                if ((t.type == 7 || t.type == 1) && s.InRange(t.valuePos, t.count)) {
+                    desc.iccProfile = std::span<const uint8_t>(s.data + t.valuePos, static_cast<size_t>(t.count));
                 }
-            } else {
-                return Status::Unsupported;
-            }
-        }
-    } else {
-        if (stripOffsetsCount == 0 || stripOffsetsCount != stripByteCountsCount) {
-            return Status::Corrupt;
+                break;
         }
-        desc.offsets.resize(stripOffsetsCount);
-        desc.byteCounts.resize(stripByteCountsCount);
+    }
 
-        if (stripOffsetsCount == 1) {
-            desc.offsets[0] = stripOffsetsOffset;
-            desc.byteCounts[0] = stripByteCountsOffset;
-        } else {
-            if (stripOffsetsType == 3) {
-                if (stripOffsetsOffset + stripOffsetsCount * 2 > size) return Status::Corrupt;
-                for (uint32_t j = 0; j < stripOffsetsCount; ++j) {
-                    desc.offsets[j] = read16(stripOffsetsOffset + j * 2);
-                }
-            } else if (stripOffsetsType == 4) {
-                if (stripOffsetsOffset + stripOffsetsCount * 4 > size) return Status::Corrupt;
-                for (uint32_t j = 0; j < stripOffsetsCount; ++j) {
-                    desc.offsets[j] = read32(stripOffsetsOffset + j * 4);
-                }
-            } else {
-                return Status::Unsupported;
-            }
+    if (nextIfd) {
+        uint64_t nextPos = current + numEntries * s.EntrySize();
+        *nextIfd = s.InRange(nextPos, s.InlineBytes()) ? s.ReadOffset(nextPos) : 0;
+    }
 
-            if (stripByteCountsType == 3) {
-                if (stripByteCountsOffset + stripByteCountsCount * 2 > size) return Status::Corrupt;
-                for (uint32_t j = 0; j < stripByteCountsCount; ++j) {
-                    desc.byteCounts[j] = read16(stripByteCountsOffset + j * 2);
-                }
-            } else if (stripByteCountsType == 4) {
-                if (stripByteCountsOffset + stripByteCountsCount * 4 > size) return Status::Corrupt;
-                for (uint32_t j = 0; j < stripByteCountsCount; ++j) {
-                    desc.byteCounts[j] = read32(stripByteCountsOffset + j * 4);
-                }
-            } else {
-                return Status::Unsupported;
-            }
-        }
+    // Populate offsets and byteCounts
+    const TiffTag& offsetsTag = desc.isTiled ? tileOffsets : stripOffsets;
+    const TiffTag& byteCountsTag = desc.isTiled ? tileByteCounts : stripByteCounts;
+    if (offsetsTag.count == 0 || offsetsTag.count != byteCountsTag.count) {
+        return Status::Corrupt;
     }
 
-    return Status::Ok;
+    Status status = ReadTagArray(s, offsetsTag, desc.offsets);
+    if (status != Status::Ok) return status;
+    return ReadTagArray(s, byteCountsTag, desc.byteCounts);
 }
 
 static Status CapabilityGate(const TiffImageDesc& desc) {
     if (desc.width == 0 || desc.height == 0) return Status::Corrupt;
 
+    // JPEG (7, new-style) units are whole baseline JPEG streams: 8-bit gray, RGB or YCbCr only
+    if (desc.compression == 7) {
+        if (desc.bitsPerSample != 8 || desc.sampleFormat != 1 || desc.predictor != 1) {
+            return Status::Unsupported;
+        }
+        if (desc.planarConfig != 1 && desc.samples > 1) return Status::Unsupported;
+        const bool gray = desc.photometric == 1 && desc.samples == 1;
+        const bool color = (desc.photometric == 2 || desc.photometric == 6) && desc.samples == 3;
+        return (gray || color) ? Status::Ok : Status::Unsupported;
+    }
+
     // Phase 1 supported compressions: 1 (Uncompressed), 32773 (PackBits), 5 (LZW), 8 (Deflate), 32946 (Deflate)
     if (desc.compression != 1 && desc.compression != 32773 &&
         desc.compression != 5 && desc.compression != 8 && desc.compression != 32946) {
         return Status::Unsupported;
     }
 
-    // 8-bit and 16-bit supported (16-bit will be downsampled to 8-bit)
-    if (desc.bitsPerSample != 8 && desc.bitsPerSample != 16) {
-        return Status::Unsupported;
+    // Integer samples: 8-bit and 16-bit (16-bit will be downsampled to 8-bit).
+    // Float samples: 16-bit half and 32-bit single, gray or RGB(A) only (kept as float for HDR).
+    if (desc.sampleFormat == 1) {
+        if (desc.bitsPerSample != 8 && desc.bitsPerSample != 16) {
+            return Status::Unsupported;
+        }
+    } else if (desc.sampleFormat == 3) {
+        if (desc.bitsPerSample != 16 && desc.bitsPerSample != 32) {
+            return Status::Unsupported;
+        }
+        if (desc.photometric != 1 && desc.photometric != 2) {
+            return Status::Unsupported;
+        }
+    } else {
+        return Status::Unsupported; // Signed integer / complex
     }
 
     // Photometrics supported: 0 (WhiteIsZero), 1 (BlackIsZero), 2 (RGB), 3 (Palette), 5 (CMYK)
@@ -393,8 +454,11 @@ static Status CapabilityGate(const TiffImageDesc& desc) {
         return Status::Unsupported;
     }
 
-    // PlanarConfiguration: only contiguous (1) supported
-    if (desc.planarConfig != 1) {
+    // PlanarConfiguration: contiguous (1), or separate planes (2) of at most 4 channels
+    if (desc.planarConfig != 1 && desc.planarConfig != 2) {
+        return Status::Unsupported;
+    }
+    if (desc.planarConfig == 2 && desc.samples > kMaxPlanes) {
         return Status::Unsupported;
     }
 
@@ -403,433 +467,684 @@ static Status CapabilityGate(const TiffImageDesc& desc) {
     if (desc.photometric == 5 && desc.samples < 4) return Status::Corrupt;
     if (desc.photometric != 2 && desc.photometric != 5 && desc.samples < 1) return Status::Corrupt;
 
-    // Predictor: supports None (1) or Horizontal (2)
-    if (desc.predictor != 1 && desc.predictor != 2) {
+    // Predictor: None (1), Horizontal (2) for integers, FloatingPoint (3) for floats
+    if (desc.predictor == 2) {
+        if (desc.sampleFormat != 1) return Status::Unsupported;
+    } else if (desc.predictor == 3) {
+        if (desc.sampleFormat != 3) return Status::Unsupported;
+    } else if (desc.predictor != 1) {
         return Status::Unsupported;
     }
 
     return Status::Ok;
 }
 
-HRESULT LoadRegion(const uint8_t* data, size_t size,
-                   const QuickView::Codec::DecodeContext& ctx,
-                   QuickView::Codec::DecodeResult& result,
-                   int cropX, int cropY, int cropW, int cropH) {
-    TiffImageDesc desc;
-    Status status = ParseTiffIFD(data, size, desc);
-    if (status != Status::Ok) {
-        return (status == Status::NotTiff) ? E_NOTIMPL : E_FAIL;
+// Pyramid levels are only trusted when they look like downsamples of the base image:
+// flagged reduced-resolution, referenced from SubIFDs, or sharing its aspect ratio.
+// Multi-page documents (same size pages) and SVS label/macro images are rejected.
+static bool IsPyramidLevelOf(const TiffImageDesc& base, const TiffImageDesc& level, bool fromSubIfd) {
+    if (level.width == 0 || level.height == 0) return false;
+    if (level.width >= base.width || level.height >= base.height) return false;
+    if (level.subfileType & 4) return false; // Transparency mask
+    if (level.samples != base.samples || level.photometric != base.photometric) return false;
+    if (level.sampleFormat != base.sampleFormat) return false; // Levels must share the output format
+    if ((level.subfileType & 1) || fromSubIfd) return true;
+
+    double rx = static_cast<double>(level.width) / base.width;
+    double ry = static_cast<double>(level.height) / base.height;
+    double tolerance = (std::max)(0.02 * rx, 2.0 / level.width + 2.0 / level.height);
+    return std::abs(rx - ry) <= tolerance;
+}
+
+// Parses IFD0 into levels[0]. When discoverLevels is set, also collects reduced-resolution
+// levels from SubIFDs and the chained IFD list, sorted from finest to coarsest.
+static Status ParseTiffPyramid(const uint8_t* data, size_t size, std::vector<TiffImageDesc>& levels,
+                               bool discoverLevels) {
+    constexpr int kMaxChainedIfds = 64;
+
+    TiffStream s;
+    uint64_t firstIfd = 0;
+    Status status = ParseTiffHeader(data, size, s, firstIfd);
+    if (status != Status::Ok) return status;
+
+    levels.clear();
+    levels.emplace_back();
+    uint64_t nextIfd = 0;
+    std::vector<uint64_t> subIfds;
+    status = ParseTiffIFD(s, firstIfd, levels[0], discoverLevels ? &nextIfd : nullptr,
+                          discoverLevels ? &subIfds : nullptr);
+    if (status != Status::Ok || !discoverLevels) return status;
+
+    for (uint64_t off : subIfds) {
+        TiffImageDesc level;
+        if (ParseTiffIFD(s, off, level, nullptr, nullptr) == Status::Ok &&
+            IsPyramidLevelOf(levels[0], level, true)) {
+            levels.push_back(std::move(level));
+        }
     }
 
-    status = CapabilityGate(desc);
-    if (status != Status::Ok) {
-        return (status == Status::Unsupported) ? E_NOTIMPL : E_FAIL;
+    std::vector<uint64_t> visited{firstIfd};
+    for (int guard = 0; nextIfd != 0 && guard < kMaxChainedIfds; ++guard) {
+        if (std::find(visited.begin(), visited.end(), nextIfd) != visited.end()) break; // Cycle
+        visited.push_back(nextIfd);
+
+        TiffImageDesc level;
+        uint64_t following = 0;
+        if (ParseTiffIFD(s, nextIfd, level, &following, nullptr) != Status::Ok) break;
+        if (IsPyramidLevelOf(levels[0], level, false)) {
+            levels.push_back(std::move(level));
+        }
+        nextIfd = following;
     }
 
-    // Clamp crop parameters to valid boundaries
-    cropX = (std::max)(0, cropX);
-    cropY = (std::max)(0, cropY);
-    cropW = (std::min)(cropW, static_cast<int>(desc.width) - cropX);
-    cropH = (std::min)(cropH, static_cast<int>(desc.height) - cropY);
-    if (cropW <= 0 || cropH <= 0) return E_INVALIDARG;
+    std::stable_sort(levels.begin() + 1, levels.end(), [](const TiffImageDesc& a, const TiffImageDesc& b) {
+        return a.width > b.width;
+    });
+    levels.erase(std::unique(levels.begin() + 1, levels.end(), [](const TiffImageDesc& a, const TiffImageDesc& b) {
+        return a.width == b.width;
+    }), levels.end());
+    return Status::Ok;
+}
 
-    uint32_t samples = desc.samples;
-    uint32_t bytesPerSample = desc.bitsPerSample / 8;
-    if (bytesPerSample == 0) bytesPerSample = 1;
-    uint32_t highByteOffset = (bytesPerSample == 2) ? (desc.isLE ? 1 : 0) : 0;
-    
-    // Intermediate buffer for 16-to-8 bit SIMD conversion to avoid allocations in hot-path
-    std::vector<uint8_t> rgb8Buf;
-    if (bytesPerSample == 2 && samples == 3 && highByteOffset == 1) {
-        rgb8Buf.resize(static_cast<size_t>(cropW) * 3);
+// Coarsest decodable level whose resolution still covers the requested scale
+static size_t SelectPyramidLevel(const std::vector<TiffImageDesc>& levels, float scale) {
+    if (levels.size() <= 1 || !(scale > 0.0f) || scale >= 1.0f) return 0;
+
+    size_t best = 0;
+    for (size_t i = 1; i < levels.size(); ++i) {
+        double levelScale = static_cast<double>(levels[i].width) / levels[0].width;
+        if (levelScale + 1e-6 < scale) break; // Sorted finest -> coarsest
+        if (CapabilityGate(levels[i]) == Status::Ok) {
+            best = i;
+        }
     }
+    return best;
+}
 
-    // Prepare Output
-    int outStride = ((cropW * 4) + 63) & ~63; // 64-byte aligned
-    size_t totalBytes = static_cast<size_t>(outStride) * cropH;
-    uint8_t* pixels = ctx.allocator(totalBytes);
-    if (!pixels) {
-        return E_OUTOFMEMORY;
+// JPEG units can shrink 2x/4x/8x inside the IDCT; picks the largest step that still covers
+// `residual` (requested scale relative to the decoded level)
+static int SelectDctScale(const TiffImageDesc& level, double residual) {
+    if (level.compression != 7 || !(residual > 0.0)) return 1;
+    for (int d : {8, 4, 2}) {
+        if (residual <= 1.0 / d + 1e-6) return d;
     }
-    std::memset(pixels, 0, totalBytes);
+    return 1;
+}
 
+// ============================================================================
+// Region decode helpers
+// ============================================================================
 
-    uint32_t pixelStride = samples * bytesPerSample;
-    uint32_t rowBytes = desc.width * pixelStride;
-    uint16_t predictor = desc.predictor;
-    uint16_t photometric = desc.photometric;
+// Crops below this decode on the calling thread (one Titan tile is 0.25 MP)
+static constexpr uint64_t kParallelMinPixels = 1024 * 1024;
 
-    bool decodeFailed = false;
+struct PixelLayout {
+    int samples;
+    int bytesPerSample;
+    int pixelStride;
+    int highByteOffset; // Byte holding the 8 MSBs of a 16-bit sample
+    bool isFloat;       // Half/single samples, output stays floating point
+};
 
-    if (desc.isTiled) {
-        uint32_t tilesPerRow = (desc.width + desc.tileWidth - 1) / desc.tileWidth;
-        uint32_t tilesPerCol = (desc.height + desc.tileHeight - 1) / desc.tileHeight;
-        uint32_t tilesCount = tilesPerRow * tilesPerCol;
-        if (desc.offsets.size() < tilesCount || desc.byteCounts.size() < tilesCount) {
-            return E_FAIL;
+static PixelLayout MakePixelLayout(const TiffImageDesc& desc) {
+    PixelLayout px{};
+    px.samples = desc.samples;
+    px.bytesPerSample = (std::max)(1, desc.bitsPerSample / 8);
+    px.pixelStride = px.samples * px.bytesPerSample;
+    px.highByteOffset = (px.bytesPerSample == 2 && desc.isLE) ? 1 : 0;
+    px.isFloat = (desc.sampleFormat == 3);
+    return px;
+}
+
+// Per-worker buffers, reused across every strip/tile the worker decodes
+struct UnitScratch {
+    std::vector<uint8_t> decoded[kMaxPlanes]; // Decompressed strip/tile, one per plane
+    std::vector<uint8_t> rows[kMaxPlanes];    // Row fixups for rows read straight from the mapping
+    std::vector<uint8_t> interleaved;         // Planar rows merged to chunky order
+    std::vector<uint8_t> bytePlanes;          // Floating-point predictor byte planes
+    std::vector<uint8_t> rgb8;                // 16-to-8 bit staging for the SIMD pack paths
+    std::vector<uint8_t> jpegStream;          // JPEGTables spliced in front of a JPEG unit
+};
+
+// Decode units: tiles, or full-width strips (a strip is a one-column tile grid)
+struct UnitGrid {
+    uint32_t unitW = 0;
+    uint32_t unitRows = 0;
+    uint32_t unitsPerRow = 0;
+    uint32_t unitsPerCol = 0;
+    uint64_t unitsCount = 0; // Per plane
+};
+
+static bool MakeUnitGrid(const TiffImageDesc& desc, int planes, UnitGrid& grid) {
+    uint32_t rowsPerStrip = desc.rowsPerStrip;
+    if (rowsPerStrip == 0 || rowsPerStrip > desc.height) {
+        rowsPerStrip = desc.height;
+    }
+    grid.unitW = desc.isTiled ? desc.tileWidth : desc.width;
+    grid.unitRows = desc.isTiled ? desc.tileHeight : rowsPerStrip;
+    if (grid.unitW == 0 || grid.unitRows == 0) {
+        return false;
+    }
+    grid.unitsPerRow = (desc.width + grid.unitW - 1) / grid.unitW;
+    grid.unitsPerCol = (desc.height + grid.unitRows - 1) / grid.unitRows;
+    grid.unitsCount = static_cast<uint64_t>(grid.unitsPerRow) * grid.unitsPerCol;
+    const uint64_t totalUnits = grid.unitsCount * planes;
+    return desc.offsets.size() >= totalUnits && desc.byteCounts.size() >= totalUnits;
+}
+
+// Units intersecting a (clamped, non-empty) crop, row-major
+static std::vector<int> UnitsInRect(const UnitGrid& grid, int cropX, int cropY, int cropW, int cropH) {
+    const uint32_t firstUx = static_cast<uint32_t>(cropX) / grid.unitW;
+    const uint32_t lastUx = (std::min)(static_cast<uint32_t>(cropX + cropW - 1) / grid.unitW, grid.unitsPerRow - 1);
+    const uint32_t firstUy = static_cast<uint32_t>(cropY) / grid.unitRows;
+    const uint32_t lastUy = (std::min)(static_cast<uint32_t>(cropY + cropH - 1) / grid.unitRows, grid.unitsPerCol - 1);
+    std::vector<int> units;
+    units.reserve(static_cast<size_t>(lastUx - firstUx + 1) * (lastUy - firstUy + 1));
+    for (uint32_t uy = firstUy; uy <= lastUy; ++uy) {
+        for (uint32_t ux = firstUx; ux <= lastUx; ++ux) {
+            units.push_back(static_cast<int>(uy * grid.unitsPerRow + ux));
         }
+    }
+    return units;
+}
 
-        // Tiled parallel decoder
-        [[maybe_unused]] bool useParallel = (tilesCount >= 4 && cropH >= 512);
+// Helper threads currently lent to ForEachUnit calls, process-wide. Decodes already
+// run on HeavyLanePool workers, so concurrent calls draw from one budget of
+// hardware_concurrency - 1 extra threads instead of each taking a core count.
+static std::atomic<int> s_unitHelpersInUse{0};
+
+static int AcquireUnitHelpers(int want) {
+    const int budget = static_cast<int>((std::max)(1u, std::thread::hardware_concurrency())) - 1;
+    int inUse = s_unitHelpersInUse.load(std::memory_order_relaxed);
+    for (;;) {
+        const int grant = (std::min)(want, budget - inUse);
+        if (grant <= 0) return 0;
+        if (s_unitHelpersInUse.compare_exchange_weak(inUse, inUse + grant, std::memory_order_relaxed)) {
+            return grant;
+        }
+    }
+}
 
-        #pragma omp parallel for if(useParallel) shared(decodeFailed)
-        for (int i = 0; i < static_cast<int>(tilesCount); ++i) {
-            if (decodeFailed) continue;
+// Runs body(unitIndex, scratch) over `units`. The parallel path hands units out from a
+// shared counter to short-lived helpers plus the calling thread; the CMake build has no
+// OpenMP runtime, so this replaces the former `omp parallel for` (which compiled serial).
+// maxHelpers caps the extra threads (DecodeContext::helperThreads; negative = only the
+// shared budget applies) and the budget may grant fewer, down to none.
+template <typename Body>
+static void ForEachUnit(const std::vector<int>& units, bool parallel, int maxHelpers, Body&& body) {
+    int helpers = 0;
+    if (parallel && maxHelpers != 0) {
+        int want = static_cast<int>(units.size()) - 1;
+        if (maxHelpers > 0) want = (std::min)(want, maxHelpers);
+        helpers = AcquireUnitHelpers(want);
+    }
 
-                if (ctx.checkCancel && ctx.checkCancel()) {
-                    decodeFailed = true;
-                    continue;
-                }
+    std::atomic<size_t> next{0};
+    auto run = [&]() {
+        UnitScratch scratch;
+        for (size_t k = next.fetch_add(1, std::memory_order_relaxed); k < units.size();
+             k = next.fetch_add(1, std::memory_order_relaxed)) {
+            body(units[k], scratch);
+        }
+    };
 
-                // Locate Tile boundary
-                int tileX = (i % tilesPerRow) * desc.tileWidth;
-                int tileY = (i / tilesPerRow) * desc.tileHeight;
-                int unitW = (std::min)(static_cast<int>(desc.tileWidth), static_cast<int>(desc.width) - tileX);
-                int unitH = (std::min)(static_cast<int>(desc.tileHeight), static_cast<int>(desc.height) - tileY);
+    {
+        std::vector<std::jthread> pool;
+        pool.reserve(helpers);
+        for (int t = 0; t < helpers; ++t) {
+            pool.emplace_back(run);
+        }
+        run();
+    }
+    if (helpers > 0) s_unitHelpersInUse.fetch_sub(helpers, std::memory_order_relaxed);
+}
 
-                // Compute Intersection with requested ROI
-                int intersectX = (std::max)(cropX, tileX);
-                int intersectEndX = (std::min)(cropX + cropW, tileX + unitW);
-                int intersectY = (std::max)(cropY, tileY);
-                int intersectEndY = (std::min)(cropY + cropH, tileY + unitH);
+// TIFF Predictor=3 on one row of `count` samples: bytes were split into planes
+// (most significant first) and differenced as one byte stream `samples` apart.
+// Leaves host (little-endian) order samples, whatever the file byte order.
+static void UndoFloatPredictor(uint8_t* row, int width, int samples, int bytesPerSample,
+                               std::vector<uint8_t>& bytePlanes) {
+    const size_t count = static_cast<size_t>(width) * samples;
+    ImageLoaderSimd::UndoHorizontalPredictor(row, width * bytesPerSample, samples, 1, false);
+    bytePlanes.assign(row, row + count * bytesPerSample);
+
+    const uint8_t* planes[kMaxPlanes];
+    for (int b = 0; b < bytesPerSample; ++b) {
+        planes[b] = bytePlanes.data() + static_cast<size_t>(bytesPerSample - 1 - b) * count;
+    }
+    ImageLoaderSimd::InterleavePlanes(planes, bytesPerSample, 1, row, count);
+}
 
-                if (intersectX >= intersectEndX || intersectY >= intersectEndY) {
-                    continue; // No overlap with this tile, skip decoding!
-                }
+static void SwapSampleBytes(uint8_t* row, size_t count, int bytesPerSample) {
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t* p = row + i * bytesPerSample;
+        std::reverse(p, p + bytesPerSample);
+    }
+}
 
-                uint64_t offset = desc.offsets[i];
-                uint64_t byteCount = desc.byteCounts[i];
-                if (offset + byteCount > size) {
-                    decodeFailed = true;
-                    continue;
-                }
+// Returns a row of `width` pixels x `samples` ready for packing: predictor undone and
+// float samples in host byte order. Rows still pointing into the mapped file are fixed
+// up in `copy` rather than copying the whole unit.
+static const uint8_t* PrepareRow(const TiffImageDesc& desc, const PixelLayout& px,
+                                 const uint8_t* src, int width, int samples, bool writable,
+                                 std::vector<uint8_t>& copy, std::vector<uint8_t>& bytePlanes) {
+    const bool swapFloat = px.isFloat && !desc.isLE && desc.predictor != 3;
+    if (desc.predictor == 1 && !swapFloat) return src;
+
+    const size_t count = static_cast<size_t>(width) * samples;
+    uint8_t* row = const_cast<uint8_t*>(src);
+    if (!writable) {
+        copy.assign(src, src + count * px.bytesPerSample);
+        row = copy.data();
+    }
 
-                size_t tileBytes = static_cast<size_t>(desc.tileWidth) * desc.tileHeight * samples;
-                std::vector<uint8_t> localBuf;
-                const uint8_t* tileData = nullptr;
+    if (desc.predictor == 2) {
+        ImageLoaderSimd::UndoHorizontalPredictor(row, width, samples, px.bytesPerSample, !desc.isLE);
+    } else if (desc.predictor == 3) {
+        UndoFloatPredictor(row, width, samples, px.bytesPerSample, bytePlanes);
+    } else {
+        SwapSampleBytes(row, count, px.bytesPerSample);
+    }
+    return row;
+}
 
-                if (desc.compression == 1) {
-                    if (offset + tileBytes > size) {
-                        decodeFailed = true;
-                        continue;
-                    }
-                    tileData = data + offset;
-                } else if (desc.compression == 32773) {
-                    localBuf.resize(tileBytes);
-                    if (!DecompressPackBits(data + offset, byteCount, localBuf.data(), tileBytes)) {
-                        decodeFailed = true;
-                        continue;
-                    }
-                    tileData = localBuf.data();
-                } else if (desc.compression == 5) {
-                    localBuf.resize(tileBytes);
-                    if (!DecompressLzw(data + offset, byteCount, localBuf.data(), tileBytes)) {
-                        decodeFailed = true;
-                        continue;
-                    }
-                    tileData = localBuf.data();
-                } else if (desc.compression == 8 || desc.compression == 32946) {
-                    localBuf.resize(tileBytes);
-                    if (!DecompressDeflate(data + offset, byteCount, localBuf.data(), tileBytes)) {
-                        decodeFailed = true;
-                        continue;
-                    }
-                    tileData = localBuf.data();
-                }
+// Converts `count` half/single pixels to RGBA of the same type; gray is replicated.
+// Alpha stays straight, like the other float decoders (EXR, WIC half).
+template <typename T>
+static void PackRowToRgbaFloat(const TiffImageDesc& desc, const PixelLayout& px,
+                               const uint8_t* src, T* dst, int count, T one) {
+    const int colorSamples = (desc.photometric == 2) ? 3 : 1;
+    const bool hasAlpha = px.samples > colorSamples;
+    for (int x = 0; x < count; ++x) {
+        const uint8_t* p = src + static_cast<size_t>(x) * px.pixelStride;
+        T c[4];
+        std::memcpy(c, p, sizeof(T) * colorSamples);
+        if (colorSamples == 1) {
+            c[1] = c[0];
+            c[2] = c[0];
+        }
+        if (hasAlpha) {
+            std::memcpy(&c[3], p + sizeof(T) * colorSamples, sizeof(T));
+        } else {
+            c[3] = one;
+        }
+        std::memcpy(dst + static_cast<size_t>(x) * 4, c, sizeof(c));
+    }
+}
 
-                if (!tileData) {
-                    decodeFailed = true;
-                    continue;
-                }
+// Converts `count` pixels at `src` to BGRA. Fails for palette images without a usable ColorMap.
+// 16-bit samples are first narrowed to their 8 MSBs in `rgb8`, so every photometric
+// runs through the same 8-bit SIMD conversions.
+static bool PackRowToBgra(const TiffImageDesc& desc, const PixelLayout& px,
+                          const uint8_t* src, uint8_t* dst, int count, std::vector<uint8_t>& rgb8) {
+    if (desc.photometric == 3 && desc.paletteBgra.empty()) return false;
+    const int samples = px.samples;
+    if (px.bytesPerSample == 2) {
+        const size_t n = static_cast<size_t>(count) * samples;
+        rgb8.resize(n);
+        ImageLoaderSimd::Narrow16To8(src, rgb8.data(), n, px.highByteOffset == 0);
+        src = rgb8.data();
+    }
 
-                // Undo predictor
-                std::vector<uint8_t> predictorBuf;
-                if (predictor == 2) {
-                    if (desc.compression == 1) {
-                        predictorBuf.assign(tileData, tileData + tileBytes);
-                        tileData = predictorBuf.data();
-                    }
-                    uint8_t* mutableData = const_cast<uint8_t*>(tileData);
-                    for (int y = 0; y < (int)desc.tileHeight; ++y) {
-                        uint8_t* rowData = mutableData + y * (desc.tileWidth * pixelStride);
-                        for (int x = 1; x < (int)desc.tileWidth; ++x) {
-                            for (uint32_t c = 0; c < pixelStride; ++c) {
-                                rowData[x * pixelStride + c] += rowData[(x - 1) * pixelStride + c];
-                            }
-                        }
-                    }
-                }
+    switch (desc.photometric) {
+    case 0:
+    case 1:
+        ImageLoaderSimd::GrayToBgra(src, samples, dst, count, desc.photometric == 0);
+        return true;
 
-                // Pack pixels falling into ROI
-                for (int y = intersectY; y < intersectEndY; ++y) {
-                    int localY = y - tileY;
-                    int outY = y - cropY;
-                    const uint8_t* srcRow = tileData + localY * (desc.tileWidth * pixelStride);
-                    uint8_t* dstRow = pixels + outY * outStride;
-
-                    if (photometric == 0 || photometric == 1) {
-                        for (int x = intersectX; x < intersectEndX; ++x) {
-                            int localX = x - tileX;
-                            int outX = x - cropX;
-                            uint8_t val = srcRow[localX * pixelStride + highByteOffset];
-                            if (photometric == 0) val = 255 - val;
-                            dstRow[outX * 4 + 0] = val;
-                            dstRow[outX * 4 + 1] = val;
-                            dstRow[outX * 4 + 2] = val;
-                            dstRow[outX * 4 + 3] = (samples > 1) ? srcRow[localX * pixelStride + bytesPerSample + highByteOffset] : 255;
-                        }
-                    } else if (photometric == 2) {
-                        int runWidth = intersectEndX - intersectX;
-                        // [Titan Perf] SIMD Accelerated 16-to-8 bit downsampling + BGRA Swizzle
-                        // Only applicable when image is RGB (samples == 3) and Little-Endian (highByteOffset == 1)
-                        if (bytesPerSample == 2 && samples == 3 && highByteOffset == 1) {
-                            int localXStart = intersectX - tileX;
-                            int outXStart = intersectX - cropX;
-                            const uint16_t* src16 = reinterpret_cast<const uint16_t*>(srcRow + localXStart * pixelStride);
-                            uint8_t* dst32 = dstRow + outXStart * 4;
-                            
-                            ImageLoaderSimd::Pack16to8(src16, rgb8Buf.data(), runWidth * 3);
-                            ImageLoaderSimd::ConvertRGBToBGRA(rgb8Buf.data(), dst32, runWidth, 1, runWidth * 4);
-                        } else {
-                            for (int x = intersectX; x < intersectEndX; ++x) {
-                                int localX = x - tileX;
-                                int outX = x - cropX;
-                                uint8_t r = srcRow[localX * pixelStride + 0 * bytesPerSample + highByteOffset];
-                                uint8_t g = srcRow[localX * pixelStride + 1 * bytesPerSample + highByteOffset];
-                                uint8_t b = srcRow[localX * pixelStride + 2 * bytesPerSample + highByteOffset];
-                                uint8_t a = (samples >= 4) ? srcRow[localX * pixelStride + 3 * bytesPerSample + highByteOffset] : 255;
-                                if (samples >= 4 && desc.extraSamples != 1) {
-                                    r = static_cast<uint8_t>((r * a + 127) / 255);
-                                    g = static_cast<uint8_t>((g * a + 127) / 255);
-                                    b = static_cast<uint8_t>((b * a + 127) / 255);
-                                }
-                                dstRow[outX * 4 + 0] = b;
-                                dstRow[outX * 4 + 1] = g;
-                                dstRow[outX * 4 + 2] = r;
-                                dstRow[outX * 4 + 3] = a;
-                            }
-                        }
-                    } else if (photometric == 3) {
-                        if (desc.colorMap.size() >= 768) {
-                            for (int x = intersectX; x < intersectEndX; ++x) {
-                                int localX = x - tileX;
-                                int outX = x - cropX;
-                                uint8_t idx = srcRow[localX * pixelStride + highByteOffset];
-                                uint8_t r = static_cast<uint8_t>(desc.colorMap[idx] / 256);
-                                uint8_t g = static_cast<uint8_t>(desc.colorMap[idx + 256] / 256);
-                                uint8_t b = static_cast<uint8_t>(desc.colorMap[idx + 512] / 256);
-                                dstRow[outX * 4 + 0] = b;
-                                dstRow[outX * 4 + 1] = g;
-                                dstRow[outX * 4 + 2] = r;
-                                dstRow[outX * 4 + 3] = 255;
-                            }
-                        } else {
-                            decodeFailed = true;
-                        }
-                    } else if (photometric == 5) {
-                        int localXStart = intersectX - tileX;
-                        int outXStart = intersectX - cropX;
-                        int runWidth = intersectEndX - intersectX;
-                        if (bytesPerSample == 1) {
-                            ConvertCmykToBgra(srcRow + localXStart * pixelStride, dstRow + outXStart * 4, runWidth, samples);
-                        } else {
-                            for (int dx = 0; dx < runWidth; ++dx) {
-                                uint8_t c = srcRow[(localXStart + dx) * pixelStride + 0 * bytesPerSample + highByteOffset];
-                                uint8_t m = srcRow[(localXStart + dx) * pixelStride + 1 * bytesPerSample + highByteOffset];
-                                uint8_t ye = srcRow[(localXStart + dx) * pixelStride + 2 * bytesPerSample + highByteOffset];
-                                uint8_t k = (samples >= 4) ? srcRow[(localXStart + dx) * pixelStride + 3 * bytesPerSample + highByteOffset] : 0;
-                                uint8_t r = (255 - c) * (255 - k) / 255;
-                                uint8_t g = (255 - m) * (255 - k) / 255;
-                                uint8_t b = (255 - ye) * (255 - k) / 255;
-                                dstRow[(outXStart + dx) * 4 + 0] = b;
-                                dstRow[(outXStart + dx) * 4 + 1] = g;
-                                dstRow[(outXStart + dx) * 4 + 2] = r;
-                                dstRow[(outXStart + dx) * 4 + 3] = 255;
-                            }
-                        }
-                    }
-                }
+    case 2:
+        if (samples == 3) {
+            ImageLoaderSimd::ConvertRGBToBGRA(src, dst, count, 1, count * 4);
+            return true;
+        }
+        for (int x = 0; x < count; ++x) {
+            const uint8_t* p = src + static_cast<size_t>(x) * samples;
+            uint8_t r = p[0];
+            uint8_t g = p[1];
+            uint8_t b = p[2];
+            uint8_t a = p[3];
+            if (desc.extraSamples != 1) {
+                r = static_cast<uint8_t>((r * a + 127) / 255);
+                g = static_cast<uint8_t>((g * a + 127) / 255);
+                b = static_cast<uint8_t>((b * a + 127) / 255);
             }
+            dst[x * 4 + 0] = b;
+            dst[x * 4 + 1] = g;
+            dst[x * 4 + 2] = r;
+            dst[x * 4 + 3] = a;
+        }
+        return true;
+
+    case 3:
+        if (samples == 1) {
+            ImageLoaderSimd::PaletteToBgra(src, desc.paletteBgra.data(), dst, count);
+            return true;
+        }
+        for (int x = 0; x < count; ++x) {
+            std::memcpy(dst + x * 4, &desc.paletteBgra[src[static_cast<size_t>(x) * samples]], 4);
+        }
+        return true;
+
+    case 5:
+        ImageLoaderSimd::CmykToBgra(src, samples, dst, count);
+        return true;
+
+    default:
+        return true;
+    }
+}
+
+// Result metadata shared by every decode path (Width/Height are the IFD's own size)
+static void FillTiffMetadata(const TiffImageDesc& desc, QuickView::Codec::DecodeResult& result) {
+    const bool isFloat = desc.sampleFormat == 3;
+    const bool planar = desc.planarConfig == 2 && desc.samples > 1;
+
+    result.metadata.Width = desc.width;
+    result.metadata.Height = desc.height;
+    result.metadata.Format = L"TIFF";
+    
+    wchar_t details[128];
+    const wchar_t* compStr = L"";
+    if (desc.compression == 1) compStr = L"Uncompressed";
+    else if (desc.compression == 32773) compStr = L"PackBits";
+    else if (desc.compression == 5) compStr = L"LZW";
+    else if (desc.compression == 8 || desc.compression == 32946) compStr = L"Deflate";
+    else if (desc.compression == 7) compStr = L"JPEG";
+
+    const wchar_t* photoStr = L"";
+    if (desc.photometric == 0 || desc.photometric == 1) photoStr = L"Grayscale";
+    else if (desc.photometric == 2) photoStr = L"RGB";
+    else if (desc.photometric == 3) photoStr = L"Palette";
+    else if (desc.photometric == 5) photoStr = L"CMYK";
+    else if (desc.photometric == 6) photoStr = L"YCbCr";
+
+    swprintf_s(details, L"%u-bit %ls%ls %ls%ls%ls%ls", static_cast<unsigned>(desc.bitsPerSample),
+               isFloat ? L"Float " : L"", photoStr, compStr, desc.compression == 7 ? L"" : L" Lossless",
+               planar ? L" Planar" : L"", desc.isBigTiff ? L" (BigTIFF)" : L"");
+    result.metadata.FormatDetails = details;
+    result.metadata.ExifOrientation = desc.orientation;
+    result.metadata.LoaderName = L"MiniTIFF";
+
+    if (!desc.iccProfile.empty() && desc.photometric != 5) {
+        result.metadata.iccProfileData.assign(desc.iccProfile.begin(), desc.iccProfile.end());
+        result.metadata.HasEmbeddedColorProfile = true;
     } else {
-        // Strip layout
-        uint32_t rowsPerStrip = desc.rowsPerStrip;
-        if (rowsPerStrip == 0 || rowsPerStrip > desc.height) {
-            rowsPerStrip = desc.height;
+        result.metadata.HasEmbeddedColorProfile = false;
+        result.metadata.colorInfo.dataSpace = QuickView::PixelDataSpace::EncodedSdr;
+    }
+
+    if (isFloat) {
+        // Float TIFFs (HDR merges, renders) are scene-linear, same contract as Radiance HDR / EXR
+        result.metadata.colorInfo.dataSpace = QuickView::PixelDataSpace::SceneLinear;
+        result.metadata.colorInfo.transfer = QuickView::TransferFunction::Linear;
+        result.metadata.colorInfo.primaries = QuickView::ColorPrimaries::SRGB;
+        result.metadata.colorInfo.nominalBitDepth = static_cast<uint8_t>(desc.bitsPerSample);
+        result.metadata.hdrMetadata.isValid = true;
+        result.metadata.hdrMetadata.isHdr = true;
+        result.metadata.hdrMetadata.isSceneLinear = true;
+        result.metadata.hdrMetadata.transfer = QuickView::TransferFunction::Linear;
+    }
+}
+
+// Compression=7: every strip/tile is a baseline JPEG decoded straight to BGRA by turbojpeg.
+// With scaleDenom > 1 the IDCT runs at 1/2, 1/4 or 1/8 and the crop is returned at that
+// reduced size (crop coordinates stay in full-resolution pixels of this IFD).
+static HRESULT DecodeJpegRegion(const uint8_t* data, size_t size, const TiffImageDesc& desc,
+                                const QuickView::Codec::DecodeContext& ctx,
+                                QuickView::Codec::DecodeResult& result,
+                                int cropX, int cropY, int cropW, int cropH, int scaleDenom) {
+    UnitGrid grid;
+    if (!MakeUnitGrid(desc, 1, grid)) {
+        return E_FAIL;
+    }
+    const std::vector<int> units = UnitsInRect(grid, cropX, cropY, cropW, cropH);
+
+    // Crop in scaled pixels, expanded outward so no source pixel is lost
+    const int d = scaleDenom;
+    const int scaledW = static_cast<int>((desc.width + d - 1) / d);
+    const int scaledH = static_cast<int>((desc.height + d - 1) / d);
+    const int sx0 = cropX / d;
+    const int sy0 = cropY / d;
+    const int sx1 = (std::min)(scaledW, (cropX + cropW + d - 1) / d);
+    const int sy1 = (std::min)(scaledH, (cropY + cropH + d - 1) / d);
+    const int outW = sx1 - sx0;
+    const int outH = sy1 - sy0;
+    if (outW <= 0 || outH <= 0) return E_INVALIDARG;
+
+    int outStride = ((outW * 4) + 63) & ~63; // 64-byte aligned
+    size_t totalBytes = static_cast<size_t>(outStride) * outH;
+    uint8_t* pixels = ctx.allocator(totalBytes);
+    if (!pixels) {
+        return E_OUTOFMEMORY;
+    }
+    std::memset(pixels, 0, totalBytes);
+
+    // Tiles decode independently; fan out on large crops like the other codecs
+    const bool useParallel = units.size() >= 2 &&
+                             static_cast<uint64_t>(cropW) * cropH >= kParallelMinPixels;
+    std::atomic<bool> decodeFailed{false};
+
+    ForEachUnit(units, useParallel, ctx.helperThreads, [&](int i, UnitScratch& scratch) {
+        if (decodeFailed.load(std::memory_order_relaxed)) return;
+        if (ctx.checkCancel && ctx.checkCancel()) {
+            decodeFailed = true;
+            return;
         }
 
-        uint32_t stripsCount = (desc.height + rowsPerStrip - 1) / rowsPerStrip;
-        if (desc.offsets.size() < stripsCount || desc.byteCounts.size() < stripsCount) {
-            return E_FAIL;
+        const uint64_t offset = desc.offsets[i];
+        const uint64_t byteCount = desc.byteCounts[i];
+        if (offset > size || byteCount > size - offset) {
+            decodeFailed = true;
+            return;
         }
 
-        [[maybe_unused]] bool useParallel = (stripsCount >= 4 && cropH >= 512);
-        int startStrip = cropY / rowsPerStrip;
-        int endStrip = (cropY + cropH - 1) / rowsPerStrip;
+        int decW = 0;
+        int decH = 0;
+        std::vector<uint8_t>& bgra = scratch.decoded[0];
+        if (!DecompressJpeg(desc.jpegTables.data(), desc.jpegTables.size(), data + offset,
+                            static_cast<size_t>(byteCount), d, scratch.jpegStream, bgra, &decW, &decH)) {
+            decodeFailed = true;
+            return;
+        }
 
-        #pragma omp parallel for if(useParallel) shared(decodeFailed)
-        for (int i = startStrip; i <= endStrip && i < static_cast<int>(stripsCount); ++i) {
-            if (decodeFailed) continue;
+        // Unit origins are MCU multiples, so they divide exactly by the DCT scale
+        const int unitX = static_cast<int>((i % grid.unitsPerRow) * grid.unitW) / d;
+        const int unitY = static_cast<int>((i / grid.unitsPerRow) * grid.unitRows) / d;
+        const int x0 = (std::max)(sx0, unitX);
+        const int x1 = (std::min)(sx1, unitX + decW);
+        const int y0 = (std::max)(sy0, unitY);
+        const int y1 = (std::min)(sy1, unitY + decH);
+        for (int y = y0; y < y1; ++y) {
+            std::memcpy(pixels + static_cast<size_t>(y - sy0) * outStride + static_cast<size_t>(x0 - sx0) * 4,
+                        bgra.data() + (static_cast<size_t>(y - unitY) * decW + (x0 - unitX)) * 4,
+                        static_cast<size_t>((std::max)(0, x1 - x0)) * 4);
+        }
+    });
 
-                if (ctx.checkCancel && ctx.checkCancel()) {
-                    decodeFailed = true;
-                    continue;
-                }
+    if (decodeFailed) {
+        if (ctx.freeFunc) ctx.freeFunc(pixels);
+        return E_FAIL;
+    }
 
-                int startY = i * rowsPerStrip;
-                int unitH = (std::min)(static_cast<int>(rowsPerStrip), static_cast<int>(desc.height) - startY);
+    result.pixels = pixels;
+    result.width = outW;
+    result.height = outH;
+    result.stride = outStride;
+    result.format = PixelFormat::BGRA8888;
+    result.success = true;
 
-                // Y overlap check
-                int intersectY = (std::max)(cropY, startY);
-                int intersectEndY = (std::min)(cropY + cropH, startY + unitH);
+    FillTiffMetadata(desc, result);
+    if (d > 1) {
+        wchar_t scaleInfo[24];
+        swprintf_s(scaleInfo, L" / DCT 1/%d", d);
+        result.metadata.FormatDetails += scaleInfo;
+    }
+    return S_OK;
+}
 
-                if (intersectY >= intersectEndY) {
-                    continue; // Skip strip with no vertical intersection
-                }
+// Decodes a crop of a single (already gated) IFD into BGRA, or RGBA half/float for float samples
+static HRESULT DecodeRegion(const uint8_t* data, size_t size, const TiffImageDesc& desc,
+                            const QuickView::Codec::DecodeContext& ctx,
+                            QuickView::Codec::DecodeResult& result,
+                            int cropX, int cropY, int cropW, int cropH, int scaleDenom = 1) {
+    // Clamp crop parameters to valid boundaries
+    cropX = (std::max)(0, cropX);
+    cropY = (std::max)(0, cropY);
+    cropW = (std::min)(cropW, static_cast<int>(desc.width) - cropX);
+    cropH = (std::min)(cropH, static_cast<int>(desc.height) - cropY);
+    if (cropW <= 0 || cropH <= 0) return E_INVALIDARG;
 
-                uint64_t offset = desc.offsets[i];
-                uint64_t byteCount = desc.byteCounts[i];
-                if (offset + byteCount > size) {
-                    decodeFailed = true;
-                    continue;
-                }
+    if (desc.compression == 7) {
+        return DecodeJpegRegion(data, size, desc, ctx, result, cropX, cropY, cropW, cropH, scaleDenom);
+    }
 
-                size_t stripBytes = static_cast<size_t>(unitH) * rowBytes;
-                std::vector<uint8_t> localBuf;
-                const uint8_t* stripData = nullptr;
+    const PixelLayout px = MakePixelLayout(desc);
 
-                if (desc.compression == 1) {
-                    if (offset + stripBytes > size) {
-                        decodeFailed = true;
-                        continue;
-                    }
-                    stripData = data + offset;
-                } else if (desc.compression == 32773) {
-                    localBuf.resize(stripBytes);
-                    if (!DecompressPackBits(data + offset, byteCount, localBuf.data(), stripBytes)) {
-                        decodeFailed = true;
-                        continue;
-                    }
-                    stripData = localBuf.data();
-                } else if (desc.compression == 5) {
-                    localBuf.resize(stripBytes);
-                    if (!DecompressLzw(data + offset, byteCount, localBuf.data(), stripBytes)) {
-                        decodeFailed = true;
-                        continue;
-                    }
-                    stripData = localBuf.data();
-                } else if (desc.compression == 8 || desc.compression == 32946) {
-                    localBuf.resize(stripBytes);
-                    if (!DecompressDeflate(data + offset, byteCount, localBuf.data(), stripBytes)) {
-                        decodeFailed = true;
-                        continue;
-                    }
-                    stripData = localBuf.data();
-                }
+    // Separate planes store each channel as its own set of strips/tiles
+    const bool planar = desc.planarConfig == 2 && px.samples > 1;
+    const int planes = planar ? px.samples : 1;
+    const int storedSamples = planar ? 1 : px.samples;
+
+    const bool tiled = desc.isTiled;
+    UnitGrid grid;
+    if (!MakeUnitGrid(desc, planes, grid)) {
+        return E_FAIL;
+    }
+    const uint32_t unitW = grid.unitW;
+    const uint32_t unitRows = grid.unitRows;
+    const uint32_t unitsPerRow = grid.unitsPerRow;
+    const uint64_t unitsCount = grid.unitsCount;
+    const size_t unitRowBytes = static_cast<size_t>(unitW) * storedSamples * px.bytesPerSample;
+
+    // Only units intersecting the ROI are decoded
+    const std::vector<int> units = UnitsInRect(grid, cropX, cropY, cropW, cropH);
+
+    // Prepare Output: BGRA8, or RGBA in the sample's own float width
+    PixelFormat outFormat = PixelFormat::BGRA8888;
+    int outBpp = 4;
+    if (px.isFloat) {
+        outFormat = (px.bytesPerSample == 4) ? PixelFormat::R32G32B32A32_FLOAT : PixelFormat::R16G16B16A16_FLOAT;
+        outBpp = px.bytesPerSample * 4;
+    }
+    int outStride = ((cropW * outBpp) + 63) & ~63; // 64-byte aligned
+    size_t totalBytes = static_cast<size_t>(outStride) * cropH;
+    uint8_t* pixels = ctx.allocator(totalBytes);
+    if (!pixels) {
+        return E_OUTOFMEMORY;
+    }
+    std::memset(pixels, 0, totalBytes);
+
+    // Region requests from the tiled view are small and already run in parallel
+    // per tile; only large crops spanning several units fan out here.
+    const bool useParallel = units.size() >= 2 &&
+                             static_cast<uint64_t>(cropW) * cropH >= kParallelMinPixels;
+    std::atomic<bool> decodeFailed{false};
+
+    ForEachUnit(units, useParallel, ctx.helperThreads, [&](int i, UnitScratch& scratch) {
+        if (decodeFailed.load(std::memory_order_relaxed)) return;
+        if (ctx.checkCancel && ctx.checkCancel()) {
+            decodeFailed = true;
+            return;
+        }
+
+        // Locate unit boundary
+        const int unitX = static_cast<int>((i % unitsPerRow) * unitW);
+        const int unitY = static_cast<int>((i / unitsPerRow) * unitRows);
+        const int validH = (std::min)(static_cast<int>(unitRows), static_cast<int>(desc.height) - unitY);
+
+        // Compute Intersection with requested ROI
+        const int intersectX = (std::max)(cropX, unitX);
+        const int intersectEndX = (std::min)({cropX + cropW, unitX + static_cast<int>(unitW), static_cast<int>(desc.width)});
+        const int intersectY = (std::max)(cropY, unitY);
+        const int intersectEndY = (std::min)(cropY + cropH, unitY + validH);
+        if (intersectX >= intersectEndX || intersectY >= intersectEndY) {
+            return;
+        }
 
-                if (!stripData) {
+        // Tiles are always stored full-size; the last strip may be short
+        const size_t unitBytes = unitRowBytes * (tiled ? unitRows : static_cast<uint32_t>(validH));
+        const uint8_t* unitData[kMaxPlanes] = {};
+        bool inPlace[kMaxPlanes] = {}; // Rows are writable (fixups can run in the decode buffer)
+
+        for (int p = 0; p < planes; ++p) {
+            const size_t index = static_cast<size_t>(i) + static_cast<size_t>(p) * unitsCount;
+            const uint64_t offset = desc.offsets[index];
+            const uint64_t byteCount = desc.byteCounts[index];
+            if (offset > size || byteCount > size - offset) {
+                decodeFailed = true;
+                return;
+            }
+
+            if (desc.compression == 1) {
+                // Rows past the ROI are never touched, so only require what is read
+                const size_t needed = unitRowBytes * static_cast<size_t>(intersectEndY - unitY);
+                if (needed > size - offset) {
                     decodeFailed = true;
-                    continue;
+                    return;
                 }
+                unitData[p] = data + offset;
+                continue;
+            }
 
-                // Undo predictor
-                std::vector<uint8_t> predictorBuf;
-                if (predictor == 2) {
-                    if (desc.compression == 1) {
-                        predictorBuf.assign(stripData, stripData + stripBytes);
-                        stripData = predictorBuf.data();
-                    }
-                    uint8_t* mutableData = const_cast<uint8_t*>(stripData);
-                    for (int y = 0; y < (int)unitH; ++y) {
-                        uint8_t* rowData = mutableData + y * rowBytes;
-                        for (int x = 1; x < (int)desc.width; ++x) {
-                            for (uint32_t c = 0; c < pixelStride; ++c) {
-                                rowData[x * pixelStride + c] += rowData[(x - 1) * pixelStride + c];
-                            }
-                        }
-                    }
-                }
+            std::vector<uint8_t>& decoded = scratch.decoded[p];
+            decoded.resize(unitBytes);
+            bool ok = false;
+            if (desc.compression == 32773) {
+                ok = DecompressPackBits(data + offset, byteCount, decoded.data(), unitBytes);
+            } else if (desc.compression == 5) {
+                ok = DecompressLzw(data + offset, byteCount, decoded.data(), unitBytes);
+            } else if (desc.compression == 8 || desc.compression == 32946) {
+                ok = DecompressDeflate(data + offset, byteCount, decoded.data(), unitBytes);
+            }
+            if (!ok) {
+                decodeFailed = true;
+                return;
+            }
+            unitData[p] = decoded.data();
+            inPlace[p] = true;
+        }
 
-                // Pack pixels falling into ROI horizontally
-                for (int y = intersectY; y < intersectEndY; ++y) {
-                    int localY = y - startY;
-                    int outY = y - cropY;
-                    const uint8_t* srcRow = stripData + localY * rowBytes;
-                    uint8_t* dstRow = pixels + outY * outStride;
-
-                    if (photometric == 0 || photometric == 1) {
-                        for (int x = cropX; x < cropX + cropW; ++x) {
-                            int outX = x - cropX;
-                            uint8_t val = srcRow[x * pixelStride + highByteOffset];
-                            if (photometric == 0) val = 255 - val;
-                            dstRow[outX * 4 + 0] = val;
-                            dstRow[outX * 4 + 1] = val;
-                            dstRow[outX * 4 + 2] = val;
-                            dstRow[outX * 4 + 3] = (samples > 1) ? srcRow[x * pixelStride + bytesPerSample + highByteOffset] : 255;
-                        }
-                    } else if (photometric == 2) {
-                        // [Titan Perf] SIMD Accelerated 16-to-8 bit downsampling + BGRA Swizzle for Stripped Layout
-                        if (bytesPerSample == 2 && samples == 3 && highByteOffset == 1) {
-                            const uint16_t* src16 = reinterpret_cast<const uint16_t*>(srcRow + cropX * pixelStride);
-                            ImageLoaderSimd::Pack16to8(src16, rgb8Buf.data(), cropW * 3);
-                            ImageLoaderSimd::ConvertRGBToBGRA(rgb8Buf.data(), dstRow, cropW, 1, cropW * 4);
-                        } else {
-                            for (int x = cropX; x < cropX + cropW; ++x) {
-                                int outX = x - cropX;
-                                uint8_t r = srcRow[x * pixelStride + 0 * bytesPerSample + highByteOffset];
-                                uint8_t g = srcRow[x * pixelStride + 1 * bytesPerSample + highByteOffset];
-                                uint8_t b = srcRow[x * pixelStride + 2 * bytesPerSample + highByteOffset];
-                                uint8_t a = (samples >= 4) ? srcRow[x * pixelStride + 3 * bytesPerSample + highByteOffset] : 255;
-                                if (samples >= 4 && desc.extraSamples != 1) {
-                                    r = static_cast<uint8_t>((r * a + 127) / 255);
-                                    g = static_cast<uint8_t>((g * a + 127) / 255);
-                                    b = static_cast<uint8_t>((b * a + 127) / 255);
-                                }
-                                dstRow[outX * 4 + 0] = b;
-                                dstRow[outX * 4 + 1] = g;
-                                dstRow[outX * 4 + 2] = r;
-                                dstRow[outX * 4 + 3] = a;
-                            }
-                        }
-                    } else if (photometric == 3) {
-                        if (desc.colorMap.size() >= 768) {
-                            for (int x = cropX; x < cropX + cropW; ++x) {
-                                int outX = x - cropX;
-                                uint8_t idx = srcRow[x * pixelStride + highByteOffset];
-                                uint8_t r = static_cast<uint8_t>(desc.colorMap[idx] / 256);
-                                uint8_t g = static_cast<uint8_t>(desc.colorMap[idx + 256] / 256);
-                                uint8_t b = static_cast<uint8_t>(desc.colorMap[idx + 512] / 256);
-                                dstRow[outX * 4 + 0] = b;
-                                dstRow[outX * 4 + 1] = g;
-                                dstRow[outX * 4 + 2] = r;
-                                dstRow[outX * 4 + 3] = 255;
-                            }
-                        } else {
-                            decodeFailed = true;
-                        }
-                    } else if (photometric == 5) {
-                        if (bytesPerSample == 1) {
-                            ConvertCmykToBgra(srcRow + cropX * pixelStride, dstRow, cropW, samples);
-                        } else {
-                            for (int dx = 0; dx < cropW; ++dx) {
-                                uint8_t c = srcRow[(cropX + dx) * pixelStride + 0 * bytesPerSample + highByteOffset];
-                                uint8_t m = srcRow[(cropX + dx) * pixelStride + 1 * bytesPerSample + highByteOffset];
-                                uint8_t ye = srcRow[(cropX + dx) * pixelStride + 2 * bytesPerSample + highByteOffset];
-                                uint8_t k = (samples >= 4) ? srcRow[(cropX + dx) * pixelStride + 3 * bytesPerSample + highByteOffset] : 0;
-                                uint8_t r = (255 - c) * (255 - k) / 255;
-                                uint8_t g = (255 - m) * (255 - k) / 255;
-                                uint8_t b = (255 - ye) * (255 - k) / 255;
-                                dstRow[dx * 4 + 0] = b;
-                                dstRow[dx * 4 + 1] = g;
-                                dstRow[dx * 4 + 2] = r;
-                                dstRow[dx * 4 + 3] = 255;
-                            }
-                        }
-                    }
+        const int localXStart = intersectX - unitX;
+        const int runWidth = intersectEndX - intersectX;
+        for (int y = intersectY; y < intersectEndY; ++y) {
+            const size_t rowOffset = static_cast<size_t>(y - unitY) * unitRowBytes;
+
+            // Predictor and byte-order fixups run per row (ROI rows only), over the full
+            // unit width since the predictor chains from the left edge
+            const uint8_t* srcRow = nullptr;
+            if (!planar) {
+                srcRow = PrepareRow(desc, px, unitData[0] + rowOffset, static_cast<int>(unitW), px.samples,
+                                    inPlace[0], scratch.rows[0], scratch.bytePlanes) +
+                         static_cast<size_t>(localXStart) * px.pixelStride;
+            } else {
+                const uint8_t* planeRows[kMaxPlanes];
+                for (int p = 0; p < planes; ++p) {
+                    planeRows[p] = PrepareRow(desc, px, unitData[p] + rowOffset, static_cast<int>(unitW), 1,
+                                              inPlace[p], scratch.rows[p], scratch.bytePlanes) +
+                                   static_cast<size_t>(localXStart) * px.bytesPerSample;
                 }
+                scratch.interleaved.resize(static_cast<size_t>(runWidth) * px.pixelStride);
+                ImageLoaderSimd::InterleavePlanes(planeRows, planes, px.bytesPerSample,
+                                                  scratch.interleaved.data(), static_cast<size_t>(runWidth));
+                srcRow = scratch.interleaved.data();
             }
-    }
+
+            uint8_t* dstRow = pixels + static_cast<size_t>(y - cropY) * outStride +
+                              static_cast<size_t>(intersectX - cropX) * outBpp;
+            if (outFormat == PixelFormat::R32G32B32A32_FLOAT) {
+                PackRowToRgbaFloat(desc, px, srcRow, reinterpret_cast<float*>(dstRow), runWidth, 1.0f);
+            } else if (outFormat == PixelFormat::R16G16B16A16_FLOAT) {
+                PackRowToRgbaFloat(desc, px, srcRow, reinterpret_cast<uint16_t*>(dstRow), runWidth,
+                                   static_cast<uint16_t>(0x3C00)); // 1.0 in IEEE half
+            } else if (!PackRowToBgra(desc, px, srcRow, dstRow, runWidth, scratch.rgb8)) {
+                decodeFailed = true;
+                return;
+            }
+        }
+    });
 
     if (decodeFailed) {
+        if (ctx.freeFunc) ctx.freeFunc(pixels);
         return E_FAIL;
     }
 
@@ -838,58 +1153,109 @@ HRESULT LoadRegion(const uint8_t* data, size_t size,
     result.width = cropW;
     result.height = cropH;
     result.stride = outStride;
-    result.format = PixelFormat::BGRA8888;
+    result.format = outFormat;
     result.success = true;
 
-    // Setup Metadata
-    result.metadata.Width = desc.width;
-    result.metadata.Height = desc.height;
-    result.metadata.Format = L"TIFF";
-    
-    wchar_t details[128];
-    const wchar_t* compStr = L"";
-    if (desc.compression == 1) compStr = L"Uncompressed";
-    else if (desc.compression == 32773) compStr = L"PackBits";
-    else if (desc.compression == 5) compStr = L"LZW";
-    else if (desc.compression == 8 || desc.compression == 32946) compStr = L"Deflate";
+    FillTiffMetadata(desc, result);
+    return S_OK;
+}
 
-    const wchar_t* photoStr = L"";
-    if (photometric == 0 || photometric == 1) photoStr = L"Grayscale";
-    else if (photometric == 2) photoStr = L"RGB";
-    else if (photometric == 3) photoStr = L"Palette";
-    else if (photometric == 5) photoStr = L"CMYK";
+// DecodeRegion results start at whole pixels (and whole 1/d pixels after IDCT scaling);
+// locates the exact crop (x, y, w, h in `desc` pixels) that was decoded from column
+// x0 / row y0 inside such a result
+static RegionWindow WindowInResult(double x, double y, double w, double h, int x0, int y0, int d) {
+    return { (x - (x0 / d) * d) / d, (y - (y0 / d) * d) / d, w / d, h / d };
+}
 
-    swprintf_s(details, L"8-bit %s %s Lossless", photoStr, compStr);
-    result.metadata.FormatDetails = details;
-    result.metadata.ExifOrientation = desc.orientation;
-    result.metadata.LoaderName = L"MiniTIFF";
+HRESULT LoadRegion(const uint8_t* data, size_t size,
+                   const QuickView::Codec::DecodeContext& ctx,
+                   QuickView::Codec::DecodeResult& result,
+                   int cropX, int cropY, int cropW, int cropH,
+                   float scale, RegionWindow* window) {
+    std::vector<TiffImageDesc> levels;
+    const bool wantsPyramid = (scale > 0.0f && scale < 1.0f);
+    Status status = ParseTiffPyramid(data, size, levels, wantsPyramid);
+    if (status != Status::Ok) {
+        return (status == Status::NotTiff) ? E_NOTIMPL : E_FAIL;
+    }
 
-    if (!desc.iccProfile.empty() && desc.photometric != 5) {
-        result.metadata.iccProfileData.assign(desc.iccProfile.begin(), desc.iccProfile.end());
-        result.metadata.HasEmbeddedColorProfile = true;
-    } else {
-        result.metadata.HasEmbeddedColorProfile = false;
-        result.metadata.colorInfo.dataSpace = QuickView::PixelDataSpace::EncodedSdr;
+    const TiffImageDesc& base = levels[0];
+    status = CapabilityGate(base);
+    if (status != Status::Ok) {
+        return (status == Status::Unsupported) ? E_NOTIMPL : E_FAIL;
     }
 
+    cropX = (std::max)(0, cropX);
+    cropY = (std::max)(0, cropY);
+    cropW = (std::min)(cropW, static_cast<int>(base.width) - cropX);
+    cropH = (std::min)(cropH, static_cast<int>(base.height) - cropY);
+    if (cropW <= 0 || cropH <= 0) return E_INVALIDARG;
+
+    auto decodeBase = [&]() {
+        const int d = SelectDctScale(base, scale);
+        HRESULT hr = DecodeRegion(data, size, base, ctx, result, cropX, cropY, cropW, cropH, d);
+        if (SUCCEEDED(hr) && window) *window = WindowInResult(cropX, cropY, cropW, cropH, cropX, cropY, d);
+        return hr;
+    };
+
+    size_t levelIndex = SelectPyramidLevel(levels, scale);
+    if (levelIndex == 0) return decodeBase();
+
+    // Map the base-level crop onto the selected level (expand outward so no source pixel is lost)
+    const TiffImageDesc& level = levels[levelIndex];
+    const double fx = static_cast<double>(base.width) / level.width;
+    const double fy = static_cast<double>(base.height) / level.height;
+    int lx0 = static_cast<int>(std::floor(cropX / fx));
+    int ly0 = static_cast<int>(std::floor(cropY / fy));
+    int lx1 = (std::min)(static_cast<int>(level.width), static_cast<int>(std::ceil((cropX + cropW) / fx)));
+    int ly1 = (std::min)(static_cast<int>(level.height), static_cast<int>(std::ceil((cropY + cropH) / fy)));
+    lx1 = (std::max)(lx1, lx0 + 1);
+    ly1 = (std::max)(ly1, ly0 + 1);
+
+    const int d = SelectDctScale(level, scale * fx);
+    HRESULT hr = DecodeRegion(data, size, level, ctx, result, lx0, ly0, lx1 - lx0, ly1 - ly0, d);
+    if (FAILED(hr)) {
+        // A damaged reduced level must not hide a healthy base image
+        return decodeBase();
+    }
+    if (window) {
+        // The widened level crop overhangs the requested one by a fraction of a level pixel
+        *window = WindowInResult(cropX / fx, cropY / fy, cropW / fx, cropH / fy, lx0, ly0, d);
+    }
+
+    // Report the true image size; result.width/height hold the level-resolution crop
+    result.metadata.Width = base.width;
+    result.metadata.Height = base.height;
+    wchar_t levelInfo[48];
+    swprintf_s(levelInfo, L" / Pyramid L%zu (%ux%u)", levelIndex, level.width, level.height);
+    result.metadata.FormatDetails += levelInfo;
     return S_OK;
 }
 
 HRESULT Load(const uint8_t* data, size_t size,
              const QuickView::Codec::DecodeContext& ctx,
              QuickView::Codec::DecodeResult& result) {
-    TiffImageDesc desc;
-    Status status = ParseTiffIFD(data, size, desc);
+    std::vector<TiffImageDesc> levels;
+    Status status = ParseTiffPyramid(data, size, levels, false);
     if (status != Status::Ok) {
         return (status == Status::NotTiff) ? E_NOTIMPL : E_FAIL;
     }
 
-    status = CapabilityGate(desc);
+    status = CapabilityGate(levels[0]);
     if (status != Status::Ok) {
         return (status == Status::Unsupported) ? E_NOTIMPL : E_FAIL;
     }
 
-    return LoadRegion(data, size, ctx, result, 0, 0, desc.width, desc.height);
+    return DecodeRegion(data, size, levels[0], ctx, result, 0, 0, levels[0].width, levels[0].height);
+}
+
+bool GetImageSize(const uint8_t* data, size_t size, uint32_t* width, uint32_t* height) {
+    std::vector<TiffImageDesc> levels;
+    if (ParseTiffPyramid(data, size, levels, false) != Status::Ok) return false;
+    if (levels[0].width == 0 || levels[0].height == 0) return false;
+    if (width) *width = levels[0].width;
+    if (height) *height = levels[0].height;
+    return true;
 }
 
 } // namespace QuickView::MiniTiff
@@ -18,8 +18,9 @@
 
 #pragma once
 
-#include "ImageLoader.h"
+#include "CodecTypes.h"
 #include <cstdint>
+#include <vector>
 
 namespace QuickView::MiniTiff {
 
@@ -33,20 +34,52 @@ enum class Status : uint8_t {
 };
 
 // Main entry point for ImageLoader.cpp
+// Integer samples decode to BGRA8888; float samples (SampleFormat=3) stay scene-linear
+// as R32G32B32A32_FLOAT (32-bit) or R16G16B16A16_FLOAT (16-bit half).
 HRESULT Load(const uint8_t* data, size_t size,
              const QuickView::Codec::DecodeContext& ctx,
              QuickView::Codec::DecodeResult& result);
 
-// Entry point for Region ROI decoding
+// Where the requested crop lies inside LoadRegion's result, in result pixels.
+// Fractional when a pyramid level or IDCT scaling widened the crop to whole pixels.
+struct RegionWindow {
+    double x = 0.0;
+    double y = 0.0;
+    double width = 0.0;
+    double height = 0.0;
+};
+
+// Entry point for Region ROI decoding.
+// Crop is in full-resolution coordinates. With scale < 1 the coarsest pyramid level
+// (SubIFD / chained IFD) that still covers the scale is decoded, and JPEG levels are
+// further reduced 2x/4x/8x in the IDCT, so result.width/height may be smaller than
+// cropW/cropH; metadata.Width/Height always report the base image.
+// A level crop is widened to whole level pixels; `window` (optional) receives the
+// exact crop within it, to be resampled with ImageLoaderSimd::ResizeRegion.
 HRESULT LoadRegion(const uint8_t* data, size_t size,
                    const QuickView::Codec::DecodeContext& ctx,
                    QuickView::Codec::DecodeResult& result,
-                   int cropX, int cropY, int cropW, int cropH);
+                   int cropX, int cropY, int cropW, int cropH,
+                   float scale = 1.0f, RegionWindow* window = nullptr);
+
+// Header-only size probe (classic TIFF and BigTIFF), no WIC round-trip
+bool GetImageSize(const uint8_t* data, size_t size, uint32_t* width, uint32_t* height);
 
 // Internal helper for Phase 3 CMYK to BGRA conversion
 void ConvertCmykToBgra(const uint8_t* src, uint8_t* dst, int width, int samples);
 
-// Internal helper for Phase 1 LZW decompression
+// Internal helper for Phase 1 LZW decompression. Table-driven: each code copies its
+// whole string from earlier output; no heap allocations.
 bool DecompressLzw(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen);
 
+// Prefix-chain LZW decoder with identical results; reference for differential tests.
+bool DecompressLzwReference(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen);
+
+// Internal helper for JPEG (Compression=7) strips/tiles. Splices the shared JPEGTables
+// stream (may be empty) in front of the unit via `stream`, then decodes it to BGRA at
+// 1/scaleDenom (1, 2, 4 or 8) into `bgra`, tightly packed at *width x *height.
+bool DecompressJpeg(const uint8_t* tables, size_t tablesLen, const uint8_t* src, size_t srcLen,
+                    int scaleDenom, std::vector<uint8_t>& stream, std::vector<uint8_t>& bgra,
+                    int* width, int* height);
+
 } // namespace QuickView::MiniTiff
@@ -18,27 +18,13 @@
 
 #include "pch.h"
 #include "MiniTiff.h"
+#include "ImageLoaderSimd.h"
 
 namespace QuickView::MiniTiff {
 
+// Exact /255 with rounding, vectorized for 4-sample pixels; extra samples are skipped
 void ConvertCmykToBgra(const uint8_t* src, uint8_t* dst, int width, int samples) {
-    for (int x = 0; x < width; ++x) {
-        uint8_t c = src[x * samples + 0];
-        uint8_t m = src[x * samples + 1];
-        uint8_t y = src[x * samples + 2];
-        uint8_t k = src[x * samples + 3];
-
-        uint32_t invK = 255 - k;
-        uint32_t rTemp = (255 - c) * invK;
-        uint32_t gTemp = (255 - m) * invK;
-        uint32_t bTemp = (255 - y) * invK;
-
-        // Mathematical fixed-point division by 255 with 100% precision: (val + 128 + (val >> 8)) >> 8
-        dst[x * 4 + 0] = static_cast<uint8_t>((bTemp + 128 + (bTemp >> 8)) >> 8); // B
-        dst[x * 4 + 1] = static_cast<uint8_t>((gTemp + 128 + (gTemp >> 8)) >> 8); // G
-        dst[x * 4 + 2] = static_cast<uint8_t>((rTemp + 128 + (rTemp >> 8)) >> 8); // R
-        dst[x * 4 + 3] = 255;
-    }
+    ImageLoaderSimd::CmykToBgra(src, samples, dst, width);
 }
 
 } // namespace QuickView::MiniTiff
@@ -0,0 +1,92 @@
+/*
+ * QuickView Mini TIFF Decoder - JPEG (Compression=7) unit decoding
+ * Copyright (C) 2026-Present QuickView Contributors
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#include "MiniTiff.h"
+#include <cstring>
+#include <turbojpeg.h>
+
+namespace QuickView::MiniTiff {
+
+namespace {
+
+// One handle per decoding thread (Titan workers decode many tiles back to back)
+struct TjDecompressor {
+    tjhandle h;
+    TjDecompressor() { h = tj3Init(TJINIT_DECOMPRESS); }
+    ~TjDecompressor() {
+        if (h) tj3Destroy(h);
+    }
+};
+
+} // namespace
+
+bool DecompressJpeg(const uint8_t* tables, size_t tablesLen, const uint8_t* src, size_t srcLen,
+                    int scaleDenom, std::vector<uint8_t>& stream, std::vector<uint8_t>& bgra,
+                    int* width, int* height) {
+    static thread_local TjDecompressor t_tj;
+    tjhandle tj = t_tj.h;
+    if (!tj || !src || srcLen < 4 || src[0] != 0xFF || src[1] != 0xD8) {
+        return false;
+    }
+
+    // JPEGTables is an SOI..EOI stream holding only DQT/DHT; units are abbreviated
+    // SOI..EOI streams. Tables without their EOI + unit without its SOI = full JPEG.
+    const uint8_t* jpeg = src;
+    size_t jpegLen = srcLen;
+    if (tables && tablesLen >= 4 && tables[0] == 0xFF && tables[1] == 0xD8) {
+        size_t tableBytes = tablesLen;
+        if (tables[tablesLen - 2] == 0xFF && tables[tablesLen - 1] == 0xD9) {
+            tableBytes -= 2;
+        }
+        stream.resize(tableBytes + srcLen - 2);
+        std::memcpy(stream.data(), tables, tableBytes);
+        std::memcpy(stream.data() + tableBytes, src + 2, srcLen - 2);
+        jpeg = stream.data();
+        jpegLen = stream.size();
+    }
+
+    if (tj3DecompressHeader(tj, jpeg, jpegLen) != 0) {
+        return false;
+    }
+    const int w = tj3Get(tj, TJPARAM_JPEGWIDTH);
+    const int h = tj3Get(tj, TJPARAM_JPEGHEIGHT);
+    if (w <= 0 || h <= 0) {
+        return false;
+    }
+
+    // The scaling factor persists on the handle, so it is set for every unit
+    const tjscalingfactor sf = {1, scaleDenom};
+    if (tj3SetScalingFactor(tj, sf) != 0) {
+        return false;
+    }
+    const int outW = TJSCALED(w, sf);
+    const int outH = TJSCALED(h, sf);
+    bgra.resize(static_cast<size_t>(outW) * outH * 4);
+    // Warnings (e.g. a truncated final MCU in an edge tile) still leave usable pixels
+    if (tj3Decompress8(tj, jpeg, jpegLen, bgra.data(), outW * 4, TJPF_BGRA) != 0 &&
+        tj3GetErrorCode(tj) != TJERR_WARNING) {
+        return false;
+    }
+
+    *width = outW;
+    *height = outH;
+    return true;
+}
+
+} // namespace QuickView::MiniTiff
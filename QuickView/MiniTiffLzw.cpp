@@ -19,11 +19,15 @@
 #include "pch.h"
 #include "MiniTiff.h"
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <limits>
 
 namespace QuickView::MiniTiff {
 
-bool DecompressLzw(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen) {
+// Prefix-chain decoder: rebuilds each string backwards on a stack, one byte per step.
+// Kept as the oracle for the differential test of DecompressLzw.
+bool DecompressLzwReference(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen) {
     if (srcLen == 0 || dstLen == 0 || !src || !dst) {
         return false;
     }
@@ -187,4 +191,148 @@ bool DecompressLzw(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLe
     return true;
 }
 
+static inline uint64_t LoadBE64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+#if defined(_MSC_VER)
+    return _byteswap_uint64(v);
+#else
+    return __builtin_bswap64(v);
+#endif
+}
+
+// Copies an earlier occurrence of a string (`from` ends at or before `to`). Short strings
+// move as two 8-byte words, which may spill past the string into output not yet written.
+static inline void CopyString(uint8_t* to, const uint8_t* from, size_t len, bool hasSlack) {
+    if (hasSlack && len <= 16) {
+        uint64_t a, b;
+        std::memcpy(&a, from, 8);
+        std::memcpy(&b, from + 8, 8);
+        std::memcpy(to, &a, 8);
+        std::memcpy(to + 8, &b, 8);
+    } else {
+        std::memcpy(to, from, len);
+    }
+}
+
+// Every dictionary string is a previously decoded string plus one byte, so it already
+// exists in the output: a code stores where (position, length, first byte) instead of a
+// prefix chain, and decoding it is a single copy from earlier output.
+bool DecompressLzw(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen) {
+    if (srcLen == 0 || dstLen == 0 || !src || !dst) {
+        return false;
+    }
+    if (dstLen > (std::numeric_limits<uint32_t>::max)()) {
+        return DecompressLzwReference(src, srcLen, dst, dstLen);
+    }
+
+    // Stack-allocated code table (No heap allocations)
+    uint32_t stringPos[4096];
+    uint16_t stringLen[4096];
+    uint8_t firstByte[4096];
+    for (uint32_t i = 0; i < 256; ++i) {
+        stringLen[i] = 1;
+        firstByte[i] = static_cast<uint8_t>(i);
+    }
+
+    uint32_t nextCode = 258;
+    uint32_t codeSize = 9;
+
+    // MSB-first bit reader, bits left-aligned in `bitBuffer`. While 8 input bytes remain
+    // the refill is a single unaligned load: bytes already (partially) held are reloaded
+    // at the same bit positions, so OR-ing them in again is harmless.
+    size_t srcIdx = 0;
+    uint64_t bitBuffer = 0;
+    uint32_t bitCount = 0;
+
+    size_t dstIdx = 0;
+    int32_t oldCode = -1;
+    size_t oldPos = 0;
+
+    while (dstIdx < dstLen) {
+        if (srcIdx + 8 <= srcLen) {
+            bitBuffer |= LoadBE64(src + srcIdx) >> bitCount;
+            srcIdx += (63 - bitCount) >> 3;
+            bitCount |= 56;
+        } else {
+            while (bitCount <= 56 && srcIdx < srcLen) {
+                bitBuffer |= static_cast<uint64_t>(src[srcIdx++]) << (56 - bitCount);
+                bitCount += 8;
+            }
+            if (bitCount < codeSize) {
+                break; // Out of bitstream bytes
+            }
+        }
+
+        const uint32_t code = static_cast<uint32_t>(bitBuffer >> (64 - codeSize));
+        bitBuffer <<= codeSize;
+        bitCount -= codeSize;
+
+        if (code == 257) { // End of information
+            break;
+        }
+        if (code == 256) { // Clear Code
+            nextCode = 258;
+            codeSize = 9;
+            oldCode = -1;
+            continue;
+        }
+
+        const size_t start = dstIdx;
+        if (oldCode == -1) {
+            if (code >= 256) {
+                return false; // Invalid first code
+            }
+            dst[dstIdx++] = static_cast<uint8_t>(code);
+            oldCode = static_cast<int32_t>(code);
+            oldPos = start;
+            continue;
+        }
+
+        if (code < 256) {
+            dst[dstIdx++] = static_cast<uint8_t>(code);
+        } else if (code < nextCode) {
+            const size_t len = stringLen[code];
+            if (len > dstLen - dstIdx) {
+                return false; // Out of output bounds
+            }
+            CopyString(dst + dstIdx, dst + stringPos[code], len, dstLen - dstIdx >= 16);
+            dstIdx += len;
+        } else if (code == nextCode) {
+            // KwKwK: the previous string plus its own first byte
+            const size_t len = stringLen[oldCode];
+            if (len + 1 > dstLen - dstIdx) {
+                return false;
+            }
+            CopyString(dst + dstIdx, dst + oldPos, len, dstLen - dstIdx >= 16);
+            dstIdx += len;
+            dst[dstIdx++] = firstByte[oldCode];
+        } else {
+            return false; // Code > nextCode (Corrupt)
+        }
+
+        // Add previous string + first byte of this one; it starts where the previous did
+        if (nextCode < 4096) {
+            stringPos[nextCode] = static_cast<uint32_t>(oldPos);
+            stringLen[nextCode] = static_cast<uint16_t>(stringLen[oldCode] + 1);
+            firstByte[nextCode] = firstByte[oldCode];
+            nextCode++;
+
+            // TIFF LZW bit-width adjustment (one code early)
+            if (nextCode == 511 || nextCode == 1023 || nextCode == 2047) {
+                codeSize = (std::min)(codeSize + 1, 12u);
+            }
+        }
+
+        oldCode = static_cast<int32_t>(code);
+        oldPos = start;
+    }
+
+    if (dstIdx != dstLen) {
+        std::memset(dst + dstIdx, 0, dstLen - dstIdx);
+    }
+
+    return true;
+}
+
 } // namespace QuickView::MiniTiff
@@ -0,0 +1,121 @@
+#include "pch.h"
+#include "MipChain.h"
+#include "ImageLoaderSimd.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace QuickView {
+namespace MipChain {
+
+namespace {
+
+constexpr int kHalfTile = TILE_SIZE / 2;
+constexpr int kTileStride = TILE_SIZE * 4;
+
+using FrameMap = std::unordered_map<TileKey, std::shared_ptr<RawImageFrame>, TileKey::Hash>;
+
+bool Usable(const RawImageFrame* frame, int w, int h) {
+    return frame && frame->pixels && frame->format == PixelFormat::BGRA8888 &&
+           frame->width >= w && frame->height >= h;
+}
+
+TileKey Child(TileKey key, int i, int j) {
+    return TileKey::From((int)key.x() * 2 + i, (int)key.y() * 2 + j, (int)key.level() - 1);
+}
+
+// Pass 1: fetch every frame the build reads, descending where a child is missing.
+// Holding the shared_ptrs keeps the frames alive if the tiles are evicted meanwhile.
+bool Collect(TileKey key, int imageW, int imageH, const TileFetch& fetch, int depth, FrameMap& leaves) {
+    for (int j = 0; j < 2; ++j) {
+        for (int i = 0; i < 2; ++i) {
+            const TileKey child = Child(key, i, j);
+            int cw = 0, ch = 0;
+            TileContentSize(imageW, imageH, child, &cw, &ch);
+            if (cw <= 0 || ch <= 0) continue; // Parent on the layer edge
+
+            auto frame = fetch(child);
+            if (Usable(frame.get(), cw, ch)) {
+                leaves.emplace(child, std::move(frame));
+                continue;
+            }
+            if (depth <= 1 || child.level() == 0) return false;
+            if (!Collect(child, imageW, imageH, fetch, depth - 1, leaves)) return false;
+        }
+    }
+    return true;
+}
+
+// Pass 2: reduce fetched children, building the missing ones in temporary slabs
+bool Reduce(TileKey key, int imageW, int imageH, const FrameMap& leaves, TileMemoryManager& memory,
+            uint8_t* parent) {
+    for (int j = 0; j < 2; ++j) {
+        for (int i = 0; i < 2; ++i) {
+            const TileKey child = Child(key, i, j);
+            int cw = 0, ch = 0;
+            TileContentSize(imageW, imageH, child, &cw, &ch);
+            if (cw <= 0 || ch <= 0) continue;
+
+            auto it = leaves.find(child);
+            if (it != leaves.end()) {
+                const RawImageFrame& f = *it->second;
+                ReduceIntoQuadrant(f.pixels, f.stride, cw, ch, parent, kTileStride, i, j);
+                continue;
+            }
+            // Only the content area is written and read back: no clearing needed
+            auto temp = memory.AllocateSmart(TILE_SLAB_SIZE);
+            if (!temp) return false;
+            if (!Reduce(child, imageW, imageH, leaves, memory, temp.get())) return false;
+            ReduceIntoQuadrant(temp.get(), kTileStride, cw, ch, parent, kTileStride, i, j);
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+void TileContentSize(int imageW, int imageH, TileKey key, int* outW, int* outH) {
+    const int lod = (int)key.level();
+    const int64_t layerW = ((int64_t)imageW + (1LL << lod) - 1) >> lod;
+    const int64_t layerH = ((int64_t)imageH + (1LL << lod) - 1) >> lod;
+    *outW = (int)std::clamp<int64_t>(layerW - (int64_t)key.x() * TILE_SIZE, 0, TILE_SIZE);
+    *outH = (int)std::clamp<int64_t>(layerH - (int64_t)key.y() * TILE_SIZE, 0, TILE_SIZE);
+}
+
+void ReduceIntoQuadrant(const uint8_t* child, int childStride, int childW, int childH,
+                        uint8_t* parent, int parentStride, int qx, int qy) {
+    uint8_t* dst = parent + (size_t)qy * kHalfTile * parentStride + (size_t)qx * kHalfTile * 4;
+    ImageLoaderSimd::Downsample2x(child, childW, childH, childStride, dst, parentStride);
+}
+
+bool BuildFromDescendants(TileKey key, int imageW, int imageH, const TileFetch& fetch,
+                          TileMemoryManager& memory, RawImageFrame& out, int maxDepth) {
+    if (key.level() == 0 || key.level() > (uint32_t)MAX_LOD_LEVELS || maxDepth < 1) return false;
+    int w = 0, h = 0;
+    TileContentSize(imageW, imageH, key, &w, &h);
+    if (w <= 0 || h <= 0) return false;
+
+    FrameMap leaves;
+    if (!Collect(key, imageW, imageH, fetch, maxDepth, leaves)) return false;
+
+    auto* slab = (uint8_t*)memory.Allocate(TILE_SLAB_SIZE);
+    if (!slab) return false;
+    std::memset(slab, 0, TILE_SLAB_SIZE); // Edge tiles: padding stays zero, as in decoded tiles
+    if (!Reduce(key, imageW, imageH, leaves, memory, slab)) {
+        memory.Free(slab);
+        return false;
+    }
+
+    out.pixels = slab;
+    out.width = TILE_SIZE;
+    out.height = TILE_SIZE;
+    out.stride = kTileStride;
+    out.format = PixelFormat::BGRA8888;
+    out.memoryDeleter.ctx = &memory;
+    out.memoryDeleter.pfn = [](uint8_t* p, void* c) { static_cast<TileMemoryManager*>(c)->Free(p); };
+    return true;
+}
+
+} // namespace MipChain
+} // namespace QuickView
@@ -0,0 +1,44 @@
+#pragma once
+#include "pch.h"
+#include "TileTypes.h"
+#include "TileMemoryManager.h"
+#include <functional>
+#include <memory>
+
+namespace QuickView {
+
+    // ============================================================================
+    // [Mip Chain] LOD tiles reduced from the tiles one level finer
+    // ============================================================================
+    // A LOD l+1 tile covers exactly the 2x2 block of LOD l tiles beneath it, so it
+    // can be built by 2x box-reducing each child into one quadrant of a slab,
+    // without decoding the source again. Missing children may themselves be built
+    // from their own children, up to `maxDepth` levels down (4^depth leaves).
+    //
+    // Layer geometry matches TileManager::Initialize: LOD l is ceil(W / 2^l) x
+    // ceil(H / 2^l) pixels in TILE_SIZE tiles; edge tiles are zero-padded slabs.
+    // ============================================================================
+    namespace MipChain {
+
+        // Ready BGRA8888 frame for a tile key, or nullptr (not decoded / evicted)
+        using TileFetch = std::function<std::shared_ptr<RawImageFrame>(TileKey)>;
+
+        static constexpr int kDefaultMaxDepth = 3;
+
+        // Valid (non-padding) pixels of a tile; 0 x 0 for tiles outside the layer
+        void TileContentSize(int imageW, int imageH, TileKey key, int* outW, int* outH);
+
+        // 2x-reduces `childW` x `childH` pixels of one child into quadrant (qx, qy)
+        // of a TILE_SIZE x TILE_SIZE parent
+        void ReduceIntoQuadrant(const uint8_t* child, int childStride, int childW, int childH,
+                                uint8_t* parent, int parentStride, int qx, int qy);
+
+        // Builds `key` (level >= 1) into a zero-padded slab from `memory`. Returns false,
+        // leaving `out` untouched, if any needed descendant is unavailable.
+        bool BuildFromDescendants(TileKey key, int imageW, int imageH, const TileFetch& fetch,
+                                  TileMemoryManager& memory, RawImageFrame& out,
+                                  int maxDepth = kDefaultMaxDepth);
+
+    } // namespace MipChain
+
+} // namespace QuickView
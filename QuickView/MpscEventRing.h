@@ -0,0 +1,102 @@
+#pragma once
+#include "pch.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace QuickView {
+
+    // ============================================================================
+    // [Titan Perf] Bounded MPSC ring of preallocated event slots
+    // ============================================================================
+    // Worker threads publish results; one consumer (the UI thread in PollState)
+    // drains them. Slots are allocated once and events are move-assigned in and out,
+    // so a tile storm costs no queue-node allocations and no lock. Each slot carries
+    // a small tag next to its payload: the consumer asks `isStale(tag)` before
+    // touching the event and drops stale results in place (payload released on the
+    // consumer, never handed to the caller).
+    // Per-slot sequence numbers (Vyukov's bounded queue): a producer claims a slot
+    // with one CAS on the tail, writes it, then publishes the slot's sequence.
+    // TryPush fails when the ring is full; callers keep a fallback path.
+    template<typename T, typename Tag>
+    class MpscEventRing {
+    public:
+        explicit MpscEventRing(size_t capacity) {
+            size_t cap = 2;
+            while (cap < capacity) cap <<= 1;
+            m_mask = cap - 1;
+            m_slots = std::make_unique<Slot[]>(cap);
+            for (size_t i = 0; i < cap; ++i) {
+                m_slots[i].seq.store(i, std::memory_order_relaxed);
+            }
+        }
+        MpscEventRing(const MpscEventRing&) = delete;
+        MpscEventRing& operator=(const MpscEventRing&) = delete;
+
+        size_t Capacity() const { return m_mask + 1; }
+
+        // Any thread. On failure (ring full) `value` is left untouched.
+        bool TryPush(T& value, const Tag& tag) {
+            uint64_t pos = m_tail.load(std::memory_order_relaxed);
+            Slot* slot;
+            for (;;) {
+                slot = &m_slots[pos & m_mask];
+                const uint64_t seq = slot->seq.load(std::memory_order_acquire);
+                const int64_t diff = (int64_t)(seq - pos);
+                if (diff == 0) {
+                    if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    return false; // Consumer has not released this slot yet
+                } else {
+                    pos = m_tail.load(std::memory_order_relaxed);
+                }
+            }
+            slot->tag = tag;
+            slot->value = std::move(value);
+            slot->seq.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer thread only. Hands fresh events to `sink(T&&, const Tag&)` in
+        // publication order; returns how many stale events were dropped.
+        // Stops at the first slot still being written, so a slow producer delays
+        // later events by one drain at most.
+        template<typename IsStale, typename Sink>
+        size_t Drain(IsStale isStale, Sink sink) {
+            size_t dropped = 0;
+            for (;;) {
+                Slot& slot = m_slots[m_head & m_mask];
+                if (slot.seq.load(std::memory_order_acquire) != m_head + 1) break;
+                // Move out first so the slot never pins a payload, whatever the sink does
+                T value = std::move(slot.value);
+                if (isStale(slot.tag)) {
+                    dropped++; // Payload released here, on the consumer
+                } else {
+                    sink(std::move(value), slot.tag);
+                }
+                slot.seq.store(m_head + m_mask + 1, std::memory_order_release);
+                m_head++;
+            }
+            return dropped;
+        }
+
+        // Consumer thread only; approximate while producers are mid-publish
+        bool EmptyApprox() const {
+            return m_tail.load(std::memory_order_acquire) == m_head;
+        }
+
+    private:
+        struct alignas(64) Slot {
+            std::atomic<uint64_t> seq{ 0 };
+            Tag tag{};
+            T value{};
+        };
+
+        std::unique_ptr<Slot[]> m_slots;
+        size_t m_mask = 0;
+        alignas(64) std::atomic<uint64_t> m_tail{ 0 };
+        alignas(64) uint64_t m_head = 0; // Consumer-owned
+    };
+
+} // namespace QuickView
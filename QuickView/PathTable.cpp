@@ -0,0 +1,69 @@
+#include "pch.h"
+#include "PathTable.h"
+
+#include <cstring>
+#include <mutex>
+
+namespace QuickView {
+
+PathTable& PathTable::Instance() {
+    static PathTable* s_table = new PathTable();
+    return *s_table;
+}
+
+PathRef PathTable::Intern(std::wstring_view path) {
+    if (path.empty()) return {};
+    const ImageID id = ComputePathHash(path);
+    {
+        std::shared_lock lock(m_mutex);
+        auto it = m_entries.find(id);
+        if (it != m_entries.end()) return { id, it->second };
+    }
+
+    std::unique_lock lock(m_mutex);
+    auto it = m_entries.find(id); // Raced with another first-time caller
+    if (it != m_entries.end()) return { id, it->second };
+    const std::wstring_view stored = StoreLocked(path);
+    m_entries.emplace(id, stored);
+    return { id, stored };
+}
+
+std::wstring_view PathTable::Find(ImageID id) const {
+    std::shared_lock lock(m_mutex);
+    auto it = m_entries.find(id);
+    return it != m_entries.end() ? it->second : std::wstring_view{};
+}
+
+PathTable::Stats PathTable::GetStats() const {
+    std::shared_lock lock(m_mutex);
+    Stats s;
+    s.entries = m_entries.size();
+    s.blocks = m_blocks.size();
+    s.arenaBytes = m_arenaChars * sizeof(wchar_t);
+    return s;
+}
+
+std::wstring_view PathTable::StoreLocked(std::wstring_view path) {
+    const size_t need = path.size() + 1; // Terminator: views double as C strings
+    wchar_t* dst = nullptr;
+    if (need > kBlockChars / 4) {
+        // Very long path (\\?\ prefix, deep archive entry): a block of its own,
+        // the shared block keeps filling
+        m_blocks.push_back(std::make_unique<wchar_t[]>(need));
+        dst = m_blocks.back().get();
+    } else {
+        if (!m_current || kBlockChars - m_blockUsed < need) {
+            m_blocks.push_back(std::make_unique<wchar_t[]>(kBlockChars));
+            m_current = m_blocks.back().get();
+            m_blockUsed = 0;
+        }
+        dst = m_current + m_blockUsed;
+        m_blockUsed += need;
+    }
+    std::memcpy(dst, path.data(), path.size() * sizeof(wchar_t));
+    dst[path.size()] = L'\0';
+    m_arenaChars += need;
+    return { dst, path.size() };
+}
+
+} // namespace QuickView
@@ -0,0 +1,87 @@
+#pragma once
+#include "pch.h"
+#include <cwctype>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// [ImageID Architecture] Stable content-based unique identifier
+using ImageID = size_t;  // 64-bit path hash
+
+// Helper: Compute normalized path hash (case-insensitive for Windows).
+// Lower-cases into a stack buffer: same value as hashing a lowered std::wstring copy.
+inline ImageID ComputePathHash(std::wstring_view path) {
+    wchar_t lowered[512];
+    if (path.size() <= std::size(lowered)) {
+        for (size_t i = 0; i < path.size(); ++i) lowered[i] = (wchar_t)::towlower(path[i]);
+        return std::hash<std::wstring_view>{}(std::wstring_view(lowered, path.size()));
+    }
+    std::wstring normalized(path);
+    std::transform(normalized.begin(), normalized.end(), normalized.begin(), ::towlower);
+    return std::hash<std::wstring>{}(normalized);
+}
+
+namespace QuickView {
+
+    // An interned path: the ImageID plus the table's copy of the spelling.
+    // The view is null-terminated and stays valid for the lifetime of the process.
+    struct PathRef {
+        ImageID id = 0;
+        std::wstring_view path;
+
+        bool empty() const { return path.empty(); }
+        const wchar_t* c_str() const { return path.empty() ? L"" : path.data(); }
+    };
+
+    // ============================================================================
+    // [Path Table] Process-wide interned file paths
+    // ============================================================================
+    // Engine queues, events and caches carry an ImageID and a view into this table
+    // instead of their own std::wstring copies, so a navigation step or a tile
+    // result moves no path bytes and allocates nothing once the path is known.
+    //
+    // Strings live in append-only 64 KB blocks and are never freed: the table
+    // grows with the number of distinct images opened in the session (a few MB
+    // for tens of thousands of files). Spellings that hash to the same ImageID
+    // (case variants of one path) share the first spelling interned.
+    // ============================================================================
+    class PathTable {
+    public:
+        static constexpr size_t kBlockChars = 32 * 1024; // 64 KB of wchar_t
+
+        PathTable() = default;
+        PathTable(const PathTable&) = delete;
+        PathTable& operator=(const PathTable&) = delete;
+
+        // The engine's table. Never destroyed: views may be read during static teardown.
+        static PathTable& Instance();
+
+        // Known paths cost one hash and a shared-lock lookup
+        PathRef Intern(std::wstring_view path);
+
+        // Interned spelling for an ID; empty if the ID was never interned
+        std::wstring_view Find(ImageID id) const;
+
+        struct Stats {
+            size_t entries = 0;
+            size_t blocks = 0;
+            size_t arenaBytes = 0; // Bytes of path text held (including terminators)
+        };
+        Stats GetStats() const;
+
+    private:
+        std::wstring_view StoreLocked(std::wstring_view path);
+
+        mutable std::shared_mutex m_mutex;
+        std::unordered_map<ImageID, std::wstring_view> m_entries;
+        std::vector<std::unique_ptr<wchar_t[]>> m_blocks;
+        wchar_t* m_current = nullptr; // Shared block being filled
+        size_t m_blockUsed = 0;       // Chars used in m_current
+        size_t m_arenaChars = 0;
+    };
+
+} // namespace QuickView
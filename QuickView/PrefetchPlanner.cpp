@@ -0,0 +1,190 @@
+#include "pch.h"
+#include "PrefetchPlanner.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace QuickView {
+
+namespace {
+
+// Priors until the first decodes of a tier complete (libjpeg-turbo class decoder)
+constexpr double kDefaultFullMsPerMP = 12.0;
+constexpr double kDefaultScaledShare = 0.3;   // Scaled decode vs full, same source
+constexpr double kDefaultPreviewMs = 15.0;
+constexpr double kFixedMs = 4.0;              // Open + header + hand-off per job
+
+double OutputBytes(PrefetchTier tier, double megapixels, double screenMegapixels) {
+    const double mp = tier == PrefetchTier::Full ? megapixels : (std::min)(megapixels, screenMegapixels);
+    return mp * 4.0e6;
+}
+
+} // namespace
+
+void PrefetchPlanner::OnNavigate(int index, double nowMs) {
+    const int delta = index - m_lastIndex;
+    const double gap = nowMs - m_lastMs;
+
+    if (m_lastIndex < 0 || gap > kIdleGapMs) {
+        // First image or a pause: direction survives, the rate does not
+        m_intervalMs = 0.0;
+        m_direction = (delta == 1 || delta == -1) && m_lastIndex >= 0 ? delta : 0;
+    } else if (delta == 0) {
+        return; // Reload / same image: not a step
+    } else if (delta != 1 && delta != -1) {
+        // Jump (gallery, Home/End, wrap): the rate says nothing about the next step
+        m_intervalMs = 0.0;
+        m_direction = 0;
+    } else if (delta != m_direction) {
+        // Reversal restarts the estimate in the new direction
+        m_intervalMs = gap;
+        m_direction = delta;
+    } else {
+        m_intervalMs = m_intervalMs > 0.0 ? m_intervalMs + kRateAlpha * (gap - m_intervalMs) : gap;
+    }
+    m_lastIndex = index;
+    m_lastMs = nowMs;
+}
+
+PrefetchPlanner::Mode PrefetchPlanner::GetMode() const {
+    if (m_intervalMs <= 0.0 || m_direction == 0) return Mode::Idle;
+    return m_intervalMs < kRapidMs ? Mode::Rapid : Mode::Browsing;
+}
+
+std::wstring PrefetchPlanner::CostKey(const std::wstring& format, PrefetchTier tier) {
+    std::wstring key = format;
+    key += L'#';
+    key += (wchar_t)(L'0' + (int)tier);
+    return key;
+}
+
+void PrefetchPlanner::RecordDecode(const std::wstring& format, PrefetchTier tier, double megapixels, double ms) {
+    if (ms <= 0.0) return;
+    const bool perImage = tier == PrefetchTier::EmbeddedPreview;
+    if (!perImage && megapixels <= 0.0) return;
+    const double value = perImage ? ms : (std::max)(0.0, ms - kFixedMs) / megapixels;
+
+    auto blend = [&](CostStat& s) {
+        s.value = s.samples == 0 ? value : s.value + kCostAlpha * (value - s.value);
+        s.samples++;
+    };
+    blend(m_costs[CostKey(format, tier)]);
+    blend(m_tierCosts[(int)tier]);
+}
+
+double PrefetchPlanner::EstimateDecodeMs(const std::wstring& format, PrefetchTier tier, double megapixels) const {
+    auto learnt = [&](PrefetchTier t) -> const CostStat* {
+        auto it = m_costs.find(CostKey(format, t));
+        if (it != m_costs.end()) return &it->second;
+        return m_tierCosts[(int)t].samples ? &m_tierCosts[(int)t] : nullptr;
+    };
+    const double mp = (std::max)(megapixels, 0.0);
+
+    if (tier == PrefetchTier::EmbeddedPreview) {
+        const CostStat* s = learnt(tier);
+        return s ? s->value : kDefaultPreviewMs;
+    }
+    if (const CostStat* s = learnt(tier)) return kFixedMs + s->value * mp;
+    if (tier == PrefetchTier::Scaled) {
+        // No scaled history yet: a share of what a full decode of this format costs
+        return kFixedMs + kDefaultScaledShare * (EstimateDecodeMs(format, PrefetchTier::Full, mp) - kFixedMs);
+    }
+    return kFixedMs + kDefaultFullMsPerMP * mp;
+}
+
+std::vector<PrefetchJob> PrefetchPlanner::Plan(const PrefetchPlanInput& in, const CandidateFn& candidate) const {
+    std::vector<PrefetchJob> jobs;
+    if (in.count <= 1 || in.maxDepth <= 0) return jobs;
+
+    const Mode mode = GetMode();
+    const int dir = m_direction != 0 ? m_direction : 1;
+    const double step = mode == Mode::Idle ? kDwellMs : m_intervalMs;
+    const int depth = (std::min)(in.count - 1, mode == Mode::Rapid ? in.maxDepth * kRapidDepthScale : in.maxDepth);
+
+    // Visit order with predicted arrival. Idle: both sides, the last direction first.
+    struct Visit { int offset; double arrivalMs; };
+    std::vector<Visit> visits;
+    if (mode == Mode::Idle) {
+        for (int k = 1; k <= depth; ++k) {
+            visits.push_back({ dir * k, k * step });
+            visits.push_back({ -dir * k, (k + 0.5) * step });
+        }
+    } else {
+        for (int k = 1; k <= depth; ++k) visits.push_back({ dir * k, k * step });
+        // Anti-regret: one step back, needed only once the user turns around
+        if (mode == Mode::Browsing) visits.push_back({ -dir, (depth + 1) * step });
+    }
+
+    double t = in.busyMs;
+    double bytes = 0.0;
+    bool firstForward = true;
+    for (const Visit& v : visits) {
+        const int index = in.current + v.offset;
+        if (index < 0 || index >= in.count) continue;
+        const bool adjacent = v.offset == dir;
+
+        const PrefetchCandidate c = candidate(index);
+        if (c.ready || c.skip) continue;
+        if (c.inFlight) {
+            t += EstimateDecodeMs(c.format, PrefetchTier::Full, c.megapixels);
+            if (adjacent) firstForward = false;
+            PrefetchJob job;
+            job.index = index;
+            job.readyAtMs = t;
+            job.arrivalMs = v.arrivalMs;
+            job.inFlight = true;
+            jobs.push_back(job);
+            continue;
+        }
+
+        // Best tier ready before arrival; cheaper tiers only when the better one misses it
+        const PrefetchTier order[3] = { PrefetchTier::Full, PrefetchTier::Scaled, PrefetchTier::EmbeddedPreview };
+        bool picked = false;
+        PrefetchTier tier = PrefetchTier::Full;
+        double cost = 0.0;
+        PrefetchTier cheapest = PrefetchTier::Full;
+        double cheapestCost = 0.0;
+        bool haveCheapest = false;
+        for (PrefetchTier candidateTier : order) {
+            if (candidateTier == PrefetchTier::Scaled && !c.canScale) continue;
+            if (candidateTier == PrefetchTier::EmbeddedPreview && !c.hasPreview) continue;
+            const double ms = EstimateDecodeMs(c.format, candidateTier, c.megapixels);
+            if (!haveCheapest || ms < cheapestCost) {
+                cheapest = candidateTier;
+                cheapestCost = ms;
+                haveCheapest = true;
+            }
+            if (!picked && t + ms <= v.arrivalMs) {
+                tier = candidateTier;
+                cost = ms;
+                picked = true;
+            }
+        }
+        if (!picked) {
+            // Nothing makes it in time. The adjacent image is still worth starting unless
+            // the user is flying past; otherwise spend the lane on images further out.
+            if (!(adjacent && firstForward && mode != Mode::Rapid)) continue;
+            tier = cheapest;
+            cost = cheapestCost;
+        }
+
+        const double out = OutputBytes(tier, c.megapixels, in.screenMegapixels);
+        if (in.budgetBytes > 0 && bytes + out > (double)in.budgetBytes) continue;
+        bytes += out;
+        t += cost;
+
+        PrefetchJob job;
+        job.index = index;
+        job.tier = tier;
+        job.readyAtMs = t;
+        job.arrivalMs = v.arrivalMs;
+        if (adjacent && firstForward) job.priority = Priority::High;
+        else if (v.offset * dir < 0) job.priority = Priority::Low;
+        else job.priority = Priority::Idle;
+        if (adjacent) firstForward = false;
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+
+} // namespace QuickView
@@ -0,0 +1,107 @@
+#pragma once
+#include "pch.h"
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ImageTypes.h"
+
+namespace QuickView {
+
+    // What a prefetch job produces. The cheaper tiers are placeholders: landing on
+    // one shows it at once and the regular dispatch then decodes the full image.
+    enum class PrefetchTier : uint8_t {
+        EmbeddedPreview = 0, // Camera / container preview, no pixel decode
+        Scaled = 1,          // Decoder-side downscale to the screen (JPEG IDCT scaling)
+        Full = 2
+    };
+
+    // The planner's view of one folder entry (ImageEngine fills it from PeekHeader + cache state)
+    struct PrefetchCandidate {
+        std::wstring format;     // PeekHeader format, upper-case
+        double megapixels = 0.0;
+        bool ready = false;      // Hot or cold cache
+        bool inFlight = false;   // Already queued or decoding
+        bool canScale = false;   // Scaled tier available
+        bool hasPreview = false; // Display-sized embedded preview available
+        bool skip = false;       // Not prefetchable (Titan candidate, over the cache cap)
+    };
+
+    struct PrefetchJob {
+        int index = -1;
+        PrefetchTier tier = PrefetchTier::Full;
+        Priority priority = Priority::Idle;
+        double readyAtMs = 0.0;  // Predicted completion, from the start of the plan
+        double arrivalMs = 0.0;  // Predicted time the user lands on it
+        bool inFlight = false;   // Already decoding: listed so the caller keeps it running
+    };
+
+    struct PrefetchPlanInput {
+        int current = 0;
+        int count = 0;
+        int maxDepth = 5;               // PrefetchPolicy::lookAheadCount
+        double busyMs = 0.0;            // Work already ahead of the plan (current image)
+        size_t budgetBytes = 0;         // Output bytes the plan may hold (0 = unbounded)
+        double screenMegapixels = 8.3;  // Output size of the placeholder tiers
+    };
+
+    // ============================================================================
+    // Navigation-velocity-aware prefetch planning
+    // ============================================================================
+    // The old queue was a fixed window keyed on direction only. The planner instead
+    // estimates when the user will land on each neighbour (browse interval from the
+    // navigation timestamps) and what each decode costs (per format and tier, learnt
+    // from completed decodes), then walks the serial decode timeline:
+    //  - each neighbour gets the best tier that is predicted ready before arrival;
+    //  - while a key is held, neighbours that cannot be ready in time are skipped so
+    //    the decoder works ahead of the user instead of always arriving late;
+    //  - a pause or a jump (gallery, Home/End) resets the rate: both sides are
+    //    planned at an assumed dwell time.
+    // Decodes already running are listed as inFlight jobs so that navigation only
+    // cancels the prefetches the new plan dropped.
+    // Times are plain milliseconds supplied by the caller, so traces replay exactly.
+    class PrefetchPlanner {
+    public:
+        enum class Mode {
+            Idle,     // No rate: first image, after a pause or a jump
+            Browsing, // Stepping with a measurable dwell (manual, slideshow)
+            Rapid     // Key repeat / flicking: faster than a full decode
+        };
+
+        static constexpr double kIdleGapMs = 2000.0;  // A pause this long resets the rate
+        static constexpr double kRapidMs = 250.0;     // Intervals below this are Rapid
+        static constexpr double kDwellMs = 1500.0;    // Assumed view time when Idle
+        static constexpr double kRateAlpha = 0.35;    // EMA weight of the newest interval
+        static constexpr double kCostAlpha = 0.3;     // EMA weight of the newest decode
+        static constexpr int kRapidDepthScale = 3;    // Look further ahead when skipping
+
+        void OnNavigate(int index, double nowMs);
+        void RecordDecode(const std::wstring& format, PrefetchTier tier, double megapixels, double ms);
+
+        // Predicted wall time of one decode on one lane
+        double EstimateDecodeMs(const std::wstring& format, PrefetchTier tier, double megapixels) const;
+
+        Mode GetMode() const;
+        double IntervalMs() const { return m_intervalMs; } // 0 = unknown
+        int Direction() const { return m_direction; }      // -1, 0, +1
+
+        using CandidateFn = std::function<PrefetchCandidate(int index)>;
+        std::vector<PrefetchJob> Plan(const PrefetchPlanInput& in, const CandidateFn& candidate) const;
+
+    private:
+        struct CostStat {
+            double value = 0.0; // ms per megapixel (Full / Scaled) or ms per image (EmbeddedPreview)
+            int samples = 0;
+        };
+        static std::wstring CostKey(const std::wstring& format, PrefetchTier tier);
+
+        int m_lastIndex = -1;
+        double m_lastMs = 0.0;
+        double m_intervalMs = 0.0;
+        int m_direction = 0;
+
+        std::unordered_map<std::wstring, CostStat> m_costs; // Per format + tier
+        CostStat m_tierCosts[3];                            // Any format, per tier
+    };
+
+} // namespace QuickView
@@ -0,0 +1,491 @@
+#include "pch.h"
+#include "ProgressiveStream.h"
+#include "WuffsLoader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <csetjmp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <jpeglib.h>
+#include <zlib.h>
+
+namespace QuickView {
+
+namespace {
+
+enum class Step { NeedMore, Done, Unsupported, Failed };
+
+// Rate-limits partial frames: the first goes out at once (time-to-first-pixel),
+// later ones no closer than minIntervalMs, and never more than maxPartials.
+class PartialEmitter {
+public:
+    PartialEmitter(const StreamingOptions& opts, PartialFrameCallback cb) : m_opts(opts), m_cb(cb) {}
+
+    bool Due() const {
+        if (m_count >= m_opts.maxPartials) return false;
+        if (m_count == 0) return true;
+        return std::chrono::steady_clock::now() - m_last >= std::chrono::milliseconds(m_opts.minIntervalMs);
+    }
+
+    void Emit(const PartialFrame& frame) {
+        m_cb(frame);
+        m_count++;
+        m_last = std::chrono::steady_clock::now();
+    }
+
+private:
+    const StreamingOptions& m_opts;
+    PartialFrameCallback m_cb;
+    int m_count = 0;
+    std::chrono::steady_clock::time_point m_last{};
+};
+
+uint32_t ReadBE32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+uint8_t Premul(uint32_t c, uint32_t a) { return (uint8_t)((c * a + 127) / 255); }
+
+// ----------------------------------------------------------------------------
+// PNG: chunk walker + incremental inflate + per-row unfilter
+// ----------------------------------------------------------------------------
+// Wuffs inflates the whole IDAT stream before it filters and swizzles any row, so
+// it cannot show rows early. This streamer handles the common non-interlaced
+// 8/16-bit layouts; anything else falls back to the final decoder.
+class PngRowStreamer {
+public:
+    PngRowStreamer() {
+        std::memset(&m_zs, 0, sizeof(m_zs));
+        for (auto& e : m_palette) e[3] = 255; // Opaque unless tRNS says otherwise
+    }
+    ~PngRowStreamer() { if (m_zInit) inflateEnd(&m_zs); }
+
+    Step Advance(const uint8_t* data, size_t available) {
+        while (m_offset < available) {
+            if (m_idatLeft > 0) {
+                const size_t n = (std::min)((size_t)m_idatLeft, available - m_offset);
+                const Step s = Inflate(data + m_offset, n);
+                m_offset += n;
+                m_idatLeft -= (uint32_t)n;
+                if (m_idatLeft == 0) m_offset += 4; // CRC
+                if (s != Step::NeedMore) return s;
+                continue;
+            }
+
+            if (available - m_offset < 8) return Step::NeedMore;
+            const uint8_t* chunk = data + m_offset;
+            const uint32_t len = ReadBE32(chunk);
+            const uint32_t type = ReadBE32(chunk + 4);
+            if (len > 0x7FFFFFFFu) return Step::Failed;
+
+            if (type == 0x49444154) { // IDAT
+                if (!m_zInit) {
+                    const Step s = BeginImage();
+                    if (s != Step::NeedMore) return s;
+                }
+                m_offset += 8;
+                m_idatLeft = len;
+                if (len == 0) m_offset += 4;
+                continue;
+            }
+            if (type == 0x49454E44) return Step::Done; // IEND before the last row: truncated
+
+            if (type == 0x49484452 || type == 0x504C5445 || type == 0x74524E53) { // IHDR, PLTE, tRNS
+                if (available - m_offset < 12 + (size_t)len) return Step::NeedMore;
+                const Step s = ParseHeaderChunk(type, chunk + 8, len);
+                if (s != Step::NeedMore) return s;
+            }
+            m_offset += 12 + (size_t)len; // Ancillary chunks are skipped without waiting for them
+        }
+        return Step::NeedMore;
+    }
+
+    PartialFrame Frame() const {
+        PartialFrame f;
+        f.pixels = m_pixels.get();
+        f.width = (int)m_width;
+        f.height = (int)m_height;
+        f.stride = (int)m_width * 4;
+        f.rowsReady = (int)m_rowsDone;
+        f.rowsFinal = f.rowsReady;
+        f.srcWidth = f.width;
+        f.srcHeight = f.height;
+        return f;
+    }
+    uint32_t RowsDone() const { return m_rowsDone; }
+    uint64_t PixelCount() const { return (uint64_t)m_width * m_height; }
+
+    size_t m_offset = 8; // Past the signature
+    uint64_t m_maxPixels = 0;
+
+private:
+    Step ParseHeaderChunk(uint32_t type, const uint8_t* p, uint32_t len) {
+        if (type == 0x49484452) {
+            if (len < 13) return Step::Failed;
+            m_width = ReadBE32(p);
+            m_height = ReadBE32(p + 4);
+            m_bitDepth = p[8];
+            m_colorType = p[9];
+            m_interlace = p[12];
+            m_haveHeader = true;
+        } else if (type == 0x504C5445) {
+            const uint32_t n = (std::min)(len / 3, 256u);
+            for (uint32_t i = 0; i < n; ++i) {
+                m_palette[i][0] = p[i * 3 + 2]; // B
+                m_palette[i][1] = p[i * 3 + 1]; // G
+                m_palette[i][2] = p[i * 3 + 0]; // R
+            }
+        } else if (m_colorType == 3) { // tRNS for palettes; gray/RGB colour keys are ignored in previews
+            for (uint32_t i = 0; i < (std::min)(len, 256u); ++i) m_palette[i][3] = p[i];
+        }
+        return Step::NeedMore;
+    }
+
+    Step BeginImage() {
+        if (!m_haveHeader || m_width == 0 || m_height == 0) return Step::Failed;
+        if (m_interlace != 0) return Step::Unsupported;
+        if (m_maxPixels && PixelCount() > m_maxPixels) return Step::Unsupported;
+
+        switch (m_colorType) {
+            case 0: m_channels = 1; break;
+            case 2: m_channels = 3; break;
+            case 3: m_channels = 1; break;
+            case 4: m_channels = 2; break;
+            case 6: m_channels = 4; break;
+            default: return Step::Unsupported;
+        }
+        if (m_bitDepth != 8 && !(m_bitDepth == 16 && m_colorType != 3)) return Step::Unsupported;
+
+        m_bytesPerPixel = m_channels * (m_bitDepth / 8);
+        m_rowBytes = (size_t)m_width * m_bytesPerPixel;
+        m_row.assign(m_rowBytes + 1, 0);
+        m_prev.assign(m_rowBytes, 0);
+        m_pixels.reset(new (std::nothrow) uint8_t[(size_t)m_width * 4 * m_height]());
+        if (!m_pixels) return Step::Unsupported;
+
+        if (inflateInit(&m_zs) != Z_OK) return Step::Failed;
+        m_zInit = true;
+        return Step::NeedMore;
+    }
+
+    Step Inflate(const uint8_t* in, size_t n) {
+        m_zs.next_in = const_cast<Bytef*>(in);
+        m_zs.avail_in = (uInt)n;
+        while (m_rowsDone < m_height) {
+            m_zs.next_out = m_row.data() + m_rowFill;
+            m_zs.avail_out = (uInt)(m_row.size() - m_rowFill);
+            const int ret = inflate(&m_zs, Z_NO_FLUSH);
+            m_rowFill = m_row.size() - m_zs.avail_out;
+            if (m_rowFill == m_row.size()) {
+                if (!FinishRow()) return Step::Failed;
+                m_rowFill = 0;
+            }
+            if (ret == Z_STREAM_END) break;
+            if (ret == Z_BUF_ERROR || (ret == Z_OK && m_zs.avail_in == 0 && m_zs.avail_out != 0)) {
+                return Step::NeedMore; // Input exhausted
+            }
+            if (ret != Z_OK) return Step::Failed;
+        }
+        return m_rowsDone == m_height ? Step::Done : Step::NeedMore;
+    }
+
+    bool FinishRow() {
+        const uint8_t filter = m_row[0];
+        uint8_t* cur = m_row.data() + 1;
+        const uint8_t* prev = m_prev.data();
+        const size_t bpp = m_bytesPerPixel;
+        switch (filter) {
+            case 0: break;
+            case 1: for (size_t i = bpp; i < m_rowBytes; ++i) cur[i] += cur[i - bpp]; break;
+            case 2: for (size_t i = 0; i < m_rowBytes; ++i) cur[i] += prev[i]; break;
+            case 3:
+                for (size_t i = 0; i < m_rowBytes; ++i) {
+                    const uint32_t left = i >= bpp ? cur[i - bpp] : 0;
+                    cur[i] += (uint8_t)((left + prev[i]) >> 1);
+                }
+                break;
+            case 4:
+                for (size_t i = 0; i < m_rowBytes; ++i) {
+                    const int a = i >= bpp ? cur[i - bpp] : 0;
+                    const int b = prev[i];
+                    const int c = i >= bpp ? prev[i - bpp] : 0;
+                    const int p = a + b - c;
+                    const int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+                    cur[i] += (uint8_t)((pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c));
+                }
+                break;
+            default: return false;
+        }
+
+        uint8_t* out = m_pixels.get() + (size_t)m_rowsDone * m_width * 4;
+        const size_t step = m_bitDepth / 8; // 16-bit: high byte of each sample
+        for (uint32_t x = 0; x < m_width; ++x, out += 4) {
+            const uint8_t* s = cur + (size_t)x * m_bytesPerPixel;
+            switch (m_colorType) {
+                case 0: out[0] = out[1] = out[2] = s[0]; out[3] = 255; break;
+                case 2: out[0] = s[2 * step]; out[1] = s[step]; out[2] = s[0]; out[3] = 255; break;
+                case 3: {
+                    const uint8_t* e = m_palette[s[0]];
+                    out[0] = Premul(e[0], e[3]); out[1] = Premul(e[1], e[3]); out[2] = Premul(e[2], e[3]); out[3] = e[3];
+                    break;
+                }
+                case 4: out[0] = out[1] = out[2] = Premul(s[0], s[step]); out[3] = s[step]; break;
+                case 6: {
+                    const uint8_t a = s[3 * step];
+                    out[0] = Premul(s[2 * step], a); out[1] = Premul(s[step], a); out[2] = Premul(s[0], a); out[3] = a;
+                    break;
+                }
+            }
+        }
+        std::memcpy(m_prev.data(), cur, m_rowBytes);
+        m_rowsDone++;
+        return true;
+    }
+
+    z_stream m_zs;
+    bool m_zInit = false;
+    bool m_haveHeader = false;
+    uint32_t m_idatLeft = 0;
+
+    uint32_t m_width = 0, m_height = 0;
+    uint8_t m_bitDepth = 0, m_colorType = 0, m_interlace = 0;
+    size_t m_channels = 0, m_bytesPerPixel = 0, m_rowBytes = 0;
+    uint8_t m_palette[256][4] = {}; // BGRA
+
+    std::vector<uint8_t> m_row; // Filter byte + raw row
+    std::vector<uint8_t> m_prev;
+    size_t m_rowFill = 0;
+    uint32_t m_rowsDone = 0;
+    std::unique_ptr<uint8_t[]> m_pixels;
+};
+
+// ----------------------------------------------------------------------------
+// JPEG: libjpeg with a suspending source over the growing buffer
+// ----------------------------------------------------------------------------
+struct JpegStreamErr {
+    jpeg_error_mgr pub;
+    jmp_buf jump;
+};
+
+struct JpegStreamSrc {
+    jpeg_source_mgr pub;
+    const uint8_t* data = nullptr;
+    size_t watermark = 0; // Bytes handed to libjpeg so far
+    size_t skipTo = 0;    // Pending skip past the watermark
+};
+
+class JpegStreamer {
+public:
+    JpegStreamer(const uint8_t* data, const StreamingOptions& opts) : m_opts(opts) {
+        m_cinfo.err = jpeg_std_error(&m_err.pub);
+        m_err.pub.error_exit = [](j_common_ptr ci) { longjmp(reinterpret_cast<JpegStreamErr*>(ci->err)->jump, 1); };
+        m_err.pub.output_message = [](j_common_ptr) {};
+        jpeg_create_decompress(&m_cinfo);
+
+        m_src.data = data;
+        m_src.pub.next_input_byte = data;
+        m_src.pub.bytes_in_buffer = 0;
+        m_src.pub.init_source = [](j_decompress_ptr) {};
+        m_src.pub.fill_input_buffer = [](j_decompress_ptr) -> boolean { return FALSE; }; // Suspend
+        m_src.pub.skip_input_data = [](j_decompress_ptr ci, long num) {
+            auto* s = reinterpret_cast<JpegStreamSrc*>(ci->src);
+            if (num <= 0) return;
+            if ((size_t)num <= s->pub.bytes_in_buffer) {
+                s->pub.next_input_byte += num;
+                s->pub.bytes_in_buffer -= (size_t)num;
+            } else {
+                s->skipTo = (size_t)(s->pub.next_input_byte - s->data) + (size_t)num;
+                s->pub.next_input_byte = s->data + s->watermark;
+                s->pub.bytes_in_buffer = 0;
+            }
+        };
+        m_src.pub.resync_to_restart = jpeg_resync_to_restart;
+        m_src.pub.term_source = [](j_decompress_ptr) {};
+        m_cinfo.src = &m_src.pub;
+    }
+
+    ~JpegStreamer() { jpeg_destroy_decompress(&m_cinfo); }
+
+    // Only PODs live in this frame: libjpeg errors longjmp back here.
+    Step Advance(size_t available, PartialEmitter& emitter) {
+        if (setjmp(m_err.jump)) return Step::Failed;
+        Refill(available);
+
+        if (m_state == State::Header) {
+            if (jpeg_read_header(&m_cinfo, TRUE) == JPEG_SUSPENDED) return Step::NeedMore;
+            if (m_cinfo.jpeg_color_space == JCS_CMYK || m_cinfo.jpeg_color_space == JCS_YCCK) return Step::Unsupported;
+            m_cinfo.out_color_space = JCS_EXT_BGRA;
+            m_cinfo.dct_method = JDCT_IFAST;
+            m_cinfo.do_fancy_upsampling = FALSE;
+            m_cinfo.scale_num = 1;
+            m_cinfo.scale_denom = 1;
+            while (m_cinfo.scale_denom < 8 &&
+                   (uint64_t)((m_cinfo.image_width + m_cinfo.scale_denom - 1) / m_cinfo.scale_denom) *
+                   ((m_cinfo.image_height + m_cinfo.scale_denom - 1) / m_cinfo.scale_denom) > m_opts.maxJpegPreviewPixels) {
+                m_cinfo.scale_denom *= 2;
+            }
+            m_progressive = jpeg_has_multiple_scans(&m_cinfo);
+            m_cinfo.buffered_image = m_progressive ? TRUE : FALSE;
+            m_state = State::Start;
+        }
+
+        if (m_state == State::Start) {
+            if (!jpeg_start_decompress(&m_cinfo)) return Step::NeedMore;
+            m_stride = (size_t)m_cinfo.output_width * 4;
+            m_pixels.reset(new (std::nothrow) uint8_t[m_stride * m_cinfo.output_height]());
+            if (!m_pixels) return Step::Unsupported;
+            m_state = m_progressive ? State::Scans : State::Rows;
+        }
+
+        if (m_state == State::Rows) {
+            while (m_cinfo.output_scanline < m_cinfo.output_height) {
+                JSAMPROW row = m_pixels.get() + (size_t)m_cinfo.output_scanline * m_stride;
+                if (jpeg_read_scanlines(&m_cinfo, &row, 1) == 0) break; // Suspended
+            }
+            const int rows = (int)m_cinfo.output_scanline;
+            const bool complete = m_cinfo.output_scanline == m_cinfo.output_height;
+            if (rows > m_rowsShown && (complete || emitter.Due())) {
+                emitter.Emit(Frame(rows, 0));
+                m_rowsShown = rows;
+            }
+            return complete ? Step::Done : Step::NeedMore;
+        }
+
+        // State::Scans (buffered-image mode)
+        if (m_finishPending) {
+            if (!jpeg_finish_output(&m_cinfo)) return Step::NeedMore;
+            m_finishPending = false;
+        }
+        int ret;
+        do {
+            ret = jpeg_consume_input(&m_cinfo);
+        } while (ret != JPEG_SUSPENDED && ret != JPEG_REACHED_EOI);
+        if (ret == JPEG_REACHED_EOI) return Step::Done; // The final decoder takes it from here
+
+        // Show the last scan that is fully in; with output behind input, the output
+        // pass reads only the coefficient buffer and cannot suspend.
+        const int completed = m_cinfo.input_scan_number - 1;
+        if (completed > m_scanShown && emitter.Due()) {
+            jpeg_start_output(&m_cinfo, completed);
+            while (m_cinfo.output_scanline < m_cinfo.output_height) {
+                JSAMPROW row = m_pixels.get() + (size_t)m_cinfo.output_scanline * m_stride;
+                if (jpeg_read_scanlines(&m_cinfo, &row, 1) == 0) break;
+            }
+            m_finishPending = !jpeg_finish_output(&m_cinfo);
+            emitter.Emit(Frame((int)m_cinfo.output_height, completed));
+            m_scanShown = completed;
+        }
+        return Step::NeedMore;
+    }
+
+private:
+    enum class State { Header, Start, Rows, Scans };
+
+    void Refill(size_t available) {
+        size_t pos = (size_t)(m_src.pub.next_input_byte - m_src.data);
+        if (m_src.skipTo > pos) {
+            pos = (std::min)(m_src.skipTo, available);
+            if (pos == m_src.skipTo) m_src.skipTo = 0;
+        }
+        m_src.watermark = available;
+        m_src.pub.next_input_byte = m_src.data + pos;
+        m_src.pub.bytes_in_buffer = available - pos;
+    }
+
+    PartialFrame Frame(int rows, int scan) const {
+        PartialFrame f;
+        f.pixels = m_pixels.get();
+        f.width = (int)m_cinfo.output_width;
+        f.height = (int)m_cinfo.output_height;
+        f.stride = (int)m_stride;
+        f.rowsReady = rows;
+        f.rowsFinal = scan == 0 ? rows : 0;
+        f.scan = scan;
+        f.srcWidth = (int)m_cinfo.image_width;
+        f.srcHeight = (int)m_cinfo.image_height;
+        return f;
+    }
+
+    const StreamingOptions& m_opts;
+    jpeg_decompress_struct m_cinfo;
+    JpegStreamErr m_err;
+    JpegStreamSrc m_src;
+    State m_state = State::Header;
+    bool m_progressive = false;
+    bool m_finishPending = false;
+    size_t m_stride = 0;
+    int m_rowsShown = 0;
+    int m_scanShown = 0;
+    std::unique_ptr<uint8_t[]> m_pixels;
+};
+
+// Feed a streamer from the source until it finishes or the source completes
+template <typename AdvanceFn>
+StreamOutcome Drive(const StreamingSource& src, const StreamingOptions& opts, SimplePredicate checkCancel, AdvanceFn&& advance) {
+    size_t available = src.WaitFor((std::min)(src.size, opts.readStep));
+    for (;;) {
+        if (checkCancel && checkCancel()) return StreamOutcome::Cancelled;
+        switch (advance(available)) {
+            case Step::NeedMore: break;
+            case Step::Done: return StreamOutcome::Finished;
+            case Step::Unsupported: return StreamOutcome::Unsupported;
+            case Step::Failed: return StreamOutcome::Failed;
+        }
+        if (available >= src.size) return StreamOutcome::Finished; // Truncated file: the final decoder reports it
+        const size_t next = src.WaitFor((std::min)(src.size, available + opts.readStep));
+        if (next <= available) return StreamOutcome::Failed; // Read error: the watermark stopped moving
+        available = next;
+    }
+}
+
+} // namespace
+
+StreamOutcome StreamPngPartials(const StreamingSource& src, const StreamingOptions& opts,
+                                PartialFrameCallback onPartial, SimplePredicate checkCancel) {
+    PngRowStreamer png;
+    png.m_maxPixels = opts.maxPixels;
+    PartialEmitter emitter(opts, onPartial);
+    uint32_t rowsShown = 0;
+
+    return Drive(src, opts, checkCancel, [&](size_t available) {
+        const Step s = png.Advance(src.data, available);
+        const uint32_t rows = png.RowsDone();
+        if (rows > rowsShown && (s == Step::Done || emitter.Due())) {
+            emitter.Emit(png.Frame());
+            rowsShown = rows;
+        }
+        return s;
+    });
+}
+
+StreamOutcome StreamJpegPartials(const StreamingSource& src, const StreamingOptions& opts,
+                                 PartialFrameCallback onPartial, SimplePredicate checkCancel) {
+    JpegStreamer jpeg(src.data, opts);
+    PartialEmitter emitter(opts, onPartial);
+    return Drive(src, opts, checkCancel, [&](size_t available) { return jpeg.Advance(available, emitter); });
+}
+
+StreamOutcome StreamPartialFrames(const StreamingSource& src, const StreamingOptions& opts,
+                                  PartialFrameCallback onPartial, SimplePredicate checkCancel) {
+    if (!src.data || !src.waitForBytes || src.size < 16) return StreamOutcome::Unsupported;
+
+    const size_t head = src.WaitFor(16);
+    if (head < 16) return StreamOutcome::Failed;
+    const uint8_t* d = src.data;
+
+    static const uint8_t kPngSig[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+    if (std::memcmp(d, kPngSig, 8) == 0) return StreamPngPartials(src, opts, onPartial, checkCancel);
+    if (d[0] == 0xFF && d[1] == 0xD8 && d[2] == 0xFF) return StreamJpegPartials(src, opts, onPartial, checkCancel);
+    if (std::memcmp(d, "GIF87a", 6) == 0 || std::memcmp(d, "GIF89a", 6) == 0) {
+        return WuffsLoader::StreamGIFPartials(src, opts, onPartial, checkCancel);
+    }
+    return StreamOutcome::Unsupported;
+}
+
+} // namespace QuickView
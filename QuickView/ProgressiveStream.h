@@ -0,0 +1,85 @@
+#pragma once
+#include "pch.h"
+#include <cstddef>
+#include <cstdint>
+#include "ImageTypes.h"
+
+namespace QuickView {
+
+    // ============================================================================
+    // [Streaming] Partial frames while a slow source is still arriving
+    // ============================================================================
+    // On HDDs and network shares a Standard job would otherwise sit on I/O until the
+    // last byte. While an async MappedFile fills, these decoders turn the bytes that
+    // have arrived so far into displayable frames:
+    //   PNG  (non-interlaced, 8/16-bit): rows top-down, own zlib row streamer
+    //   GIF  (first frame):              rows via Wuffs' dirty rect
+    //   JPEG baseline:                   scanlines top-down
+    //   JPEG progressive:                one full-frame refinement per completed scan
+    // They are previews only. Streaming stops once the source is complete and the
+    // normal decoder produces the final frame from the finished buffer, so colour
+    // management, orientation and HDR handling stay in one place.
+    // ============================================================================
+
+    struct StreamingSource {
+        const uint8_t* data = nullptr; // Final buffer, readable up to the watermark
+        size_t size = 0;               // Final size
+        // Blocks until at least `bytes` are readable or the source failed; returns the watermark
+        size_t (*waitForBytes)(void* ctx, size_t bytes) = nullptr;
+        void* ctx = nullptr;
+
+        size_t WaitFor(size_t bytes) const { return waitForBytes(ctx, bytes); }
+    };
+
+    // BGRA8 premultiplied, like the final decoders. Rows [0, rowsReady) hold data;
+    // progressive refinements cover the whole frame (rowsReady == height) and keep
+    // rowsFinal at 0, so a consumer must recopy every row.
+    struct PartialFrame {
+        const uint8_t* pixels = nullptr;
+        int width = 0;
+        int height = 0;
+        int stride = 0;
+        int rowsReady = 0;
+        int rowsFinal = 0; // Rows [0, rowsFinal) stay unchanged in later partials
+        int scan = 0; // Progressive JPEG scan shown; 0 for row-order formats
+        int srcWidth = 0;  // Full-resolution size (JPEG previews may be IDCT-scaled)
+        int srcHeight = 0;
+    };
+
+    struct PartialFrameCallback {
+        void (*pfn)(void* ctx, const PartialFrame& frame) = nullptr;
+        void* ctx = nullptr;
+
+        void operator()(const PartialFrame& frame) const {
+            if (pfn) pfn(ctx, frame);
+        }
+        explicit operator bool() const { return pfn != nullptr; }
+    };
+
+    struct StreamingOptions {
+        size_t readStep = 64 * 1024;            // Wait for at least this much new data per step
+        int minIntervalMs = 120;                // Between partial frames (each is a full upload)
+        int maxPartials = 8;
+        uint64_t maxPixels = 32ull * 1000 * 1000; // Larger row-order images are left to Titan / the final decoder
+        uint64_t maxJpegPreviewPixels = 8ull * 1000 * 1000; // Progressive/baseline JPEG previews use IDCT scaling above this
+    };
+
+    enum class StreamOutcome {
+        Finished,    // Source complete (or preview done): run the normal decoder
+        Unsupported, // Format / variant without a streaming path
+        Failed,      // Source read error or corrupt data; the normal decoder reports it
+        Cancelled,
+    };
+
+    // Sniffs the format from the first bytes and streams partial frames until the
+    // source completes. Runs on the calling (worker) thread; `onPartial` is called
+    // synchronously and must copy what it keeps.
+    StreamOutcome StreamPartialFrames(const StreamingSource& src, const StreamingOptions& opts,
+                                      PartialFrameCallback onPartial, SimplePredicate checkCancel = {});
+
+    StreamOutcome StreamPngPartials(const StreamingSource& src, const StreamingOptions& opts,
+                                    PartialFrameCallback onPartial, SimplePredicate checkCancel = {});
+    StreamOutcome StreamJpegPartials(const StreamingSource& src, const StreamingOptions& opts,
+                                     PartialFrameCallback onPartial, SimplePredicate checkCancel = {});
+
+} // namespace QuickView
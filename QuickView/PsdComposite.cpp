@@ -0,0 +1,411 @@
+/*
+ * QuickView PSD/PSB Composite Decoder - Merged image data section
+ * Copyright (C) 2026-Present QuickView Contributors
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#include "PsdComposite.h"
+#include "ImageLoaderSimd.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace QuickView::Codec::PsdComposite {
+
+struct HeaderInfo {
+  uint16_t version = 0; // 1=PSD, 2=PSB
+  uint16_t channels = 0;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint16_t depth = 0;       // 8/16 supported
+  uint16_t colorMode = 0;   // 1=Gray, 3=RGB supported
+  uint16_t compression = 0; // 0=Raw, 1=RLE
+  size_t imageDataOffset = 0;
+};
+
+static inline uint16_t ReadBE16(const uint8_t *p) {
+  return static_cast<uint16_t>((static_cast<uint16_t>(p[0]) << 8) | p[1]);
+}
+
+static inline uint32_t ReadBE32(const uint8_t *p) {
+  return (static_cast<uint32_t>(p[0]) << 24) |
+         (static_cast<uint32_t>(p[1]) << 16) |
+         (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+static inline uint64_t ReadBE64(const uint8_t *p) {
+  return (static_cast<uint64_t>(p[0]) << 56) |
+         (static_cast<uint64_t>(p[1]) << 48) |
+         (static_cast<uint64_t>(p[2]) << 40) |
+         (static_cast<uint64_t>(p[3]) << 32) |
+         (static_cast<uint64_t>(p[4]) << 24) |
+         (static_cast<uint64_t>(p[5]) << 16) |
+         (static_cast<uint64_t>(p[6]) << 8) | static_cast<uint64_t>(p[7]);
+}
+
+static inline bool FitsRange(size_t offset, size_t need, size_t size) {
+  return offset <= size && need <= (size - offset);
+}
+
+static bool ParseHeader(const uint8_t *data, size_t size, HeaderInfo &out) {
+  if (!data || size < 26)
+    return false;
+  if (std::memcmp(data, "8BPS", 4) != 0)
+    return false;
+
+  out.version = ReadBE16(data + 4);
+  if (out.version != 1 && out.version != 2)
+    return false;
+
+  out.channels = ReadBE16(data + 12);
+  out.height = ReadBE32(data + 14);
+  out.width = ReadBE32(data + 18);
+  out.depth = ReadBE16(data + 22);
+  out.colorMode = ReadBE16(data + 24);
+
+  if (out.channels == 0 || out.width == 0 || out.height == 0)
+    return false;
+
+  size_t off = 26;
+
+  if (!FitsRange(off, 4, size))
+    return false;
+  const uint32_t colorModeLen = ReadBE32(data + off);
+  off += 4;
+  if (!FitsRange(off, colorModeLen, size))
+    return false;
+  off += static_cast<size_t>(colorModeLen);
+
+  if (!FitsRange(off, 4, size))
+    return false;
+  const uint32_t imageResLen = ReadBE32(data + off);
+  off += 4;
+  if (!FitsRange(off, imageResLen, size))
+    return false;
+  off += static_cast<size_t>(imageResLen);
+
+  uint64_t layerMaskLen = 0;
+  if (out.version == 1) {
+    if (!FitsRange(off, 4, size))
+      return false;
+    layerMaskLen = ReadBE32(data + off);
+    off += 4;
+  } else {
+    if (!FitsRange(off, 8, size))
+      return false;
+    layerMaskLen = ReadBE64(data + off);
+    off += 8;
+  }
+
+  if (layerMaskLen > static_cast<uint64_t>(size - off))
+    return false;
+  off += static_cast<size_t>(layerMaskLen);
+
+  if (!FitsRange(off, 2, size))
+    return false;
+  out.compression = ReadBE16(data + off);
+  out.imageDataOffset = off;
+  return true;
+}
+
+
+
+static bool DecodePackBitsRow(const uint8_t *src, size_t srcSize, uint8_t *dst,
+                              size_t dstSize) {
+  size_t si = 0;
+  size_t di = 0;
+
+  while (si < srcSize && di < dstSize) {
+    const int8_t n = static_cast<int8_t>(src[si++]);
+    if (n >= 0) {
+      const size_t count = static_cast<size_t>(n) + 1;
+      if (count > srcSize - si || count > dstSize - di)
+        return false;
+      std::memcpy(dst + di, src + si, count);
+      si += count;
+      di += count;
+    } else if (n >= -127) {
+      if (si >= srcSize)
+        return false;
+      const uint8_t value = src[si++];
+      const size_t count = static_cast<size_t>(1 - n);
+      if (count > dstSize - di)
+        return false;
+      std::memset(dst + di, value, count);
+      di += count;
+    } else {
+      // n == -128: no-op
+    }
+  }
+
+  return di == dstSize;
+}
+
+HRESULT Load(const uint8_t *data, size_t size, const DecodeContext &ctx,
+                    DecodeResult &result) {
+  HeaderInfo header;
+  if (!ParseHeader(data, size, header))
+    return E_FAIL;
+
+  const bool supportedColorMode =
+      (header.colorMode == 3 || header.colorMode == 1);
+  const bool supportedDepth = (header.depth == 8 || header.depth == 16);
+  const bool supportedCompression =
+      (header.compression == 0 || header.compression == 1);
+  if (!supportedColorMode || !supportedDepth || !supportedCompression)
+    return E_NOTIMPL;
+
+  if (header.colorMode == 3 && header.channels < 3)
+    return E_FAIL;
+  if (header.colorMode == 1 && header.channels < 1)
+    return E_FAIL;
+
+  uint32_t outW = header.width;
+  uint32_t outH = header.height;
+  if (ctx.targetWidth > 0 || ctx.targetHeight > 0) {
+    const double tw = (ctx.targetWidth > 0)
+                          ? static_cast<double>(ctx.targetWidth)
+                          : static_cast<double>(header.width);
+    const double th = (ctx.targetHeight > 0)
+                          ? static_cast<double>(ctx.targetHeight)
+                          : static_cast<double>(header.height);
+    double scale = (std::min)(tw / static_cast<double>(header.width),
+                              th / static_cast<double>(header.height));
+    if (scale > 1.0)
+      scale = 1.0;
+    if (scale > 0.0 && scale < 1.0) {
+      outW = (std::max)(1u, static_cast<uint32_t>(header.width * scale + 0.5));
+      outH = (std::max)(1u, static_cast<uint32_t>(header.height * scale + 0.5));
+    }
+  }
+
+  const int stride = CalculateSIMDAlignedStride(static_cast<int>(outW), 4);
+  if (stride <= 0)
+    return E_FAIL;
+
+  const size_t totalSize =
+      static_cast<size_t>(stride) * static_cast<size_t>(outH);
+  uint8_t *pixels = ctx.allocator(totalSize);
+  if (!pixels)
+    return E_OUTOFMEMORY;
+
+  std::memset(pixels, 0, totalSize);
+
+  std::vector<uint32_t> srcXForOut(outW);
+  for (uint32_t ox = 0; ox < outW; ++ox) {
+    uint32_t sx = static_cast<uint32_t>(
+        (static_cast<uint64_t>(ox) * header.width) / outW);
+    if (sx >= header.width)
+      sx = header.width - 1;
+    srcXForOut[ox] = sx;
+  }
+
+  const int bytesPerSample = (header.depth == 16) ? 2 : 1;
+  const size_t rowBytes = static_cast<size_t>(header.width) * bytesPerSample;
+  const size_t compressionOffset = header.imageDataOffset + 2;
+  if (!FitsRange(compressionOffset, 0, size))
+    return E_FAIL;
+
+  // Channels that reach the output: RGB + alpha, or gray + alpha. Alpha is always
+  // decoded so its transparency can be inspected below.
+  const uint16_t usedChannels = (std::min)(
+      header.channels, static_cast<uint16_t>(header.colorMode == 3 ? 4 : 2));
+
+  // Start of every used channel row in the file. Channels are stored one after
+  // another, so rows are located up front and the output is then built row by
+  // row with all channels at hand.
+  std::vector<size_t> rowOffsets(static_cast<size_t>(usedChannels) *
+                                 header.height);
+  std::vector<uint32_t> rowLengths;
+  const uint64_t numRows = static_cast<uint64_t>(header.channels) *
+                           static_cast<uint64_t>(header.height);
+  if (header.compression == 0) {
+    if (numRows > (size - compressionOffset) / rowBytes)
+      return E_FAIL;
+    for (size_t i = 0; i < rowOffsets.size(); ++i)
+      rowOffsets[i] = compressionOffset + i * rowBytes;
+  } else {
+    const size_t rleLenField = (header.version == 2) ? 4u : 2u;
+    if (numRows > (std::numeric_limits<size_t>::max() / rleLenField))
+      return E_FAIL;
+    const size_t rleTableBytes = static_cast<size_t>(numRows) * rleLenField;
+    if (!FitsRange(compressionOffset, rleTableBytes, size))
+      return E_FAIL;
+
+    const uint8_t *rleLenTable = data + compressionOffset;
+    size_t offset = compressionOffset + rleTableBytes;
+    rowLengths.resize(rowOffsets.size());
+    for (uint64_t idx = 0; idx < numRows; ++idx) {
+      const uint8_t *lenPtr =
+          rleLenTable + static_cast<size_t>(idx) * rleLenField;
+      const uint32_t packedLen =
+          (rleLenField == 2) ? ReadBE16(lenPtr) : ReadBE32(lenPtr);
+      if (packedLen > size - offset)
+        return E_FAIL;
+      if (idx < rowOffsets.size()) {
+        rowOffsets[static_cast<size_t>(idx)] = offset;
+        rowLengths[static_cast<size_t>(idx)] = packedLen;
+      }
+      offset += packedLen;
+    }
+  }
+
+  std::vector<uint8_t> decodedRows[4];
+  if (header.compression == 1) {
+    for (uint16_t c = 0; c < usedChannels; ++c)
+      decodedRows[c].resize(rowBytes);
+  }
+  std::vector<uint8_t> fullRow;
+  if (outW != header.width)
+    fullRow.resize(static_cast<size_t>(header.width) * 4);
+
+  for (uint32_t oy = 0; oy < outH; ++oy) {
+    if (ctx.checkCancel && (oy % 128 == 0) && ctx.checkCancel())
+      return E_ABORT;
+    uint32_t sy = static_cast<uint32_t>(
+        (static_cast<uint64_t>(oy) * header.height) / outH);
+    if (sy >= header.height)
+      sy = header.height - 1;
+
+    const uint8_t *rows[4] = {};
+    for (uint16_t c = 0; c < usedChannels; ++c) {
+      const size_t idx = static_cast<size_t>(c) * header.height + sy;
+      if (header.compression == 0) {
+        rows[c] = data + rowOffsets[idx];
+      } else {
+        if (!DecodePackBitsRow(data + rowOffsets[idx], rowLengths[idx],
+                               decodedRows[c].data(), rowBytes))
+          return E_FAIL;
+        rows[c] = decodedRows[c].data();
+      }
+    }
+
+    const uint8_t *planes[4] = {rows[0], rows[1], rows[2], rows[3]};
+    if (header.colorMode == 1) {
+      planes[1] = rows[0];
+      planes[2] = rows[0];
+      planes[3] = rows[1];
+    }
+    uint8_t *dstRow = pixels + static_cast<size_t>(oy) * stride;
+    if (fullRow.empty()) {
+      ImageLoaderSimd::PlanarToBgra(planes, bytesPerSample, dstRow,
+                                    static_cast<int>(outW));
+    } else {
+      ImageLoaderSimd::PlanarToBgra(planes, bytesPerSample, fullRow.data(),
+                                    static_cast<int>(header.width));
+      for (uint32_t ox = 0; ox < outW; ++ox) {
+        std::memcpy(dstRow + static_cast<size_t>(ox) * 4,
+                    fullRow.data() + static_cast<size_t>(srcXForOut[ox]) * 4, 4);
+      }
+    }
+  }
+
+  // Evaluate true transparency using zero-alpha RGB check heuristic to avoid showing
+  // checkerboard grids in dark shadow regions where a custom alpha channel name is saved.
+  if (header.channels >= (header.colorMode == 3 ? 4u : 2u)) {
+    size_t zeroAlphaCount = 0;
+    size_t zeroAlphaButNotEmptyCount = 0;
+    const bool isRgb = (header.colorMode == 3);
+
+    for (uint32_t y = 0; y < outH; ++y) {
+      uint8_t *row = pixels + static_cast<size_t>(y) * stride;
+      for (uint32_t x = 0; x < outW; ++x) {
+        uint8_t a = row[x * 4 + 3];
+        if (a == 0) {
+          zeroAlphaCount++;
+          if (isRgb) {
+            if (row[x * 4 + 2] != 255 || row[x * 4 + 1] != 255 ||
+                row[x * 4 + 0] != 255) {
+              zeroAlphaButNotEmptyCount++;
+            }
+          } else {
+            if (row[x * 4 + 0] != 255) {
+              zeroAlphaButNotEmptyCount++;
+            }
+          }
+        }
+      }
+    }
+
+    bool hasTransparency = false;
+    if (zeroAlphaCount > 0) {
+      const size_t maxLeak =
+          (std::max)(static_cast<size_t>(50), zeroAlphaCount / 50);
+      if (zeroAlphaButNotEmptyCount <= maxLeak) {
+        hasTransparency = true;
+      }
+    }
+
+    if (!hasTransparency) {
+#pragma omp parallel for schedule(dynamic, 64)
+      for (int y = 0; y < static_cast<int>(outH); ++y) {
+        uint8_t *row = pixels + static_cast<size_t>(y) * stride;
+        for (uint32_t x = 0; x < outW; ++x) {
+          row[x * 4 + 3] = 255;
+        }
+      }
+    } else {
+      // In-place premultiply straight RGB by Alpha because Direct2D renders
+      // BGRA8888 in D2D1_ALPHA_MODE_PREMULTIPLIED mode.
+      ImageLoaderSimd::PremultiplyAlpha(pixels, outW, outH, stride);
+    }
+  }
+
+  result.pixels = pixels;
+  result.width = static_cast<int>(outW);
+  result.height = static_cast<int>(outH);
+  result.stride = stride;
+  result.format = PixelFormat::BGRA8888;
+  result.success = true;
+  result.metadata.Format = (header.version == 2) ? L"PSB" : L"PSD";
+  result.metadata.LoaderName =
+      (header.version == 2) ? L"PSB Composite" : L"PSD Composite";
+  result.metadata.Width = header.width;
+  result.metadata.Height = header.height;
+
+  std::wstring details =
+      (header.version == 2) ? L"PSB v2 Composite" : L"PSD Composite";
+  details += (header.compression == 0) ? L" Raw" : L" RLE";
+  if (header.depth == 16)
+    details += L" 16bpc";
+  else if (header.depth == 32)
+    details += L" 32bpc";
+  if (outW != header.width || outH != header.height)
+    details += L" [Scaled]";
+  result.metadata.FormatDetails = details;
+  result.metadata.colorInfo.nominalBitDepth = static_cast<uint8_t>(
+      (std::min)(header.depth, static_cast<uint16_t>(255)));
+  result.metadata.colorInfo.primaries = QuickView::ColorPrimaries::SRGB;
+  result.metadata.colorInfo.transfer = (header.depth >= 32)
+                                           ? QuickView::TransferFunction::Linear
+                                           : QuickView::TransferFunction::SRGB;
+  result.metadata.colorInfo.dataSpace =
+      (header.depth >= 32) ? QuickView::PixelDataSpace::SceneLinear
+                           : QuickView::PixelDataSpace::EncodedSdr;
+  // Populate HDR metadata for high bit-depth PSD/PSB
+  result.metadata.hdrMetadata.isValid = true;
+  result.metadata.hdrMetadata.transfer =
+      (header.depth >= 32) ? QuickView::TransferFunction::Linear
+                           : QuickView::TransferFunction::SRGB;
+  result.metadata.hdrMetadata.primaries = QuickView::ColorPrimaries::SRGB;
+  result.metadata.hdrMetadata.isHdr = (header.depth >= 32);
+  result.metadata.hdrMetadata.isSceneLinear = (header.depth >= 32);
+  return S_OK;
+}
+
+} // namespace QuickView::Codec::PsdComposite
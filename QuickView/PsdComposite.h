@@ -0,0 +1,31 @@
+/*
+ * QuickView PSD/PSB Composite Decoder - Public API
+ * Copyright (C) 2026-Present QuickView Contributors
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "CodecTypes.h"
+#include <cstdint>
+
+namespace QuickView::Codec::PsdComposite {
+
+// Decodes the merged image of an 8/16-bit RGB or Gray PSD/PSB (raw or RLE) to
+// BGRA8888, nearest-neighbour downscaled into ctx.targetWidth/targetHeight if set.
+// E_NOTIMPL for other modes/depths (callers fall back to the embedded preview).
+HRESULT Load(const uint8_t* data, size_t size, const DecodeContext& ctx, DecodeResult& result);
+
+} // namespace QuickView::Codec::PsdComposite
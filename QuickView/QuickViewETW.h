@@ -1,5 +1,7 @@
 #pragma once
 
+#ifdef _WIN32
+
 #include <windows.h>
 #include <TraceLoggingProvider.h>
 #include "EditState.h" // For AppConfig g_config
@@ -34,3 +36,10 @@ extern AppConfig g_config;
                 TraceLoggingString(CURRENT_MODULE, "Module"), __VA_ARGS__); \
         } \
     } while(0)
+
+#else
+
+// Headless build off Windows (benchmarks): no ETW provider, events compile away
+#define QV_LOG(EventName, ...) do { } while(0)
+
+#endif // _WIN32
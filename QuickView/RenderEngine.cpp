@@ -82,43 +82,6 @@ bool LoadIccFromResource(T *d2dContext, int resourceId,
   return (res < 0.0f) ? 0.0f : (res > 1.0f ? 1.0f : res);
 }
 
-// CPU-side Reinhard Extended: matches GPU ReinhardExtended.
-// Per-channel version for CPU fallback path.
-static __forceinline float ReinhardExtendedScalar(float L, float Lwhite) {
-  if (L <= 0.0f) return 0.0f;
-  const float LwSq = Lwhite * Lwhite;
-  return L * (1.0f + L / LwSq) / (1.0f + L);
-}
-
-// Apply Reinhard Extended tone mapping preserving chrominance (max-channel luminance).
-static __forceinline void ReinhardExtendedRGB(float r, float g, float b, float Lwhite,
-                                       float& outR, float& outG, float& outB) {
-  float L = (r > g) ? (r > b ? r : b) : (g > b ? g : b); // max channel
-  if (L <= 0.0f) { outR = outG = outB = 0.0f; return; }
-  float mappedL = ReinhardExtendedScalar(L, Lwhite);
-  float scale = mappedL / L;
-  outR = r * scale;
-  outG = g * scale;
-  outB = b * scale;
-}
-
-static __forceinline float LinearToSrgbScalar(float value) {
-  value = (value > 0.0f) ? value : 0.0f;
-  if (value <= 0.0031308f) {
-    return value * 12.92f;
-  } else {
-    return 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
-  }
-}
-
-
-
-static __forceinline uint8_t EncodeLinearToSdr8(float value) {
-  value = LinearToSrgbScalar(value);
-  value = (value < 0.0f) ? 0.0f : (value > 1.0f ? 1.0f : value);
-  return static_cast<uint8_t>(value * 255.0f + 0.5f);
-}
-
 struct ColorMatrix3x3 {
   float m[3][3];
 };
@@ -862,12 +825,6 @@ float HlgScalarToLinearScRgb(float v) {
   return powf((std::max)(scene, 0.0f), 1.2f) * HLG_REFERENCE_PEAK_SCRGB;
 }
 
-// libplacebo-compatible smoothstep (edge0 > edge1 maps to decreasing ramp)
-float SmoothStep(float edge0, float edge1, float x) {
-  x = std::clamp((x - edge0) / (edge1 - edge0 + 1e-9f), 0.0f, 1.0f);
-  return x * x * (3.0f - 2.0f * x);
-}
-
 uint32_t FloatBits(float value) {
   uint32_t bits = 0;
   memcpy(&bits, &value, sizeof(bits));
@@ -1238,130 +1195,8 @@ BuildToneMapSettings(const QuickView::RawImageFrame &frame,
       settings.displayPeakScRgb = 1.0f;
       settings.contentPeakScRgb = settings.displayPeakScRgb;
   }
-  const float contentPeakLinear = settings.contentPeakScRgb;
-  const float displayPeakLinear = (std::max)(settings.displayPeakScRgb, 1e-4f);
-
   if (settings.mode == 0) { // Spline (libplacebo pl_tone_map_spline port — PQ space)
-    // --- Convert all luminance bounds to PQ space [0, 1] ---
-    const float input_min  = 0.0f;
-    const float input_max  = LinearToPQ(contentPeakLinear);
-    const float output_min = 0.0f;
-    const float output_max = LinearToPQ(displayPeakLinear);
-
-    // Static image viewer: force input_avg = 0 to use default knee position.
-    // mpv uses dynamic peak detection (hdr-compute-peak=yes) for real-time scene avg,
-    // NOT static maxFALL metadata. For static images, libplacebo defaults to
-    // knee_default (0.4) when input_avg is 0, producing the standard spline curve.
-    const float input_avg = 0.0f;
-
-    // --- st2094_pick_knee (libplacebo port, PQ space) ---
-    constexpr float knee_adaptation = 0.4f;
-    constexpr float knee_minimum    = 0.1f;
-    constexpr float knee_maximum    = 0.8f;
-    constexpr float knee_default    = 0.4f;
-
-    const float src_knee_min = input_min + knee_minimum * (input_max - input_min);
-    const float src_knee_max = input_min + knee_maximum * (input_max - input_min);
-    const float dst_knee_min = output_min + knee_minimum * (output_max - output_min);
-    const float dst_knee_max = output_min + knee_maximum * (output_max - output_min);
-
-    float src_knee;
-    float dst_knee;
-
-    if (g_config.HdrSplineKnee > 0.0f) {
-        // Manual Static Mode: Knee is a percentage of the display peak luminance.
-        // Maintain 1:1 absolute mapping up to the knee point.
-        dst_knee = output_min + g_config.HdrSplineKnee * (output_max - output_min);
-        src_knee = dst_knee; // 1:1 mapping in PQ space means input = output
-        
-        // Ensure we don't exceed input peak, otherwise we are stretching instead of compressing
-        if (src_knee > input_max) {
-            src_knee = input_max;
-            dst_knee = src_knee;
-        }
-    } else {
-        // Automatic Dynamic Mode (libplacebo default)
-        // Source knee from scene average brightness (clamped to safe range)
-        src_knee = (input_avg > 0.0f)
-            ? input_avg
-            : (input_min + knee_default * (input_max - input_min));
-        src_knee = std::clamp(src_knee, src_knee_min, src_knee_max);
-
-        // Target adaptation: linear rescale + perceptual weighting
-        const float target = (src_knee - input_min) / (input_max - input_min + 1e-9f);
-        const float adapted = output_min + target * (output_max - output_min);
-
-        // Increase adaptation strength near extreme knee positions
-        const float tuning = 1.0f - SmoothStep(knee_maximum, knee_default, target)
-                                   * SmoothStep(knee_minimum, knee_default, target);
-        const float adaptation = knee_adaptation + (1.0f - knee_adaptation) * tuning;
-        dst_knee = src_knee + (adapted - src_knee) * adaptation;
-        dst_knee = std::clamp(dst_knee, dst_knee_min, dst_knee_max);
-    }
-
-    // --- Spline slope and polynomial solve (PQ space, identical to libplacebo) ---
-    constexpr float spline_contrast = 0.5f;
-    constexpr float slope_tuning    = 1.5f;
-    constexpr float slope_offset    = 0.2f;
-
-    float slope = (dst_knee - output_min) / (src_knee - input_min + 1e-9f);
-
-    // Tune slope: closer to 1.0 when peak ratio is small, closer to linear when large
-    float ratio = input_max / (output_max + 1e-9f) - 1.0f;
-    ratio = std::clamp(slope_tuning * ratio, slope_offset, 1.0f + slope_offset);
-    slope = powf(slope, (1.0f - spline_contrast) * ratio);
-
-    // Normalize around pivot for polynomial fitting
-    const float in_min  = input_min  - src_knee;
-    const float in_max  = input_max  - src_knee;
-    const float out_min = output_min - dst_knee;
-    const float out_max = output_max - dst_knee;
-
-    // P polynomial (order 2) — shadow region
-    // P(in_min) = out_min, P'(0) = slope, P(0) = 0
-    const float Pa = (std::abs(in_min) > 1e-7f)
-        ? (out_min - slope * in_min) / (in_min * in_min) : 0.0f;
-    const float Pb = slope;
-
-    // Q polynomial (order 3) — highlight region
-    // Q(in_max) = out_max, Q''(in_max) = 0, Q(0) = 0, Q'(0) = slope
-    float Qa, Qb, Qc;
-    if (std::abs(in_max) > 1e-7f) {
-      const float t = 2.0f * in_max * in_max;
-      Qa = (slope * in_max - out_max) / (in_max * t);
-      Qb = -3.0f * (slope * in_max - out_max) / t;
-      Qc = slope;
-    } else {
-      Qa = 0.0f; Qb = 0.0f; Qc = slope;
-    }
-
-    settings.splineSrcPivot = src_knee;   // PQ space
-    settings.splineDstPivot = dst_knee;   // PQ space
-    settings.splinePa = Pa;
-    settings.splinePb = Pb;
-    settings.splineQa = Qa;
-    settings.splineQb = Qb;
-    settings.splineQc = Qc;
-
-    // Calculate mapped scene average luminance in PQ space for contrast recovery
-    float input_avg_pq = input_avg;
-    if (input_avg_pq <= 0.0f) {
-      input_avg_pq = (g_config.HdrSplineKnee > 0.0f) ? src_knee : (input_min + knee_default * (input_max - input_min));
-    }
-    float sx = input_avg_pq - src_knee;
-    float mapped_avg;
-    if (sx > 0.0f) {
-      sx = std::min(sx, input_max - src_knee);
-      mapped_avg = ((Qa * sx + Qb) * sx + Qc) * sx + dst_knee;
-    } else {
-      sx = std::max(sx, -src_knee);
-      mapped_avg = (Pa * sx + Pb) * sx + dst_knee;
-    }
-    mapped_avg = std::clamp(mapped_avg, 0.0f, output_max);
-
-    settings.sceneAvgPq = input_avg_pq;
-    settings.mappedAvgPq = mapped_avg;
-    settings.contrastRecovery = 0.0f; // Disabled: libplacebo default is 0.0 (high_quality preset uses 0.3, video-optimized)
+    ImageLoaderSimd::FitSplineToneCurve(settings, g_config.HdrSplineKnee);
   } else {
     // Mode 1/2: displayPeakScRgb is already linear scRGB.
     settings.sceneAvgPq = 0.0f;
@@ -1496,6 +1331,30 @@ BuildToneMapSettings(const QuickView::RawImageFrame &frame,
   return settings;
 }
 
+// Settings for tone mapping a composed gain-map image (GPU bake and its CPU twin)
+QuickView::ToneMapSettings
+BuildGainMapToneMapSettings(const QuickView::RawImageFrame &frame,
+                            const QuickView::DisplayColorState &displayState,
+                            float targetHeadroom) {
+  QuickView::ToneMapSettings toneMapSettings = BuildToneMapSettings(frame, displayState, true);
+
+  // Gain Map composition results in a "fake" HDR texture. 
+  // We need to override the peak to match the gain applied.
+  toneMapSettings.contentPeakScRgb = (std::max)(
+      toneMapSettings.contentPeakScRgb,
+      std::exp2((std::max)(0.0f, targetHeadroom)));
+
+  toneMapSettings.transferFunction =
+      static_cast<uint32_t>(QuickView::TransferFunction::Linear);
+
+  // [v6.1.4.28] Restored identity matrix for Gain Map stability.
+  // Applying gamut mapping here was causing crashes and black regions.
+  std::fill(std::begin(toneMapSettings.colorMatrix), std::end(toneMapSettings.colorMatrix), 0.0f);
+  toneMapSettings.colorMatrix[0] = toneMapSettings.colorMatrix[5] =
+      toneMapSettings.colorMatrix[10] = toneMapSettings.colorMatrix[15] = 1.0f;
+  return toneMapSettings;
+}
+
 bool OpenCmsProfileFromBlob(const ProfileBlob& blob, ScopedCmsProfile* outProfile) {
   if (!outProfile || blob.bytes.empty()) return false;
   outProfile->Reset(cmsOpenProfileFromMem(blob.bytes.data(),
@@ -2353,6 +2212,13 @@ CRenderEngine::UploadRawFrameToGPU(const QuickView::RawImageFrame &frame,
                   break; 
               }
 
+              // Same image at the same headroom (e.g. a re-upload after a resize): reuse the bake
+              if (m_bakeCache.BakeMatches(frame.pixels, frame.auxLayer->pixels, (UINT)frame.width, (UINT)frame.height,
+                                          payload.targetHeadroom, useHdrOutput, false)) {
+                  m_bakeCache.bakedBitmap.CopyTo(outBitmap);
+                  return S_OK;
+              }
+
               ComPtr<ID3D11Texture2D> pBaked;
               HRESULT hrBake = S_OK;
 
@@ -2380,6 +2246,8 @@ CRenderEngine::UploadRawFrameToGPU(const QuickView::RawImageFrame &frame,
                       &m_bakeCache.baseTexture, &m_bakeCache.auxTexture);
                   
                   if (SUCCEEDED(hrBake)) {
+                      m_bakeCache.bakedBitmap.Reset(); // Belongs to the previous image
+                      m_bakeCache.bakedOnCpu = false;
                       m_bakeCache.lastBasePixels = frame.pixels;
                       m_bakeCache.lastAuxPixels = frame.auxLayer->pixels;
                       m_bakeCache.lastBaseW = frame.width;
@@ -2390,26 +2258,8 @@ CRenderEngine::UploadRawFrameToGPU(const QuickView::RawImageFrame &frame,
               }
 
               if (SUCCEEDED(hrBake) && pBaked) {
-                  m_bakeCache.lastHeadroom = payload.targetHeadroom;
-                  
-                  QuickView::ToneMapSettings toneMapSettings =
-                      BuildToneMapSettings(frame, m_displayColorState, true);
-                  
-                  // Gain Map composition results in a "fake" HDR texture. 
-                  // We need to override the peak to match the gain applied.
-                  toneMapSettings.contentPeakScRgb = (std::max)(
-                      toneMapSettings.contentPeakScRgb,
-                      std::exp2((std::max)(0.0f, payload.targetHeadroom)));
-                  
-                  toneMapSettings.transferFunction =
-                      static_cast<uint32_t>(QuickView::TransferFunction::Linear);
-
-                  // [v6.1.4.28] Restored identity matrix for Gain Map stability.
-                  // Applying gamut mapping here was causing crashes and black regions.
-                  toneMapSettings.colorMatrix[ 0] = 1.0f; toneMapSettings.colorMatrix[ 1] = 0.0f; toneMapSettings.colorMatrix[ 2] = 0.0f; toneMapSettings.colorMatrix[ 3] = 0.0f;
-                  toneMapSettings.colorMatrix[ 4] = 0.0f; toneMapSettings.colorMatrix[ 5] = 1.0f; toneMapSettings.colorMatrix[ 6] = 0.0f; toneMapSettings.colorMatrix[ 7] = 0.0f;
-                  toneMapSettings.colorMatrix[ 8] = 0.0f; toneMapSettings.colorMatrix[ 9] = 0.0f; toneMapSettings.colorMatrix[10] = 1.0f; toneMapSettings.colorMatrix[11] = 0.0f;
-                  toneMapSettings.colorMatrix[12] = 0.0f; toneMapSettings.colorMatrix[13] = 0.0f; toneMapSettings.colorMatrix[14] = 0.0f; toneMapSettings.colorMatrix[15] = 1.0f;
+                  const QuickView::ToneMapSettings toneMapSettings =
+                      BuildGainMapToneMapSettings(frame, m_displayColorState, payload.targetHeadroom);
 
                   ComPtr<ID3D11Texture2D> pMapped;
                   HRESULT hrToneMap = useHdrOutput
@@ -2444,6 +2294,8 @@ CRenderEngine::UploadRawFrameToGPU(const QuickView::RawImageFrame &frame,
                   
                   if (SUCCEEDED(hrResult)) {
                       m_bakeCache.bakedBitmap = result;
+                      m_bakeCache.lastHeadroom = payload.targetHeadroom;
+                      m_bakeCache.lastHdrOutput = useHdrOutput;
                       result.CopyTo(outBitmap);
                       return S_OK;
                   }
@@ -2456,6 +2308,87 @@ CRenderEngine::UploadRawFrameToGPU(const QuickView::RawImageFrame &frame,
       }
   }
 
+  // No compute device: the same bake through the shaders' CPU twins, in row bands
+  // straight into the bitmap so no full-frame FP16 intermediate is ever allocated
+  if (frame.blendOp == QuickView::GpuBlendOp::UltraHdrGainMap &&
+      frame.auxLayer && frame.auxLayer->pixels &&
+      !(m_computeEngine && m_computeEngine->IsAvailable()))
+  {
+      QuickView::GpuShaderPayload payload = frame.shaderPayload;
+      payload.targetHeadroom = m_displayColorState.GetHdrHeadroomStops(g_config.HdrPeakNitsOverride);
+      const UINT32 maxBitmapSize = m_d2dContext->GetMaximumBitmapSize();
+      if (payload.targetHeadroom > 0.01f &&
+          static_cast<UINT32>(frame.width) <= maxBitmapSize && static_cast<UINT32>(frame.height) <= maxBitmapSize) {
+          const bool useHdrOutput = ShouldUseHdrOutputForFrame(frame);
+          if (m_bakeCache.BakeMatches(frame.pixels, frame.auxLayer->pixels, (UINT)frame.width, (UINT)frame.height,
+                                      payload.targetHeadroom, useHdrOutput, true)) {
+              m_bakeCache.bakedBitmap.CopyTo(outBitmap);
+              return S_OK;
+          }
+
+          D2D1_BITMAP_PROPERTIES1 bakedProps = GetDefaultBitmapProps(
+              useHdrOutput ? DXGI_FORMAT_R16G16B16A16_FLOAT : DXGI_FORMAT_B8G8R8A8_UNORM,
+              D2D1_ALPHA_MODE_PREMULTIPLIED);
+          ComPtr<ID2D1ColorContext> scRgbContext;
+          if (useHdrOutput &&
+              SUCCEEDED(m_d2dContext->CreateColorContext(D2D1_COLOR_SPACE_SCRGB, nullptr, 0, &scRgbContext))) {
+              bakedProps.colorContext = scRgbContext.Get();
+          }
+          ComPtr<ID2D1Bitmap1> result;
+          HRESULT hrBake = m_d2dContext->CreateBitmap(
+              D2D1::SizeU(static_cast<UINT32>(frame.width), static_cast<UINT32>(frame.height)),
+              nullptr, 0, &bakedProps, &result);
+
+          if (SUCCEEDED(hrBake)) {
+              const QuickView::ToneMapSettings toneMapSettings =
+                  BuildGainMapToneMapSettings(frame, m_displayColorState, payload.targetHeadroom);
+              // ~1 MP per band: still wide enough for the kernels' own row threading
+              const int bandRows = (std::max)(1, (1 << 20) / frame.width);
+              const int composedStride = frame.width * 8;
+              const int mappedStride = frame.width * (useHdrOutput ? 8 : 4);
+              std::vector<uint16_t> composed(static_cast<size_t>(frame.width) * bandRows * 4);
+              std::vector<uint8_t> mapped(static_cast<size_t>(mappedStride) * bandRows);
+              const uint8_t* composedBytes = reinterpret_cast<const uint8_t*>(composed.data());
+
+              for (int y0 = 0; y0 < frame.height && SUCCEEDED(hrBake); y0 += bandRows) {
+                  const int rows = (std::min)(bandRows, frame.height - y0);
+                  ImageLoaderSimd::ComposeGainMapRows(frame.pixels, frame.stride, frame.format, frame.width, frame.height,
+                                                      frame.auxLayer->pixels, frame.auxLayer->width, frame.auxLayer->height,
+                                                      frame.auxLayer->stride, payload, y0, y0 + rows,
+                                                      composed.data(), composedStride);
+                  if (useHdrOutput) {
+                      ImageLoaderSimd::ToneMapHdrToHdr(composedBytes, composedStride, QuickView::PixelFormat::R16G16B16A16_FLOAT,
+                                                       reinterpret_cast<uint16_t*>(mapped.data()), mappedStride,
+                                                       frame.width, rows, toneMapSettings);
+                  } else {
+                      ImageLoaderSimd::ToneMapHdrToSdr(composedBytes, composedStride, QuickView::PixelFormat::R16G16B16A16_FLOAT,
+                                                       mapped.data(), mappedStride, frame.width, rows, toneMapSettings);
+                  }
+                  const D2D1_RECT_U band = D2D1::RectU(0, static_cast<UINT32>(y0), static_cast<UINT32>(frame.width),
+                                                       static_cast<UINT32>(y0 + rows));
+                  hrBake = result->CopyFromMemory(&band, mapped.data(), static_cast<UINT32>(mappedStride));
+              }
+          }
+
+          if (SUCCEEDED(hrBake)) {
+              // Owns no textures: the GPU path's uploads belong to a device that is gone
+              m_bakeCache.Reset();
+              m_bakeCache.lastBasePixels = frame.pixels;
+              m_bakeCache.lastAuxPixels = frame.auxLayer->pixels;
+              m_bakeCache.lastBaseW = frame.width;
+              m_bakeCache.lastBaseH = frame.height;
+              m_bakeCache.lastAuxW = frame.auxLayer->width;
+              m_bakeCache.lastAuxH = frame.auxLayer->height;
+              m_bakeCache.bakedBitmap = result;
+              m_bakeCache.lastHeadroom = payload.targetHeadroom;
+              m_bakeCache.lastHdrOutput = useHdrOutput;
+              m_bakeCache.bakedOnCpu = true;
+              result.CopyTo(outBitmap);
+              return S_OK;
+          }
+      }
+  }
+
   // Map PixelFormat to DXGI_FORMAT and D2D1_ALPHA_MODE
   DXGI_FORMAT dxgiFormat;
   D2D1_ALPHA_MODE alphaMode = D2D1_ALPHA_MODE_PREMULTIPLIED;
@@ -2612,21 +2545,24 @@ CRenderEngine::UploadRawFrameToGPU(const QuickView::RawImageFrame &frame,
               }
           }
           if (!rawBitmap) {
-              // PASSTHROUGH: Fallback only when compute engine is unavailable or GPU dispatch failed
+              // Compute engine unavailable or GPU dispatch failed: run CSToneMapHDR's CPU twin
               g_runtime.LastFrameGpuToneMapped = false;
               QV_LOG("Render_ToneMapDecision",
-                  TraceLoggingString("HDR PASSTHROUGH (ComputeEngine unavailable or error fallback)", "Shader"),
+                  TraceLoggingString("ToneMapHdrToHdr CPU (ComputeEngine unavailable or error fallback)", "Shader"),
                   TraceLoggingFloat32(toneMapSettings.displayPeakScRgb, "DisplayPeak"),
                   TraceLoggingFloat32(toneMapSettings.contentPeakScRgb, "ContentPeak"),
                   TraceLoggingBool(m_computeEngine && m_computeEngine->IsAvailable(), "ComputeAvailable"));
+              std::vector<uint16_t> hdrPixels(static_cast<size_t>(frame.width) * frame.height * 4);
+              ImageLoaderSimd::ToneMapHdrToHdr(uploadPixels, static_cast<int>(uploadStride), frame.format,
+                                               hdrPixels.data(), frame.width * 8, frame.width, frame.height,
+                                               toneMapSettings);
               D2D1_BITMAP_PROPERTIES1 hdrProps = GetDefaultBitmapProps(
-                  frame.format == QuickView::PixelFormat::R16G16B16A16_UNORM ? DXGI_FORMAT_R16G16B16A16_UNORM : 
-                  (frame.format == QuickView::PixelFormat::R16G16B16A16_FLOAT ? DXGI_FORMAT_R16G16B16A16_FLOAT : DXGI_FORMAT_R32G32B32A32_FLOAT), D2D1_ALPHA_MODE_PREMULTIPLIED);
+                  DXGI_FORMAT_R16G16B16A16_FLOAT, D2D1_ALPHA_MODE_PREMULTIPLIED);
               hdrProps.colorContext = scRgbContext.Get();
               m_d2dContext->CreateBitmap(
                   D2D1::SizeU(static_cast<UINT32>(frame.width),
                               static_cast<UINT32>(frame.height)),
-                  uploadPixels, uploadStride, &hdrProps, &rawBitmap);
+                  hdrPixels.data(), static_cast<UINT32>(frame.width * 8), &hdrProps, &rawBitmap);
           }
           srcContext = scRgbContext; // For FLOAT, always scRGB source in CMS
       } else {
@@ -2657,134 +2593,13 @@ CRenderEngine::UploadRawFrameToGPU(const QuickView::RawImageFrame &frame,
               }
           }
           if (!rawBitmap) {
+              // CPU twin of CSToneMap: same settings, same curve, straight-alpha BGRA8
               g_runtime.LastFrameGpuToneMapped = false;
               std::vector<uint8_t> sdrPixels(static_cast<size_t>(frame.width) * frame.height * 4);
               const QuickView::ToneMapSettings toneMapSettings = BuildToneMapSettings(frame, m_displayColorState);
-              const float exposure = toneMapSettings.exposure;
-              // Apply exposure
-              for (int y = 0; y < frame.height; ++y) {
-                  const uint8_t *srcRow = uploadPixels + static_cast<size_t>(y) * uploadStride;
-                  uint8_t *dstRow = sdrPixels.data() + static_cast<size_t>(y) * frame.width * 4;
-                  for (int x = 0; x < frame.width; ++x) {
-                      float r, g, b, a;
-                      if (frame.format == QuickView::PixelFormat::R16G16B16A16_UNORM) {
-                          const uint16_t* p16 = reinterpret_cast<const uint16_t*>(srcRow);
-                          r = p16[x * 4 + 0] / 65535.0f;
-                          g = p16[x * 4 + 1] / 65535.0f;
-                          b = p16[x * 4 + 2] / 65535.0f;
-                          a = std::clamp(p16[x * 4 + 3] / 65535.0f, 0.0f, 1.0f);
-                          // Apply EOTF (PQ/HLG to Linear)
-                          if (toneMapSettings.transferFunction == static_cast<uint32_t>(QuickView::TransferFunction::PQ)) {
-                              r = PQToLinear(r); g = PQToLinear(g); b = PQToLinear(b);
-                          } else if (toneMapSettings.transferFunction == static_cast<uint32_t>(QuickView::TransferFunction::HLG)) {
-                              // HLG CPU fallback can be implemented here if needed.
-                          }
-                      } else if (frame.format == QuickView::PixelFormat::R16G16B16A16_FLOAT) {
-                          const uint16_t* p16 = reinterpret_cast<const uint16_t*>(srcRow);
-                          r = DirectX::PackedVector::XMConvertHalfToFloat(p16[x * 4 + 0]);
-                          g = DirectX::PackedVector::XMConvertHalfToFloat(p16[x * 4 + 1]);
-                          b = DirectX::PackedVector::XMConvertHalfToFloat(p16[x * 4 + 2]);
-                          a = std::clamp(DirectX::PackedVector::XMConvertHalfToFloat(p16[x * 4 + 3]), 0.0f, 1.0f);
-                      } else {
-                          const float* pf = reinterpret_cast<const float*>(srcRow);
-                          r = pf[x * 4 + 0]; g = pf[x * 4 + 1]; b = pf[x * 4 + 2];
-                          a = std::clamp(pf[x * 4 + 3], 0.0f, 1.0f);
-                      }
-
-                      // 1. Apply Exposure/Gain first
-                      const float expTotal = exposure * toneMapSettings.exposureGain;
-                      r *= expTotal; g *= expTotal; b *= expTotal;
-
-                      // 2. Calculate luma in source space (BT.2020)
-                      const float luma = r * 0.2627f + g * 0.6780f + b * 0.0593f;
-
-                      // 3. Matrix conversion (Rec.2020 -> Linear sRGB/scRGB)
-                      float outR = r * toneMapSettings.colorMatrix[0] + g * toneMapSettings.colorMatrix[1] + b * toneMapSettings.colorMatrix[2];
-                      float outG = r * toneMapSettings.colorMatrix[4] + g * toneMapSettings.colorMatrix[5] + b * toneMapSettings.colorMatrix[6];
-                      float outB = r * toneMapSettings.colorMatrix[8] + g * toneMapSettings.colorMatrix[9] + b * toneMapSettings.colorMatrix[10];
-
-                      // 4. Gamut Intersection: Pull negative channels towards luma
-                      float minChannel = std::min({outR, outG, outB});
-                      if (minChannel < 0.0f) {
-                          float t = luma / (std::max)(luma - minChannel, 1e-6f);
-                          outR = luma * (1.0f - t) + outR * t;
-                          outG = luma * (1.0f - t) + outG * t;
-                          outB = luma * (1.0f - t) + outB * t;
-                      }
-                      r = (std::max)(0.0f, outR);
-                      g = (std::max)(0.0f, outG);
-                      b = (std::max)(0.0f, outB);
-                      float premulR, premulG, premulB;
-                      if (toneMapSettings.mode == 1) { // Colorimetric
-                          premulR = std::min(1.0f, r / toneMapSettings.displayPeakScRgb) * a;
-                          premulG = std::min(1.0f, g / toneMapSettings.displayPeakScRgb) * a;
-                          premulB = std::min(1.0f, b / toneMapSettings.displayPeakScRgb) * a;
-                      } else if (toneMapSettings.mode == 0) { // Spline (PQ space)
-                               float L = std::max({r, g, b});
-
-                              if (L <= 0.0f) {
-                                  premulR = premulG = premulB = 0.0f;
-                              } else {
-                                  // Convert max-channel luminance to PQ for spline evaluation
-                                  float L_pq = LinearToPQ(L);
-                                  float sx = L_pq - toneMapSettings.splineSrcPivot;
-                                  float targetL_pq;
-                                  if (sx > 0.0f) {
-                                      float contentPeakPq = LinearToPQ(toneMapSettings.contentPeakScRgb);
-                                      sx = std::min(sx, contentPeakPq - toneMapSettings.splineSrcPivot);
-                                      targetL_pq = ((toneMapSettings.splineQa * sx + toneMapSettings.splineQb) * sx + toneMapSettings.splineQc) * sx + toneMapSettings.splineDstPivot;
-                                  } else {
-                                      sx = std::max(sx, -toneMapSettings.splineSrcPivot);
-                                      targetL_pq = (toneMapSettings.splinePa * sx + toneMapSettings.splinePb) * sx + toneMapSettings.splineDstPivot;
-                                  }
-                                  float displayPeakPq = LinearToPQ(toneMapSettings.displayPeakScRgb);
-                                  targetL_pq = std::clamp(targetL_pq, 0.0f, displayPeakPq);
-
-                                  // Convert back to linear for ratio-based color mapping
-                                  float targetL = PQToLinear(targetL_pq);
-                                  float outPeakLinear = toneMapSettings.displayPeakScRgb;
-
-                                  // Compression-based Desaturation (CPU)
-                                  float compressionRatio = targetL / std::max(1e-6f, L);
-                                  float desat = 1.0f - std::pow(std::clamp(compressionRatio, 0.0f, 1.0f), 0.2f);
-                                  
-                                  float outR = r * compressionRatio;
-                                  float outG = g * compressionRatio;
-                                  float outB = b * compressionRatio;
-
-                                  if (desat > 0.0f) {
-                                      // Perception desaturation factor (can be adjusted, here 0.5 as suggested)
-                                      float mixFactor = desat * 0.5f;
-                                      outR = outR * (1.0f - mixFactor) + targetL * mixFactor;
-                                      outG = outG * (1.0f - mixFactor) + targetL * mixFactor;
-                                      outB = outB * (1.0f - mixFactor) + targetL * mixFactor;
-                                  }
-                                  
-                                  if (toneMapSettings.isHdrOutput) {
-                                      premulR = outR * a;
-                                      premulG = outG * a;
-                                      premulB = outB * a;
-                                  } else {
-                                      premulR = (outR / outPeakLinear) * a;
-                                      premulG = (outG / outPeakLinear) * a;
-                                      premulB = (outB / outPeakLinear) * a;
-                                  }
-                              }
-                      } else { // Reinhard Extended (index 2)
-                          float mapR, mapG, mapB;
-                          float Lwhite = toneMapSettings.displayPeakScRgb * exposure * toneMapSettings.exposureGain;
-                          ReinhardExtendedRGB(r, g, b, Lwhite, mapR, mapG, mapB);
-                          premulR = mapR * a;
-                          premulG = mapG * a;
-                          premulB = mapB * a;
-                      }
-
-                      dstRow[x * 4 + 0] = EncodeLinearToSdr8(premulB);
-                      dstRow[x * 4 + 1] = EncodeLinearToSdr8(premulG);
-                      dstRow[x * 4 + 2] = EncodeLinearToSdr8(premulR);
-                      dstRow[x * 4 + 3] = static_cast<uint8_t>(a * 255.0f + 0.5f);
-                  }
-              }
+              ImageLoaderSimd::ToneMapHdrToSdr(uploadPixels, static_cast<int>(uploadStride), frame.format,
+                                               sdrPixels.data(), frame.width * 4, frame.width, frame.height,
+                                               toneMapSettings);
               D2D1_BITMAP_PROPERTIES1 sdrProps = GetDefaultBitmapProps(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED);
               m_d2dContext->CreateBitmap(D2D1::SizeU(static_cast<UINT32>(frame.width), static_cast<UINT32>(frame.height)),
                   sdrPixels.data(), static_cast<UINT32>(frame.width * 4), &sdrProps, &rawBitmap);
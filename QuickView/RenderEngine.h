@@ -184,6 +184,16 @@ private:
         Microsoft::WRL::ComPtr<ID3D11Texture2D> auxTexture;
         Microsoft::WRL::ComPtr<ID2D1Bitmap1> bakedBitmap;
         float lastHeadroom = -1.0f;
+        bool lastHdrOutput = false;
+        bool bakedOnCpu = false;
+
+        // bakedBitmap still applies: same base/aux pixels, headroom, output and path
+        bool BakeMatches(const void* base, const void* aux, UINT w, UINT h,
+                         float headroom, bool hdrOutput, bool onCpu) const {
+            return bakedBitmap && lastBasePixels == base && lastAuxPixels == aux &&
+                   lastBaseW == w && lastBaseH == h && lastHeadroom == headroom &&
+                   lastHdrOutput == hdrOutput && bakedOnCpu == onCpu;
+        }
 
         void Reset() {
             lastBasePixels = nullptr;
@@ -192,6 +202,7 @@ private:
             auxTexture.Reset();
             bakedBitmap.Reset();
             lastHeadroom = -1.0f;
+            bakedOnCpu = false;
         }
     } m_bakeCache;
 
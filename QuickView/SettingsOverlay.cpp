@@ -2430,22 +2430,26 @@ void SettingsOverlay::BuildMenu() {
                      EngineConfig autoCfg = EngineConfig::FromHardware(SystemInfo::Cached());
                      policy.enablePrefetch = true;
                      policy.maxCacheMemory = autoCfg.maxCacheMemory;
+                     policy.maxColdCacheMemory = autoCfg.maxColdCacheMemory;
                      policy.lookAheadCount = autoCfg.prefetchLookAhead;
                      break;
                  }
                  case 2: // Eco
                      policy.enablePrefetch = true;
                      policy.maxCacheMemory = 128 * 1024 * 1024;
+                     policy.maxColdCacheMemory = 64 * 1024 * 1024;
                      policy.lookAheadCount = 1;
                      break;
                  case 3: // Balanced
                      policy.enablePrefetch = true;
                      policy.maxCacheMemory = 512 * 1024 * 1024;
+                     policy.maxColdCacheMemory = 256 * 1024 * 1024;
                      policy.lookAheadCount = 3;
                      break;
                  case 4: // Ultra
                      policy.enablePrefetch = true;
                      policy.maxCacheMemory = 2048ULL * 1024 * 1024;
+                     policy.maxColdCacheMemory = 1024ULL * 1024 * 1024;
                      policy.lookAheadCount = 10;
                      break;
              }
@@ -0,0 +1,368 @@
+#pragma once
+#include "pch.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace QuickView {
+
+    // ============================================================================
+    // [Titan Perf] Work-stealing priority queue for HeavyLanePool dispatch
+    // ============================================================================
+    // One heap under one mutex made every tile batch, CancelOthers and every worker
+    // pop meet on the same lock. Jobs now live in:
+    //   - A global injector (priority heap) for critical work: base layers, full
+    //     decodes and tiles that intersect the viewport. Every worker checks it first.
+    //   - Per-worker bounded lanes (deques kept in descending priority). Batches are
+    //     sorted once and dealt round-robin across the active lanes, so each lane
+    //     holds an interleaved slice of the center-out order. A full lane spills to
+    //     the injector.
+    // A worker takes the better of the injector top and its own lane front; when both
+    // are empty it steals the best advertised front among its peers, and moves half of
+    // that victim's tail into its own lane so the next pops stay local.
+    // Job requirements: `int priority` (higher runs first) and `bool critical`.
+    template<typename Job>
+    class StealingJobQueue {
+    public:
+        static constexpr size_t DEFAULT_LANE_CAPACITY = 64;
+
+        struct Stats {
+            uint64_t injected = 0;   // Critical jobs + lane overflow
+            uint64_t dealt = 0;      // Jobs placed in worker lanes
+            uint64_t overflowed = 0; // Dealt jobs that spilled to the injector
+            uint64_t popped = 0;
+            uint64_t stolen = 0;     // Pops served from a peer lane
+            uint64_t contended = 0;  // Lock acquisitions that had to wait
+        };
+
+        explicit StealingJobQueue(int lanes = 1, size_t laneCapacity = DEFAULT_LANE_CAPACITY) {
+            Reset(lanes, laneCapacity);
+        }
+        StealingJobQueue(const StealingJobQueue&) = delete;
+        StealingJobQueue& operator=(const StealingJobQueue&) = delete;
+
+        // Not thread-safe: call before any worker touches the queue
+        void Reset(int lanes, size_t laneCapacity = DEFAULT_LANE_CAPACITY) {
+            lanes = (std::max)(1, lanes);
+            m_lanes.clear();
+            for (int i = 0; i < lanes; ++i) {
+                m_lanes.push_back(std::make_unique<Lane>());
+            }
+            m_laneCapacity = (std::max)(laneCapacity, (size_t)1);
+            m_activeLanes = lanes;
+            m_injector.clear();
+            m_injectorTop = EMPTY;
+            m_size = 0;
+        }
+
+        // Lanes [0, n) receive dealt work (workers above the concurrency limit idle;
+        // anything already in their lanes is stolen by the others)
+        void SetActiveLanes(int n) {
+            m_activeLanes.store((std::clamp)(n, 1, (int)m_lanes.size()), std::memory_order_relaxed);
+        }
+
+        int LaneCount() const { return (int)m_lanes.size(); }
+        size_t Size() const { return m_size.load(std::memory_order_acquire); }
+        bool Empty() const { return Size() == 0; }
+
+        void Push(Job job) {
+            m_size.fetch_add(1, std::memory_order_acq_rel);
+            if (job.critical) {
+                std::unique_lock lock = Lock(m_injectorMutex);
+                InjectLocked(std::move(job));
+                m_stats.injected++;
+                return;
+            }
+            std::vector<Job> one;
+            one.push_back(std::move(job));
+            Deal(one);
+        }
+
+        // Moves every job out of `jobs` (left empty, capacity kept for reuse)
+        void PushBatch(std::vector<Job>& jobs) {
+            if (jobs.empty()) return;
+            m_size.fetch_add(jobs.size(), std::memory_order_acq_rel);
+
+            auto firstLocal = std::stable_partition(jobs.begin(), jobs.end(), [](const Job& j) { return j.critical; });
+            if (firstLocal != jobs.begin()) {
+                std::unique_lock lock = Lock(m_injectorMutex);
+                for (auto it = jobs.begin(); it != firstLocal; ++it) {
+                    InjectLocked(std::move(*it));
+                }
+                m_stats.injected += (uint64_t)(firstLocal - jobs.begin());
+            }
+            jobs.erase(jobs.begin(), firstLocal);
+            Deal(jobs);
+            jobs.clear();
+        }
+
+        bool TryPop(int lane, Job* out) {
+            lane = (std::clamp)(lane, 0, (int)m_lanes.size() - 1);
+            Lane& own = *m_lanes[lane];
+            const int64_t injectorTop = m_injectorTop.load(std::memory_order_acquire);
+            const int64_t ownFront = own.front.load(std::memory_order_acquire);
+
+            if (injectorTop != EMPTY && injectorTop >= ownFront && PopInjector(out)) return Popped(false);
+            if (ownFront != EMPTY && PopFront(own, out)) return Popped(false);
+            if (PopInjector(out)) return Popped(false);
+            if (Steal(lane, out)) return Popped(true);
+            return false;
+        }
+
+        template<typename Pred>
+        bool AnyOf(Pred pred) const {
+            {
+                std::lock_guard lock(m_injectorMutex);
+                if (std::any_of(m_injector.begin(), m_injector.end(), pred)) return true;
+            }
+            for (const auto& lane : m_lanes) {
+                std::lock_guard lock(lane->mutex);
+                if (std::any_of(lane->jobs.begin(), lane->jobs.end(), pred)) return true;
+            }
+            return false;
+        }
+
+        // Pushes `job` unless a queued job matches `pred`; returns whether it was
+        // pushed. Check and push are one step for every PushUnique caller, so two
+        // racing submits of the same work cannot both get in.
+        template<typename Pred>
+        bool PushUnique(Pred pred, Job job) {
+            std::unique_lock lock = Lock(m_uniqueMutex);
+            if (AnyOf(pred)) return false;
+            Push(std::move(job));
+            return true;
+        }
+
+        // PushUnique that also removes queued jobs matching `superseded` (work the new
+        // job covers, handed to `sink`) in the same step. Returns whether it was pushed.
+        template<typename Pred, typename Superseded, typename Sink>
+        bool PushReplacing(Pred pred, Superseded superseded, Sink sink, Job job) {
+            std::unique_lock lock = Lock(m_uniqueMutex);
+            if (AnyOf(pred)) return false;
+            RemoveIf(superseded, sink);
+            Push(std::move(job));
+            return true;
+        }
+
+        // Removes queued jobs matching `pred`, handing each to `sink` (under the lock
+        // of the queue part that held it). Returns the number removed.
+        template<typename Pred, typename Sink>
+        size_t RemoveIf(Pred pred, Sink sink) {
+            size_t removed = 0;
+            {
+                std::unique_lock lock = Lock(m_injectorMutex);
+                auto it = std::stable_partition(m_injector.begin(), m_injector.end(), [&](const Job& j) { return !pred(j); });
+                for (auto r = it; r != m_injector.end(); ++r) sink(*r);
+                removed += (size_t)(m_injector.end() - it);
+                m_injector.erase(it, m_injector.end());
+                std::make_heap(m_injector.begin(), m_injector.end(), HeapLess);
+                PublishInjectorTop();
+            }
+            for (auto& lanePtr : m_lanes) {
+                Lane& lane = *lanePtr;
+                std::unique_lock lock = Lock(lane.mutex);
+                auto it = std::stable_partition(lane.jobs.begin(), lane.jobs.end(), [&](const Job& j) { return !pred(j); });
+                for (auto r = it; r != lane.jobs.end(); ++r) sink(*r);
+                removed += (size_t)(lane.jobs.end() - it);
+                lane.jobs.erase(it, lane.jobs.end());
+                PublishFront(lane);
+            }
+            if (removed) m_size.fetch_sub(removed, std::memory_order_acq_rel);
+            return removed;
+        }
+
+        template<typename Sink>
+        size_t Clear(Sink sink) {
+            return RemoveIf([](const Job&) { return true; }, sink);
+        }
+        size_t Clear() {
+            return Clear([](const Job&) {});
+        }
+
+        Stats GetStats() const {
+            Stats s;
+            s.injected = m_stats.injected.load(std::memory_order_relaxed);
+            s.dealt = m_stats.dealt.load(std::memory_order_relaxed);
+            s.overflowed = m_stats.overflowed.load(std::memory_order_relaxed);
+            s.popped = m_stats.popped.load(std::memory_order_relaxed);
+            s.stolen = m_stats.stolen.load(std::memory_order_relaxed);
+            s.contended = m_stats.contended.load(std::memory_order_relaxed);
+            return s;
+        }
+
+    private:
+        static constexpr int64_t EMPTY = (std::numeric_limits<int64_t>::min)();
+
+        struct alignas(64) Lane {
+            mutable std::mutex mutex;
+            std::deque<Job> jobs;                  // Descending priority
+            std::atomic<int64_t> front{ EMPTY };   // Priority of jobs.front(), for lock-free peeks
+        };
+
+        struct AtomicStats {
+            std::atomic<uint64_t> injected{ 0 };
+            std::atomic<uint64_t> dealt{ 0 };
+            std::atomic<uint64_t> overflowed{ 0 };
+            std::atomic<uint64_t> popped{ 0 };
+            std::atomic<uint64_t> stolen{ 0 };
+            std::atomic<uint64_t> contended{ 0 };
+        };
+
+        static bool HeapLess(const Job& a, const Job& b) { return a.priority < b.priority; }
+        static bool RunsBefore(const Job& a, const Job& b) { return a.priority > b.priority; }
+
+        std::unique_lock<std::mutex> Lock(std::mutex& m) {
+            std::unique_lock<std::mutex> lock(m, std::try_to_lock);
+            if (!lock.owns_lock()) {
+                m_stats.contended.fetch_add(1, std::memory_order_relaxed);
+                lock.lock();
+            }
+            return lock;
+        }
+
+        bool Popped(bool stolen) {
+            m_size.fetch_sub(1, std::memory_order_acq_rel);
+            m_stats.popped.fetch_add(1, std::memory_order_relaxed);
+            if (stolen) m_stats.stolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        void PublishInjectorTop() {
+            m_injectorTop.store(m_injector.empty() ? EMPTY : (int64_t)m_injector.front().priority, std::memory_order_release);
+        }
+        static void PublishFront(Lane& lane) {
+            lane.front.store(lane.jobs.empty() ? EMPTY : (int64_t)lane.jobs.front().priority, std::memory_order_release);
+        }
+
+        void InjectLocked(Job job) {
+            m_injector.push_back(std::move(job));
+            std::push_heap(m_injector.begin(), m_injector.end(), HeapLess);
+            PublishInjectorTop();
+        }
+
+        bool PopInjector(Job* out) {
+            if (m_injectorTop.load(std::memory_order_acquire) == EMPTY) return false;
+            std::unique_lock lock = Lock(m_injectorMutex);
+            if (m_injector.empty()) return false;
+            std::pop_heap(m_injector.begin(), m_injector.end(), HeapLess);
+            *out = std::move(m_injector.back());
+            m_injector.pop_back();
+            PublishInjectorTop();
+            return true;
+        }
+
+        bool PopFront(Lane& lane, Job* out) {
+            std::unique_lock lock = Lock(lane.mutex);
+            if (lane.jobs.empty()) return false;
+            *out = std::move(lane.jobs.front());
+            lane.jobs.pop_front();
+            PublishFront(lane);
+            return true;
+        }
+
+        // Merges descending-sorted `incoming` into the lane; what does not fit is
+        // returned in `incoming` (lowest priorities)
+        void MergeIntoLane(Lane& lane, std::vector<Job>& incoming) {
+            std::unique_lock lock = Lock(lane.mutex);
+            if (lane.jobs.empty() || !RunsBefore(incoming.front(), lane.jobs.back())) {
+                for (auto& job : incoming) lane.jobs.push_back(std::move(job));
+            } else {
+                std::deque<Job> merged;
+                std::merge(std::make_move_iterator(lane.jobs.begin()), std::make_move_iterator(lane.jobs.end()),
+                           std::make_move_iterator(incoming.begin()), std::make_move_iterator(incoming.end()),
+                           std::back_inserter(merged), RunsBefore);
+                lane.jobs.swap(merged);
+            }
+            incoming.clear();
+            while (lane.jobs.size() > m_laneCapacity) {
+                incoming.push_back(std::move(lane.jobs.back()));
+                lane.jobs.pop_back();
+            }
+            PublishFront(lane);
+        }
+
+        void Deal(std::vector<Job>& jobs) {
+            if (jobs.empty()) return;
+            std::stable_sort(jobs.begin(), jobs.end(), RunsBefore);
+
+            const int lanes = m_activeLanes.load(std::memory_order_relaxed);
+            const int start = (int)(m_nextLane.fetch_add((uint32_t)jobs.size(), std::memory_order_relaxed) % (uint32_t)lanes);
+            std::vector<std::vector<Job>> shares((size_t)(std::min)((size_t)lanes, jobs.size()));
+            for (size_t i = 0; i < jobs.size(); ++i) {
+                shares[i % shares.size()].push_back(std::move(jobs[i]));
+            }
+
+            std::vector<Job> overflow;
+            for (size_t s = 0; s < shares.size(); ++s) {
+                MergeIntoLane(*m_lanes[(start + (int)s) % lanes], shares[s]);
+                for (auto& job : shares[s]) overflow.push_back(std::move(job));
+            }
+            m_stats.dealt.fetch_add(jobs.size() - overflow.size(), std::memory_order_relaxed);
+            if (overflow.empty()) return;
+
+            std::unique_lock lock = Lock(m_injectorMutex);
+            for (auto& job : overflow) InjectLocked(std::move(job));
+            m_stats.injected.fetch_add(overflow.size(), std::memory_order_relaxed);
+            m_stats.overflowed.fetch_add(overflow.size(), std::memory_order_relaxed);
+        }
+
+        bool Steal(int self, Job* out) {
+            const int n = (int)m_lanes.size();
+            for (int attempt = 0; attempt < 2; ++attempt) {
+                int victim = -1;
+                int64_t best = EMPTY;
+                for (int k = 1; k < n; ++k) {
+                    const int i = (self + k) % n;
+                    const int64_t front = m_lanes[i]->front.load(std::memory_order_acquire);
+                    if (front != EMPTY && (victim < 0 || front > best)) {
+                        victim = i;
+                        best = front;
+                    }
+                }
+                if (victim < 0) return false;
+
+                std::vector<Job> tail;
+                {
+                    Lane& v = *m_lanes[victim];
+                    std::unique_lock lock = Lock(v.mutex);
+                    if (v.jobs.empty()) continue; // Drained meanwhile: rescan once
+                    *out = std::move(v.jobs.front());
+                    v.jobs.pop_front();
+                    const size_t take = v.jobs.size() / 2;
+                    const auto tailBegin = v.jobs.end() - (std::ptrdiff_t)take;
+                    tail.assign(std::make_move_iterator(tailBegin), std::make_move_iterator(v.jobs.end()));
+                    v.jobs.erase(tailBegin, v.jobs.end());
+                    PublishFront(v);
+                }
+                if (!tail.empty()) {
+                    MergeIntoLane(*m_lanes[self], tail);
+                    if (!tail.empty()) {
+                        std::unique_lock lock = Lock(m_injectorMutex);
+                        for (auto& job : tail) InjectLocked(std::move(job));
+                    }
+                }
+                return true;
+            }
+            return false;
+        }
+
+        std::vector<std::unique_ptr<Lane>> m_lanes;
+        size_t m_laneCapacity = DEFAULT_LANE_CAPACITY;
+        std::atomic<int> m_activeLanes{ 1 };
+        std::atomic<uint32_t> m_nextLane{ 0 };
+
+        std::mutex m_uniqueMutex;   // Serializes PushUnique's check + push
+        mutable std::mutex m_injectorMutex;
+        std::vector<Job> m_injector; // Max-heap on priority
+        std::atomic<int64_t> m_injectorTop{ EMPTY };
+
+        std::atomic<size_t> m_size{ 0 }; // Raised before insertion, lowered after removal
+        AtomicStats m_stats;
+    };
+
+} // namespace QuickView
@@ -3,7 +3,7 @@
 #include <algorithm>
 #include <mutex>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -22,21 +22,23 @@ struct SystemInfo {
     
 
 
-    static bool IsSolidStateDrive(const std::wstring& path) {
+    static bool IsSolidStateDrive(const wchar_t* path) {
 #ifdef _WIN32
         // Get Volume Path (e.g. "C:\\") from file path
         wchar_t volumePath[MAX_PATH];
-        if (!GetVolumePathNameW(path.c_str(), volumePath, MAX_PATH)) {
+        if (!GetVolumePathNameW(path, volumePath, MAX_PATH)) {
             return false; // Safest default to HDD-like behavior if failed
         }
 
-        const std::wstring cacheKey(volumePath);
+        // A handful of volumes per session: a linear scan keeps the per-navigation
+        // lookup free of allocations
         static std::mutex s_cacheMutex;
-        static std::unordered_map<std::wstring, bool> s_cache;
+        static std::vector<std::pair<std::wstring, bool>> s_cache;
         {
             std::scoped_lock guard(s_cacheMutex);
-            const auto it = s_cache.find(cacheKey);
-            if (it != s_cache.end()) return it->second;
+            for (const auto& entry : s_cache) {
+                if (entry.first == volumePath) return entry.second;
+            }
         }
 
         // Create handle to the volume
@@ -88,7 +90,7 @@ struct SystemInfo {
 
         {
             std::scoped_lock guard(s_cacheMutex);
-            s_cache.emplace(cacheKey, isSSD);
+            s_cache.emplace_back(volumePath, isSSD);
         }
         return isSSD;
 #else
@@ -163,6 +165,7 @@ struct EngineConfig {
     int maxHeavyWorkers = 1;           // Heavy Lane worker cap
     size_t arenaPreallocSize = 256 * 1024 * 1024;  // PMR Arena size per worker
     size_t maxCacheMemory = 512 * 1024 * 1024;     // Prefetch cache limit
+    size_t maxColdCacheMemory = 256 * 1024 * 1024; // Compressed tier behind it
     int prefetchLookAhead = 3;         // Prefetch step count
     int idleTimeoutMs = 5000;          // Idle timeout before worker shutdown (ms)
     int minHotSpares = 1;              // Minimum hot-spare workers
@@ -185,6 +188,7 @@ struct EngineConfig {
             cfg.detectedTier = Tier::ULTRA;
             cfg.arenaPreallocSize = 512 * 1024 * 1024;   // 512MB per worker
             cfg.maxCacheMemory = 2ULL * 1024 * 1024 * 1024; // 2GB cache
+            cfg.maxColdCacheMemory = 1ULL * 1024 * 1024 * 1024; // 1GB compressed
             cfg.prefetchLookAhead = 10;
             cfg.minHotSpares = 2; // Keep 2 hot spares on high-end
         } 
@@ -193,6 +197,7 @@ struct EngineConfig {
             cfg.detectedTier = Tier::BALANCED;
             cfg.arenaPreallocSize = 256 * 1024 * 1024;   // 256MB per worker
             cfg.maxCacheMemory = 512 * 1024 * 1024;      // 512MB cache
+            cfg.maxColdCacheMemory = 256 * 1024 * 1024;  // 256MB compressed
             cfg.prefetchLookAhead = 3;
             cfg.minHotSpares = 1;
         } 
@@ -201,6 +206,7 @@ struct EngineConfig {
             cfg.detectedTier = Tier::ECO;
             cfg.arenaPreallocSize = 128 * 1024 * 1024;   // 128MB per worker
             cfg.maxCacheMemory = 128 * 1024 * 1024;      // 128MB cache
+            cfg.maxColdCacheMemory = 64 * 1024 * 1024;   // 64MB compressed
             cfg.prefetchLookAhead = 1;
             cfg.minHotSpares = 1;
         }
@@ -0,0 +1,435 @@
+#include "pch.h"
+#include "ThumbnailDiskCache.h"
+#include <ShlObj.h>
+#include <filesystem>
+#include <random>
+#include <cstring>
+#include <thread>
+#include <zlib.h>
+
+namespace {
+
+constexpr uint32_t kIndexMagic = 0x49545651;   // 'QVTI'
+constexpr uint32_t kPackMagic = 0x50545651;    // 'QVTP'
+constexpr uint32_t kRecordMagic = 0x52545651;  // 'QVTR'
+constexpr uint32_t kFormatVersion = 1;
+
+constexpr uint32_t kFlagBlurry = 1u << 0;
+
+// Live entries above this share of SLOT_COUNT trigger a reset (keeps probe chains short)
+constexpr uint32_t kMaxLoadPercent = 70;
+
+struct PackHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t packId;
+};
+
+struct RecordHeader {
+    uint32_t magic;
+    uint32_t payloadBytes;  // Deflated pixel bytes following the header
+    uint64_t imageId;
+    int32_t width;
+    int32_t height;
+    int32_t stride;
+    int32_t origWidth;
+    int32_t origHeight;
+    uint32_t flags;
+    uint64_t fileSize;      // Source file size (hover metadata)
+    uint32_t adler;         // Adler-32 of the payload
+    uint32_t reserved;
+};
+static_assert(sizeof(RecordHeader) == 56, "RecordHeader is part of the on-disk format");
+
+uint64_t NewPackId() {
+    std::random_device rd;
+    uint64_t id = ((uint64_t)rd() << 32) | rd();
+    return id ? id : 1;
+}
+
+// 0 marks an empty slot
+uint64_t SlotId(uint64_t imageId) { return imageId ? imageId : 1; }
+
+// Fibonacci hashing of the (already hashed) ImageID; probing is linear from here
+uint32_t HomeSlot(uint64_t slotId) {
+    return (uint32_t)((slotId * 0x9E3779B97F4A7C15ull) >> 48) & (ThumbnailDiskCache::SLOT_COUNT - 1);
+}
+
+bool WriteAt(HANDLE h, uint64_t offset, const void* data, size_t bytes) {
+    OVERLAPPED ov = {};
+    ov.Offset = (DWORD)offset;
+    ov.OffsetHigh = (DWORD)(offset >> 32);
+    DWORD written = 0;
+    return WriteFile(h, data, (DWORD)bytes, &written, &ov) && written == bytes;
+}
+
+bool ReadAt(HANDLE h, uint64_t offset, void* data, size_t bytes) {
+    OVERLAPPED ov = {};
+    ov.Offset = (DWORD)offset;
+    ov.OffsetHigh = (DWORD)(offset >> 32);
+    DWORD read = 0;
+    return ReadFile(h, data, (DWORD)bytes, &read, &ov) && read == bytes;
+}
+
+bool TruncateAt(HANDLE h, uint64_t size) {
+    LARGE_INTEGER pos;
+    pos.QuadPart = (LONGLONG)size;
+    return SetFilePointerEx(h, pos, nullptr, FILE_BEGIN) && SetEndOfFile(h);
+}
+
+} // namespace
+
+struct ThumbnailDiskCache::IndexHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t liveCount;
+    uint64_t packBytes;     // Committed end of the pack (anything past it is a torn append)
+    uint64_t packId;        // Must match PackHeader::packId
+};
+
+struct ThumbnailDiskCache::IndexSlot {
+    uint64_t imageId;       // 0 = empty
+    uint64_t mtime;
+    uint64_t fileSize;
+    uint64_t offset;        // Record offset in the pack
+    uint32_t targetSize;
+    uint32_t recordBytes;
+};
+
+static constexpr uint64_t IndexFileBytes() {
+    return 32 + (uint64_t)ThumbnailDiskCache::SLOT_COUNT * 40;
+}
+
+ThumbnailDiskCache::~ThumbnailDiskCache() {
+    Close();
+}
+
+std::wstring ThumbnailDiskCache::DefaultDirectory() {
+    PWSTR localAppData = nullptr;
+    std::wstring dir;
+    if (SUCCEEDED(SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr, &localAppData))) {
+        dir = std::wstring(localAppData) + L"\\QuickView\\ThumbCache";
+    }
+    CoTaskMemFree(localAppData);
+    return dir;
+}
+
+ThumbnailDiskCache::IndexHeader* ThumbnailDiskCache::Header() const {
+    return reinterpret_cast<IndexHeader*>(m_indexView);
+}
+
+ThumbnailDiskCache::IndexSlot* ThumbnailDiskCache::Slots() const {
+    return reinterpret_cast<IndexSlot*>(m_indexView + sizeof(IndexHeader));
+}
+
+bool ThumbnailDiskCache::Open(const std::wstring& directory) {
+    static_assert(sizeof(IndexHeader) == 32 && sizeof(IndexSlot) == 40, "Index layout is part of the on-disk format");
+
+    std::lock_guard lock(m_mutex);
+    CloseLocked();
+    if (directory.empty()) return false;
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    m_indexPath = directory + L"\\thumbs.idx";
+    m_packPath = directory + L"\\thumbs.pack";
+
+    // Unreadable or foreign files: start over once
+    if (!OpenFilesLocked(false)) {
+        CloseLocked();
+        if (!OpenFilesLocked(true)) {
+            CloseLocked();
+            return false;
+        }
+    }
+    m_probeView.store(m_indexView);
+    return true;
+}
+
+bool ThumbnailDiskCache::OpenFilesLocked(bool recreate) {
+    const DWORD disposition = recreate ? CREATE_ALWAYS : OPEN_ALWAYS;
+    m_hIndex = CreateFileW(m_indexPath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                           disposition, FILE_ATTRIBUTE_NORMAL, nullptr);
+    m_hPack = CreateFileW(m_packPath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                          disposition, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_hIndex == INVALID_HANDLE_VALUE || m_hPack == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER indexSize = {};
+    LARGE_INTEGER packSize = {};
+    if (!GetFileSizeEx(m_hIndex, &indexSize) || !GetFileSizeEx(m_hPack, &packSize)) return false;
+    const bool sizedRight = (uint64_t)indexSize.QuadPart == IndexFileBytes();
+
+    // Mapping a larger size than the file extends it (zero-filled)
+    const uint64_t bytes = IndexFileBytes();
+    m_hIndexMap = CreateFileMappingW(m_hIndex, nullptr, PAGE_READWRITE, (DWORD)(bytes >> 32), (DWORD)bytes, nullptr);
+    if (!m_hIndexMap) return false;
+    m_indexView = static_cast<uint8_t*>(MapViewOfFile(m_hIndexMap, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)bytes));
+    if (!m_indexView) return false;
+
+    PackHeader pack = {};
+    const IndexHeader* h = Header();
+    const bool valid = sizedRight &&
+        h->magic == kIndexMagic && h->version == kFormatVersion && h->slotCount == SLOT_COUNT &&
+        h->packBytes >= sizeof(PackHeader) && h->packBytes <= (uint64_t)packSize.QuadPart &&
+        ReadAt(m_hPack, 0, &pack, sizeof(pack)) &&
+        pack.magic == kPackMagic && pack.version == kFormatVersion && pack.packId == h->packId;
+
+    if (!valid) return ResetLocked();
+
+    // Drop a torn tail from an append that never reached the index
+    if ((uint64_t)packSize.QuadPart > h->packBytes) {
+        TruncateAt(m_hPack, h->packBytes);
+    }
+    return true;
+}
+
+void ThumbnailDiskCache::UnmapPackLocked() {
+    if (m_packView) UnmapViewOfFile(m_packView);
+    if (m_hPackMap) CloseHandle(m_hPackMap);
+    m_packView = nullptr;
+    m_hPackMap = nullptr;
+    m_packMappedBytes = 0;
+}
+
+bool ThumbnailDiskCache::ResetLocked() {
+    UnmapPackLocked();
+
+    PackHeader pack = { kPackMagic, kFormatVersion, NewPackId() };
+    if (!TruncateAt(m_hPack, 0) || !WriteAt(m_hPack, 0, &pack, sizeof(pack))) return false;
+
+    std::memset(m_indexView, 0, (size_t)IndexFileBytes());
+    IndexHeader* h = Header();
+    h->magic = kIndexMagic;
+    h->version = kFormatVersion;
+    h->slotCount = SLOT_COUNT;
+    h->liveCount = 0;
+    h->packBytes = sizeof(PackHeader);
+    h->packId = pack.packId;
+    return true;
+}
+
+void ThumbnailDiskCache::Close() {
+    std::lock_guard lock(m_mutex);
+    CloseLocked();
+}
+
+void ThumbnailDiskCache::CloseLocked() {
+    UnmapPackLocked();
+    // Unpublish, then wait out any Contains still reading the view
+    m_probeView.store(nullptr);
+    while (m_probeReaders.load() != 0) std::this_thread::yield();
+    if (m_indexView) {
+        FlushViewOfFile(m_indexView, 0);
+        UnmapViewOfFile(m_indexView);
+        m_indexView = nullptr;
+    }
+    if (m_hIndexMap) {
+        CloseHandle(m_hIndexMap);
+        m_hIndexMap = nullptr;
+    }
+    if (m_hIndex != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_hIndex);
+        m_hIndex = INVALID_HANDLE_VALUE;
+    }
+    if (m_hPack != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_hPack);
+        m_hPack = INVALID_HANDLE_VALUE;
+    }
+}
+
+bool ThumbnailDiskCache::IsOpen() const {
+    std::lock_guard lock(m_mutex);
+    return m_indexView != nullptr;
+}
+
+ThumbnailDiskCache::IndexSlot* ThumbnailDiskCache::FindSlotLocked(uint64_t imageId, uint32_t targetSize, bool forInsert) const {
+    const uint64_t id = SlotId(imageId);
+    IndexSlot* slots = Slots();
+    uint32_t i = HomeSlot(id);
+    for (uint32_t probe = 0; probe < SLOT_COUNT; ++probe, i = (i + 1) & (SLOT_COUNT - 1)) {
+        IndexSlot& s = slots[i];
+        if (s.imageId == 0) return forInsert ? &s : nullptr;
+        if (s.imageId == id && s.targetSize == targetSize) return &s;
+    }
+    return nullptr;
+}
+
+bool ThumbnailDiskCache::EnsurePackViewLocked(uint64_t endOffset) {
+    if (endOffset <= m_packMappedBytes) return true;
+
+    // The pack grew since it was mapped: remap the whole committed range
+    UnmapPackLocked();
+    const uint64_t bytes = Header()->packBytes;
+    if (endOffset > bytes) return false;
+    m_hPackMap = CreateFileMappingW(m_hPack, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_hPackMap) return false;
+    m_packView = static_cast<const uint8_t*>(MapViewOfFile(m_hPackMap, FILE_MAP_READ, 0, 0, (SIZE_T)bytes));
+    if (!m_packView) {
+        UnmapPackLocked();
+        return false;
+    }
+    m_packMappedBytes = bytes;
+    return true;
+}
+
+bool ThumbnailDiskCache::Contains(uint64_t imageId, uint32_t targetSize) const {
+    // Put writes the key fields with imageId last (release), so a matching id has
+    // its targetSize in place
+    m_probeReaders.fetch_add(1);
+    bool found = false;
+    if (uint8_t* view = m_probeView.load()) {
+        auto* slots = reinterpret_cast<IndexSlot*>(view + sizeof(IndexHeader));
+        const uint64_t id = SlotId(imageId);
+        uint32_t i = HomeSlot(id);
+        for (uint32_t probe = 0; probe < SLOT_COUNT; ++probe, i = (i + 1) & (SLOT_COUNT - 1)) {
+            const uint64_t slotId = std::atomic_ref<uint64_t>(slots[i].imageId).load(std::memory_order_acquire);
+            if (slotId == 0) break;
+            if (slotId == id && std::atomic_ref<uint32_t>(slots[i].targetSize).load(std::memory_order_relaxed) == targetSize) {
+                found = true;
+                break;
+            }
+        }
+    }
+    m_probeReaders.fetch_sub(1);
+    return found;
+}
+
+bool ThumbnailDiskCache::Get(const Key& key, CImageLoader::ThumbData* out) {
+    if (!out) return false;
+
+    // Under the lock only the slot lookup and a copy of the deflated record: the pack
+    // view is remapped whenever it grows
+    RecordHeader rec;
+    std::vector<uint8_t> payload;
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_indexView) return false;
+
+        const IndexSlot* slot = FindSlotLocked(key.imageId, key.targetSize, false);
+        if (!slot || slot->mtime != key.mtime || slot->fileSize != key.fileSize ||
+            slot->recordBytes < sizeof(RecordHeader) ||
+            !EnsurePackViewLocked(slot->offset + slot->recordBytes)) {
+            m_misses++;
+            return false;
+        }
+
+        std::memcpy(&rec, m_packView + slot->offset, sizeof(rec));
+        if (rec.magic != kRecordMagic || sizeof(rec) + rec.payloadBytes != slot->recordBytes) {
+            m_misses++;
+            return false;
+        }
+        const uint8_t* src = m_packView + slot->offset + sizeof(rec);
+        payload.assign(src, src + rec.payloadBytes);
+    }
+
+    // Checksum and inflate outside it, so Put and Open never queue behind them
+    const uint64_t rawBytes = (uint64_t)rec.stride * (uint32_t)rec.height;
+    if (rec.imageId != SlotId(key.imageId) ||
+        rec.width <= 0 || rec.height <= 0 || rec.stride < rec.width * 4 || rawBytes > (64ull << 20) ||
+        adler32(adler32(0L, Z_NULL, 0), payload.data(), rec.payloadBytes) != rec.adler) {
+        m_misses++;
+        return false;
+    }
+
+    out->pixels.resize((size_t)rawBytes);
+    uLongf destLen = (uLongf)rawBytes;
+    if (uncompress(out->pixels.data(), &destLen, payload.data(), rec.payloadBytes) != Z_OK || destLen != rawBytes) {
+        out->pixels.clear();
+        m_misses++;
+        return false;
+    }
+
+    out->width = rec.width;
+    out->height = rec.height;
+    out->stride = rec.stride;
+    out->origWidth = rec.origWidth;
+    out->origHeight = rec.origHeight;
+    out->fileSize = rec.fileSize;
+    out->isBlurry = (rec.flags & kFlagBlurry) != 0;
+    out->isFailed = false;
+    out->isValid = true;
+    out->loaderName = L"Thumb Cache (L3)";
+    m_hits++;
+    return true;
+}
+
+bool ThumbnailDiskCache::Put(const Key& key, const CImageLoader::ThumbData& data) {
+    if (!data.isValid || data.isFailed || data.width <= 0 || data.height <= 0 ||
+        data.stride < data.width * 4 || data.pixels.size() < (size_t)data.stride * data.height) {
+        return false;
+    }
+
+    // Compress outside the lock (fast level: thumbnails are re-read far more often than written)
+    const uLong rawBytes = (uLong)((size_t)data.stride * data.height);
+    std::vector<uint8_t> record(sizeof(RecordHeader) + compressBound(rawBytes));
+    uLongf packed = (uLongf)(record.size() - sizeof(RecordHeader));
+    if (compress2(record.data() + sizeof(RecordHeader), &packed, data.pixels.data(), rawBytes, 1) != Z_OK) {
+        return false;
+    }
+    record.resize(sizeof(RecordHeader) + packed);
+
+    RecordHeader rec = {};
+    rec.magic = kRecordMagic;
+    rec.payloadBytes = (uint32_t)packed;
+    rec.imageId = SlotId(key.imageId);
+    rec.width = data.width;
+    rec.height = data.height;
+    rec.stride = data.stride;
+    rec.origWidth = data.origWidth;
+    rec.origHeight = data.origHeight;
+    rec.flags = data.isBlurry ? kFlagBlurry : 0;
+    rec.fileSize = data.fileSize;
+    rec.adler = (uint32_t)adler32(adler32(0L, Z_NULL, 0), record.data() + sizeof(RecordHeader), (uInt)packed);
+    std::memcpy(record.data(), &rec, sizeof(rec));
+
+    std::lock_guard lock(m_mutex);
+    if (!m_indexView) return false;
+
+    IndexHeader* h = Header();
+    IndexSlot* slot = FindSlotLocked(key.imageId, key.targetSize, true);
+    const bool isNew = slot && slot->imageId == 0;
+    if (!slot || (isNew && (h->liveCount + 1) * 100ull > (uint64_t)SLOT_COUNT * kMaxLoadPercent) ||
+        h->packBytes + record.size() > MAX_PACK_BYTES) {
+        // Full: start a new generation rather than compacting
+        if (!ResetLocked()) return false;
+        h = Header();
+        slot = FindSlotLocked(key.imageId, key.targetSize, true);
+        if (!slot) return false;
+    }
+
+    // Payload first, then the slot and the committed end: a crash in between leaves
+    // only an unreferenced tail that the next Open truncates.
+    const uint64_t offset = h->packBytes;
+    if (!WriteAt(m_hPack, offset, record.data(), record.size())) return false;
+
+    if (slot->imageId == 0) h->liveCount++;
+    slot->mtime = key.mtime;
+    slot->fileSize = key.fileSize;
+    slot->offset = offset;
+    std::atomic_ref<uint32_t>(slot->targetSize).store(key.targetSize, std::memory_order_relaxed);
+    slot->recordBytes = (uint32_t)record.size();
+    std::atomic_ref<uint64_t>(slot->imageId).store(SlotId(key.imageId), std::memory_order_release); // Contains reads it lock-free
+    h->packBytes = offset + record.size();
+    m_writes++;
+    return true;
+}
+
+void ThumbnailDiskCache::Clear() {
+    std::lock_guard lock(m_mutex);
+    if (m_indexView) ResetLocked();
+}
+
+ThumbnailDiskCache::Stats ThumbnailDiskCache::GetStats() const {
+    std::lock_guard lock(m_mutex);
+    Stats stats;
+    if (m_indexView) {
+        stats.entries = Header()->liveCount;
+        stats.slots = SLOT_COUNT;
+        stats.packBytes = Header()->packBytes;
+    }
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    stats.writes = m_writes;
+    return stats;
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include "pch.h"
+#include "ImageLoader.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+
+// ============================================================================
+// L3 Thumbnail Cache (persistent, shared across launches)
+// ============================================================================
+// Two files in the cache directory:
+//   thumbs.idx  - fixed-size open-addressing table, memory-mapped read/write.
+//                 Opening it is a single MapViewOfFile: no scan, no parse.
+//   thumbs.pack - append-only records (header + deflated BGRA), read through a
+//                 read-only mapping that is extended when the file grows.
+// A slot is keyed by (ImageID, target size) and validated by the source file's
+// mtime and size; a changed file simply misses and its slot is overwritten.
+// When the table or pack reaches its cap the whole store is reset.
+class ThumbnailDiskCache {
+public:
+    struct Key {
+        uint64_t imageId = 0;
+        uint64_t mtime = 0;     // FILETIME of the source (or its archive)
+        uint64_t fileSize = 0;
+        uint32_t targetSize = 0;
+    };
+
+    struct Stats {
+        uint32_t entries = 0;
+        uint32_t slots = 0;
+        uint64_t packBytes = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t writes = 0;
+    };
+
+    ThumbnailDiskCache() = default;
+    ~ThumbnailDiskCache();
+    ThumbnailDiskCache(const ThumbnailDiskCache&) = delete;
+    ThumbnailDiskCache& operator=(const ThumbnailDiskCache&) = delete;
+
+    // Opens (or creates) the store in `directory`. A missing, foreign or mismatched
+    // index/pack pair is reset rather than repaired.
+    bool Open(const std::wstring& directory);
+    void Close();
+    bool IsOpen() const;
+
+    // %LOCALAPPDATA%\QuickView\ThumbCache
+    static std::wstring DefaultDirectory();
+
+    bool Get(const Key& key, CImageLoader::ThumbData* out);
+    bool Put(const Key& key, const CImageLoader::ThumbData& data);
+
+    // Index-only probe (ignores mtime) for queue routing on the UI thread. Lock-free:
+    // never waits behind a Put's pack write; a slot rewritten meanwhile may answer either way.
+    bool Contains(uint64_t imageId, uint32_t targetSize) const;
+
+    void Clear();
+    Stats GetStats() const;
+
+    static constexpr uint32_t SLOT_COUNT = 1u << 16;            // ~45k live entries at 70% load
+    static constexpr uint64_t MAX_PACK_BYTES = 1024ull << 20;   // 1 GB
+
+private:
+    struct IndexHeader;
+    struct IndexSlot;
+
+    mutable std::mutex m_mutex;
+    std::wstring m_indexPath;
+    std::wstring m_packPath;
+
+    HANDLE m_hIndex = INVALID_HANDLE_VALUE;
+    HANDLE m_hIndexMap = nullptr;
+    uint8_t* m_indexView = nullptr;
+
+    HANDLE m_hPack = INVALID_HANDLE_VALUE;
+    HANDLE m_hPackMap = nullptr;
+    const uint8_t* m_packView = nullptr;
+    uint64_t m_packMappedBytes = 0;
+
+    // Contains' view of the index: published after Open, cleared (and drained of
+    // readers) before the index is unmapped
+    std::atomic<uint8_t*> m_probeView = nullptr;
+    mutable std::atomic<uint32_t> m_probeReaders = 0;
+
+    std::atomic<uint64_t> m_hits = 0;
+    std::atomic<uint64_t> m_misses = 0;
+    std::atomic<uint64_t> m_writes = 0;
+
+    IndexHeader* Header() const;
+    IndexSlot* Slots() const;
+    IndexSlot* FindSlotLocked(uint64_t imageId, uint32_t targetSize, bool forInsert) const;
+
+    bool OpenFilesLocked(bool recreate);
+    void CloseLocked();
+    bool ResetLocked();
+    void UnmapPackLocked();
+    bool EnsurePackViewLocked(uint64_t endOffset);
+};
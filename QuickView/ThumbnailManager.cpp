@@ -14,18 +14,20 @@ ThumbnailManager::~ThumbnailManager() {
 void ThumbnailManager::Initialize(HWND hwnd, CImageLoader* pLoader) {
     m_hwnd = hwnd;
     m_pLoader = pLoader;
-    m_running = true;
-    m_workerThreadFast = std::thread(&ThumbnailManager::WorkerLoopFast, this);
-    m_workerThreadSlow = std::thread(&ThumbnailManager::WorkerLoopSlow, this);
+    m_diskCache.Open(ThumbnailDiskCache::DefaultDirectory()); // O(1): maps the index, no scan
+
+    // Thumbnail extraction (especially via WIC/Shell) relies on COM components
+    static thread_local HRESULT t_coInitHr = E_FAIL;
+    m_scheduler.Start(QuickView::ThumbnailScheduler::DefaultWorkerCount(),
+        [this](Task& task) { ProcessTask(task); },
+        [] { t_coInitHr = CoInitializeEx(nullptr, COINIT_MULTITHREADED); },
+        [] { if (SUCCEEDED(t_coInitHr)) CoUninitialize(); });
 }
 
 void ThumbnailManager::Shutdown() {
-    m_running = false;
-    m_cvFast.notify_all();
-    m_cvSlow.notify_all();
-    if (m_workerThreadFast.joinable()) m_workerThreadFast.join();
-    if (m_workerThreadSlow.joinable()) m_workerThreadSlow.join();
+    m_scheduler.Stop();
     ClearCache();
+    m_diskCache.Close();
 }
 
 void ThumbnailManager::ClearCache() {
@@ -40,10 +42,7 @@ void ThumbnailManager::ClearCache() {
     std::lock_guard<std::mutex> queueLock(m_queueMutex);
     m_currentGeneration++; // Invalidate pending work
     m_pendingTasks.clear();
-    m_fastQueue = std::priority_queue<Task, std::vector<Task>, std::greater<Task>>();
-    m_slowQueue = std::priority_queue<Task, std::vector<Task>, std::greater<Task>>();
-
-    m_slowQueue = std::priority_queue<Task, std::vector<Task>, std::greater<Task>>();
+    m_scheduler.Clear();
 }
 
 ComPtr<ID2D1Bitmap> ThumbnailManager::GetThumbnail(size_t imageId, LPCWSTR /*filePath*/, ID2D1RenderTarget* pRT) {
@@ -147,123 +146,70 @@ void ThumbnailManager::TouchLRU(size_t imageId) {
     }
 }
 
-void ThumbnailManager::WorkerLoopFast() {
-    // Thumbnail extraction (especially via WIC/Shell) relies on COM components
-    HRESULT coInitHr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
-    
-    while (m_running) {
-        Task task;
-        {
-            std::unique_lock<std::mutex> lock(m_queueMutex);
-            m_cvFast.wait(lock, [this] { return !m_fastQueue.empty() || !m_running; });
-            
-            if (!m_running) break;
-            
-            // Double check empty in case of spurious wake or stolen task (unlikely with one consumer per queue, but safe)
-            if (m_fastQueue.empty()) continue;
-
-            task = m_fastQueue.top();
-            m_fastQueue.pop();
-            
-        }
-        
-        // [Fix] Check if task is still valid for current view state
-        if (task.generation != m_currentGeneration) {
-            std::lock_guard<std::mutex> lock(m_queueMutex);
-            m_pendingTasks.erase(task.imageId);
-            continue;
-        }
+void ThumbnailManager::ProcessTask(const Task& task) {
+    // [Fix] Check if task is still valid for current view state
+    if (task.generation != m_currentGeneration) {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_pendingTasks.erase(task.imageId);
+        return;
+    }
 
-        int targetSize = 300; 
-        CImageLoader::ThumbData data;
-        HRESULT hr = m_pLoader->LoadThumbnail(task.path.c_str(), targetSize, &data);
-        if (FAILED(hr) || !data.isValid) {
-            data.isValid = true; 
-            data.isFailed = true;
-            data.width = 1; data.height = 1; data.stride = 4;
-            data.pixels = { 0x80, 0x80, 0x80, 0xFF }; 
-            data.loaderName = L"Failure Placeholder";
-        }
-        if (data.isValid) {
-            // Re-check generation after potentially long extraction
-            if (task.generation == m_currentGeneration) {
-                {
-                    std::lock_guard<std::mutex> lock(m_cacheMutex);
-                    size_t size = data.pixels.size();
-                    m_l1Cache[task.imageId] = std::move(data);
-                    AddToLRU(task.imageId, size);
-                }
-                PostMessage(m_hwnd, WM_THUMB_KEY_READY, (WPARAM)task.imageId, 0);
+    CImageLoader::ThumbData data;
+    HRESULT hr = LoadThumbnailCached(task, &data);
+    if (FAILED(hr) || !data.isValid) {
+        data.isValid = true; 
+        data.isFailed = true;
+        data.width = 1; data.height = 1; data.stride = 4;
+        data.pixels = { 0x80, 0x80, 0x80, 0xFF }; 
+        data.loaderName = task.isFastLane ? L"Failure Placeholder" : L"Failure Placeholder (Archive)";
+    }
+    if (data.isValid) {
+        // Re-check generation after potentially long extraction
+        if (task.generation == m_currentGeneration) {
+            {
+                std::lock_guard<std::mutex> lock(m_cacheMutex);
+                size_t size = data.pixels.size();
+                m_l1Cache[task.imageId] = std::move(data);
+                AddToLRU(task.imageId, size);
             }
-        }
-        {
-            std::lock_guard<std::mutex> lock(m_queueMutex);
-            m_pendingTasks.erase(task.imageId);
+            PostMessage(m_hwnd, WM_THUMB_KEY_READY, (WPARAM)task.imageId, 0);
         }
     }
-    
-    if (SUCCEEDED(coInitHr)) {
-        CoUninitialize();
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_pendingTasks.erase(task.imageId);
     }
 }
 
-void ThumbnailManager::WorkerLoopSlow() {
-    // Thumbnail extraction (especially via WIC/Shell) relies on COM components
-    HRESULT coInitHr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
-    
-    while (m_running) {
-        Task task;
-        {
-            std::unique_lock<std::mutex> lock(m_queueMutex);
-            m_cvSlow.wait(lock, [this] { return !m_slowQueue.empty() || !m_running; });
-            
-            if (!m_running) break;
-            
-            if (m_slowQueue.empty()) continue;
-
-            task = m_slowQueue.top();
-            m_slowQueue.pop();
-            
-        }
-        
-        // [Fix] Check if task is still valid for current view state
-        if (task.generation != m_currentGeneration) {
-            std::lock_guard<std::mutex> lock(m_queueMutex);
-            m_pendingTasks.erase(task.imageId);
-            continue;
-        }
+bool ThumbnailManager::MakeDiskKey(size_t imageId, const std::wstring& path, ThumbnailDiskCache::Key* key) {
+    // Archive members are validated against the archive file itself
+    std::wstring archivePath;
+    size_t archiveIndex = 0;
+    const std::wstring& statPath = FileNavigator::ParseVirtualPath(path, archivePath, archiveIndex) ? archivePath : path;
 
-        int targetSize = 300; 
-        CImageLoader::ThumbData data;
-        HRESULT hr = m_pLoader->LoadThumbnail(task.path.c_str(), targetSize, &data, true);
-        if (FAILED(hr) || !data.isValid) {
-            data.isValid = true; 
-            data.isFailed = true;
-            data.width = 1; data.height = 1; data.stride = 4;
-            data.pixels = { 0x80, 0x80, 0x80, 0xFF }; 
-            data.loaderName = L"Failure Placeholder (Archive)";
-        }
-        if (data.isValid) {
-            // Re-check generation after potentially long extraction
-            if (task.generation == m_currentGeneration) {
-                {
-                    std::lock_guard<std::mutex> lock(m_cacheMutex);
-                    size_t size = data.pixels.size();
-                    m_l1Cache[task.imageId] = std::move(data);
-                    AddToLRU(task.imageId, size);
-                }
-                PostMessage(m_hwnd, WM_THUMB_KEY_READY, (WPARAM)task.imageId, 0);
-            }
-        }
-        {
-            std::lock_guard<std::mutex> lock(m_queueMutex);
-            m_pendingTasks.erase(task.imageId);
-        }
+    WIN32_FILE_ATTRIBUTE_DATA attrs;
+    if (!GetFileAttributesExW(statPath.c_str(), GetFileExInfoStandard, &attrs)) return false;
+
+    key->imageId = imageId;
+    key->mtime = ((uint64_t)attrs.ftLastWriteTime.dwHighDateTime << 32) | attrs.ftLastWriteTime.dwLowDateTime;
+    key->fileSize = ((uint64_t)attrs.nFileSizeHigh << 32) | attrs.nFileSizeLow;
+    key->targetSize = THUMB_TARGET_SIZE;
+    return true;
+}
+
+HRESULT ThumbnailManager::LoadThumbnailCached(const Task& task, CImageLoader::ThumbData* data) {
+    ThumbnailDiskCache::Key key;
+    const bool haveKey = MakeDiskKey(task.imageId, task.path, &key);
+    if (haveKey && m_diskCache.Get(key, data)) {
+        return S_OK;
     }
-    
-    if (SUCCEEDED(coInitHr)) {
-        CoUninitialize();
+
+    HRESULT hr = m_pLoader->LoadThumbnail(task.path.c_str(), THUMB_TARGET_SIZE, data);
+    // Failures are not persisted: a missing codec or locked file may succeed next time
+    if (SUCCEEDED(hr) && haveKey && data->isValid && !data->isFailed) {
+        m_diskCache.Put(key, *data);
     }
+    return hr;
 }
 
 // Added to match planned API changes
@@ -306,27 +252,17 @@ void ThumbnailManager::QueueRequest(size_t imageId, LPCWSTR path, int priority)
         QuickView::ExtEqualsIgnoreCase(e, L".avif") ||
         QuickView::ExtEqualsIgnoreCase(e, L".psd") || QuickView::ExtEqualsIgnoreCase(e, L".psb") ||
         QuickView::ExtEqualsIgnoreCase(e, L".webp");
-    t.isFastLane = isFast;
-
-    if (isFast) {
-        m_fastQueue.push(t);
-        m_cvFast.notify_one();
-    } else {
-        m_slowQueue.push(t);
-        m_cvSlow.notify_one();
-    }
-    
+    // L3 hits are a read + inflate: never park them behind a slow decode
+    t.isFastLane = isFast || m_diskCache.Contains(imageId, THUMB_TARGET_SIZE);
+
     m_pendingTasks[imageId] = true;
+    m_scheduler.Push(std::move(t));
 }
 
 void ThumbnailManager::ClearQueue() {
     std::lock_guard<std::mutex> lock(m_queueMutex);
     m_currentGeneration++; // [Fix] Increment generation to invalidate pending background extractions
-    m_fastQueue = std::priority_queue<Task, std::vector<Task>, std::greater<Task>>();
-    m_slowQueue = std::priority_queue<Task, std::vector<Task>, std::greater<Task>>();
-    m_pendingTasks.clear();
-
-    m_slowQueue = std::priority_queue<Task, std::vector<Task>, std::greater<Task>>();
+    m_scheduler.Clear();
     m_pendingTasks.clear();
 }
 
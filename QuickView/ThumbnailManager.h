@@ -1,12 +1,11 @@
 #pragma once
 #include "pch.h"
 #include "ImageLoader.h"
+#include "ThumbnailDiskCache.h"
+#include "ThumbnailScheduler.h"
 #include <unordered_map>
 #include <list>
 #include <mutex>
-#include <thread>
-#include <condition_variable>
-#include <queue>
 #include <atomic>
 
 #define WM_THUMB_KEY_READY (WM_USER + 101)
@@ -85,46 +84,22 @@ private:
     
     // Constants moved below for organizational clarity
 
-    // --- Worker Thread ---
-    // --- Worker Threads ---
-    struct Task {
-        size_t imageId;
-        std::wstring path;
-        int priorityDistance; // 0 = highest (center)
-        bool isFastLane;      // Tag to verify lane if needed
-        uint64_t generation;   // [Fix] Track when this task was created
-
-        // [New] Archive-aware sorting
-        bool isArchive = false;
-        int archiveIndex = -1;
-        size_t archivePathHash = 0;
-        
-        bool operator>(const Task& other) const {
-            // Same archive: force sequential index order to maintain Solid VFS state
-            if (isArchive && other.isArchive && archivePathHash == other.archivePathHash) {
-                return archiveIndex > other.archiveIndex;
-            }
-            // Different archives or mixed: respect distance to screen center
-            return priorityDistance > other.priorityDistance; // Min-heap
-        }
-    };
+    // --- Worker Pool ---
+    // Work-stealing pool sized to the machine (was one fast + one slow thread)
+    using Task = QuickView::ThumbTask;
+    QuickView::ThumbnailScheduler m_scheduler;
 
-    std::thread m_workerThreadFast;
-    std::thread m_workerThreadSlow;
-    
-    std::mutex m_queueMutex; // Protects BOTH queues and pending map
-    std::condition_variable m_cvFast;
-    std::condition_variable m_cvSlow;
-    
-    std::priority_queue<Task, std::vector<Task>, std::greater<Task>> m_fastQueue;
-    std::priority_queue<Task, std::vector<Task>, std::greater<Task>> m_slowQueue;
-    
+    std::mutex m_queueMutex; // Protects pending map (and orders ClearQueue vs QueueRequest)
     std::unordered_map<size_t, bool> m_pendingTasks; 
-    std::atomic<bool> m_running = false;
     std::atomic<uint64_t> m_currentGeneration{ 0 };
 
-    void WorkerLoopFast();
-    void WorkerLoopSlow();
+    void ProcessTask(const Task& task);
+
+    // --- L3 Cache (disk) ---
+    // Survives relaunches; checked by the workers before decoding, filled after.
+    ThumbnailDiskCache m_diskCache;
+    HRESULT LoadThumbnailCached(const Task& task, CImageLoader::ThumbData* data);
+    static bool MakeDiskKey(size_t imageId, const std::wstring& path, ThumbnailDiskCache::Key* key);
     
     void EvictLRU();
     void AddToLRU(size_t imageId, size_t size);
@@ -132,4 +107,5 @@ private:
 
     const size_t MAX_CACHE_SIZE = 512 * 1024 * 1024; // [v6.0.6] Increased to 512MB for 4K/8K assets
     const size_t MAX_CACHE_COUNT = 2000;
+    static constexpr int THUMB_TARGET_SIZE = 300;
 };
@@ -0,0 +1,264 @@
+#pragma once
+#include "pch.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace QuickView {
+
+    // One gallery thumbnail request (built by ThumbnailManager::QueueRequest)
+    struct ThumbTask {
+        size_t imageId = 0;
+        std::wstring path;
+        int priorityDistance = 0; // 0 = highest (center)
+        bool isFastLane = false;  // Embedded preview / cheap decode
+        uint64_t generation = 0;  // [Fix] Track when this task was created
+
+        // [New] Archive-aware sorting
+        bool isArchive = false;
+        int archiveIndex = -1;
+        size_t archivePathHash = 0;
+
+        bool operator>(const ThumbTask& other) const {
+            // Same archive: force sequential index order to maintain Solid VFS state
+            if (isArchive && other.isArchive && archivePathHash == other.archivePathHash) {
+                return archiveIndex > other.archiveIndex;
+            }
+            // Different archives or mixed: respect distance to screen center
+            return priorityDistance > other.priorityDistance; // Min-heap
+        }
+    };
+
+    // ============================================================================
+    // Work-stealing thumbnail pool
+    // ============================================================================
+    // Replaces the fixed fast/slow thread pair. Every worker owns its queues (one lock
+    // per worker, so producers and consumers rarely meet) and steals from its peers
+    // when they run dry. Queues stay priority heaps rather than LIFO deques: center-
+    // first order is what the gallery sees, so owners and thieves both take the best
+    // task.
+    //  - Fast lane before slow lane, and slow decodes are capped at workers - 1 so a
+    //    burst of PNG/TIFF decodes never starves embedded-preview thumbnails.
+    //  - Archive members are pinned to one worker chosen by archive hash and are never
+    //    stolen: a solid archive is walked by a single thread in archiveIndex order.
+    //  - Generations are the caller's business; Clear() only drops queued tasks.
+    class ThumbnailScheduler {
+    public:
+        using Handler = std::function<void(ThumbTask& task)>;
+        using ThreadHook = std::function<void()>;
+
+        struct Stats {
+            uint64_t executed = 0;
+            uint64_t stolen = 0;
+        };
+
+        ThumbnailScheduler() = default;
+        ~ThumbnailScheduler() { Stop(); }
+        ThumbnailScheduler(const ThumbnailScheduler&) = delete;
+        ThumbnailScheduler& operator=(const ThumbnailScheduler&) = delete;
+
+        // Logical cores minus the UI thread; never below the old fast/slow pair
+        static int DefaultWorkerCount() {
+            const int cores = (int)std::thread::hardware_concurrency();
+            return (std::clamp)(cores - 1, 2, 16);
+        }
+
+        // onThreadStart / onThreadExit run on each worker (COM apartment setup)
+        void Start(int workerCount, Handler handler, ThreadHook onThreadStart = {}, ThreadHook onThreadExit = {}) {
+            Stop();
+            workerCount = (std::max)(1, workerCount);
+            m_handler = std::move(handler);
+            m_onThreadStart = std::move(onThreadStart);
+            m_onThreadExit = std::move(onThreadExit);
+            m_slowLimit = workerCount > 1 ? workerCount - 1 : 1;
+            m_running = true;
+
+            m_workers.clear();
+            for (int i = 0; i < workerCount; ++i) {
+                m_workers.push_back(std::make_unique<Worker>());
+            }
+            for (int i = 0; i < workerCount; ++i) {
+                m_workers[i]->thread = std::thread(&ThumbnailScheduler::Run, this, i);
+            }
+        }
+
+        // Joins the workers; queued tasks are dropped, a running task completes first
+        void Stop() {
+            if (m_workers.empty()) return;
+            m_running = false;
+            Signal(true);
+            for (auto& w : m_workers) {
+                if (w->thread.joinable()) w->thread.join();
+            }
+            m_workers.clear();
+            m_queued = 0;
+            m_slowActive = 0;
+        }
+
+        void Push(ThumbTask task) {
+            const int n = (int)m_workers.size();
+            if (n == 0) return;
+
+            const bool pinned = task.isArchive;
+            const int home = pinned ? (int)(task.archivePathHash % (size_t)n)
+                                    : (int)(m_nextWorker.fetch_add(1, std::memory_order_relaxed) % (uint32_t)n);
+            {
+                Worker& w = *m_workers[home];
+                std::lock_guard<std::mutex> lock(w.mutex);
+                Heap& heap = pinned ? w.pinned : (task.isFastLane ? w.fast : w.slow);
+                heap.push_back(std::move(task));
+                std::push_heap(heap.begin(), heap.end(), std::greater<ThumbTask>());
+                m_queued.fetch_add(1, std::memory_order_relaxed);
+            }
+            // Pinned work can only run on its home worker: make sure that one wakes up
+            Signal(pinned);
+        }
+
+        // Drops every queued (not yet running) task. Returns how many were dropped.
+        size_t Clear() {
+            size_t dropped = 0;
+            for (auto& w : m_workers) {
+                std::lock_guard<std::mutex> lock(w->mutex);
+                const size_t n = w->fast.size() + w->slow.size() + w->pinned.size();
+                w->fast.clear();
+                w->slow.clear();
+                w->pinned.clear();
+                m_queued.fetch_sub(n, std::memory_order_relaxed);
+                dropped += n;
+            }
+            return dropped;
+        }
+
+        int WorkerCount() const { return (int)m_workers.size(); }
+        size_t QueuedCount() const { return m_queued.load(std::memory_order_relaxed); }
+
+        Stats GetStats() const {
+            return { m_executed.load(std::memory_order_relaxed), m_stolen.load(std::memory_order_relaxed) };
+        }
+
+    private:
+        using Heap = std::vector<ThumbTask>; // std::greater heap: front() is the next task
+
+        struct Worker {
+            std::mutex mutex;
+            Heap fast;
+            Heap slow;
+            Heap pinned; // Archive members: owner only
+            std::thread thread;
+        };
+
+        static ThumbTask PopTop(Heap& heap) {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<ThumbTask>());
+            ThumbTask task = std::move(heap.back());
+            heap.pop_back();
+            return task;
+        }
+
+        bool TryPop(int index, Heap Worker::* lane, ThumbTask* out) {
+            Worker& w = *m_workers[index];
+            std::lock_guard<std::mutex> lock(w.mutex);
+            Heap& heap = w.*lane;
+            if (heap.empty()) return false;
+            *out = PopTop(heap);
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool TrySteal(int self, Heap Worker::* lane, ThumbTask* out) {
+            const int n = (int)m_workers.size();
+            for (int k = 1; k < n; ++k) {
+                if (TryPop((self + k) % n, lane, out)) {
+                    m_stolen.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool TryReserveSlow() {
+            if (m_slowActive.fetch_add(1, std::memory_order_acq_rel) < m_slowLimit) return true;
+            m_slowActive.fetch_sub(1, std::memory_order_acq_rel);
+            return false;
+        }
+
+        bool Acquire(int self, ThumbTask* out, bool* isSlow) {
+            *isSlow = false;
+            if (TryPop(self, &Worker::fast, out)) return true;
+            if (TryPop(self, &Worker::pinned, out)) return true;
+            if (TrySteal(self, &Worker::fast, out)) return true;
+
+            if (!TryReserveSlow()) return false;
+            if (TryPop(self, &Worker::slow, out) || TrySteal(self, &Worker::slow, out)) {
+                *isSlow = true;
+                return true;
+            }
+            m_slowActive.fetch_sub(1, std::memory_order_acq_rel);
+            return false;
+        }
+
+        void Signal(bool all) {
+            {
+                std::lock_guard<std::mutex> lock(m_idleMutex);
+                m_signal++;
+            }
+            if (all) m_idleCv.notify_all();
+            else m_idleCv.notify_one();
+        }
+
+        void Run(int self) {
+            if (m_onThreadStart) m_onThreadStart();
+
+            while (m_running.load(std::memory_order_acquire)) {
+                // Read the ticket before looking for work: a Push that lands in between
+                // bumps it, so the wait below cannot miss it
+                uint64_t ticket;
+                {
+                    std::lock_guard<std::mutex> lock(m_idleMutex);
+                    ticket = m_signal;
+                }
+
+                ThumbTask task;
+                bool isSlow = false;
+                if (Acquire(self, &task, &isSlow)) {
+                    m_handler(task);
+                    m_executed.fetch_add(1, std::memory_order_relaxed);
+                    if (isSlow) {
+                        m_slowActive.fetch_sub(1, std::memory_order_acq_rel);
+                        Signal(false); // A capped slow task may be waiting
+                    }
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(m_idleMutex);
+                m_idleCv.wait(lock, [&] { return !m_running.load(std::memory_order_acquire) || m_signal != ticket; });
+            }
+
+            if (m_onThreadExit) m_onThreadExit();
+        }
+
+        std::vector<std::unique_ptr<Worker>> m_workers;
+        Handler m_handler;
+        ThreadHook m_onThreadStart;
+        ThreadHook m_onThreadExit;
+
+        std::atomic<bool> m_running{ false };
+        std::atomic<uint32_t> m_nextWorker{ 0 };
+        std::atomic<size_t> m_queued{ 0 };
+        std::atomic<int> m_slowActive{ 0 };
+        int m_slowLimit = 1;
+
+        std::mutex m_idleMutex;
+        std::condition_variable m_idleCv;
+        uint64_t m_signal = 0; // Guarded by m_idleMutex
+
+        std::atomic<uint64_t> m_executed{ 0 };
+        std::atomic<uint64_t> m_stolen{ 0 };
+    };
+
+} // namespace QuickView
@@ -0,0 +1,84 @@
+#pragma once
+#include "pch.h"
+#include "TileTypes.h"
+#include <vector>
+#include <cstdint>
+
+namespace QuickView {
+
+    // ============================================================================
+    // [Titan Perf] CLOCK (second-chance) ring for tile eviction
+    // ============================================================================
+    // Replaces the sorted std::list LRU. Each tracked tile owns one slot (its index is
+    // stored in TileEntry::clockSlot); the reference bit lives in the TileEntry so
+    // readers can set it without touching the ring. Eviction walks the hand and costs
+    // O(evicted + tiles given a second chance) instead of a full sort per frame.
+    class TileClock {
+    public:
+        static constexpr int32_t NO_SLOT = -1;
+
+        // Returns the slot now holding `key` (free slots are reused before growing)
+        int32_t Insert(TileKey key) {
+            int32_t slot;
+            if (!m_free.empty()) {
+                slot = m_free.back();
+                m_free.pop_back();
+                m_keys[slot] = key;
+            } else {
+                slot = (int32_t)m_keys.size();
+                m_keys.push_back(key);
+            }
+            m_live++;
+            return slot;
+        }
+
+        void Release(int32_t slot) {
+            if (slot < 0 || slot >= (int32_t)m_keys.size() || m_keys[slot] == EmptyKey()) return;
+            m_keys[slot] = EmptyKey();
+            m_free.push_back(slot);
+            m_live--;
+        }
+
+        void Clear() {
+            m_keys.clear();
+            m_free.clear();
+            m_hand = 0;
+            m_live = 0;
+        }
+
+        size_t Size() const { return m_live; }
+
+        // Advances the hand while `needMore()` holds. `tryEvict(key)` returns true when the
+        // tile was evicted (its slot is released here) and false when it was spared because
+        // its reference bit was set (the callback clears it). Two laps bound the walk: after
+        // one lap every bit seen has been cleared. Returns the number of evicted tiles.
+        template<typename NeedMore, typename TryEvict>
+        size_t Sweep(NeedMore&& needMore, TryEvict&& tryEvict) {
+            size_t evicted = 0;
+            const size_t ringSize = m_keys.size();
+            if (ringSize == 0) return 0;
+
+            for (size_t steps = 0; steps < 2 * ringSize && m_live > 0 && needMore(); ++steps) {
+                if (m_hand >= ringSize) m_hand = 0;
+                const int32_t slot = (int32_t)m_hand++;
+                if (m_keys[slot] == EmptyKey()) continue;
+
+                if (tryEvict(m_keys[slot])) {
+                    Release(slot);
+                    evicted++;
+                }
+            }
+            return evicted;
+        }
+
+    private:
+        // Level 255 is never produced (MAX_LOD_LEVELS is 8)
+        static TileKey EmptyKey() { return TileKey{ ~0ULL }; }
+
+        std::vector<TileKey> m_keys;   // Slot -> key (EmptyKey when free)
+        std::vector<int32_t> m_free;   // Released slots, reused LIFO
+        size_t m_hand = 0;
+        size_t m_live = 0;
+    };
+
+} // namespace QuickView
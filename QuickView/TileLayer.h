@@ -17,7 +17,8 @@ namespace QuickView {
     struct TileEntry {
         std::atomic<TileStateCode> state{TileStateCode::Empty};
         std::shared_ptr<TileState> data; // Holds the logical tile data (Frame, Texture) - SHARED for RenderEngine access
-        bool inLru = false; // [BugFix] O(1) LRU deduplication flag
+        int32_t clockSlot = -1; // [Titan Perf] Slot in TileManager's CLOCK ring (-1 = untracked)
+        std::atomic<bool> referenced{false}; // CLOCK reference bit, set on every use (lock-free)
 
         TileEntry() = default;
         // shared_ptr is copyable, so TileEntry can be copyable, but atomic is not.
@@ -27,12 +28,16 @@ namespace QuickView {
         TileEntry(TileEntry&& other) noexcept {
             state.store(other.state.load());
             data = std::move(other.data);
+            clockSlot = other.clockSlot;
+            referenced.store(other.referenced.load());
         }
         
         TileEntry& operator=(TileEntry&& other) noexcept {
             if (this != &other) {
                 state.store(other.state.load());
                 data = std::move(other.data);
+                clockSlot = other.clockSlot;
+                referenced.store(other.referenced.load());
             }
             return *this;
         }
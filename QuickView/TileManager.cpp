@@ -43,7 +43,7 @@ namespace QuickView {
     TileManager::~TileManager() {
         // UniquePtrs handle cleanup
         m_layers.clear();
-        m_lru.clear();
+        m_clock.Clear();
     }
 
     void TileManager::Initialize(int imageWidth, int imageHeight) {
@@ -53,7 +53,7 @@ namespace QuickView {
         m_imageW = imageWidth;
         m_imageH = imageHeight;
         m_layers.clear();
-        m_lru.clear();
+        m_clock.Clear();
         m_lastViewport = {};
         m_currentLOD = 0;
         m_viewportTilesActive = false;
@@ -243,21 +243,19 @@ namespace QuickView {
                 entry.data->lastUsedFrameId = currentFrame;
                 entry.data->generationId = m_generationId;
 
-                // Add to LRU
-                if (!entry.inLru) {
-                    m_lru.push_front(entry.data->key);
-                    entry.inLru = true;
+                // Track in CLOCK ring
+                if (entry.clockSlot == TileClock::NO_SLOT) {
+                    entry.clockSlot = m_clock.Insert(entry.data->key);
                 }
+                entry.referenced.store(true, std::memory_order_relaxed);
                 missing.push_back(entry.data->key);
             } 
             else {
-                // Keep Alive / Update LRU
+                // Keep Alive: set the reference bit (O(1), no list reordering)
                 if (entry.data) {
                     entry.data->lastUsedFrameId = currentFrame;
-                    // Move to front logic? std::list splice is O(1) if we had iterator.
-                    // Without iterator, we skip re-ordering every frame to avoid O(N) search.
-                    // Lazy LRU: We just update timestamp. When evicting, we sort/check timestamp.
                 }
+                entry.referenced.store(true, std::memory_order_relaxed);
             }
         };
 
@@ -284,54 +282,40 @@ namespace QuickView {
     void TileManager::EnforceBudget() {
         if (GetReadyCount() <= m_maxTiles) return;
 
-        // Lazy LRU Eviction: Scan the list from back.
-        // Since we don't update list position on access (O(N)), the list handles insertion order.
-        // But we want Least Recently Used.
-        // Ideal: Use spliced list. But mapping Key -> ListIterator is extra memory.
-        // Alternative: Max-Heap of timestamps?
-        // Simpler: Just scan the m_lru list. If item is effectively old (timestamp < current - threshold), kill it.
-        // But frame counter might not vary much if we just pause.
-        
-        // Let's implement Strict LRU with Batch Eviction to avoid sorting on every frame.
-        // We evict down to 90% of m_maxTiles to give breathing room.
-        
-        m_lru.sort([&](const TileKey& a, const TileKey& b) {
-            auto entryA = GetTileEntry(a);
-            auto entryB = GetTileEntry(b);
-            uint64_t tA = (entryA && entryA->data) ? entryA->data->lastUsedFrameId : 0;
-            uint64_t tB = (entryB && entryB->data) ? entryB->data->lastUsedFrameId : 0;
-            return tA < tB;
-        });
+        // [Titan Perf] CLOCK eviction: the hand skips tiles whose reference bit was set
+        // since its last pass (clearing it) and evicts the rest. No sort, no per-comparison
+        // lookups: cost is O(evicted) plus the recently used tiles it passes over.
 
         // [Titan Perf] Dynamic Watermark: Target 90% of max tiles to avoid constant thrashing
         int targetTiles = std::max(1, (int)(m_maxTiles * 0.90f));
-        
-        // Evict
-        while (m_readyCount.load() > targetTiles && !m_lru.empty()) {
-            TileKey victim = m_lru.front();
-            m_lru.pop_front();
-
-            TileEntry* entry = GetTileEntry(victim);
-            if (entry) {
-                entry->inLru = false; // Mark removed from LRU
-                
-                // [Fix] Evict unconditionally. Loading tasks at the front of LRU are old/stale.
-                // Do not skip them, as doing so permanently drops them from LRU tracking.
+
+        m_clock.Sweep(
+            [&] { return m_readyCount.load() > targetTiles; },
+            [&](TileKey victim) {
+                TileEntry* entry = GetTileEntry(victim);
+                if (!entry) return true; // Stale slot (layer cleared)
+
+                if (entry->referenced.exchange(false, std::memory_order_relaxed)) {
+                    return false; // Second chance
+                }
+                entry->clockSlot = TileClock::NO_SLOT;
+
+                // [Fix] Evict unconditionally. Unreferenced loading tasks are old/stale.
                 TileStateCode s = entry->state.load(std::memory_order_relaxed);
                 if (s == TileStateCode::Ready) {
                     m_readyCount--;
                 }
-                
+
                 // [Fix17d] Record VirtualSurface tiles for VRAM Trim
                 if (entry->data && entry->data->uploaded) {
                     m_evictedTiles.push_back(victim);
                 }
-                
+
                 // Release CPU-only tiles AND Reset GPU tiles
                 entry->state.store(TileStateCode::Empty);
                 entry->data.reset();
-            }
-        }
+                return true;
+            });
     }
 
     // [Fix17d]
@@ -379,6 +363,19 @@ namespace QuickView {
         return nullptr;
     }
     
+    std::shared_ptr<RawImageFrame> TileManager::GetReadyFrame(TileKey key) {
+        std::lock_guard lock(m_mutex);
+        TileEntry* entry = GetTileEntry(key);
+        if (!entry || entry->state.load(std::memory_order_relaxed) != TileStateCode::Ready) return nullptr;
+        return entry->data ? entry->data->frame : nullptr;
+    }
+
+    void TileManager::GetImageSize(int* outW, int* outH) {
+        std::lock_guard lock(m_mutex);
+        *outW = m_imageW;
+        *outH = m_imageH;
+    }
+
     // [Smart Pull]
     ITileStateLayer* TileManager::GetLayer(int lod) {
         if (lod < 0 || lod >= (int)m_layers.size()) return nullptr;
@@ -455,7 +452,7 @@ namespace QuickView {
         for (auto& l : m_layers) {
             if (l) l->Clear();
         }
-        m_lru.clear();
+        m_clock.Clear();
         m_readyCount.store(0);
         m_lastViewport = {};
         m_currentLOD = 0;
@@ -470,7 +467,7 @@ namespace QuickView {
     }
     
     int TileManager::GetTotalCount() const {
-        return (int)m_lru.size(); // Approximate
+        return (int)m_clock.Size(); // Tracked tiles (any state)
     }
     
     int TileManager::GetReadyCount() const {
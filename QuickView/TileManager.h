@@ -2,6 +2,7 @@
 #include "pch.h"
 #include "TileTypes.h"
 #include "TileLayer.h" // [Hybrid Pyramid]
+#include "TileClock.h"
 #include "MappedFile.h"
 #include <vector>
 #include <memory>
@@ -34,6 +35,11 @@ namespace QuickView {
         TileEntry* GetTileEntry(TileKey key); 
         std::shared_ptr<TileState> GetTile(TileKey key);
 
+        // [Mip Chain] CPU pixels of a Ready tile, or nullptr (not ready / already uploaded).
+        // The returned reference keeps the slab alive if the tile is evicted meanwhile.
+        std::shared_ptr<RawImageFrame> GetReadyFrame(TileKey key);
+        void GetImageSize(int* outW, int* outH);
+
         // [Smart Pull] Access Layer directly for Worker checks
         ITileStateLayer* GetLayer(int lod);
 
@@ -82,6 +88,7 @@ namespace QuickView {
                     for (int x = startX; x < endX; ++x) {
                          TileEntry* entry = m_layers[l]->GetEntry(x, y);
                          if (entry && entry->state.load(std::memory_order_relaxed) == TileStateCode::Ready) {
+                             entry->referenced.store(true, std::memory_order_relaxed); // CLOCK second chance
                              if (entry->data) {
                                  func(TileKey::From(x, y, l), entry->data.get());
                              }
@@ -105,8 +112,8 @@ namespace QuickView {
         // [Hybrid Pyramid] Layers
         std::vector<std::unique_ptr<ITileStateLayer>> m_layers;
         
-        // LRU Tracking
-        std::list<TileKey> m_lru; 
+        // [Titan Perf] CLOCK eviction ring (reference bits live in TileEntry)
+        TileClock m_clock;
         std::mutex m_mutex;
         
         // [Fix17d] Eviction Queue for VRAM Trim
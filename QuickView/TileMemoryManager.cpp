@@ -1,123 +1,220 @@
 #include "TileMemoryManager.h"
-
-#include <windows.h>
+#include "VirtualMemory.h"
 
 namespace QuickView {
 
 TileMemoryManager::TileMemoryManager(size_t capacityMB) {
-    m_capacity = (capacityMB * 1024 * 1024) / TILE_SLAB_SIZE;
-    if (m_capacity == 0) m_capacity = 1;
-    
-    m_totalSize = m_capacity * TILE_SLAB_SIZE;
-    
-    // Allocate contiguous virtual address space
-    m_basePtr = static_cast<uint8_t*>(VirtualAlloc(nullptr, m_totalSize, MEM_RESERVE, PAGE_READWRITE));
-    
-    if (!m_basePtr) {
-        abort();
-    }
-    
-    // Initialize free stack and commit tracking
-    m_freeIndices.reserve(m_capacity);
-    m_committed.resize(m_capacity, false);
-    
-    for (size_t i = 0; i < m_capacity; ++i) {
-        // Push in reverse order so we pop 0 first (better for cache linearity initially)
-        m_freeIndices.push_back((int)(m_capacity - 1 - i));
+    m_budget = capacityMB * 1024 * 1024;
+    if (m_budget < TILE_SLAB_SIZE) m_budget = TILE_SLAB_SIZE;
+
+    for (int c = 0; c < TILE_SIZE_CLASS_COUNT; ++c) {
+        SizeClass& sc = m_classes[c];
+        sc.slotSize = TileSizeClassBytes(static_cast<TileSizeClass>(c));
+        sc.slotCount = m_budget / sc.slotSize;
+        if (sc.slotCount == 0) sc.slotCount = 1;
+
+        // Allocate contiguous virtual address space (per class, nothing committed yet).
+        // Small pages: a 256 KB slot could not be decommitted out of a 2 MB page.
+        sc.reservation = VM::Reserve(sc.slotCount * sc.slotSize);
+        if (!sc.reservation) {
+            abort();
+        }
+        sc.basePtr = static_cast<uint8_t*>(sc.reservation.base);
+
+        // Initialize free stack and commit tracking
+        sc.freeIndices.reserve(sc.slotCount);
+        sc.committed.resize(sc.slotCount, false);
+        sc.requested.resize(sc.slotCount, 0);
+        for (size_t i = 0; i < sc.slotCount; ++i) {
+            // Push in reverse order so we pop 0 first (better for cache linearity initially)
+            sc.freeIndices.push_back((int)(sc.slotCount - 1 - i));
+        }
     }
 }
 
 TileMemoryManager::~TileMemoryManager() {
-    if (m_basePtr) {
-        VirtualFree(m_basePtr, 0, MEM_RELEASE);
-        m_basePtr = nullptr;
+    for (SizeClass& sc : m_classes) {
+        VM::Release(sc.reservation);
+        sc.basePtr = nullptr;
+    }
+}
+
+bool TileMemoryManager::ClassFor(size_t bytes, TileSizeClass* outClass) {
+    for (int c = 0; c < TILE_SIZE_CLASS_COUNT; ++c) {
+        if (bytes <= TileSizeClassBytes(static_cast<TileSizeClass>(c))) {
+            *outClass = static_cast<TileSizeClass>(c);
+            return true;
+        }
     }
+    return false;
 }
 
-bool TileMemoryManager::Owns(void* ptr) const {
-    if (!ptr || !m_basePtr) return false;
+TileMemoryManager::SizeClass* TileMemoryManager::Owner(void* ptr) {
+    if (!ptr) return nullptr;
     uint8_t* p = static_cast<uint8_t*>(ptr);
-    return (p >= m_basePtr) && (p < m_basePtr + m_totalSize);
+    for (SizeClass& sc : m_classes) {
+        if (sc.basePtr && p >= sc.basePtr && p < sc.basePtr + sc.slotCount * sc.slotSize) {
+            return &sc;
+        }
+    }
+    return nullptr;
 }
 
 void* TileMemoryManager::Allocate() {
+    return Allocate(TILE_SLAB_SIZE);
+}
+
+void* TileMemoryManager::Allocate(size_t bytes) {
+    TileSizeClass cls;
     std::lock_guard<std::mutex> lock(m_mutex);
-    
-    if (m_freeIndices.empty()) {
+
+    if (!ClassFor(bytes, &cls)) {
+        m_failedAllocations++;
+        return nullptr; // Larger than any class
+    }
+    SizeClass& sc = m_classes[static_cast<int>(cls)];
+
+    if (sc.freeIndices.empty() || m_usedBytes + sc.slotSize > m_budget) {
+        m_failedAllocations++;
         return nullptr; // OOM in Slab
     }
-    
-    int index = m_freeIndices.back();
-    m_freeIndices.pop_back();
-    
-    void* targetPtr = m_basePtr + (size_t)index * TILE_SLAB_SIZE;
-    
+
+    // Prefer a slot that is still committed (most recently freed first): no OS call
+    const size_t inUse = sc.slotCount - sc.freeIndices.size();
+    if (sc.committedCount > inUse && !sc.committed[sc.freeIndices.back()]) {
+        auto it = std::find_if(sc.freeIndices.rbegin(), sc.freeIndices.rend(),
+                               [&](int i) { return sc.committed[i]; });
+        std::iter_swap(it, sc.freeIndices.rbegin());
+    }
+    int index = sc.freeIndices.back();
+    sc.freeIndices.pop_back();
+
+    void* targetPtr = sc.basePtr + (size_t)index * sc.slotSize;
+
     // Commit physical memory dynamically
-    if (!m_committed[index]) {
-        if (!VirtualAlloc(targetPtr, TILE_SLAB_SIZE, MEM_COMMIT, PAGE_READWRITE)) {
+    if (!sc.committed[index]) {
+        // Idle slots of other classes count against the budget: release just enough
+        if (m_committedBytes + sc.slotSize > m_budget) {
+            ReleaseIdleLocked(m_committedBytes + sc.slotSize - m_budget);
+        }
+        m_commitCalls++;
+        if (!VM::Commit(targetPtr, sc.slotSize)) {
             // Commit failed (OOM), push back and fail
-            m_freeIndices.push_back(index);
+            sc.freeIndices.push_back(index);
+            m_failedAllocations++;
             return nullptr;
         }
-        m_committed[index] = true;
+        sc.committed[index] = true;
+        sc.committedCount++;
+        m_committedBytes += sc.slotSize;
     }
-    
+
+    sc.requested[index] = bytes;
+    sc.requestedBytes += bytes;
+    m_usedBytes += sc.slotSize;
     return targetPtr;
 }
 
 void TileMemoryManager::Free(void* ptr) {
     if (!ptr) return;
-    
-    // Check ownership
-    // Calculation: index = (ptr - base) / slab_size
-    // Safety check included
-    if (!Owns(ptr)) {
+
+    // Check ownership (reservations never move, no lock needed)
+    SizeClass* sc = Owner(ptr);
+    if (!sc) {
         return;
     }
-    
-    uint8_t* p = static_cast<uint8_t*>(ptr);
-    size_t offset = p - m_basePtr;
-    
-    // Ensure aligned to slab boundary
-    if (offset % TILE_SLAB_SIZE != 0) {
+
+    size_t offset = static_cast<uint8_t*>(ptr) - sc->basePtr;
+
+    // Ensure aligned to slot boundary
+    if (offset % sc->slotSize != 0) {
         return;
     }
-    
-    int index = (int)(offset / TILE_SLAB_SIZE);
-    
+
+    int index = (int)(offset / sc->slotSize);
+
     std::lock_guard<std::mutex> lock(m_mutex);
-    m_freeIndices.push_back(index);
+    sc->requestedBytes -= sc->requested[index];
+    sc->requested[index] = 0;
+    m_usedBytes -= sc->slotSize;
+    sc->freeIndices.push_back(index);
 }
 
 void TileMemoryManager::Shrink() {
     std::lock_guard<std::mutex> lock(m_mutex);
-    for (int index : m_freeIndices) {
-        if (m_committed[index]) {
-            void* targetPtr = m_basePtr + (size_t)index * TILE_SLAB_SIZE;
-            VirtualFree(targetPtr, TILE_SLAB_SIZE, MEM_DECOMMIT);
-            m_committed[index] = false;
+    ShrinkLocked();
+}
+
+void TileMemoryManager::ShrinkLocked() {
+    for (SizeClass& sc : m_classes) {
+        for (int index : sc.freeIndices) {
+            if (sc.committed[index]) DecommitLocked(sc, index);
         }
     }
 }
 
-TileMemoryManager::SlabPtr TileMemoryManager::AllocateSmart() {
-    void* ptr = Allocate();
+void TileMemoryManager::ReleaseIdleLocked(size_t bytes) {
+    // Largest classes first (fewest OS calls per byte); within a class the oldest
+    // freed slots, since the back of the free stack is what gets reused next
+    size_t released = 0;
+    for (int c = TILE_SIZE_CLASS_COUNT - 1; c >= 0 && released < bytes; --c) {
+        SizeClass& sc = m_classes[c];
+        for (int index : sc.freeIndices) {
+            if (released >= bytes) break;
+            if (sc.committed[index]) {
+                DecommitLocked(sc, index);
+                released += sc.slotSize;
+            }
+        }
+    }
+}
+
+void TileMemoryManager::DecommitLocked(SizeClass& sc, int index) {
+    void* targetPtr = sc.basePtr + (size_t)index * sc.slotSize;
+    VM::Decommit(targetPtr, sc.slotSize);
+    m_decommitCalls++;
+    sc.committed[index] = false;
+    sc.committedCount--;
+    m_committedBytes -= sc.slotSize;
+}
+
+TileMemoryManager::SlabPtr TileMemoryManager::AllocateSmart(size_t bytes) {
+    void* ptr = Allocate(bytes);
     if (!ptr) return nullptr;
-    
+
     return SlabPtr(static_cast<uint8_t*>(ptr), SlabDeleter{this});
 }
 
 size_t TileMemoryManager::GetUsed() const {
-    // This is approximate if lock not held, but atomic read of vector size is usually safe enough for stats
-    // Or lock it.
-    // std::lock_guard lock(m_mutex); // Can't mark const if locking non-mutable mutex?
-    // Mutex is mutable in header now? No.
-    // Let's rely on approximate.
-    return (m_capacity - m_freeIndices.size()) * TILE_SLAB_SIZE;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_usedBytes;
 }
 
 size_t TileMemoryManager::GetFree() const {
-    return m_freeIndices.size() * TILE_SLAB_SIZE;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budget - m_usedBytes;
+}
+
+TileMemoryManager::Stats TileMemoryManager::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats stats;
+    for (int c = 0; c < TILE_SIZE_CLASS_COUNT; ++c) {
+        const SizeClass& sc = m_classes[c];
+        ClassStats& cs = stats.classes[c];
+        cs.slotSize = sc.slotSize;
+        cs.slotCount = sc.slotCount;
+        cs.inUse = sc.slotCount - sc.freeIndices.size();
+        cs.committed = sc.committedCount;
+        cs.requestedBytes = sc.requestedBytes;
+        stats.requestedBytes += sc.requestedBytes;
+    }
+    stats.budgetBytes = m_budget;
+    stats.usedBytes = m_usedBytes;
+    stats.committedBytes = m_committedBytes;
+    stats.failedAllocations = m_failedAllocations;
+    stats.commitCalls = m_commitCalls;
+    stats.decommitCalls = m_decommitCalls;
+    return stats;
 }
 
 } // namespace QuickView
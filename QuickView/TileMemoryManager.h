@@ -1,24 +1,47 @@
 #pragma once
-#include "pch.h"
 #include <vector>
 #include <mutex>
 #include <memory>
 #include <functional>
+#include <algorithm>
+#include "VirtualMemory.h"
 
 namespace QuickView {
 
 // Fixed size slab for 512x512 RGBA (1MB)
-constexpr size_t TILE_SLAB_SIZE = 512 * 512 * 4; 
+constexpr size_t TILE_SLAB_SIZE = 512 * 512 * 4;
+
+// Slot sizes served by TileMemoryManager. Quarter fits edge tiles (<= 256x256 BGRA),
+// Double/Quad fit padded tiles and FP16 / FP32 HDR tiles (8 / 16 bytes per pixel).
+enum class TileSizeClass : int {
+    Quarter = 0,    // 256 KB
+    Full,           // 1 MB (TILE_SLAB_SIZE)
+    Double,         // 2 MB
+    Quad,           // 4 MB
+    Count
+};
+constexpr int TILE_SIZE_CLASS_COUNT = static_cast<int>(TileSizeClass::Count);
+
+constexpr size_t TileSizeClassBytes(TileSizeClass c) {
+    constexpr size_t kBytes[TILE_SIZE_CLASS_COUNT] = {
+        TILE_SLAB_SIZE / 4, TILE_SLAB_SIZE, TILE_SLAB_SIZE * 2, TILE_SLAB_SIZE * 4
+    };
+    return kBytes[static_cast<int>(c)];
+}
 
 class TileMemoryManager {
 public:
-    // capacityMB: Total size in Megabytes (default 512MB = 512 tiles)
+    // capacityMB: Budget in Megabytes shared by all size classes (default 512MB = 512 full tiles).
+    // Each class reserves the whole budget as address space; only used slots count against it.
     TileMemoryManager(size_t capacityMB = 512);
     ~TileMemoryManager();
 
     // Returns a pointer to a 1MB block. Returns nullptr if full.
     // The returned pointer MUST be freed via Free() or the custom deleter.
     void* Allocate();
+    // Returns a block from the smallest size class holding `bytes`. Returns nullptr if
+    // `bytes` exceeds the largest class or the budget is exhausted (caller falls back to heap).
+    void* Allocate(size_t bytes);
     void Free(void* ptr);
 
     struct SlabDeleter {
@@ -30,26 +53,74 @@ public:
         }
     };
     using SlabPtr = std::unique_ptr<uint8_t[], SlabDeleter>;
-    SlabPtr AllocateSmart();
+    SlabPtr AllocateSmart(size_t bytes = TILE_SLAB_SIZE);
+
+    static bool ClassFor(size_t bytes, TileSizeClass* outClass);
 
-    size_t GetCapacity() const { return m_capacity * TILE_SLAB_SIZE; }
+    size_t GetCapacity() const { return m_budget; }
     size_t GetUsed() const;
     size_t GetFree() const;
 
+    // Occupancy / fragmentation snapshot
+    struct ClassStats {
+        size_t slotSize = 0;
+        size_t slotCount = 0;       // Reserved slots
+        size_t inUse = 0;
+        size_t committed = 0;       // Slots backed by physical memory (in use or idle)
+        size_t requestedBytes = 0;  // Sum of requested sizes of in-use slots
+    };
+    struct Stats {
+        ClassStats classes[TILE_SIZE_CLASS_COUNT];
+        size_t budgetBytes = 0;
+        size_t usedBytes = 0;       // Slot bytes handed out
+        size_t committedBytes = 0;
+        size_t requestedBytes = 0;
+        size_t failedAllocations = 0; // Too large or over budget (went to heap)
+        size_t commitCalls = 0;     // Lifetime OS commit / decommit calls (one per slot)
+        size_t decommitCalls = 0;
+
+        // Fraction of the budget handed out
+        double Occupancy() const { return budgetBytes ? (double)usedBytes / budgetBytes : 0.0; }
+        // Internal fragmentation: slot bytes not covered by the request
+        double Fragmentation() const { return usedBytes ? 1.0 - (double)requestedBytes / usedBytes : 0.0; }
+        // Committed but idle (reclaimable by Shrink)
+        size_t IdleCommittedBytes() const { return committedBytes - (std::min)(committedBytes, usedBytes); }
+    };
+    Stats GetStats() const;
+
     // Dynamically decommit unused free slabs
     void Shrink();
 
 private:
-    uint8_t* m_basePtr = nullptr;
-    size_t m_capacity; // Number of slabs
-    size_t m_totalSize; // Total bytes
-
-    std::vector<int> m_freeIndices;
-    std::vector<bool> m_committed; // Tracks which slabs have physical memory mapped
-    std::mutex m_mutex;
-    
-    // Check if ptr belongs to us
-    bool Owns(void* ptr) const;
+    struct SizeClass {
+        VM::Reservation reservation;
+        uint8_t* basePtr = nullptr;
+        size_t slotSize = 0;
+        size_t slotCount = 0;
+        std::vector<int> freeIndices;
+        std::vector<bool> committed; // Tracks which slots have physical memory mapped
+        std::vector<size_t> requested; // Requested bytes per in-use slot
+        size_t committedCount = 0;
+        size_t requestedBytes = 0;
+    };
+
+    SizeClass m_classes[TILE_SIZE_CLASS_COUNT];
+    size_t m_budget = 0;        // Total bytes
+    size_t m_usedBytes = 0;
+    size_t m_committedBytes = 0;
+    size_t m_failedAllocations = 0;
+    size_t m_commitCalls = 0;
+    size_t m_decommitCalls = 0;
+    mutable std::mutex m_mutex;
+
+    void ShrinkLocked();
+    // Decommits idle slots until at least `bytes` are released (or none are left).
+    // Only called when the allocating class has no idle committed slot of its own.
+    void ReleaseIdleLocked(size_t bytes);
+    void DecommitLocked(SizeClass& sc, int index);
+
+    // Finds the class whose reservation contains ptr (nullptr if not ours)
+    SizeClass* Owner(void* ptr);
 };
 
 }
@@ -15,8 +15,10 @@
 #include <type_traits>
 #include <functional>
 #include <mutex>
+#ifdef _WIN32
 #include <d2d1_1.h>
 #include <wrl/client.h>
+#endif
 
 namespace QuickView {
 
@@ -104,7 +106,9 @@ namespace QuickView {
         
         // Resources
         std::shared_ptr<RawImageFrame> frame; // CPU Memory (Slab)
+#ifdef _WIN32
         Microsoft::WRL::ComPtr<ID2D1Bitmap1> bitmap; // GPU Texture (Cached)
+#endif
         
         // Metadata
         uint64_t lastUsedFrameId = 0; // For LRU
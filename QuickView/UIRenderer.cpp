@@ -2315,6 +2315,9 @@ void UIRenderer::DrawDebugHUD(ID2D1DeviceContext* dc) {
     
     if (isHit) {
         dc->DrawText(L"CACHE HIT \u26A1", 11, m_debugFormat.Get(), D2D1::RectF(px, py, px+150, py+20), greenBrush.Get());
+    } else if (s.cacheSlots[curIdx] == ImageEngine::CacheStatus::COLD) {
+        // [Cold Tier] Compressed copy, promoted on the next cache lookup
+        dc->DrawText(L"COLD HIT \u2744", 10, m_debugFormat.Get(), D2D1::RectF(px, py, px+150, py+20), greenBrush.Get());
     } else {
         dc->DrawText(L"LOADING... \u23F3", 12, m_debugFormat.Get(), D2D1::RectF(px, py, px+150, py+20), yellowBrush.Get());
     }
@@ -2363,6 +2366,7 @@ void UIRenderer::DrawDebugHUD(ID2D1DeviceContext* dc) {
         
         if (st == ImageEngine::CacheStatus::HEAVY) dc->FillRectangle(slt, (ID2D1Brush*)greenBrush.Get()); 
         else if (st == ImageEngine::CacheStatus::PENDING) dc->FillRectangle(slt, (ID2D1Brush*)blueBrush.Get());
+        else if (st == ImageEngine::CacheStatus::COLD) dc->DrawRectangle(D2D1::RectF(slt.left+1, slt.top+1, slt.right-1, slt.bottom-1), (ID2D1Brush*)greenBrush.Get(), 2.0f); // Hollow green: compressed tier
         else {
              // Empty but Target?
              if (isTarget) dc->DrawRectangle(slt, (ID2D1Brush*)grayBrush.Get(), 1.0f); // Hollow
@@ -2377,7 +2381,13 @@ void UIRenderer::DrawDebugHUD(ID2D1DeviceContext* dc) {
         int count = g_pImageEngine->GetCacheItemCount();
         
         wchar_t cacheBuf[128];
-        swprintf_s(cacheBuf, L"Cache: %llu / %llu MB (%d Items)", used/1024/1024, limit/1024/1024, count);
+        if (s.coldItems > 0) {
+            // [Cold Tier] Compressed MB, item count, last promotion time
+            swprintf_s(cacheBuf, L"Cache: %llu / %llu MB (%d) | Cold: %llu MB (%d) %.1fms", used/1024/1024, limit/1024/1024, count,
+                (unsigned long long)(s.coldBytes/1024/1024), s.coldItems, s.coldPromoteMs);
+        } else {
+            swprintf_s(cacheBuf, L"Cache: %llu / %llu MB (%d Items)", used/1024/1024, limit/1024/1024, count);
+        }
         
         // Draw below the slots (py is currently at top of slots)
         // [HUD Adjust] +5px gap between slot strip and Cache text
@@ -3931,7 +3941,7 @@ float UIRenderer::EstimateRectLuminance(const D2D1_RECT_F& screenRect) const {
         AdaptiveUiPaneSnapshot pane;
         if (!GetAdaptiveUiPaneSnapshot(paneIndex, pane) || pane.path.empty()) continue;
 
-        const auto frame = g_pImageEngine->GetCachedImage(pane.path);
+        const auto frame = g_pImageEngine->PeekCachedImage(pane.path);
         if (!frame || !frame->IsValid()) continue;
 
         const D2D1_RECT_F clipped = D2D1::RectF(
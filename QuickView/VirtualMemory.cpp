@@ -0,0 +1,226 @@
+#include "pch.h"
+#include "VirtualMemory.h"
+
+#include <atomic>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#endif
+
+namespace QuickView {
+namespace VM {
+
+namespace {
+
+size_t AlignUp(size_t v, size_t a) { return (v + a - 1) & ~(a - 1); }
+
+#ifndef _WIN32
+void* MapNone(size_t bytes, int extraFlags) {
+    void* p = mmap(nullptr, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | extraFlags, -1, 0);
+    return p == MAP_FAILED ? nullptr : p;
+}
+
+// Over-reserve by one huge page and trim, so THP can back every 2 MB block
+Reservation ReserveTransparent(size_t bytes, size_t hugeSize) {
+    Reservation r;
+    const size_t size = AlignUp(bytes, hugeSize);
+    char* raw = static_cast<char*>(MapNone(size + hugeSize, MAP_NORESERVE));
+    if (!raw) return r;
+
+    char* base = reinterpret_cast<char*>(AlignUp(reinterpret_cast<uintptr_t>(raw), hugeSize));
+    if (base > raw) munmap(raw, base - raw);
+    const size_t tail = (raw + size + hugeSize) - (base + size);
+    if (tail) munmap(base + size, tail);
+
+#ifdef MADV_HUGEPAGE
+    madvise(base, size, MADV_HUGEPAGE);
+#endif
+    r.base = base;
+    r.size = size;
+    r.commitGranularity = hugeSize;
+    r.hugePages = HugePages::Transparent;
+    return r;
+}
+#endif
+
+} // namespace
+
+size_t PageSize() {
+#ifdef _WIN32
+    static const size_t s_pageSize = [] {
+        SYSTEM_INFO si;
+        GetSystemInfo(&si);
+        return (size_t)si.dwPageSize;
+    }();
+#else
+    static const size_t s_pageSize = (size_t)sysconf(_SC_PAGESIZE);
+#endif
+    return s_pageSize;
+}
+
+size_t HugePageSize() {
+#if defined(__linux__)
+    static const size_t s_hugeSize = [] {
+        size_t kb = 0;
+        if (FILE* f = std::fopen("/proc/meminfo", "r")) {
+            char line[128];
+            while (std::fgets(line, sizeof(line), f)) {
+                if (std::sscanf(line, "Hugepagesize: %zu kB", &kb) == 1) break;
+            }
+            std::fclose(f);
+        }
+        return kb * 1024;
+    }();
+    return s_hugeSize;
+#else
+    // Windows large pages must be committed in full at reserve time (and need
+    // SeLockMemoryPrivilege), which defeats commit-on-demand. Not offered.
+    return 0;
+#endif
+}
+
+Reservation Reserve(size_t bytes, HugePages hugePages) {
+    Reservation r;
+    if (bytes == 0) return r;
+
+#ifdef _WIN32
+    (void)hugePages;
+    const size_t size = AlignUp(bytes, PageSize());
+    r.base = VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_READWRITE);
+    if (!r.base) return r;
+    r.size = size;
+    r.commitGranularity = PageSize();
+    return r;
+#else
+    const size_t hugeSize = HugePageSize();
+    if (hugePages != HugePages::Off && hugeSize) {
+#ifdef MAP_HUGETLB
+        if (hugePages == HugePages::Explicit) {
+            // No MAP_NORESERVE: the pool pages are reserved now, so an empty pool
+            // fails here instead of raising SIGBUS on first touch
+            const size_t size = AlignUp(bytes, hugeSize);
+            if (void* p = MapNone(size, MAP_HUGETLB)) {
+                r.base = p;
+                r.size = size;
+                r.commitGranularity = hugeSize;
+                r.hugePages = HugePages::Explicit;
+                return r;
+            }
+        }
+#endif
+        r = ReserveTransparent(bytes, hugeSize);
+        if (r) return r;
+    }
+
+    const size_t size = AlignUp(bytes, PageSize());
+    r.base = MapNone(size, MAP_NORESERVE);
+    if (!r.base) return r;
+    r.size = size;
+    r.commitGranularity = PageSize();
+    return r;
+#endif
+}
+
+void Release(Reservation& r) {
+    if (!r.base) return;
+#ifdef _WIN32
+    VirtualFree(r.base, 0, MEM_RELEASE);
+#else
+    munmap(r.base, r.size);
+#endif
+    r = Reservation{};
+}
+
+bool Commit(void* ptr, size_t bytes) {
+    if (!bytes) return true;
+#ifdef _WIN32
+    return VirtualAlloc(ptr, bytes, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+    return mprotect(ptr, bytes, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+void Decommit(void* ptr, size_t bytes) {
+    if (!bytes) return;
+#ifdef _WIN32
+    VirtualFree(ptr, bytes, MEM_DECOMMIT);
+#elif defined(__linux__)
+    // DONTNEED drops the pages immediately (hugetlb ranges need Linux 5.18+;
+    // older kernels keep them until Release)
+    madvise(ptr, bytes, MADV_DONTNEED);
+    mprotect(ptr, bytes, PROT_NONE);
+#else
+    // Portable fallback: replace the range with a fresh inaccessible mapping
+    mmap(ptr, bytes, PROT_NONE, MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+#endif
+}
+
+void Prefault(void* ptr, size_t bytes) {
+    if (!bytes) return;
+#if defined(MADV_POPULATE_WRITE)
+    // Linux 5.14+: one call populates writable page tables for the whole range
+    if (madvise(ptr, bytes, MADV_POPULATE_WRITE) == 0) return;
+#endif
+    // Atomic OR with zero: a write fault that cannot clobber a concurrent store
+    const size_t page = PageSize();
+    auto* p = static_cast<uint8_t*>(ptr);
+    for (size_t off = 0; off < bytes; off += page) {
+        std::atomic_ref<uint8_t>(p[off]).fetch_or(0, std::memory_order_relaxed);
+    }
+    std::atomic_ref<uint8_t>(p[bytes - 1]).fetch_or(0, std::memory_order_relaxed);
+}
+
+void* AlignedAlloc(size_t bytes, size_t alignment) {
+#ifdef _WIN32
+    return _aligned_malloc(bytes, alignment);
+#else
+    void* p = nullptr;
+    if (alignment < sizeof(void*)) alignment = sizeof(void*);
+    return posix_memalign(&p, alignment, bytes) == 0 ? p : nullptr;
+#endif
+}
+
+void AlignedFree(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+uint64_t ProcessPageFaults() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc{};
+    pmc.cb = sizeof(pmc);
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0;
+    return pmc.PageFaultCount;
+#else
+    struct rusage ru;
+    std::memset(&ru, 0, sizeof(ru));
+    if (getrusage(RUSAGE_SELF, &ru) != 0) return 0;
+    return (uint64_t)ru.ru_minflt + (uint64_t)ru.ru_majflt;
+#endif
+}
+
+uint64_t TotalPhysicalMemory() {
+#ifdef _WIN32
+    MEMORYSTATUSEX statex;
+    statex.dwLength = sizeof(statex);
+    if (!GlobalMemoryStatusEx(&statex)) return 0;
+    return statex.ullTotalPhys;
+#else
+    const long pages = sysconf(_SC_PHYS_PAGES);
+    return pages > 0 ? (uint64_t)pages * PageSize() : 0;
+#endif
+}
+
+} // namespace VM
+} // namespace QuickView
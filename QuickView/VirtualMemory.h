@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace QuickView {
+namespace VM {
+
+    // ============================================================================
+    // Platform-neutral virtual memory primitives
+    // ============================================================================
+    // QuantumArena and TileMemoryManager reserve large address ranges up front and
+    // commit pages on demand. This layer maps that model onto the host:
+    //   Windows: VirtualAlloc MEM_RESERVE / MEM_COMMIT, VirtualFree MEM_DECOMMIT
+    //   POSIX:   mmap PROT_NONE reserve, mprotect commit, madvise(DONTNEED) decommit
+    // Decommitted ranges are inaccessible again on both, so a stale pointer into a
+    // shrunk arena faults instead of silently reading zero pages.
+    // ============================================================================
+
+    enum class HugePages : uint8_t {
+        Off = 0,
+        Transparent, // Linux: 2 MB-aligned reservation + MADV_HUGEPAGE; no-op elsewhere
+        Explicit,    // Linux: MAP_HUGETLB pool pages, falls back to Transparent when the pool is empty
+    };
+
+    struct Reservation {
+        void* base = nullptr;
+        size_t size = 0;
+        size_t commitGranularity = 0; // Commit/decommit offsets and sizes are multiples of this
+        HugePages hugePages = HugePages::Off; // Mode actually obtained
+
+        explicit operator bool() const { return base != nullptr; }
+    };
+
+    size_t PageSize();
+    size_t HugePageSize(); // 0 when the platform has no usable huge pages
+
+    // Reserve address space without physical backing. Returns an empty reservation on failure.
+    Reservation Reserve(size_t bytes, HugePages hugePages = HugePages::Off);
+    void Release(Reservation& r);
+
+    // [ptr, ptr + bytes) must lie inside a reservation and be granularity-aligned
+    bool Commit(void* ptr, size_t bytes);
+    void Decommit(void* ptr, size_t bytes);
+    // Fault committed pages in ahead of use without changing their contents
+    // (safe while other threads write the range)
+    void Prefault(void* ptr, size_t bytes);
+
+    // Heap fallback with alignment (overflow blocks, not page-backed ranges)
+    void* AlignedAlloc(size_t bytes, size_t alignment);
+    void AlignedFree(void* ptr);
+
+    // Process-wide page fault count (soft + hard). Deltas over a short window
+    // approximate the faults a single decode caused.
+    uint64_t ProcessPageFaults();
+
+    uint64_t TotalPhysicalMemory();
+
+} // namespace VM
+} // namespace QuickView
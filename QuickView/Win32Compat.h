@@ -0,0 +1,67 @@
+#pragma once
+// ============================================================================
+// Win32Compat.h - Win32 subset for the headless build off Windows
+// ============================================================================
+// Pulled in by pch.h when _WIN32 is not defined. Only the types, status codes
+// and CRT helpers the decode core (MiniTiff, the arena and tile allocators,
+// ImageTypes) uses; nothing that talks to a window, WIC or Direct2D.
+// ============================================================================
+
+#ifndef _WIN32
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cwchar>
+
+// --- Integer types ---
+typedef uint8_t BYTE;
+typedef uint16_t WORD;
+typedef uint32_t DWORD;
+typedef int32_t LONG;
+typedef unsigned int UINT;
+typedef uint64_t UINT64;
+typedef int BOOL;
+
+struct FILETIME {
+    DWORD dwLowDateTime;
+    DWORD dwHighDateTime;
+};
+
+// --- HRESULT ---
+typedef int32_t HRESULT;
+
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+
+#define S_OK ((HRESULT)0L)
+#define S_FALSE ((HRESULT)1L)
+#define E_NOTIMPL ((HRESULT)0x80004001L)
+#define E_POINTER ((HRESULT)0x80004003L)
+#define E_ABORT ((HRESULT)0x80004004L)
+#define E_FAIL ((HRESULT)0x80004005L)
+#define E_UNEXPECTED ((HRESULT)0x8000FFFFL)
+#define E_OUTOFMEMORY ((HRESULT)0x8007000EL)
+#define E_INVALIDARG ((HRESULT)0x80070057L)
+
+// --- CRT ---
+inline void* _aligned_malloc(size_t size, size_t alignment) {
+    // aligned_alloc wants a size that is a multiple of the alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+inline void _aligned_free(void* p) {
+    std::free(p);
+}
+
+template <size_t N>
+inline int swprintf_s(wchar_t (&buffer)[N], const wchar_t* format, ...) {
+    va_list args;
+    va_start(args, format);
+    const int written = std::vswprintf(buffer, N, format, args);
+    va_end(args);
+    return written;
+}
+
+#endif // _WIN32
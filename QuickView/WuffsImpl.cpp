@@ -45,6 +45,7 @@ typedef unsigned long uLongf;
 #endif
 
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <malloc.h>
 #include <vector>
@@ -275,6 +276,108 @@ bool DecodeGIF(const uint8_t* d, size_t s, uint32_t* w, uint32_t* h, std::pmr::v
 bool DecodeGIF(const uint8_t* d, size_t s, uint32_t* w, uint32_t* h, std::vector<uint8_t>& out, CancelPredicate c) { return DecodeGIF_Impl(d, s, w, h, out, c); }
 bool DecodeGIF(const uint8_t* d, size_t s, uint32_t* w, uint32_t* h, AllocatorFunc alloc, CancelPredicate c) { BufferAdapter a(alloc); return DecodeGIF_Impl(d, s, w, h, a, c); }
 
+// [Streaming] Same decoder, but the io_buffer only exposes what has arrived: on a
+// short read we wait for more and report the dirty rect (LZW emits top-down).
+QuickView::StreamOutcome StreamGIFPartials(const QuickView::StreamingSource& stream,
+                                           const QuickView::StreamingOptions& opts,
+                                           QuickView::PartialFrameCallback onPartial,
+                                           CancelPredicate checkCancel) {
+    using QuickView::StreamOutcome;
+
+    wuffs_gif__decoder dec;
+    wuffs_base__status status = wuffs_gif__decoder__initialize(
+        &dec, sizeof(dec), WUFFS_VERSION,
+        WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+    if (!wuffs_base__status__is_ok(&status)) return StreamOutcome::Failed;
+
+    wuffs_base__io_buffer src = {};
+    src.data.ptr = const_cast<uint8_t*>(stream.data);
+    src.data.len = stream.size;
+    src.meta.wi = stream.WaitFor(std::min(stream.size, opts.readStep));
+    src.meta.closed = (src.meta.wi == stream.size);
+
+    int partials = 0;
+    int rowsShown = 0;
+    auto lastEmit = std::chrono::steady_clock::now();
+    wuffs_base__pixel_buffer pb = {};
+    std::vector<uint8_t> pixels;
+    uint32_t width = 0, height = 0;
+
+    auto emit = [&](int rows) {
+        QuickView::PartialFrame f;
+        f.pixels = pixels.data();
+        f.width = (int)width;
+        f.height = (int)height;
+        f.stride = (int)width * 4;
+        f.rowsReady = rows;
+        // rowsFinal stays 0: interlaced passes revisit rows above the dirty rect's bottom
+        f.srcWidth = f.width;
+        f.srcHeight = f.height;
+        onPartial(f);
+        partials++;
+        rowsShown = rows;
+        lastEmit = std::chrono::steady_clock::now();
+    };
+
+    // Returns false when the source is exhausted or failed
+    auto waitForMore = [&]() {
+        if (src.meta.closed) return false;
+        const size_t next = stream.WaitFor(std::min(stream.size, src.meta.wi + opts.readStep));
+        if (next <= src.meta.wi) return false;
+        src.meta.wi = next;
+        src.meta.closed = (next == stream.size);
+        return true;
+    };
+
+#define WUFFS_STREAM_TRY(expr, onShortRead) \
+    do { \
+        while (true) { \
+            if (checkCancel && checkCancel()) return StreamOutcome::Cancelled; \
+            status = (expr); \
+            if (wuffs_base__status__is_ok(&status)) break; \
+            if (status.repr == wuffs_base__suspension__short_read) { \
+                onShortRead; \
+                if (waitForMore()) continue; \
+                return src.meta.closed ? StreamOutcome::Finished : StreamOutcome::Failed; \
+            } \
+            return StreamOutcome::Failed; \
+        } \
+    } while (0)
+
+    wuffs_base__image_config ic = {};
+    WUFFS_STREAM_TRY(wuffs_gif__decoder__decode_image_config(&dec, &ic, &src), (void)0);
+
+    width = wuffs_base__pixel_config__width(&ic.pixcfg);
+    height = wuffs_base__pixel_config__height(&ic.pixcfg);
+    if (width == 0 || height == 0) return StreamOutcome::Failed;
+    if ((uint64_t)width * height > opts.maxPixels) return StreamOutcome::Unsupported;
+
+    wuffs_base__pixel_config__set(&ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL, WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+    pixels.resize((size_t)width * height * 4);
+    status = wuffs_base__pixel_buffer__set_from_slice(&pb, &ic.pixcfg, wuffs_base__make_slice_u8(pixels.data(), pixels.size()));
+    if (!wuffs_base__status__is_ok(&status)) return StreamOutcome::Failed;
+
+    std::vector<uint8_t> workbuf(wuffs_gif__decoder__workbuf_len(&dec).max_incl);
+
+    wuffs_base__frame_config fc = {};
+    WUFFS_STREAM_TRY(wuffs_gif__decoder__decode_frame_config(&dec, &fc, &src), (void)0);
+
+    auto emitIfDue = [&]() {
+        const int rows = (int)std::min(wuffs_gif__decoder__frame_dirty_rect(&dec).max_excl_y, height);
+        if (rows <= rowsShown || partials >= opts.maxPartials) return;
+        if (partials > 0 && std::chrono::steady_clock::now() - lastEmit < std::chrono::milliseconds(opts.minIntervalMs)) return;
+        emit(rows);
+    };
+    WUFFS_STREAM_TRY(wuffs_gif__decoder__decode_frame(&dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                                                      wuffs_base__make_slice_u8(workbuf.data(), workbuf.size()), nullptr),
+                     emitIfDue());
+#undef WUFFS_STREAM_TRY
+
+    // First frame complete (later frames belong to the animation path)
+    if (rowsShown < (int)height) emit((int)height);
+    return StreamOutcome::Finished;
+}
+
 // ------------------------------------------------------------
 // BMP Decoder
 // ------------------------------------------------------------
@@ -962,12 +1065,16 @@ private:
     };
     
     void BackgroundIndexer(std::stop_token st) {
+#ifdef _WIN32
         __try {
             BackgroundIndexerInternal(st);
         }
         __except (GetExceptionCode() == STATUS_IN_PAGE_ERROR ? EXCEPTION_EXECUTE_HANDLER : EXCEPTION_CONTINUE_SEARCH) {
             // [Stability Fix] Safely exit if MMF page fault fails (e.g. temporary file deleted, disk removed).
         }
+#else
+        BackgroundIndexerInternal(st);
+#endif
     }
 
     void BackgroundIndexerInternal(std::stop_token st) {
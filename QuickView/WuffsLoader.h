@@ -10,6 +10,7 @@
 #include <memory_resource>
 #include "DisplayColorInfo.h"
 #include "ImageTypes.h"
+#include "ProgressiveStream.h"
 
 namespace WuffsLoader {
 
@@ -69,6 +70,14 @@ bool DecodeGIF(const uint8_t* data, size_t size,
                AllocatorFunc alloc,
                CancelPredicate checkCancel = {});
 
+/// <summary>
+/// [Streaming] Emit the first GIF frame row-by-row while the source is still arriving
+/// </summary>
+QuickView::StreamOutcome StreamGIFPartials(const QuickView::StreamingSource& src,
+                                           const QuickView::StreamingOptions& opts,
+                                           QuickView::PartialFrameCallback onPartial,
+                                           CancelPredicate checkCancel = {});
+
 /// <summary>
 /// Decode BMP image to BGRA pixels
 /// </summary>
@@ -5420,7 +5420,7 @@ void RefreshImageDisplay(HWND hwnd) {
 
     // Refresh Right Pane (Single or Compare Right)
     if (!GetPaneContext(PaneSlot::Primary).path.empty()) {
-        auto frame = g_pImageEngine->GetCachedImage(GetPaneContext(PaneSlot::Primary).path);
+        auto frame = g_pImageEngine->PeekCachedImage(GetPaneContext(PaneSlot::Primary).path);
         if (frame && frame->IsValid()) {
             if (GetPaneContext(PaneSlot::Primary).metadata.MeasuredPeakNits < 0.0f &&
                 frame->pixels &&
@@ -5451,7 +5451,7 @@ void RefreshImageDisplay(HWND hwnd) {
 
     // Refresh Left Pane (Compare Mode)
     if (IsCompareModeActive() && GetPaneContext(PaneSlot::Left).valid && !GetPaneContext(PaneSlot::Left).path.empty()) {
-        auto leftFrame = g_pImageEngine->GetCachedImage(GetPaneContext(PaneSlot::Left).path);
+        auto leftFrame = g_pImageEngine->PeekCachedImage(GetPaneContext(PaneSlot::Left).path);
         if (leftFrame && leftFrame->IsValid()) {
             if (GetPaneContext(PaneSlot::Left).metadata.MeasuredPeakNits < 0.0f &&
                 leftFrame->pixels &&
@@ -6597,22 +6597,26 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, [[maybe_unused]] LPWSTR lpCm
                  EngineConfig autoCfg = EngineConfig::FromHardware(SystemInfo::Cached());
                  policy.enablePrefetch = true;
                  policy.maxCacheMemory = autoCfg.maxCacheMemory;
+                 policy.maxColdCacheMemory = autoCfg.maxColdCacheMemory;
                  policy.lookAheadCount = autoCfg.prefetchLookAhead;
                  break;
              }
              case 2: // Eco
                  policy.enablePrefetch = true;
                  policy.maxCacheMemory = 128 * 1024 * 1024;
+                 policy.maxColdCacheMemory = 64 * 1024 * 1024;
                  policy.lookAheadCount = 1;
                  break;
              case 3: // Balanced
                  policy.enablePrefetch = true;
                  policy.maxCacheMemory = 512 * 1024 * 1024;
+                 policy.maxColdCacheMemory = 256 * 1024 * 1024;
                  policy.lookAheadCount = 3;
                  break;
              case 4: // Ultra
                  policy.enablePrefetch = true;
                  policy.maxCacheMemory = 2048ULL * 1024 * 1024;
+                 policy.maxColdCacheMemory = 1024ULL * 1024 * 1024;
                  policy.lookAheadCount = 10;
                  break;
          }
@@ -12188,12 +12192,13 @@ void ProcessEngineEvents(HWND hwnd) {
                 // UI Text Logic
                 wchar_t titleBuf[2048];
                 if (isPreview) {
-                    swprintf_s(titleBuf, L"Loading... %s - %s",
-                        evt.filePath.substr(evt.filePath.find_last_of(L"\\/") + 1).c_str(),
+                    const std::wstring_view fileName = evt.filePath.substr(evt.filePath.find_last_of(L"\\/") + 1);
+                    swprintf_s(titleBuf, L"Loading... %.*s - %s",
+                        (int)fileName.size(), fileName.data(),
                         g_szWindowTitle);
                 } else {
                      // [RAW+JPEG Pairing] Flag the hidden RAW in the title, e.g. "IMG_001.JPG (+CR3)"
-                     std::wstring titleName = evt.filePath.substr(evt.filePath.find_last_of(L"\\/") + 1);
+                     std::wstring titleName(evt.filePath.substr(evt.filePath.find_last_of(L"\\/") + 1));
                      if (const auto* pairedRaw = GetPaneContext(PaneSlot::Primary).navigator.GetPairedRaw(FileNavigator::PathToImageID(evt.filePath))) {
                          titleName += L" (" + FileNavigator::PairedRawLabel(*pairedRaw) + L")";
                      }
@@ -12424,7 +12429,7 @@ void ProcessEngineEvents(HWND hwnd) {
             if (g_compEngine && g_config.IsAdvancedColorEnabled(g_compEngine->GetDisplayColorState().advancedColorActive)) {
                 // 1. Update Core Cache (Critical for navigation & Ctrl+5 refresh)
                 if (g_pImageEngine) {
-                    auto cachedFrame = g_pImageEngine->GetCachedImage(evt.filePath);
+                    auto cachedFrame = g_pImageEngine->PeekCachedImage(evt.filePath);
                     if (cachedFrame) {
                         cachedFrame->blendOp = evt.blendOp;
                         cachedFrame->shaderPayload = evt.shaderPayload;
@@ -12438,7 +12443,7 @@ void ProcessEngineEvents(HWND hwnd) {
                 }
 
                 // 2. Update Active Runtime Resource (for immediate repaint)
-                auto cachedFrame = (g_pImageEngine) ? g_pImageEngine->GetCachedImage(evt.filePath) : nullptr;
+                auto cachedFrame = (g_pImageEngine) ? g_pImageEngine->PeekCachedImage(evt.filePath) : nullptr;
                 if (cachedFrame && cachedFrame->auxLayer) {
                     GetPaneContext(PaneSlot::Primary).resource.blendOp = cachedFrame->blendOp;
                     GetPaneContext(PaneSlot::Primary).resource.shaderPayload = cachedFrame->shaderPayload;
@@ -12451,7 +12456,7 @@ void ProcessEngineEvents(HWND hwnd) {
 
                 // [v10.3.1] Trigger Histogram Refresh for HDR Gain Map
                 if (g_runtime.ShowInfoPanel && g_runtime.InfoPanelExpanded && IsTelemetryNeeded()) {
-                    UpdateHistogramAsync(hwnd, evt.filePath);
+                    UpdateHistogramAsync(hwnd, std::wstring(evt.filePath));
                 }
 
                 QV_LOG("Main_AuxLayer", TraceLoggingString("GainMapApplied GpuBake", "Action"));
@@ -13112,7 +13117,7 @@ FireAndForget UpdateHistogramAsync(HWND hwnd, std::wstring path) {
     // [v10.3.1 Optimized] Zero-Copy Histogram Calculation
     // We no longer call LoadToMemory() (which re-decodes the file from disk).
     // Instead, we use the pixels already residing in the engine's cache.
-    auto frame = (g_pImageEngine) ? g_pImageEngine->GetCachedImage(path) : nullptr;
+    auto frame = (g_pImageEngine) ? g_pImageEngine->PeekCachedImage(path) : nullptr;
     if (frame && frame->IsValid()) {
         g_pImageEngine->GetLoader()->ComputeHistogramFromFrame(*frame, &GetPaneContext(PaneSlot::Primary).metadata);
         
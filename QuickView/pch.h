@@ -2,12 +2,18 @@
 // [VFS-STABILITY-FIX] Build: 20260515.2
 
 // Windows headers
+#ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <windows.h>
 #include <windowsx.h>
 #include <shlwapi.h>
 #include <imm.h>
+#else
+// [Portable] Headless builds (QuickViewBench off Windows): only the decode core
+// compiles, against the small Win32 subset it uses
+#include "Win32Compat.h"
+#endif
 
 // Spartan Bedrock (Zero-cost types only)
 #include <cstdint>
@@ -37,6 +43,7 @@
 #include <expected>
 #include <span>
 
+#ifdef _WIN32
 // [Critical] Resolve Windows macro interference BEFORE Direct2D/DirectWrite headers
 #undef DrawText
 #undef DrawTextW
@@ -63,6 +70,7 @@ using Microsoft::WRL::ComPtr;
 #pragma comment(lib, "shlwapi.lib") // [SVG] For SHCreateMemStream
 #pragma comment(lib, "ole32.lib")   // [SVG] For CreateStreamOnHGlobal
 #pragma comment(lib, "imm32.lib")
+#endif // _WIN32
 
 // Helper macro for HRESULT checking
 
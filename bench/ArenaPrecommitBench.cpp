@@ -0,0 +1,142 @@
+/*
+ * QuickView Headless Benchmarks - Heavy Arena pre-commit while browsing a folder
+ * Copyright (C) 2026-Present QuickView Contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#include "BenchHarness.h"
+#include "MemoryArena.h"
+#include "VirtualMemory.h"
+#include <cstring>
+#include <thread>
+
+namespace {
+
+using namespace QuickView::Bench;
+
+// ----------------------------------------------------------------------------
+// Folder walk: 45 MP camera JPEGs with the occasional 12 MP phone shot
+// ----------------------------------------------------------------------------
+constexpr int kNavigations = 24;
+constexpr size_t kArenaSize = 512ull * 1024 * 1024; // ArenaConfig Standard tier
+
+struct Shot { int width; int height; };
+
+Shot ShotAt(int nav) {
+    if (nav % 6 == 5) return { 4032, 3024 };    // Phone
+    return { 8256 + (nav % 3) * 16, 5504 };     // Camera, slight crop variation
+}
+
+enum class Policy {
+    ShrinkEveryReset, // Old behaviour when ShouldShrinkMemory(): decommit to zero
+    WorkingSet,       // Retain recent working set, pre-commit only
+    WorkingSetFault,  // Retain + pre-commit + pre-fault across threads
+};
+
+struct PolicyResult {
+    LatencyStats decodeMs;  // Decoder writing its frame
+    LatencyStats navMs;     // Reset + pre-commit + decode
+    uint64_t decodeFaults = 0;
+    uint64_t navFaults = 0;
+    QuantumArena::Telemetry telemetry;
+};
+
+// Decoder stand-in: one frame allocation, written row by row as tj3Decompress8 does
+void FakeDecode(QuantumArena& arena, const Shot& shot) {
+    const size_t stride = (size_t)shot.width * 4;
+    auto* frame = static_cast<uint8_t*>(arena.Allocate(stride * shot.height, 64));
+    for (int y = 0; y < shot.height; ++y) {
+        std::memset(frame + (size_t)y * stride, y & 0xFF, stride);
+    }
+    DoNotOptimize(frame);
+}
+
+PolicyResult Browse(Policy policy, int faultThreads) {
+    QuantumArena arena(kArenaSize);
+    ArenaWorkingSet workingSet;
+    PolicyResult r;
+
+    for (int nav = 0; nav < kNavigations; ++nav) {
+        const Shot shot = ShotAt(nav);
+        const size_t predicted = ArenaWorkingSet::PredictFrameBytes(shot.width, shot.height);
+
+        const uint64_t navFaults0 = QuickView::VM::ProcessPageFaults();
+        Stopwatch nav_sw;
+
+        // HeavyLanePool::HintFrameSize
+        if (policy != Policy::ShrinkEveryReset) {
+            workingSet.Record(predicted);
+            arena.SetRetainBytes(workingSet.RetainBytes());
+        }
+        // Worker: Reset() with ShouldShrinkMemory() == true, then PrecommitForDecode
+        arena.Reset();
+        arena.ShrinkToRetained();
+        if (policy != Policy::ShrinkEveryReset) {
+            arena.Precommit(predicted, policy == Policy::WorkingSetFault ? faultThreads : 0);
+        }
+
+        const uint64_t decodeFaults0 = QuickView::VM::ProcessPageFaults();
+        Stopwatch decode_sw;
+        FakeDecode(arena, shot);
+        const double decodeMs = decode_sw.ElapsedMs();
+        const uint64_t decodeFaults = QuickView::VM::ProcessPageFaults() - decodeFaults0;
+
+        const double navMs = nav_sw.ElapsedMs();
+        const uint64_t navFaults = QuickView::VM::ProcessPageFaults() - navFaults0;
+
+        if (nav == 0) continue; // Cold start is the same for every policy
+        r.decodeMs.Add(decodeMs);
+        r.navMs.Add(navMs);
+        r.decodeFaults += decodeFaults;
+        r.navFaults += navFaults;
+    }
+    arena.Reset();
+    r.telemetry = arena.GetTelemetry();
+    return r;
+}
+
+void PrintRow(const char* name, const PolicyResult& r) {
+    const double navs = (double)(kNavigations - 1);
+    std::printf("%-18s %11.0f %11.0f %9.1f %9.1f %9.1f %9.1f %8llu %8llu\n", name,
+                r.navFaults / navs, r.decodeFaults / navs,
+                r.decodeMs.Percentile(50), r.decodeMs.Percentile(99),
+                r.navMs.Percentile(50), r.navMs.Percentile(99),
+                (unsigned long long)r.telemetry.commitCalls, (unsigned long long)r.telemetry.decommitCalls);
+}
+
+} // namespace
+
+QV_BENCHMARK(ArenaPrecommit, "Soft faults per navigation over a folder of 45 MP images: shrink-on-reset vs header-driven working set") {
+    const int faultThreads = opts.threads > 0 ? opts.threads
+                                              : std::clamp((int)std::thread::hardware_concurrency() / 4, 1, 4);
+    std::printf("Workload: %d navigations, 45 MP (every 6th 12 MP), arena %zu MB, %d fault threads, page %zu B\n",
+                kNavigations, kArenaSize >> 20, faultThreads, QuickView::VM::PageSize());
+    std::printf("%-18s %11s %11s %9s %9s %9s %9s %8s %8s\n", "Policy", "faults/nav", "dec faults",
+                "dec p50ms", "dec p99ms", "nav p50ms", "nav p99ms", "Commits", "Decommit");
+
+    for (int run = 0; run < opts.warmup + opts.iterations; ++run) {
+        const bool timed = run >= opts.warmup;
+        PolicyResult a = Browse(Policy::ShrinkEveryReset, faultThreads);
+        PolicyResult b = Browse(Policy::WorkingSet, faultThreads);
+        PolicyResult c = Browse(Policy::WorkingSetFault, faultThreads);
+        if (timed) {
+            PrintRow("shrink-on-reset", a);
+            PrintRow("working set", b);
+            PrintRow("ws + prefault", c);
+        }
+    }
+    return 0;
+}
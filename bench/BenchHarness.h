@@ -0,0 +1,140 @@
+/*
+ * QuickView Headless Benchmarks - Shared harness (registry, timing, stats)
+ * Copyright (C) 2026-Present QuickView Contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Intentionally free of Win32 types: benchmark bodies only talk to the
+// decode/engine APIs and report through this header, so the harness itself
+// stays portable to Linux CI runners.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace QuickView::Bench {
+
+struct BenchOptions {
+    std::filesystem::path corpus;   // --corpus <dir>: real-world files (optional per benchmark)
+    int iterations = 5;             // --iterations <n>: timed runs per sample
+    int warmup = 1;                 // --warmup <n>: untimed runs per sample
+    int threads = 0;                // --threads <n>: 0 = hardware_concurrency
+};
+
+using BenchFn = int (*)(const BenchOptions& opts);
+
+struct BenchEntry {
+    const char* name;
+    const char* description;
+    BenchFn fn;
+};
+
+// Static registry (filled by QV_BENCHMARK at static-init time)
+inline std::vector<BenchEntry>& Registry() {
+    static std::vector<BenchEntry> s_entries;
+    return s_entries;
+}
+
+struct BenchRegistration {
+    BenchRegistration(const char* name, const char* description, BenchFn fn) {
+        Registry().push_back({name, description, fn});
+    }
+};
+
+#define QV_BENCHMARK(Name, Description)                                                   \
+    static int Name##_Run(const ::QuickView::Bench::BenchOptions& opts);                  \
+    static ::QuickView::Bench::BenchRegistration Name##_Registration(#Name, Description, \
+                                                                    &Name##_Run);         \
+    static int Name##_Run(const ::QuickView::Bench::BenchOptions& opts)
+
+// ============================================================================
+// Timing
+// ============================================================================
+
+class Stopwatch {
+public:
+    Stopwatch() : m_start(std::chrono::steady_clock::now()) {}
+    void Restart() { m_start = std::chrono::steady_clock::now(); }
+    double ElapsedMs() const {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+    }
+private:
+    std::chrono::steady_clock::time_point m_start;
+};
+
+// ============================================================================
+// Latency statistics (exact percentiles, sample counts are small)
+// ============================================================================
+
+class LatencyStats {
+public:
+    void Add(double ms) { m_samples.push_back(ms); m_total += ms; }
+    size_t Count() const { return m_samples.size(); }
+    double TotalMs() const { return m_total; }
+    double MeanMs() const { return m_samples.empty() ? 0.0 : m_total / m_samples.size(); }
+
+    double Percentile(double p) const {
+        if (m_samples.empty()) return 0.0;
+        std::vector<double> sorted = m_samples;
+        std::sort(sorted.begin(), sorted.end());
+        double rank = p / 100.0 * static_cast<double>(sorted.size() - 1);
+        size_t lo = static_cast<size_t>(rank);
+        size_t hi = (std::min)(lo + 1, sorted.size() - 1);
+        double frac = rank - static_cast<double>(lo);
+        return sorted[lo] + (sorted[hi] - sorted[lo]) * frac;
+    }
+
+private:
+    std::vector<double> m_samples;
+    double m_total = 0.0;
+};
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+inline std::vector<uint8_t> ReadWholeFile(const std::filesystem::path& path) {
+    std::ifstream f(path, std::ios::binary | std::ios::ate);
+    if (!f) return {};
+    std::streamoff size = f.tellg();
+    if (size <= 0) return {};
+    std::vector<uint8_t> buf(static_cast<size_t>(size));
+    f.seekg(0);
+    f.read(reinterpret_cast<char*>(buf.data()), size);
+    buf.resize(static_cast<size_t>(f.gcount()));
+    return buf;
+}
+
+inline double MegaPixels(int64_t pixels) { return static_cast<double>(pixels) / 1e6; }
+inline double MiB(size_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); }
+
+// Keeps the optimizer from discarding results of pure kernels.
+inline void DoNotOptimize(const void* p) {
+    static const void* volatile s_sink = nullptr;
+    s_sink = p;
+}
+
+inline void PrintHeader(const char* title) {
+    std::printf("\n== %s ==\n", title);
+}
+
+} // namespace QuickView::Bench
@@ -0,0 +1,106 @@
+/*
+ * QuickView Headless Benchmarks - Entry point
+ * Copyright (C) 2026-Present QuickView Contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#include "BenchHarness.h"
+#ifdef _WIN32
+#include "DebugMetrics.h"
+#include "EditState.h"
+#include "FileNavigator.h"
+#endif
+#include "ImageLoaderSimd.h"
+#include "MemoryArena.h"
+#include <cstring>
+
+#ifdef _WIN32
+// Stubs for globals normally owned by main.cpp (no window, no panes); only the
+// Windows build links ImageLoader.cpp and the navigator that reference them
+RuntimeConfig g_runtime;
+AppConfig g_config;
+DebugMetrics g_debugMetrics;
+static FileNavigator s_benchNavigator;
+FileNavigator& g_navigator = s_benchNavigator;
+#endif
+
+// Benchmarks must see stable arena behaviour: never return pages between runs
+bool QuantumArena::ShouldShrinkMemory() noexcept { return false; }
+
+static void PrintUsage() {
+    std::printf("Usage: QuickViewBench [--list] [--run name[,name...]] [--corpus <dir>]\n"
+                "                      [--iterations <n>] [--warmup <n>] [--threads <n>]\n");
+}
+
+static bool NameSelected(const std::string& filter, const char* name) {
+    if (filter.empty()) return true;
+    size_t start = 0;
+    while (start <= filter.size()) {
+        size_t end = filter.find(',', start);
+        if (end == std::string::npos) end = filter.size();
+        if (filter.compare(start, end - start, name) == 0) return true;
+        start = end + 1;
+    }
+    return false;
+}
+
+int main(int argc, char** argv) {
+    using namespace QuickView::Bench;
+
+    BenchOptions opts;
+    std::string filter;
+    bool listOnly = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        auto next = [&]() -> const char* { return (i + 1 < argc) ? argv[++i] : ""; };
+        if (std::strcmp(arg, "--list") == 0) listOnly = true;
+        else if (std::strcmp(arg, "--run") == 0) filter = next();
+        else if (std::strcmp(arg, "--corpus") == 0) opts.corpus = next();
+        else if (std::strcmp(arg, "--iterations") == 0) opts.iterations = (std::max)(1, std::atoi(next()));
+        else if (std::strcmp(arg, "--warmup") == 0) opts.warmup = (std::max)(0, std::atoi(next()));
+        else if (std::strcmp(arg, "--threads") == 0) opts.threads = (std::max)(0, std::atoi(next()));
+        else { PrintUsage(); return 2; }
+    }
+
+    if (listOnly) {
+        for (const auto& e : Registry()) {
+            std::printf("%-28s %s\n", e.name, e.description);
+        }
+        return 0;
+    }
+
+    std::printf("QuickViewBench | SIMD target: %s\n", ImageLoaderSimd::GetActiveTargetName());
+
+    int failures = 0;
+    int ran = 0;
+    for (const auto& e : Registry()) {
+        if (!NameSelected(filter, e.name)) continue;
+        PrintHeader(e.name);
+        int rc = e.fn(opts);
+        if (rc != 0) {
+            std::printf("[FAIL] %s returned %d\n", e.name, rc);
+            failures++;
+        }
+        ran++;
+    }
+
+    if (ran == 0) {
+        std::printf("No benchmark matched '%s' (use --list)\n", filter.c_str());
+        return 2;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+/*
+ * QuickView Headless Benchmarks - TIFF / PSD pixel conversion: per-pixel loops vs SIMD row kernels
+ * Copyright (C) 2026-Present QuickView Contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#include "BenchHarness.h"
+#include "ImageLoaderSimd.h"
+#include <cstring>
+
+namespace {
+
+using namespace QuickView::Bench;
+
+// ----------------------------------------------------------------------------
+// 8192 x 6144 (50 MP) frames, converted row by row the way the decoders call
+// the kernels: a prepress CMYK TIFF, an 8-bit palette TIFF, a WhiteIsZero scan,
+// and a 16-bit RGBA PSD composite (four big-endian channel planes).
+// ----------------------------------------------------------------------------
+constexpr int kW = 8192;
+constexpr int kH = 6144;
+
+std::vector<uint8_t> MakeBytes(size_t n, uint32_t seed) {
+    std::vector<uint8_t> v(n);
+    for (size_t i = 0; i < n; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        // Smooth ramps with a little noise, like scanned artwork
+        v[i] = static_cast<uint8_t>((i / 97) + (seed >> 29));
+    }
+    return v;
+}
+
+// Before: MiniTiff::ConvertCmykToBgra
+void CmykLoop(const uint8_t* src, uint8_t* dst, int width) {
+    for (int x = 0; x < width; ++x) {
+        const uint32_t invK = 255 - src[x * 4 + 3];
+        const uint32_t r = (255 - src[x * 4 + 0]) * invK;
+        const uint32_t g = (255 - src[x * 4 + 1]) * invK;
+        const uint32_t b = (255 - src[x * 4 + 2]) * invK;
+        dst[x * 4 + 0] = static_cast<uint8_t>((b + 128 + (b >> 8)) >> 8);
+        dst[x * 4 + 1] = static_cast<uint8_t>((g + 128 + (g >> 8)) >> 8);
+        dst[x * 4 + 2] = static_cast<uint8_t>((r + 128 + (r >> 8)) >> 8);
+        dst[x * 4 + 3] = 255;
+    }
+}
+
+// Before: MiniTiff palette case, three ColorMap reads per pixel
+void PaletteLoop(const uint8_t* src, const uint16_t* colorMap, uint8_t* dst, int width) {
+    for (int x = 0; x < width; ++x) {
+        const uint8_t idx = src[x];
+        dst[x * 4 + 0] = static_cast<uint8_t>(colorMap[idx + 512] / 256);
+        dst[x * 4 + 1] = static_cast<uint8_t>(colorMap[idx + 256] / 256);
+        dst[x * 4 + 2] = static_cast<uint8_t>(colorMap[idx] / 256);
+        dst[x * 4 + 3] = 255;
+    }
+}
+
+// Before: MiniTiff gray case with the WhiteIsZero flip
+void GrayLoop(const uint8_t* src, uint8_t* dst, int width) {
+    for (int x = 0; x < width; ++x) {
+        const uint8_t val = static_cast<uint8_t>(255 - src[x]);
+        dst[x * 4 + 0] = val;
+        dst[x * 4 + 1] = val;
+        dst[x * 4 + 2] = val;
+        dst[x * 4 + 3] = 255;
+    }
+}
+
+// Before: PsdComposite::WriteChannelToBgraRow, one strided pass per channel
+uint8_t PsdSample(const uint8_t* row, uint32_t x) {
+    uint32_t val = (static_cast<uint32_t>(row[x * 2]) << 8) | row[x * 2 + 1];
+    if (val > 32768) val = 32768;
+    return static_cast<uint8_t>((val * 255 + 16384) / 32768);
+}
+
+void PsdChannelLoops(const uint8_t* const* rows, const std::vector<uint32_t>& srcX, uint8_t* dst) {
+    static const int kOffset[4] = { 2, 1, 0, 3 };
+    for (int c = 0; c < 4; ++c) {
+        for (size_t x = 0; x < srcX.size(); ++x) dst[x * 4 + kOffset[c]] = PsdSample(rows[c], srcX[x]);
+    }
+}
+
+} // namespace
+
+QV_BENCHMARK(CodecConvert, "50 MP CMYK / palette / WhiteIsZero TIFF rows and 16-bit PSD planes: per-pixel loops vs SIMD kernels") {
+    const size_t pixels = static_cast<size_t>(kW) * kH;
+    const std::vector<uint8_t> cmyk = MakeBytes(pixels * 4, 1);
+    const std::vector<uint8_t> gray = MakeBytes(pixels, 2);
+    const std::vector<uint8_t> psd = MakeBytes(pixels * 2 * 4, 3); // Four planes, channel after channel
+
+    std::vector<uint16_t> colorMap(768);
+    uint32_t palette[256];
+    for (int i = 0; i < 256; ++i) {
+        colorMap[i] = static_cast<uint16_t>(i * 257);
+        colorMap[i + 256] = static_cast<uint16_t>((255 - i) * 257);
+        colorMap[i + 512] = static_cast<uint16_t>((i * 7 & 255) * 257);
+        const uint8_t bgra[4] = { static_cast<uint8_t>(colorMap[i + 512] / 256), static_cast<uint8_t>(colorMap[i + 256] / 256),
+                                  static_cast<uint8_t>(colorMap[i] / 256), 255 };
+        std::memcpy(&palette[i], bgra, 4);
+    }
+    std::vector<uint32_t> identityX(kW);
+    for (int x = 0; x < kW; ++x) identityX[x] = static_cast<uint32_t>(x);
+
+    std::vector<uint8_t> out[2];
+    out[0].resize(pixels * 4);
+    out[1].resize(pixels * 4);
+
+    const char* const sources[] = { "CMYK TIFF 8-bit", "Palette TIFF", "WhiteIsZero TIFF", "PSD RGBA 16-bit" };
+
+    std::printf("Target: %s\n", ImageLoaderSimd::GetActiveTargetName());
+    std::printf("%-18s %-16s %10s %10s %10s %8s\n", "Source", "Method", "p50 ms", "p95 ms", "MP/s", "Exact");
+
+    for (int ci = 0; ci < 4; ++ci) {
+        for (int method = 0; method < 2; ++method) {
+            const bool simd = method == 1;
+            LatencyStats lat;
+            for (int run = 0; run < opts.warmup + opts.iterations; ++run) {
+                Stopwatch sw;
+                for (int y = 0; y < kH; ++y) {
+                    const size_t row = static_cast<size_t>(y) * kW;
+                    uint8_t* dst = out[method].data() + row * 4;
+                    switch (ci) {
+                    case 0:
+                        if (simd) ImageLoaderSimd::CmykToBgra(cmyk.data() + row * 4, 4, dst, kW);
+                        else CmykLoop(cmyk.data() + row * 4, dst, kW);
+                        break;
+                    case 1:
+                        if (simd) ImageLoaderSimd::PaletteToBgra(gray.data() + row, palette, dst, kW);
+                        else PaletteLoop(gray.data() + row, colorMap.data(), dst, kW);
+                        break;
+                    case 2:
+                        if (simd) ImageLoaderSimd::GrayToBgra(gray.data() + row, 1, dst, kW, true);
+                        else GrayLoop(gray.data() + row, dst, kW);
+                        break;
+                    default: {
+                        const uint8_t* planes[4];
+                        for (int c = 0; c < 4; ++c) planes[c] = psd.data() + (static_cast<size_t>(c) * pixels + row) * 2;
+                        if (simd) ImageLoaderSimd::PlanarToBgra(planes, 2, dst, kW);
+                        else PsdChannelLoops(planes, identityX, dst);
+                        break;
+                    }
+                    }
+                }
+                const double ms = sw.ElapsedMs();
+                DoNotOptimize(out[method].data());
+                if (run >= opts.warmup) lat.Add(ms);
+            }
+            const double p50 = lat.Percentile(50);
+            // The old CMYK rounding is off by one for 24 (ink, K) pairs; the kernel's is exact
+            const char* exact = !simd ? "-" : (out[0] == out[1] ? "yes" : (ci == 0 ? "+-1" : "NO"));
+            std::printf("%-18s %-16s %10.2f %10.2f %10.1f %8s\n", sources[ci], simd ? "SIMD kernel" : "Loop (before)",
+                        p50, lat.Percentile(95), p50 > 0.0 ? MegaPixels(static_cast<int64_t>(pixels)) / (p50 / 1000.0) : 0.0, exact);
+        }
+    }
+    return 0;
+}
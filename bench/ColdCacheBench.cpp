@@ -0,0 +1,195 @@
+/*
+ * QuickView Headless Benchmarks - Decoded-frame cache with a compressed cold tier
+ * Copyright (C) 2026-Present QuickView Contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#include "BenchHarness.h"
+#include "ColdFrameCache.h"
+#include <turbojpeg.h>
+#include <list>
+#include <random>
+#include <unordered_map>
+
+namespace {
+
+using namespace QuickView::Bench;
+using QuickView::ColdFrameCache;
+using QuickView::RawImageFrame;
+
+// ----------------------------------------------------------------------------
+// Folder: 200 x 12 MP JPEGs (4 distinct encodes reused by index)
+// ----------------------------------------------------------------------------
+constexpr int kFolderSize = 200;
+constexpr int kWidth = 4000;
+constexpr int kHeight = 3000;
+constexpr int kDistinct = 4;
+constexpr size_t kHotBudget = 1024ull * 1024 * 1024;  // PrefetchPolicy::maxCacheMemory default
+constexpr size_t kColdBudget = 512ull * 1024 * 1024;
+
+// Smooth gradients, soft shapes and sensor-like grain, so the decoded JPEG has
+// roughly the entropy of a real photo
+std::vector<uint8_t> EncodeSyntheticJpeg(uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> bgra((size_t)kWidth * kHeight * 4);
+    const float cx = (float)(rng() % kWidth), cy = (float)(rng() % kHeight);
+    for (int y = 0; y < kHeight; ++y) {
+        uint8_t* row = bgra.data() + (size_t)y * kWidth * 4;
+        for (int x = 0; x < kWidth; ++x) {
+            const float dx = x - cx, dy = y - cy;
+            const bool disc = dx * dx + dy * dy < 600.0f * 600.0f;
+            const int grain = (int)(rng() % 9) - 4;
+            row[x * 4 + 0] = (uint8_t)std::clamp((disc ? 200 : x * 255 / kWidth) + grain, 0, 255);
+            row[x * 4 + 1] = (uint8_t)std::clamp((y * 255 / kHeight + (int)seed * 40) % 256 + grain, 0, 255);
+            row[x * 4 + 2] = (uint8_t)std::clamp((disc ? 60 : (x + y) * 255 / (kWidth + kHeight)) + grain, 0, 255);
+            row[x * 4 + 3] = 255;
+        }
+    }
+
+    tjhandle tj = tj3Init(TJINIT_COMPRESS);
+    tj3Set(tj, TJPARAM_QUALITY, 90);
+    tj3Set(tj, TJPARAM_SUBSAMP, TJSAMP_420);
+    unsigned char* out = nullptr;
+    size_t outSize = 0;
+    std::vector<uint8_t> jpeg;
+    if (tj3Compress8(tj, bgra.data(), kWidth, kWidth * 4, kHeight, TJPF_BGRA, &out, &outSize) == 0) {
+        jpeg.assign(out, out + outSize);
+    }
+    tj3Free(out);
+    tj3Destroy(tj);
+    return jpeg;
+}
+
+// Miss path stand-in: full tj3 decode to heap BGRA, as the cache would hold it
+std::shared_ptr<RawImageFrame> Decode(tjhandle tj, const std::vector<uint8_t>& jpeg) {
+    auto frame = std::make_shared<RawImageFrame>();
+    frame->width = kWidth;
+    frame->height = kHeight;
+    frame->stride = kWidth * 4;
+    frame->format = QuickView::PixelFormat::BGRA8888;
+    frame->quality = QuickView::DecodeQuality::Full;
+    frame->pixels = new uint8_t[(size_t)frame->stride * kHeight];
+    frame->memoryDeleter = QuickView::MemoryDeleter::FromDeleteArray();
+    tj3DecompressHeader(tj, jpeg.data(), jpeg.size());
+    tj3Decompress8(tj, jpeg.data(), jpeg.size(), frame->pixels, frame->stride, TJPF_BGRA);
+    return frame;
+}
+
+// Back-and-forth walk: forward in bursts, then flip back further than the hot
+// LRU holds (1 GB / 48 MB = 21 frames) before continuing
+std::vector<int> BrowsePath() {
+    std::vector<int> path;
+    int pos = 0;
+    path.push_back(pos);
+    while (pos < kFolderSize - 1) {
+        for (int i = 0; i < 50 && pos < kFolderSize - 1; ++i) path.push_back(++pos);
+        for (int i = 0; i < 30 && pos > 0; ++i) path.push_back(--pos);
+        for (int i = 0; i < 30 && pos < kFolderSize - 1; ++i) path.push_back(++pos);
+    }
+    return path;
+}
+
+struct BrowseResult {
+    LatencyStats hotMs;   // Lookup in the decoded LRU
+    LatencyStats coldMs;  // Promotion from the compressed tier
+    LatencyStats missMs;  // Full decode
+    LatencyStats navMs;   // Every navigation
+    ColdFrameCache::Stats cold;
+};
+
+// ImageEngine::GetCachedImage + AddToCache, without the prefetcher
+BrowseResult Browse(const std::vector<std::vector<uint8_t>>& jpegs, const std::vector<int>& path, bool withCold) {
+    struct Hot { std::shared_ptr<RawImageFrame> frame; std::list<int>::iterator lru; };
+    std::unordered_map<int, Hot> hot;
+    std::list<int> lru; // Most recent at front
+    size_t hotBytes = 0;
+    std::unique_ptr<ColdFrameCache> cold;
+    if (withCold) cold = std::make_unique<ColdFrameCache>(kColdBudget);
+
+    tjhandle tj = tj3Init(TJINIT_DECOMPRESS);
+    BrowseResult r;
+    for (int index : path) {
+        Stopwatch sw;
+
+        std::shared_ptr<RawImageFrame> frame;
+        auto it = hot.find(index);
+        if (it != hot.end()) {
+            frame = it->second.frame;
+            lru.splice(lru.begin(), lru, it->second.lru);
+            r.hotMs.Add(sw.ElapsedMs());
+        } else {
+            frame = cold ? cold->Take((ImageID)index) : nullptr;
+            const bool promoted = frame != nullptr;
+            if (!frame) frame = Decode(tj, jpegs[index % kDistinct]);
+            (promoted ? r.coldMs : r.missMs).Add(sw.ElapsedMs());
+
+            const size_t size = frame->GetBufferSize();
+            while (hotBytes + size > kHotBudget && !lru.empty()) {
+                const int victim = lru.back();
+                lru.pop_back();
+                auto vit = hot.find(victim);
+                hotBytes -= vit->second.frame->GetBufferSize();
+                if (cold) cold->Put((ImageID)victim, std::move(vit->second.frame), victim);
+                hot.erase(vit);
+            }
+            lru.push_front(index);
+            hot[index] = { frame, lru.begin() };
+            hotBytes += size;
+        }
+        DoNotOptimize(frame->pixels);
+        r.navMs.Add(sw.ElapsedMs());
+
+        // Dwell: the user looks at the image while the worker compresses
+        if (cold) cold->Flush();
+    }
+    tj3Destroy(tj);
+    if (cold) r.cold = cold->GetStats();
+    return r;
+}
+
+void PrintRow(const char* name, const BrowseResult& r) {
+    std::printf("%-10s %5zu %5zu %5zu %9.1f %9.2f %9.2f %9.1f %9.1f %9.1f\n", name,
+                r.hotMs.Count(), r.coldMs.Count(), r.missMs.Count(),
+                r.navMs.MeanMs(), r.coldMs.Percentile(50), r.coldMs.Percentile(99),
+                r.missMs.Percentile(50), r.missMs.Percentile(99), r.navMs.Percentile(90));
+}
+
+} // namespace
+
+QV_BENCHMARK(ColdCache, "Back-and-forth browsing over 200 x 12 MP JPEGs: decoded LRU alone vs LRU + compressed cold tier") {
+    std::vector<std::vector<uint8_t>> jpegs;
+    for (int i = 0; i < kDistinct; ++i) jpegs.push_back(EncodeSyntheticJpeg(0x51C0 + i));
+    const std::vector<int> path = BrowsePath();
+
+    std::printf("Workload: %zu navigations over %d files (%dx%d), hot %zu MB, cold %zu MB\n",
+                path.size(), kFolderSize, kWidth, kHeight, kHotBudget >> 20, kColdBudget >> 20);
+    std::printf("%-10s %5s %5s %5s %9s %9s %9s %9s %9s %9s\n", "Cache", "Hot", "Cold", "Miss",
+                "nav avgms", "cold p50", "cold p99", "miss p50", "miss p99", "nav p90");
+
+    for (int run = 0; run < opts.warmup + opts.iterations; ++run) {
+        const bool timed = run >= opts.warmup;
+        BrowseResult a = Browse(jpegs, path, false);
+        BrowseResult b = Browse(jpegs, path, true);
+        if (timed) {
+            PrintRow("hot only", a);
+            PrintRow("hot+cold", b);
+            std::printf("  cold tier: %zu frames, %.0f MB for %.0f MB decoded (ratio %.2f), %llu evictions\n",
+                        b.cold.entries, MiB(b.cold.compressedBytes), MiB(b.cold.rawBytes), b.cold.Ratio(),
+                        (unsigned long long)b.cold.evictions);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,255 @@
+/*
+ * QuickView Headless Benchmarks - Buffer codec decode latency over a corpus
+ * Copyright (C) 2026-Present QuickView Contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#include "BenchHarness.h"
+#ifdef _WIN32
+#include "ImageLoader.h"
+#else
+#include "PsdComposite.h"
+#include "StbLoader.h"
+#include "TinyExrLoader.h"
+#include "WuffsLoader.h"
+#include <turbojpeg.h>
+#endif
+#include "MemoryArena.h"
+#include "MiniTiff.h"
+#include <cwctype>
+#include <map>
+
+namespace {
+
+using namespace QuickView::Bench;
+
+struct FormatStats {
+    LatencyStats latency;
+    int64_t pixels = 0;        // Decoded pixels summed over timed runs
+    size_t files = 0;
+    size_t failures = 0;
+    size_t peakArenaBytes = 0;
+    size_t arenaAllocs = 0;    // Summed over timed runs
+    size_t overflowAllocs = 0; // Summed over timed runs
+};
+
+// Grouping key: upper-case extension ("JPG" and "JPEG" stay distinct on purpose,
+// so a regression in one corpus subset is visible on its own line).
+std::string FormatKey(const std::filesystem::path& path) {
+    std::string ext = path.extension().string();
+    if (!ext.empty() && ext[0] == '.') ext.erase(0, 1);
+    for (auto& c : ext) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    return ext.empty() ? std::string("?") : ext;
+}
+
+bool IsBufferCodecExtension(const std::string& key) {
+    // WebP needs libwebp, which only the Windows bench links
+    static const char* kKeys[] = {
+        "JPG", "JPEG", "JFIF", "PNG", "GIF", "BMP", "TGA", "QOI", "PNM", "PBM", "PGM",
+        "PPM", "PAM", "TIF", "TIFF", "PSD", "PSB", "EXR", "HDR", "PIC",
+#ifdef _WIN32
+        "WEBP"
+#endif
+    };
+    for (const char* k : kKeys) {
+        if (key == k) return true;
+    }
+    return false;
+}
+
+// Decode buffers come from the benchmark arena, as HeavyLanePool's come from its arena
+QuickView::Codec::DecodeContext ArenaContext(QuantumArena& arena) {
+    QuickView::Codec::DecodeContext ctx;
+    ctx.allocator.ctx = &arena;
+    ctx.allocator.pfn = [](void* c, size_t s) -> uint8_t* {
+        return static_cast<uint8_t*>(static_cast<QuantumArena*>(c)->Allocate(s, 64));
+    };
+    return ctx;
+}
+
+// TIFF goes straight to MiniTiff (LoadBufferUnified only routes it by path).
+HRESULT DecodeTiff(const std::vector<uint8_t>& bytes, QuantumArena& arena, int& outW, int& outH) {
+    QuickView::Codec::DecodeResult result;
+    HRESULT hr = QuickView::MiniTiff::Load(bytes.data(), bytes.size(), ArenaContext(arena), result);
+    outW = result.width;
+    outH = result.height;
+    return hr;
+}
+
+#ifdef _WIN32
+// One decode through the same entry points HeavyLanePool uses for mapped files.
+HRESULT DecodeOnce(CImageLoader& loader, const std::string& key,
+                   const std::vector<uint8_t>& bytes, QuantumArena& arena,
+                   int& outW, int& outH) {
+    if (key == "TIF" || key == "TIFF") return DecodeTiff(bytes, arena, outW, outH);
+
+    QuickView::RawImageFrame frame;
+    std::wstring loaderName;
+    HRESULT hr = loader.LoadToFrameFromMemory(bytes.data(), bytes.size(), &frame, &arena,
+                                              0, 0, &loaderName);
+    outW = frame.width;
+    outH = frame.height;
+    return hr;
+}
+#else
+// Off Windows there is no CImageLoader: each format goes to the codec the loader
+// dispatches it to. Stb and TinyEXR allocate their own buffers, so their arena
+// columns stay at zero.
+HRESULT DecodeJpeg(const std::vector<uint8_t>& bytes, QuantumArena& arena, int& outW, int& outH) {
+    // One handle per thread, as the loader keeps (tj3Init is not what is measured)
+    struct TjHandle {
+        tjhandle h = tj3Init(TJINIT_DECOMPRESS);
+        ~TjHandle() { if (h) tj3Destroy(h); }
+    };
+    thread_local TjHandle tj;
+    if (!tj.h || tj3DecompressHeader(tj.h, bytes.data(), bytes.size()) != 0) return E_FAIL;
+
+    const int w = tj3Get(tj.h, TJPARAM_JPEGWIDTH);
+    const int h = tj3Get(tj.h, TJPARAM_JPEGHEIGHT);
+    const int stride = QuickView::CalculateSIMDAlignedStride(w, 4);
+    if (w <= 0 || h <= 0 || stride <= 0) return E_FAIL;
+
+    auto* pixels = static_cast<uint8_t*>(arena.Allocate(static_cast<size_t>(stride) * h, 64));
+    if (!pixels) return E_OUTOFMEMORY;
+    if (tj3Decompress8(tj.h, bytes.data(), bytes.size(), pixels, stride, TJPF_BGRA) != 0) return E_FAIL;
+    outW = w;
+    outH = h;
+    return S_OK;
+}
+
+HRESULT DecodeWuffs(const std::string& key, const std::vector<uint8_t>& bytes, QuantumArena& arena,
+                    int& outW, int& outH) {
+    const QuickView::AllocatorCallback alloc = ArenaContext(arena).allocator;
+    const uint8_t* data = bytes.data();
+    const size_t size = bytes.size();
+    uint32_t w = 0, h = 0;
+    bool ok = false;
+    if (key == "PNG") ok = WuffsLoader::DecodePNG(data, size, &w, &h, alloc);
+    else if (key == "GIF") ok = WuffsLoader::DecodeGIF(data, size, &w, &h, alloc);
+    else if (key == "BMP") ok = WuffsLoader::DecodeBMP(data, size, &w, &h, alloc);
+    else if (key == "TGA") ok = WuffsLoader::DecodeTGA(data, size, &w, &h, alloc);
+    else if (key == "QOI") ok = WuffsLoader::DecodeQOI(data, size, &w, &h, alloc);
+    else ok = WuffsLoader::DecodeNetpbm(data, size, &w, &h, alloc);
+    outW = static_cast<int>(w);
+    outH = static_cast<int>(h);
+    return ok ? S_OK : E_FAIL;
+}
+
+HRESULT DecodeOnce(const std::string& key, const std::vector<uint8_t>& bytes, QuantumArena& arena,
+                   int& outW, int& outH) {
+    if (key == "TIF" || key == "TIFF") return DecodeTiff(bytes, arena, outW, outH);
+    if (key == "JPG" || key == "JPEG" || key == "JFIF") return DecodeJpeg(bytes, arena, outW, outH);
+
+    if (key == "PSD" || key == "PSB") {
+        QuickView::Codec::DecodeResult result;
+        HRESULT hr = QuickView::Codec::PsdComposite::Load(bytes.data(), bytes.size(),
+                                                          ArenaContext(arena), result);
+        outW = result.width;
+        outH = result.height;
+        return hr;
+    }
+    if (key == "EXR") {
+        std::vector<float> rgba;
+        return TinyExrLoader::LoadEXRFromMemory(bytes.data(), bytes.size(), &outW, &outH, rgba)
+                   ? S_OK : E_FAIL;
+    }
+    if (key == "HDR" || key == "PIC") {
+        int channels = 0;
+        std::pmr::vector<uint8_t> out(std::pmr::get_default_resource());
+        return StbLoader::LoadImageFromMemory(bytes.data(), bytes.size(), &outW, &outH, &channels,
+                                              out, key == "HDR")
+                   ? S_OK : E_FAIL;
+    }
+    return DecodeWuffs(key, bytes, arena, outW, outH);
+}
+#endif
+
+} // namespace
+
+QV_BENCHMARK(Decode, "Per-format MP/s, p50/p99 latency and arena usage over --corpus") {
+    if (opts.corpus.empty() || !std::filesystem::is_directory(opts.corpus)) {
+        std::printf("[Skip] --corpus <dir> is required for this benchmark\n");
+        return 0;
+    }
+
+#ifdef _WIN32
+    CImageLoader loader; // No WIC factory: unsupported buffers report E_NOTIMPL
+#endif
+    QuantumArena arena;
+    std::map<std::string, FormatStats> stats;
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(opts.corpus)) {
+        if (!entry.is_regular_file()) continue;
+        std::string key = FormatKey(entry.path());
+        if (!IsBufferCodecExtension(key)) continue;
+
+        std::vector<uint8_t> bytes = ReadWholeFile(entry.path());
+        if (bytes.empty()) continue;
+
+        FormatStats& fs = stats[key];
+        fs.files++;
+
+        bool failed = false;
+        for (int run = 0; run < opts.warmup + opts.iterations && !failed; ++run) {
+            arena.Reset();
+            arena.ResetStatistics();
+
+            int w = 0, h = 0;
+            Stopwatch sw;
+#ifdef _WIN32
+            HRESULT hr = DecodeOnce(loader, key, bytes, arena, w, h);
+#else
+            HRESULT hr = DecodeOnce(key, bytes, arena, w, h);
+#endif
+            double ms = sw.ElapsedMs();
+
+            if (FAILED(hr) || w <= 0 || h <= 0) {
+                fs.failures++;
+                failed = true;
+                std::printf("[Warn] %s: decode failed (0x%08X)\n",
+                            entry.path().filename().string().c_str(), static_cast<unsigned>(hr));
+                break;
+            }
+            if (run < opts.warmup) continue;
+
+            fs.latency.Add(ms);
+            fs.pixels += static_cast<int64_t>(w) * h;
+            fs.peakArenaBytes = (std::max)(fs.peakArenaBytes, arena.GetPeakUsage());
+            fs.arenaAllocs += arena.GetAllocationCount();
+            fs.overflowAllocs += arena.GetOverflowCount();
+        }
+    }
+
+    if (stats.empty()) {
+        std::printf("[Skip] No decodable files under %s\n", opts.corpus.string().c_str());
+        return 0;
+    }
+
+    std::printf("%-6s %6s %5s %9s %9s %9s %10s %9s %9s\n",
+                "Format", "Files", "Fail", "MP/s", "p50 ms", "p99 ms", "PeakArena", "Allocs", "Overflow");
+    for (const auto& [key, fs] : stats) {
+        const size_t runs = fs.latency.Count();
+        const double seconds = fs.latency.TotalMs() / 1000.0;
+        const double mps = seconds > 0.0 ? MegaPixels(fs.pixels) / seconds : 0.0;
+        std::printf("%-6s %6zu %5zu %9.1f %9.2f %9.2f %8.1fMB %9.1f %9.1f\n",
+                    key.c_str(), fs.files, fs.failures, mps,
+                    fs.latency.Percentile(50.0), fs.latency.Percentile(99.0),
+                    MiB(fs.peakArenaBytes),
+                    runs ? static_cast<double>(fs.arenaAllocs) / runs : 0.0,
+                    runs ? static_cast<double>(fs.overflowAllocs) / runs : 0.0);
+    }
+    return 0;
+}
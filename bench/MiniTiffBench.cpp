@@ -0,0 +1,227 @@
+/*
+ * QuickView Headless Benchmarks - MiniTiff strip decode and predictor kernels
+ * Copyright (C) 2026-Present QuickView Contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#include "BenchHarness.h"
+#include "SyntheticTiff.h"
+#include "ImageLoaderSimd.h"
+#include "MemoryArena.h"
+#include "MiniTiff.h"
+
+namespace {
+
+using namespace QuickView::Bench;
+using namespace QuickView::Testing;
+
+QuickView::Codec::DecodeContext ArenaContext(QuantumArena& arena) {
+    QuickView::Codec::DecodeContext ctx;
+    ctx.allocator.ctx = &arena;
+    ctx.allocator.pfn = [](void* c, size_t s) -> uint8_t* {
+        return static_cast<uint8_t*>(static_cast<QuantumArena*>(c)->Allocate(s, 64));
+    };
+    return ctx;
+}
+
+const char* CompressionName(uint16_t compression) {
+    switch (compression) {
+        case 1: return "None";
+        case 5: return "LZW";
+        case 8: return "Deflate";
+        default: return "?";
+    }
+}
+
+// Reference for the vectorized kernel: the per-byte loop MiniTiff used before
+void UndoPredictorBytewise(uint8_t* row, int width, int pixelStride) {
+    for (int x = 1; x < width; ++x) {
+        for (int c = 0; c < pixelStride; ++c) {
+            row[x * pixelStride + c] += row[(x - 1) * pixelStride + c];
+        }
+    }
+}
+
+} // namespace
+
+QV_BENCHMARK(MiniTiffStrips, "Synthetic 24 MP strip TIFFs: full Load and 512x512 region MP/s per codec/predictor") {
+    constexpr uint32_t kWidth = 6000;
+    constexpr uint32_t kHeight = 4000;
+    constexpr int kTile = 512;
+
+    struct Case { uint16_t compression; uint16_t predictor; uint16_t bits; };
+    const Case cases[] = {
+        {5, 1, 8}, {5, 2, 8}, {8, 1, 8}, {8, 2, 8}, {5, 2, 16}, {8, 2, 16}, {1, 2, 8},
+    };
+
+    QuantumArena arena;
+    std::printf("%-8s %5s %5s %9s %9s %9s %11s\n",
+                "Codec", "Pred", "Bits", "Ratio", "Full MP/s", "p50 ms", "Region MP/s");
+
+    for (const Case& c : cases) {
+        SyntheticTiffDesc desc;
+        desc.width = kWidth;
+        desc.height = kHeight;
+        desc.bitsPerSample = c.bits;
+        desc.compression = c.compression;
+        desc.predictor = c.predictor;
+        desc.rowsPerStrip = 64;
+
+        const std::vector<uint8_t> samples = MakeGradientSamples(kWidth, kHeight, 3, c.bits / 8);
+        const std::vector<uint8_t> file = BuildStripTiff(desc, samples);
+        const auto ctx = ArenaContext(arena);
+
+        // Full decode (multi-strip, eligible for the parallel path)
+        LatencyStats full;
+        bool failed = false;
+        for (int run = 0; run < opts.warmup + opts.iterations && !failed; ++run) {
+            arena.Reset();
+            QuickView::Codec::DecodeResult result;
+            Stopwatch sw;
+            HRESULT hr = QuickView::MiniTiff::Load(file.data(), file.size(), ctx, result);
+            double ms = sw.ElapsedMs();
+            if (FAILED(hr)) {
+                std::printf("[Warn] %s pred=%u: Load failed (0x%08X)\n", CompressionName(c.compression),
+                            c.predictor, static_cast<unsigned>(hr));
+                failed = true;
+                break;
+            }
+            DoNotOptimize(result.pixels);
+            if (run >= opts.warmup) full.Add(ms);
+        }
+        if (failed) return 1;
+
+        // Titan-sized region requests walking a diagonal (serial path, strip reuse)
+        LatencyStats region;
+        for (int run = 0; run < opts.iterations; ++run) {
+            for (int t = 0; t < 8; ++t) {
+                arena.Reset();
+                const int x = (t * 701) % (kWidth - kTile);
+                const int y = (t * 457) % (kHeight - kTile);
+                QuickView::Codec::DecodeResult result;
+                Stopwatch sw;
+                HRESULT hr = QuickView::MiniTiff::LoadRegion(file.data(), file.size(), ctx, result, x, y, kTile, kTile);
+                double ms = sw.ElapsedMs();
+                if (FAILED(hr)) return 1;
+                DoNotOptimize(result.pixels);
+                region.Add(ms);
+            }
+        }
+
+        const double fullMp = MegaPixels(static_cast<int64_t>(kWidth) * kHeight) * full.Count();
+        const double regionMp = MegaPixels(static_cast<int64_t>(kTile) * kTile) * region.Count();
+        std::printf("%-8s %5u %5u %8.2fx %9.1f %9.2f %11.1f\n",
+                    CompressionName(c.compression), c.predictor, c.bits,
+                    static_cast<double>(samples.size()) / file.size(),
+                    fullMp / (full.TotalMs() / 1000.0), full.Percentile(50.0),
+                    regionMp / (region.TotalMs() / 1000.0));
+    }
+    return 0;
+}
+
+QV_BENCHMARK(TiffPredictor, "Horizontal predictor undo: SIMD kernel vs bytewise loop, GB/s per layout") {
+    constexpr int kWidth = 8192;
+    constexpr int kRows = 256;
+
+    std::printf("%-6s %7s %14s %14s %8s\n", "Bits", "Samples", "Bytewise GB/s", "SIMD GB/s", "Match");
+    for (int bytesPerSample : {1, 2}) {
+        for (int samples = 1; samples <= 4; ++samples) {
+            const size_t rowBytes = static_cast<size_t>(kWidth) * samples * bytesPerSample;
+            std::vector<uint8_t> source(rowBytes * kRows);
+            uint32_t seed = 12345u + samples;
+            for (auto& b : source) {
+                seed = seed * 1664525u + 1013904223u;
+                b = static_cast<uint8_t>(seed >> 27);
+            }
+            std::vector<uint8_t> work(source.size());
+
+            auto timeGBps = [&](auto&& kernel) {
+                LatencyStats stats;
+                for (int run = 0; run < opts.warmup + opts.iterations; ++run) {
+                    work = source;
+                    Stopwatch sw;
+                    for (int r = 0; r < kRows; ++r) kernel(work.data() + r * rowBytes);
+                    double ms = sw.ElapsedMs();
+                    if (run >= opts.warmup) stats.Add(ms);
+                }
+                DoNotOptimize(work.data());
+                return (static_cast<double>(source.size()) * stats.Count() / 1e9) / (stats.TotalMs() / 1000.0);
+            };
+
+            // Bytewise is only a correct reference for 8-bit samples (16-bit loses the carry)
+            const double bytewise = timeGBps([&](uint8_t* row) {
+                UndoPredictorBytewise(row, kWidth, samples * bytesPerSample);
+            });
+            std::vector<uint8_t> reference = work;
+
+            const double simd = timeGBps([&](uint8_t* row) {
+                ImageLoaderSimd::UndoHorizontalPredictor(row, kWidth, samples, bytesPerSample, false);
+            });
+            const char* match = (bytesPerSample == 1) ? (work == reference ? "yes" : "NO") : "n/a";
+
+            std::printf("%-6d %7d %14.2f %14.2f %8s\n", bytesPerSample * 8, samples, bytewise, simd, match);
+            if (bytesPerSample == 1 && work != reference) return 1;
+        }
+    }
+    return 0;
+}
+
+QV_BENCHMARK(TiffLzw, "LZW strip decode: table-driven decoder vs prefix-chain reference, MB/s per content") {
+    constexpr uint32_t kWidth = 4096;
+    constexpr uint32_t kRows = 64; // One typical strip
+
+    struct Case { const char* name; uint16_t predictor; bool flat; };
+    const Case cases[] = {
+        {"Photo", 1, false}, {"Photo+Pred", 2, false}, {"Flat", 1, true},
+    };
+
+    std::printf("%-11s %8s %15s %15s %8s\n", "Content", "Ratio", "Reference MB/s", "Table MB/s", "Match");
+    for (const Case& c : cases) {
+        std::vector<uint8_t> plain = c.flat ? std::vector<uint8_t>(static_cast<size_t>(kWidth) * kRows * 3, 0x80)
+                                            : MakeGradientSamples(kWidth, kRows, 3, 1);
+        if (c.predictor == 2) {
+            for (uint32_t r = 0; r < kRows; ++r) {
+                ApplyHorizontalPredictor(plain.data() + static_cast<size_t>(r) * kWidth * 3, kWidth, 3, 1);
+            }
+        }
+        const std::vector<uint8_t> stream = EncodeTiffLzw(plain.data(), plain.size());
+        std::vector<uint8_t> out(plain.size());
+
+        auto timeMBps = [&](auto&& decode) {
+            LatencyStats stats;
+            for (int run = 0; run < opts.warmup + opts.iterations; ++run) {
+                Stopwatch sw;
+                for (int rep = 0; rep < 16; ++rep) {
+                    if (!decode(stream.data(), stream.size(), out.data(), out.size())) return -1.0;
+                }
+                double ms = sw.ElapsedMs();
+                if (run >= opts.warmup) stats.Add(ms);
+            }
+            DoNotOptimize(out.data());
+            return (MiB(plain.size()) * 16 * stats.Count()) / (stats.TotalMs() / 1000.0);
+        };
+
+        const double reference = timeMBps(QuickView::MiniTiff::DecompressLzwReference);
+        const bool refMatch = out == plain;
+        const double table = timeMBps(QuickView::MiniTiff::DecompressLzw);
+        const bool match = refMatch && out == plain;
+
+        std::printf("%-11s %7.2fx %15.1f %15.1f %8s\n", c.name,
+                    static_cast<double>(plain.size()) / stream.size(), reference, table, match ? "yes" : "NO");
+        if (!match || reference < 0.0 || table < 0.0) return 1;
+    }
+    return 0;
+}
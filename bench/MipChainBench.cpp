@@ -0,0 +1,206 @@
+/*
+ * QuickView Headless Benchmarks - Time to a complete LOD pyramid: per-level resize vs mip chain
+ * Copyright (C) 2026-Present QuickView Contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#include "BenchHarness.h"
+#include "ImageLoaderSimd.h"
+#include "MipChain.h"
+#include <unordered_map>
+
+namespace {
+
+using namespace QuickView::Bench;
+using QuickView::MAX_LOD_LEVELS;
+using QuickView::RawImageFrame;
+using QuickView::TILE_SIZE;
+using QuickView::TileKey;
+using QuickView::TileMemoryManager;
+
+// ----------------------------------------------------------------------------
+// 16384 x 12288 (201 MP) master; LOD 0 is already sliced into 768 tiles, as
+// after a full-resolution viewing session. Every method ends with LOD 1..8 as
+// zero-padded TILE_SIZE slabs from TileMemoryManager (260 tiles).
+// ----------------------------------------------------------------------------
+constexpr int kW = 16384;
+constexpr int kH = 12288;
+constexpr size_t kSlabBudgetMB = 1536; // 768 LOD 0 tiles + two pyramids (reference, current)
+
+using TileMap = std::unordered_map<TileKey, std::shared_ptr<RawImageFrame>, TileKey::Hash>;
+
+std::vector<uint8_t> MakeMaster() {
+    std::vector<uint8_t> px(static_cast<size_t>(kW) * kH * 4);
+    for (int y = 0; y < kH; ++y) {
+        uint8_t* row = px.data() + static_cast<size_t>(y) * kW * 4;
+        for (int x = 0; x < kW; ++x) {
+            row[x * 4 + 0] = static_cast<uint8_t>(x ^ y);
+            row[x * 4 + 1] = static_cast<uint8_t>((x >> 3) + (y >> 5));
+            row[x * 4 + 2] = static_cast<uint8_t>(x * 7 + y * 3);
+            row[x * 4 + 3] = 255;
+        }
+    }
+    return px;
+}
+
+int LayerSize(int size, int lod) { return (size + (1 << lod) - 1) >> lod; }
+
+std::shared_ptr<RawImageFrame> WrapSlab(uint8_t* slab, TileMemoryManager& memory) {
+    auto frame = std::make_shared<RawImageFrame>();
+    frame->pixels = slab;
+    frame->width = TILE_SIZE;
+    frame->height = TILE_SIZE;
+    frame->stride = TILE_SIZE * 4;
+    frame->format = QuickView::PixelFormat::BGRA8888;
+    frame->memoryDeleter.ctx = &memory;
+    frame->memoryDeleter.pfn = [](uint8_t* p, void* c) { static_cast<TileMemoryManager*>(c)->Free(p); };
+    return frame;
+}
+
+// Cuts one whole layer into tiles, like SliceTileFromLODCache
+bool SliceLayer(const uint8_t* layer, int layerW, int layerH, int lod, TileMemoryManager& memory, TileMap& out) {
+    for (int ty = 0; ty * TILE_SIZE < layerH; ++ty) {
+        for (int tx = 0; tx * TILE_SIZE < layerW; ++tx) {
+            auto* slab = static_cast<uint8_t*>(memory.Allocate());
+            if (!slab) return false;
+            std::memset(slab, 0, QuickView::TILE_SLAB_SIZE);
+            const int cw = (std::min)(TILE_SIZE, layerW - tx * TILE_SIZE);
+            const int ch = (std::min)(TILE_SIZE, layerH - ty * TILE_SIZE);
+            for (int y = 0; y < ch; ++y) {
+                std::memcpy(slab + static_cast<size_t>(y) * TILE_SIZE * 4,
+                            layer + ((static_cast<size_t>(ty) * TILE_SIZE + y) * layerW + tx * TILE_SIZE) * 4,
+                            static_cast<size_t>(cw) * 4);
+            }
+            out.emplace(TileKey::From(tx, ty, lod), WrapSlab(slab, memory));
+        }
+    }
+    return true;
+}
+
+// Before: every level is resized from the master, then sliced
+bool PyramidByResize(const std::vector<uint8_t>& master, TileMemoryManager& memory, TileMap& out) {
+    std::vector<uint8_t> layer;
+    for (int lod = 1; lod <= MAX_LOD_LEVELS; ++lod) {
+        const int w = LayerSize(kW, lod), h = LayerSize(kH, lod);
+        layer.resize(static_cast<size_t>(w) * h * 4);
+        ImageLoaderSimd::Resize(master.data(), kW, kH, 0, layer.data(), w, h, 0, ImageLoaderSimd::ResampleFilter::Box);
+        if (!SliceLayer(layer.data(), w, h, lod, memory, out)) return false;
+    }
+    return true;
+}
+
+// Whole-layer cascade: each level is one Downsample2x of the previous, then sliced
+bool PyramidByCascade(const std::vector<uint8_t>& master, TileMemoryManager& memory, TileMap& out) {
+    std::vector<uint8_t> prev, cur;
+    const uint8_t* src = master.data();
+    for (int lod = 1; lod <= MAX_LOD_LEVELS; ++lod) {
+        const int sw = LayerSize(kW, lod - 1), sh = LayerSize(kH, lod - 1);
+        const int w = LayerSize(kW, lod), h = LayerSize(kH, lod);
+        cur.resize(static_cast<size_t>(w) * h * 4);
+        ImageLoaderSimd::Downsample2x(src, sw, sh, 0, cur.data(), 0);
+        if (!SliceLayer(cur.data(), w, h, lod, memory, out)) return false;
+        std::swap(prev, cur);
+        src = prev.data();
+    }
+    return true;
+}
+
+// Mip chain: each tile is reduced from its four children already in slabs
+bool PyramidByMipChain(const TileMap& lod0, TileMemoryManager& memory, TileMap& out) {
+    auto fetch = [&](TileKey key) -> std::shared_ptr<RawImageFrame> {
+        const TileMap& map = key.level() == 0 ? lod0 : out;
+        auto it = map.find(key);
+        return it == map.end() ? nullptr : it->second;
+    };
+    for (int lod = 1; lod <= MAX_LOD_LEVELS; ++lod) {
+        const int w = LayerSize(kW, lod), h = LayerSize(kH, lod);
+        for (int ty = 0; ty * TILE_SIZE < h; ++ty) {
+            for (int tx = 0; tx * TILE_SIZE < w; ++tx) {
+                const TileKey key = TileKey::From(tx, ty, lod);
+                auto frame = std::make_shared<RawImageFrame>();
+                if (!QuickView::MipChain::BuildFromDescendants(key, kW, kH, fetch, memory, *frame, 1)) return false;
+                out.emplace(key, std::move(frame));
+            }
+        }
+    }
+    return true;
+}
+
+bool SamePyramid(const TileMap& a, const TileMap& b) {
+    if (a.size() != b.size()) return false;
+    for (const auto& [key, frame] : a) {
+        auto it = b.find(key);
+        if (it == b.end() || std::memcmp(frame->pixels, it->second->pixels, QuickView::TILE_SLAB_SIZE) != 0) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+QV_BENCHMARK(MipChain, "201 MP image, LOD 1..8 into tile slabs: per-level resize vs cascade vs tile mip chain") {
+    const std::vector<uint8_t> master = MakeMaster();
+    TileMemoryManager memory(kSlabBudgetMB);
+    TileMap lod0;
+    if (!SliceLayer(master.data(), kW, kH, 0, memory, lod0)) {
+        std::printf("Slab budget exhausted while slicing LOD 0\n");
+        return 1;
+    }
+
+    enum class Method { Resize, Cascade, MipChain };
+    const struct { const char* name; Method method; } methods[] = {
+        { "Resize per level (before)", Method::Resize },
+        { "Cascade Downsample2x", Method::Cascade },
+        { "Mip chain from LOD 0 tiles", Method::MipChain },
+    };
+
+    std::printf("Target: %s\n", ImageLoaderSimd::GetActiveTargetName());
+    std::printf("%-28s %8s %10s %10s %12s %8s\n", "Method", "Tiles", "p50 ms", "p95 ms", "Src MP/s", "Exact");
+
+    TileMap reference; // Cascade output; the mip chain must match it bit for bit
+    for (const auto& m : methods) {
+        LatencyStats lat;
+        TileMap pyramid;
+        for (int run = 0; run < opts.warmup + opts.iterations; ++run) {
+            pyramid.clear();
+            Stopwatch sw;
+            bool ok = false;
+            switch (m.method) {
+            case Method::Resize: ok = PyramidByResize(master, memory, pyramid); break;
+            case Method::Cascade: ok = PyramidByCascade(master, memory, pyramid); break;
+            case Method::MipChain: ok = PyramidByMipChain(lod0, memory, pyramid); break;
+            }
+            const double ms = sw.ElapsedMs();
+            if (!ok) {
+                std::printf("%s: slab budget exhausted\n", m.name);
+                return 1;
+            }
+            if (run >= opts.warmup) lat.Add(ms);
+        }
+
+        const char* exact = "-";
+        if (m.method == Method::Cascade) {
+            reference = std::move(pyramid);
+            pyramid = {};
+        } else if (m.method == Method::MipChain) {
+            exact = SamePyramid(pyramid, reference) ? "yes" : "NO";
+        }
+        const double p50 = lat.Percentile(50);
+        const size_t tiles = m.method == Method::Cascade ? reference.size() : pyramid.size();
+        std::printf("%-28s %8zu %10.1f %10.1f %12.1f %8s\n", m.name, tiles, p50, lat.Percentile(95),
+                    p50 > 0.0 ? MegaPixels(static_cast<int64_t>(kW) * kH) / (p50 / 1000.0) : 0.0, exact);
+    }
+    return 0;
+}
@@ -0,0 +1,190 @@
+/*
+ * QuickView Headless Benchmarks - Per-message allocations: path copies vs interned ImageIDs
+ * Copyright (C) 2026-Present QuickView Contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#include "BenchHarness.h"
+#include "PathTable.h"
+#include <atomic>
+#include <cwctype>
+#include <deque>
+#include <list>
+#include <new>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
+// ----------------------------------------------------------------------------
+// Allocation counter: replaces the global operator new for the whole bench
+// executable. One relaxed increment per allocation; other benchmarks do not
+// allocate in their timed loops, so their numbers are unaffected.
+// ----------------------------------------------------------------------------
+namespace {
+std::atomic<uint64_t> g_allocations{ 0 };
+}
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+using namespace QuickView::Bench;
+using QuickView::PathTable;
+
+constexpr int kFolderSize = 2000;
+constexpr int kNavigations = 20000;
+constexpr int kTilesPerStep = 16;
+
+// Realistic lengths: well past the small-string buffer
+std::vector<std::wstring> MakeFolder() {
+    std::vector<std::wstring> files;
+    for (int i = 0; i < kFolderSize; ++i) {
+        files.push_back(L"D:\\Photos\\2025\\Iceland Trip\\Day " + std::to_wstring(i / 100) +
+                        L"\\DSC_" + std::to_wstring(10000 + i) + L".JPG");
+    }
+    return files;
+}
+
+// Before: ComputePathHash lower-cased a heap copy on every call
+ImageID LegacyPathHash(const std::wstring& path) {
+    std::wstring normalized = path;
+    std::transform(normalized.begin(), normalized.end(), normalized.begin(), ::towlower);
+    return std::hash<std::wstring>{}(normalized);
+}
+
+// The per-message path fields of FastLaneCommand / EngineEvent, before and after
+struct LegacyCommand { std::wstring path; ImageID id = 0; int slot = 0; };
+struct LegacyEvent { int type = 0; std::wstring filePath; ImageID imageId = 0; int tile = -1; };
+struct InternedCommand { std::wstring_view path; ImageID id = 0; int slot = 0; };
+struct InternedEvent { int type = 0; std::wstring_view filePath; ImageID imageId = 0; int tile = -1; };
+
+struct Traffic {
+    uint64_t messages = 0;
+    uint64_t allocations = 0;
+    double ms = 0.0;
+    double AllocsPerMessage() const { return messages ? (double)allocations / messages : 0.0; }
+    double NsPerMessage() const { return messages ? ms * 1e6 / messages : 0.0; }
+};
+
+// Legacy keys the containers by the event's path copy; interned by its ImageID
+const std::wstring& KeyOf(const LegacyEvent& e) { return e.filePath; }
+ImageID KeyOf(const InternedEvent& e) { return e.imageId; }
+
+// One navigation step as the engine sees it: NavigateTo resolves the path to an
+// ID (and, interned, to the table's view), a FastLane command is queued and
+// popped, a FullReady event goes through the event queue and keys the pending
+// erase and cache lookup in PollState. Then a burst of TileReady events for the
+// same image.
+template <typename Command, typename Event, typename Key, typename ResolveFn>
+Traffic Run(const std::vector<std::wstring>& files, ResolveFn resolve) {
+    std::unordered_map<Key, int> cache;
+    std::list<Key> lru;
+    std::unordered_set<Key> pending;
+    for (int i = 0; i < kFolderSize; ++i) {
+        Event probe{};
+        std::tie(probe.imageId, probe.filePath) = resolve(files[i]);
+        if (i % 2 == 0) { // Half the folder decoded
+            cache.emplace(KeyOf(probe), i);
+            lru.push_front(KeyOf(probe));
+        } else if (i % 4 == 1) {
+            pending.insert(KeyOf(probe));
+        }
+    }
+
+    std::deque<Command> commands;
+    std::vector<Event> events;
+    events.reserve(kTilesPerStep + 1);
+    std::vector<Event> drained;
+    drained.reserve(kTilesPerStep + 1);
+
+    Traffic t;
+    uint64_t hits = 0, tiles = 0;
+    const uint64_t before = g_allocations.load(std::memory_order_relaxed);
+    Stopwatch sw;
+    for (int n = 0; n < kNavigations; ++n) {
+        const std::wstring& file = files[(n * 7) % kFolderSize];
+        Command queued{};
+        std::tie(queued.id, queued.path) = resolve(file);
+
+        commands.push_back(std::move(queued));
+        Command cmd = std::move(commands.front());
+        commands.pop_front();
+
+        events.push_back(Event{ 1, cmd.path, cmd.id, -1 });
+        for (int tile = 0; tile < kTilesPerStep; ++tile) events.push_back(Event{ 2, cmd.path, cmd.id, tile });
+        drained.swap(events); // PollState drains under the lock
+        for (const Event& e : drained) {
+            if (e.type != 1) { tiles += e.imageId ^ (uint64_t)e.tile; continue; }
+            pending.erase(KeyOf(e));
+            hits += cache.count(KeyOf(e));
+        }
+        drained.clear();
+        t.messages += 2 + kTilesPerStep; // Command + FullReady + tiles
+    }
+    t.ms = sw.ElapsedMs();
+    t.allocations = g_allocations.load(std::memory_order_relaxed) - before;
+    static volatile uint64_t s_sink;
+    s_sink = hits + tiles;
+    return t;
+}
+
+Traffic RunLegacy(const std::vector<std::wstring>& files) {
+    return Run<LegacyCommand, LegacyEvent, std::wstring>(files, [](const std::wstring& f) {
+        return std::pair<ImageID, std::wstring>{ LegacyPathHash(f), f };
+    });
+}
+
+Traffic RunInterned(const std::vector<std::wstring>& files) {
+    return Run<InternedCommand, InternedEvent, ImageID>(files, [](const std::wstring& f) {
+        const QuickView::PathRef ref = PathTable::Instance().Intern(f);
+        return std::pair<ImageID, std::wstring_view>{ ref.id, ref.path };
+    });
+}
+
+void PrintRow(const char* name, const Traffic& t) {
+    std::printf("%-10s %10llu %12llu %12.3f %10.1f\n", name, (unsigned long long)t.messages,
+                (unsigned long long)t.allocations, t.AllocsPerMessage(), t.NsPerMessage());
+}
+
+} // namespace
+
+QV_BENCHMARK(PathIntern, "Navigation + tile-event traffic: std::wstring path copies vs interned ImageID keys (allocations per message)") {
+    const std::vector<std::wstring> files = MakeFolder();
+    for (const auto& f : files) PathTable::Instance().Intern(f); // First visit of each file
+
+    std::printf("Workload: %d navigations over %d files, %d TileReady events per step\n",
+                kNavigations, kFolderSize, kTilesPerStep);
+    std::printf("%-10s %10s %12s %12s %10s\n", "Keys", "Messages", "Allocations", "Allocs/msg", "ns/msg");
+
+    for (int run = 0; run < opts.warmup + opts.iterations; ++run) {
+        const bool timed = run >= opts.warmup;
+        const Traffic legacy = RunLegacy(files);
+        const Traffic ids = RunInterned(files);
+        if (timed) {
+            PrintRow("wstring", legacy);
+            PrintRow("ImageID", ids);
+        }
+    }
+    const auto stats = PathTable::Instance().GetStats();
+    std::printf("  path table: %zu entries, %zu blocks, %.2f MB\n", stats.entries, stats.blocks, MiB(stats.arenaBytes));
+    return 0;
+}
@@ -0,0 +1,232 @@
+/*
+ * QuickView Headless Benchmarks - HeavyLanePool -> PollState result channel
+ * Copyright (C) 2026-Present QuickView Contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#include "BenchHarness.h"
+#include "MpscEventRing.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace {
+
+using namespace QuickView::Bench;
+using QuickView::MpscEventRing;
+using Clock = std::chrono::steady_clock;
+
+// ----------------------------------------------------------------------------
+// Tile storm: 8 decode workers finishing tiles while the user navigates away
+// ----------------------------------------------------------------------------
+constexpr int kProducers = 8;
+constexpr int kEventsPerProducer = 50000;
+constexpr size_t kRingSlots = 512;        // HeavyLanePool::kResultRingSlots
+constexpr auto kDrainInterval = std::chrono::microseconds(200); // WM_ENGINE_EVENT cadence
+constexpr double kDecodeUs = 4.0;         // Tiny tiles at full speed: ~2M results/s from 8 workers
+
+struct FakeFrame { std::vector<uint8_t> pixels = std::vector<uint8_t>(256); };
+
+// EngineEvent stand-in: strings, a frame reference and a fat metadata block
+struct Event {
+    int type = 0; // 1 = TileReady
+    size_t imageId = 0;
+    std::wstring filePath;
+    std::shared_ptr<FakeFrame> rawFrame;
+    std::optional<int> tileCoord;
+    std::wstring loaderName;
+    uint8_t metadata[384] = {};
+};
+
+void BurnMicros(double us) {
+    const Clock::time_point end = Clock::now() + std::chrono::nanoseconds((int64_t)(us * 1000.0));
+    while (Clock::now() < end) {}
+}
+
+struct Tag {
+    size_t imageId = 0;
+    bool isTile = false;
+};
+
+// Old path: one mutex-guarded deque, stale tiles filtered after the pop
+class MutexChannel {
+public:
+    void Push(Event&& evt) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_results.push_back(std::move(evt));
+    }
+    size_t Drain(size_t currentImageId, std::vector<Event>& out, size_t* dropped) {
+        size_t n = 0;
+        for (;;) {
+            std::optional<Event> evt;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_results.empty()) break;
+                evt = std::move(m_results.front());
+                m_results.pop_front();
+            }
+            n++;
+            if (evt->type == 1 && evt->imageId != currentImageId) { (*dropped)++; continue; }
+            out.push_back(std::move(*evt));
+        }
+        return n;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::deque<Event> m_results;
+};
+
+// New path: ring first, locked overflow only while the ring is full
+class RingChannel {
+public:
+    void Push(Event&& evt) {
+        const Tag tag{ evt.imageId, evt.type == 1 };
+        if (m_overflowCount.load(std::memory_order_acquire) == 0 && m_ring.TryPush(evt, tag)) return;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_overflow.push_back(std::move(evt));
+        m_overflowCount.fetch_add(1, std::memory_order_release);
+        overflowed.fetch_add(1, std::memory_order_relaxed);
+    }
+    size_t Drain(size_t currentImageId, std::vector<Event>& out, size_t* dropped) {
+        auto isStale = [currentImageId](const Tag& t) { return t.isTile && t.imageId != currentImageId; };
+        const size_t before = out.size();
+        const size_t d = m_ring.Drain(isStale, [&](Event&& evt, const Tag&) { out.push_back(std::move(evt)); });
+        *dropped += d;
+        size_t n = d + (out.size() - before);
+        if (m_overflowCount.load(std::memory_order_acquire) > 0 && m_ring.EmptyApprox()) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& evt : m_overflow) {
+                n++;
+                if (isStale(Tag{ evt.imageId, evt.type == 1 })) { (*dropped)++; continue; }
+                out.push_back(std::move(evt));
+            }
+            m_overflowCount.fetch_sub((int)m_overflow.size(), std::memory_order_release);
+            m_overflow.clear();
+        }
+        return n;
+    }
+
+    std::atomic<uint64_t> overflowed{ 0 };
+
+private:
+    MpscEventRing<Event, Tag> m_ring{ kRingSlots };
+    std::atomic<int> m_overflowCount{ 0 };
+    std::mutex m_mutex;
+    std::deque<Event> m_overflow;
+};
+
+struct ChannelResult {
+    LatencyStats enqueue; // Per-push cost seen by a worker
+    LatencyStats drain;   // Per-PollState drain on the UI thread
+    double totalMs = 0.0;
+    size_t delivered = 0;
+    size_t dropped = 0;
+};
+
+template<typename Channel>
+ChannelResult RunStorm(Channel& channel) {
+    const auto frame = std::make_shared<FakeFrame>();
+    const std::wstring path = L"D:\\Photos\\Panorama\\gigapixel_stitch_2026_03_14_final_export_v7.jpg";
+    constexpr int total = kProducers * kEventsPerProducer;
+
+    std::atomic<int> pushed{ 0 };
+    std::atomic<size_t> currentImage{ 1 };
+    std::vector<std::vector<double>> enqueueSamples(kProducers);
+
+    ChannelResult result;
+    Stopwatch wall;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            auto& samples = enqueueSamples[p];
+            samples.reserve(kEventsPerProducer / 16 + 1);
+            for (int i = 0; i < kEventsPerProducer; ++i) {
+                BurnMicros(kDecodeUs);
+                Event evt;
+                evt.type = (i % 16 == 15) ? 2 : 1; // Mostly tiles, some full frames
+                // Every other event was decoded for the image the user already left
+                evt.imageId = (i & 1) ? currentImage.load(std::memory_order_relaxed) : 0;
+                evt.filePath = path;
+                evt.rawFrame = frame;
+                evt.tileCoord = i;
+                if ((i & 15) == 0) {
+                    const Clock::time_point t0 = Clock::now();
+                    channel.Push(std::move(evt));
+                    samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+                } else {
+                    channel.Push(std::move(evt));
+                }
+                pushed.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    std::vector<Event> batch;
+    size_t consumed = 0;
+    while (consumed < (size_t)total) {
+        batch.clear();
+        Stopwatch drain;
+        consumed += channel.Drain(currentImage.load(), batch, &result.dropped);
+        result.drain.Add(drain.ElapsedMs());
+        result.delivered += batch.size();
+        DoNotOptimize(batch.data());
+        if (pushed.load(std::memory_order_relaxed) < total) std::this_thread::sleep_for(kDrainInterval);
+    }
+    result.totalMs = wall.ElapsedMs();
+    for (auto& t : producers) t.join();
+    for (int p = 0; p < kProducers; ++p) {
+        for (double v : enqueueSamples[p]) result.enqueue.Add(v);
+    }
+    return result;
+}
+
+void PrintRow(const char* name, const ChannelResult& r) {
+    const double total = (double)kProducers * kEventsPerProducer;
+    std::printf("%-12s %9.1f %9.1f %9.1f %9.1f %9.2f %9zu %9zu %8.0f\n", name,
+                r.enqueue.Percentile(50) * 1.0e6, r.enqueue.Percentile(99) * 1.0e6,
+                r.drain.Percentile(50) * 1000.0, r.drain.Percentile(99) * 1000.0,
+                total / (r.totalMs * 1000.0), r.delivered, r.dropped, r.totalMs);
+}
+
+} // namespace
+
+QV_BENCHMARK(ResultChannel, "8 workers publishing 400k tile results, half stale: mutex deque vs lock-free ring") {
+    std::printf("Workload: %d producers x %d events, drain every %lld us, ring %zu slots\n",
+                kProducers, kEventsPerProducer, (long long)kDrainInterval.count(), kRingSlots);
+    std::printf("%-12s %9s %9s %9s %9s %9s %9s %9s %8s\n", "Channel", "enq p50ns", "enq p99ns",
+                "drn p50us", "drn p99us", "Mevt/s", "Delivered", "Dropped", "Total ms");
+
+    for (int run = 0; run < opts.warmup + opts.iterations; ++run) {
+        const bool timed = run >= opts.warmup;
+
+        MutexChannel mutexChannel;
+        ChannelResult a = RunStorm(mutexChannel);
+
+        RingChannel ringChannel;
+        ChannelResult b = RunStorm(ringChannel);
+
+        if (timed) {
+            PrintRow("mutex deque", a);
+            PrintRow("mpsc ring", b);
+            std::printf("%-12s overflowed=%llu\n", "", (unsigned long long)ringChannel.overflowed.load());
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,289 @@
+/*
+ * QuickView Headless Benchmarks - Gallery thumbnail pool under scrolling
+ * Copyright (C) 2026-Present QuickView Contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#include "BenchHarness.h"
+#include "ThumbnailScheduler.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_set>
+
+namespace {
+
+using namespace QuickView::Bench;
+using QuickView::ThumbnailScheduler;
+using QuickView::ThumbTask;
+
+// ----------------------------------------------------------------------------
+// Synthetic folder: cost model per thumbnail kind (single-core milliseconds)
+// ----------------------------------------------------------------------------
+constexpr int kFolderSize = 4000;
+constexpr int kArchives = 4;
+constexpr double kFastMs = 2.0;     // JPEG DCT-scaled / RAW embedded preview
+constexpr double kSlowMs = 18.0;    // PNG / TIFF / AVIF full decode + resize
+constexpr double kArchiveMs = 4.0;  // Member of a solid archive
+
+struct Item {
+    bool fast;
+    bool archive;
+    int archiveIndex;
+    double costMs;
+};
+
+std::vector<Item> MakeFolder() {
+    std::vector<Item> items(kFolderSize);
+    uint32_t rng = 12345;
+    int archiveCounters[kArchives] = {};
+    for (int i = 0; i < kFolderSize; ++i) {
+        rng = rng * 1664525u + 1013904223u;
+        const uint32_t r = (rng >> 8) % 100;
+        Item& it = items[i];
+        it.archive = r < 15;
+        it.fast = it.archive || r < 70;
+        it.archiveIndex = it.archive ? archiveCounters[i % kArchives]++ : -1;
+        it.costMs = it.archive ? kArchiveMs : (it.fast ? kFastMs : kSlowMs);
+    }
+    return items;
+}
+
+// CPU-bound stand-in for a decode: dependent integer work over a cache-resident
+// scratch buffer, calibrated once so a "2 ms" thumbnail costs ~2 ms of one core.
+// Results land in the thread's scratch buffer, so the loop cannot be dropped.
+void BurnUnits(uint64_t units) {
+    thread_local std::vector<uint32_t> scratch(16384, 1u);
+    uint64_t acc = 0x9E3779B97F4A7C15ull;
+    for (uint64_t u = 0; u < units; ++u) {
+        for (size_t i = 0; i < scratch.size(); i += 16) {
+            acc ^= scratch[i] + (acc << 6) + (acc >> 2);
+            scratch[i] = (uint32_t)acc;
+        }
+    }
+}
+
+double CalibrateUnitsPerMs() {
+    BurnUnits(200);
+    Stopwatch sw;
+    constexpr uint64_t kUnits = 4000;
+    BurnUnits(kUnits);
+    return (double)kUnits / (std::max)(sw.ElapsedMs(), 1e-3);
+}
+
+// ----------------------------------------------------------------------------
+// Baseline: the old ThumbnailManager fast/slow thread pair
+// ----------------------------------------------------------------------------
+class TwoLanePool {
+public:
+    using Handler = std::function<void(ThumbTask&)>;
+
+    void Start(Handler handler) {
+        m_handler = std::move(handler);
+        m_running = true;
+        m_fastThread = std::thread([this] { Loop(m_fastQueue, m_cvFast); });
+        m_slowThread = std::thread([this] { Loop(m_slowQueue, m_cvSlow); });
+    }
+    void Stop() {
+        { std::lock_guard<std::mutex> lock(m_mutex); m_running = false; }
+        m_cvFast.notify_all();
+        m_cvSlow.notify_all();
+        if (m_fastThread.joinable()) m_fastThread.join();
+        if (m_slowThread.joinable()) m_slowThread.join();
+    }
+    void Push(ThumbTask task) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (task.isFastLane) { m_fastQueue.push(std::move(task)); m_cvFast.notify_one(); }
+        else { m_slowQueue.push(std::move(task)); m_cvSlow.notify_one(); }
+    }
+    void Clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fastQueue = Queue();
+        m_slowQueue = Queue();
+    }
+
+private:
+    using Queue = std::priority_queue<ThumbTask, std::vector<ThumbTask>, std::greater<ThumbTask>>;
+
+    void Loop(Queue& queue, std::condition_variable& cv) {
+        for (;;) {
+            ThumbTask task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                cv.wait(lock, [&] { return !queue.empty() || !m_running; });
+                if (!m_running) return;
+                task = queue.top();
+                queue.pop();
+            }
+            m_handler(task);
+        }
+    }
+
+    Handler m_handler;
+    std::mutex m_mutex;
+    std::condition_variable m_cvFast;
+    std::condition_variable m_cvSlow;
+    Queue m_fastQueue;
+    Queue m_slowQueue;
+    std::thread m_fastThread;
+    std::thread m_slowThread;
+    bool m_running = false;
+};
+
+class StealingPool {
+public:
+    explicit StealingPool(int workers) : m_workers(workers) {}
+    void Start(ThumbnailScheduler::Handler handler) { m_pool.Start(m_workers, std::move(handler)); }
+    void Stop() { m_pool.Stop(); }
+    void Push(ThumbTask task) { m_pool.Push(std::move(task)); }
+    void Clear() { m_pool.Clear(); }
+    uint64_t Stolen() const { return m_pool.GetStats().stolen; }
+private:
+    ThumbnailScheduler m_pool;
+    int m_workers;
+};
+
+// ----------------------------------------------------------------------------
+// Scroll driver: mirrors GalleryOverlay::Render -> ThumbnailManager::QueueRequest
+// ----------------------------------------------------------------------------
+struct ScrollResult {
+    double scrollMs = 0.0;
+    size_t completedDuringScroll = 0;
+    double settleMs = 0.0;          // Scroll stop -> last visible cell ready
+    LatencyStats visibleLatency;    // Cell first visible -> ready (cells ready before leaving view)
+};
+
+template<typename Pool>
+ScrollResult RunScroll(Pool& pool, const std::vector<Item>& folder, double unitsPerMs) {
+    constexpr int kColumns = 8;
+    constexpr int kVisible = kColumns * 6;
+    constexpr int kFrames = 150;                 // 2.5 s at 60 Hz
+    constexpr int kRowsPerFrame = 1;             // Steady wheel scroll: 8 new cells per frame
+    constexpr auto kFrame = std::chrono::microseconds(16667);
+
+    using Clock = std::chrono::steady_clock;
+    std::vector<std::atomic<bool>> ready(folder.size());
+    std::vector<Clock::time_point> firstVisible(folder.size());
+    std::vector<double> readyAt(folder.size(), -1.0);
+    std::mutex readyMutex;
+    std::atomic<uint64_t> generation{ 0 };
+    const Clock::time_point t0 = Clock::now();
+
+    pool.Start([&](ThumbTask& t) {
+        if (t.generation != generation.load()) return;
+        BurnUnits((uint64_t)(folder[t.imageId].costMs * unitsPerMs));
+        std::lock_guard<std::mutex> lock(readyMutex);
+        readyAt[t.imageId] = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        ready[t.imageId] = true;
+    });
+
+    std::unordered_set<size_t> pending;
+    auto renderFrame = [&](int firstCell) {
+        const int center = firstCell + kVisible / 2;
+        const Clock::time_point now = Clock::now();
+        for (int i = firstCell; i < firstCell + kVisible && i < (int)folder.size(); ++i) {
+            if (firstVisible[i] == Clock::time_point{}) firstVisible[i] = now;
+            if (ready[i] || pending.count(i)) continue;
+            const Item& it = folder[i];
+            ThumbTask t;
+            t.imageId = (size_t)i;
+            t.priorityDistance = std::abs(i - center);
+            t.isFastLane = it.fast;
+            t.generation = generation.load();
+            t.isArchive = it.archive;
+            t.archiveIndex = it.archiveIndex;
+            t.archivePathHash = it.archive ? (size_t)(i % kArchives) + 1 : 0;
+            pool.Push(std::move(t));
+            pending.insert(i);
+        }
+    };
+
+    ScrollResult result;
+    int firstCell = 0;
+    Clock::time_point frameStart = Clock::now();
+    for (int f = 0; f < kFrames; ++f) {
+        renderFrame(firstCell);
+        firstCell += kRowsPerFrame * kColumns;
+        frameStart += kFrame;
+        std::this_thread::sleep_until(frameStart);
+    }
+    result.scrollMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+    // Scroll stopped: keep rendering until the final viewport is filled
+    auto viewportReady = [&] {
+        for (int i = firstCell; i < firstCell + kVisible && i < (int)folder.size(); ++i) {
+            if (!ready[i]) return false;
+        }
+        return true;
+    };
+    Stopwatch settle;
+    while (!viewportReady() && settle.ElapsedMs() < 60000.0) {
+        renderFrame(firstCell);
+        std::this_thread::sleep_for(kFrame);
+    }
+    result.settleMs = settle.ElapsedMs();
+
+    // Gallery closes: ThumbnailManager::ClearQueue
+    generation++;
+    pool.Clear();
+    pool.Stop();
+
+    for (size_t i = 0; i < folder.size(); ++i) {
+        if (readyAt[i] < 0.0) continue;
+        if (readyAt[i] <= result.scrollMs) result.completedDuringScroll++;
+        const double visibleMs = std::chrono::duration<double, std::milli>(firstVisible[i] - t0).count();
+        result.visibleLatency.Add(readyAt[i] - visibleMs);
+    }
+    return result;
+}
+
+void PrintRow(const char* name, int workers, const ScrollResult& r) {
+    std::printf("%-14s %7d %10.0f %10.1f %10.1f %10.1f\n", name, workers,
+                r.completedDuringScroll * 1000.0 / r.scrollMs,
+                r.visibleLatency.Percentile(50), r.visibleLatency.Percentile(95), r.settleMs);
+}
+
+} // namespace
+
+QV_BENCHMARK(ThumbnailPool, "Gallery scroll over a synthetic 4000-item folder: thumbs/s and visible-cell latency, 2-lane vs work-stealing") {
+    const std::vector<Item> folder = MakeFolder();
+    const double unitsPerMs = CalibrateUnitsPerMs();
+    const int workers = opts.threads > 0 ? opts.threads : ThumbnailScheduler::DefaultWorkerCount();
+
+    std::printf("Folder: %d items (%.0f%% slow @ %.0f ms, %.0f%% fast @ %.0f ms, archives @ %.0f ms)\n",
+                kFolderSize, 30.0, kSlowMs, 55.0, kFastMs, kArchiveMs);
+    std::printf("%-14s %7s %10s %10s %10s %10s\n", "Pool", "Workers", "Thumbs/s", "p50 ms", "p95 ms", "Settle ms");
+
+    for (int run = 0; run < opts.warmup + opts.iterations; ++run) {
+        const bool timed = run >= opts.warmup;
+
+        TwoLanePool legacy;
+        ScrollResult a = RunScroll(legacy, folder, unitsPerMs);
+
+        StealingPool stealing(workers);
+        ScrollResult b = RunScroll(stealing, folder, unitsPerMs);
+
+        if (timed) {
+            PrintRow("fast/slow", 2, a);
+            PrintRow("work-stealing", workers, b);
+            std::printf("%-14s %7s stolen=%llu\n", "", "", (unsigned long long)stealing.Stolen());
+        }
+    }
+    return 0;
+}
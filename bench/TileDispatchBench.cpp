@@ -0,0 +1,324 @@
+/*
+ * QuickView Headless Benchmarks - HeavyLanePool tile dispatch under panning
+ * Copyright (C) 2026-Present QuickView Contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#include "BenchHarness.h"
+#include "StealingJobQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace {
+
+using namespace QuickView::Bench;
+using QuickView::StealingJobQueue;
+using Clock = std::chrono::steady_clock;
+
+// ----------------------------------------------------------------------------
+// Panning workload: mirrors ImageEngine::UpdateTitanTiles -> SubmitPriorityTileBatch
+// ----------------------------------------------------------------------------
+constexpr int kFrames = 250;
+constexpr int kTilesPerFrame = 40;       // 10k jobs in total
+constexpr int kVisiblePerFrame = 12;     // Viewport tiles; the rest is the preload ring
+constexpr auto kFrameInterval = std::chrono::microseconds(4000); // Fast drag
+constexpr double kDecodeUs = 60.0;       // Region decode stand-in per tile
+
+struct FakeMapping { std::vector<uint8_t> bytes = std::vector<uint8_t>(64); };
+
+// Old JobInfo payload: path + mapping copied into every job
+struct LegacyJob {
+    int id = 0;
+    int priority = 0;
+    std::wstring path;
+    std::shared_ptr<FakeMapping> mmf;
+    bool operator<(const LegacyJob& other) const { return priority < other.priority; }
+};
+
+struct ImageContext {
+    std::wstring path;
+    std::shared_ptr<FakeMapping> mmf;
+};
+
+struct Job {
+    int id = 0;
+    int priority = 0;
+    bool critical = false;
+    std::shared_ptr<const ImageContext> image;
+};
+
+void BurnMicros(double us) {
+    const Clock::time_point end = Clock::now() + std::chrono::nanoseconds((int64_t)(us * 1000.0));
+    while (Clock::now() < end) {}
+}
+
+// Lock acquisition that counts waits, like StealingJobQueue::Lock
+std::unique_lock<std::mutex> CountedLock(std::mutex& m, std::atomic<uint64_t>& contended) {
+    std::unique_lock<std::mutex> lock(m, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        contended.fetch_add(1, std::memory_order_relaxed);
+        lock.lock();
+    }
+    return lock;
+}
+
+// ----------------------------------------------------------------------------
+// Baseline: one vector heap under one mutex (pre-change HeavyLanePool)
+// ----------------------------------------------------------------------------
+class LegacyPool {
+public:
+    explicit LegacyPool(int workers) : m_workers(workers) {}
+    std::atomic<uint64_t> contended{ 0 };
+
+    void Start(std::function<void(int id)> run) {
+        m_run = std::move(run);
+        m_running = true;
+        for (int i = 0; i < m_workers; ++i) m_threads.emplace_back([this] { Loop(); });
+    }
+    void Stop() {
+        { std::lock_guard<std::mutex> lock(m_mutex); m_running = false; }
+        m_cv.notify_all();
+        for (auto& t : m_threads) t.join();
+        m_threads.clear();
+    }
+    // Returns the time spent holding the pool lock
+    double SubmitBatch(const std::wstring& path, const std::shared_ptr<FakeMapping>& mmf,
+                       const std::vector<std::pair<int, int>>& batch) {
+        std::unique_lock<std::mutex> lock = CountedLock(m_mutex, contended);
+        Stopwatch held;
+        m_jobs.reserve(m_jobs.size() + batch.size());
+        for (const auto& [id, priority] : batch) {
+            LegacyJob job;
+            job.id = id;
+            job.priority = priority;
+            job.path = path;
+            job.mmf = mmf;
+            m_jobs.push_back(job);
+        }
+        std::make_heap(m_jobs.begin(), m_jobs.end());
+        const double ms = held.ElapsedMs();
+        lock.unlock();
+        m_cv.notify_all();
+        return ms;
+    }
+    LatencyStats popHold;
+
+private:
+    void Loop() {
+        std::vector<double> localHold;
+        for (;;) {
+            LegacyJob job;
+            {
+                std::unique_lock<std::mutex> lock = CountedLock(m_mutex, contended);
+                m_cv.wait(lock, [&] { return !m_jobs.empty() || !m_running; });
+                if (!m_running) break;
+                Stopwatch held;
+                std::pop_heap(m_jobs.begin(), m_jobs.end());
+                job = m_jobs.back();
+                m_jobs.pop_back();
+                localHold.push_back(held.ElapsedMs());
+            }
+            m_run(job.id);
+        }
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        for (double v : localHold) popHold.Add(v);
+    }
+
+    int m_workers;
+    std::function<void(int)> m_run;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<LegacyJob> m_jobs;
+    std::vector<std::thread> m_threads;
+    std::mutex m_statsMutex;
+    bool m_running = false;
+};
+
+// ----------------------------------------------------------------------------
+// New: StealingJobQueue + pool lock used only for sleeping
+// ----------------------------------------------------------------------------
+class StealingPool {
+public:
+    explicit StealingPool(int workers) : m_queue(workers), m_workers(workers) {}
+
+    void Start(std::function<void(int id)> run) {
+        m_run = std::move(run);
+        m_running = true;
+        for (int i = 0; i < m_workers; ++i) m_threads.emplace_back([this, i] { Loop(i); });
+    }
+    void Stop() {
+        { std::lock_guard<std::mutex> lock(m_mutex); m_running = false; }
+        m_cv.notify_all();
+        for (auto& t : m_threads) t.join();
+        m_threads.clear();
+    }
+    // Returns the time spent in the queue's locks (upper bound: whole PushBatch)
+    double SubmitBatch(const std::shared_ptr<const ImageContext>& image,
+                       const std::vector<std::pair<int, int>>& batch, int visible) {
+        m_scratch.clear();
+        for (size_t i = 0; i < batch.size(); ++i) {
+            Job& job = m_scratch.emplace_back();
+            job.id = batch[i].first;
+            job.priority = batch[i].second;
+            job.critical = (int)i < visible;
+            job.image = image;
+        }
+        Stopwatch held;
+        m_queue.PushBatch(m_scratch);
+        const double ms = held.ElapsedMs();
+        { std::lock_guard<std::mutex> lock(m_mutex); }
+        m_cv.notify_all();
+        return ms;
+    }
+    StealingJobQueue<Job>::Stats Stats() const { return m_queue.GetStats(); }
+    LatencyStats popHold;
+
+private:
+    void Loop(int self) {
+        std::vector<double> localHold;
+        for (;;) {
+            Job job;
+            Stopwatch held;
+            if (m_queue.TryPop(self, &job)) {
+                localHold.push_back(held.ElapsedMs());
+                m_run(job.id);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [&] { return !m_queue.Empty() || !m_running; });
+            if (!m_running) break;
+        }
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        for (double v : localHold) popHold.Add(v);
+    }
+
+    StealingJobQueue<Job> m_queue;
+    int m_workers;
+    std::function<void(int)> m_run;
+    std::vector<Job> m_scratch;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<std::thread> m_threads;
+    std::mutex m_statsMutex;
+    bool m_running = false;
+};
+
+struct PanResult {
+    LatencyStats visibleDispatch; // Submit -> worker start, viewport tiles
+    LatencyStats ringDispatch;    // Submit -> worker start, preload ring
+    LatencyStats submitHold;
+    double totalMs = 0.0;
+};
+
+// Center-out priorities with a penalty for the ring, as in UpdateTitanTiles
+std::vector<std::pair<int, int>> MakeFrameBatch(int frame) {
+    std::vector<std::pair<int, int>> batch;
+    for (int i = 0; i < kTilesPerFrame; ++i) {
+        const int id = frame * kTilesPerFrame + i;
+        int priority = -(i * i * 4096);
+        if (i >= kVisiblePerFrame) priority -= 100000000;
+        batch.push_back({ id, priority });
+    }
+    return batch;
+}
+
+template<typename Pool, typename SubmitFn>
+PanResult RunPan(Pool& pool, SubmitFn submit) {
+    const int total = kFrames * kTilesPerFrame;
+    std::vector<Clock::time_point> submitted(total);
+    std::vector<Clock::time_point> started(total);
+    std::atomic<int> done{ 0 };
+
+    pool.Start([&](int id) {
+        started[id] = Clock::now();
+        BurnMicros(kDecodeUs);
+        done.fetch_add(1, std::memory_order_release);
+    });
+
+    PanResult result;
+    Stopwatch wall;
+    Clock::time_point next = Clock::now();
+    for (int f = 0; f < kFrames; ++f) {
+        const auto batch = MakeFrameBatch(f);
+        const Clock::time_point now = Clock::now();
+        for (const auto& item : batch) submitted[item.first] = now;
+        result.submitHold.Add(submit(batch));
+        next += kFrameInterval;
+        std::this_thread::sleep_until(next);
+    }
+    while (done.load(std::memory_order_acquire) < total && wall.ElapsedMs() < 60000.0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    result.totalMs = wall.ElapsedMs();
+    pool.Stop();
+
+    for (int id = 0; id < total; ++id) {
+        const double ms = std::chrono::duration<double, std::milli>(started[id] - submitted[id]).count();
+        if (id % kTilesPerFrame < kVisiblePerFrame) result.visibleDispatch.Add(ms);
+        else result.ringDispatch.Add(ms);
+    }
+    return result;
+}
+
+void PrintRow(const char* name, const PanResult& r, const LatencyStats& popHold, uint64_t contended) {
+    std::printf("%-14s %9.2f %9.2f %9.2f %9.1f %9.1f %9.2f %10llu %8.0f\n", name,
+                r.visibleDispatch.Percentile(50), r.visibleDispatch.Percentile(99),
+                r.ringDispatch.Percentile(50),
+                r.submitHold.Percentile(50) * 1000.0, r.submitHold.Percentile(99) * 1000.0,
+                popHold.Percentile(99) * 1000.0, (unsigned long long)contended, r.totalMs);
+}
+
+} // namespace
+
+QV_BENCHMARK(TileDispatch, "10k tile jobs submitted while panning: dispatch latency and queue lock hold time, single heap vs work-stealing") {
+    const int workers = opts.threads > 0 ? opts.threads : (std::max)(2, (int)std::thread::hardware_concurrency() - 1);
+    const std::wstring path = L"D:\\Photos\\Panorama\\gigapixel_stitch_2026_03_14_final_export_v7.jpg";
+    const auto mmf = std::make_shared<FakeMapping>();
+    const auto image = std::make_shared<const ImageContext>(ImageContext{ path, mmf });
+
+    std::printf("Workload: %d frames x %d tiles (%d visible), %.0f us/tile, %d workers\n",
+                kFrames, kTilesPerFrame, kVisiblePerFrame, kDecodeUs, workers);
+    std::printf("%-14s %9s %9s %9s %9s %9s %9s %10s %8s\n", "Queue", "vis p50ms", "vis p99ms", "ring p50ms",
+                "sub p50us", "sub p99us", "pop p99us", "Contended", "Total ms");
+
+    for (int run = 0; run < opts.warmup + opts.iterations; ++run) {
+        const bool timed = run >= opts.warmup;
+
+        LegacyPool legacy(workers);
+        PanResult a = RunPan(legacy, [&](const std::vector<std::pair<int, int>>& batch) {
+            return legacy.SubmitBatch(path, mmf, batch);
+        });
+
+        StealingPool stealing(workers);
+        PanResult b = RunPan(stealing, [&](const std::vector<std::pair<int, int>>& batch) {
+            return stealing.SubmitBatch(image, batch, kVisiblePerFrame);
+        });
+
+        if (timed) {
+            PrintRow("single heap", a, legacy.popHold, legacy.contended.load());
+            PrintRow("work-stealing", b, stealing.popHold, stealing.Stats().contended);
+            const auto s = stealing.Stats();
+            std::printf("%-14s injected=%llu dealt=%llu overflow=%llu stolen=%llu\n", "",
+                        (unsigned long long)s.injected, (unsigned long long)s.dealt,
+                        (unsigned long long)s.overflowed, (unsigned long long)s.stolen);
+        }
+    }
+    return 0;
+}
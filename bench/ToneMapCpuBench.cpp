@@ -0,0 +1,211 @@
+/*
+ * QuickView Headless Benchmarks - ComputeEngine tone mapping / gain-map composition on the CPU
+ * Copyright (C) 2026-Present QuickView Contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#include "BenchHarness.h"
+#include "ImageLoaderSimd.h"
+#include "ImageTypes.h"
+#include <bit>
+#include <cmath>
+
+namespace {
+
+using namespace QuickView::Bench;
+using QuickView::PixelFormat;
+
+// ----------------------------------------------------------------------------
+// 6000 x 4000 (24 MP) scene-linear FP16 frame peaking at 1000 nits, the
+// decode the RenderEngine fallback and SDR-target thumbnails hand to the CPU:
+// SDR output through the spline and BT.2390 curves, scRGB HDR output, and an
+// 8-bit Ultra HDR base composed with a quarter-resolution gain map.
+// ----------------------------------------------------------------------------
+constexpr int kW = 6000;
+constexpr int kH = 4000;
+
+// Scalar IEEE half conversions (XMConvertHalfToFloat / XMConvertFloatToHalf
+// semantics, without DirectXMath so the bench also builds off Windows)
+float HalfToFloat(uint16_t h) {
+    const uint32_t sign = static_cast<uint32_t>(h & 0x8000u) << 16;
+    const uint32_t exp = (h >> 10) & 0x1Fu;
+    uint32_t mant = h & 0x3FFu;
+    uint32_t bits;
+    if (exp == 0x1F) {
+        bits = sign | 0x7F800000u | (mant << 13);
+    } else if (exp != 0) {
+        bits = sign | ((exp + 112) << 23) | (mant << 13);
+    } else if (mant == 0) {
+        bits = sign;
+    } else {
+        // Subnormal: normalise the mantissa
+        uint32_t e = 0;
+        while (!(mant & 0x400u)) { mant <<= 1; ++e; }
+        bits = sign | ((113 - e) << 23) | ((mant & 0x3FFu) << 13);
+    }
+    return std::bit_cast<float>(bits);
+}
+
+uint16_t FloatToHalf(float f) {
+    const uint32_t bits = std::bit_cast<uint32_t>(f);
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    const int exp = static_cast<int>((bits >> 23) & 0xFFu) - 127 + 15;
+    if (exp >= 31) return static_cast<uint16_t>(sign | 0x7C00u);
+    if (exp <= 0) return static_cast<uint16_t>(sign); // The frame never goes below 2^-14
+    uint32_t h = sign | (static_cast<uint32_t>(exp) << 10) | ((bits >> 13) & 0x3FFu);
+    const uint32_t rest = bits & 0x1FFFu;
+    if (rest > 0x1000u || (rest == 0x1000u && (h & 1u))) ++h; // Round to nearest even
+    return static_cast<uint16_t>(h);
+}
+
+std::vector<uint16_t> MakeHdrFrame() {
+    std::vector<uint16_t> v(static_cast<size_t>(kW) * kH * 4);
+    uint32_t seed = 7;
+    for (int y = 0; y < kH; ++y) {
+        for (int x = 0; x < kW; ++x) {
+            seed = seed * 1664525u + 1013904223u;
+            // Diagonal ramp to 12.5 (1000 nits) with per-channel tint and noise
+            const float base = 12.5f * static_cast<float>(x + y) / static_cast<float>(kW + kH);
+            uint16_t* p = &v[(static_cast<size_t>(y) * kW + x) * 4];
+            for (int c = 0; c < 3; ++c) {
+                const float noise = static_cast<float>((seed >> (8 * c)) & 255) / 2048.0f;
+                p[c] = FloatToHalf(base * (0.7f + 0.15f * c) + noise);
+            }
+            p[3] = FloatToHalf(1.0f);
+        }
+    }
+    return v;
+}
+
+QuickView::ToneMapSettings MakeSettings(uint32_t mode, bool hdrOutput) {
+    QuickView::ToneMapSettings s{};
+    s.contentPeakScRgb = 12.5f;
+    s.displayPeakScRgb = hdrOutput ? 600.0f / 80.0f : 203.0f / 80.0f;
+    s.paperWhiteScRgb = s.displayPeakScRgb;
+    s.realHardwarePeakScRgb = s.displayPeakScRgb;
+    s.exposure = 1.0f;
+    s.exposureGain = 1.0f;
+    s.mode = mode;
+    s.isHdrOutput = hdrOutput ? 1 : 0;
+    s.transferFunction = 2; // Linear
+    s.desatThreshold = 0.18f;
+    s.desatStrength = 0.75f;
+    s.colorMatrix[0] = s.colorMatrix[5] = s.colorMatrix[10] = s.colorMatrix[15] = 1.0f;
+    if (mode == 0) ImageLoaderSimd::FitSplineToneCurve(s, 0.0f);
+    return s;
+}
+
+// Before: RenderEngine's CPU fallback, max-channel Reinhard Extended and a
+// per-channel pow per pixel
+uint8_t EncodeSdr8(float value) {
+    value = (value > 0.0f) ? value : 0.0f;
+    value = (value <= 0.0031308f) ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+    value = (value < 0.0f) ? 0.0f : (value > 1.0f ? 1.0f : value);
+    return static_cast<uint8_t>(value * 255.0f + 0.5f);
+}
+
+void ReinhardLoop(const uint16_t* src, uint8_t* dst, int width, float lwhite) {
+    for (int x = 0; x < width; ++x) {
+        const float r = HalfToFloat(src[x * 4 + 0]);
+        const float g = HalfToFloat(src[x * 4 + 1]);
+        const float b = HalfToFloat(src[x * 4 + 2]);
+        const float a = HalfToFloat(src[x * 4 + 3]);
+        const float l = (r > g) ? (r > b ? r : b) : (g > b ? g : b);
+        const float scale = l > 0.0f ? (1.0f + l / (lwhite * lwhite)) / (1.0f + l) : 0.0f;
+        dst[x * 4 + 0] = EncodeSdr8(b * scale * a);
+        dst[x * 4 + 1] = EncodeSdr8(g * scale * a);
+        dst[x * 4 + 2] = EncodeSdr8(r * scale * a);
+        dst[x * 4 + 3] = static_cast<uint8_t>(a * 255.0f + 0.5f);
+    }
+}
+
+} // namespace
+
+QV_BENCHMARK(ToneMapCpu, "24 MP FP16 frame through the ComputeEngine tone-map / gain-map math on the CPU: per-pixel loop vs SIMD rows vs threaded frame") {
+    const size_t pixels = static_cast<size_t>(kW) * kH;
+    const std::vector<uint16_t> hdr = MakeHdrFrame();
+    const uint8_t* src = reinterpret_cast<const uint8_t*>(hdr.data());
+    const int srcStride = kW * 8;
+
+    // Ultra HDR: sRGB base plus a 1500 x 1000 gain map
+    const int gainW = kW / 4, gainH = kH / 4;
+    std::vector<uint8_t> sdrBase(pixels * 4), gainMap(static_cast<size_t>(gainW) * gainH);
+    for (size_t i = 0; i < sdrBase.size(); ++i) sdrBase[i] = static_cast<uint8_t>((i / 97) ^ (i >> 13));
+    for (size_t i = 0; i < gainMap.size(); ++i) gainMap[i] = static_cast<uint8_t>(i * 31 / 7);
+    QuickView::GpuShaderPayload payload;
+    for (int c = 0; c < 3; ++c) {
+        payload.gainMapMin[c] = 0.0f;
+        payload.gainMapMax[c] = 3.0f;
+        payload.gamma[c] = 1.0f;
+        payload.offsetSdr[c] = payload.offsetHdr[c] = 1.0f / 64.0f;
+    }
+    payload.hdrCapacityMin = 0.0f;
+    payload.hdrCapacityMax = 3.0f;
+    payload.targetHeadroom = 2.0f;
+
+    const char* const cases[] = { "SDR spline", "SDR BT.2390", "HDR scRGB", "Gain map" };
+    const char* const methods[] = { "Loop (before)", "SIMD rows", "SIMD threaded" };
+
+    std::vector<uint8_t> out[3];
+    for (auto& o : out) o.resize(pixels * 8);
+
+    std::printf("Target: %s\n", ImageLoaderSimd::GetActiveTargetName());
+    std::printf("%-12s %-14s %10s %10s %10s %8s\n", "Case", "Method", "p50 ms", "p95 ms", "MP/s", "Exact");
+
+    for (int ci = 0; ci < 4; ++ci) {
+        const bool sdr = ci < 2;
+        const QuickView::ToneMapSettings s = MakeSettings(ci == 1 ? 2 : 0, ci == 2);
+        for (int method = 0; method < 3; ++method) {
+            // The old fallback only had an SDR curve; the gain map samples
+            // vertically across rows, so it only runs as a whole frame
+            if ((method == 0 && !sdr) || (ci == 3 && method != 2)) continue;
+            LatencyStats lat;
+            for (int run = 0; run < opts.warmup + opts.iterations; ++run) {
+                uint8_t* dst = out[method].data();
+                Stopwatch sw;
+                if (ci == 3) {
+                    ImageLoaderSimd::ComposeGainMap(sdrBase.data(), kW * 4, PixelFormat::BGRA8888, kW, kH,
+                                                    gainMap.data(), gainW, gainH, gainW, payload,
+                                                    reinterpret_cast<uint16_t*>(dst), kW * 8);
+                } else if (method == 2) {
+                    if (sdr) ImageLoaderSimd::ToneMapHdrToSdr(src, srcStride, PixelFormat::R16G16B16A16_FLOAT, dst, kW * 4, kW, kH, s);
+                    else ImageLoaderSimd::ToneMapHdrToHdr(src, srcStride, PixelFormat::R16G16B16A16_FLOAT,
+                                                          reinterpret_cast<uint16_t*>(dst), kW * 8, kW, kH, s);
+                } else {
+                    const int dstStride = sdr ? kW * 4 : kW * 8;
+                    for (int y = 0; y < kH; ++y) {
+                        const uint8_t* row = src + static_cast<size_t>(y) * srcStride;
+                        uint8_t* dstRow = dst + static_cast<size_t>(y) * dstStride;
+                        if (method == 0) ReinhardLoop(reinterpret_cast<const uint16_t*>(row), dstRow, kW, s.displayPeakScRgb);
+                        else if (sdr) ImageLoaderSimd::ToneMapHdrToSdr(row, srcStride, PixelFormat::R16G16B16A16_FLOAT, dstRow, dstStride, kW, 1, s);
+                        else ImageLoaderSimd::ToneMapHdrToHdr(row, srcStride, PixelFormat::R16G16B16A16_FLOAT,
+                                                              reinterpret_cast<uint16_t*>(dstRow), dstStride, kW, 1, s);
+                    }
+                }
+                const double ms = sw.ElapsedMs();
+                DoNotOptimize(dst);
+                if (run >= opts.warmup) lat.Add(ms);
+            }
+            const double p50 = lat.Percentile(50);
+            // Threaded bands must reproduce the single-row output byte for byte;
+            // the old loop ran a different curve
+            const char* exact = (method == 2 && ci != 3) ? (out[1] == out[2] ? "yes" : "NO") : "-";
+            std::printf("%-12s %-14s %10.2f %10.2f %10.1f %8s\n", cases[ci], methods[method], p50,
+                        lat.Percentile(95), p50 > 0.0 ? MegaPixels(static_cast<int64_t>(pixels)) / (p50 / 1000.0) : 0.0, exact);
+        }
+    }
+    return 0;
+}
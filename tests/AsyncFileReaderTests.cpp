@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "MappedFile.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+// Async chunked MappedFile fill: watermark, batching and both reader backends
+
+using QuickView::AsyncFileReader;
+using QuickView::AsyncReadRequest;
+using QuickView::MappedFile;
+
+namespace {
+
+class TempFile {
+public:
+    TempFile(const char* name, size_t size) : m_bytes(size) {
+        std::mt19937 rng(static_cast<uint32_t>(size));
+        for (auto& b : m_bytes) b = static_cast<uint8_t>(rng());
+        m_path = std::filesystem::temp_directory_path() / name;
+        std::ofstream(m_path, std::ios::binary).write(reinterpret_cast<const char*>(m_bytes.data()), m_bytes.size());
+    }
+    ~TempFile() { std::error_code ec; std::filesystem::remove(m_path, ec); }
+
+    std::wstring Path() const { return m_path.wstring(); }
+    const std::vector<uint8_t>& Bytes() const { return m_bytes; }
+
+private:
+    std::filesystem::path m_path;
+    std::vector<uint8_t> m_bytes;
+};
+
+// Holds requests until the test completes them, in whatever order it likes
+class ManualReader final : public AsyncFileReader {
+public:
+    Backend GetBackend() const override { return Backend::ThreadPool; }
+    void Submit(const AsyncReadRequest* requests, size_t count) override {
+        submitCalls++;
+        pending.insert(pending.end(), requests, requests + count);
+    }
+    void Complete(size_t i, bool truncate = false) {
+        const AsyncReadRequest& req = pending[i];
+        size_t got = QuickView::ReadFileAt(req.file, req.offset, req.dst, req.length);
+        if (truncate) got /= 2;
+        req.onComplete(req.ctx, req, got);
+    }
+
+    std::vector<AsyncReadRequest> pending;
+    int submitCalls = 0;
+};
+
+void ExpectContent(const MappedFile& file, const TempFile& src) {
+    ASSERT_TRUE(file.IsValid());
+    ASSERT_EQ(file.size(), src.Bytes().size());
+    EXPECT_EQ(std::memcmp(file.data(), src.Bytes().data(), file.size()), 0);
+    EXPECT_TRUE(file.IsComplete());
+}
+
+} // namespace
+
+TEST(AsyncFileReaderTest, WatermarkAdvancesOverContiguousPrefix) {
+    const size_t size = MappedFile::kHeadChunk + 2 * MappedFile::kChunkSize + 1000;
+    TempFile src("qv_async_watermark.bin", size);
+    ManualReader reader;
+    MappedFile file(src.Path(), MappedFile::LoadMode::Async, &reader);
+
+    ASSERT_TRUE(file.IsOpen());
+    ASSERT_EQ(reader.pending.size(), 4u); // 64 KB head + 1 MB + 1 MB + tail
+    EXPECT_EQ(reader.pending[0].length, MappedFile::kHeadChunk);
+    EXPECT_EQ(reader.pending[3].length, 1000u);
+    EXPECT_EQ(file.BytesAvailable(), 0u);
+
+    reader.Complete(2); // Out of order: a hole at the front holds the watermark
+    EXPECT_EQ(file.BytesAvailable(), 0u);
+    reader.Complete(0);
+    EXPECT_EQ(file.BytesAvailable(), MappedFile::kHeadChunk);
+    EXPECT_EQ(std::memcmp(file.PartialData(), src.Bytes().data(), MappedFile::kHeadChunk), 0);
+    reader.Complete(1);
+    EXPECT_EQ(file.BytesAvailable(), MappedFile::kHeadChunk + 2 * MappedFile::kChunkSize);
+    EXPECT_FALSE(file.IsComplete());
+    reader.Complete(3);
+    EXPECT_EQ(file.WaitForBytes(size), size);
+    ExpectContent(file, src);
+}
+
+TEST(AsyncFileReaderTest, ShortReadInvalidatesLikeBlockingFailure) {
+    TempFile src("qv_async_short.bin", MappedFile::kHeadChunk + 4096);
+    ManualReader reader;
+    MappedFile file(src.Path(), MappedFile::LoadMode::Async, &reader);
+    ASSERT_EQ(reader.pending.size(), 2u);
+
+    reader.Complete(0);
+    reader.Complete(1, /*truncate*/ true);
+    EXPECT_TRUE(file.HasReadError());
+    EXPECT_TRUE(file.IsComplete());
+    EXPECT_EQ(file.BytesAvailable(), MappedFile::kHeadChunk);
+    EXPECT_FALSE(file.IsValid());
+    EXPECT_EQ(file.data(), nullptr);
+}
+
+TEST(AsyncFileReaderTest, ReadaheadWindowIsOneBatch) {
+    TempFile a("qv_async_ra_a.bin", 300 * 1024);
+    TempFile b("qv_async_ra_b.bin", 10);
+    TempFile c("qv_async_ra_c.bin", 2 * 1024 * 1024);
+    ManualReader reader;
+
+    auto files = MappedFile::OpenReadahead(
+        { a.Path(), L"qv_async_missing_file.bin", b.Path(), c.Path() }, reader);
+    ASSERT_EQ(files.size(), 4u);
+    EXPECT_EQ(files[1], nullptr);
+    EXPECT_EQ(reader.submitCalls, 1);
+    EXPECT_EQ(reader.pending.size(), 2u + 1u + 3u);
+    EXPECT_TRUE(files[0]->IsBuffered()); // Prefetch jobs decode straight from the buffer
+
+    for (size_t i = reader.pending.size(); i-- > 0;) reader.Complete(i);
+    ExpectContent(*files[0], a);
+    ExpectContent(*files[2], b);
+    ExpectContent(*files[3], c);
+}
+
+TEST(AsyncFileReaderTest, ThreadPoolBackendFillsFile) {
+    TempFile src("qv_async_pool.bin", 5 * 1024 * 1024 + 123);
+    auto reader = AsyncFileReader::CreateThreadPool(3);
+    ASSERT_EQ(reader->GetBackend(), AsyncFileReader::Backend::ThreadPool);
+
+    for (int round = 0; round < 4; ++round) {
+        MappedFile file(src.Path(), MappedFile::LoadMode::Async, reader.get());
+        EXPECT_GE(file.WaitForBytes(MappedFile::kHeadChunk), MappedFile::kHeadChunk);
+        ExpectContent(file, src);
+    }
+
+    // Destroyed while reads are still queued: the destructor waits for them
+    for (int i = 0; i < 8; ++i) MappedFile(src.Path(), MappedFile::LoadMode::Async, reader.get());
+}
+
+TEST(AsyncFileReaderTest, IoUringBackendFillsFile) {
+    auto reader = AsyncFileReader::CreateIoUring(8);
+    if (!reader) GTEST_SKIP() << "io_uring not available on this host";
+    ASSERT_EQ(reader->GetBackend(), AsyncFileReader::Backend::IoUring);
+
+    // More chunks than the queue depth: the overflow waits inside the backend
+    TempFile a("qv_async_uring_a.bin", 20 * 1024 * 1024 + 7);
+    TempFile b("qv_async_uring_b.bin", 40 * 1024);
+    auto files = MappedFile::OpenReadahead({ a.Path(), b.Path() }, *reader);
+    ExpectContent(*files[0], a);
+    ExpectContent(*files[1], b);
+}
+
+TEST(AsyncFileReaderTest, BlockingModeUnchanged) {
+    TempFile src("qv_async_blocking.bin", 777777);
+    MappedFile file(src.Path());
+    EXPECT_EQ(file.BytesAvailable(), file.size());
+    ExpectContent(file, src);
+
+    MappedFile missing(L"qv_async_missing_file.bin");
+    EXPECT_FALSE(missing.IsValid());
+    EXPECT_EQ(missing.size(), 0u);
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include "ImageLoaderSimd.h"
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Codec row conversions (CMYK, gray, palette, 16-to-8, PSD planes) against per-pixel loops
+
+namespace {
+
+// Odd widths leave scalar tails behind every vector width
+const int kWidths[] = { 1, 3, 15, 16, 17, 31, 64, 67, 255, 1001 };
+
+std::vector<uint8_t> RandomBytes(size_t n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> v(n);
+    for (auto& b : v) b = static_cast<uint8_t>(rng());
+    return v;
+}
+
+uint8_t PsdSample(const uint8_t* p) {
+    uint32_t v = (static_cast<uint32_t>(p[0]) << 8) | p[1];
+    if (v > 32768) v = 32768;
+    return static_cast<uint8_t>((v * 255 + 16384) / 32768);
+}
+
+} // namespace
+
+TEST(CodecConvertTests, CmykMatchesExactDivision) {
+    for (int samples : { 4, 5 }) {
+        for (int w : kWidths) {
+            const auto src = RandomBytes(static_cast<size_t>(w) * samples, w * 3 + samples);
+            std::vector<uint8_t> got(static_cast<size_t>(w) * 4, 0xCD);
+            ImageLoaderSimd::CmykToBgra(src.data(), samples, got.data(), w);
+            for (int x = 0; x < w; ++x) {
+                const uint8_t* p = &src[static_cast<size_t>(x) * samples];
+                const int invK = 255 - p[3];
+                const uint8_t want[4] = {
+                    static_cast<uint8_t>(((255 - p[2]) * invK + 127) / 255),
+                    static_cast<uint8_t>(((255 - p[1]) * invK + 127) / 255),
+                    static_cast<uint8_t>(((255 - p[0]) * invK + 127) / 255), 255 };
+                ASSERT_EQ(std::memcmp(&got[static_cast<size_t>(x) * 4], want, 4), 0)
+                    << "samples " << samples << " width " << w << " x " << x;
+            }
+        }
+    }
+}
+
+TEST(CodecConvertTests, CmykCoversEveryInkPair) {
+    // All (ink, K) combinations: the vector rounding must agree with / 255 everywhere
+    std::vector<uint8_t> src(256 * 256 * 4);
+    for (int k = 0; k < 256; ++k) {
+        for (int c = 0; c < 256; ++c) {
+            uint8_t* p = &src[(static_cast<size_t>(k) * 256 + c) * 4];
+            p[0] = static_cast<uint8_t>(c);
+            p[1] = static_cast<uint8_t>(255 - c);
+            p[2] = static_cast<uint8_t>(c ^ 0x5A);
+            p[3] = static_cast<uint8_t>(k);
+        }
+    }
+    std::vector<uint8_t> got(src.size());
+    ImageLoaderSimd::CmykToBgra(src.data(), 4, got.data(), 256 * 256);
+    for (size_t i = 0; i < 256 * 256; ++i) {
+        const uint8_t* p = &src[i * 4];
+        const int invK = 255 - p[3];
+        ASSERT_EQ(got[i * 4 + 2], ((255 - p[0]) * invK + 127) / 255) << i;
+        ASSERT_EQ(got[i * 4 + 1], ((255 - p[1]) * invK + 127) / 255) << i;
+        ASSERT_EQ(got[i * 4 + 0], ((255 - p[2]) * invK + 127) / 255) << i;
+    }
+}
+
+TEST(CodecConvertTests, GrayReplicatesAndInverts) {
+    for (int samples : { 1, 2, 3 }) {
+        for (bool invert : { false, true }) {
+            for (int w : kWidths) {
+                const auto src = RandomBytes(static_cast<size_t>(w) * samples, w + samples * 13);
+                std::vector<uint8_t> got(static_cast<size_t>(w) * 4, 0xCD);
+                ImageLoaderSimd::GrayToBgra(src.data(), samples, got.data(), w, invert);
+                for (int x = 0; x < w; ++x) {
+                    const uint8_t* p = &src[static_cast<size_t>(x) * samples];
+                    const uint8_t v = invert ? static_cast<uint8_t>(255 - p[0]) : p[0];
+                    const uint8_t want[4] = { v, v, v, samples > 1 ? p[1] : static_cast<uint8_t>(255) };
+                    ASSERT_EQ(std::memcmp(&got[static_cast<size_t>(x) * 4], want, 4), 0)
+                        << "samples " << samples << " invert " << invert << " width " << w << " x " << x;
+                }
+            }
+        }
+    }
+}
+
+TEST(CodecConvertTests, PaletteLooksUpPackedEntries) {
+    const auto entries = RandomBytes(256 * 4, 77);
+    uint32_t palette[256];
+    std::memcpy(palette, entries.data(), sizeof(palette));
+    for (int w : kWidths) {
+        const auto idx = RandomBytes(static_cast<size_t>(w), w * 5);
+        std::vector<uint8_t> got(static_cast<size_t>(w) * 4, 0xCD);
+        ImageLoaderSimd::PaletteToBgra(idx.data(), palette, got.data(), w);
+        for (int x = 0; x < w; ++x) {
+            ASSERT_EQ(std::memcmp(&got[static_cast<size_t>(x) * 4], &entries[idx[x] * 4u], 4), 0)
+                << "width " << w << " x " << x;
+        }
+    }
+}
+
+TEST(CodecConvertTests, Narrow16KeepsMostSignificantByte) {
+    for (bool bigEndian : { false, true }) {
+        for (int w : kWidths) {
+            const size_t n = static_cast<size_t>(w) * 3;
+            const auto src = RandomBytes(n * 2, w * 11 + bigEndian);
+            std::vector<uint8_t> got(n, 0xCD);
+            ImageLoaderSimd::Narrow16To8(src.data(), got.data(), n, bigEndian);
+            for (size_t i = 0; i < n; ++i) {
+                ASSERT_EQ(got[i], src[i * 2 + (bigEndian ? 0 : 1)]) << "width " << w << " i " << i;
+            }
+        }
+    }
+}
+
+TEST(CodecConvertTests, PlanarRowsInterleaveToBgra) {
+    for (int bps : { 1, 2 }) {
+        for (bool gray : { false, true }) {
+            for (bool alpha : { false, true }) {
+                for (int w : kWidths) {
+                    const size_t rowBytes = static_cast<size_t>(w) * bps;
+                    std::vector<uint8_t> rows[4];
+                    for (int c = 0; c < 4; ++c) rows[c] = RandomBytes(rowBytes, w * 17 + c * 3 + bps);
+                    if (bps == 2) {
+                        // Out-of-range values above 32768 must clamp to 255
+                        for (size_t i = 0; i < rowBytes; i += 2) rows[0][i] = static_cast<uint8_t>(rows[0][i] & 0x87);
+                    }
+                    const uint8_t* planes[4] = { rows[0].data(), rows[1].data(), rows[2].data(),
+                                                 alpha ? rows[3].data() : nullptr };
+                    if (gray) planes[1] = planes[2] = planes[0];
+
+                    std::vector<uint8_t> got(static_cast<size_t>(w) * 4, 0xCD);
+                    ImageLoaderSimd::PlanarToBgra(planes, bps, got.data(), w);
+                    for (int x = 0; x < w; ++x) {
+                        auto sample = [&](const uint8_t* p) { return bps == 2 ? PsdSample(p + x * 2) : p[x]; };
+                        const uint8_t want[4] = { sample(planes[2]), sample(planes[1]), sample(planes[0]),
+                                                  alpha ? sample(planes[3]) : static_cast<uint8_t>(255) };
+                        ASSERT_EQ(std::memcmp(&got[static_cast<size_t>(x) * 4], want, 4), 0)
+                            << "bps " << bps << " gray " << gray << " alpha " << alpha << " width " << w << " x " << x;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(CodecConvertTests, Psd16BitRangeEndpoints) {
+    const uint8_t row[] = { 0x00, 0x00, 0x40, 0x00, 0x80, 0x00, 0x80, 0x01, 0xFF, 0xFF };
+    const uint8_t* planes[4] = { row, row, row, row };
+    uint8_t got[5 * 4];
+    ImageLoaderSimd::PlanarToBgra(planes, 2, got, 5);
+    const uint8_t want[5] = { 0, 128, 255, 255, 255 };
+    for (int x = 0; x < 5; ++x) {
+        for (int c = 0; c < 4; ++c) EXPECT_EQ(got[x * 4 + c], want[x]) << "x " << x << " c " << c;
+    }
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include "ColdFrameCache.h"
+#include <cstring>
+#include <random>
+
+// Compressed second tier behind the decoded-frame cache: codec round trips,
+// promotion, budget eviction and the uncompressed hand-back
+
+using QuickView::ColdFrameCache;
+using QuickView::RawImageFrame;
+namespace FrameCodec = QuickView::FrameCodec;
+
+namespace {
+
+// Photo-like BGRA: gradients, flat areas (runs), a repeating palette (index hits),
+// noise (literals) and a translucent band (alpha changes)
+std::shared_ptr<RawImageFrame> MakeFrame(int w, int h, int stride, uint32_t seed) {
+    std::mt19937 rng(seed);
+    auto f = std::make_shared<RawImageFrame>();
+    f->width = w;
+    f->height = h;
+    f->stride = stride;
+    f->format = QuickView::PixelFormat::BGRA8888;
+    f->quality = QuickView::DecodeQuality::Full;
+    f->exifOrientation = 6;
+    f->srcWidth = w * 2;
+    f->srcHeight = h * 2;
+    f->iccProfile = { 1, 2, 3 };
+    f->pixels = new uint8_t[(size_t)stride * h];
+    f->memoryDeleter = QuickView::MemoryDeleter::FromDeleteArray();
+    for (int y = 0; y < h; ++y) {
+        uint8_t* row = f->pixels + (size_t)y * stride;
+        for (int x = 0; x < w; ++x) {
+            uint8_t* p = row + x * 4;
+            const int zone = (x * 5) / w;
+            if (zone == 0) { p[0] = (uint8_t)x; p[1] = (uint8_t)(y + x / 3); p[2] = (uint8_t)y; p[3] = 255; }
+            else if (zone == 1) { p[0] = 40; p[1] = 80; p[2] = 120; p[3] = 255; }
+            else if (zone == 2) { const uint8_t v = (uint8_t)((x / 7 % 4) * 60); p[0] = v; p[1] = (uint8_t)(v / 2); p[2] = 200; p[3] = 255; }
+            else if (zone == 3) { const uint32_t r = rng(); std::memcpy(p, &r, 3); p[3] = 255; }
+            else { p[0] = (uint8_t)(x + y); p[1] = 10; p[2] = (uint8_t)(y * 3); p[3] = (uint8_t)(y * 7); }
+        }
+    }
+    return f;
+}
+
+void ExpectSamePixels(const RawImageFrame& a, const RawImageFrame& b) {
+    ASSERT_EQ(a.width, b.width);
+    ASSERT_EQ(a.height, b.height);
+    for (int y = 0; y < a.height; ++y) {
+        ASSERT_EQ(std::memcmp(a.pixels + (size_t)y * a.stride, b.pixels + (size_t)y * b.stride, (size_t)a.width * 4), 0)
+            << "row " << y;
+    }
+}
+
+} // namespace
+
+TEST(ColdFrameCacheTest, CodecRoundTripsStripes) {
+    for (int w : { 1, 3, 64, 333 }) {
+        const int h = 41, stride = w * 4 + 12; // Padded rows
+        auto f = MakeFrame(w, h, stride, (uint32_t)w);
+        std::vector<uint8_t> enc(FrameCodec::MaxEncodedSize(w, h));
+        const size_t n = FrameCodec::EncodeStripe(f->pixels, w, h, stride, enc.data());
+        ASSERT_LE(n, enc.size());
+
+        std::vector<uint8_t> dec((size_t)stride * h, 0xCD);
+        ASSERT_TRUE(FrameCodec::DecodeStripe(enc.data(), n, w, h, stride, dec.data())) << "width " << w;
+        for (int y = 0; y < h; ++y) {
+            ASSERT_EQ(std::memcmp(dec.data() + (size_t)y * stride, f->pixels + (size_t)y * stride, (size_t)w * 4), 0)
+                << "width " << w << " row " << y;
+        }
+        // Truncated stream is rejected rather than read past
+        EXPECT_FALSE(FrameCodec::DecodeStripe(enc.data(), n - 1, w, h, stride, dec.data()));
+    }
+
+    // Flat opaque black matches the initial predictor: only the per-row width codes remain
+    std::vector<uint8_t> black(200 * 10 * 4, 0);
+    for (size_t i = 3; i < black.size(); i += 4) black[i] = 255;
+    std::vector<uint8_t> enc(FrameCodec::MaxEncodedSize(200, 10));
+    const size_t n = FrameCodec::EncodeStripe(black.data(), 200, 10, 800, enc.data());
+    EXPECT_EQ(n, 10u * ((200 * 4 / 16 + 3) / 4));
+    std::vector<uint8_t> dec(black.size());
+    ASSERT_TRUE(FrameCodec::DecodeStripe(enc.data(), n, 200, 10, 800, dec.data()));
+    EXPECT_EQ(dec, black);
+}
+
+TEST(ColdFrameCacheTest, PromotesCompressedFrameWithMetadata) {
+    ColdFrameCache cold(64ull << 20);
+    auto f = MakeFrame(1500, 900, 1500 * 4, 1); // Several stripes, some straddling blocks
+    cold.Put(ComputePathHash(L"a.jpg"), f, 7);
+    cold.Flush();
+
+    auto stats = cold.GetStats();
+    EXPECT_EQ(stats.entries, 1u);
+    EXPECT_EQ(stats.queued, 0u);
+    EXPECT_GT(stats.compressedBytes, 0u);
+    EXPECT_LT(stats.Ratio(), 0.9);
+    EXPECT_TRUE(cold.Contains(ComputePathHash(L"a.jpg")));
+
+    int index = -1;
+    auto back = cold.Take(ComputePathHash(L"a.jpg"), &index);
+    ASSERT_NE(back, nullptr);
+    EXPECT_NE(back.get(), f.get()); // Decompressed copy, not the queued frame
+    EXPECT_EQ(index, 7);
+    EXPECT_EQ(back->exifOrientation, 6);
+    EXPECT_EQ(back->srcWidth, 3000);
+    EXPECT_EQ(back->quality, QuickView::DecodeQuality::Full);
+    EXPECT_EQ(back->iccProfile, f->iccProfile);
+    ExpectSamePixels(*back, *f);
+
+    EXPECT_FALSE(cold.Contains(ComputePathHash(L"a.jpg"))); // Promotion moves it out of the tier
+    EXPECT_EQ(cold.Take(ComputePathHash(L"a.jpg")), nullptr);
+    stats = cold.GetStats();
+    EXPECT_EQ(stats.compressedBytes, 0u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+}
+
+TEST(ColdFrameCacheTest, BudgetEvictsLeastRecentlyEvicted) {
+    ColdFrameCache cold(4ull << 20);
+    std::vector<std::shared_ptr<RawImageFrame>> frames;
+    for (int i = 0; i < 6; ++i) {
+        frames.push_back(MakeFrame(1024, 768, 1024 * 4, 10 + i)); // 3 MB raw each
+        cold.Put(ComputePathHash(L"f" + std::to_wstring(i)), frames.back(), i);
+        cold.Flush();
+    }
+    const auto stats = cold.GetStats();
+    EXPECT_LE(stats.compressedBytes, 4ull << 20);
+    EXPECT_GT(stats.evictions, 0u);
+    EXPECT_FALSE(cold.Contains(ComputePathHash(L"f0")));
+    EXPECT_TRUE(cold.Contains(ComputePathHash(L"f5")));
+
+    auto back = cold.Take(ComputePathHash(L"f5"));
+    ASSERT_NE(back, nullptr);
+    ExpectSamePixels(*back, *frames[5]);
+}
+
+TEST(ColdFrameCacheTest, RejectsFramesItCannotHold) {
+    ColdFrameCache cold(16ull << 20);
+
+    auto hdr = MakeFrame(64, 64, 64 * 4, 2);
+    hdr->format = QuickView::PixelFormat::R16G16B16A16_FLOAT;
+    cold.Put(ComputePathHash(L"hdr.exr"), hdr, 0);
+    EXPECT_FALSE(cold.Contains(ComputePathHash(L"hdr.exr")));
+
+    auto layered = MakeFrame(64, 64, 64 * 4, 3);
+    layered->auxLayer = std::make_unique<QuickView::AuxLayer>();
+    cold.Put(ComputePathHash(L"gainmap.jpg"), layered, 0);
+    EXPECT_FALSE(cold.Contains(ComputePathHash(L"gainmap.jpg")));
+
+    // Noise does not compress: dropped once the worker sees it
+    auto noise = std::make_shared<RawImageFrame>();
+    noise->width = 256;
+    noise->height = 256;
+    noise->stride = 1024;
+    noise->pixels = new uint8_t[1024 * 256];
+    noise->memoryDeleter = QuickView::MemoryDeleter::FromDeleteArray();
+    std::mt19937 rng(4);
+    for (int i = 0; i < 1024 * 256; ++i) noise->pixels[i] = (uint8_t)rng();
+    cold.Put(ComputePathHash(L"noise.png"), noise, 0);
+    cold.Flush();
+    EXPECT_FALSE(cold.Contains(ComputePathHash(L"noise.png")));
+}
+
+TEST(ColdFrameCacheTest, QueuedFrameIsHandedBackAndEraseWins) {
+    ColdFrameCache cold(64ull << 20);
+    auto a = MakeFrame(2000, 1500, 2000 * 4, 5);
+    auto b = MakeFrame(2000, 1500, 2000 * 4, 6);
+    cold.Put(ComputePathHash(L"a"), a, 0);
+    cold.Put(ComputePathHash(L"b"), b, 1);
+
+    // Either still queued (same object back) or already compressed (equal copy)
+    auto back = cold.Take(ComputePathHash(L"b"));
+    ASSERT_NE(back, nullptr);
+    ExpectSamePixels(*back, *b);
+
+    cold.Erase(ComputePathHash(L"a"));
+    cold.Flush();
+    EXPECT_FALSE(cold.Contains(ComputePathHash(L"a")));
+    EXPECT_EQ(cold.GetStats().compressedBytes, 0u);
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "ImageLoaderSimd.h"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Fused frame statistics: banked histograms and the Laplacian against the old three-pass loops
+
+using ImageLoaderSimd::FrameStats;
+using ImageLoaderSimd::FrameStatsSource;
+
+namespace {
+
+std::vector<uint8_t> RandomBgra(int w, int h, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> px(static_cast<size_t>(w) * h * 4);
+    for (auto& v : px) v = static_cast<uint8_t>(rng());
+    return px;
+}
+
+// Random with flat runs, so equal values hit the banks back to back
+std::vector<uint8_t> BlockyBgra(int w, int h, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> px(static_cast<size_t>(w) * h * 4);
+    for (int y = 0; y < h; ++y) {
+        uint8_t c[4] = {};
+        for (int x = 0; x < w; ++x) {
+            if (x % 13 == 0) for (auto& v : c) v = static_cast<uint8_t>(rng());
+            std::memcpy(&px[(static_cast<size_t>(y) * w + x) * 4], c, 4);
+        }
+    }
+    return px;
+}
+
+// Histogram rows y = 0, step, ...; Laplacian on the step grid (the loops the kernel replaced)
+FrameStats Reference(const std::vector<uint8_t>& px, int w, int h, int step) {
+    FrameStats s;
+    auto luma = [&](int x, int y) {
+        const uint8_t* p = &px[(static_cast<size_t>(y) * w + x) * 4];
+        return (54 * p[2] + 183 * p[1] + 19 * p[0]) >> 8;
+    };
+    for (int y = 0; y < h; y += step) {
+        for (int x = 0; x < w; ++x) {
+            const uint8_t* p = &px[(static_cast<size_t>(y) * w + x) * 4];
+            s.histB[p[0]]++;
+            s.histG[p[1]]++;
+            s.histR[p[2]]++;
+            const int l = (p[2] * 299 + p[1] * 587 + p[0] * 114 + 500) / 1000;
+            s.histL[l]++;
+            s.lumaSum += l;
+            s.pixelCount++;
+        }
+    }
+    if (w > step * 2 && h > step * 2) {
+        for (int y = step; y + step < h; y += step) {
+            for (int x = step; x + step < w; x += step) {
+                const int lap = luma(x, y - step) + luma(x, y + step) + luma(x - step, y) + luma(x + step, y) - 4 * luma(x, y);
+                s.lapSumSq += static_cast<uint64_t>(lap * lap);
+                s.lapCount++;
+            }
+        }
+    }
+    return s;
+}
+
+void ExpectSameStats(const FrameStats& got, const FrameStats& want) {
+    EXPECT_EQ(std::memcmp(got.histR, want.histR, sizeof(want.histR)), 0);
+    EXPECT_EQ(std::memcmp(got.histG, want.histG, sizeof(want.histG)), 0);
+    EXPECT_EQ(std::memcmp(got.histB, want.histB, sizeof(want.histB)), 0);
+    EXPECT_EQ(std::memcmp(got.histL, want.histL, sizeof(want.histL)), 0);
+    EXPECT_EQ(got.pixelCount, want.pixelCount);
+    EXPECT_EQ(got.lumaSum, want.lumaSum);
+    EXPECT_EQ(got.lapSumSq, want.lapSumSq);
+    EXPECT_EQ(got.lapCount, want.lapCount);
+}
+
+FrameStats Compute(const std::vector<uint8_t>& px, int w, int h, int step) {
+    FrameStatsSource src;
+    src.pixels = px.data();
+    src.width = w;
+    src.height = h;
+    src.stride = w * 4;
+    FrameStats stats;
+    ImageLoaderSimd::ComputeFrameStats(src, step, &stats);
+    return stats;
+}
+
+} // namespace
+
+TEST(FrameStatsTests, MatchesThreePassReference) {
+    struct Case { int w, h, step; };
+    const Case cases[] = { {1, 1, 1}, {2, 7, 1}, {3, 3, 1}, {37, 29, 1}, {101, 67, 2}, {250, 130, 5}, {64, 200, 3}, {9, 9, 4} };
+    for (const Case& c : cases) {
+        const auto px = RandomBgra(c.w, c.h, static_cast<uint32_t>(c.w * 7 + c.h));
+        SCOPED_TRACE(testing::Message() << c.w << "x" << c.h << " step " << c.step);
+        ExpectSameStats(Compute(px, c.w, c.h, c.step), Reference(px, c.w, c.h, c.step));
+    }
+}
+
+TEST(FrameStatsTests, FlatRunsMergeAcrossBanks) {
+    const int w = 333, h = 41;
+    std::vector<uint8_t> flat(static_cast<size_t>(w) * h * 4, 200);
+    const FrameStats stats = Compute(flat, w, h, 1);
+    EXPECT_EQ(stats.histB[200], static_cast<uint32_t>(w * h));
+    EXPECT_EQ(stats.histL[200], static_cast<uint32_t>(w * h));
+    EXPECT_EQ(stats.lapSumSq, 0u);
+
+    const auto blocky = BlockyBgra(w, h, 3);
+    ExpectSameStats(Compute(blocky, w, h, 1), Reference(blocky, w, h, 1));
+}
+
+TEST(FrameStatsTests, ThreadedBandsMatchReference) {
+    // Over 1 MP sampled: rows split into bands on worker threads
+    const int w = 1500, h = 900;
+    const auto px = BlockyBgra(w, h, 5);
+    ExpectSameStats(Compute(px, w, h, 1), Reference(px, w, h, 1));
+    ExpectSameStats(Compute(px, w, h, 7), Reference(px, w, h, 7));
+}
+
+TEST(FrameStatsTests, FloatFrameUsesFloatHistogramAndLuma) {
+    const int w = 45, h = 23;
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> dist(-0.1f, 2.5f);
+    std::vector<float> px(static_cast<size_t>(w) * h * 4);
+    for (auto& v : px) v = dist(rng);
+
+    FrameStatsSource src;
+    src.pixels = reinterpret_cast<const uint8_t*>(px.data());
+    src.width = w;
+    src.height = h;
+    src.stride = w * 16;
+    src.isFloat = true;
+    src.mapRange = 2.0f;
+    FrameStats stats;
+    ImageLoaderSimd::ComputeFrameStats(src, 2, &stats);
+
+    FrameStats want;
+    for (int y = 0; y < h; y += 2) {
+        ImageLoaderSimd::ComputeHistogramRowFloat(px.data() + static_cast<size_t>(y) * w * 4, w, 2.0f,
+                                                  want.histR, want.histG, want.histB, want.histL);
+    }
+    EXPECT_EQ(std::memcmp(stats.histL, want.histL, sizeof(want.histL)), 0);
+    EXPECT_EQ(std::memcmp(stats.histR, want.histR, sizeof(want.histR)), 0);
+    EXPECT_EQ(stats.pixelCount, static_cast<uint64_t>(w) * ((h + 1) / 2));
+
+    auto luma = [&](int x, int y) {
+        const float* p = &px[(static_cast<size_t>(y) * w + x) * 4];
+        return static_cast<int>(std::clamp((p[0] * 0.299f + p[1] * 0.587f + p[2] * 0.114f) * 255.0f, 0.0f, 255.0f));
+    };
+    uint64_t lapSumSq = 0, lapCount = 0;
+    for (int y = 2; y + 2 < h; y += 2) {
+        for (int x = 2; x + 2 < w; x += 2) {
+            const int lap = luma(x, y - 2) + luma(x, y + 2) + luma(x - 2, y) + luma(x + 2, y) - 4 * luma(x, y);
+            lapSumSq += static_cast<uint64_t>(lap * lap);
+            lapCount++;
+        }
+    }
+    EXPECT_EQ(stats.lapSumSq, lapSumSq);
+    EXPECT_EQ(stats.lapCount, lapCount);
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include "JpegEntryIndex.h"
+#include <turbojpeg.h>
+#include <cstring>
+
+// Entry-point index used by the Titan JPEG tile path: a sub-JPEG must decode to
+// exactly the rows a full decode produces
+
+using QuickView::JpegEntryIndex;
+
+namespace {
+
+struct EncodeParams {
+    int width = 0;
+    int height = 0;
+    int subsamp = TJSAMP_420;
+    int restartRows = 0;
+    int restartBlocks = 0;
+    bool optimize = false;
+    bool progressive = false;
+};
+
+std::vector<uint8_t> MakePixels(int w, int h) {
+    std::vector<uint8_t> px((size_t)w * h * 4);
+    uint32_t rng = 7;
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            rng = rng * 1103515245u + 12345u;
+            uint8_t* p = &px[((size_t)y * w + x) * 4];
+            // Gradients with noise and hard edges: wide DC swings across MCU rows
+            p[0] = (uint8_t)(x * 255 / w + (rng >> 28));
+            p[1] = (uint8_t)(((x / 24 + y / 16) & 1) ? 230 : 20);
+            p[2] = (uint8_t)(y * 255 / h ^ (rng >> 25));
+            p[3] = 255;
+        }
+    }
+    return px;
+}
+
+std::vector<uint8_t> Encode(const EncodeParams& params) {
+    const std::vector<uint8_t> px = MakePixels(params.width, params.height);
+    tjhandle tj = tj3Init(TJINIT_COMPRESS);
+    tj3Set(tj, TJPARAM_QUALITY, 90);
+    tj3Set(tj, TJPARAM_SUBSAMP, params.subsamp);
+    tj3Set(tj, TJPARAM_RESTARTROWS, params.restartRows);
+    tj3Set(tj, TJPARAM_RESTARTBLOCKS, params.restartBlocks);
+    tj3Set(tj, TJPARAM_OPTIMIZE, params.optimize ? 1 : 0);
+    tj3Set(tj, TJPARAM_PROGRESSIVE, params.progressive ? 1 : 0);
+    unsigned char* jpeg = nullptr;
+    size_t jpegSize = 0;
+    const int rc = tj3Compress8(tj, px.data(), params.width, 0, params.height, TJPF_BGRX, &jpeg, &jpegSize);
+    std::vector<uint8_t> out;
+    if (rc == 0) out.assign(jpeg, jpeg + jpegSize);
+    tj3Free(jpeg);
+    tj3Destroy(tj);
+    return out;
+}
+
+bool Decode(const std::vector<uint8_t>& jpeg, int* w, int* h, std::vector<uint8_t>* px) {
+    tjhandle tj = tj3Init(TJINIT_DECOMPRESS);
+    bool ok = tj3DecompressHeader(tj, jpeg.data(), jpeg.size()) == 0;
+    if (ok) {
+        *w = tj3Get(tj, TJPARAM_JPEGWIDTH);
+        *h = tj3Get(tj, TJPARAM_JPEGHEIGHT);
+        px->assign((size_t)*w * *h * 4, 0);
+        ok = tj3Decompress8(tj, jpeg.data(), jpeg.size(), px->data(), 0, TJPF_BGRX) == 0;
+    }
+    tj3Destroy(tj);
+    return ok;
+}
+
+// Extracts [y0, y1) through the index and compares against the full decode
+void ExpectRowsMatch(const JpegEntryIndex& index, const std::vector<uint8_t>& jpeg,
+                     const std::vector<uint8_t>& full, int width, int y0, int y1) {
+    SCOPED_TRACE(testing::Message() << "rows " << y0 << ".." << y1);
+    std::vector<uint8_t> sub;
+    int firstRow = -1;
+    if (!index.ExtractRows(jpeg.data(), jpeg.size(), y0, y1, &sub, &firstRow)) {
+        // Only allowed when the whole scan is needed anyway
+        EXPECT_LT(y0, 2 * index.McuHeight());
+        return;
+    }
+    ASSERT_GE(firstRow, 0);
+    ASSERT_LE(firstRow, y0);
+    EXPECT_LT(sub.size(), jpeg.size());
+
+    int sw = 0, sh = 0;
+    std::vector<uint8_t> px;
+    ASSERT_TRUE(Decode(sub, &sw, &sh, &px));
+    ASSERT_EQ(sw, width);
+    ASSERT_GE(firstRow + sh, y1);
+    const size_t rowBytes = (size_t)width * 4;
+    for (int y = y0; y < y1; ++y) {
+        ASSERT_EQ(0, memcmp(&full[(size_t)y * rowBytes], &px[(size_t)(y - firstRow) * rowBytes], rowBytes))
+            << "row " << y;
+    }
+}
+
+void CheckStream(const EncodeParams& params, bool expectRestart) {
+    const std::vector<uint8_t> jpeg = Encode(params);
+    ASSERT_FALSE(jpeg.empty());
+    int w = 0, h = 0;
+    std::vector<uint8_t> full;
+    ASSERT_TRUE(Decode(jpeg, &w, &h, &full));
+
+    auto index = JpegEntryIndex::Build(jpeg.data(), jpeg.size());
+    ASSERT_NE(index, nullptr);
+    EXPECT_EQ(index->Width(), params.width);
+    EXPECT_EQ(index->Height(), params.height);
+    EXPECT_EQ(index->UsesRestartMarkers(), expectRestart);
+    EXPECT_GT(index->Entries().size(), 1u);
+
+    const int ranges[][2] = {
+        { 0, 40 }, { 17, 90 }, { 128, 256 }, { h / 2, h / 2 + 1 }, { h - 200, h - 70 }, { h - 33, h },
+    };
+    for (const auto& r : ranges) {
+        ExpectRowsMatch(*index, jpeg, full, w, r[0], r[1]);
+    }
+}
+
+} // namespace
+
+TEST(JpegEntryIndexTest, HuffmanEntryPointsMatchFullDecode) {
+    EncodeParams params;
+    params.width = 517;
+    params.height = 611;
+    for (int subsamp : { TJSAMP_420, TJSAMP_422, TJSAMP_444, TJSAMP_GRAY }) {
+        SCOPED_TRACE(subsamp);
+        params.subsamp = subsamp;
+        CheckStream(params, false);
+    }
+}
+
+TEST(JpegEntryIndexTest, OptimizedTablesStillDecodeIdentically) {
+    // Per-image tables often lack DC categories the re-coded first block needs:
+    // those rows are skipped as entry points, never emitted wrongly
+    EncodeParams params;
+    params.width = 300;
+    params.height = 700;
+    params.optimize = true;
+    CheckStream(params, false);
+}
+
+TEST(JpegEntryIndexTest, RestartMarkersAreRenumbered) {
+    EncodeParams params;
+    params.width = 520;
+    params.height = 640;
+    params.restartRows = 1;
+    CheckStream(params, true);
+
+    // Intervals that do not line up with MCU rows: only some rows are entry points
+    params.restartRows = 0;
+    params.restartBlocks = 7; // MCUs; 33 MCUs per row, so every 7th row starts an interval
+    params.subsamp = TJSAMP_420;
+    CheckStream(params, true);
+}
+
+TEST(JpegEntryIndexTest, MultiRowRestartIntervalsDecodeWithoutWarnings) {
+    // Restart every 4 MCU rows: the next entry point usually lies past the rows a
+    // tile asked for, and the SOF height must cover everything copied up to it
+    // (otherwise libjpeg warns about extraneous data and TurboJPEG returns -1)
+    EncodeParams params;
+    params.width = 640;
+    params.height = 1024;
+    params.restartRows = 4;
+    const std::vector<uint8_t> jpeg = Encode(params);
+    ASSERT_FALSE(jpeg.empty());
+    int w = 0, h = 0;
+    std::vector<uint8_t> full;
+    ASSERT_TRUE(Decode(jpeg, &w, &h, &full));
+    auto index = JpegEntryIndex::Build(jpeg.data(), jpeg.size());
+    ASSERT_NE(index, nullptr);
+    ASSERT_TRUE(index->UsesRestartMarkers());
+
+    for (int y0 = 40; y0 < h - 16; y0 += 37) {
+        for (int rows : { 1, 16, 45, 133 }) {
+            ExpectRowsMatch(*index, jpeg, full, w, y0, (std::min)(h, y0 + rows));
+        }
+    }
+}
+
+TEST(JpegEntryIndexTest, RejectsProgressiveAndGarbage) {
+    EncodeParams params;
+    params.width = 256;
+    params.height = 256;
+    params.progressive = true;
+    const std::vector<uint8_t> progressive = Encode(params);
+    ASSERT_FALSE(progressive.empty());
+    EXPECT_EQ(JpegEntryIndex::Build(progressive.data(), progressive.size()), nullptr);
+
+    params.progressive = false;
+    std::vector<uint8_t> truncated = Encode(params);
+    truncated.resize(truncated.size() / 2);
+    EXPECT_EQ(JpegEntryIndex::Build(truncated.data(), truncated.size()), nullptr);
+
+    const uint8_t junk[] = { 0xFF, 0xD8, 0xFF, 0xFF, 0x00, 0x02 };
+    EXPECT_EQ(JpegEntryIndex::Build(junk, sizeof(junk)), nullptr);
+}
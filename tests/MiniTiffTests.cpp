@@ -25,6 +25,11 @@
 #include <filesystem>
 #include <cwctype>
 #include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <zlib.h>
+#include <turbojpeg.h>
+#include "SyntheticTiff.h" // EncodeTiffLzw
 
 static std::vector<uint8_t> ReadFileBytes(const std::wstring& path) {
     FILE* f = nullptr;
@@ -45,6 +50,705 @@ static std::vector<uint8_t> ReadFileBytes(const std::wstring& path) {
     return buf;
 }
 
+// ============================================================================
+// Synthetic in-memory TIFF writer (strips, optional predictor/Deflate/planes)
+// ============================================================================
+
+struct SyntheticIfd {
+    uint32_t width;
+    uint32_t height;
+    uint8_t gray;                 // Constant fill when `samplesData` is empty
+    uint32_t subfileType = 0;     // 1 = reduced resolution
+    uint16_t samples = 1;
+    uint16_t bitsPerSample = 8;
+    uint16_t photometric = 1;     // BlackIsZero
+    uint16_t compression = 1;     // 1 = none, 8 = Deflate
+    uint16_t predictor = 1;       // 2 = horizontal (little-endian only), 3 = floating point
+    uint16_t sampleFormat = 1;    // 3 = IEEE float
+    uint16_t planarConfig = 1;    // 2 = one set of strips per channel
+    uint32_t rowsPerStrip = 0;    // 0 = single strip
+    std::vector<uint8_t> samplesData; // Interleaved samples, little-endian for 16/32-bit
+    uint32_t tileSize = 0;        // Square tiles (only with `encodedUnits`)
+    std::vector<std::vector<uint8_t>> encodedUnits; // Pre-compressed strips/tiles, written as-is
+    std::vector<uint8_t> jpegTables;
+};
+
+static void PutInt(std::vector<uint8_t>& buf, size_t pos, uint64_t v, int bytes, bool bigEndian = false) {
+    for (int i = 0; i < bytes; ++i) {
+        buf[pos + (bigEndian ? bytes - 1 - i : i)] = static_cast<uint8_t>(v >> (8 * i));
+    }
+}
+
+static void AppendInt(std::vector<uint8_t>& buf, uint64_t v, int bytes, bool bigEndian = false) {
+    buf.resize(buf.size() + bytes);
+    PutInt(buf, buf.size() - bytes, v, bytes, bigEndian);
+}
+
+// Horizontal differencing (Predictor=2), right to left so deltas use original values
+static void ApplyPredictor(uint8_t* row, uint32_t width, int samples, int bytesPerSample) {
+    for (int64_t i = static_cast<int64_t>(width) * samples - 1; i >= samples; --i) {
+        if (bytesPerSample == 1) {
+            row[i] = static_cast<uint8_t>(row[i] - row[i - samples]);
+        } else {
+            uint16_t cur = static_cast<uint16_t>(row[i * 2] | (row[i * 2 + 1] << 8));
+            uint16_t prev = static_cast<uint16_t>(row[(i - samples) * 2] | (row[(i - samples) * 2 + 1] << 8));
+            uint16_t d = static_cast<uint16_t>(cur - prev);
+            row[i * 2] = static_cast<uint8_t>(d);
+            row[i * 2 + 1] = static_cast<uint8_t>(d >> 8);
+        }
+    }
+}
+
+// Floating-point predictor (Predictor=3): MSB-first byte planes, then bytes differenced `samples` apart.
+// The result does not depend on the file byte order.
+static void ApplyFloatPredictor(uint8_t* row, uint32_t width, int samples, int bytesPerSample) {
+    const size_t count = static_cast<size_t>(width) * samples;
+    std::vector<uint8_t> planes(count * bytesPerSample);
+    for (size_t i = 0; i < count; ++i) {
+        for (int b = 0; b < bytesPerSample; ++b) {
+            planes[b * count + i] = row[i * bytesPerSample + (bytesPerSample - 1 - b)];
+        }
+    }
+    for (int64_t i = static_cast<int64_t>(planes.size()) - 1; i >= samples; --i) {
+        planes[i] = static_cast<uint8_t>(planes[i] - planes[i - samples]);
+    }
+    std::memcpy(row, planes.data(), planes.size());
+}
+
+// Writes a classic TIFF or BigTIFF with the IFDs chained in order
+static std::vector<uint8_t> BuildSyntheticTiff(const std::vector<SyntheticIfd>& ifds, bool bigTiff,
+                                               bool bigEndian = false) {
+    const int offBytes = bigTiff ? 8 : 4;
+    const bool be = bigEndian;
+
+    std::vector<uint8_t> buf;
+    buf.push_back(be ? 'M' : 'I');
+    buf.push_back(be ? 'M' : 'I');
+    AppendInt(buf, bigTiff ? 0x2B : 0x2A, 2, be);
+    if (bigTiff) {
+        AppendInt(buf, 8, 2, be);
+        AppendInt(buf, 0, 2, be);
+    }
+    size_t linkPos = buf.size(); // Where the next IFD offset gets patched in
+    AppendInt(buf, 0, offBytes, be);
+
+    for (const SyntheticIfd& d : ifds) {
+        const int bps = d.bitsPerSample / 8;
+        const bool planar = d.planarConfig == 2;
+        const int planes = planar ? d.samples : 1;
+        const int storedSamples = planar ? 1 : d.samples;
+        const size_t pixelBytes = static_cast<size_t>(d.samples) * bps;
+        const size_t rowBytes = static_cast<size_t>(d.width) * storedSamples * bps;
+        std::vector<uint8_t> raw = d.samplesData;
+        if (raw.empty()) raw.assign(pixelBytes * d.width * d.height, d.gray);
+
+        // Strips, all of plane 0 first for separate planes
+        const uint32_t rps = d.rowsPerStrip ? d.rowsPerStrip : d.height;
+        std::vector<uint64_t> offsets, counts;
+        for (const std::vector<uint8_t>& unit : d.encodedUnits) {
+            offsets.push_back(buf.size());
+            counts.push_back(unit.size());
+            buf.insert(buf.end(), unit.begin(), unit.end());
+        }
+        for (int p = 0; p < planes && d.encodedUnits.empty(); ++p) {
+            std::vector<uint8_t> plane = raw;
+            if (planar) {
+                plane.resize(rowBytes * d.height);
+                for (size_t i = 0; i < static_cast<size_t>(d.width) * d.height; ++i) {
+                    std::memcpy(&plane[i * bps], &raw[i * pixelBytes + p * bps], bps);
+                }
+            }
+
+            for (uint32_t y0 = 0; y0 < d.height; y0 += rps) {
+                uint32_t rows = (std::min)(rps, d.height - y0);
+                std::vector<uint8_t> strip(plane.begin() + y0 * rowBytes, plane.begin() + (y0 + rows) * rowBytes);
+                for (uint32_t r = 0; r < rows; ++r) {
+                    uint8_t* row = strip.data() + r * rowBytes;
+                    if (d.predictor == 2) ApplyPredictor(row, d.width, storedSamples, bps);
+                    if (d.predictor == 3) ApplyFloatPredictor(row, d.width, storedSamples, bps);
+                }
+                if (be && d.predictor != 3) {
+                    for (size_t i = 0; i + bps <= strip.size(); i += bps) {
+                        std::reverse(strip.begin() + i, strip.begin() + i + bps);
+                    }
+                }
+                if (d.compression == 8) {
+                    uLongf packedLen = compressBound(static_cast<uLong>(strip.size()));
+                    std::vector<uint8_t> packed(packedLen);
+                    compress2(packed.data(), &packedLen, strip.data(), static_cast<uLong>(strip.size()), 6);
+                    packed.resize(packedLen);
+                    strip.swap(packed);
+                }
+                offsets.push_back(buf.size());
+                counts.push_back(strip.size());
+                buf.insert(buf.end(), strip.begin(), strip.end());
+            }
+        }
+
+        struct Entry { uint16_t tag, type; std::vector<uint64_t> values; uint64_t outOfLine = 0; };
+        std::vector<Entry> entries = {
+            {254, 4, {d.subfileType}},
+            {256, 4, {d.width}},
+            {257, 4, {d.height}},
+            {258, 3, {d.bitsPerSample}},
+            {259, 3, {d.compression}},
+            {262, 3, {d.photometric}},
+            {273, 4, offsets},
+            {277, 3, {d.samples}},
+            {278, 4, {rps}},
+            {279, 4, counts},
+            {284, 3, {d.planarConfig}},
+            {317, 3, {d.predictor}},
+            {339, 3, std::vector<uint64_t>(d.samples, d.sampleFormat)},
+        };
+        if (d.tileSize) {
+            // Tile tags replace the strip layout (entries stay sorted by tag)
+            std::erase_if(entries, [](const Entry& e) { return e.tag == 273 || e.tag == 278 || e.tag == 279; });
+            const Entry tileEntries[] = {
+                {322, 4, {d.tileSize}}, {323, 4, {d.tileSize}}, {324, 4, offsets}, {325, 4, counts},
+            };
+            auto at = std::find_if(entries.begin(), entries.end(), [](const Entry& e) { return e.tag > 325; });
+            entries.insert(at, std::begin(tileEntries), std::end(tileEntries));
+        }
+        if (!d.jpegTables.empty()) {
+            auto at = std::find_if(entries.begin(), entries.end(), [](const Entry& e) { return e.tag > 347; });
+            entries.insert(at, Entry{347, 7, std::vector<uint64_t>(d.jpegTables.begin(), d.jpegTables.end())});
+        }
+
+        // Values that do not fit the entry go before the IFD
+        auto typeSizeOf = [](const Entry& e) { return e.type == 7 ? 1 : (e.type == 3 ? 2 : 4); };
+        for (Entry& e : entries) {
+            const int typeSize = typeSizeOf(e);
+            if (e.values.size() * typeSize <= static_cast<size_t>(offBytes)) continue;
+            if (buf.size() & 1) buf.push_back(0);
+            e.outOfLine = buf.size();
+            for (uint64_t v : e.values) AppendInt(buf, v, typeSize, be);
+        }
+
+        if (buf.size() & 1) buf.push_back(0); // IFDs start on a word boundary
+        PutInt(buf, linkPos, buf.size(), offBytes, be);
+        AppendInt(buf, entries.size(), bigTiff ? 8 : 2, be);
+        for (const Entry& e : entries) {
+            const int typeSize = typeSizeOf(e);
+            AppendInt(buf, e.tag, 2, be);
+            AppendInt(buf, e.type, 2, be);
+            AppendInt(buf, e.values.size(), offBytes, be);
+            if (e.outOfLine) {
+                AppendInt(buf, e.outOfLine, offBytes, be);
+                continue;
+            }
+            // Inline values are left-justified in the value field
+            for (uint64_t v : e.values) AppendInt(buf, v, typeSize, be);
+            AppendInt(buf, 0, offBytes - static_cast<int>(e.values.size()) * typeSize, be);
+        }
+        linkPos = buf.size();
+        AppendInt(buf, 0, offBytes, be);
+    }
+    return buf;
+}
+
+static QuickView::Codec::DecodeContext MakeAlignedContext() {
+    QuickView::Codec::DecodeContext ctx;
+    ctx.allocator.ctx = nullptr;
+    ctx.allocator.pfn = [](void*, size_t s) -> uint8_t* {
+        return static_cast<uint8_t*>(_aligned_malloc(s, 64));
+    };
+    return ctx;
+}
+
+TEST(MiniTiffTest, LoadSyntheticBigTiff) {
+    std::vector<uint8_t> bytes = BuildSyntheticTiff({{40, 24, 0x5A}}, true);
+
+    uint32_t w = 0, h = 0;
+    ASSERT_TRUE(QuickView::MiniTiff::GetImageSize(bytes.data(), bytes.size(), &w, &h));
+    EXPECT_EQ(w, 40u);
+    EXPECT_EQ(h, 24u);
+
+    QuickView::Codec::DecodeResult result;
+    HRESULT hr = QuickView::MiniTiff::Load(bytes.data(), bytes.size(), MakeAlignedContext(), result);
+    ASSERT_EQ(hr, S_OK);
+    ASSERT_TRUE(result.success);
+    EXPECT_EQ(result.width, 40);
+    EXPECT_EQ(result.height, 24);
+    EXPECT_EQ(result.pixels[0], 0x5A);
+    EXPECT_EQ(result.pixels[(23 * result.stride) + 39 * 4 + 2], 0x5A);
+    EXPECT_NE(result.metadata.FormatDetails.find(L"BigTIFF"), std::wstring::npos);
+
+    if (result.pixels) _aligned_free(result.pixels);
+}
+
+TEST(MiniTiffTest, RegionUsesPyramidLevel) {
+    // Base 64x64 (gray 200), reduced 32x32 (gray 100), reduced 16x16 (gray 50)
+    std::vector<SyntheticIfd> ifds = {{64, 64, 200}, {32, 32, 100, 1}, {16, 16, 50, 1}};
+
+    for (bool bigTiff : {false, true}) {
+        std::vector<uint8_t> bytes = BuildSyntheticTiff(ifds, bigTiff);
+        auto ctx = MakeAlignedContext();
+
+        // Full scale: base level, exact crop size
+        QuickView::Codec::DecodeResult full;
+        ASSERT_EQ(QuickView::MiniTiff::LoadRegion(bytes.data(), bytes.size(), ctx, full, 8, 8, 32, 32), S_OK);
+        EXPECT_EQ(full.width, 32);
+        EXPECT_EQ(full.pixels[0], 200);
+        if (full.pixels) _aligned_free(full.pixels);
+
+        // Half scale: the 32x32 level covers it, 16x16 would not
+        QuickView::Codec::DecodeResult half;
+        ASSERT_EQ(QuickView::MiniTiff::LoadRegion(bytes.data(), bytes.size(), ctx, half, 8, 8, 32, 32, 0.5f), S_OK);
+        EXPECT_EQ(half.width, 16);
+        EXPECT_EQ(half.height, 16);
+        EXPECT_EQ(half.pixels[0], 100);
+        EXPECT_EQ(half.metadata.Width, 64u);
+        EXPECT_EQ(half.metadata.Height, 64u);
+        if (half.pixels) _aligned_free(half.pixels);
+
+        // Quarter scale, odd crop: coarsest level, crop expanded outward; the window
+        // keeps the exact crop so resampling it does not shift the tile
+        QuickView::Codec::DecodeResult quarter;
+        QuickView::MiniTiff::RegionWindow window;
+        ASSERT_EQ(QuickView::MiniTiff::LoadRegion(bytes.data(), bytes.size(), ctx, quarter, 6, 6, 10, 10, 0.25f, &window), S_OK);
+        EXPECT_EQ(quarter.width, 3);  // floor(6/4)=1 .. ceil(16/4)=4
+        EXPECT_EQ(quarter.pixels[0], 50);
+        EXPECT_DOUBLE_EQ(window.x, 0.5); // 6/4 - 1
+        EXPECT_DOUBLE_EQ(window.y, 0.5);
+        EXPECT_DOUBLE_EQ(window.width, 2.5);
+        EXPECT_DOUBLE_EQ(window.height, 2.5);
+        if (quarter.pixels) _aligned_free(quarter.pixels);
+    }
+}
+
+static std::vector<uint8_t> PseudoRandomBytes(size_t n, uint32_t seed) {
+    std::vector<uint8_t> v(n);
+    for (auto& b : v) {
+        seed = seed * 1664525u + 1013904223u;
+        b = static_cast<uint8_t>(seed >> 24);
+    }
+    return v;
+}
+
+// Expected BGRA for RGB samples (16-bit keeps the high byte)
+static void ExpectRgbMatches(const QuickView::Codec::DecodeResult& result, const std::vector<uint8_t>& samplesData,
+                             uint32_t width, int bytesPerSample, int x0 = 0, int y0 = 0) {
+    const int hi = bytesPerSample - 1;
+    for (int y = 0; y < result.height; ++y) {
+        const uint8_t* row = result.pixels + static_cast<size_t>(y) * result.stride;
+        for (int x = 0; x < result.width; ++x) {
+            const size_t src = ((static_cast<size_t>(y0 + y) * width) + x0 + x) * 3 * bytesPerSample;
+            ASSERT_EQ(row[x * 4 + 2], samplesData[src + 0 * bytesPerSample + hi]) << "x=" << x << " y=" << y;
+            ASSERT_EQ(row[x * 4 + 1], samplesData[src + 1 * bytesPerSample + hi]) << "x=" << x << " y=" << y;
+            ASSERT_EQ(row[x * 4 + 0], samplesData[src + 2 * bytesPerSample + hi]) << "x=" << x << " y=" << y;
+            ASSERT_EQ(row[x * 4 + 3], 255);
+        }
+    }
+}
+
+TEST(MiniTiffTest, PredictorStripsRoundTrip) {
+    struct Case { uint16_t bits; uint16_t compression; };
+    for (Case c : {Case{8, 8}, Case{8, 1}, Case{16, 8}, Case{16, 1}}) {
+        SyntheticIfd ifd{203, 37, 0};
+        ifd.samples = 3;
+        ifd.photometric = 2;
+        ifd.bitsPerSample = c.bits;
+        ifd.compression = c.compression;
+        ifd.predictor = 2;
+        ifd.rowsPerStrip = 5;
+        ifd.samplesData = PseudoRandomBytes(static_cast<size_t>(203) * 37 * 3 * (c.bits / 8), c.bits + c.compression);
+        std::vector<uint8_t> bytes = BuildSyntheticTiff({ifd}, false);
+
+        QuickView::Codec::DecodeResult full;
+        ASSERT_EQ(QuickView::MiniTiff::Load(bytes.data(), bytes.size(), MakeAlignedContext(), full), S_OK)
+            << "bits=" << c.bits << " compression=" << c.compression;
+        ExpectRgbMatches(full, ifd.samplesData, 203, c.bits / 8);
+        if (full.pixels) _aligned_free(full.pixels);
+
+        // Crop starting mid-strip and mid-row: predictor still runs from column 0
+        QuickView::Codec::DecodeResult region;
+        ASSERT_EQ(QuickView::MiniTiff::LoadRegion(bytes.data(), bytes.size(), MakeAlignedContext(), region, 61, 7, 100, 21), S_OK);
+        EXPECT_EQ(region.width, 100);
+        EXPECT_EQ(region.height, 21);
+        ExpectRgbMatches(region, ifd.samplesData, 203, c.bits / 8, 61, 7);
+        if (region.pixels) _aligned_free(region.pixels);
+    }
+}
+
+TEST(MiniTiffTest, ParallelStripDecodeMatchesSerial) {
+    // Large enough to take the multi-threaded path; strips are deliberately uneven
+    SyntheticIfd ifd{1280, 900, 0};
+    ifd.samples = 3;
+    ifd.photometric = 2;
+    ifd.compression = 8;
+    ifd.predictor = 2;
+    ifd.rowsPerStrip = 37;
+    ifd.samplesData = PseudoRandomBytes(static_cast<size_t>(1280) * 900 * 3, 7);
+    std::vector<uint8_t> bytes = BuildSyntheticTiff({ifd}, true);
+
+    // -1: shared helper budget, 0: calling thread only (pool workers), 2: capped
+    for (int helpers : { -1, 0, 2 }) {
+        SCOPED_TRACE(helpers);
+        QuickView::Codec::DecodeContext ctx = MakeAlignedContext();
+        ctx.helperThreads = helpers;
+        QuickView::Codec::DecodeResult full;
+        ASSERT_EQ(QuickView::MiniTiff::Load(bytes.data(), bytes.size(), ctx, full), S_OK);
+        ExpectRgbMatches(full, ifd.samplesData, 1280, 1);
+        if (full.pixels) _aligned_free(full.pixels);
+    }
+}
+
+TEST(MiniTiffTest, PlanarStripsMatchChunky) {
+    struct Case { uint16_t bits; uint16_t compression; uint16_t predictor; };
+    for (Case c : {Case{8, 8, 2}, Case{8, 1, 1}, Case{16, 8, 2}}) {
+        SyntheticIfd ifd{117, 29, 0};
+        ifd.samples = 3;
+        ifd.photometric = 2;
+        ifd.bitsPerSample = c.bits;
+        ifd.compression = c.compression;
+        ifd.predictor = c.predictor;
+        ifd.planarConfig = 2;
+        ifd.rowsPerStrip = 6;
+        ifd.samplesData = PseudoRandomBytes(static_cast<size_t>(117) * 29 * 3 * (c.bits / 8), 31 + c.bits);
+        std::vector<uint8_t> bytes = BuildSyntheticTiff({ifd}, false);
+
+        QuickView::Codec::DecodeResult full;
+        ASSERT_EQ(QuickView::MiniTiff::Load(bytes.data(), bytes.size(), MakeAlignedContext(), full), S_OK)
+            << "bits=" << c.bits << " compression=" << c.compression;
+        ExpectRgbMatches(full, ifd.samplesData, 117, c.bits / 8);
+        EXPECT_NE(full.metadata.FormatDetails.find(L"Planar"), std::wstring::npos);
+        if (full.pixels) _aligned_free(full.pixels);
+
+        QuickView::Codec::DecodeResult region;
+        ASSERT_EQ(QuickView::MiniTiff::LoadRegion(bytes.data(), bytes.size(), MakeAlignedContext(), region, 33, 5, 70, 17), S_OK);
+        ExpectRgbMatches(region, ifd.samplesData, 117, c.bits / 8, 33, 5);
+        if (region.pixels) _aligned_free(region.pixels);
+    }
+}
+
+// Scene-linear test pattern: negatives, sub-normals-free fractions and HDR highlights
+static std::vector<uint8_t> MakeFloatSamples(size_t count, uint32_t seed) {
+    std::vector<uint8_t> bytes(count * sizeof(float));
+    for (size_t i = 0; i < count; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        float v = static_cast<float>(seed >> 8) / static_cast<float>(1u << 24) * 24.0f - 4.0f;
+        std::memcpy(&bytes[i * sizeof(float)], &v, sizeof(float));
+    }
+    return bytes;
+}
+
+// Expected RGBA float/half for RGB(A) float samples, compared bit-exact
+template <typename T>
+static void ExpectRgbaFloatMatches(const QuickView::Codec::DecodeResult& result, const std::vector<uint8_t>& samplesData,
+                                   uint32_t width, int samples, T one, int x0 = 0, int y0 = 0) {
+    for (int y = 0; y < result.height; ++y) {
+        const T* row = reinterpret_cast<const T*>(result.pixels + static_cast<size_t>(y) * result.stride);
+        for (int x = 0; x < result.width; ++x) {
+            const size_t src = ((static_cast<size_t>(y0 + y) * width) + x0 + x) * samples;
+            for (int c = 0; c < 4; ++c) {
+                T expected = one;
+                if (c < samples) std::memcpy(&expected, &samplesData[(src + c) * sizeof(T)], sizeof(T));
+                ASSERT_EQ(std::memcmp(&row[x * 4 + c], &expected, sizeof(T)), 0) << "x=" << x << " y=" << y << " c=" << c;
+            }
+        }
+    }
+}
+
+TEST(MiniTiffTest, FloatStripsRoundTrip) {
+    struct Case { uint16_t compression; uint16_t predictor; uint16_t planar; bool bigEndian; };
+    const Case cases[] = {
+        {1, 1, 1, false}, {8, 3, 1, false}, {1, 1, 1, true}, {8, 3, 1, true}, {8, 3, 2, false}, {1, 1, 2, true},
+    };
+    for (const Case& c : cases) {
+        SyntheticIfd ifd{75, 19, 0};
+        ifd.samples = 3;
+        ifd.photometric = 2;
+        ifd.bitsPerSample = 32;
+        ifd.sampleFormat = 3;
+        ifd.compression = c.compression;
+        ifd.predictor = c.predictor;
+        ifd.planarConfig = c.planar;
+        ifd.rowsPerStrip = 4;
+        ifd.samplesData = MakeFloatSamples(static_cast<size_t>(75) * 19 * 3, 11u + c.predictor);
+        std::vector<uint8_t> bytes = BuildSyntheticTiff({ifd}, false, c.bigEndian);
+
+        QuickView::Codec::DecodeResult full;
+        ASSERT_EQ(QuickView::MiniTiff::Load(bytes.data(), bytes.size(), MakeAlignedContext(), full), S_OK)
+            << "predictor=" << c.predictor << " planar=" << c.planar << " bigEndian=" << c.bigEndian;
+        EXPECT_EQ(full.format, QuickView::PixelFormat::R32G32B32A32_FLOAT);
+        EXPECT_TRUE(full.metadata.hdrMetadata.isSceneLinear);
+        ExpectRgbaFloatMatches(full, ifd.samplesData, 75, 3, 1.0f);
+        if (full.pixels) _aligned_free(full.pixels);
+
+        QuickView::Codec::DecodeResult region;
+        ASSERT_EQ(QuickView::MiniTiff::LoadRegion(bytes.data(), bytes.size(), MakeAlignedContext(), region, 21, 3, 40, 11), S_OK);
+        ExpectRgbaFloatMatches(region, ifd.samplesData, 75, 3, 1.0f, 21, 3);
+        if (region.pixels) _aligned_free(region.pixels);
+    }
+}
+
+TEST(MiniTiffTest, HalfFloatWithAlpha) {
+    // RGBA half samples; alpha is passed through straight
+    SyntheticIfd ifd{50, 12, 0};
+    ifd.samples = 4;
+    ifd.photometric = 2;
+    ifd.bitsPerSample = 16;
+    ifd.sampleFormat = 3;
+    ifd.compression = 8;
+    ifd.predictor = 3;
+    ifd.samplesData = PseudoRandomBytes(static_cast<size_t>(50) * 12 * 4 * 2, 5);
+    std::vector<uint8_t> bytes = BuildSyntheticTiff({ifd}, false);
+
+    QuickView::Codec::DecodeResult result;
+    ASSERT_EQ(QuickView::MiniTiff::Load(bytes.data(), bytes.size(), MakeAlignedContext(), result), S_OK);
+    EXPECT_EQ(result.format, QuickView::PixelFormat::R16G16B16A16_FLOAT);
+    ExpectRgbaFloatMatches(result, ifd.samplesData, 50, 4, static_cast<uint16_t>(0x3C00));
+    if (result.pixels) _aligned_free(result.pixels);
+
+    // Signed integers and floats tagged with the integer predictor stay unsupported
+    ifd.predictor = 2;
+    bytes = BuildSyntheticTiff({ifd}, false);
+    EXPECT_EQ(QuickView::MiniTiff::Load(bytes.data(), bytes.size(), MakeAlignedContext(), result), E_NOTIMPL);
+    ifd.predictor = 1;
+    ifd.sampleFormat = 2;
+    bytes = BuildSyntheticTiff({ifd}, false);
+    EXPECT_EQ(QuickView::MiniTiff::Load(bytes.data(), bytes.size(), MakeAlignedContext(), result), E_NOTIMPL);
+}
+
+// Baseline JPEG (4:2:0 for color) of a tightly packed RGB or gray buffer
+static std::vector<uint8_t> EncodeJpeg(const uint8_t* pixels, int width, int height, bool gray) {
+    tjhandle tj = tj3Init(TJINIT_COMPRESS);
+    tj3Set(tj, TJPARAM_QUALITY, 90);
+    tj3Set(tj, TJPARAM_SUBSAMP, gray ? TJSAMP_GRAY : TJSAMP_420);
+    unsigned char* jpeg = nullptr;
+    size_t jpegSize = 0;
+    const int pf = gray ? TJPF_GRAY : TJPF_RGB;
+    EXPECT_EQ(tj3Compress8(tj, pixels, width, 0, height, pf, &jpeg, &jpegSize), 0);
+    std::vector<uint8_t> out(jpeg, jpeg + jpegSize);
+    tj3Free(jpeg);
+    tj3Destroy(tj);
+    return out;
+}
+
+// Reference decode of a complete JPEG to tightly packed BGRA at 1/scaleDenom
+static std::vector<uint8_t> DecodeJpegBgra(const std::vector<uint8_t>& jpeg, int scaleDenom, int& width, int& height) {
+    tjhandle tj = tj3Init(TJINIT_DECOMPRESS);
+    EXPECT_EQ(tj3DecompressHeader(tj, jpeg.data(), jpeg.size()), 0);
+    const tjscalingfactor sf = {1, scaleDenom};
+    tj3SetScalingFactor(tj, sf);
+    width = TJSCALED(tj3Get(tj, TJPARAM_JPEGWIDTH), sf);
+    height = TJSCALED(tj3Get(tj, TJPARAM_JPEGHEIGHT), sf);
+    std::vector<uint8_t> bgra(static_cast<size_t>(width) * height * 4);
+    EXPECT_EQ(tj3Decompress8(tj, jpeg.data(), jpeg.size(), bgra.data(), width * 4, TJPF_BGRA), 0);
+    tj3Destroy(tj);
+    return bgra;
+}
+
+// Moves DQT/DHT segments into a JPEGTables stream, leaving the abbreviated unit stream
+static std::vector<uint8_t> SplitJpegTables(const std::vector<uint8_t>& jpeg, std::vector<uint8_t>& tables) {
+    tables = {0xFF, 0xD8};
+    std::vector<uint8_t> unit = {0xFF, 0xD8};
+    size_t pos = 2;
+    while (pos + 4 <= jpeg.size() && jpeg[pos] == 0xFF && jpeg[pos + 1] != 0xDA) {
+        const size_t len = 2 + ((static_cast<size_t>(jpeg[pos + 2]) << 8) | jpeg[pos + 3]);
+        std::vector<uint8_t>& dst = (jpeg[pos + 1] == 0xDB || jpeg[pos + 1] == 0xC4) ? tables : unit;
+        dst.insert(dst.end(), jpeg.begin() + pos, jpeg.begin() + pos + len);
+        pos += len;
+    }
+    unit.insert(unit.end(), jpeg.begin() + pos, jpeg.end());
+    tables.push_back(0xFF);
+    tables.push_back(0xD9);
+    return unit;
+}
+
+// Smooth content so chroma subsampling and DCT scaling see photo-like blocks
+static std::vector<uint8_t> MakeSmoothRgb(int width, int height, int channels, uint32_t seed) {
+    std::vector<uint8_t> v(static_cast<size_t>(width) * height * channels);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            for (int c = 0; c < channels; ++c) {
+                seed = seed * 1664525u + 1013904223u;
+                v[(static_cast<size_t>(y) * width + x) * channels + c] =
+                    static_cast<uint8_t>((x * (c + 2) + y * 3) / 2 + (seed >> 29));
+            }
+        }
+    }
+    return v;
+}
+
+// Tiled YCbCr JPEG TIFF with shared JPEGTables; the expected image is assembled from
+// reference decodes of the complete per-tile JPEGs.
+struct JpegTiledFixture {
+    static constexpr int kWidth = 200;
+    static constexpr int kHeight = 136;
+    static constexpr int kTile = 64;
+    static constexpr int kCols = (kWidth + kTile - 1) / kTile;
+    static constexpr int kRows = (kHeight + kTile - 1) / kTile;
+
+    std::vector<uint8_t> file;
+    std::vector<std::vector<uint8_t>> tileJpegs;
+
+    JpegTiledFixture() {
+        SyntheticIfd ifd{kWidth, kHeight, 0};
+        ifd.samples = 3;
+        ifd.photometric = 6;
+        ifd.compression = 7;
+        ifd.tileSize = kTile;
+        for (int ty = 0; ty < kRows; ++ty) {
+            for (int tx = 0; tx < kCols; ++tx) {
+                std::vector<uint8_t> tile = MakeSmoothRgb(kTile, kTile, 3, ty * kCols + tx + 1);
+                tileJpegs.push_back(EncodeJpeg(tile.data(), kTile, kTile, false));
+                ifd.encodedUnits.push_back(SplitJpegTables(tileJpegs.back(), ifd.jpegTables));
+            }
+        }
+        file = BuildSyntheticTiff({ifd}, false);
+    }
+
+    // Reference crop (in 1/scaleDenom pixels) as tightly packed BGRA
+    std::vector<uint8_t> Expected(int scaleDenom, int x0, int y0, int w, int h) const {
+        std::vector<uint8_t> out(static_cast<size_t>(w) * h * 4);
+        const int step = kTile / scaleDenom;
+        for (int t = 0; t < kCols * kRows; ++t) {
+            int tw = 0, th = 0;
+            std::vector<uint8_t> tile = DecodeJpegBgra(tileJpegs[t], scaleDenom, tw, th);
+            for (int y = 0; y < th; ++y) {
+                for (int x = 0; x < tw; ++x) {
+                    const int gx = (t % kCols) * step + x - x0;
+                    const int gy = (t / kCols) * step + y - y0;
+                    if (gx < 0 || gy < 0 || gx >= w || gy >= h) continue;
+                    std::memcpy(&out[(static_cast<size_t>(gy) * w + gx) * 4], &tile[(static_cast<size_t>(y) * tw + x) * 4], 4);
+                }
+            }
+        }
+        return out;
+    }
+};
+
+static void ExpectBgraMatches(const QuickView::Codec::DecodeResult& result, const std::vector<uint8_t>& expected) {
+    for (int y = 0; y < result.height; ++y) {
+        ASSERT_EQ(std::memcmp(result.pixels + static_cast<size_t>(y) * result.stride,
+                              &expected[static_cast<size_t>(y) * result.width * 4], static_cast<size_t>(result.width) * 4), 0)
+            << "y=" << y;
+    }
+}
+
+TEST(MiniTiffTest, JpegTilesWithTables) {
+    const JpegTiledFixture fx;
+
+    QuickView::Codec::DecodeResult full;
+    ASSERT_EQ(QuickView::MiniTiff::Load(fx.file.data(), fx.file.size(), MakeAlignedContext(), full), S_OK);
+    EXPECT_EQ(full.width, fx.kWidth);
+    EXPECT_EQ(full.height, fx.kHeight);
+    EXPECT_NE(full.metadata.FormatDetails.find(L"JPEG"), std::wstring::npos);
+    ExpectBgraMatches(full, fx.Expected(1, 0, 0, fx.kWidth, fx.kHeight));
+    if (full.pixels) _aligned_free(full.pixels);
+
+    QuickView::Codec::DecodeResult region;
+    ASSERT_EQ(QuickView::MiniTiff::LoadRegion(fx.file.data(), fx.file.size(), MakeAlignedContext(), region, 37, 21, 120, 90), S_OK);
+    EXPECT_EQ(region.width, 120);
+    EXPECT_EQ(region.height, 90);
+    ExpectBgraMatches(region, fx.Expected(1, 37, 21, 120, 90));
+    if (region.pixels) _aligned_free(region.pixels);
+}
+
+TEST(MiniTiffTest, JpegRegionUsesDctScaling) {
+    const JpegTiledFixture fx;
+
+    // 1/2, 1/4 and 1/8 come straight from the IDCT; the crop expands outward
+    for (int denom : {2, 4, 8}) {
+        QuickView::Codec::DecodeResult region;
+        QuickView::MiniTiff::RegionWindow window;
+        ASSERT_EQ(QuickView::MiniTiff::LoadRegion(fx.file.data(), fx.file.size(), MakeAlignedContext(), region,
+                                                  37, 21, 120, 90, 1.0f / denom, &window), S_OK);
+        const int x0 = 37 / denom, y0 = 21 / denom;
+        const int x1 = (157 + denom - 1) / denom, y1 = (111 + denom - 1) / denom;
+        EXPECT_EQ(region.width, x1 - x0) << "denom=" << denom;
+        EXPECT_EQ(region.height, y1 - y0) << "denom=" << denom;
+        // IDCT scaling widens the crop to whole 1/denom pixels too
+        EXPECT_DOUBLE_EQ(window.x, 37.0 / denom - x0) << "denom=" << denom;
+        EXPECT_DOUBLE_EQ(window.y, 21.0 / denom - y0) << "denom=" << denom;
+        EXPECT_DOUBLE_EQ(window.width, 120.0 / denom) << "denom=" << denom;
+        EXPECT_DOUBLE_EQ(window.height, 90.0 / denom) << "denom=" << denom;
+        EXPECT_EQ(region.metadata.Width, static_cast<UINT>(fx.kWidth));
+        EXPECT_NE(region.metadata.FormatDetails.find(L"DCT 1/" + std::to_wstring(denom)), std::wstring::npos);
+        ExpectBgraMatches(region, fx.Expected(denom, x0, y0, region.width, region.height));
+        if (region.pixels) _aligned_free(region.pixels);
+    }
+
+    // Between steps the finer one is kept (0.3 needs at least 1/2)
+    QuickView::Codec::DecodeResult coarse;
+    ASSERT_EQ(QuickView::MiniTiff::LoadRegion(fx.file.data(), fx.file.size(), MakeAlignedContext(), coarse, 0, 0, 128, 128, 0.3f), S_OK);
+    EXPECT_EQ(coarse.width, 64);
+    if (coarse.pixels) _aligned_free(coarse.pixels);
+}
+
+TEST(MiniTiffTest, JpegGrayStripsWithoutTables) {
+    constexpr int kWidth = 90, kHeight = 40, kRows = 16;
+    SyntheticIfd ifd{kWidth, kHeight, 0};
+    ifd.compression = 7;
+    ifd.rowsPerStrip = kRows;
+    const std::vector<uint8_t> gray = MakeSmoothRgb(kWidth, kHeight, 1, 3);
+    std::vector<uint8_t> expected;
+    for (int y0 = 0; y0 < kHeight; y0 += kRows) {
+        const int rows = (std::min)(kRows, kHeight - y0);
+        ifd.encodedUnits.push_back(EncodeJpeg(gray.data() + static_cast<size_t>(y0) * kWidth, kWidth, rows, true));
+        int w = 0, h = 0;
+        std::vector<uint8_t> strip = DecodeJpegBgra(ifd.encodedUnits.back(), 1, w, h);
+        expected.insert(expected.end(), strip.begin(), strip.end());
+    }
+    std::vector<uint8_t> bytes = BuildSyntheticTiff({ifd}, false);
+
+    QuickView::Codec::DecodeResult result;
+    ASSERT_EQ(QuickView::MiniTiff::Load(bytes.data(), bytes.size(), MakeAlignedContext(), result), S_OK);
+    ExpectBgraMatches(result, expected);
+    if (result.pixels) _aligned_free(result.pixels);
+}
+
+// Differential fuzz: the table-driven decoder must agree with the prefix-chain reference
+// on intact, truncated, bit-flipped and random streams, for short and long outputs.
+TEST(MiniTiffTest, LzwMatchesReferenceDecoder) {
+    uint32_t seed = 0xC0FFEEu;
+    auto next = [&]() { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+
+    for (int iter = 0; iter < 1500; ++iter) {
+        // Mix of runs (long dictionary strings, KwKwK) and noise (dictionary resets)
+        std::vector<uint8_t> plain(1 + next() % 20000);
+        const uint32_t alphabet = 1 + next() % 256;
+        for (size_t i = 0; i < plain.size();) {
+            const size_t run = (std::min<size_t>)(1 + next() % 64, plain.size() - i);
+            const uint8_t v = static_cast<uint8_t>(next() % alphabet);
+            for (size_t r = 0; r < run; ++r) plain[i++] = (next() % 4 == 0) ? static_cast<uint8_t>(next() % alphabet) : v;
+        }
+
+        std::vector<uint8_t> stream = QuickView::Testing::EncodeTiffLzw(plain.data(), plain.size());
+        size_t dstLen = plain.size();
+        switch (iter % 5) {
+            case 0: break; // Intact
+            case 1: dstLen = 1 + next() % (plain.size() + 64); break;
+            case 2: stream.resize(1 + next() % stream.size()); break;
+            case 3:
+                for (int f = 0; f < 1 + static_cast<int>(next() % 4); ++f) {
+                    stream[next() % stream.size()] ^= static_cast<uint8_t>(1u << (next() % 8));
+                }
+                break;
+            case 4:
+                for (auto& b : stream) b = static_cast<uint8_t>(next());
+                break;
+        }
+
+        std::vector<uint8_t> expected(dstLen, 0xAB), actual(dstLen, 0xCD);
+        const bool refOk = QuickView::MiniTiff::DecompressLzwReference(stream.data(), stream.size(), expected.data(), dstLen);
+        const bool ok = QuickView::MiniTiff::DecompressLzw(stream.data(), stream.size(), actual.data(), dstLen);
+        ASSERT_EQ(ok, refOk) << "iter=" << iter;
+        if (ok) {
+            ASSERT_EQ(actual, expected) << "iter=" << iter;
+        }
+        if (iter % 5 == 0) {
+            ASSERT_TRUE(ok);
+            ASSERT_EQ(actual, plain) << "iter=" << iter;
+        }
+    }
+
+    uint8_t out[16];
+    EXPECT_FALSE(QuickView::MiniTiff::DecompressLzw(nullptr, 0, out, sizeof(out)));
+}
+
 TEST(MiniTiffTest, LoadUncompressedRGB) {
     std::wstring path = L"../../../Local-Files/test_img/格式测试/tiff-rgb24.tiff";
     std::vector<uint8_t> bytes = ReadFileBytes(path);
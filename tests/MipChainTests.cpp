@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include "MipChain.h"
+#include "ImageLoaderSimd.h"
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <vector>
+
+// Mip chain: exact 2x2 box kernel, quadrant placement, recursive builds from finer LODs
+
+using namespace QuickView;
+
+namespace {
+
+constexpr int kStride = TILE_SIZE * 4;
+
+std::vector<uint8_t> RandomBgra(int w, int h, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> px(static_cast<size_t>(w) * h * 4);
+    for (auto& v : px) v = static_cast<uint8_t>(rng());
+    return px;
+}
+
+// Reference 2x2 mean with rounding; odd edges repeat the last column / row
+std::vector<uint8_t> ReferenceDownsample(const std::vector<uint8_t>& src, int w, int h) {
+    const int dw = (w + 1) / 2, dh = (h + 1) / 2;
+    std::vector<uint8_t> dst(static_cast<size_t>(dw) * dh * 4);
+    auto at = [&](int x, int y, int c) { return src[(static_cast<size_t>(y) * w + x) * 4 + c]; };
+    for (int y = 0; y < dh; ++y) {
+        const int y0 = y * 2, y1 = (std::min)(y * 2 + 1, h - 1);
+        for (int x = 0; x < dw; ++x) {
+            const int x0 = x * 2, x1 = (std::min)(x * 2 + 1, w - 1);
+            for (int c = 0; c < 4; ++c) {
+                dst[(static_cast<size_t>(y) * dw + x) * 4 + c] =
+                    static_cast<uint8_t>((at(x0, y0, c) + at(x1, y0, c) + at(x0, y1, c) + at(x1, y1, c) + 2) >> 2);
+            }
+        }
+    }
+    return dst;
+}
+
+// Slices a whole image into the zero-padded LOD tiles TileManager would hold
+class TileStore {
+public:
+    TileStore(const std::vector<uint8_t>& image, int w, int h, int lod) {
+        const int tilesX = (w + TILE_SIZE - 1) / TILE_SIZE;
+        const int tilesY = (h + TILE_SIZE - 1) / TILE_SIZE;
+        for (int ty = 0; ty < tilesY; ++ty) {
+            for (int tx = 0; tx < tilesX; ++tx) {
+                auto frame = std::make_shared<RawImageFrame>();
+                auto* px = static_cast<uint8_t*>(std::calloc(TILE_SLAB_SIZE, 1));
+                const int cw = (std::min)(TILE_SIZE, w - tx * TILE_SIZE);
+                const int ch = (std::min)(TILE_SIZE, h - ty * TILE_SIZE);
+                for (int y = 0; y < ch; ++y) {
+                    std::memcpy(px + static_cast<size_t>(y) * kStride,
+                                image.data() + ((static_cast<size_t>(ty) * TILE_SIZE + y) * w + tx * TILE_SIZE) * 4,
+                                static_cast<size_t>(cw) * 4);
+                }
+                frame->pixels = px;
+                frame->width = TILE_SIZE;
+                frame->height = TILE_SIZE;
+                frame->stride = kStride;
+                frame->format = PixelFormat::BGRA8888;
+                frame->memoryDeleter.pfn = [](uint8_t* p, void*) { std::free(p); };
+                m_tiles[TileKey::From(tx, ty, lod).key] = std::move(frame);
+            }
+        }
+    }
+
+    void Drop(TileKey key) { m_tiles.erase(key.key); }
+
+    MipChain::TileFetch Fetch() const {
+        return [this](TileKey key) -> std::shared_ptr<RawImageFrame> {
+            auto it = m_tiles.find(key.key);
+            return it == m_tiles.end() ? nullptr : it->second;
+        };
+    }
+
+private:
+    std::map<uint64_t, std::shared_ptr<RawImageFrame>> m_tiles;
+};
+
+// Content of `tile` matches the reference level and its padding is zero
+void ExpectTileMatches(const RawImageFrame& tile, const std::vector<uint8_t>& level, int levelW, int levelH,
+                       int tx, int ty) {
+    for (int y = 0; y < TILE_SIZE; ++y) {
+        const int ly = ty * TILE_SIZE + y;
+        for (int x = 0; x < TILE_SIZE; ++x) {
+            const int lx = tx * TILE_SIZE + x;
+            const uint8_t* got = tile.pixels + static_cast<size_t>(y) * tile.stride + x * 4;
+            for (int c = 0; c < 4; ++c) {
+                const uint8_t want = (lx < levelW && ly < levelH)
+                    ? level[(static_cast<size_t>(ly) * levelW + lx) * 4 + c] : 0;
+                ASSERT_EQ(got[c], want) << "x=" << x << " y=" << y << " c=" << c;
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST(MipChainTests, Downsample2xMatchesReference) {
+    const int sizes[][2] = { {1, 1}, {2, 2}, {3, 5}, {17, 9}, {64, 3}, {513, 511}, {1000, 7} };
+    for (const auto& s : sizes) {
+        const auto src = RandomBgra(s[0], s[1], static_cast<uint32_t>(s[0] * 31 + s[1]));
+        const auto want = ReferenceDownsample(src, s[0], s[1]);
+        std::vector<uint8_t> got(want.size(), 0xCD);
+        ImageLoaderSimd::Downsample2x(src.data(), s[0], s[1], 0, got.data(), 0);
+        ASSERT_EQ(got, want) << s[0] << "x" << s[1];
+    }
+}
+
+TEST(MipChainTests, Downsample2xHonorsStrides) {
+    const int w = 101, h = 37, srcStride = w * 4 + 52, dstStride = 51 * 4 + 12;
+    const auto packed = RandomBgra(w, h, 7);
+    std::vector<uint8_t> src(static_cast<size_t>(srcStride) * h, 0xEE);
+    for (int y = 0; y < h; ++y) {
+        std::memcpy(src.data() + static_cast<size_t>(y) * srcStride, packed.data() + static_cast<size_t>(y) * w * 4, w * 4);
+    }
+    std::vector<uint8_t> dst(static_cast<size_t>(dstStride) * 19, 0xAB);
+    ImageLoaderSimd::Downsample2x(src.data(), w, h, srcStride, dst.data(), dstStride);
+
+    const auto want = ReferenceDownsample(packed, w, h);
+    for (int y = 0; y < 19; ++y) {
+        ASSERT_EQ(std::memcmp(dst.data() + static_cast<size_t>(y) * dstStride, want.data() + static_cast<size_t>(y) * 51 * 4, 51 * 4), 0);
+        for (int b = 51 * 4; b < dstStride; ++b) ASSERT_EQ(dst[static_cast<size_t>(y) * dstStride + b], 0xAB);
+    }
+}
+
+TEST(MipChainTests, TileContentSizeFollowsLayerGeometry) {
+    int w = 0, h = 0;
+    MipChain::TileContentSize(1500, 700, TileKey::From(2, 1, 0), &w, &h);
+    EXPECT_EQ(w, 1500 - 1024);
+    EXPECT_EQ(h, 700 - 512);
+    MipChain::TileContentSize(1500, 700, TileKey::From(1, 0, 1), &w, &h); // Layer is 750 x 350
+    EXPECT_EQ(w, 750 - 512);
+    EXPECT_EQ(h, 350);
+    MipChain::TileContentSize(1500, 700, TileKey::From(2, 0, 1), &w, &h);
+    EXPECT_EQ(w, 0);
+}
+
+TEST(MipChainTests, BuildsFromChildrenWithEdges) {
+    // LOD 0 is 3 x 2 tiles with partial edges; LOD 1 is 2 x 1 tiles
+    const int w = 1300, h = 700;
+    const auto image = RandomBgra(w, h, 11);
+    const auto lod1 = ReferenceDownsample(image, w, h);
+    TileStore store(image, w, h, 0);
+    TileMemoryManager memory(16);
+
+    for (int tx = 0; tx < 2; ++tx) {
+        RawImageFrame tile;
+        ASSERT_TRUE(MipChain::BuildFromDescendants(TileKey::From(tx, 0, 1), w, h, store.Fetch(), memory, tile));
+        ASSERT_EQ(tile.width, TILE_SIZE);
+        ASSERT_EQ(tile.stride, kStride);
+        ExpectTileMatches(tile, lod1, (w + 1) / 2, (h + 1) / 2, tx, 0);
+    }
+}
+
+TEST(MipChainTests, RecursesThroughMissingLevels) {
+    // LOD 2 tile (0, 0) from LOD 0 only: every LOD 1 child is built in a temporary slab
+    const int w = 2048, h = 1536;
+    const auto image = RandomBgra(w, h, 13);
+    const auto lod1 = ReferenceDownsample(image, w, h);
+    const auto lod2 = ReferenceDownsample(lod1, w / 2, h / 2);
+    TileStore store(image, w, h, 0);
+    TileMemoryManager memory(16);
+
+    RawImageFrame tile;
+    ASSERT_FALSE(MipChain::BuildFromDescendants(TileKey::From(0, 0, 2), w, h, store.Fetch(), memory, tile, 1));
+    ASSERT_TRUE(MipChain::BuildFromDescendants(TileKey::From(0, 0, 2), w, h, store.Fetch(), memory, tile, 2));
+    ExpectTileMatches(tile, lod2, w / 4, h / 4, 0, 0);
+}
+
+TEST(MipChainTests, FailsWhenADescendantIsMissing) {
+    const int w = 1024, h = 1024;
+    TileStore store(RandomBgra(w, h, 17), w, h, 0);
+    store.Drop(TileKey::From(1, 1, 0));
+    TileMemoryManager memory(16);
+
+    RawImageFrame tile;
+    EXPECT_FALSE(MipChain::BuildFromDescendants(TileKey::From(0, 0, 1), w, h, store.Fetch(), memory, tile));
+    EXPECT_EQ(tile.pixels, nullptr);
+    EXPECT_FALSE(MipChain::BuildFromDescendants(TileKey::From(0, 0, 0), w, h, store.Fetch(), memory, tile));
+    EXPECT_EQ(memory.GetUsed(), 0u);
+}
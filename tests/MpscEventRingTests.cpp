@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "MpscEventRing.h"
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Lock-free result channel between HeavyLanePool workers and PollState
+
+using QuickView::MpscEventRing;
+
+namespace {
+
+struct TestTag {
+    size_t imageId = 0;
+    bool isTile = false;
+};
+
+struct TestEvent {
+    int id = 0;
+    std::shared_ptr<int> payload;
+};
+
+auto NeverStale = [](const TestTag&) { return false; };
+
+} // namespace
+
+TEST(MpscEventRingTest, DrainsInPublicationOrder) {
+    MpscEventRing<TestEvent, TestTag> ring(8);
+    for (int i = 0; i < 5; ++i) {
+        TestEvent e{ i, nullptr };
+        ASSERT_TRUE(ring.TryPush(e, TestTag{ 1, true }));
+    }
+
+    std::vector<int> ids;
+    const size_t dropped = ring.Drain(NeverStale, [&](TestEvent&& e, const TestTag&) { ids.push_back(e.id); });
+    EXPECT_EQ(dropped, 0u);
+    EXPECT_EQ(ids, (std::vector<int>{ 0, 1, 2, 3, 4 }));
+    EXPECT_TRUE(ring.EmptyApprox());
+}
+
+TEST(MpscEventRingTest, FullRingRejectsWithoutConsumingValue) {
+    MpscEventRing<TestEvent, TestTag> ring(3);
+    ASSERT_EQ(ring.Capacity(), 4u); // Rounded up to a power of two
+    for (int i = 0; i < 4; ++i) {
+        TestEvent e{ i, nullptr };
+        ASSERT_TRUE(ring.TryPush(e, TestTag{}));
+    }
+
+    TestEvent extra{ 99, std::make_shared<int>(7) };
+    EXPECT_FALSE(ring.TryPush(extra, TestTag{}));
+    ASSERT_TRUE(extra.payload); // Caller keeps it for the fallback path
+
+    // Draining frees the slots and the ring wraps
+    ring.Drain(NeverStale, [](TestEvent&&, const TestTag&) {});
+    EXPECT_TRUE(ring.TryPush(extra, TestTag{}));
+    int last = -1;
+    ring.Drain(NeverStale, [&](TestEvent&& e, const TestTag&) { last = e.id; });
+    EXPECT_EQ(last, 99);
+}
+
+TEST(MpscEventRingTest, StaleEventsReleasedOnDrain) {
+    MpscEventRing<TestEvent, TestTag> ring(16);
+    auto pixels = std::make_shared<int>(0);
+    for (int i = 0; i < 6; ++i) {
+        TestEvent e{ i, pixels };
+        // Even ids belong to the old image
+        ASSERT_TRUE(ring.TryPush(e, TestTag{ (size_t)(i % 2 == 0 ? 1 : 2), true }));
+    }
+    TestEvent full{ 6, pixels };
+    ASSERT_TRUE(ring.TryPush(full, TestTag{ 1, false })); // Non-tile results always pass
+    EXPECT_EQ(pixels.use_count(), 8);
+
+    std::vector<int> ids;
+    const size_t dropped = ring.Drain([](const TestTag& t) { return t.isTile && t.imageId != 2; },
+                                      [&](TestEvent&& e, const TestTag&) { ids.push_back(e.id); });
+    EXPECT_EQ(dropped, 3u);
+    EXPECT_EQ(ids, (std::vector<int>{ 1, 3, 5, 6 }));
+    EXPECT_EQ(pixels.use_count(), 1); // Nothing lingers in the slots
+}
+
+TEST(MpscEventRingTest, ConcurrentProducersLoseNothing) {
+    constexpr int kProducers = 8;
+    constexpr int kPerProducer = 5000;
+    MpscEventRing<TestEvent, TestTag> ring(64);
+    std::vector<int> lastSeen(kProducers, -1);
+    int received = 0;
+    bool ordered = true;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&ring, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                TestEvent e{ p * kPerProducer + i, nullptr };
+                while (!ring.TryPush(e, TestTag{ (size_t)p, true })) std::this_thread::yield();
+            }
+        });
+    }
+
+    auto sink = [&](TestEvent&& e, const TestTag& tag) {
+        const int seq = e.id - (int)tag.imageId * kPerProducer;
+        if (seq <= lastSeen[tag.imageId]) ordered = false; // Per-producer FIFO
+        lastSeen[tag.imageId] = seq;
+        received++;
+    };
+    while (received < kProducers * kPerProducer) {
+        if (ring.Drain(NeverStale, sink) == 0 && ring.EmptyApprox()) std::this_thread::yield();
+    }
+    for (auto& t : producers) t.join();
+
+    EXPECT_EQ(received, kProducers * kPerProducer);
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(ring.EmptyApprox());
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "PathTable.h"
+#include <algorithm>
+#include <cwctype>
+#include <set>
+#include <thread>
+
+// Interned path table: hash compatibility, view stability and arena layout
+
+using QuickView::PathRef;
+using QuickView::PathTable;
+
+namespace {
+
+ImageID LoweredCopyHash(const std::wstring& path) {
+    std::wstring normalized = path;
+    std::transform(normalized.begin(), normalized.end(), normalized.begin(), ::towlower);
+    return std::hash<std::wstring>{}(normalized);
+}
+
+} // namespace
+
+TEST(PathTableTests, ComputePathHashMatchesLoweredCopy) {
+    const std::wstring path = L"C:\\Photos\\2025\\Trip\\IMG_0042.JPG";
+    EXPECT_EQ(ComputePathHash(path), LoweredCopyHash(path));
+    EXPECT_EQ(ComputePathHash(path), ComputePathHash(L"c:\\photos\\2025\\trip\\img_0042.jpg"));
+    EXPECT_NE(ComputePathHash(path), ComputePathHash(L"C:\\Photos\\2025\\Trip\\IMG_0043.JPG"));
+
+    // Longer than the stack buffer: falls back to a copy, same value
+    const std::wstring deep = L"\\\\?\\D:\\" + std::wstring(700, L'A') + L"\\Frame.PNG";
+    EXPECT_EQ(ComputePathHash(deep), LoweredCopyHash(deep));
+}
+
+TEST(PathTableTests, InternIsStableAndNullTerminated) {
+    PathTable table;
+    std::wstring source = L"D:\\Shots\\a.png";
+    const PathRef first = table.Intern(source);
+    source.assign(L"overwritten......................"); // The table owns its copy
+
+    EXPECT_EQ(first.id, ComputePathHash(L"D:\\Shots\\a.png"));
+    EXPECT_EQ(first.path, L"D:\\Shots\\a.png");
+    EXPECT_EQ(first.path.data()[first.path.size()], L'\0');
+    EXPECT_STREQ(first.c_str(), L"D:\\Shots\\a.png");
+
+    const PathRef again = table.Intern(L"D:\\Shots\\a.png");
+    EXPECT_EQ(again.id, first.id);
+    EXPECT_EQ(again.path.data(), first.path.data());
+    EXPECT_EQ(table.GetStats().entries, 1u);
+}
+
+TEST(PathTableTests, CaseVariantsShareFirstSpelling) {
+    PathTable table;
+    const PathRef upper = table.Intern(L"E:\\Scans\\PAGE1.TIF");
+    const PathRef lower = table.Intern(L"e:\\scans\\page1.tif");
+    EXPECT_EQ(lower.id, upper.id);
+    EXPECT_EQ(lower.path, L"E:\\Scans\\PAGE1.TIF");
+}
+
+TEST(PathTableTests, EmptyPathIsNotInterned) {
+    PathTable table;
+    const PathRef ref = table.Intern(L"");
+    EXPECT_TRUE(ref.empty());
+    EXPECT_EQ(ref.id, 0u);
+    EXPECT_STREQ(ref.c_str(), L"");
+    EXPECT_EQ(table.GetStats().entries, 0u);
+}
+
+TEST(PathTableTests, FindReturnsInternedSpelling) {
+    PathTable table;
+    const PathRef ref = table.Intern(L"F:\\x.jxl");
+    EXPECT_EQ(table.Find(ref.id).data(), ref.path.data());
+    EXPECT_TRUE(table.Find(ComputePathHash(L"F:\\never.jxl")).empty());
+}
+
+TEST(PathTableTests, BlocksSpillAndLongPathsGetTheirOwn) {
+    PathTable table;
+    std::vector<PathRef> refs;
+    // ~60 chars each: several shared blocks
+    for (int i = 0; i < 2000; ++i) {
+        refs.push_back(table.Intern(L"C:\\Users\\Someone\\Pictures\\Holiday\\Day" + std::to_wstring(i) + L"\\IMG.JPG"));
+    }
+    const auto shared = table.GetStats();
+    EXPECT_EQ(shared.entries, 2000u);
+    EXPECT_GT(shared.blocks, 1u);
+
+    const std::wstring longPath = L"\\\\?\\G:\\" + std::wstring(PathTable::kBlockChars / 2, L'x') + L".png";
+    const PathRef big = table.Intern(longPath);
+    EXPECT_EQ(big.path, longPath);
+    EXPECT_EQ(table.GetStats().blocks, shared.blocks + 1);
+
+    // The shared block keeps filling after the dedicated one
+    table.Intern(L"C:\\after.png");
+    EXPECT_EQ(table.GetStats().blocks, shared.blocks + 1);
+
+    // Earlier views are untouched by growth
+    for (int i = 0; i < 2000; ++i) {
+        EXPECT_EQ(refs[i].path, L"C:\\Users\\Someone\\Pictures\\Holiday\\Day" + std::to_wstring(i) + L"\\IMG.JPG");
+    }
+}
+
+TEST(PathTableTests, ConcurrentInternAgreesOnOneCopy) {
+    PathTable table;
+    constexpr int kThreads = 8;
+    constexpr int kPaths = 500;
+    std::vector<std::vector<const wchar_t*>> seen(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kPaths; ++i) {
+                const int n = (i * 7 + t) % kPaths;
+                seen[t].push_back(table.Intern(L"H:\\burst\\" + std::to_wstring(n) + L".cr3").path.data());
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    EXPECT_EQ(table.GetStats().entries, (size_t)kPaths);
+    std::set<const wchar_t*> distinct;
+    for (const auto& v : seen) distinct.insert(v.begin(), v.end());
+    EXPECT_EQ(distinct.size(), (size_t)kPaths);
+}
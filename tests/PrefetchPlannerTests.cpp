@@ -0,0 +1,430 @@
+#include <gtest/gtest.h>
+#include "PrefetchPlanner.h"
+#include <cstdio>
+#include <deque>
+#include <random>
+
+// Velocity-aware prefetch planning: rate / cost estimation, tier choice, and a
+// deterministic replay of navigation traces against the old fixed window
+
+using QuickView::PrefetchCandidate;
+using QuickView::PrefetchJob;
+using QuickView::PrefetchPlanInput;
+using QuickView::PrefetchPlanner;
+using QuickView::PrefetchTier;
+using QuickView::Priority;
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Discrete-event model of ImageEngine's serial prefetch lane
+// ----------------------------------------------------------------------------
+struct SimImage {
+    std::wstring format;
+    double megapixels;
+    bool canScale;
+    bool hasPreview;
+};
+
+// "True" decoder costs the planner has to learn (with +-15% jitter)
+double TrueCostMs(const SimImage& img, PrefetchTier tier) {
+    if (img.format == L"JPEG") return tier == PrefetchTier::Full ? 4 + 9.0 * img.megapixels : 4 + 2.2 * img.megapixels;
+    if (img.format == L"ARW") return tier == PrefetchTier::Full ? 6 + 22.0 * img.megapixels : 10;
+    return 4 + 14.0 * img.megapixels; // PNG: full only
+}
+
+struct Step {
+    double atMs;
+    int index;
+};
+
+struct SimResult {
+    int navigations = 0;
+    int fullHits = 0;     // Full decode ready on arrival
+    int previewHits = 0;  // Placeholder tier ready on arrival
+    double waitMs = 0.0;  // Sum of time-to-first-pixels over misses
+
+    int Hits() const { return fullHits + previewHits; }
+    double HitRate() const { return navigations ? (double)Hits() / navigations : 0.0; }
+    double MeanMissWaitMs() const { return navigations > Hits() ? waitMs / (navigations - Hits()) : 0.0; }
+};
+
+// Lanes as in ImageEngine: the image on screen decodes on its own heavy worker and
+// is cancelled when the user moves on (CancelOthers). Prefetch is serial and only
+// starts while nothing else decodes (PumpPrefetch). The fixed window loses its
+// running prefetch on every navigation; the planner keeps the ones its new plan
+// still lists (RetainPrefetch).
+class Simulator {
+public:
+    enum class Strategy { FixedWindow, Planner };
+
+    Simulator(std::vector<SimImage> folder, Strategy strategy, uint32_t seed)
+        : m_folder(std::move(folder)), m_strategy(strategy), m_rng(seed), m_ready(m_folder.size(), -1) {}
+
+    SimResult Run(const std::vector<Step>& trace) {
+        SimResult r;
+        for (const Step& s : trace) Navigate(s.atMs, s.index, r);
+        AdvanceTo(trace.back().atMs + 60000.0, r);
+        return r;
+    }
+
+private:
+    struct Job {
+        int index;
+        PrefetchTier tier;
+    };
+    struct Lane {
+        bool busy = false;
+        Job job{};
+        double endMs = 0.0;
+        double durationMs = 0.0;
+    };
+
+    void Navigate(double now, int index, SimResult& r) {
+        AdvanceTo(now, r);
+        CloseWait(now, r);
+        r.navigations++;
+        if (m_ready[index] == (int)PrefetchTier::Full) r.fullHits++;
+        else if (m_ready[index] >= 0) r.previewHits++;
+        else { m_waiting = true; m_waitStart = now; }
+
+        const int previous = m_current;
+        m_current = index;
+        m_queue.clear();    // UpdateView rebuilds the queue
+        m_upgradeAt = -1.0;
+        if (m_critical.busy && m_critical.job.index != index) m_critical.busy = false;
+
+        if (m_strategy == Strategy::FixedWindow) {
+            if (m_prefetch.busy && m_prefetch.job.index != index) m_prefetch.busy = false;
+            if (m_ready[index] < 0 && !Decoding(index)) Start(m_critical, { index, PrefetchTier::Full });
+
+            // The v9.1 queue: +-1 when idle, else adjacent / anti-regret / look-ahead, all full
+            const int delta = previous < 0 ? 0 : index - previous;
+            if (delta != 1 && delta != -1) {
+                Push(index + 1, PrefetchTier::Full);
+                Push(index - 1, PrefetchTier::Full);
+            } else {
+                Push(index + delta, PrefetchTier::Full);
+                Push(index - delta, PrefetchTier::Full);
+                for (int i = 2; i <= kLookAhead; ++i) Push(index + delta * i, PrefetchTier::Full);
+            }
+            return;
+        }
+
+        m_planner.OnNavigate(index, now);
+        const bool rapid = m_planner.GetMode() == PrefetchPlanner::Mode::Rapid;
+        if (m_ready[index] < 0) {
+            if (!Decoding(index)) Start(m_critical, { index, PrefetchTier::Full });
+        } else if (m_ready[index] != (int)PrefetchTier::Full) {
+            // Placeholder on screen: upgrade now, or once the user stops flying past
+            if (rapid) m_upgradeAt = now + 2.0 * m_planner.IntervalMs();
+            else Start(m_critical, { index, PrefetchTier::Full });
+        }
+
+        PrefetchPlanInput in;
+        in.current = index;
+        in.count = (int)m_folder.size();
+        in.maxDepth = kLookAhead;
+        in.budgetBytes = 1024ull << 20;
+        in.screenMegapixels = 2.1;
+        if (m_critical.busy) {
+            in.busyMs = m_planner.EstimateDecodeMs(m_folder[index].format, PrefetchTier::Full, m_folder[index].megapixels);
+        }
+        auto jobs = m_planner.Plan(in, [&](int i) {
+            PrefetchCandidate c;
+            c.format = m_folder[i].format;
+            c.megapixels = m_folder[i].megapixels;
+            c.canScale = m_folder[i].canScale;
+            c.hasPreview = m_folder[i].hasPreview;
+            c.ready = m_ready[i] >= 0;
+            c.inFlight = m_prefetch.busy && m_prefetch.job.index == i;
+            return c;
+        });
+
+        bool keep = m_prefetch.busy && m_prefetch.job.index == index;
+        for (const PrefetchJob& j : jobs) {
+            if (j.inFlight) keep = keep || j.index == m_prefetch.job.index;
+            else Push(j.index, j.tier);
+        }
+        if (!keep) m_prefetch.busy = false;
+    }
+
+    bool Decoding(int index) const {
+        return (m_critical.busy && m_critical.job.index == index) ||
+               (m_prefetch.busy && m_prefetch.job.index == index && m_prefetch.job.tier == PrefetchTier::Full);
+    }
+
+    void Push(int index, PrefetchTier tier) {
+        if (index < 0 || index >= (int)m_folder.size()) return;
+        m_queue.push_back({ index, tier });
+    }
+
+    void Start(Lane& lane, Job job) {
+        std::uniform_real_distribution<double> jitter(0.85, 1.15);
+        lane.busy = true;
+        lane.job = job;
+        lane.durationMs = TrueCostMs(m_folder[job.index], job.tier) * jitter(m_rng);
+        lane.endMs = m_clock + lane.durationMs;
+    }
+
+    void AdvanceTo(double t, SimResult& r) {
+        for (;;) {
+            // PumpPrefetch: serial, only while no other decode runs
+            while (!m_critical.busy && !m_prefetch.busy && !m_queue.empty()) {
+                const Job job = m_queue.front();
+                m_queue.pop_front();
+                if (m_ready[job.index] < (int)job.tier) Start(m_prefetch, job);
+            }
+
+            Lane* next = nullptr;
+            double nextMs = m_upgradeAt >= 0.0 ? m_upgradeAt : 1e300;
+            if (m_critical.busy && m_critical.endMs < nextMs) { next = &m_critical; nextMs = m_critical.endMs; }
+            if (m_prefetch.busy && m_prefetch.endMs < nextMs) { next = &m_prefetch; nextMs = m_prefetch.endMs; }
+            if (nextMs > t) break;
+
+            m_clock = nextMs;
+            if (!next) {
+                m_upgradeAt = -1.0;
+                if (!Decoding(m_current)) Start(m_critical, { m_current, PrefetchTier::Full });
+                continue;
+            }
+            next->busy = false;
+            const Job job = next->job;
+            const SimImage& img = m_folder[job.index];
+            m_ready[job.index] = (std::max)(m_ready[job.index], (int)job.tier);
+            m_planner.RecordDecode(img.format, job.tier, img.megapixels, next->durationMs);
+            if (job.index == m_current) CloseWait(m_clock, r);
+        }
+        m_clock = (std::max)(m_clock, t);
+    }
+
+    void CloseWait(double now, SimResult& r) {
+        if (!m_waiting) return;
+        r.waitMs += now - m_waitStart;
+        m_waiting = false;
+    }
+
+    static constexpr int kLookAhead = 5;
+
+    std::vector<SimImage> m_folder;
+    Strategy m_strategy;
+    std::mt19937 m_rng;
+    PrefetchPlanner m_planner;
+
+    std::vector<int> m_ready; // Best tier decoded per index, -1 = none (cache holds the folder)
+    std::deque<Job> m_queue;
+    Lane m_critical;
+    Lane m_prefetch;
+    double m_upgradeAt = -1.0;
+    double m_clock = 0.0;
+
+    int m_current = -1;
+    bool m_waiting = false;
+    double m_waitStart = 0.0;
+};
+
+// Camera dump: mostly 24 MP JPEGs, every fourth a 45 MP raw with an embedded
+// preview, the odd PNG screenshot
+std::vector<SimImage> MixedFolder(int n) {
+    std::vector<SimImage> f;
+    for (int i = 0; i < n; ++i) {
+        if (i % 4 == 3) f.push_back({ L"ARW", 45.0, false, true });
+        else if (i % 11 == 5) f.push_back({ L"PNG", 3.7, false, false });
+        else f.push_back({ L"JPEG", 24.0, true, false });
+    }
+    return f;
+}
+
+std::vector<Step> Linear(int from, int to, double startMs, double intervalMs, double jitter, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> d(-jitter, jitter);
+    std::vector<Step> trace;
+    double t = startMs;
+    const int step = to >= from ? 1 : -1;
+    for (int i = from;; i += step) {
+        trace.push_back({ t, i });
+        if (i == to) break;
+        t += intervalMs * (1.0 + d(rng));
+    }
+    return trace;
+}
+
+SimResult Replay(const std::vector<SimImage>& folder, Simulator::Strategy s, const std::vector<Step>& trace) {
+    return Simulator(folder, s, 1234).Run(trace);
+}
+
+void Report(const char* name, const SimResult& fixed, const SimResult& planned) {
+    std::printf("  %-14s fixed %5.1f%% (miss wait %6.0f ms)  planner %5.1f%% (full %d, preview %d, miss wait %6.0f ms)\n",
+                name, 100.0 * fixed.HitRate(), fixed.MeanMissWaitMs(), 100.0 * planned.HitRate(),
+                planned.fullHits, planned.previewHits, planned.MeanMissWaitMs());
+}
+
+} // namespace
+
+TEST(PrefetchPlannerTest, EstimatesBrowseRateAndResetsOnPauseOrJump) {
+    PrefetchPlanner p;
+    p.OnNavigate(10, 0.0);
+    EXPECT_EQ(p.GetMode(), PrefetchPlanner::Mode::Idle);
+
+    for (int i = 1; i <= 10; ++i) p.OnNavigate(10 + i, i * 60.0);
+    EXPECT_EQ(p.GetMode(), PrefetchPlanner::Mode::Rapid);
+    EXPECT_EQ(p.Direction(), 1);
+    EXPECT_NEAR(p.IntervalMs(), 60.0, 1.0);
+
+    p.OnNavigate(19, 700.0); // Reversal restarts from the new gap
+    EXPECT_EQ(p.Direction(), -1);
+    EXPECT_NEAR(p.IntervalMs(), 100.0, 1e-9);
+
+    p.OnNavigate(18, 5000.0); // Pause: direction kept, rate dropped
+    EXPECT_EQ(p.GetMode(), PrefetchPlanner::Mode::Idle);
+    EXPECT_EQ(p.Direction(), -1);
+
+    p.OnNavigate(17, 5800.0);
+    EXPECT_EQ(p.GetMode(), PrefetchPlanner::Mode::Browsing);
+    p.OnNavigate(70, 6000.0); // Gallery jump
+    EXPECT_EQ(p.GetMode(), PrefetchPlanner::Mode::Idle);
+    EXPECT_EQ(p.Direction(), 0);
+}
+
+TEST(PrefetchPlannerTest, LearnsDecodeCostPerFormatAndTier) {
+    PrefetchPlanner p;
+    const double prior = p.EstimateDecodeMs(L"JPEG", PrefetchTier::Full, 24.0);
+    EXPECT_GT(prior, 0.0);
+    EXPECT_LT(p.EstimateDecodeMs(L"JPEG", PrefetchTier::Scaled, 24.0), prior);
+
+    for (int i = 0; i < 20; ++i) p.RecordDecode(L"JPEG", PrefetchTier::Full, 24.0, 484.0);
+    EXPECT_NEAR(p.EstimateDecodeMs(L"JPEG", PrefetchTier::Full, 24.0), 484.0, 1.0);
+    EXPECT_NEAR(p.EstimateDecodeMs(L"JPEG", PrefetchTier::Full, 12.0), 244.0, 1.0); // Scales with size
+    EXPECT_NEAR(p.EstimateDecodeMs(L"PNG", PrefetchTier::Full, 24.0), 484.0, 1.0);  // Unknown format: tier average
+
+    p.RecordDecode(L"ARW", PrefetchTier::EmbeddedPreview, 45.0, 9.0); // Flat, not per megapixel
+    EXPECT_NEAR(p.EstimateDecodeMs(L"ARW", PrefetchTier::EmbeddedPreview, 60.0), 9.0, 1e-9);
+}
+
+TEST(PrefetchPlannerTest, PicksCheaperTierOnlyWhenFullMissesArrival) {
+    PrefetchPlanner p;
+    for (int i = 0; i < 5; ++i) p.RecordDecode(L"JPEG", PrefetchTier::Full, 24.0, 220.0);
+    for (int i = 0; i < 5; ++i) p.RecordDecode(L"JPEG", PrefetchTier::Scaled, 24.0, 57.0);
+
+    auto jpeg = [](int) {
+        PrefetchCandidate c;
+        c.format = L"JPEG";
+        c.megapixels = 24.0;
+        c.canScale = true;
+        return c;
+    };
+    PrefetchPlanInput in;
+    in.current = 50;
+    in.count = 200;
+
+    // Slow manual browsing: everything in the window decodes in full, adjacent first
+    for (int i = 0; i <= 4; ++i) p.OnNavigate(46 + i, i * 1500.0);
+    auto jobs = p.Plan(in, jpeg);
+    ASSERT_FALSE(jobs.empty());
+    EXPECT_EQ(jobs[0].index, 51);
+    EXPECT_EQ(jobs[0].priority, Priority::High);
+    for (const auto& j : jobs) EXPECT_EQ(j.tier, PrefetchTier::Full);
+    EXPECT_EQ(jobs.back().index, 49); // Anti-regret step back
+    EXPECT_EQ(jobs.back().priority, Priority::Low);
+
+    // Key held at 45 ms: neighbours that cannot be ready are skipped, the rest scaled
+    PrefetchPlanner fast;
+    for (int i = 0; i < 5; ++i) fast.RecordDecode(L"JPEG", PrefetchTier::Full, 24.0, 220.0);
+    for (int i = 0; i < 5; ++i) fast.RecordDecode(L"JPEG", PrefetchTier::Scaled, 24.0, 57.0);
+    for (int i = 0; i <= 10; ++i) fast.OnNavigate(40 + i, i * 45.0);
+    jobs = fast.Plan(in, jpeg);
+    ASSERT_FALSE(jobs.empty());
+    EXPECT_GT(jobs[0].index, 51);
+    for (const auto& j : jobs) {
+        EXPECT_EQ(j.tier, PrefetchTier::Scaled);
+        EXPECT_LE(j.readyAtMs, j.arrivalMs);
+    }
+
+    // Budget bounds how much the plan may hold
+    in.budgetBytes = 24 * 4000000 + 1;
+    EXPECT_EQ(p.Plan(in, jpeg).size(), 1u);
+}
+
+TEST(PrefetchPlannerTest, SkipsReadyAndCountsInFlightWork) {
+    PrefetchPlanner p;
+    for (int i = 0; i <= 4; ++i) p.OnNavigate(i, i * 800.0);
+    PrefetchPlanInput in;
+    in.current = 4;
+    in.count = 100;
+    auto jobs = p.Plan(in, [](int i) {
+        PrefetchCandidate c;
+        c.format = L"JPEG";
+        c.megapixels = 12.0;
+        c.ready = i == 5;
+        c.inFlight = i == 6;
+        c.skip = i == 7;
+        return c;
+    });
+    ASSERT_GE(jobs.size(), 2u);
+    EXPECT_EQ(jobs[0].index, 6); // Listed so navigation does not cancel it
+    EXPECT_TRUE(jobs[0].inFlight);
+    EXPECT_EQ(jobs[1].index, 8);
+    EXPECT_FALSE(jobs[1].inFlight);
+    EXPECT_GT(jobs[1].readyAtMs, p.EstimateDecodeMs(L"JPEG", PrefetchTier::Full, 12.0)); // Queued behind #6
+    for (const auto& j : jobs) EXPECT_TRUE(j.index != 5 && j.index != 7);
+}
+
+TEST(PrefetchPlannerTest, ReplayedTracesBeatFixedWindow) {
+    const auto folder = MixedFolder(400);
+    using S = Simulator::Strategy;
+
+    struct Trace { const char* name; std::vector<Step> steps; };
+    std::vector<Trace> traces;
+    traces.push_back({ "key hold 60ms", Linear(0, 150, 0.0, 60.0, 0.1, 1) });
+    traces.push_back({ "manual 700ms", Linear(0, 120, 0.0, 700.0, 0.3, 2) });
+    traces.push_back({ "slideshow 3s", Linear(0, 60, 0.0, 3000.0, 0.0, 3) });
+    {
+        // Back and forth: forward bursts with a look back
+        std::vector<Step> s;
+        double t = 0.0;
+        int pos = 100;
+        for (int round = 0; round < 8; ++round) {
+            for (int i = 0; i < 12; ++i) { s.push_back({ t, pos++ }); t += 500.0; }
+            for (int i = 0; i < 4; ++i) { s.push_back({ t, pos-- }); t += 400.0; }
+        }
+        traces.push_back({ "back-forth", s });
+    }
+    {
+        // Gallery: jump, linger, step a little either way
+        std::mt19937 rng(4);
+        std::vector<Step> s;
+        double t = 0.0;
+        for (int round = 0; round < 20; ++round) {
+            int pos = 10 + (int)(rng() % 380);
+            const int dir = rng() % 2 ? 1 : -1;
+            s.push_back({ t, pos });
+            t += 2500.0;
+            for (int i = 0; i < 3; ++i) { pos += dir; s.push_back({ t, pos }); t += 1800.0; }
+        }
+        traces.push_back({ "gallery jumps", s });
+    }
+
+    std::printf("Prefetch hit rate (image ready on arrival), %zu files:\n", folder.size());
+    for (const Trace& tr : traces) {
+        const SimResult fixed = Replay(folder, S::FixedWindow, tr.steps);
+        const SimResult planned = Replay(folder, S::Planner, tr.steps);
+        Report(tr.name, fixed, planned);
+
+        // Deterministic: the same trace replays to the same result
+        const SimResult again = Replay(folder, S::Planner, tr.steps);
+        EXPECT_EQ(again.fullHits, planned.fullHits) << tr.name;
+        EXPECT_EQ(again.previewHits, planned.previewHits) << tr.name;
+
+        EXPECT_GE(planned.Hits(), fixed.Hits()) << tr.name;
+        EXPECT_LE(planned.MeanMissWaitMs(), fixed.MeanMissWaitMs() + 1.0) << tr.name;
+    }
+
+    // Held key: the fixed window decodes what the user has already passed
+    const SimResult fixed = Replay(folder, S::FixedWindow, traces[0].steps);
+    const SimResult planned = Replay(folder, S::Planner, traces[0].steps);
+    EXPECT_GE(planned.HitRate(), fixed.HitRate() + 0.3);
+
+    // Slideshow leaves time for full decodes of everything
+    const SimResult slideshow = Replay(folder, S::Planner, traces[2].steps);
+    EXPECT_GE(slideshow.fullHits, slideshow.navigations - 1);
+}
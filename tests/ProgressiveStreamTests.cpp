@@ -0,0 +1,302 @@
+#include <gtest/gtest.h>
+#include "ProgressiveStream.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+#include <jpeglib.h>
+#include <zlib.h>
+
+// Partial frames from a source that arrives at a throttled rate: time-to-first-pixel,
+// row/scan monotonicity and pixel correctness of what has been shown
+
+using namespace QuickView;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Releases `bytesPerSec` of an in-memory file, like a slow network share
+class ThrottledSource {
+public:
+    ThrottledSource(const std::vector<uint8_t>& bytes, double bytesPerSec)
+        : m_bytes(bytes), m_rate(bytesPerSec), m_start(Clock::now()) {}
+
+    StreamingSource Source() {
+        StreamingSource src;
+        src.data = m_bytes.data();
+        src.size = m_bytes.size();
+        src.ctx = this;
+        src.waitForBytes = [](void* c, size_t bytes) {
+            auto* self = static_cast<ThrottledSource*>(c);
+            for (;;) {
+                const size_t avail = self->Available();
+                if (avail >= bytes || avail == self->m_bytes.size()) return avail;
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        };
+        return src;
+    }
+
+    double TransferMs() const { return m_bytes.size() * 1000.0 / m_rate; }
+    double ElapsedMs() const { return std::chrono::duration<double, std::milli>(Clock::now() - m_start).count(); }
+
+private:
+    size_t Available() const {
+        const double bytes = ElapsedMs() / 1000.0 * m_rate;
+        return bytes >= m_bytes.size() ? m_bytes.size() : (size_t)bytes;
+    }
+
+    const std::vector<uint8_t>& m_bytes;
+    double m_rate;
+    Clock::time_point m_start;
+};
+
+struct Recorded {
+    double atMs;
+    int width, height, rowsReady, rowsFinal, scan, srcWidth;
+    std::vector<uint8_t> pixels;
+};
+
+struct Recorder {
+    ThrottledSource* clock = nullptr;
+    std::vector<Recorded> frames;
+
+    PartialFrameCallback Callback() {
+        PartialFrameCallback cb;
+        cb.ctx = this;
+        cb.pfn = [](void* c, const PartialFrame& f) {
+            auto* self = static_cast<Recorder*>(c);
+            Recorded r{ self->clock->ElapsedMs(), f.width, f.height, f.rowsReady, f.rowsFinal, f.scan, f.srcWidth, {} };
+            r.pixels.assign(f.pixels, f.pixels + (size_t)f.stride * f.height);
+            self->frames.push_back(std::move(r));
+        };
+        return cb;
+    }
+};
+
+std::vector<uint8_t> NoiseRgba(int w, int h, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> px((size_t)w * h * 4);
+    for (size_t i = 0; i < px.size(); ++i) {
+        // Smooth-ish ramp plus noise: compresses, but not to nothing
+        px[i] = (uint8_t)(((i / 4) % w) + (rng() & 63));
+    }
+    return px;
+}
+
+void PutBE32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int s = 24; s >= 0; s -= 8) out.push_back((uint8_t)(v >> s));
+}
+
+void PutChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& payload) {
+    PutBE32(out, (uint32_t)payload.size());
+    const size_t typeAt = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), payload.begin(), payload.end());
+    PutBE32(out, (uint32_t)crc32(0, out.data() + typeAt, (uInt)(payload.size() + 4)));
+}
+
+uint8_t Paeth(int a, int b, int c) {
+    const int p = a + b - c, pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+    return (uint8_t)((pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c));
+}
+
+// 8-bit RGBA, every filter type in rotation so the unfilter paths all run
+std::vector<uint8_t> EncodePng(const std::vector<uint8_t>& rgba, int w, int h, bool interlaced = false) {
+    const size_t rowBytes = (size_t)w * 4;
+    std::vector<uint8_t> raw;
+    for (int y = 0; y < h; ++y) {
+        const uint8_t* cur = rgba.data() + y * rowBytes;
+        const uint8_t* prev = y > 0 ? cur - rowBytes : nullptr;
+        const uint8_t filter = (uint8_t)(y % 5);
+        raw.push_back(filter);
+        for (size_t i = 0; i < rowBytes; ++i) {
+            const int a = i >= 4 ? cur[i - 4] : 0, b = prev ? prev[i] : 0, c = (prev && i >= 4) ? prev[i - 4] : 0;
+            uint8_t pred = 0;
+            switch (filter) {
+                case 1: pred = (uint8_t)a; break;
+                case 2: pred = (uint8_t)b; break;
+                case 3: pred = (uint8_t)((a + b) >> 1); break;
+                case 4: pred = Paeth(a, b, c); break;
+            }
+            raw.push_back((uint8_t)(cur[i] - pred));
+        }
+    }
+    uLongf zlen = compressBound((uLong)raw.size());
+    std::vector<uint8_t> z(zlen);
+    compress2(z.data(), &zlen, raw.data(), (uLong)raw.size(), 6);
+    z.resize(zlen);
+
+    std::vector<uint8_t> png = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+    std::vector<uint8_t> ihdr;
+    PutBE32(ihdr, (uint32_t)w);
+    PutBE32(ihdr, (uint32_t)h);
+    ihdr.insert(ihdr.end(), { 8, 6, 0, 0, (uint8_t)(interlaced ? 1 : 0) });
+    PutChunk(png, "IHDR", ihdr);
+    // Several IDAT chunks, as encoders write them
+    for (size_t off = 0; off < z.size(); off += 8192) {
+        PutChunk(png, "IDAT", std::vector<uint8_t>(z.begin() + off, z.begin() + std::min(z.size(), off + 8192)));
+    }
+    PutChunk(png, "IEND", {});
+    return png;
+}
+
+std::vector<uint8_t> EncodeJpeg(const std::vector<uint8_t>& rgba, int w, int h, bool progressive) {
+    jpeg_compress_struct cinfo;
+    jpeg_error_mgr jerr;
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_compress(&cinfo);
+    unsigned char* out = nullptr;
+    unsigned long outSize = 0;
+    jpeg_mem_dest(&cinfo, &out, &outSize);
+    cinfo.image_width = w;
+    cinfo.image_height = h;
+    cinfo.input_components = 4;
+    cinfo.in_color_space = JCS_EXT_RGBA;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, 92, TRUE);
+    if (progressive) jpeg_simple_progression(&cinfo);
+    jpeg_start_compress(&cinfo, TRUE);
+    while (cinfo.next_scanline < cinfo.image_height) {
+        JSAMPROW row = const_cast<uint8_t*>(rgba.data()) + (size_t)cinfo.next_scanline * w * 4;
+        jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_compress(&cinfo);
+    std::vector<uint8_t> bytes(out, out + outSize);
+    jpeg_destroy_compress(&cinfo);
+    free(out);
+    return bytes;
+}
+
+StreamingOptions FastOptions() {
+    StreamingOptions opts;
+    opts.readStep = 8 * 1024;
+    opts.minIntervalMs = 15;
+    opts.maxPartials = 64;
+    return opts;
+}
+
+} // namespace
+
+TEST(ProgressiveStreamTest, PngRowsArriveLongBeforeTransferCompletes) {
+    const int w = 384, h = 384;
+    const auto rgba = NoiseRgba(w, h, 7);
+    const auto png = EncodePng(rgba, w, h);
+
+    ThrottledSource slow(png, png.size() / 0.4); // ~400 ms transfer
+    Recorder rec{ &slow };
+    const auto outcome = StreamPartialFrames(slow.Source(), FastOptions(), rec.Callback());
+
+    ASSERT_EQ(outcome, StreamOutcome::Finished);
+    ASSERT_GE(rec.frames.size(), 3u);
+    EXPECT_LT(rec.frames.front().atMs, slow.TransferMs() / 2) << "time-to-first-pixel";
+    EXPECT_EQ(rec.frames.back().rowsReady, h);
+
+    int lastRows = 0;
+    for (const auto& f : rec.frames) {
+        ASSERT_EQ(f.width, w);
+        ASSERT_EQ(f.height, h);
+        EXPECT_GT(f.rowsReady, lastRows);
+        EXPECT_EQ(f.rowsFinal, f.rowsReady); // Rows are never revisited
+        lastRows = f.rowsReady;
+
+        // Shown rows are exact premultiplied BGRA, the rest stays cleared
+        for (int y = 0; y < f.height; ++y) {
+            const uint8_t* got = f.pixels.data() + (size_t)y * w * 4;
+            const uint8_t* src = rgba.data() + (size_t)y * w * 4;
+            for (int x = 0; x < w; ++x, got += 4, src += 4) {
+                const uint8_t a = src[3];
+                const uint8_t expect[4] = {
+                    (uint8_t)((src[2] * a + 127) / 255), (uint8_t)((src[1] * a + 127) / 255),
+                    (uint8_t)((src[0] * a + 127) / 255), a };
+                if (y < f.rowsReady) {
+                    ASSERT_EQ(std::memcmp(got, expect, 4), 0) << "row " << y << " col " << x;
+                } else {
+                    ASSERT_EQ(got[3], 0) << "row " << y << " not ready yet";
+                }
+            }
+        }
+    }
+}
+
+TEST(ProgressiveStreamTest, ProgressiveJpegRefinesOncePerCompletedScan) {
+    const int w = 512, h = 384;
+    const auto jpeg = EncodeJpeg(NoiseRgba(w, h, 11), w, h, /*progressive*/ true);
+
+    ThrottledSource slow(jpeg, jpeg.size() / 0.4);
+    Recorder rec{ &slow };
+    const auto outcome = StreamPartialFrames(slow.Source(), FastOptions(), rec.Callback());
+
+    ASSERT_EQ(outcome, StreamOutcome::Finished);
+    ASSERT_GE(rec.frames.size(), 2u);
+    EXPECT_LT(rec.frames.front().atMs, slow.TransferMs() / 2) << "time-to-first-pixel";
+
+    int lastScan = 0;
+    for (const auto& f : rec.frames) {
+        EXPECT_EQ(f.width, w);
+        EXPECT_EQ(f.rowsReady, h); // Every refinement covers the whole frame
+        EXPECT_EQ(f.rowsFinal, 0); // ...and may change any row of it
+        EXPECT_GT(f.scan, lastScan);
+        lastScan = f.scan;
+        // The DC scan alone already paints the bottom row
+        EXPECT_EQ(f.pixels[((size_t)(h - 1) * w + w / 2) * 4 + 3], 255);
+    }
+}
+
+TEST(ProgressiveStreamTest, BaselineJpegStreamsScaledScanlines) {
+    const int w = 640, h = 480;
+    const auto jpeg = EncodeJpeg(NoiseRgba(w, h, 3), w, h, /*progressive*/ false);
+
+    ThrottledSource slow(jpeg, jpeg.size() / 0.3);
+    Recorder rec{ &slow };
+    StreamingOptions opts = FastOptions();
+    opts.maxJpegPreviewPixels = 200 * 150; // Forces 1/4 IDCT scaling
+    ASSERT_EQ(StreamPartialFrames(slow.Source(), opts, rec.Callback()), StreamOutcome::Finished);
+
+    ASSERT_GE(rec.frames.size(), 2u);
+    int lastRows = 0;
+    for (const auto& f : rec.frames) {
+        EXPECT_EQ(f.width, w / 4);
+        EXPECT_EQ(f.height, h / 4);
+        EXPECT_EQ(f.srcWidth, w);
+        EXPECT_EQ(f.scan, 0);
+        EXPECT_GT(f.rowsReady, lastRows);
+        lastRows = f.rowsReady;
+        // Consumers copy only rows past rowsFinal from later partials
+        ASSERT_EQ(f.rowsFinal, f.rowsReady);
+        const size_t finalBytes = (size_t)f.rowsFinal * (w / 4) * 4;
+        EXPECT_EQ(std::memcmp(f.pixels.data(), rec.frames.back().pixels.data(), finalBytes), 0);
+    }
+    EXPECT_EQ(lastRows, h / 4);
+}
+
+TEST(ProgressiveStreamTest, UnsupportedAndCancelledSourcesStopEarly) {
+    const int w = 64, h = 64;
+    const auto rgba = NoiseRgba(w, h, 5);
+    {
+        const auto interlaced = EncodePng(rgba, w, h, /*interlaced*/ true);
+        ThrottledSource src(interlaced, 1e9);
+        Recorder rec{ &src };
+        EXPECT_EQ(StreamPartialFrames(src.Source(), FastOptions(), rec.Callback()), StreamOutcome::Unsupported);
+        EXPECT_TRUE(rec.frames.empty());
+    }
+    {
+        const std::vector<uint8_t> bmp(4096, 'B');
+        ThrottledSource src(bmp, 1e9);
+        Recorder rec{ &src };
+        EXPECT_EQ(StreamPartialFrames(src.Source(), FastOptions(), rec.Callback()), StreamOutcome::Unsupported);
+    }
+    {
+        const auto png = EncodePng(NoiseRgba(256, 256, 9), 256, 256);
+        ThrottledSource src(png, png.size() / 10.0); // Would take 10 s
+        Recorder rec{ &src };
+        SimplePredicate cancel;
+        cancel.ctx = &rec;
+        cancel.pfn = [](void* c) { return !static_cast<Recorder*>(c)->frames.empty(); };
+        EXPECT_EQ(StreamPartialFrames(src.Source(), FastOptions(), rec.Callback(), cancel), StreamOutcome::Cancelled);
+        EXPECT_EQ(rec.frames.size(), 1u);
+        EXPECT_LT(src.ElapsedMs(), 5000.0);
+    }
+}
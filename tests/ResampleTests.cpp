@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "ImageLoaderSimd.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Separable resampler: coefficient normalization, exact box means, banding
+
+using ImageLoaderSimd::ResampleFilter;
+
+namespace {
+
+constexpr ResampleFilter kFilters[] = { ResampleFilter::Box, ResampleFilter::Mitchell, ResampleFilter::Lanczos3 };
+
+std::vector<uint8_t> RandomBgra(int w, int h, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> px(static_cast<size_t>(w) * h * 4);
+    for (auto& v : px) v = static_cast<uint8_t>(rng());
+    return px;
+}
+
+} // namespace
+
+TEST(ResampleTests, FlatColorSurvivesEveryScale) {
+    struct Size { int sw, sh, dw, dh; };
+    const Size sizes[] = { {100, 80, 10, 8}, {7, 5, 31, 17}, {1, 1, 5, 3}, {640, 480, 13, 1}, {3000, 200, 60, 4} };
+    for (ResampleFilter f : kFilters) {
+        for (const Size& s : sizes) {
+            std::vector<uint8_t> src(static_cast<size_t>(s.sw) * s.sh * 4);
+            for (size_t i = 0; i < src.size(); i += 4) {
+                src[i] = 10; src[i + 1] = 128; src[i + 2] = 255; src[i + 3] = 0;
+            }
+            std::vector<uint8_t> dst(static_cast<size_t>(s.dw) * s.dh * 4, 77);
+            ImageLoaderSimd::Resize(src.data(), s.sw, s.sh, 0, dst.data(), s.dw, s.dh, 0, f);
+            for (size_t i = 0; i < dst.size(); i += 4) {
+                ASSERT_EQ(dst[i], 10);
+                ASSERT_EQ(dst[i + 1], 128);
+                ASSERT_EQ(dst[i + 2], 255);
+                ASSERT_EQ(dst[i + 3], 0);
+            }
+        }
+    }
+}
+
+TEST(ResampleTests, BoxIsTheAreaMean) {
+    constexpr int kSrcW = 40, kSrcH = 30, kFactor = 10;
+    const auto src = RandomBgra(kSrcW, kSrcH, 1);
+    std::vector<uint8_t> dst((kSrcW / kFactor) * (kSrcH / kFactor) * 4);
+    ImageLoaderSimd::Resize(src.data(), kSrcW, kSrcH, 0, dst.data(), kSrcW / kFactor, kSrcH / kFactor, 0,
+                            ResampleFilter::Box);
+
+    for (int y = 0; y < kSrcH / kFactor; ++y) {
+        for (int x = 0; x < kSrcW / kFactor; ++x) {
+            for (int c = 0; c < 4; ++c) {
+                int sum = 0;
+                for (int j = 0; j < kFactor; ++j) {
+                    for (int i = 0; i < kFactor; ++i) {
+                        sum += src[((y * kFactor + j) * kSrcW + x * kFactor + i) * 4 + c];
+                    }
+                }
+                const int mean = (sum + kFactor * kFactor / 2) / (kFactor * kFactor);
+                // The horizontal pass rounds to 8 bits before the vertical one
+                EXPECT_LE(std::abs(dst[(y * (kSrcW / kFactor) + x) * 4 + c] - mean), 1);
+            }
+        }
+    }
+}
+
+TEST(ResampleTests, SameSizeCopiesWithStrides) {
+    constexpr int kW = 37, kH = 11;
+    const auto src = RandomBgra(kW + 3, kH, 2); // Source rows padded by 3 pixels
+    std::vector<uint8_t> dst(static_cast<size_t>(kW * 4 + 8) * kH, 0);
+    ImageLoaderSimd::Resize(src.data(), kW, kH, (kW + 3) * 4, dst.data(), kW, kH, kW * 4 + 8, ResampleFilter::Lanczos3);
+    for (int y = 0; y < kH; ++y) {
+        EXPECT_EQ(0, std::memcmp(dst.data() + y * (kW * 4 + 8), src.data() + y * (kW + 3) * 4, kW * 4));
+    }
+}
+
+TEST(ResampleTests, BandedResizeMatchesSeparatePasses) {
+    // Large enough to split into bands across threads; bands recompute the
+    // source rows they share, so the result must equal the unbanded passes
+    constexpr int kSrcW = 3000, kSrcH = 2000, kDstW = 397, kDstH = 301;
+    const auto src = RandomBgra(kSrcW, kSrcH, 3);
+    for (ResampleFilter f : kFilters) {
+        std::vector<uint8_t> whole(kDstW * kDstH * 4);
+        ImageLoaderSimd::Resize(src.data(), kSrcW, kSrcH, 0, whole.data(), kDstW, kDstH, 0, f);
+
+        // Width-only then height-only: the same two passes as whole-image calls
+        std::vector<uint8_t> wide(static_cast<size_t>(kDstW) * kSrcH * 4);
+        std::vector<uint8_t> twoStep(kDstW * kDstH * 4);
+        ImageLoaderSimd::Resize(src.data(), kSrcW, kSrcH, 0, wide.data(), kDstW, kSrcH, 0, f);
+        ImageLoaderSimd::Resize(wide.data(), kDstW, kSrcH, 0, twoStep.data(), kDstW, kDstH, 0, f);
+        EXPECT_EQ(whole, twoStep);
+    }
+}
+
+TEST(ResampleTests, RegionTilesMatchWholeResize) {
+    // Tiles cut at fractional source positions (as a pyramid-level crop widened to
+    // whole pixels is): each must equal its part of the whole-image resize, or
+    // neighbouring tiles shift against each other and show seams
+    constexpr int kSrcW = 300, kSrcH = 200, kDstW = 200, kDstH = 120;
+    const auto src = RandomBgra(kSrcW, kSrcH, 5);
+    const int cuts[] = { 0, 37, 100, 163, 200 };
+    for (ResampleFilter f : kFilters) {
+        std::vector<uint8_t> whole(kDstW * kDstH * 4);
+        ImageLoaderSimd::Resize(src.data(), kSrcW, kSrcH, 0, whole.data(), kDstW, kDstH, 0, f);
+
+        const double sx = static_cast<double>(kSrcW) / kDstW, sy = static_cast<double>(kSrcH) / kDstH;
+        for (int i = 0; i + 1 < 5; ++i) {
+            const int x0 = cuts[i], w = cuts[i + 1] - cuts[i];
+            const int y0 = (std::min)(cuts[i], kDstH - 1), h = (std::min)(kDstH - y0, 41);
+            std::vector<uint8_t> tile(static_cast<size_t>(w) * h * 4);
+            ImageLoaderSimd::ResizeRegion(src.data(), kSrcW, kSrcH, 0, x0 * sx, y0 * sy, w * sx, h * sy,
+                                          tile.data(), w, h, 0, f);
+            for (int y = 0; y < h; ++y) {
+                ASSERT_EQ(0, std::memcmp(&tile[static_cast<size_t>(y) * w * 4],
+                                         &whole[(static_cast<size_t>(y0 + y) * kDstW + x0) * 4], static_cast<size_t>(w) * 4))
+                    << "filter " << static_cast<int>(f) << " tile " << i << " row " << y;
+            }
+        }
+    }
+}
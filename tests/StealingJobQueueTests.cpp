@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include "StealingJobQueue.h"
+#include <atomic>
+#include <thread>
+
+// Work-stealing dispatch queue behind HeavyLanePool
+
+using QuickView::StealingJobQueue;
+
+namespace {
+
+struct TestJob {
+    int id = 0;
+    int priority = 0;
+    bool critical = false;
+};
+
+TestJob MakeJob(int id, int priority, bool critical = false) {
+    TestJob j;
+    j.id = id;
+    j.priority = priority;
+    j.critical = critical;
+    return j;
+}
+
+} // namespace
+
+TEST(StealingJobQueueTest, SingleLanePopsInPriorityOrder) {
+    StealingJobQueue<TestJob> queue(1);
+    std::vector<TestJob> batch;
+    for (int i = 0; i < 40; ++i) batch.push_back(MakeJob(i, (i * 17) % 40));
+    queue.PushBatch(batch);
+    EXPECT_TRUE(batch.empty());
+    queue.Push(MakeJob(100, 25, true));
+    EXPECT_EQ(queue.Size(), 41u);
+
+    std::vector<int> order;
+    TestJob job;
+    while (queue.TryPop(0, &job)) order.push_back(job.priority);
+    ASSERT_EQ(order.size(), 41u);
+    EXPECT_TRUE(std::is_sorted(order.rbegin(), order.rend()));
+    EXPECT_TRUE(queue.Empty());
+}
+
+TEST(StealingJobQueueTest, CriticalJobsOvertakeDealtWork) {
+    StealingJobQueue<TestJob> queue(4);
+    std::vector<TestJob> batch;
+    for (int i = 0; i < 32; ++i) batch.push_back(MakeJob(i, -i));
+    queue.PushBatch(batch);
+    queue.Push(MakeJob(999, 1000, true));
+
+    // Every lane sees the injector before its own front
+    TestJob job;
+    ASSERT_TRUE(queue.TryPop(3, &job));
+    EXPECT_EQ(job.id, 999);
+    EXPECT_EQ(queue.GetStats().injected, 1u);
+    EXPECT_EQ(queue.GetStats().dealt, 32u);
+}
+
+TEST(StealingJobQueueTest, IdleLaneStealsBestPeerJob) {
+    StealingJobQueue<TestJob> queue(4);
+    queue.SetActiveLanes(2); // Lanes 2 and 3 receive nothing
+    std::vector<TestJob> batch;
+    for (int i = 0; i < 20; ++i) batch.push_back(MakeJob(i, 100 - i));
+    queue.PushBatch(batch);
+
+    TestJob job;
+    ASSERT_TRUE(queue.TryPop(3, &job));
+    EXPECT_EQ(job.priority, 100); // Best advertised front, not an arbitrary victim
+    EXPECT_EQ(queue.GetStats().stolen, 1u);
+
+    // Half of the victim's tail moved over: the thief now pops locally
+    ASSERT_TRUE(queue.TryPop(3, &job));
+    EXPECT_EQ(queue.GetStats().stolen, 1u);
+    EXPECT_EQ(queue.Size(), 18u);
+}
+
+TEST(StealingJobQueueTest, FullLanesSpillToInjector) {
+    StealingJobQueue<TestJob> queue(2, 4);
+    std::vector<TestJob> batch;
+    for (int i = 0; i < 20; ++i) batch.push_back(MakeJob(i, i));
+    queue.PushBatch(batch);
+
+    const auto stats = queue.GetStats();
+    EXPECT_EQ(stats.dealt, 8u);
+    EXPECT_EQ(stats.overflowed, 12u);
+    EXPECT_EQ(queue.Size(), 20u);
+
+    // Lowest priorities spilled; nothing is lost
+    size_t popped = 0;
+    TestJob job;
+    while (queue.TryPop((int)(popped % 2), &job)) popped++;
+    EXPECT_EQ(popped, 20u);
+}
+
+TEST(StealingJobQueueTest, RemoveIfReachesEveryPart) {
+    StealingJobQueue<TestJob> queue(3, 4);
+    std::vector<TestJob> batch;
+    for (int i = 0; i < 30; ++i) batch.push_back(MakeJob(i, i % 7, i % 5 == 0));
+    queue.PushBatch(batch);
+
+    std::vector<int> removedIds;
+    const size_t removed = queue.RemoveIf([](const TestJob& j) { return j.id % 2 == 1; },
+                                          [&](const TestJob& j) { removedIds.push_back(j.id); });
+    EXPECT_EQ(removed, 15u);
+    EXPECT_EQ(removedIds.size(), 15u);
+    EXPECT_EQ(queue.Size(), 15u);
+    EXPECT_FALSE(queue.AnyOf([](const TestJob& j) { return j.id % 2 == 1; }));
+    EXPECT_TRUE(queue.AnyOf([](const TestJob& j) { return j.id == 10; }));
+
+    EXPECT_EQ(queue.Clear(), 15u);
+    EXPECT_TRUE(queue.Empty());
+    TestJob job;
+    EXPECT_FALSE(queue.TryPop(0, &job));
+}
+
+TEST(StealingJobQueueTest, ConcurrentProducersAndConsumersLoseNothing) {
+    constexpr int kWorkers = 4;
+    constexpr int kJobs = 20000;
+    StealingJobQueue<TestJob> queue(kWorkers, 16);
+    std::vector<std::atomic<int>> seen(kJobs);
+    std::atomic<int> consumed{ 0 };
+    std::atomic<bool> producing{ true };
+
+    std::vector<std::thread> workers;
+    for (int w = 0; w < kWorkers; ++w) {
+        workers.emplace_back([&, w] {
+            TestJob job;
+            while (producing.load() || !queue.Empty()) {
+                if (queue.TryPop(w, &job)) {
+                    seen[job.id]++;
+                    consumed++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<TestJob> batch;
+    for (int i = 0; i < kJobs; ++i) {
+        batch.push_back(MakeJob(i, (i * 7919) % 1000, i % 50 == 0));
+        if (batch.size() == 97) queue.PushBatch(batch);
+        if (i % 1000 == 0) {
+            queue.RemoveIf([](const TestJob&) { return false; }, [](const TestJob&) {});
+        }
+    }
+    queue.PushBatch(batch);
+    producing = false;
+    for (auto& t : workers) t.join();
+
+    EXPECT_EQ(consumed.load(), kJobs);
+    for (int i = 0; i < kJobs; ++i) {
+        ASSERT_EQ(seen[i].load(), 1) << "job " << i;
+    }
+    EXPECT_EQ(queue.GetStats().popped, (uint64_t)kJobs);
+}
+
+TEST(StealingJobQueueTest, PushUniqueAdmitsOneOfRacingDuplicates) {
+    constexpr int kThreads = 8;
+    constexpr int kIds = 200;
+    StealingJobQueue<TestJob> queue(4, 8);
+    std::atomic<int> accepted{ 0 };
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&, t] {
+            for (int id = 0; id < kIds; ++id) {
+                // Odd ids go through the injector, even ones are dealt to lanes
+                const TestJob job = MakeJob(id, (id * 31 + t) % 97, id % 2 == 1);
+                if (queue.PushUnique([id](const TestJob& j) { return j.id == id; }, job)) accepted++;
+            }
+        });
+    }
+    for (auto& t : producers) t.join();
+
+    EXPECT_EQ(accepted.load(), kIds);
+    EXPECT_EQ(queue.Size(), (size_t)kIds);
+    std::vector<int> seen(kIds);
+    TestJob job;
+    while (queue.TryPop(0, &job)) seen[job.id]++;
+    for (int id = 0; id < kIds; ++id) EXPECT_EQ(seen[id], 1) << "job " << id;
+
+    // Once the original is popped, the same work may be queued again
+    EXPECT_TRUE(queue.PushUnique([](const TestJob& j) { return j.id == 0; }, MakeJob(0, 1)));
+    EXPECT_FALSE(queue.PushUnique([](const TestJob& j) { return j.id == 0; }, MakeJob(0, 2)));
+}
+
+TEST(StealingJobQueueTest, PushReplacingDropsSupersededJobs) {
+    // A queued low-priority prefetch (id 1, priority 100) is replaced, not
+    // mistaken for a duplicate of the full decode of the same image
+    StealingJobQueue<TestJob> queue(2, 4);
+    queue.Push(MakeJob(1, 100));
+    queue.Push(MakeJob(2, 100));
+    int dropped = 0;
+    EXPECT_TRUE(queue.PushReplacing([](const TestJob& j) { return j.id == 1 && j.priority == 200; },
+                                    [](const TestJob& j) { return j.id == 1 && j.priority == 100; },
+                                    [&](const TestJob&) { dropped++; }, MakeJob(1, 200, true)));
+    EXPECT_EQ(dropped, 1);
+    EXPECT_EQ(queue.Size(), 2u);
+
+    // The full decode itself is still deduplicated
+    EXPECT_FALSE(queue.PushReplacing([](const TestJob& j) { return j.id == 1 && j.priority == 200; },
+                                     [](const TestJob& j) { return j.id == 1 && j.priority == 100; },
+                                     [&](const TestJob&) { dropped++; }, MakeJob(1, 200, true)));
+    EXPECT_EQ(dropped, 1);
+
+    TestJob job;
+    ASSERT_TRUE(queue.TryPop(0, &job));
+    EXPECT_EQ(job.id, 1);
+    EXPECT_EQ(job.priority, 200);
+    ASSERT_TRUE(queue.TryPop(0, &job));
+    EXPECT_EQ(job.id, 2);
+    EXPECT_FALSE(queue.TryPop(0, &job));
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "ThumbnailDiskCache.h"
+#include <filesystem>
+#include <fstream>
+
+// L3 thumbnail store: pack/index round trips, reopen, validation and torn writes
+
+namespace {
+
+struct TempCacheDir {
+    std::filesystem::path path;
+    TempCacheDir() {
+        path = std::filesystem::temp_directory_path() /
+               ("qv_thumbcache_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "_" +
+                ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(path);
+    }
+    ~TempCacheDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+};
+
+CImageLoader::ThumbData MakeThumb(int w, int h, uint8_t seed) {
+    CImageLoader::ThumbData d;
+    d.width = w;
+    d.height = h;
+    d.stride = w * 4;
+    d.pixels.resize(static_cast<size_t>(d.stride) * h);
+    for (size_t i = 0; i < d.pixels.size(); ++i) d.pixels[i] = static_cast<uint8_t>((i / 7) * seed);
+    d.isValid = true;
+    d.isBlurry = false;
+    d.origWidth = w * 10;
+    d.origHeight = h * 10;
+    d.fileSize = 123456;
+    return d;
+}
+
+ThumbnailDiskCache::Key MakeKey(uint64_t id, uint64_t mtime = 1000) {
+    ThumbnailDiskCache::Key k;
+    k.imageId = id;
+    k.mtime = mtime;
+    k.fileSize = 4096;
+    k.targetSize = 300;
+    return k;
+}
+
+} // namespace
+
+TEST(ThumbnailDiskCacheTest, RoundTripSurvivesReopen) {
+    TempCacheDir dir;
+    const auto thumb = MakeThumb(300, 200, 3);
+    {
+        ThumbnailDiskCache cache;
+        ASSERT_TRUE(cache.Open(dir.path.wstring()));
+        EXPECT_FALSE(cache.Contains(42, 300));
+        ASSERT_TRUE(cache.Put(MakeKey(42), thumb));
+        EXPECT_TRUE(cache.Contains(42, 300));
+        EXPECT_FALSE(cache.Contains(42, 256)); // Other target size
+    }
+
+    ThumbnailDiskCache cache;
+    ASSERT_TRUE(cache.Open(dir.path.wstring()));
+    EXPECT_EQ(cache.GetStats().entries, 1u);
+
+    CImageLoader::ThumbData out;
+    ASSERT_TRUE(cache.Get(MakeKey(42), &out));
+    EXPECT_EQ(out.width, 300);
+    EXPECT_EQ(out.height, 200);
+    EXPECT_EQ(out.stride, 1200);
+    EXPECT_EQ(out.origWidth, 3000);
+    EXPECT_EQ(out.fileSize, 123456u);
+    EXPECT_FALSE(out.isBlurry);
+    EXPECT_TRUE(out.isValid);
+    EXPECT_EQ(out.pixels, thumb.pixels);
+
+    // A modified source (different mtime) misses, and the rewrite replaces the slot
+    EXPECT_FALSE(cache.Get(MakeKey(42, 2000), &out));
+    const auto edited = MakeThumb(300, 200, 5);
+    ASSERT_TRUE(cache.Put(MakeKey(42, 2000), edited));
+    ASSERT_TRUE(cache.Get(MakeKey(42, 2000), &out));
+    EXPECT_EQ(out.pixels, edited.pixels);
+    EXPECT_EQ(cache.GetStats().entries, 1u);
+}
+
+TEST(ThumbnailDiskCacheTest, ManyEntriesAndFailuresNotStored) {
+    TempCacheDir dir;
+    ThumbnailDiskCache cache;
+    ASSERT_TRUE(cache.Open(dir.path.wstring()));
+
+    for (uint64_t id = 1; id <= 2000; ++id) {
+        ASSERT_TRUE(cache.Put(MakeKey(id * 0x9E3779B97F4A7C15ull), MakeThumb(16 + id % 32, 12, static_cast<uint8_t>(id))));
+    }
+    for (uint64_t id = 1; id <= 2000; id += 97) {
+        CImageLoader::ThumbData out;
+        ASSERT_TRUE(cache.Get(MakeKey(id * 0x9E3779B97F4A7C15ull), &out)) << id;
+        EXPECT_EQ(out.pixels, MakeThumb(16 + id % 32, 12, static_cast<uint8_t>(id)).pixels);
+    }
+    EXPECT_EQ(cache.GetStats().entries, 2000u);
+
+    auto failed = MakeThumb(8, 8, 1);
+    failed.isFailed = true;
+    EXPECT_FALSE(cache.Put(MakeKey(7), failed));
+    EXPECT_FALSE(cache.Contains(7, 300));
+
+    cache.Clear();
+    EXPECT_EQ(cache.GetStats().entries, 0u);
+    CImageLoader::ThumbData out;
+    EXPECT_FALSE(cache.Get(MakeKey(0x9E3779B97F4A7C15ull), &out));
+}
+
+TEST(ThumbnailDiskCacheTest, TornTailAndForeignFilesAreDiscarded) {
+    TempCacheDir dir;
+    const auto thumb = MakeThumb(64, 64, 9);
+    {
+        ThumbnailDiskCache cache;
+        ASSERT_TRUE(cache.Open(dir.path.wstring()));
+        ASSERT_TRUE(cache.Put(MakeKey(1), thumb));
+    }
+
+    // Bytes appended past the committed end (crash mid-append) are truncated on open
+    const auto pack = dir.path / "thumbs.pack";
+    const auto committed = std::filesystem::file_size(pack);
+    {
+        std::ofstream f(pack, std::ios::binary | std::ios::app);
+        f << "garbage from an interrupted append";
+    }
+    {
+        ThumbnailDiskCache cache;
+        ASSERT_TRUE(cache.Open(dir.path.wstring()));
+        CImageLoader::ThumbData out;
+        EXPECT_TRUE(cache.Get(MakeKey(1), &out));
+    }
+    EXPECT_EQ(std::filesystem::file_size(pack), committed);
+
+    // An index that does not belong to this pack resets the store
+    {
+        std::ofstream f(pack, std::ios::binary | std::ios::trunc);
+        f << "not a pack";
+    }
+    ThumbnailDiskCache cache;
+    ASSERT_TRUE(cache.Open(dir.path.wstring()));
+    EXPECT_EQ(cache.GetStats().entries, 0u);
+    CImageLoader::ThumbData out;
+    EXPECT_FALSE(cache.Get(MakeKey(1), &out));
+    EXPECT_TRUE(cache.Put(MakeKey(1), thumb));
+    EXPECT_TRUE(cache.Get(MakeKey(1), &out));
+}
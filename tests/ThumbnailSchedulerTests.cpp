@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "ThumbnailScheduler.h"
+#include <chrono>
+#include <set>
+
+// Work-stealing pool behind ThumbnailManager
+
+using QuickView::ThumbnailScheduler;
+using QuickView::ThumbTask;
+
+namespace {
+
+// Lets a test hold workers inside the handler until it has finished queueing
+class Gate {
+public:
+    void Wait() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_open; });
+    }
+    void Open() {
+        { std::lock_guard<std::mutex> lock(m_mutex); m_open = true; }
+        m_cv.notify_all();
+    }
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_open = false;
+};
+
+template<typename Pred>
+bool WaitFor(Pred pred) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+ThumbTask MakeTask(size_t id, bool fast, int distance = 0) {
+    ThumbTask t;
+    t.imageId = id;
+    t.isFastLane = fast;
+    t.priorityDistance = distance;
+    return t;
+}
+
+ThumbTask MakeArchiveTask(size_t id, size_t archiveHash, int archiveIndex) {
+    ThumbTask t = MakeTask(id, true);
+    t.isArchive = true;
+    t.archivePathHash = archiveHash;
+    t.archiveIndex = archiveIndex;
+    return t;
+}
+
+} // namespace
+
+TEST(ThumbnailSchedulerTest, RunsEveryTaskOnce) {
+    constexpr size_t kTasks = 2000;
+    std::vector<std::atomic<int>> runs(kTasks);
+    std::atomic<size_t> done{ 0 };
+
+    ThumbnailScheduler pool;
+    pool.Start(4, [&](ThumbTask& t) { runs[t.imageId]++; done++; });
+    for (size_t i = 0; i < kTasks; ++i) {
+        ThumbTask t = (i % 7 == 0) ? MakeArchiveTask(i, i % 3, (int)i) : MakeTask(i, i % 3 != 0, (int)(i % 50));
+        pool.Push(std::move(t));
+    }
+
+    ASSERT_TRUE(WaitFor([&] { return done.load() == kTasks; }));
+    pool.Stop();
+    for (size_t i = 0; i < kTasks; ++i) {
+        EXPECT_EQ(runs[i].load(), 1) << "task " << i;
+    }
+    EXPECT_EQ(pool.GetStats().executed, kTasks);
+}
+
+TEST(ThumbnailSchedulerTest, SolidArchiveRunsInIndexOrderOnOneThread) {
+    constexpr size_t kArchive = 0xC0FFEE;
+    Gate gate;
+    std::mutex mutex;
+    std::vector<int> order;
+    std::set<std::thread::id> threads;
+
+    ThumbnailScheduler pool;
+    pool.Start(4, [&](ThumbTask& t) {
+        if (t.archiveIndex < 0) { gate.Wait(); return; } // Blocker holds the home worker
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(t.archiveIndex);
+        threads.insert(std::this_thread::get_id());
+    });
+
+    pool.Push(MakeArchiveTask(0, kArchive, -1));
+    ASSERT_TRUE(WaitFor([&] { return pool.QueuedCount() == 0; }));
+
+    // Center-first distances disagree with archive order on purpose
+    const int indices[] = { 7, 2, 9, 0, 5, 3, 8, 1, 6, 4 };
+    for (int idx : indices) {
+        ThumbTask t = MakeArchiveTask(100 + idx, kArchive, idx);
+        t.priorityDistance = 10 - idx;
+        pool.Push(std::move(t));
+    }
+    // Idle peers must not steal pinned members
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(pool.QueuedCount(), 10u);
+
+    gate.Open();
+    ASSERT_TRUE(WaitFor([&] { std::lock_guard<std::mutex> lock(mutex); return order.size() == 10; }));
+    pool.Stop();
+
+    EXPECT_EQ(order, (std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+    EXPECT_EQ(threads.size(), 1u);
+}
+
+TEST(ThumbnailSchedulerTest, ClearDropsQueuedWork) {
+    Gate gate;
+    std::atomic<int> started{ 0 };
+    std::atomic<int> finished{ 0 };
+
+    ThumbnailScheduler pool;
+    pool.Start(2, [&](ThumbTask&) { started++; gate.Wait(); finished++; });
+    pool.Push(MakeTask(0, true));
+    pool.Push(MakeTask(1, true));
+    ASSERT_TRUE(WaitFor([&] { return started.load() == 2; }));
+
+    for (size_t i = 2; i < 52; ++i) pool.Push(MakeTask(i, i % 2 == 0));
+    EXPECT_EQ(pool.Clear(), 50u);
+    EXPECT_EQ(pool.QueuedCount(), 0u);
+
+    gate.Open();
+    ASSERT_TRUE(WaitFor([&] { return finished.load() == 2; }));
+    pool.Stop();
+    EXPECT_EQ(started.load(), 2); // Running tasks complete, dropped ones never start
+}
+
+TEST(ThumbnailSchedulerTest, SlowDecodesLeaveAWorkerForFastLane) {
+    Gate gate;
+    std::atomic<int> slowStarted{ 0 };
+    std::atomic<bool> fastDone{ false };
+
+    ThumbnailScheduler pool;
+    pool.Start(3, [&](ThumbTask& t) {
+        if (t.isFastLane) { fastDone = true; return; }
+        slowStarted++;
+        gate.Wait();
+    });
+
+    for (size_t i = 0; i < 6; ++i) pool.Push(MakeTask(i, false));
+    ASSERT_TRUE(WaitFor([&] { return slowStarted.load() == 2; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(slowStarted.load(), 2); // workers - 1
+
+    pool.Push(MakeTask(100, true));
+    EXPECT_TRUE(WaitFor([&] { return fastDone.load(); }));
+
+    gate.Open();
+    ASSERT_TRUE(WaitFor([&] { return pool.GetStats().executed == 7; }));
+    pool.Stop();
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "TileClock.h"
+#include <unordered_map>
+
+// CLOCK ring used by TileManager::EnforceBudget
+
+using QuickView::TileClock;
+using QuickView::TileKey;
+
+namespace {
+
+// Stand-in for TileEntry reference bits, keyed by tile
+struct FakeTiles {
+    std::unordered_map<uint64_t, bool> referenced;
+    std::vector<uint64_t> evicted;
+    size_t visits = 0;
+
+    bool TryEvict(TileKey key) {
+        visits++;
+        bool& ref = referenced[key.key];
+        if (ref) { ref = false; return false; }
+        evicted.push_back(key.key);
+        return true;
+    }
+};
+
+} // namespace
+
+TEST(TileClockTest, EvictsUnreferencedInHandOrder) {
+    TileClock clock;
+    FakeTiles tiles;
+    for (int i = 0; i < 6; ++i) {
+        clock.Insert(TileKey::From(i, 0, 0));
+        tiles.referenced[TileKey::From(i, 0, 0).key] = (i % 2 == 0); // Even tiles recently used
+    }
+
+    size_t evicted = clock.Sweep([&] { return tiles.evicted.size() < 2; },
+                                 [&](TileKey k) { return tiles.TryEvict(k); });
+    EXPECT_EQ(evicted, 2u);
+    ASSERT_EQ(tiles.evicted.size(), 2u);
+    EXPECT_EQ(tiles.evicted[0], TileKey::From(1, 0, 0).key);
+    EXPECT_EQ(tiles.evicted[1], TileKey::From(3, 0, 0).key);
+    EXPECT_EQ(clock.Size(), 4u);
+
+    // The hand resumes where it stopped: tile 5 is next, then the spared even tiles
+    tiles.evicted.clear();
+    clock.Sweep([&] { return tiles.evicted.size() < 2; }, [&](TileKey k) { return tiles.TryEvict(k); });
+    ASSERT_EQ(tiles.evicted.size(), 2u);
+    EXPECT_EQ(tiles.evicted[0], TileKey::From(5, 0, 0).key);
+    EXPECT_EQ(tiles.evicted[1], TileKey::From(0, 0, 0).key);
+}
+
+TEST(TileClockTest, AllReferencedStillTerminates) {
+    TileClock clock;
+    FakeTiles tiles;
+    constexpr int kTiles = 1000;
+    for (int i = 0; i < kTiles; ++i) {
+        clock.Insert(TileKey::From(i, 1, 2));
+        tiles.referenced[TileKey::From(i, 1, 2).key] = true;
+    }
+
+    // One lap clears every bit, the second evicts
+    size_t evicted = clock.Sweep([&] { return tiles.evicted.size() < 10; }, [&](TileKey k) { return tiles.TryEvict(k); });
+    EXPECT_EQ(evicted, 10u);
+    EXPECT_EQ(tiles.visits, static_cast<size_t>(kTiles + 10));
+
+    // Nothing referenced now: cost is proportional to the evicted count
+    tiles.visits = 0;
+    tiles.evicted.clear();
+    clock.Sweep([&] { return tiles.evicted.size() < 5; }, [&](TileKey k) { return tiles.TryEvict(k); });
+    EXPECT_EQ(tiles.visits, 5u);
+
+    // An unsatisfiable target stops after two laps instead of spinning
+    clock.Sweep([] { return true; }, [](TileKey) { return false; });
+    EXPECT_EQ(clock.Size(), static_cast<size_t>(kTiles - 15));
+}
+
+TEST(TileClockTest, ReleasedSlotsAreReused) {
+    TileClock clock;
+    int32_t a = clock.Insert(TileKey::From(1, 1, 0));
+    int32_t b = clock.Insert(TileKey::From(2, 1, 0));
+    EXPECT_NE(a, b);
+    EXPECT_EQ(clock.Size(), 2u);
+
+    clock.Release(a);
+    clock.Release(a); // Double release is ignored
+    EXPECT_EQ(clock.Size(), 1u);
+    EXPECT_EQ(clock.Insert(TileKey::From(3, 1, 0)), a);
+
+    // Released slots are skipped by the hand
+    clock.Release(b);
+    std::vector<uint64_t> seen;
+    clock.Sweep([&] { return clock.Size() > 0; }, [&](TileKey k) { seen.push_back(k.key); return true; });
+    ASSERT_EQ(seen.size(), 1u);
+    EXPECT_EQ(seen[0], TileKey::From(3, 1, 0).key);
+
+    clock.Clear();
+    EXPECT_EQ(clock.Size(), 0u);
+    EXPECT_EQ(clock.Sweep([] { return true; }, [](TileKey) { return true; }), 0u);
+}
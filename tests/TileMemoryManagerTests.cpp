@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "TileMemoryManager.h"
+#include <cstring>
+
+// Size-class slab pool used for Titan tiles
+
+using QuickView::TileMemoryManager;
+using QuickView::TileSizeClass;
+using QuickView::TILE_SLAB_SIZE;
+
+TEST(TileMemoryManagerTest, PicksSmallestClass) {
+    TileSizeClass c;
+    ASSERT_TRUE(TileMemoryManager::ClassFor(1, &c));
+    EXPECT_EQ(c, TileSizeClass::Quarter);
+    ASSERT_TRUE(TileMemoryManager::ClassFor(256 * 256 * 4, &c));
+    EXPECT_EQ(c, TileSizeClass::Quarter);
+    ASSERT_TRUE(TileMemoryManager::ClassFor(256 * 256 * 4 + 1, &c));
+    EXPECT_EQ(c, TileSizeClass::Full);
+    ASSERT_TRUE(TileMemoryManager::ClassFor(512 * 512 * 8, &c)); // FP16 tile
+    EXPECT_EQ(c, TileSizeClass::Double);
+    ASSERT_TRUE(TileMemoryManager::ClassFor(512 * 512 * 16, &c)); // FP32 tile
+    EXPECT_EQ(c, TileSizeClass::Quad);
+    EXPECT_FALSE(TileMemoryManager::ClassFor(512 * 512 * 16 + 1, &c));
+}
+
+TEST(TileMemoryManagerTest, StatsTrackOccupancyAndFragmentation) {
+    TileMemoryManager pool(16);
+
+    void* edge = pool.Allocate(100 * 512 * 4);       // Quarter slot
+    void* full = pool.Allocate();                     // Full slot
+    void* hdr = pool.Allocate(512 * 512 * 16);        // Quad slot
+    ASSERT_NE(edge, nullptr);
+    ASSERT_NE(full, nullptr);
+    ASSERT_NE(hdr, nullptr);
+    std::memset(hdr, 0xFF, 512 * 512 * 16);            // Committed and writable
+
+    auto stats = pool.GetStats();
+    EXPECT_EQ(stats.classes[0].inUse, 1u);
+    EXPECT_EQ(stats.classes[1].inUse, 1u);
+    EXPECT_EQ(stats.classes[2].inUse, 0u);
+    EXPECT_EQ(stats.classes[3].inUse, 1u);
+    const size_t used = TILE_SLAB_SIZE / 4 + TILE_SLAB_SIZE + TILE_SLAB_SIZE * 4;
+    EXPECT_EQ(stats.usedBytes, used);
+    EXPECT_EQ(pool.GetUsed(), used);
+    EXPECT_EQ(stats.requestedBytes, 100u * 512 * 4 + TILE_SLAB_SIZE + 512u * 512 * 16);
+    EXPECT_NEAR(stats.Occupancy(), static_cast<double>(used) / (16 * 1024 * 1024), 1e-9);
+    EXPECT_GT(stats.Fragmentation(), 0.0);
+    EXPECT_EQ(stats.IdleCommittedBytes(), 0u);
+
+    // Freed slots stay committed until Shrink, then are reused from the free list
+    pool.Free(edge);
+    stats = pool.GetStats();
+    EXPECT_EQ(stats.classes[0].inUse, 0u);
+    EXPECT_EQ(stats.IdleCommittedBytes(), TILE_SLAB_SIZE / 4);
+    EXPECT_EQ(pool.Allocate(1000), edge);
+    pool.Free(edge);
+
+    pool.Shrink();
+    stats = pool.GetStats();
+    EXPECT_EQ(stats.IdleCommittedBytes(), 0u);
+    EXPECT_EQ(stats.commitCalls, 3u);   // Reuse did not commit again
+    EXPECT_EQ(stats.decommitCalls, 1u); // Only the idle quarter slot
+    EXPECT_EQ(stats.classes[0].committed, 0u);
+
+    pool.Free(full);
+    pool.Free(hdr);
+    EXPECT_EQ(pool.GetUsed(), 0u);
+}
+
+TEST(TileMemoryManagerTest, BudgetIsSharedAcrossClasses) {
+    TileMemoryManager pool(8);
+    std::vector<void*> blocks;
+    blocks.push_back(pool.Allocate(512 * 512 * 16)); // 4 MB
+    blocks.push_back(pool.Allocate(512 * 512 * 8));  // 2 MB
+    blocks.push_back(pool.Allocate());                // 1 MB
+    blocks.push_back(pool.Allocate(1));               // 256 KB
+    for (void* b : blocks) ASSERT_NE(b, nullptr);
+
+    // 7.25 MB handed out: another full slot does not fit, a quarter slot does
+    EXPECT_EQ(pool.Allocate(), nullptr);
+    EXPECT_EQ(pool.Allocate(512 * 512 * 16 + 1), nullptr); // Larger than any class
+    void* quarter = pool.Allocate(1);
+    EXPECT_NE(quarter, nullptr);
+    EXPECT_EQ(pool.GetStats().failedAllocations, 2u);
+
+    // Pointers from another allocator are ignored
+    int local = 0;
+    pool.Free(&local);
+
+    pool.Free(quarter);
+    for (void* b : blocks) pool.Free(b);
+    EXPECT_EQ(pool.GetUsed(), 0u);
+    EXPECT_EQ(pool.GetFree(), pool.GetCapacity());
+
+    // Idle slots of other classes are decommitted to make room for a new commit
+    auto first = pool.AllocateSmart(512 * 512 * 16);  // Reuses the committed 4 MB slot
+    auto second = pool.AllocateSmart(512 * 512 * 16); // Needs a fresh commit
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    auto stats = pool.GetStats();
+    EXPECT_EQ(stats.committedBytes, pool.GetCapacity());
+    EXPECT_EQ(stats.classes[0].committed + stats.classes[1].committed + stats.classes[2].committed, 0u);
+}
+
+TEST(TileMemoryManagerTest, CommitReleasesOnlyWhatItNeeds) {
+    TileMemoryManager pool(2);
+    std::vector<void*> quarters;
+    for (int i = 0; i < 8; ++i) quarters.push_back(pool.Allocate(1));
+    for (void* q : quarters) ASSERT_NE(q, nullptr);
+    for (void* q : quarters) pool.Free(q);
+    EXPECT_EQ(pool.GetStats().committedBytes, pool.GetCapacity());
+
+    // A full slot needs 1 MB: four idle quarter slots go, the other four stay committed
+    void* full = pool.Allocate();
+    ASSERT_NE(full, nullptr);
+    auto stats = pool.GetStats();
+    EXPECT_EQ(stats.decommitCalls, 4u);
+    EXPECT_EQ(stats.classes[0].committed, 4u);
+    EXPECT_EQ(stats.committedBytes, pool.GetCapacity());
+
+    // The surviving quarter slots are reused without another commit
+    void* a = pool.Allocate(1);
+    void* b = pool.Allocate(1);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(pool.GetStats().commitCalls, 8u + 1u);
+
+    pool.Free(a);
+    pool.Free(b);
+    pool.Free(full);
+}
@@ -0,0 +1,451 @@
+#include <gtest/gtest.h>
+#include "ImageLoaderSimd.h"
+#include "ImageTypes.h"
+#include <DirectXPackedVector.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// CPU tone-mapping / gain-map pipeline against a double-precision transcription of the ComputeEngine HLSL
+
+using QuickView::GpuShaderPayload;
+using QuickView::PixelFormat;
+using QuickView::ToneMapSettings;
+
+namespace {
+
+const int kWidths[] = { 1, 3, 17, 67 };
+const PixelFormat kFormats[] = { PixelFormat::R32G32B32A32_FLOAT, PixelFormat::R16G16B16A16_FLOAT,
+                                 PixelFormat::R16G16B16A16_UNORM };
+
+// --- HLSL transcription (ComputeEngine.cpp), in double ---------------------------
+
+double Luma2020(const double* c) { return 0.2627 * c[0] + 0.6780 * c[1] + 0.0593 * c[2]; }
+
+double LinearToPQ(double l) {
+    const double p = std::pow(std::max(l, 0.0) / 125.0, 2610.0 / 16384.0);
+    return std::pow((0.8359375 + 18.8515625 * p) / (1.0 + 18.6875 * p), 78.84375);
+}
+
+double PQToLinear(double v) {
+    const double p = std::pow(std::max(v, 0.0), 1.0 / 78.84375);
+    return std::pow(std::max(p - 0.8359375, 0.0) / (18.8515625 - 18.6875 * p), 16384.0 / 2610.0) * 125.0;
+}
+
+void ToneCurve(double* c, const ToneMapSettings& s, double displayPeak, bool hdr) {
+    const double l = Luma2020(c);
+    if (l <= 0.0) return;
+    if (hdr && s.mode == 0 && s.contentPeakScRgb <= s.displayPeakScRgb + 1e-5f) return;
+    double target = l;
+    if (s.mode == 0) {
+        const double lPq = LinearToPQ(l);
+        double x = lPq - s.splineSrcPivot;
+        double targetPq;
+        if (x > 0.0) {
+            x = std::min(x, LinearToPQ(s.contentPeakScRgb) - s.splineSrcPivot);
+            targetPq = ((s.splineQa * x + s.splineQb) * x + s.splineQc) * x + s.splineDstPivot;
+        } else {
+            x = std::max(x, -static_cast<double>(s.splineSrcPivot));
+            targetPq = (s.splinePa * x + s.splinePb) * x + s.splineDstPivot;
+        }
+        target = PQToLinear(std::clamp(targetPq, 0.0, LinearToPQ(s.displayPeakScRgb)));
+        if (s.contrastRecovery > 0.0f) {
+            const double mappedPq = LinearToPQ(target);
+            const double orig = lPq / std::max<double>(s.sceneAvgPq, 1e-6);
+            const double mapped = mappedPq / std::max<double>(s.mappedAvgPq, 1e-6);
+            const double factor = std::pow(std::max(orig / std::max(mapped, 1e-6), 1e-6), s.contrastRecovery);
+            target = PQToLinear(std::clamp(mappedPq * factor, 0.0, LinearToPQ(displayPeak)));
+        }
+    } else if (s.mode == 2) {
+        const double srcMax = LinearToPQ(s.contentPeakScRgb);
+        const double dstMax = LinearToPQ(displayPeak);
+        if (srcMax > dstMax) {
+            const double lPq = LinearToPQ(l);
+            const double ks = std::max(1.5 * dstMax - 0.5, 0.075);
+            if (lPq > ks) {
+                const double t = std::clamp((lPq - ks) / std::max(srcMax - ks, 1e-6), 0.0, 1.0);
+                const double k = (srcMax - ks) / std::max(dstMax - ks, 1e-6);
+                const double h = (((k - 2.0) * t + (3.0 - 2.0 * k)) * t + k) * t;
+                target = PQToLinear(std::clamp(ks + (dstMax - ks) * h, 0.0, dstMax));
+            }
+        }
+    }
+    const double ratio = target / l;
+    for (int i = 0; i < 3; ++i) c[i] *= ratio;
+    if (s.mode != 1 && ratio < s.desatThreshold) {
+        const double d = std::pow((s.desatThreshold - ratio) / s.desatThreshold, 1.5) * s.desatStrength;
+        const double m = Luma2020(c);
+        for (int i = 0; i < 3; ++i) c[i] += (m - c[i]) * d;
+    }
+}
+
+void GamutMap(double* c, const double* yw, double peak) {
+    const double y = yw[0] * c[0] + yw[1] * c[1] + yw[2] * c[2];
+    const double maxC = std::max({ c[0], c[1], c[2] });
+    const double minC = std::min({ c[0], c[1], c[2] });
+    if (maxC <= 0.0) {
+        c[0] = c[1] = c[2] = 0.0;
+        return;
+    }
+    double k = 1.0;
+    if (maxC > peak && maxC > y) k = std::min(k, (peak - y) / (maxC - y));
+    if (minC < 0.0 && y > minC) k = std::min(k, y / (y - minC));
+    for (int i = 0; i < 3; ++i) c[i] = y + k * (c[i] - y);
+}
+
+double SrgbToLinear(double c) { return c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4); }
+
+// CSToneMap (hdr = false) / CSToneMapHDR on one texel as the shader samples it
+void ReferencePixel(const float* texel, const ToneMapSettings& s, bool hdr, double* out) {
+    double c[3];
+    for (int i = 0; i < 3; ++i) c[i] = std::max<double>(texel[i], 0.0);
+    if (s.transferFunction == 3) {
+        for (double& v : c) v = PQToLinear(v);
+    } else if (s.transferFunction == 4) {
+        for (double& v : c) v = v >= 0.5 ? (std::exp((v - 0.55991073) / 0.17883277) + 0.28466892) / 12.0 : v * v / 3.0;
+        const double gain = std::pow(std::max(Luma2020(c), 0.0), 0.2) * 12.5;
+        for (double& v : c) v *= gain;
+    } else if (s.transferFunction == 1) {
+        for (double& v : c) v = SrgbToLinear(v);
+    }
+    for (double& v : c) v *= static_cast<double>(s.exposure) * s.exposureGain;
+
+    const double displayPeak = std::max(s.displayPeakScRgb, 1.0f);
+    if (Luma2020(c) > 1e-6) ToneCurve(c, s, displayPeak, hdr);
+    if (!hdr) {
+        for (double& v : c) v /= displayPeak;
+    }
+    double m[3];
+    for (int i = 0; i < 3; ++i) m[i] = s.colorMatrix[i * 4] * c[0] + s.colorMatrix[i * 4 + 1] * c[1] + s.colorMatrix[i * 4 + 2] * c[2];
+    static const double kRec709[3] = { 0.2126, 0.7152, 0.0722 };
+    static const double kBt2020[3] = { 0.2627, 0.6780, 0.0593 };
+    GamutMap(m, hdr ? kBt2020 : kRec709,
+             hdr ? std::max(std::min(s.realHardwarePeakScRgb, s.displayPeakScRgb), 1.0f) : 1.0);
+    for (int i = 0; i < 3; ++i) out[i] = m[i];
+    out[3] = texel[3];
+}
+
+double EncodeSrgb(double c) {
+    c = std::max(c, 0.0);
+    c = c <= 0.0031308 ? c * 12.92 : 1.055 * std::pow(c, 1.0 / 2.4) - 0.055;
+    return std::clamp(c, 0.0, 1.0) * 255.0;
+}
+
+// --- Sources ---------------------------------------------------------------------
+
+struct Source {
+    std::vector<uint8_t> bytes;
+    std::vector<float> texels; // What SrcTex[id.xy] returns
+    int stride = 0;
+};
+
+// Smooth ramps plus noise, a few negatives for float formats; `range` is the peak value
+Source MakeSource(PixelFormat format, int w, int h, float range, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> noise(-0.08f, 0.08f);
+    const bool unorm = format == PixelFormat::R16G16B16A16_UNORM;
+    Source src;
+    src.texels.resize(static_cast<size_t>(w) * h * 4);
+    src.stride = w * (format == PixelFormat::R32G32B32A32_FLOAT ? 16 : 8) + 8; // Padded rows
+    src.bytes.resize(static_cast<size_t>(src.stride) * h);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            float* t = &src.texels[(static_cast<size_t>(y) * w + x) * 4];
+            const float ramp = (x + 0.5f) / w;
+            const float v[4] = { ramp * ramp + noise(rng), (1.0f - ramp) * (y + 1.0f) / h + noise(rng),
+                                 0.5f * ramp + noise(rng), 0.25f + 0.75f * ramp };
+            for (int c = 0; c < 4; ++c) {
+                float val = c == 3 ? v[c] : v[c] * range;
+                if (unorm) val = std::clamp(val, 0.0f, 1.0f);
+                uint8_t* p = src.bytes.data() + static_cast<size_t>(y) * src.stride;
+                if (format == PixelFormat::R32G32B32A32_FLOAT) {
+                    t[c] = val;
+                    std::memcpy(p + (x * 4 + c) * 4, &val, 4);
+                } else if (format == PixelFormat::R16G16B16A16_FLOAT) {
+                    const uint16_t hv = DirectX::PackedVector::XMConvertFloatToHalf(val);
+                    t[c] = DirectX::PackedVector::XMConvertHalfToFloat(hv);
+                    std::memcpy(p + (x * 4 + c) * 2, &hv, 2);
+                } else {
+                    const uint16_t uv = static_cast<uint16_t>(val * 65535.0f + 0.5f);
+                    t[c] = uv / 65535.0f;
+                    std::memcpy(p + (x * 4 + c) * 2, &uv, 2);
+                }
+            }
+        }
+    }
+    return src;
+}
+
+// 1000-nit content on a 203-nit SDR target with a continuous spline through the pivots
+ToneMapSettings BaseSettings() {
+    ToneMapSettings s = {};
+    s.contentPeakScRgb = 12.5f;
+    s.displayPeakScRgb = 2.5375f;
+    s.paperWhiteScRgb = 2.5375f;
+    s.exposure = 1.0f;
+    s.exposureGain = 1.0f;
+    s.splineSrcPivot = 0.45f;
+    s.splineDstPivot = 0.40f;
+    s.splinePa = -0.15f;
+    s.splinePb = 0.92f;
+    s.splineQa = 0.35f;
+    s.splineQb = -0.95f;
+    s.splineQc = 0.55f;
+    s.realHardwarePeakScRgb = 5.0f;
+    s.transferFunction = 2;
+    s.desatThreshold = 0.35f;
+    s.desatStrength = 0.8f;
+    s.colorMatrix[0] = s.colorMatrix[5] = s.colorMatrix[10] = s.colorMatrix[15] = 1.0f;
+    return s;
+}
+
+// BT.709 -> BT.2020: pushes saturated colors outside [0, peak] for the gamut map
+void SetWideMatrix(ToneMapSettings& s) {
+    const float m[9] = { 1.6605f, -0.5876f, -0.0728f, -0.1246f, 1.1329f, -0.0083f, -0.0182f, -0.1006f, 1.1187f };
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) s.colorMatrix[i * 4 + j] = m[i * 3 + j];
+    }
+}
+
+float SourceRange(PixelFormat format, uint32_t transfer) {
+    return format == PixelFormat::R16G16B16A16_UNORM || transfer != 2 ? 1.0f : 16.0f;
+}
+
+void ExpectSdrMatches(const Source& src, PixelFormat format, int w, int h, const ToneMapSettings& s) {
+    std::vector<uint8_t> got(static_cast<size_t>(w) * h * 4 + 4, 0xCD);
+    ImageLoaderSimd::ToneMapHdrToSdr(src.bytes.data(), src.stride, format, got.data(), w * 4, w, h, s);
+    ASSERT_EQ(got.back(), 0xCD);
+    for (int i = 0; i < w * h; ++i) {
+        double ref[4];
+        ReferencePixel(&src.texels[static_cast<size_t>(i) * 4], s, false, ref);
+        const double want[4] = { EncodeSrgb(ref[2]), EncodeSrgb(ref[1]), EncodeSrgb(ref[0]),
+                                 std::clamp(ref[3], 0.0, 1.0) * 255.0 };
+        for (int c = 0; c < 4; ++c) {
+            // +-1 LSB: the shader's float pow vs this double reference at rounding boundaries
+            ASSERT_NEAR(got[static_cast<size_t>(i) * 4 + c], want[c], 1.0)
+                << "pixel " << i << " channel " << c << " mode " << s.mode << " transfer " << s.transferFunction;
+        }
+    }
+}
+
+void ExpectHdrMatches(const Source& src, PixelFormat format, int w, int h, const ToneMapSettings& s) {
+    std::vector<uint16_t> got(static_cast<size_t>(w) * h * 4);
+    ImageLoaderSimd::ToneMapHdrToHdr(src.bytes.data(), src.stride, format, got.data(), w * 8, w, h, s);
+    for (int i = 0; i < w * h; ++i) {
+        double ref[4];
+        ReferencePixel(&src.texels[static_cast<size_t>(i) * 4], s, true, ref);
+        for (int c = 0; c < 4; ++c) {
+            const double v = DirectX::PackedVector::XMConvertHalfToFloat(got[static_cast<size_t>(i) * 4 + c]);
+            // FP16 output: a couple of half ulps (2^-10), as the gamut map's (peak - Y) / (maxC - Y)
+            // amplifies float rounding for channels pulled in from above the hardware peak
+            ASSERT_NEAR(v, ref[c], std::abs(ref[c]) * 4e-3 + 2e-5)
+                << "pixel " << i << " channel " << c << " mode " << s.mode << " transfer " << s.transferFunction;
+        }
+    }
+}
+
+} // namespace
+
+TEST(ToneMapCpuTests, SdrMatchesShaderAcrossFormatsTransfersAndModes) {
+    for (PixelFormat format : kFormats) {
+        for (uint32_t transfer : { 2u, 3u, 4u, 1u }) {
+            for (uint32_t mode : { 0u, 1u, 2u }) {
+                for (int w : kWidths) {
+                    ToneMapSettings s = BaseSettings();
+                    s.transferFunction = transfer;
+                    s.mode = mode;
+                    // HLG / PQ decode to at most 12.5 / 125: scale so the curve has work to do
+                    s.exposure = transfer == 3 ? 0.2f : transfer == 1 ? 4.0f : 1.0f;
+                    const Source src = MakeSource(format, w, 3, SourceRange(format, transfer), w * 31 + transfer * 7 + mode);
+                    SCOPED_TRACE(testing::Message() << "format " << static_cast<int>(format) << " width " << w);
+                    ExpectSdrMatches(src, format, w, 3, s);
+                }
+            }
+        }
+    }
+}
+
+TEST(ToneMapCpuTests, ContrastRecoveryDesatAndMatrix) {
+    ToneMapSettings s = BaseSettings();
+    s.mode = 0;
+    s.contrastRecovery = 0.3f;
+    s.sceneAvgPq = 0.32f;
+    s.mappedAvgPq = 0.29f;
+    s.desatThreshold = 0.6f;
+    s.desatStrength = 1.0f;
+    s.exposureGain = 1.3f;
+    SetWideMatrix(s);
+    for (PixelFormat format : { PixelFormat::R32G32B32A32_FLOAT, PixelFormat::R16G16B16A16_FLOAT }) {
+        const Source src = MakeSource(format, 67, 9, 16.0f, 5);
+        ExpectSdrMatches(src, format, 67, 9, s);
+        ExpectHdrMatches(src, format, 67, 9, s);
+    }
+}
+
+TEST(ToneMapCpuTests, HdrMatchesShaderIncludingPassthrough) {
+    for (uint32_t mode : { 0u, 1u, 2u }) {
+        for (float contentPeak : { 12.5f, 4.0f }) { // 4.0 < display: the spline passes the pixel through
+            ToneMapSettings s = BaseSettings();
+            s.mode = mode;
+            s.contentPeakScRgb = contentPeak;
+            s.displayPeakScRgb = 5.0f;
+            s.realHardwarePeakScRgb = 4.5f;
+            SetWideMatrix(s);
+            for (PixelFormat format : kFormats) {
+                for (int w : kWidths) {
+                    const Source src = MakeSource(format, w, 2, SourceRange(format, 2), w + mode * 3);
+                    SCOPED_TRACE(testing::Message() << "content " << contentPeak << " format "
+                                                    << static_cast<int>(format) << " width " << w);
+                    ExpectHdrMatches(src, format, w, 2, s);
+                }
+            }
+        }
+    }
+}
+
+TEST(ToneMapCpuTests, SplineFitHitsBlackAndDisplayPeak) {
+    for (float knee : { 0.0f, 0.5f }) {
+        ToneMapSettings s = BaseSettings();
+        ImageLoaderSimd::FitSplineToneCurve(s, knee);
+        const double in0 = -static_cast<double>(s.splineSrcPivot);
+        const double in1 = LinearToPQ(s.contentPeakScRgb) - s.splineSrcPivot;
+        const double black = (s.splinePa * in0 + s.splinePb) * in0 + s.splineDstPivot;
+        const double peak = ((s.splineQa * in1 + s.splineQb) * in1 + s.splineQc) * in1 + s.splineDstPivot;
+        EXPECT_NEAR(black, 0.0, 1e-5) << "knee " << knee;
+        EXPECT_NEAR(peak, LinearToPQ(s.displayPeakScRgb), 1e-5) << "knee " << knee;
+        EXPECT_GT(s.splinePb, 0.0f);
+        EXPECT_LE(s.mappedAvgPq, LinearToPQ(s.displayPeakScRgb) + 1e-6);
+    }
+}
+
+TEST(ToneMapCpuTests, ThreadedBandsMatchRowByRow) {
+    // 1200 x 300 is past the threading threshold; bands must not change a byte
+    const int w = 1200, h = 300;
+    const Source src = MakeSource(PixelFormat::R16G16B16A16_FLOAT, w, h, 16.0f, 11);
+    ToneMapSettings s = BaseSettings();
+    s.contrastRecovery = 0.3f;
+    s.sceneAvgPq = 0.3f;
+    s.mappedAvgPq = 0.3f;
+    std::vector<uint8_t> whole(static_cast<size_t>(w) * h * 4), rows(whole.size());
+    ImageLoaderSimd::ToneMapHdrToSdr(src.bytes.data(), src.stride, PixelFormat::R16G16B16A16_FLOAT, whole.data(), w * 4, w, h, s);
+    for (int y = 0; y < h; ++y) {
+        ImageLoaderSimd::ToneMapHdrToSdr(src.bytes.data() + static_cast<size_t>(y) * src.stride, src.stride,
+                                         PixelFormat::R16G16B16A16_FLOAT, rows.data() + static_cast<size_t>(y) * w * 4,
+                                         w * 4, w, 1, s);
+    }
+    EXPECT_EQ(whole, rows);
+}
+
+TEST(ToneMapCpuTests, ComposeGainMapMatchesShader) {
+    struct Case { int w, h, gw, gh; };
+    const Case cases[] = { {1, 1, 1, 1}, {17, 5, 17, 5}, {67, 13, 17, 4}, {33, 9, 70, 20} };
+    for (bool floatBase : { false, true }) {
+        for (bool perChannel : { false, true }) {
+            for (bool baseIsHdr : { false, true }) {
+                for (const Case& c : cases) {
+                    std::mt19937 rng(c.w * 13 + c.gw + floatBase);
+                    const int stride = c.w * (floatBase ? 16 : 4);
+                    std::vector<uint8_t> base(static_cast<size_t>(stride) * c.h);
+                    if (floatBase) {
+                        std::uniform_real_distribution<float> dist(0.0f, 1.2f);
+                        for (size_t i = 0; i < base.size() / 4; ++i) {
+                            const float v = dist(rng);
+                            std::memcpy(&base[i * 4], &v, 4);
+                        }
+                    } else {
+                        for (auto& b : base) b = static_cast<uint8_t>(rng());
+                    }
+                    const int gainStride = c.gw + 3;
+                    std::vector<uint8_t> gain(static_cast<size_t>(gainStride) * c.gh);
+                    for (auto& g : gain) g = static_cast<uint8_t>(rng());
+
+                    GpuShaderPayload p;
+                    for (int i = 0; i < 3; ++i) {
+                        p.gainMapMin[i] = perChannel ? -0.5f + 0.2f * i : -0.25f;
+                        p.gainMapMax[i] = perChannel ? 2.0f + 0.5f * i : 3.0f;
+                        p.gamma[i] = perChannel ? 1.0f + 0.3f * i : 1.0f;
+                        p.offsetSdr[i] = p.offsetHdr[i] = 1.0f / 64.0f;
+                    }
+                    p.hdrCapacityMin = 0.0f;
+                    p.hdrCapacityMax = 3.0f;
+                    p.targetHeadroom = 2.0f;
+                    p.baseIsHdr = baseIsHdr ? 1.0f : 0.0f;
+
+                    std::vector<uint16_t> got(static_cast<size_t>(c.w) * c.h * 4);
+                    ImageLoaderSimd::ComposeGainMap(base.data(), stride,
+                                                    floatBase ? PixelFormat::R32G32B32A32_FLOAT : PixelFormat::BGRA8888,
+                                                    c.w, c.h, gain.data(), c.gw, c.gh, gainStride, p, got.data(), c.w * 8);
+
+                    double weight = (2.0 - 0.0) / 3.0;
+                    if (baseIsHdr) weight = 1.0 - weight;
+                    auto texel = [&](int x, int y) {
+                        return gain[static_cast<size_t>(std::clamp(y, 0, c.gh - 1)) * gainStride + std::clamp(x, 0, c.gw - 1)] / 255.0;
+                    };
+                    for (int y = 0; y < c.h; ++y) {
+                        for (int x = 0; x < c.w; ++x) {
+                            // Clamp-addressed bilinear sample at uv = (xy + 0.5) / size
+                            const double tx = (x + 0.5) / c.w * c.gw - 0.5, ty = (y + 0.5) / c.h * c.gh - 0.5;
+                            const int x0 = static_cast<int>(std::floor(tx)), y0 = static_cast<int>(std::floor(ty));
+                            const double fx = tx - x0, fy = ty - y0;
+                            const double top = texel(x0, y0) + (texel(x0 + 1, y0) - texel(x0, y0)) * fx;
+                            const double bottom = texel(x0, y0 + 1) + (texel(x0 + 1, y0 + 1) - texel(x0, y0 + 1)) * fx;
+                            const double g = top + (bottom - top) * fy;
+                            const size_t px = static_cast<size_t>(y) * c.w + x;
+                            for (int ch = 0; ch < 3; ++ch) {
+                                double sdr;
+                                if (floatBase) {
+                                    float f;
+                                    std::memcpy(&f, &base[static_cast<size_t>(y) * stride + (x * 4 + ch) * 4], 4);
+                                    sdr = f;
+                                } else {
+                                    sdr = SrgbToLinear(base[static_cast<size_t>(y) * stride + x * 4 + 2 - ch] / 255.0);
+                                }
+                                const double gainLog = p.gainMapMin[ch] + (p.gainMapMax[ch] - p.gainMapMin[ch]) *
+                                                                              std::pow(g, 1.0 / p.gamma[ch]);
+                                const double want = std::max((sdr + p.offsetSdr[ch]) * std::exp2(gainLog * weight) - p.offsetHdr[ch], 0.0);
+                                const double v = DirectX::PackedVector::XMConvertHalfToFloat(got[px * 4 + ch]);
+                                ASSERT_NEAR(v, want, want * 2e-3 + 1e-5)
+                                    << c.w << "x" << c.h << " from " << c.gw << "x" << c.gh << " at " << x << "," << y
+                                    << " channel " << ch << " float " << floatBase << " perChannel " << perChannel;
+                            }
+                            EXPECT_EQ(DirectX::PackedVector::XMConvertHalfToFloat(got[px * 4 + 3]), 1.0f);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(ToneMapCpuTests, ComposeGainMapRowsMatchWholeFrame) {
+    // RenderEngine's CPU bake composes band by band; the gain map is still sampled
+    // against the whole frame, so the bands must tile it exactly
+    const int w = 301, h = 97, gw = 77, gh = 25;
+    std::mt19937 rng(5);
+    std::vector<uint8_t> base(static_cast<size_t>(w) * h * 4), gain(static_cast<size_t>(gw) * gh);
+    for (auto& b : base) b = static_cast<uint8_t>(rng());
+    for (auto& g : gain) g = static_cast<uint8_t>(rng());
+    GpuShaderPayload p;
+    for (int i = 0; i < 3; ++i) {
+        p.gainMapMax[i] = 2.5f;
+        p.gamma[i] = 1.0f;
+        p.offsetSdr[i] = p.offsetHdr[i] = 1.0f / 64.0f;
+    }
+    p.hdrCapacityMax = 2.5f;
+    p.targetHeadroom = 1.5f;
+
+    std::vector<uint16_t> whole(static_cast<size_t>(w) * h * 4), banded(whole.size());
+    ImageLoaderSimd::ComposeGainMap(base.data(), w * 4, PixelFormat::BGRA8888, w, h, gain.data(), gw, gh, gw, p,
+                                    whole.data(), w * 8);
+    for (int y0 = 0; y0 < h; y0 += 10) {
+        std::vector<uint16_t> band(static_cast<size_t>(w) * 10 * 4);
+        const int y1 = (std::min)(h, y0 + 10);
+        ImageLoaderSimd::ComposeGainMapRows(base.data(), w * 4, PixelFormat::BGRA8888, w, h, gain.data(), gw, gh, gw, p,
+                                            y0, y1, band.data(), w * 8);
+        std::copy(band.begin(), band.begin() + static_cast<size_t>(y1 - y0) * w * 4,
+                  banded.begin() + static_cast<size_t>(y0) * w * 4);
+    }
+    EXPECT_EQ(whole, banded);
+}
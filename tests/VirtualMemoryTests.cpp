@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "VirtualMemory.h"
+#include "MemoryArena.h"
+#include <cstring>
+
+// Portable reserve/commit layer under QuantumArena and TileMemoryManager
+
+namespace VM = QuickView::VM;
+
+// Normally provided by ImageEngine.cpp (AppConfig-driven); tests always shrink
+bool QuantumArena::ShouldShrinkMemory() noexcept { return true; }
+
+TEST(VirtualMemoryTest, ReserveCommitDecommitRoundTrip) {
+    const size_t page = VM::PageSize();
+    ASSERT_GE(page, 4096u);
+
+    VM::Reservation r = VM::Reserve(64 * page);
+    ASSERT_TRUE(r);
+    EXPECT_GE(r.size, 64 * page);
+    EXPECT_EQ(r.commitGranularity, page);
+    EXPECT_EQ(r.hugePages, VM::HugePages::Off);
+
+    auto* bytes = static_cast<uint8_t*>(r.base);
+    ASSERT_TRUE(VM::Commit(bytes + 8 * page, 4 * page));
+    std::memset(bytes + 8 * page, 0xAB, 4 * page);
+    EXPECT_EQ(bytes[11 * page + 17], 0xAB);
+
+    // Recommitted pages come back zeroed
+    VM::Decommit(bytes + 8 * page, 4 * page);
+    ASSERT_TRUE(VM::Commit(bytes + 8 * page, 4 * page));
+    EXPECT_EQ(bytes[11 * page + 17], 0);
+
+    VM::Release(r);
+    EXPECT_FALSE(r);
+}
+
+TEST(VirtualMemoryTest, HugePageRequestDegradesGracefully) {
+    VM::Reservation r = VM::Reserve(3 * 1024 * 1024, VM::HugePages::Explicit);
+    ASSERT_TRUE(r); // Whatever the host offers, the reservation succeeds
+    if (r.hugePages != VM::HugePages::Off) {
+        EXPECT_EQ(r.commitGranularity, VM::HugePageSize());
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(r.base) % r.commitGranularity, 0u);
+        EXPECT_EQ(r.size % r.commitGranularity, 0u);
+    }
+    ASSERT_TRUE(VM::Commit(r.base, r.commitGranularity));
+    static_cast<uint8_t*>(r.base)[r.commitGranularity - 1] = 1;
+    VM::Release(r);
+}
+
+TEST(VirtualMemoryTest, ArenaTelemetryPerResetCycle) {
+    QuantumArena arena(64 * 1024 * 1024);
+
+    // Cycle 1: 5 MB in 1 MB commit chunks
+    for (int i = 0; i < 5; ++i) {
+        void* p = arena.Allocate(1024 * 1024);
+        ASSERT_NE(p, nullptr);
+        std::memset(p, i, 1024 * 1024);
+    }
+    EXPECT_GE(arena.GetCommittedBytes(), 5u * 1024 * 1024);
+    arena.Reset(); // Shrinks everything (ShouldShrinkMemory above)
+
+    auto t = arena.GetTelemetry();
+    EXPECT_EQ(t.resetCycles, 1u);
+    EXPECT_GE(t.cycleCommitCalls, 1u);
+    EXPECT_LE(t.cycleCommitCalls, 5u);
+    EXPECT_GE(t.cycleCommitBytes, 5u * 1024 * 1024);
+    EXPECT_EQ(t.cycleDecommitCalls, 1u);
+    EXPECT_EQ(t.cycleDecommitBytes, t.cycleCommitBytes);
+    EXPECT_EQ(t.committedBytes, 0u);
+
+    // Cycle 2: nothing allocated, nothing committed; faults are measured from here on
+    arena.Reset();
+    t = arena.GetTelemetry();
+    EXPECT_EQ(t.resetCycles, 2u);
+    EXPECT_EQ(t.cycleCommitCalls, 0u);
+    EXPECT_EQ(t.cycleDecommitCalls, 0u);
+    EXPECT_GE(t.commitCalls, 1u); // Lifetime totals survive
+
+    // Cycle 3: touching fresh pages shows up as faults
+    void* p = arena.Allocate(4 * 1024 * 1024);
+    ASSERT_NE(p, nullptr);
+    std::memset(p, 1, 4 * 1024 * 1024);
+    arena.Reset();
+    t = arena.GetTelemetry();
+    EXPECT_GT(t.cyclePageFaults, 0u);
+}
+
+TEST(VirtualMemoryTest, ArenaOverflowUsesAlignedHeap) {
+    QuantumArena arena(1024 * 1024);
+    void* big = arena.Allocate(3 * 1024 * 1024);
+    ASSERT_NE(big, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(big) % QuantumArena::ALIGNMENT, 0u);
+    EXPECT_TRUE(arena.Owns(big));
+    EXPECT_EQ(arena.GetOverflowCount(), 1u);
+    std::memset(big, 0x5A, 3 * 1024 * 1024);
+    arena.Reset(); // Frees the overflow block
+    EXPECT_FALSE(arena.Owns(big));
+}
+
+TEST(VirtualMemoryTest, ArenaKeepsWorkingSetWithHysteresis) {
+    constexpr size_t MB = 1024 * 1024;
+    QuantumArena arena(256 * MB);
+    ArenaWorkingSet workingSet;
+
+    // 45 MP BGRA frame predicted from the header, committed and faulted before decode
+    const size_t frame = ArenaWorkingSet::PredictFrameBytes(8256, 5504);
+    EXPECT_EQ(frame, (size_t)8256 * 4 * 5504);
+    workingSet.Record(frame);
+    arena.SetRetainBytes(workingSet.RetainBytes());
+    EXPECT_EQ(arena.Precommit(frame, 2), frame);
+    EXPECT_GE(arena.GetCommittedBytes(), frame);
+    EXPECT_GE(arena.GetTelemetry().prefaultBytes, frame - QuickView::VM::PageSize());
+    const uint64_t commits = arena.GetTelemetry().commitCalls;
+    std::memset(arena.Allocate(frame), 0x11, frame); // Decoder finds it ready
+
+    // ShouldShrinkMemory() is true here: Reset shrinks only to the working set
+    arena.Reset();
+    EXPECT_GE(arena.GetCommittedBytes(), frame);
+    EXPECT_EQ(arena.Precommit(frame, 2), frame);
+    EXPECT_EQ(arena.GetTelemetry().commitCalls, commits); // Nothing to do
+
+    // One small image does not give the memory back...
+    workingSet.Record(ArenaWorkingSet::PredictFrameBytes(4032, 3024));
+    arena.SetRetainBytes(workingSet.RetainBytes());
+    arena.Reset();
+    EXPECT_GE(arena.GetCommittedBytes(), frame);
+
+    // ...a full window of them does
+    for (size_t i = 0; i < ArenaWorkingSet::kWindow; ++i) {
+        workingSet.Record(ArenaWorkingSet::PredictFrameBytes(4032, 3024));
+    }
+    arena.SetRetainBytes(workingSet.RetainBytes());
+    arena.Reset();
+    EXPECT_LT(arena.GetCommittedBytes(), frame);
+    EXPECT_GE(arena.GetCommittedBytes(), (size_t)4032 * 4 * 3024);
+
+    // Explicit reclaim ignores the working set
+    arena.Shrink();
+    EXPECT_EQ(arena.GetCommittedBytes(), 0u);
+}
@@ -0,0 +1,220 @@
+/*
+ * QuickView Test Support - In-memory TIFF writer shared by tests and benchmarks
+ * Copyright (C) 2026-Present QuickView Contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Produces strip-organized little-endian TIFFs so MiniTiff tests and benchmarks run
+// without a corpus. Only the subset MiniTiff decodes is written: 8/16-bit interleaved
+// samples, Uncompressed / LZW / Deflate, optional horizontal predictor.
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <zlib.h>
+
+namespace QuickView::Testing {
+
+struct SyntheticTiffDesc {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint16_t samples = 3;
+    uint16_t bitsPerSample = 8;
+    uint16_t photometric = 2;  // RGB
+    uint16_t compression = 1;  // 1 = none, 5 = LZW, 8 = Deflate
+    uint16_t predictor = 1;
+    uint32_t rowsPerStrip = 64;
+};
+
+// TIFF LZW (MSB-first, code width grows one code early to match the decoder)
+inline std::vector<uint8_t> EncodeTiffLzw(const uint8_t* src, size_t len) {
+    constexpr int kClear = 256;
+    constexpr int kEoi = 257;
+    constexpr int kMaxCode = 4093;
+
+    std::vector<uint8_t> out;
+    uint64_t bitBuffer = 0;
+    int bitCount = 0;
+    int nextCode = 258;
+    auto codeWidth = [&]() {
+        int last = nextCode - 1;
+        return last < 511 ? 9 : last < 1023 ? 10 : last < 2047 ? 11 : 12;
+    };
+    auto emit = [&](int code) {
+        int width = codeWidth();
+        bitBuffer = (bitBuffer << width) | static_cast<uint32_t>(code);
+        bitCount += width;
+        while (bitCount >= 8) {
+            bitCount -= 8;
+            out.push_back(static_cast<uint8_t>(bitBuffer >> bitCount));
+        }
+    };
+
+    // Dictionary as (prefix code, byte) -> code, open addressing
+    constexpr size_t kHashSize = 1 << 14;
+    std::vector<int32_t> keys(kHashSize, -1);
+    std::vector<uint16_t> codes(kHashSize);
+    auto slot = [&](int32_t key) {
+        size_t h = (static_cast<uint32_t>(key) * 2654435761u) >> 18;
+        while (keys[h] != -1 && keys[h] != key) h = (h + 1) & (kHashSize - 1);
+        return h;
+    };
+
+    emit(kClear);
+    if (len == 0) {
+        emit(kEoi);
+    } else {
+        int w = src[0];
+        for (size_t i = 1; i < len; ++i) {
+            const int32_t key = (w << 8) | src[i];
+            size_t h = slot(key);
+            if (keys[h] == key) {
+                w = codes[h];
+                continue;
+            }
+            emit(w);
+            keys[h] = key;
+            codes[h] = static_cast<uint16_t>(nextCode++);
+            if (nextCode >= kMaxCode) {
+                emit(kClear);
+                std::fill(keys.begin(), keys.end(), -1);
+                nextCode = 258;
+            }
+            w = src[i];
+        }
+        emit(w);
+        nextCode++; // The decoder adds an entry for the last code before reading EOI
+        emit(kEoi);
+    }
+    if (bitCount > 0) {
+        out.push_back(static_cast<uint8_t>(bitBuffer << (8 - bitCount)));
+    }
+    return out;
+}
+
+// Horizontal differencing (Predictor=2) for one little-endian row
+inline void ApplyHorizontalPredictor(uint8_t* row, uint32_t width, int samples, int bytesPerSample) {
+    for (int64_t i = static_cast<int64_t>(width) * samples - 1; i >= samples; --i) {
+        if (bytesPerSample == 1) {
+            row[i] = static_cast<uint8_t>(row[i] - row[i - samples]);
+        } else {
+            uint16_t cur = static_cast<uint16_t>(row[i * 2] | (row[i * 2 + 1] << 8));
+            uint16_t prev = static_cast<uint16_t>(row[(i - samples) * 2] | (row[(i - samples) * 2 + 1] << 8));
+            uint16_t d = static_cast<uint16_t>(cur - prev);
+            row[i * 2] = static_cast<uint8_t>(d);
+            row[i * 2 + 1] = static_cast<uint8_t>(d >> 8);
+        }
+    }
+}
+
+// `samplesData` holds width * height * samples interleaved samples (little-endian for 16-bit)
+inline std::vector<uint8_t> BuildStripTiff(const SyntheticTiffDesc& d, const std::vector<uint8_t>& samplesData) {
+    auto put = [](std::vector<uint8_t>& buf, uint64_t v, int bytes) {
+        for (int i = 0; i < bytes; ++i) buf.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    };
+    auto patch32 = [](std::vector<uint8_t>& buf, size_t pos, uint32_t v) {
+        for (int i = 0; i < 4; ++i) buf[pos + i] = static_cast<uint8_t>(v >> (8 * i));
+    };
+
+    const int bps = d.bitsPerSample / 8;
+    const size_t rowBytes = static_cast<size_t>(d.width) * d.samples * bps;
+    const uint32_t rps = d.rowsPerStrip ? (std::min)(d.rowsPerStrip, d.height) : d.height;
+
+    std::vector<uint8_t> buf = {'I', 'I', 0x2A, 0x00, 0, 0, 0, 0};
+    std::vector<uint32_t> offsets, counts;
+    std::vector<uint8_t> strip;
+    for (uint32_t y0 = 0; y0 < d.height; y0 += rps) {
+        const uint32_t rows = (std::min)(rps, d.height - y0);
+        strip.assign(samplesData.begin() + y0 * rowBytes, samplesData.begin() + (y0 + rows) * rowBytes);
+        if (d.predictor == 2) {
+            for (uint32_t r = 0; r < rows; ++r) {
+                ApplyHorizontalPredictor(strip.data() + r * rowBytes, d.width, d.samples, bps);
+            }
+        }
+        if (d.compression == 5) {
+            strip = EncodeTiffLzw(strip.data(), strip.size());
+        } else if (d.compression == 8) {
+            uLongf packedLen = compressBound(static_cast<uLong>(strip.size()));
+            std::vector<uint8_t> packed(packedLen);
+            compress2(packed.data(), &packedLen, strip.data(), static_cast<uLong>(strip.size()), 6);
+            packed.resize(packedLen);
+            strip.swap(packed);
+        }
+        offsets.push_back(static_cast<uint32_t>(buf.size()));
+        counts.push_back(static_cast<uint32_t>(strip.size()));
+        buf.insert(buf.end(), strip.begin(), strip.end());
+        if (buf.size() & 1) buf.push_back(0);
+    }
+
+    const uint32_t offsetsPos = static_cast<uint32_t>(buf.size());
+    for (uint32_t v : offsets) put(buf, v, 4);
+    const uint32_t countsPos = static_cast<uint32_t>(buf.size());
+    for (uint32_t v : counts) put(buf, v, 4);
+
+    struct Entry { uint16_t tag, type; uint32_t count, value; };
+    const bool single = offsets.size() == 1;
+    const Entry entries[] = {
+        {256, 4, 1, d.width},
+        {257, 4, 1, d.height},
+        {258, 3, 1, d.bitsPerSample},
+        {259, 3, 1, d.compression},
+        {262, 3, 1, d.photometric},
+        {273, 4, static_cast<uint32_t>(offsets.size()), single ? offsets[0] : offsetsPos},
+        {277, 3, 1, d.samples},
+        {278, 4, 1, rps},
+        {279, 4, static_cast<uint32_t>(counts.size()), single ? counts[0] : countsPos},
+        {317, 3, 1, d.predictor},
+    };
+
+    patch32(buf, 4, static_cast<uint32_t>(buf.size()));
+    put(buf, sizeof(entries) / sizeof(entries[0]), 2);
+    for (const Entry& e : entries) {
+        put(buf, e.tag, 2);
+        put(buf, e.type, 2);
+        put(buf, e.count, 4);
+        put(buf, e.value, e.type == 3 ? 2 : 4); // SHORT values are left-justified
+        if (e.type == 3) put(buf, 0, 2);
+    }
+    put(buf, 0, 4);
+    return buf;
+}
+
+// Photo-like content: smooth gradients plus low-amplitude noise, so LZW/Deflate
+// and the predictor see realistic redundancy instead of flat fills or pure noise.
+inline std::vector<uint8_t> MakeGradientSamples(uint32_t width, uint32_t height, int samples, int bytesPerSample) {
+    std::vector<uint8_t> out(static_cast<size_t>(width) * height * samples * bytesPerSample);
+    uint32_t seed = 0x9E3779B9u;
+    size_t i = 0;
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            for (int c = 0; c < samples; ++c) {
+                seed = seed * 1664525u + 1013904223u;
+                uint32_t base = (x * (c + 1) * 65535u / (width ? width : 1) + y * 65535u / (height ? height : 1)) / 2;
+                uint32_t v = (base + (seed >> 28) * 64) & 0xFFFF;
+                if (bytesPerSample == 1) {
+                    out[i++] = static_cast<uint8_t>(v >> 8);
+                } else {
+                    out[i++] = static_cast<uint8_t>(v);
+                    out[i++] = static_cast<uint8_t>(v >> 8);
+                }
+            }
+        }
+    }
+    return out;
+}
+
+} // namespace QuickView::Testing